@@ -0,0 +1,110 @@
+"""Benchmarks of (weighted) structural algorithms.
+
+Every algorithm is called through the usual API (weights given as an
+attribute name or a list, results returned as lists) and with the weights
+passed as a buffer and the results returned as L{Buffer} objects, which
+is as close to the C core as the binding gets. The C{track_*_overhead}
+benchmarks report the share of the former spent in the binding layer.
+"""
+
+from array import array
+
+from .common import binding_overhead, make_graph, sizes
+
+
+class WeightedAlgorithms(object):
+    """Weighted algorithms that finish in (nearly) linear time."""
+
+    params = [sizes(10 ** 6)]
+    param_names = ["edges"]
+    timeout = 600
+
+    def setup(self, m):
+        self.graph = make_graph(m, weighted=True)
+        self.weights = self.graph.es["weight"]
+        self.weight_buffer = array("d", self.weights)
+        self.sources = list(range(10))
+
+    def time_degree(self, m):
+        self.graph.degree()
+
+    def time_degree_core(self, m):
+        self.graph.degree(return_type="buffer")
+
+    def time_strength_attribute(self, m):
+        self.graph.strength(weights="weight")
+
+    def time_strength_list(self, m):
+        self.graph.strength(weights=self.weights)
+
+    def time_strength_core(self, m):
+        self.graph.strength(weights=self.weight_buffer, return_type="buffer")
+
+    def time_pagerank_attribute(self, m):
+        self.graph.pagerank(weights="weight")
+
+    def time_pagerank_list(self, m):
+        self.graph.pagerank(weights=self.weights)
+
+    def time_pagerank_core(self, m):
+        self.graph.pagerank(weights=self.weight_buffer, return_type="buffer")
+
+    def time_shortest_paths(self, m):
+        self.graph.shortest_paths(self.sources, weights="weight")
+
+    def time_shortest_paths_core(self, m):
+        self.graph.shortest_paths(
+            self.sources, weights=self.weight_buffer, return_type="buffer"
+        )
+
+    def time_components(self, m):
+        self.graph.components()
+
+    def track_pagerank_overhead(self, m):
+        return binding_overhead(
+            lambda: self.graph.pagerank(weights=self.weights),
+            lambda: self.graph.pagerank(
+                weights=self.weight_buffer, return_type="buffer"
+            ),
+            repeat=3
+        )
+    track_pagerank_overhead.unit = "%"
+
+    def track_shortest_paths_overhead(self, m):
+        return binding_overhead(
+            lambda: self.graph.shortest_paths(self.sources, weights=self.weights),
+            lambda: self.graph.shortest_paths(
+                self.sources, weights=self.weight_buffer, return_type="buffer"
+            ),
+            repeat=3
+        )
+    track_shortest_paths_overhead.unit = "%"
+
+
+class Betweenness(object):
+    """Weighted betweenness, which takes quadratic time."""
+
+    params = [sizes(10 ** 4)]
+    param_names = ["edges"]
+    timeout = 600
+
+    def setup(self, m):
+        self.graph = make_graph(m, weighted=True)
+        self.weights = self.graph.es["weight"]
+        self.weight_buffer = array("d", self.weights)
+
+    def time_betweenness(self, m):
+        self.graph.betweenness(weights="weight")
+
+    def time_betweenness_core(self, m):
+        self.graph.betweenness(weights=self.weight_buffer, return_type="buffer")
+
+    def track_betweenness_overhead(self, m):
+        return binding_overhead(
+            lambda: self.graph.betweenness(weights=self.weights),
+            lambda: self.graph.betweenness(
+                weights=self.weight_buffer, return_type="buffer"
+            ),
+            repeat=3
+        )
+    track_betweenness_overhead.unit = "%"
@@ -0,0 +1,72 @@
+"""Benchmarks of the attribute handler."""
+
+import random
+
+from .common import make_graph, sizes
+
+
+class VertexAttributes(object):
+    """Getting and setting vertex attributes, in bulk and one by one."""
+
+    params = [sizes()]
+    param_names = ["edges"]
+    timeout = 600
+
+    def setup(self, m):
+        self.graph = make_graph(m).copy()
+        rng = random.Random(42)
+        self.real_values = [rng.random() for _ in range(self.graph.vcount())]
+        self.str_values = [str(value) for value in self.real_values]
+        self.graph.vs["real"] = self.real_values
+        self.graph.vs["str"] = self.str_values
+        self.indices = list(range(min(self.graph.vcount(), 10000)))
+
+    def time_set_numeric(self, m):
+        self.graph.vs["new_real"] = self.real_values
+
+    def time_set_string(self, m):
+        self.graph.vs["new_str"] = self.str_values
+
+    def time_get_numeric(self, m):
+        self.graph.vs["real"]
+
+    def time_get_string(self, m):
+        self.graph.vs["str"]
+
+    def time_get_single(self, m):
+        vs = self.graph.vs
+        for index in self.indices:
+            vs[index]["real"]
+
+    def time_set_single(self, m):
+        vs = self.graph.vs
+        for index in self.indices:
+            vs[index]["real"] = 0.5
+
+
+class EdgeAttributes(object):
+    """Getting and setting edge attributes, in bulk and one by one."""
+
+    params = [sizes()]
+    param_names = ["edges"]
+    timeout = 600
+
+    def setup(self, m):
+        self.graph = make_graph(m, weighted=True).copy()
+        self.weights = self.graph.es["weight"]
+        self.indices = list(range(min(self.graph.ecount(), 10000)))
+
+    def time_set_numeric(self, m):
+        self.graph.es["new_weight"] = self.weights
+
+    def time_get_numeric(self, m):
+        self.graph.es["weight"]
+
+    def time_get_single(self, m):
+        es = self.graph.es
+        for index in self.indices:
+            es[index]["weight"]
+
+    def time_delete(self, m):
+        self.graph.es["tmp"] = 1.0
+        del self.graph.es["tmp"]
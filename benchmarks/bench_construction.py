@@ -0,0 +1,69 @@
+"""Benchmarks of building graphs from Python data."""
+
+import random
+
+from igraph import FastRNG, Graph, set_random_number_generator
+
+from .common import (
+    binding_overhead, edge_list_to_buffer, make_edge_list, sizes
+)
+
+
+class GraphConstruction(object):
+    """Graph construction and C{add_edges()} from lists of pairs, with the
+    same edges passed as a buffer as the reference for the C core."""
+
+    params = [sizes()]
+    param_names = ["edges"]
+    timeout = 600
+
+    def setup(self, m):
+        self.n = max(m // 4, 2)
+        self.edges = make_edge_list(m)
+        self.buffer = edge_list_to_buffer(self.edges)
+        self.half = len(self.edges) // 2
+        self.base = Graph(self.n, self.edges[:self.half])
+
+    def time_construct(self, m):
+        Graph(self.n, self.edges)
+
+    def time_construct_core(self, m):
+        Graph(self.n, self.buffer)
+
+    def time_add_edges(self, m):
+        self.base.copy().add_edges(self.edges[self.half:])
+
+    def time_add_edges_core(self, m):
+        self.base.copy().add_edges(self.buffer[self.half:])
+
+    def track_binding_overhead(self, m):
+        return binding_overhead(
+            lambda: Graph(self.n, self.edges),
+            lambda: Graph(self.n, self.buffer),
+            repeat=3
+        )
+    track_binding_overhead.unit = "%"
+
+
+class RandomGraphs(object):
+    """Random graph generators; these run entirely in the C core."""
+
+    params = [sizes()]
+    param_names = ["edges"]
+    timeout = 600
+
+    def setup(self, m):
+        set_random_number_generator(FastRNG(42))
+
+    def teardown(self, m):
+        set_random_number_generator(random)
+
+    def time_erdos_renyi_gnm(self, m):
+        Graph.Erdos_Renyi(n=max(m // 4, 2), m=m)
+
+    def time_erdos_renyi_gnp(self, m):
+        n = max(m // 4, 2)
+        Graph.Erdos_Renyi(n=n, p=2.0 * m / n / (n - 1))
+
+    def time_barabasi(self, m):
+        Graph.Barabasi(max(m // 4, 2), 4)
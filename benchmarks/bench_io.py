@@ -0,0 +1,75 @@
+"""Benchmarks of pickling and file I/O."""
+
+import os
+import pickle
+import shutil
+import tempfile
+
+from igraph import Graph
+
+from .common import make_graph, sizes
+
+
+class Pickling(object):
+    """Pickling graphs with a numeric and a string vertex attribute."""
+
+    params = [sizes()]
+    param_names = ["edges"]
+    timeout = 600
+
+    def setup(self, m):
+        self.graph = make_graph(m, weighted=True).copy()
+        self.graph.vs["name"] = [str(i) for i in range(self.graph.vcount())]
+        self.data = pickle.dumps(self.graph, protocol=pickle.HIGHEST_PROTOCOL)
+
+    def time_dumps(self, m):
+        pickle.dumps(self.graph, protocol=pickle.HIGHEST_PROTOCOL)
+
+    def time_loads(self, m):
+        pickle.loads(self.data)
+
+
+class FileFormats(object):
+    """Writing and reading graphs in various formats."""
+
+    params = [sizes(), ["edgelist", "ncol", "graphml", "binary"]]
+    param_names = ["edges", "format"]
+    timeout = 600
+
+    def setup(self, m, format):
+        if format == "graphml" and m > 10 ** 6:
+            raise NotImplementedError("too slow for routine runs")
+        self.graph = make_graph(m, weighted=True)
+        self.tmpdir = tempfile.mkdtemp()
+        self.path = os.path.join(self.tmpdir, "graph." + format)
+        self.out_path = os.path.join(self.tmpdir, "out." + format)
+        self.graph.save(self.path, format=format)
+
+    def teardown(self, m, format):
+        shutil.rmtree(self.tmpdir, ignore_errors=True)
+
+    def time_write(self, m, format):
+        self.graph.save(self.out_path, format=format)
+
+    def time_read(self, m, format):
+        Graph.Load(self.path, format=format)
+
+
+class Snapshots(object):
+    """Opening memory-mapped snapshots, which should not depend much on the
+    size of the graph."""
+
+    params = [sizes()]
+    param_names = ["edges"]
+    timeout = 600
+
+    def setup(self, m):
+        self.tmpdir = tempfile.mkdtemp()
+        self.path = os.path.join(self.tmpdir, "graph.snapshot")
+        make_graph(m).write_snapshot(self.path)
+
+    def teardown(self, m):
+        shutil.rmtree(self.tmpdir, ignore_errors=True)
+
+    def time_open(self, m):
+        Graph.Open_Snapshot(self.path)
@@ -0,0 +1,43 @@
+"""Benchmarks of vertex and edge sequences."""
+
+from .common import make_graph, sizes
+
+
+class Sequences(object):
+    """Iterating over, indexing and filtering vertex and edge sequences."""
+
+    params = [sizes(10 ** 6)]
+    param_names = ["edges"]
+    timeout = 600
+
+    def setup(self, m):
+        self.graph = make_graph(m, weighted=True)
+        self.indices = list(range(min(self.graph.vcount(), 10000)))
+
+    def time_iterate_vertices(self, m):
+        for _ in self.graph.vs:
+            pass
+
+    def time_iterate_edges(self, m):
+        for _ in self.graph.es:
+            pass
+
+    def time_edge_tuples(self, m):
+        [edge.tuple for edge in self.graph.es]
+
+    def time_index_vertices(self, m):
+        vs = self.graph.vs
+        for index in self.indices:
+            vs[index]
+
+    def time_select_by_keyword(self, m):
+        self.graph.es.select(weight_gt=5)
+
+    def time_select_by_callable(self, m):
+        self.graph.es.select(lambda edge: edge["weight"] > 5)
+
+    def time_select_by_indices(self, m):
+        self.graph.vs.select(self.indices)
+
+    def time_get_edgelist(self, m):
+        self.graph.get_edgelist()
@@ -0,0 +1,46 @@
+"""Benchmarks of traversals and their iterators."""
+
+from .common import binding_overhead, make_graph, sizes
+
+
+class Traversal(object):
+    """BFS and DFS from a single root, vertex by vertex and in batches;
+    C{bfs()} returns the whole traversal in one call and serves as the
+    reference for the C core."""
+
+    params = [sizes(10 ** 6)]
+    param_names = ["edges"]
+    timeout = 600
+
+    def setup(self, m):
+        self.graph = make_graph(m)
+
+    def time_bfs(self, m):
+        self.graph.bfs(0)
+
+    def time_bfsiter(self, m):
+        for _ in self.graph.bfsiter(0):
+            pass
+
+    def time_bfsiter_advanced(self, m):
+        for _ in self.graph.bfsiter(0, advanced=True):
+            pass
+
+    def time_bfsiter_batch(self, m):
+        for _ in self.graph.bfsiter(0, batch=4096):
+            pass
+
+    def time_dfsiter(self, m):
+        for _ in self.graph.dfsiter(0):
+            pass
+
+    def time_dfsiter_batch(self, m):
+        for _ in self.graph.dfsiter(0, batch=4096):
+            pass
+
+    def track_bfsiter_overhead(self, m):
+        def iterate():
+            for _ in self.graph.bfsiter(0):
+                pass
+        return binding_overhead(iterate, lambda: self.graph.bfs(0), repeat=3)
+    track_bfsiter_overhead.unit = "%"
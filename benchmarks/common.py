@@ -0,0 +1,115 @@
+"""Shared helpers of the benchmark suite.
+
+Every benchmark module builds its graphs with L{make_graph()} so that the
+benchmarks of different modules (and different commits) run on the very
+same synthetic graphs. The sizes are numbers of edges; the graphs have an
+average degree of 8, i.e. M{n = m / 4} vertices.
+
+The largest graphs take a lot of time and memory to build. Set the
+C{IGRAPH_BENCHMARK_MAX_EDGES} environment variable to skip every size
+above the given number of edges, e.g. C{IGRAPH_BENCHMARK_MAX_EDGES=100000}
+for a quick run.
+"""
+
+import os
+import random
+import timeit
+
+from array import array
+from igraph import FastRNG, Graph, set_random_number_generator
+
+#: Number of edges of the synthetic graphs, from small to large
+SIZES = [10 ** 4, 10 ** 5, 10 ** 6, 10 ** 7]
+
+#: Seed of the random number generator used to build the graphs
+SEED = 42
+
+_graph_cache = {}
+
+
+def sizes(limit=None):
+    """Returns the sizes to be benchmarked, optionally excluding those
+    above the given number of edges (for benchmarks of algorithms that
+    would take too long on larger graphs)."""
+    max_edges = os.environ.get("IGRAPH_BENCHMARK_MAX_EDGES")
+    if max_edges:
+        max_edges = int(max_edges)
+        limit = max_edges if limit is None else min(limit, max_edges)
+    result = [size for size in SIZES if limit is None or size <= limit]
+    return result or SIZES[:1]
+
+
+def make_edge_list(m, seed=SEED):
+    """Returns a reproducible random edge list with C{m} edges on C{m / 4}
+    vertices, as a list of pairs."""
+    rng = random.Random(seed)
+    n = max(m // 4, 2)
+    randrange = rng.randrange
+    return [(randrange(n), randrange(n)) for _ in range(m)]
+
+
+def edge_list_to_buffer(edges):
+    """Converts an edge list to a two-dimensional memoryview of doubles
+    that igraph uses without conversion.
+
+    Raises C{NotImplementedError} (which makes asv skip the benchmark) on
+    Python versions without C{memoryview.cast()}.
+    """
+    flat = array("d")
+    for edge in edges:
+        flat.extend(edge)
+    view = memoryview(flat)
+    if not hasattr(view, "cast"):
+        raise NotImplementedError("memoryview.cast() is not available")
+    return view.cast("B").cast("d", (len(edges), 2))
+
+
+def make_graph(m, weighted=False, seed=SEED):
+    """Returns a reproducible undirected Erdos-Renyi graph with C{m} edges
+    on C{m / 4} vertices.
+
+    Graphs are cached within the process; benchmarks must not modify them
+    (use C{copy()} instead). If C{weighted} is C{True}, the edges have a
+    C{weight} attribute with random weights between 1 and 10.
+    """
+    key = m, weighted, seed
+    graph = _graph_cache.get(key)
+    if graph is None:
+        set_random_number_generator(FastRNG(seed))
+        try:
+            graph = Graph.Erdos_Renyi(n=max(m // 4, 2), m=m)
+        finally:
+            set_random_number_generator(random)
+        if weighted:
+            rng = random.Random(seed)
+            graph.es["weight"] = [
+                rng.uniform(1, 10) for _ in range(graph.ecount())
+            ]
+        _graph_cache[key] = graph
+    return graph
+
+
+def min_time(func, repeat=5, number=1):
+    """Returns the best wall-clock time of C{func} out of C{repeat} runs."""
+    return min(timeit.repeat(func, repeat=repeat, number=number)) / number
+
+
+def binding_overhead(full, core, repeat=5, number=1):
+    """Estimates the share of the binding layer in the running time of an
+    operation.
+
+    C{full} performs the operation through the usual, convenient Python
+    API (e.g., passing lists and returning lists), while C{core} performs
+    the same operation with the inputs already in the form the C core
+    needs and without converting the result (e.g., passing buffers and
+    returning buffers). The difference of their running times is the
+    time spent in the binding layer.
+
+    @return: the binding overhead in percent of the running time of
+      C{full}.
+    """
+    full_time = min_time(full, repeat, number)
+    core_time = min_time(core, repeat, number)
+    if full_time <= 0:
+        return 0.0
+    return max(full_time - core_time, 0.0) / full_time * 100.0
@@ -0,0 +1,497 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#include <Python.h>
+#include "adjacency.h"
+#include "attributes.h"
+#include "py2compat.h"
+#include <stdlib.h>
+
+/**
+ * \ingroup python_interface_adjacency
+ * \brief Number of single-vertex queries that have to hit the same version
+ *        of a graph before its adjacency lists are built.
+ *
+ * Building the lists takes time linear in the size of the graph, which is
+ * a bad deal if the graph is modified between every couple of queries.
+ */
+#define IGRAPHMODULE_ADJACENCY_LAZY_QUERIES 32
+
+/**
+ * \ingroup python_interface_adjacency
+ * \brief Builds the adjacency lists of a graph for the given neighbor mode.
+ *
+ * \param result the new lists with a reference count of one are returned
+ *        here
+ * \return \c IGRAPH_SUCCESS or \c IGRAPH_ENOMEM
+ */
+int igraphmodule_adjacency_build(const igraph_t *graph, igraph_neimode_t mode,
+    igraphmodule_adjacency_t **result) {
+  igraphmodule_adjacency_t *adj;
+  igraph_bool_t directed = igraph_is_directed(graph);
+  long int no_of_nodes = igraph_vcount(graph);
+  long int v, i1, i2, j1, j2, e, e1, e2, n1, n2, k = 0;
+  const igraph_real_t *os = VECTOR(graph->os), *is = VECTOR(graph->is);
+  const igraph_real_t *oi = VECTOR(graph->oi), *ii = VECTOR(graph->ii);
+  const igraph_real_t *from = VECTOR(graph->from), *to = VECTOR(graph->to);
+  size_t total = 0;
+
+  *result = 0;
+
+  if (!directed)
+    mode = IGRAPH_ALL;
+
+  if (mode & IGRAPH_OUT)
+    total += igraph_ecount(graph);
+  if (mode & IGRAPH_IN)
+    total += igraph_ecount(graph);
+
+  adj = (igraphmodule_adjacency_t*) calloc(1, sizeof(igraphmodule_adjacency_t));
+  if (adj == 0)
+    return IGRAPH_ENOMEM;
+
+  adj->refcount = 1;
+  adj->no_of_nodes = no_of_nodes;
+  adj->offsets = (long int*) malloc((no_of_nodes + 1) * sizeof(long int));
+  adj->neighbors = (long int*) malloc((total > 0 ? total : 1) * sizeof(long int));
+  adj->edges = (long int*) malloc((total > 0 ? total : 1) * sizeof(long int));
+  if (adj->offsets == 0 || adj->neighbors == 0 || adj->edges == 0) {
+    igraphmodule_adjacency_decref(adj);
+    return IGRAPH_ENOMEM;
+  }
+
+#define PUSH(nei, eid) { adj->neighbors[k] = (nei); adj->edges[k] = (eid); k++; }
+
+  /* The order of the neighbors is the same as in igraph_neighbors() and
+   * the order of the edges is the same as in igraph_incident() */
+  for (v = 0; v < no_of_nodes; v++) {
+    adj->offsets[v] = k;
+    i1 = (long int) os[v]; j1 = (long int) os[v + 1];
+    i2 = (long int) is[v]; j2 = (long int) is[v + 1];
+
+    if (!directed || mode != IGRAPH_ALL) {
+      if (mode & IGRAPH_OUT) {
+        for (; i1 < j1; i1++) {
+          e1 = (long int) oi[i1];
+          PUSH((long int) to[e1], e1);
+        }
+      }
+      if (mode & IGRAPH_IN) {
+        for (; i2 < j2; i2++) {
+          e2 = (long int) ii[i2];
+          PUSH((long int) from[e2], e2);
+        }
+      }
+    } else {
+      /* igraph_incident() lists the out-edges first, then the in-edges */
+      for (e = 0; e < j1 - i1; e++) {
+        adj->edges[k + e] = (long int) oi[i1 + e];
+      }
+      for (e = 0; e < j2 - i2; e++) {
+        adj->edges[k + j1 - i1 + e] = (long int) ii[i2 + e];
+      }
+
+      /* igraph_neighbors() merges the out- and in-neighbors */
+      while (i1 < j1 && i2 < j2) {
+        n1 = (long int) to[(long int) oi[i1]];
+        n2 = (long int) from[(long int) ii[i2]];
+        if (n1 < n2) {
+          adj->neighbors[k++] = n1; i1++;
+        } else if (n1 > n2) {
+          adj->neighbors[k++] = n2; i2++;
+        } else {
+          adj->neighbors[k++] = n1; adj->neighbors[k++] = n2; i1++; i2++;
+        }
+      }
+      for (; i1 < j1; i1++) {
+        adj->neighbors[k++] = (long int) to[(long int) oi[i1]];
+      }
+      for (; i2 < j2; i2++) {
+        adj->neighbors[k++] = (long int) from[(long int) ii[i2]];
+      }
+    }
+  }
+  adj->offsets[no_of_nodes] = k;
+
+#undef PUSH
+
+  *result = adj;
+  return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup python_interface_adjacency
+ * \brief Takes a new reference to the adjacency lists
+ */
+void igraphmodule_adjacency_incref(igraphmodule_adjacency_t *adj) {
+  adj->refcount++;
+}
+
+/**
+ * \ingroup python_interface_adjacency
+ * \brief Releases a reference to the adjacency lists, freeing them when the
+ *        last reference is gone. A null pointer is ignored.
+ */
+void igraphmodule_adjacency_decref(igraphmodule_adjacency_t *adj) {
+  if (adj == 0 || --adj->refcount > 0)
+    return;
+
+  free(adj->offsets);
+  free(adj->neighbors);
+  free(adj->edges);
+  free(adj);
+}
+
+/**
+ * \ingroup python_interface_adjacency
+ * \brief Returns the number of bytes used by the adjacency lists
+ */
+size_t igraphmodule_adjacency_bytes(const igraphmodule_adjacency_t *adj) {
+  if (adj == 0)
+    return 0;
+  return sizeof(igraphmodule_adjacency_t) +
+    (adj->no_of_nodes + 1) * sizeof(long int) +
+    2 * adj->offsets[adj->no_of_nodes] * sizeof(long int);
+}
+
+/**
+ * \ingroup python_interface_adjacency
+ * \brief Returns the cached adjacency lists of a graph, building them if
+ *        needed.
+ *
+ * Must be called with the GIL held. The lists are built while holding the
+ * GIL so that no other thread can modify the graph in the meantime.
+ *
+ * \param mode the neighbor mode; ignored for undirected graphs
+ * \param eager whether the lists should be built right now if they do not
+ *        exist yet. Callers that query a single vertex should pass false;
+ *        the lists are then built only if the graph has been queried many
+ *        times since it last changed.
+ * \return the lists (a borrowed reference), or \c NULL if the caller should
+ *         query the C core directly. No exception is raised in this case.
+ */
+igraphmodule_adjacency_t* igraphmodule_get_adjacency(const igraph_t *graph,
+    igraph_neimode_t mode, igraph_bool_t eager) {
+  igraphmodule_i_attribute_struct *attrs = ATTR_STRUCT(graph);
+  igraphmodule_adjacency_t *adj;
+
+  if (attrs == 0)
+    return 0;
+
+  if (!igraph_is_directed(graph))
+    mode = IGRAPH_ALL;
+  if (mode != IGRAPH_OUT && mode != IGRAPH_IN && mode != IGRAPH_ALL)
+    return 0;
+
+  if (attrs->adjacency[mode - 1])
+    return attrs->adjacency[mode - 1];
+
+  if (!eager && ++attrs->adjacency_queries < IGRAPHMODULE_ADJACENCY_LAZY_QUERIES)
+    return 0;
+
+  /* if we are out of memory, we simply let the C core do its job */
+  if (igraphmodule_adjacency_build(graph, mode, &adj))
+    return 0;
+
+  attrs->adjacency[mode - 1] = adj;
+  return adj;
+}
+
+/**
+ * \ingroup python_interface_adjacency
+ * \brief Returns a new reference to the adjacency lists of a graph, for
+ *        objects that keep using the lists after the call.
+ *
+ * The cached lists are used (and built if needed); if the graph cannot
+ * cache them, lists of its own are built for the caller. Must be called
+ * with the GIL held.
+ *
+ * \return the lists or \c NULL if there was not enough memory, in which
+ *         case a \c MemoryError is raised
+ */
+igraphmodule_adjacency_t* igraphmodule_acquire_adjacency(const igraph_t *graph,
+    igraph_neimode_t mode) {
+  igraphmodule_adjacency_t *adj = igraphmodule_get_adjacency(graph, mode, 1);
+
+  if (adj) {
+    igraphmodule_adjacency_incref(adj);
+  } else if (igraphmodule_adjacency_build(graph, mode, &adj)) {
+    PyErr_NoMemory();
+    return 0;
+  }
+
+  return adj;
+}
+
+/**
+ * \ingroup python_interface_adjacency
+ * \brief Returns the neighbors or the incident edges of a vertex as a
+ *        Python list
+ *
+ * \param edges whether to return the incident edges instead of the
+ *        neighbors
+ */
+PyObject* igraphmodule_adjacency_to_PyList(const igraphmodule_adjacency_t *adj,
+    long int vid, igraph_bool_t edges) {
+  const long int *items = (edges ? adj->edges : adj->neighbors) + adj->offsets[vid];
+  long int i, n = IGRAPHMODULE_ADJACENCY_DEGREE(adj, vid);
+  PyObject *result, *item;
+
+  result = PyList_New(n);
+  if (result == 0)
+    return 0;
+
+  for (i = 0; i < n; i++) {
+    item = PyInt_FromLong(items[i]);
+    if (item == 0) {
+      Py_DECREF(result);
+      return 0;
+    }
+    PyList_SET_ITEM(result, i, item);
+  }
+
+  return result;
+}
+
+/**
+ * \ingroup python_interface_adjacency
+ * \brief Workspace of the breadth-first searches of the neighborhood queries
+ */
+typedef struct {
+  long int *added, *queue, *dist, *found;
+} igraphmodule_i_adjacency_bfs_t;
+
+static void igraphmodule_i_adjacency_bfs_destroy(igraphmodule_i_adjacency_bfs_t *bfs) {
+  free(bfs->added);
+  free(bfs->queue);
+  free(bfs->dist);
+  free(bfs->found);
+}
+
+static int igraphmodule_i_adjacency_bfs_init(igraphmodule_i_adjacency_bfs_t *bfs,
+    long int no_of_nodes) {
+  size_t n = no_of_nodes > 0 ? no_of_nodes : 1;
+
+  bfs->added = (long int*) calloc(n, sizeof(long int));
+  bfs->queue = (long int*) malloc(n * sizeof(long int));
+  bfs->dist = (long int*) malloc(n * sizeof(long int));
+  bfs->found = (long int*) malloc(n * sizeof(long int));
+  if (bfs->added == 0 || bfs->queue == 0 || bfs->dist == 0 || bfs->found == 0) {
+    igraphmodule_i_adjacency_bfs_destroy(bfs);
+    return IGRAPH_ENOMEM;
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup python_interface_adjacency
+ * \brief Collects the vertices reachable from a vertex in at most \p order
+ *        steps into \c bfs->found, in the order of \c igraph_neighborhood().
+ *
+ * \param stamp a positive number that is different for every search done
+ *        with the same workspace
+ * \return the number of vertices found
+ */
+static long int igraphmodule_i_adjacency_bfs(const igraphmodule_adjacency_t *adj,
+    igraphmodule_i_adjacency_bfs_t *bfs, long int node, long int stamp,
+    long int order, long int mindist) {
+  long int *added = bfs->added, *queue = bfs->queue, *dist = bfs->dist;
+  long int *found = bfs->found;
+  long int j, head = 0, tail = 0, count = 0, nei, end;
+
+  added[node] = stamp;
+  if (mindist == 0)
+    found[count++] = node;
+  if (order > 0) {
+    queue[tail] = node; dist[tail] = 0; tail++;
+  }
+
+  while (head < tail) {
+    long int actnode = queue[head], actdist = dist[head];
+    head++;
+
+    end = adj->offsets[actnode + 1];
+    for (j = adj->offsets[actnode]; j < end; j++) {
+      nei = adj->neighbors[j];
+      if (added[nei] == stamp)
+        continue;
+      added[nei] = stamp;
+      if (actdist < order - 1) {
+        queue[tail] = nei; dist[tail] = actdist + 1; tail++;
+      }
+      if (actdist + 1 >= mindist)
+        found[count++] = nei;
+    }
+  }
+
+  return count;
+}
+
+/**
+ * \ingroup python_interface_adjacency
+ * \brief Finds the vertices reachable from some vertices in at most
+ *        \p order steps, just like \c igraph_neighborhood() and
+ *        \c igraph_neighborhood_size() do.
+ *
+ * The vertices are listed in the same order as by \c igraph_neighborhood().
+ * May be called without the GIL.
+ *
+ * \param vids the IDs of the start vertices
+ * \param order the number of steps; must be non-negative
+ * \param mindist the minimum distance of the vertices to be included;
+ *        must be between zero and \p order
+ * \param result an initialized pointer vector that is resized to hold a
+ *        newly allocated vector for every vertex, or \c NULL if only the
+ *        sizes are needed
+ * \param sizes an initialized vector that is resized to hold the size of
+ *        the neighborhood of every vertex, or \c NULL
+ * \return \c IGRAPH_SUCCESS or \c IGRAPH_ENOMEM
+ */
+int igraphmodule_adjacency_neighborhood(const igraphmodule_adjacency_t *adj,
+    const igraph_vector_t *vids, long int order, long int mindist,
+    igraph_vector_ptr_t *result, igraph_vector_t *sizes) {
+  long int nv = igraph_vector_size(vids);
+  long int i, k, count;
+  igraphmodule_i_adjacency_bfs_t bfs;
+  igraph_vector_t *v;
+  int retval;
+
+  retval = igraphmodule_i_adjacency_bfs_init(&bfs, adj->no_of_nodes);
+  if (retval)
+    return retval;
+
+  if (result && igraph_vector_ptr_resize(result, nv)) {
+    retval = IGRAPH_ENOMEM;
+    goto cleanup;
+  }
+  if (result) {
+    igraph_vector_ptr_null(result);
+  }
+  if (sizes && igraph_vector_resize(sizes, nv)) {
+    retval = IGRAPH_ENOMEM;
+    goto cleanup;
+  }
+
+  for (i = 0; i < nv; i++) {
+    count = igraphmodule_i_adjacency_bfs(adj, &bfs, (long int) VECTOR(*vids)[i],
+        i + 1, order, mindist);
+
+    if (sizes) {
+      VECTOR(*sizes)[i] = count;
+    }
+
+    if (result) {
+      v = (igraph_vector_t*) malloc(sizeof(igraph_vector_t));
+      if (v == 0 || igraph_vector_init(v, count)) {
+        free(v);
+        retval = IGRAPH_ENOMEM;
+        break;
+      }
+      for (k = 0; k < count; k++) {
+        VECTOR(*v)[k] = bfs.found[k];
+      }
+      VECTOR(*result)[i] = v;
+    }
+  }
+
+  if (retval && result) {
+    for (i = 0; i < nv; i++) {
+      v = (igraph_vector_t*) VECTOR(*result)[i];
+      if (v) {
+        igraph_vector_destroy(v);
+        free(v);
+      }
+    }
+    igraph_vector_ptr_clear(result);
+  }
+
+cleanup:
+  igraphmodule_i_adjacency_bfs_destroy(&bfs);
+
+  return retval;
+}
+
+/**
+ * \ingroup python_interface_adjacency
+ * \brief Finds the vertices reachable from some vertices in at most
+ *        \p order steps and stores them in the compressed sparse row format.
+ *
+ * Same as \ref igraphmodule_adjacency_neighborhood(), but the neighborhood
+ * of \c vids[i] is written to <tt>ids[offsets[i]]</tt> to
+ * <tt>ids[offsets[i+1]-1]</tt> instead of a vector of its own. May be called
+ * without the GIL.
+ *
+ * \param offsets an initialized vector that is resized to the number of
+ *        start vertices plus one
+ * \param ids an initialized vector that is resized to hold all the
+ *        neighborhoods
+ * \return \c IGRAPH_SUCCESS or \c IGRAPH_ENOMEM
+ */
+int igraphmodule_adjacency_neighborhood_csr(const igraphmodule_adjacency_t *adj,
+    const igraph_vector_t *vids, long int order, long int mindist,
+    igraph_vector_long_t *offsets, igraph_vector_long_t *ids) {
+  long int nv = igraph_vector_size(vids);
+  long int i, k, count, total = 0, capacity = 0;
+  igraphmodule_i_adjacency_bfs_t bfs;
+  int retval;
+
+  retval = igraphmodule_i_adjacency_bfs_init(&bfs, adj->no_of_nodes);
+  if (retval)
+    return retval;
+
+  if (igraph_vector_long_resize(offsets, nv + 1)) {
+    retval = IGRAPH_ENOMEM;
+    goto cleanup;
+  }
+  igraph_vector_long_clear(ids);
+
+  for (i = 0; i < nv; i++) {
+    VECTOR(*offsets)[i] = total;
+    count = igraphmodule_i_adjacency_bfs(adj, &bfs, (long int) VECTOR(*vids)[i],
+        i + 1, order, mindist);
+    /* igraph_vector_long_resize() would reallocate to the exact size */
+    if (total + count > capacity) {
+      capacity = (2 * capacity > total + count) ? 2 * capacity : total + count;
+      if (igraph_vector_long_reserve(ids, capacity)) {
+        retval = IGRAPH_ENOMEM;
+        break;
+      }
+    }
+    if (igraph_vector_long_resize(ids, total + count)) {
+      retval = IGRAPH_ENOMEM;
+      break;
+    }
+    for (k = 0; k < count; k++) {
+      VECTOR(*ids)[total + k] = bfs.found[k];
+    }
+    total += count;
+  }
+  VECTOR(*offsets)[nv] = total;
+
+cleanup:
+  igraphmodule_i_adjacency_bfs_destroy(&bfs);
+
+  return retval;
+}
@@ -0,0 +1,90 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#ifndef PYTHON_ADJACENCY_H
+#define PYTHON_ADJACENCY_H
+
+#include <Python.h>
+#include <igraph.h>
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_adjacency Cached adjacency lists
+ *
+ * The neighbors and the incident edges of all the vertices of a graph for
+ * a given neighbor mode, stored in the compressed sparse row format and in
+ * the same order as returned by \c igraph_neighbors() and
+ * \c igraph_incident(). The lists of a graph are built once and kept in
+ * its attribute table until the graph is modified, so that traversals
+ * and neighbor queries do not query the C core vertex by vertex on every
+ * call.
+ *
+ * The lists are reference counted: adding vertices or edges drops the
+ * reference held by the graph, but objects that took a reference of their
+ * own (such as the BFS and DFS iterators) may still use them. Apart from
+ * the reference counting (which needs the GIL), the functions below do not
+ * touch Python objects.
+ */
+
+/**
+ * \ingroup python_interface_adjacency
+ * \brief Adjacency lists of a graph in the compressed sparse row format
+ */
+typedef struct igraphmodule_adjacency_s {
+  long int refcount;
+  long int no_of_nodes;
+  // neighbors[offsets[v]] to neighbors[offsets[v+1]-1] are the neighbors
+  // of vertex v, edges[] holds the IDs of the incident edges in the same
+  // range. The two match item by item, except for IGRAPH_ALL in directed
+  // graphs where igraph_neighbors() merges the out- and in-neighbors but
+  // igraph_incident() lists the out-edges first
+  long int *offsets;
+  long int *neighbors;
+  long int *edges;
+} igraphmodule_adjacency_t;
+
+#define IGRAPHMODULE_ADJACENCY_DEGREE(adj, v) \
+  ((adj)->offsets[(v)+1] - (adj)->offsets[(v)])
+
+int igraphmodule_adjacency_build(const igraph_t *graph, igraph_neimode_t mode,
+    igraphmodule_adjacency_t **result);
+void igraphmodule_adjacency_incref(igraphmodule_adjacency_t *adj);
+void igraphmodule_adjacency_decref(igraphmodule_adjacency_t *adj);
+size_t igraphmodule_adjacency_bytes(const igraphmodule_adjacency_t *adj);
+
+igraphmodule_adjacency_t* igraphmodule_get_adjacency(const igraph_t *graph,
+    igraph_neimode_t mode, igraph_bool_t eager);
+igraphmodule_adjacency_t* igraphmodule_acquire_adjacency(const igraph_t *graph,
+    igraph_neimode_t mode);
+PyObject* igraphmodule_adjacency_to_PyList(const igraphmodule_adjacency_t *adj,
+    long int vid, igraph_bool_t edges);
+
+int igraphmodule_adjacency_neighborhood(const igraphmodule_adjacency_t *adj,
+    const igraph_vector_t *vids, long int order, long int mindist,
+    igraph_vector_ptr_t *result, igraph_vector_t *sizes);
+int igraphmodule_adjacency_neighborhood_csr(const igraphmodule_adjacency_t *adj,
+    const igraph_vector_t *vids, long int order, long int mindist,
+    igraph_vector_long_t *offsets, igraph_vector_long_t *ids);
+
+#endif
@@ -20,7 +20,10 @@
 
 */
 
+#include <math.h>
+#include <string.h>
 #include "arpackobject.h"
+#include "common.h"
 #include "graphobject.h"
 #include "error.h"
 #include "py2compat.h"
@@ -279,3 +282,429 @@ PyTypeObject igraphmodule_ARPACKOptionsType = {
   0,                                          /* tp_free */
 };
 
+
+/**
+ * \ingroup python_interface_arpack
+ * \brief Data passed to the matrix-vector product of an ARPACK session
+ */
+typedef struct {
+  const igraph_t *graph;
+  const igraph_vector_t *weights;
+  igraphmodule_arpack_problem_t problem;
+  igraph_real_t *tmp;
+} igraphmodule_i_ARPACKSession_extra_t;
+
+/**
+ * \ingroup python_interface_arpack
+ * \brief Multiplies a vector with the matrix of the eigenproblem.
+ *
+ * The products are calculated straight from the edge list of the graph.
+ * Writing A for the (weighted) adjacency matrix, the matrices are A for
+ * undirected eigenvector centralities, A^T for directed ones, A A^T for hub
+ * scores and A^T A for authority scores. Edges of undirected graphs count in
+ * both directions.
+ */
+static int igraphmodule_i_ARPACKSession_matvec(igraph_real_t *to,
+    const igraph_real_t *from, int n, void *data) {
+  igraphmodule_i_ARPACKSession_extra_t *extra =
+    (igraphmodule_i_ARPACKSession_extra_t*)data;
+  const igraph_t *graph = extra->graph;
+  igraph_bool_t directed = igraph_is_directed(graph);
+  igraph_real_t w, *tmp = extra->tmp;
+  long int e, u, v, m = igraph_ecount(graph);
+
+#define WEIGHT(e) (extra->weights ? VECTOR(*extra->weights)[e] : 1.0)
+
+  memset(to, 0, sizeof(igraph_real_t) * n);
+
+  switch (extra->problem) {
+    case IGRAPHMODULE_ARPACK_EIGENVECTOR_CENTRALITY:
+      for (e = 0; e < m; e++) {
+        u = IGRAPH_FROM(graph, e); v = IGRAPH_TO(graph, e); w = WEIGHT(e);
+        to[u] += w * from[v];
+        to[v] += w * from[u];
+      }
+      break;
+
+    case IGRAPHMODULE_ARPACK_EIGENVECTOR_CENTRALITY_DIRECTED:
+      for (e = 0; e < m; e++) {
+        u = IGRAPH_FROM(graph, e); v = IGRAPH_TO(graph, e); w = WEIGHT(e);
+        to[v] += w * from[u];
+      }
+      break;
+
+    case IGRAPHMODULE_ARPACK_HUB_SCORE:
+    case IGRAPHMODULE_ARPACK_AUTHORITY_SCORE:
+      {
+        /* hub scores: tmp = A^T x, to = A tmp; authority scores the other
+         * way round */
+        igraph_bool_t hub = (extra->problem == IGRAPHMODULE_ARPACK_HUB_SCORE);
+        memset(tmp, 0, sizeof(igraph_real_t) * n);
+        for (e = 0; e < m; e++) {
+          u = IGRAPH_FROM(graph, e); v = IGRAPH_TO(graph, e); w = WEIGHT(e);
+          if (!directed) {
+            tmp[u] += w * from[v];
+            tmp[v] += w * from[u];
+          } else if (hub) {
+            tmp[v] += w * from[u];
+          } else {
+            tmp[u] += w * from[v];
+          }
+        }
+        for (e = 0; e < m; e++) {
+          u = IGRAPH_FROM(graph, e); v = IGRAPH_TO(graph, e); w = WEIGHT(e);
+          if (!directed) {
+            to[u] += w * tmp[v];
+            to[v] += w * tmp[u];
+          } else if (hub) {
+            to[u] += w * tmp[v];
+          } else {
+            to[v] += w * tmp[u];
+          }
+        }
+      }
+      break;
+
+    default:
+      IGRAPH_ERROR("invalid ARPACK session problem", IGRAPH_EINVAL);
+  }
+
+#undef WEIGHT
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_arpack
+ * \brief Finds the leading eigenvector of an eigenproblem with the session.
+ *
+ * The ARPACK work arrays of the session are allocated on the first call and
+ * reused as long as they are large enough. If the last call solved the same
+ * kind of problem on a graph with the same number of vertices, its result is
+ * used as the starting vector, so ARPACK converges quickly when the graph
+ * changed only a little; the degrees (strengths) of the vertices are used
+ * otherwise. The iteration statistics of the call are available from the
+ * attributes inherited from \c ARPACKOptions.
+ *
+ * \param self     the session
+ * \param graph    the graph
+ * \param problem  the eigenproblem to solve
+ * \param scale    whether to scale the result so that its largest element
+ *                 is one; the result has unit length otherwise
+ * \param weights  edge weights or a null pointer
+ * \param vector   the eigenvector is returned here
+ * \param value    the eigenvalue is returned here
+ * \return error code
+ */
+int igraphmodule_ARPACKSession_solve(igraphmodule_ARPACKSessionObject *self,
+    const igraph_t *graph, igraphmodule_arpack_problem_t problem,
+    igraph_bool_t scale, const igraph_vector_t *weights,
+    igraph_vector_t *vector, igraph_real_t *value) {
+  long int i, which, n = igraph_vcount(graph), m = igraph_ecount(graph);
+  igraph_bool_t symmetric = (problem != IGRAPHMODULE_ARPACK_EIGENVECTOR_CENTRALITY_DIRECTED);
+  igraphmodule_i_ARPACKSession_extra_t extra;
+  igraph_arpack_options_t *options;
+  igraph_matrix_t vectors, complex_values;
+  igraph_vector_t values, tmp;
+  igraph_real_t amax;
+  double started = igraphmodule_clock();
+  int ncv;
+
+  options = igraphmodule_ARPACKOptions_get(&self->base);
+  self->warm = 0;
+
+  if (weights && igraph_vector_size(weights) != m) {
+    IGRAPH_ERROR("weight vector length must match the number of edges",
+        IGRAPH_EINVAL);
+  }
+
+  if (m == 0) {
+    /* special case: the matrix is all zeros */
+    IGRAPH_CHECK(igraph_vector_resize(vector, n));
+    igraph_vector_fill(vector, 1);
+    *value = 0;
+    self->time = igraphmodule_clock() - started;
+    return IGRAPH_SUCCESS;
+  }
+
+  /* (Re)allocate the work arrays if they are too small for this graph */
+  ncv = options->ncv > 20 ? options->ncv : 20;
+  if (!self->has_storage || self->storage.maxn < n || self->storage.maxncv < ncv) {
+    if (self->has_storage) {
+      igraph_arpack_storage_destroy(&self->storage);
+      self->has_storage = 0;
+    }
+    IGRAPH_CHECK(igraph_arpack_storage_init(&self->storage, n, ncv, n,
+          /* symm = */ 0));
+    self->has_storage = 1;
+  }
+
+  IGRAPH_MATRIX_INIT_FINALLY(&vectors, n, 1);
+  IGRAPH_VECTOR_INIT_FINALLY(&tmp, n);
+
+  if (self->last_problem == problem && igraph_vector_size(&self->last) == n) {
+    /* warm start from the last result */
+    for (i = 0; i < n; i++)
+      MATRIX(vectors, i, 0) = VECTOR(self->last)[i];
+    self->warm = 1;
+  } else {
+    /* cold start from the degrees, like the C core of igraph */
+    igraph_neimode_t mode = IGRAPH_ALL;
+    if (problem == IGRAPHMODULE_ARPACK_EIGENVECTOR_CENTRALITY_DIRECTED ||
+        problem == IGRAPHMODULE_ARPACK_AUTHORITY_SCORE)
+      mode = IGRAPH_IN;
+    else if (problem == IGRAPHMODULE_ARPACK_HUB_SCORE)
+      mode = IGRAPH_OUT;
+    IGRAPH_CHECK(igraph_strength(graph, &tmp, igraph_vss_all(), mode,
+          IGRAPH_LOOPS, weights));
+    for (i = 0; i < n; i++)
+      MATRIX(vectors, i, 0) = VECTOR(tmp)[i] ? VECTOR(tmp)[i] : 1.0;
+  }
+
+  options->n = (int) n;
+  options->nev = 1;
+  options->ncv = 0;   /* ARPACK chooses it */
+  options->ldv = 0;
+  options->start = 1;
+  options->info = 1;
+  options->which[0] = 'L';
+  options->which[1] = symmetric ? 'A' : 'R';
+
+  extra.graph = graph;
+  extra.weights = weights;
+  extra.problem = problem;
+  extra.tmp = VECTOR(tmp);
+
+  if (symmetric) {
+    IGRAPH_VECTOR_INIT_FINALLY(&values, 1);
+    IGRAPH_CHECK(igraph_arpack_rssolve(igraphmodule_i_ARPACKSession_matvec,
+          &extra, options, &self->storage, &values, &vectors));
+    *value = VECTOR(values)[0];
+    igraph_vector_destroy(&values);
+    IGRAPH_FINALLY_CLEAN(1);
+  } else {
+    IGRAPH_MATRIX_INIT_FINALLY(&complex_values, 1, 2);
+    IGRAPH_CHECK(igraph_arpack_rnsolve(igraphmodule_i_ARPACKSession_matvec,
+          &extra, options, &self->storage, &complex_values, &vectors));
+    *value = MATRIX(complex_values, 0, 0);
+    igraph_matrix_destroy(&complex_values);
+    IGRAPH_FINALLY_CLEAN(1);
+  }
+
+  IGRAPH_CHECK(igraph_vector_resize(vector, n));
+  for (i = 0; i < n; i++)
+    VECTOR(*vector)[i] = MATRIX(vectors, i, 0);
+
+  igraph_vector_destroy(&tmp);
+  igraph_matrix_destroy(&vectors);
+  IGRAPH_FINALLY_CLEAN(2);
+
+  /* Remember the result for the next call */
+  IGRAPH_CHECK(igraph_vector_update(&self->last, vector));
+  self->last_problem = problem;
+
+  /* Make the largest element positive and scale */
+  amax = 0; which = 0;
+  for (i = 0; i < n; i++) {
+    if (fabs(VECTOR(*vector)[i]) > amax) {
+      amax = fabs(VECTOR(*vector)[i]);
+      which = i;
+    }
+  }
+  if (VECTOR(*vector)[which] < 0)
+    igraph_vector_scale(vector, -1);
+  if (scale && amax != 0)
+    igraph_vector_scale(vector, 1 / amax);
+
+  self->time = igraphmodule_clock() - started;
+
+  return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup python_interface_arpack
+ * \brief Allocates a new ARPACK session object
+ */
+static PyObject* igraphmodule_ARPACKSession_new(PyTypeObject *type,
+    PyObject *args, PyObject *kwds) {
+  igraphmodule_ARPACKSessionObject* self;
+
+  if (!PyArg_ParseTuple(args, ""))
+    return NULL;
+
+  self = PyObject_New(igraphmodule_ARPACKSessionObject,
+    &igraphmodule_ARPACKSessionType);
+  if (self == 0)
+    return NULL;
+
+  igraph_arpack_options_init(&self->base.params);
+  igraph_arpack_options_init(&self->base.params_out);
+  self->has_storage = 0;
+  self->last_problem = IGRAPHMODULE_ARPACK_NONE;
+  self->warm = 0;
+  self->time = 0;
+  if (igraph_vector_init(&self->last, 0)) {
+    /* the object is not fully initialized, so it is freed here */
+    PyObject_Del((PyObject*)self);
+    return igraphmodule_handle_igraph_error();
+  }
+
+  return (PyObject*)self;
+}
+
+/**
+ * \ingroup python_interface_arpack
+ * \brief Deallocates an ARPACK session object and its workspace
+ */
+static void igraphmodule_ARPACKSession_dealloc(
+  igraphmodule_ARPACKSessionObject* self) {
+  if (self->has_storage)
+    igraph_arpack_storage_destroy(&self->storage);
+  igraph_vector_destroy(&self->last);
+  PyObject_Del((PyObject*)self);
+}
+
+/**
+ * \ingroup python_interface_arpack
+ * \brief Looks up an attribute of an ARPACK session object, falling back to
+ *        the parameters inherited from \c ARPACKOptions
+ */
+static PyObject* igraphmodule_ARPACKSession_getattro(
+  igraphmodule_ARPACKSessionObject* self, PyObject* name) {
+  PyObject *result;
+  char *attrname;
+
+  result = PyObject_GenericGetAttr((PyObject*)self, name);
+  if (result != 0 || !PyErr_ExceptionMatches(PyExc_AttributeError))
+    return result;
+
+  attrname = PyString_CopyAsString(name);
+  if (attrname == 0)
+    return NULL;
+  PyErr_Clear();
+  result = igraphmodule_ARPACKOptions_getattr(&self->base, attrname);
+  free(attrname);
+
+  return result;
+}
+
+/**
+ * \ingroup python_interface_arpack
+ * \brief Forgets the starting vector of the session
+ */
+static PyObject* igraphmodule_ARPACKSession_reset(
+  igraphmodule_ARPACKSessionObject* self) {
+  igraph_vector_clear(&self->last);
+  self->last_problem = IGRAPHMODULE_ARPACK_NONE;
+  Py_RETURN_NONE;
+}
+
+/** \ingroup python_interface_arpack
+ * \brief Returns whether the last call was warm-started
+ */
+static PyObject* igraphmodule_ARPACKSession_get_warm_start(
+  igraphmodule_ARPACKSessionObject* self, void* closure) {
+  if (self->warm)
+    Py_RETURN_TRUE;
+  Py_RETURN_FALSE;
+}
+
+/** \ingroup python_interface_arpack
+ * \brief Returns the time taken by the last call
+ */
+static PyObject* igraphmodule_ARPACKSession_get_time(
+  igraphmodule_ARPACKSessionObject* self, void* closure) {
+  return PyFloat_FromDouble(self->time);
+}
+
+/**
+ * \ingroup python_interface_arpack
+ * Method table for the \c igraph.ARPACKSession object
+ */
+static PyMethodDef igraphmodule_ARPACKSession_methods[] = {
+  {"reset", (PyCFunction)igraphmodule_ARPACKSession_reset, METH_NOARGS,
+    "reset()\n\n"
+    "Forgets the result of the last computation, so the next one starts\n"
+    "from scratch. The work arrays are kept.\n"
+  },
+  {NULL}
+};
+
+/**
+ * \ingroup python_interface_arpack
+ * Getter/setter table for the \c igraph.ARPACKSession object
+ */
+static PyGetSetDef igraphmodule_ARPACKSession_getseters[] = {
+  {"warm_start", (getter)igraphmodule_ARPACKSession_get_warm_start, NULL,
+    "Whether the last computation started from the result of the previous one",
+    NULL
+  },
+  {"time", (getter)igraphmodule_ARPACKSession_get_time, NULL,
+    "Wall clock time taken by the last computation in seconds", NULL
+  },
+  {NULL}
+};
+
+/** \ingroup python_interface_arpack
+ * Python type object referencing the methods Python calls when it performs
+ * various operations on an ARPACK session object
+ */
+PyTypeObject igraphmodule_ARPACKSessionType = {
+  PyVarObject_HEAD_INIT(0, 0)
+  "igraph.ARPACKSession",                     /* tp_name */
+  sizeof(igraphmodule_ARPACKSessionObject),   /* tp_basicsize */
+  0,                                          /* tp_itemsize */
+  (destructor)igraphmodule_ARPACKSession_dealloc,      /* tp_dealloc */
+  0,                                          /* tp_print */
+  0,                                          /* tp_getattr */
+  0,                                          /* tp_setattr */
+  0,                                          /* tp_compare (2.x) / tp_reserved (3.x) */
+  0,                                          /* tp_repr */
+  0,                                          /* tp_as_number */
+  0,                                          /* tp_as_sequence */
+  0,                                          /* tp_as_mapping */
+  0,                                          /* tp_hash */
+  0,                                          /* tp_call */
+  0,                                          /* tp_str */
+  (getattrofunc)igraphmodule_ARPACKSession_getattro,   /* tp_getattro */
+  0,                                          /* tp_setattro */
+  0,                                          /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT,                         /* tp_flags */
+  "ARPACK parameters with a reusable workspace and a warm start.\n\n"
+  "An ARPACK session can be used wherever an L{ARPACKOptions} object\n"
+  "is accepted. When passed to L{Graph.eigenvector_centrality()},\n"
+  "L{Graph.hub_score()} or L{Graph.authority_score()}, the session\n"
+  "keeps the ARPACK work arrays between calls and starts the next\n"
+  "computation of the same kind from the last result instead of the\n"
+  "vertex degrees. When a graph changes only slightly between two\n"
+  "calls, the second one converges in a fraction of the operations.\n"
+  "Use a separate session for each kind of computation and each\n"
+  "graph that is tracked.\n\n"
+  "Besides the attributes of L{ARPACKOptions}, which describe the last\n"
+  "computation (e.g., C{numop} and C{iter}), the following are\n"
+  "available:\n\n"
+  " - C{warm_start}: whether the last computation started from the\n"
+  "   result of the previous one\n\n"
+  " - C{time}: wall clock time taken by the last computation in\n"
+  "   seconds\n\n"
+  "Other ARPACK-based methods accept sessions as plain parameter\n"
+  "objects, without the warm start.\n",      /* tp_doc */
+  0,                                          /* tp_traverse */
+  0,                                          /* tp_clear */
+  0,                                          /* tp_richcompare */
+  0,                                          /* tp_weaklistoffset */
+  0,                                          /* tp_iter */
+  0,                                          /* tp_iternext */
+  igraphmodule_ARPACKSession_methods,         /* tp_methods */
+  0,                                          /* tp_members */
+  igraphmodule_ARPACKSession_getseters,       /* tp_getset */
+  &igraphmodule_ARPACKOptionsType,            /* tp_base */
+  0,                                          /* tp_dict */
+  0,                                          /* tp_descr_get */
+  0,                                          /* tp_descr_set */
+  0,                                          /* tp_dictoffset */
+  0,                                          /* tp_init */
+  0,                                          /* tp_alloc */
+  (newfunc)igraphmodule_ARPACKSession_new,    /* tp_new */
+  0,                                          /* tp_free */
+};
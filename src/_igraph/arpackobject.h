@@ -49,7 +49,49 @@ void igraphmodule_ARPACKOptions_dealloc(igraphmodule_ARPACKOptionsObject* self);
 
 PyObject* igraphmodule_ARPACKOptions_new(void);
 PyObject* igraphmodule_ARPACKOptions_str(igraphmodule_ARPACKOptionsObject *self);
+PyObject* igraphmodule_ARPACKOptions_getattr(igraphmodule_ARPACKOptionsObject* self,
+    char* attrname);
 #define igraphmodule_ARPACKOptions_CheckExact(ob) ((ob)->ob_type == &igraphmodule_ARPACKOptionsType)
 igraph_arpack_options_t *igraphmodule_ARPACKOptions_get(igraphmodule_ARPACKOptionsObject *self);
 int igraphmodule_ARPACKOptions_Check(PyObject *ob);
+
+extern PyTypeObject igraphmodule_ARPACKSessionType;
+
+/**
+ * \ingroup python_interface_arpack
+ * \brief Eigenproblems that an ARPACK session can solve on its own
+ */
+typedef enum {
+  IGRAPHMODULE_ARPACK_NONE = 0,
+  IGRAPHMODULE_ARPACK_EIGENVECTOR_CENTRALITY,
+  IGRAPHMODULE_ARPACK_EIGENVECTOR_CENTRALITY_DIRECTED,
+  IGRAPHMODULE_ARPACK_HUB_SCORE,
+  IGRAPHMODULE_ARPACK_AUTHORITY_SCORE
+} igraphmodule_arpack_problem_t;
+
+/**
+ * \ingroup python_interface_arpack
+ * \brief ARPACK parameters together with a reusable workspace and the
+ *        eigenvector of the last computation, which is used as the
+ *        starting vector of the next one
+ */
+typedef struct {
+  igraphmodule_ARPACKOptionsObject base;
+  // Work arrays of ARPACK, kept between calls
+  igraph_arpack_storage_t storage;
+  igraph_bool_t has_storage;
+  // The eigenvector found by the last call and the problem it belongs to
+  igraph_vector_t last;
+  igraphmodule_arpack_problem_t last_problem;
+  // Whether the last call was warm-started and how long it took
+  igraph_bool_t warm;
+  double time;
+} igraphmodule_ARPACKSessionObject;
+
+#define igraphmodule_ARPACKSession_Check(ob) PyObject_TypeCheck((ob), &igraphmodule_ARPACKSessionType)
+
+int igraphmodule_ARPACKSession_solve(igraphmodule_ARPACKSessionObject *self,
+    const igraph_t *graph, igraphmodule_arpack_problem_t problem,
+    igraph_bool_t scale, const igraph_vector_t *weights,
+    igraph_vector_t *vector, igraph_real_t *value);
 #endif
@@ -22,8 +22,11 @@
 
 #include <Python.h>
 #include "attributes.h"
+#include "bufferobject.h"
+#include "columnobject.h"
 #include "common.h"
 #include "convert.h"
+#include "error.h"
 #include "py2compat.h"
 #include "pyhelpers.h"
 
@@ -36,6 +39,12 @@ int igraphmodule_i_attribute_struct_init(igraphmodule_i_attribute_struct *attrs)
     RC_ALLOC("dict", attrs->attrs[i]);
   }
   attrs->vertex_name_index = 0;
+  attrs->edge_vector_cache = 0;
+  attrs->edge_index = 0;
+  for (i=0; i<3; i++)
+    attrs->adjacency[i] = 0;
+  attrs->adjacency_queries = 0;
+  attrs->canonical_forms = 0;
   return 0;
 }
 
@@ -51,6 +60,17 @@ void igraphmodule_i_attribute_struct_destroy(igraphmodule_i_attribute_struct *at
     RC_DEALLOC("dict", attrs->vertex_name_index);
     Py_DECREF(attrs->vertex_name_index);
   }
+  if (attrs->edge_vector_cache) {
+    RC_DEALLOC("dict", attrs->edge_vector_cache);
+    Py_DECREF(attrs->edge_vector_cache);
+  }
+  igraphmodule_edge_index_destroy(attrs->edge_index);
+  for (i=0; i<3; i++)
+    igraphmodule_adjacency_decref(attrs->adjacency[i]);
+  if (attrs->canonical_forms) {
+    RC_DEALLOC("dict", attrs->canonical_forms);
+    Py_DECREF(attrs->canonical_forms);
+  }
 }
 
 int igraphmodule_i_attribute_struct_index_vertex_names(
@@ -121,6 +141,298 @@ void igraphmodule_invalidate_vertex_name_index(igraph_t *graph) {
   igraphmodule_i_attribute_struct_invalidate_vertex_name_index(ATTR_STRUCT(graph));
 }
 
+/**
+ * \brief Records the name of a single vertex in the vertex name index if
+ *        the index has already been built.
+ *
+ * The index maps each name to the smallest vertex ID having that name, just
+ * like a full rebuild would do. If the name cannot be added to the index
+ * (e.g., because it is not hashable), the index is simply invalidated; the
+ * error will be reported when the index is rebuilt.
+ */
+static void igraphmodule_i_attribute_struct_index_vertex_name(
+    igraphmodule_i_attribute_struct *attrs, PyObject* name, long int vid) {
+  PyObject *o_vid, *value;
+
+  if (attrs->vertex_name_index == 0)
+    return;
+
+  o_vid = PyDict_GetItem(attrs->vertex_name_index, name);
+  if (o_vid != 0 && PyInt_AsLong(o_vid) <= vid)
+    return;
+
+  value = PyInt_FromLong(vid);
+  if (value == 0 || PyDict_SetItem(attrs->vertex_name_index, name, value)) {
+    PyErr_Clear();
+    igraphmodule_i_attribute_struct_invalidate_vertex_name_index(attrs);
+  }
+  Py_XDECREF(value);
+}
+
+/**
+ * \brief Removes the name of a single vertex from the vertex name index if
+ *        the index has already been built.
+ *
+ * Another vertex with the same name may have to take over the entry, so the
+ * index is invalidated if the entry pointed to the given vertex.
+ */
+static void igraphmodule_i_attribute_struct_unindex_vertex_name(
+    igraphmodule_i_attribute_struct *attrs, PyObject* name, long int vid) {
+  PyObject *o_vid;
+
+  if (attrs->vertex_name_index == 0)
+    return;
+
+  o_vid = PyDict_GetItem(attrs->vertex_name_index, name);
+  if (o_vid == 0) {
+    PyErr_Clear();
+    return;
+  }
+
+  if (PyInt_AsLong(o_vid) == vid)
+    igraphmodule_i_attribute_struct_invalidate_vertex_name_index(attrs);
+}
+
+/**
+ * \brief Updates the vertex name index after the name of a single vertex
+ *        has been changed.
+ *
+ * This keeps the index valid without rebuilding it from scratch when new
+ * vertices are named one by one.
+ *
+ * \param  graph     the graph
+ * \param  vid       the ID of the vertex whose name was changed
+ * \param  old_name  the old name of the vertex
+ * \param  new_name  the new name of the vertex
+ */
+void igraphmodule_update_vertex_name_index(igraph_t *graph, long int vid,
+    PyObject* old_name, PyObject* new_name) {
+  igraphmodule_i_attribute_struct *attrs = ATTR_STRUCT(graph);
+  igraphmodule_i_attribute_struct_unindex_vertex_name(attrs, old_name, vid);
+  igraphmodule_i_attribute_struct_index_vertex_name(attrs, new_name, vid);
+}
+
+/**
+ * \brief Invalidates the cached C vectors of numeric edge attributes.
+ *
+ * \param  attrs  the attribute struct of the graph
+ * \param  name   the name of the attribute whose cached vector should be
+ *                dropped, or \c NULL to drop all the cached vectors
+ */
+void igraphmodule_i_attribute_struct_invalidate_edge_vector_cache(
+    igraphmodule_i_attribute_struct *attrs, PyObject* name) {
+  if (attrs->edge_vector_cache == 0)
+    return;
+
+  if (name == 0) {
+    Py_DECREF(attrs->edge_vector_cache);
+    attrs->edge_vector_cache = 0;
+  } else if (PyDict_GetItem(attrs->edge_vector_cache, name)) {
+    PyDict_DelItem(attrs->edge_vector_cache, name);
+  }
+}
+
+/**
+ * \brief Invalidates the cached C vectors of numeric edge attributes.
+ *
+ * This must be called whenever the values of an edge attribute are
+ * modified from the Python interface. Adding, deleting or permuting edges
+ * invalidates the cache automatically.
+ *
+ * \param  graph  the graph
+ * \param  name   the name of the attribute being modified, or \c NULL if
+ *                all the edge attributes were potentially modified
+ */
+void igraphmodule_invalidate_edge_attribute_vector_cache(const igraph_t *graph,
+    PyObject* name) {
+  igraphmodule_i_attribute_struct_invalidate_edge_vector_cache(ATTR_STRUCT(graph), name);
+}
+
+/**
+ * \brief Drops the hashed edge index of the graph.
+ *
+ * Must be called whenever edges are added, deleted or permuted.
+ */
+static void igraphmodule_i_attribute_struct_invalidate_edge_index(
+    igraphmodule_i_attribute_struct *attrs) {
+  igraphmodule_edge_index_destroy(attrs->edge_index);
+  attrs->edge_index = 0;
+}
+
+/**
+ * \brief Drops the cached adjacency lists of the graph.
+ *
+ * Must be called whenever vertices or edges are added, deleted or permuted.
+ * Objects that hold a reference to the lists of their own may keep using
+ * them.
+ */
+static void igraphmodule_i_attribute_struct_invalidate_adjacency(
+    igraphmodule_i_attribute_struct *attrs) {
+  int i;
+  for (i=0; i<3; i++) {
+    igraphmodule_adjacency_decref(attrs->adjacency[i]);
+    attrs->adjacency[i] = 0;
+  }
+  attrs->adjacency_queries = 0;
+}
+
+/* Number of canonical forms cached for a graph */
+#define IGRAPHMODULE_CANONICAL_FORMS_CACHE_SIZE 8
+
+/**
+ * \brief Drops the cached canonical forms of the graph.
+ *
+ * Must be called whenever vertices or edges are added, deleted or permuted.
+ */
+static void igraphmodule_i_attribute_struct_invalidate_canonical_forms(
+    igraphmodule_i_attribute_struct *attrs) {
+  if (attrs->canonical_forms) {
+    RC_DEALLOC("dict", attrs->canonical_forms);
+    Py_DECREF(attrs->canonical_forms);
+    attrs->canonical_forms = 0;
+  }
+}
+
+/**
+ * \brief Returns a canonical form of the graph cached by
+ *        \ref igraphmodule_cache_canonical_form(), or \c NULL if there is
+ *        none for the given key.
+ *
+ * \return a borrowed reference to the cached form
+ */
+PyObject* igraphmodule_get_cached_canonical_form(const igraph_t *graph,
+    PyObject* key) {
+  igraphmodule_i_attribute_struct* attrs = ATTR_STRUCT(graph);
+  PyObject* form;
+
+  if (attrs->canonical_forms == 0)
+    return 0;
+
+  form = PyDict_GetItem(attrs->canonical_forms, key);
+  if (form == 0)
+    PyErr_Clear();
+  return form;
+}
+
+/**
+ * \brief Caches a canonical form of the graph until the graph is modified.
+ *
+ * Only a handful of forms (one for each combination of splitting heuristic
+ * and vertex colors that was asked for) are kept; the cache is emptied
+ * when it gets full.
+ *
+ * \param  graph  the graph
+ * \param  key    the splitting heuristic and the colors, as a hashable
+ *                object
+ * \param  form   the canonical form
+ * \return 0 if everything was OK, 1 otherwise
+ */
+int igraphmodule_cache_canonical_form(const igraph_t *graph, PyObject* key,
+    PyObject* form) {
+  igraphmodule_i_attribute_struct* attrs = ATTR_STRUCT(graph);
+
+  if (attrs->canonical_forms &&
+      PyDict_Size(attrs->canonical_forms) >= IGRAPHMODULE_CANONICAL_FORMS_CACHE_SIZE)
+    PyDict_Clear(attrs->canonical_forms);
+
+  if (attrs->canonical_forms == 0) {
+    attrs->canonical_forms = PyDict_New();
+    if (attrs->canonical_forms == 0)
+      return 1;
+    RC_ALLOC("dict", attrs->canonical_forms);
+  }
+
+  return PyDict_SetItem(attrs->canonical_forms, key, form) ? 1 : 0;
+}
+
+/**
+ * \brief Returns the hashed edge index of the graph, or \c NULL if it has
+ *        not been built yet.
+ *
+ * May be called without holding the GIL.
+ */
+const igraphmodule_edge_index_t* igraphmodule_get_edge_index(const igraph_t *graph) {
+  return graph->attr ? ATTR_STRUCT(graph)->edge_index : 0;
+}
+
+/**
+ * \brief Replaces the hashed edge index of the graph.
+ *
+ * The graph takes ownership of the index. Must be called with the GIL held
+ * so that the index is not replaced while another thread is using it.
+ */
+void igraphmodule_set_edge_index(const igraph_t *graph,
+    igraphmodule_edge_index_t* index) {
+  igraphmodule_i_attribute_struct* attrs = ATTR_STRUCT(graph);
+  igraphmodule_edge_index_destroy(attrs->edge_index);
+  attrs->edge_index = index;
+}
+
+/**
+ * \brief Returns the cached C vector of a numeric edge attribute.
+ *
+ * \param  graph  the graph
+ * \param  name   the name of the attribute
+ * \returns  the cached vector or \c NULL if there is no cached vector for
+ *            the given attribute (no exception set). The vector is owned by
+ *            the cache and must not be modified.
+ */
+const igraph_vector_t* igraphmodule_get_cached_edge_attribute_vector(
+    const igraph_t *graph, const char* name) {
+  PyObject *cache = ATTR_STRUCT(graph)->edge_vector_cache, *entry;
+
+  if (cache == 0)
+    return 0;
+
+  entry = PyDict_GetItemString(cache, name);
+  if (entry == 0)
+    return 0;
+
+  return &((igraphmodule_BufferObject*)entry)->vector;
+}
+
+/**
+ * \brief Stores a copy of the C vector of a numeric edge attribute in the
+ *        cache so subsequent calls with the same attribute as weights do
+ *        not have to convert the Python values again.
+ *
+ * \param  graph  the graph
+ * \param  name   the name of the attribute
+ * \param  v      the values of the attribute
+ * \returns  0 if everything was OK, 1 otherwise (an exception is set)
+ */
+int igraphmodule_cache_edge_attribute_vector(const igraph_t *graph,
+    const char* name, const igraph_vector_t* v) {
+  igraphmodule_i_attribute_struct *attrs = ATTR_STRUCT(graph);
+  igraph_vector_t copy;
+  PyObject *entry;
+
+  if (attrs->edge_vector_cache == 0) {
+    attrs->edge_vector_cache = PyDict_New();
+    if (attrs->edge_vector_cache == 0)
+      return 1;
+    RC_ALLOC("dict", attrs->edge_vector_cache);
+  }
+
+  if (igraph_vector_copy(&copy, v)) {
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+
+  entry = igraphmodule_Buffer_from_vector_t(&copy);
+  igraph_vector_destroy(&copy);
+  if (entry == 0)
+    return 1;
+
+  if (PyDict_SetItemString(attrs->edge_vector_cache, name, entry)) {
+    Py_DECREF(entry);
+    return 1;
+  }
+
+  Py_DECREF(entry);    /* the cache holds a reference now */
+  return 0;
+}
+
 void igraphmodule_index_vertex_names(igraph_t *graph, igraph_bool_t force) {
   igraphmodule_i_attribute_struct_index_vertex_names(ATTR_STRUCT(graph), force);
 }
@@ -157,18 +469,19 @@ int igraphmodule_PyObject_matches_attribute_record(PyObject* object, igraph_attr
   return 0;
 }
 
-int igraphmodule_get_vertex_id_by_name(igraph_t *graph, PyObject* o, igraph_integer_t* vid) {
-  igraphmodule_i_attribute_struct* attrs = ATTR_STRUCT(graph);
-  PyObject* o_vid = NULL;
+/**
+ * \brief Converts an entry of the vertex name index to a vertex ID, setting
+ *        an appropriate exception if the name was not found in the index.
+ *
+ * \param  o      the name being looked up
+ * \param  o_vid  the entry of the index (\c NULL if the name was not found)
+ * \param  vid    the vertex ID is returned here
+ * \returns  0 if everything was OK, 1 otherwise
+ */
+static int igraphmodule_i_vertex_name_index_entry_to_vid(PyObject* o,
+    PyObject* o_vid, igraph_integer_t* vid) {
   int tmp;
 
-  if (graph) {
-    attrs = ATTR_STRUCT(graph);
-    if (igraphmodule_i_attribute_struct_index_vertex_names(attrs, 0))
-      return 1;
-    o_vid = PyDict_GetItem(attrs->vertex_name_index, o);
-  }
-
   if (o_vid == NULL) {
 #ifdef IGRAPH_PYTHON3
     PyErr_Format(PyExc_ValueError, "no such vertex: %R", o);
@@ -197,6 +510,69 @@ int igraphmodule_get_vertex_id_by_name(igraph_t *graph, PyObject* o, igraph_inte
   return 0;
 }
 
+int igraphmodule_get_vertex_id_by_name(igraph_t *graph, PyObject* o, igraph_integer_t* vid) {
+  igraphmodule_i_attribute_struct* attrs;
+  PyObject* o_vid = NULL;
+
+  if (graph) {
+    attrs = ATTR_STRUCT(graph);
+    if (igraphmodule_i_attribute_struct_index_vertex_names(attrs, 0))
+      return 1;
+    o_vid = PyDict_GetItem(attrs->vertex_name_index, o);
+  }
+
+  return igraphmodule_i_vertex_name_index_entry_to_vid(o, o_vid, vid);
+}
+
+/**
+ * \brief Looks up the IDs of several vertices by their names at once.
+ *
+ * The vertex name index is checked (and built if needed) only once for the
+ * whole sequence.
+ *
+ * \param  graph  the graph
+ * \param  names  a Python sequence containing the names of the vertices
+ * \param  ids    an initialized vector; the vertex IDs are returned here in
+ *                the order of the names
+ * \returns  0 if everything was OK, 1 otherwise
+ */
+int igraphmodule_get_vertex_ids_by_name(igraph_t *graph, PyObject* names,
+    igraph_vector_t* ids) {
+  igraphmodule_i_attribute_struct* attrs = ATTR_STRUCT(graph);
+  PyObject *seq, **items;
+  igraph_integer_t vid;
+  Py_ssize_t i, n;
+
+  seq = PySequence_Fast(names, "vertex names must be given in a sequence");
+  if (seq == 0)
+    return 1;
+
+  if (igraphmodule_i_attribute_struct_index_vertex_names(attrs, 0)) {
+    Py_DECREF(seq);
+    return 1;
+  }
+
+  n = PySequence_Fast_GET_SIZE(seq);
+  if (igraph_vector_resize(ids, n)) {
+    igraphmodule_handle_igraph_error();
+    Py_DECREF(seq);
+    return 1;
+  }
+
+  items = PySequence_Fast_ITEMS(seq);
+  for (i = 0; i < n; i++) {
+    if (igraphmodule_i_vertex_name_index_entry_to_vid(items[i],
+          PyDict_GetItem(attrs->vertex_name_index, items[i]), &vid)) {
+      Py_DECREF(seq);
+      return 1;
+    }
+    VECTOR(*ids)[i] = vid;
+  }
+
+  Py_DECREF(seq);
+  return 0;
+}
+
 /**
  * \brief Checks whether the given graph has the given graph attribute.
  *
@@ -230,6 +606,437 @@ igraph_bool_t igraphmodule_has_edge_attribute(const igraph_t *graph, const char*
   return name != 0 && dict != 0 && PyDict_GetItemString(dict, name) != 0;
 }
 
+/**
+ * \brief Returns the number of values in the storage of a vertex or edge
+ *        attribute.
+ *
+ * Vertex and edge attributes are stored either in a Python list or in a
+ * typed column (see \ref igraphmodule_ColumnObject). The functions below
+ * hide the difference between the two.
+ *
+ * \param  values  the list or column that stores the attribute
+ */
+Py_ssize_t igraphmodule_attribute_values_size(PyObject* values) {
+  if (igraphmodule_Column_Check(values))
+    return ((igraphmodule_ColumnObject*)values)->size;
+  return PyList_Size(values);
+}
+
+/**
+ * \brief Returns a single value from the storage of a vertex or edge
+ *        attribute.
+ *
+ * \param  values  the list or column that stores the attribute
+ * \param  index   the index of the vertex or edge
+ * \returns  a new reference to the value or \c NULL in case of an error
+ */
+PyObject* igraphmodule_attribute_values_get_item(PyObject* values, Py_ssize_t index) {
+  PyObject* result;
+
+  if (igraphmodule_Column_Check(values)) {
+    if (index < 0 || index >= ((igraphmodule_ColumnObject*)values)->size) {
+      PyErr_SetString(PyExc_IndexError, "attribute index out of range");
+      return 0;
+    }
+    return igraphmodule_Column_get_item((igraphmodule_ColumnObject*)values, index);
+  }
+
+  result = PyList_GetItem(values, index);
+  Py_XINCREF(result);
+  return result;
+}
+
+/**
+ * \brief Returns a copy of all the values of a vertex or edge attribute in
+ *        a new Python list.
+ *
+ * \param  values  the list or column that stores the attribute
+ */
+PyObject* igraphmodule_attribute_values_to_list(PyObject* values) {
+  if (igraphmodule_Column_Check(values))
+    return igraphmodule_Column_to_list((igraphmodule_ColumnObject*)values);
+  return PyList_GetSlice(values, 0, PyList_Size(values));
+}
+
+/**
+ * \brief Returns the Python list that stores a vertex or edge attribute,
+ *        converting a typed column into a list if needed.
+ *
+ * \param  dict  the attribute dict of the graph
+ * \param  key   the name of the attribute
+ * \returns  a borrowed reference to the list or \c NULL if there is no such
+ *            attribute (no exception set) or there was an error
+ */
+PyObject* igraphmodule_attribute_values_as_list(PyObject* dict, PyObject* key) {
+  PyObject *values, *list;
+
+  values = PyDict_GetItem(dict, key);
+  if (values == 0 || !igraphmodule_Column_Check(values))
+    return values;
+
+  list = igraphmodule_Column_to_list((igraphmodule_ColumnObject*)values);
+  if (list == 0)
+    return 0;
+
+  if (PyDict_SetItem(dict, key, list)) {
+    Py_DECREF(list);
+    return 0;
+  }
+
+  Py_DECREF(list);   /* the dict holds a reference now */
+  return list;
+}
+
+/**
+ * \brief Sets a single value in the storage of a vertex or edge attribute.
+ *
+ * If the attribute is stored in a typed column and the value does not fit
+ * the type of the column, the column is converted into a list first and
+ * \c values is updated accordingly.
+ *
+ * \param  dict    the attribute dict of the graph
+ * \param  key     the name of the attribute
+ * \param  values  pointer to the list or column that stores the attribute
+ * \param  index   the index of the vertex or edge
+ * \param  item    the new value; the reference is stolen even in case of
+ *                  an error, just like \c PyList_SetItem() does
+ * \returns  0 if everything was OK, -1 otherwise
+ */
+int igraphmodule_attribute_values_set_item(PyObject* dict, PyObject* key,
+    PyObject** values, Py_ssize_t index, PyObject* item) {
+  int retval;
+
+  if (igraphmodule_Column_Check(*values)) {
+    igraphmodule_ColumnObject* column = (igraphmodule_ColumnObject*)(*values);
+    if (index < 0 || index >= column->size) {
+      PyErr_SetString(PyExc_IndexError, "attribute index out of range");
+      Py_DECREF(item);
+      return -1;
+    }
+
+    retval = igraphmodule_Column_set_item(column, index, item);
+    if (retval <= 0) {
+      Py_DECREF(item);
+      return retval;
+    }
+
+    /* value does not fit into the column */
+    *values = igraphmodule_attribute_values_as_list(dict, key);
+    if (*values == 0) {
+      Py_DECREF(item);
+      return -1;
+    }
+  }
+
+  return PyList_SetItem(*values, index, item);
+}
+
+/* Largest magnitude up to which every integer is exactly representable as
+ * a double */
+#define IGRAPHMODULE_MAX_EXACT_INTEGER 9007199254740992.0
+
+/* Operators of attribute filters besides the rich comparisons of Python */
+#define IGRAPHMODULE_FILTER_IN    (Py_GE + 1)
+#define IGRAPHMODULE_FILTER_NOTIN (Py_GE + 2)
+
+/**
+ * \brief Converts a number to a double if the conversion is exact.
+ *
+ * Only exact \c int, \c long, \c float and \c bool instances are accepted;
+ * subclasses may override the comparison operators.
+ *
+ * \returns  1 if the conversion succeeded, 0 otherwise (no exception set)
+ */
+static int igraphmodule_i_filter_value_as_double(PyObject* o, double* result) {
+  if (PyFloat_CheckExact(o)) {
+    *result = PyFloat_AS_DOUBLE(o);
+    return 1;
+  }
+
+  if (PyBool_Check(o)) {
+    *result = (o == Py_True) ? 1 : 0;
+    return 1;
+  }
+
+#ifndef IGRAPH_PYTHON3
+  if (PyInt_CheckExact(o)) {
+    *result = PyInt_AS_LONG(o);
+    return fabs(*result) <= IGRAPHMODULE_MAX_EXACT_INTEGER;
+  }
+#endif
+
+  if (PyLong_CheckExact(o)) {
+    int overflow;
+    PY_LONG_LONG value = PyLong_AsLongLongAndOverflow(o, &overflow);
+    if (overflow || (value == -1 && PyErr_Occurred())) {
+      PyErr_Clear();
+      return 0;
+    }
+    *result = (double)value;
+    return fabs(*result) <= IGRAPHMODULE_MAX_EXACT_INTEGER;
+  }
+
+  return 0;
+}
+
+/**
+ * \brief Compares two doubles with one of the rich comparison operators.
+ */
+static igraph_bool_t igraphmodule_i_filter_compare(int op, double a, double b) {
+  switch (op) {
+    case Py_LT: return a < b;
+    case Py_LE: return a <= b;
+    case Py_EQ: return a == b;
+    case Py_NE: return a != b;
+    case Py_GT: return a > b;
+    case Py_GE: return a >= b;
+    default: return 0;
+  }
+}
+
+static int igraphmodule_i_filter_double_cmp(const void* a, const void* b) {
+  double da = *(const double*)a, db = *(const double*)b;
+  return (da < db) ? -1 : ((da > db) ? 1 : 0);
+}
+
+/**
+ * \brief Filters an index vector by comparing the values stored in a typed
+ *        column against a number or a collection of numbers, without
+ *        creating Python objects for the items of the column.
+ *
+ * The results are exactly the same as the results of the corresponding
+ * Python operators. Cases where this cannot be guaranteed by comparing
+ * doubles (e.g., ordered comparisons with missing values, which raise an
+ * exception in Python 3) are left to the generic code path.
+ *
+ * \returns  1 if the vector was filtered, 0 if the generic code path must
+ *           be used, -1 in case of an error
+ */
+static int igraphmodule_i_attribute_column_filter(
+    igraphmodule_ColumnObject* column, igraph_vector_t* ids, int op,
+    PyObject* value) {
+  long int i, j, n = igraph_vector_size(ids);
+  igraph_vector_t set;
+  double x = 0, item;
+  igraph_bool_t missing, keep;
+
+  if (op == IGRAPHMODULE_FILTER_IN || op == IGRAPHMODULE_FILTER_NOTIN) {
+    PyObject *seq, *element;
+    Py_ssize_t k, m;
+
+    if (!PyList_Check(value) && !PyTuple_Check(value) &&
+        !PyAnySet_Check(value))
+      return 0;
+
+    seq = PySequence_Fast(value, "");
+    if (seq == 0)
+      return -1;
+
+    m = PySequence_Fast_GET_SIZE(seq);
+    if (igraph_vector_init(&set, 0) || igraph_vector_reserve(&set, m)) {
+      Py_DECREF(seq);
+      igraphmodule_handle_igraph_error();
+      return -1;
+    }
+
+    for (k = 0; k < m; k++) {
+      element = PySequence_Fast_GET_ITEM(seq, k);
+      if (!igraphmodule_i_filter_value_as_double(element, &x)) {
+        Py_DECREF(seq);
+        igraph_vector_destroy(&set);
+        return 0;
+      }
+      /* NaN is not equal to anything, it can never match */
+      if (x == x)
+        igraph_vector_push_back(&set, x);   /* space reserved already */
+    }
+    Py_DECREF(seq);
+
+    qsort(VECTOR(set), igraph_vector_size(&set), sizeof(double),
+        igraphmodule_i_filter_double_cmp);
+  } else {
+    if (!igraphmodule_i_filter_value_as_double(value, &x))
+      return 0;
+    /* None cannot be ordered with respect to numbers */
+    if (op != Py_EQ && op != Py_NE && column->valid != 0)
+      return 0;
+  }
+
+  for (i = 0, j = 0; i < n; i++) {
+    long int idx = (long int)VECTOR(*ids)[i];
+
+    if (idx < 0 || idx >= column->size) {
+      if (op == IGRAPHMODULE_FILTER_IN || op == IGRAPHMODULE_FILTER_NOTIN)
+        igraph_vector_destroy(&set);
+      PyErr_SetString(PyExc_IndexError, "attribute index out of range");
+      return -1;
+    }
+
+    missing = column->valid != 0 && !column->valid[idx];
+    switch (column->type) {
+      case IGRAPHMODULE_COLUMN_FLOAT:
+        item = ((double*)column->data)[idx];
+        break;
+      case IGRAPHMODULE_COLUMN_INT:
+        item = (double)((PY_LONG_LONG*)column->data)[idx];
+        break;
+      default:
+        item = column->data[idx] ? 1 : 0;
+    }
+
+    if (op == IGRAPHMODULE_FILTER_IN || op == IGRAPHMODULE_FILTER_NOTIN) {
+      if (missing) {
+        keep = 0;
+      } else if (fabs(item) > IGRAPHMODULE_MAX_EXACT_INTEGER &&
+          column->type == IGRAPHMODULE_COLUMN_INT) {
+        /* cannot be compared exactly as a double; ask Python */
+        PyObject* o = igraphmodule_Column_get_item(column, idx);
+        int contains = o ? PySequence_Contains(value, o) : -1;
+        Py_XDECREF(o);
+        if (contains < 0) {
+          igraph_vector_destroy(&set);
+          return -1;
+        }
+        keep = contains;
+      } else {
+        keep = (item == item) && bsearch(&item, VECTOR(set),
+            igraph_vector_size(&set), sizeof(double),
+            igraphmodule_i_filter_double_cmp) != 0;
+      }
+      if (op == IGRAPHMODULE_FILTER_NOTIN)
+        keep = !keep;
+    } else if (missing) {
+      /* None is only equal to None */
+      keep = (op == Py_NE);
+    } else if (fabs(item) > IGRAPHMODULE_MAX_EXACT_INTEGER &&
+        column->type == IGRAPHMODULE_COLUMN_INT) {
+      PyObject* o = igraphmodule_Column_get_item(column, idx);
+      int result = o ? PyObject_RichCompareBool(o, value, op) : -1;
+      Py_XDECREF(o);
+      if (result < 0)
+        return -1;
+      keep = result;
+    } else {
+      keep = igraphmodule_i_filter_compare(op, item, x);
+    }
+
+    if (keep)
+      VECTOR(*ids)[j++] = idx;
+  }
+
+  if (op == IGRAPHMODULE_FILTER_IN || op == IGRAPHMODULE_FILTER_NOTIN)
+    igraph_vector_destroy(&set);
+
+  igraph_vector_resize(ids, j);   /* shrinking never fails */
+  return 1;
+}
+
+/**
+ * \brief Filters a vector of vertex or edge IDs by the values of an
+ *        attribute, in place.
+ *
+ * This implements the keyword arguments of \c VertexSeq.select() and
+ * \c EdgeSeq.select(). An ID is kept if <tt>value_of_id OP value</tt> is
+ * true, where \c OP is one of \c "lt", \c "le", \c "eq", \c "ne",
+ * \c "gt", \c "ge", \c "in" or \c "notin". The order of the remaining IDs
+ * is retained. Attributes stored in typed columns are compared without
+ * creating Python objects for their items whenever possible.
+ *
+ * \param  values  the list or column that stores the attribute
+ * \param  ids     the IDs to filter
+ * \param  op      the name of the operator
+ * \param  value   the value on the right hand side of the operator
+ * \returns  0 if everything was OK, 1 otherwise
+ */
+int igraphmodule_attribute_values_filter(PyObject* values, igraph_vector_t* ids,
+    PyObject* op_o, PyObject* value) {
+  static igraphmodule_enum_translation_table_entry_t filter_tt[] = {
+        {"lt", Py_LT},
+        {"le", Py_LE},
+        {"eq", Py_EQ},
+        {"ne", Py_NE},
+        {"gt", Py_GT},
+        {"ge", Py_GE},
+        {"in", IGRAPHMODULE_FILTER_IN},
+        {"notin", IGRAPHMODULE_FILTER_NOTIN},
+        {0,0}
+    };
+  long int i, j, n = igraph_vector_size(ids);
+  int op = Py_EQ, result;
+
+  if (igraphmodule_PyObject_to_enum(op_o, filter_tt, &op))
+    return 1;
+  if (op < Py_LT || op > IGRAPHMODULE_FILTER_NOTIN) {
+    PyErr_SetString(PyExc_ValueError, "invalid filter operator");
+    return 1;
+  }
+
+  if (igraphmodule_Column_Check(values)) {
+    result = igraphmodule_i_attribute_column_filter(
+        (igraphmodule_ColumnObject*)values, ids, op, value);
+    if (result != 0)
+      return result < 0;
+  }
+
+  for (i = 0, j = 0; i < n; i++) {
+    PyObject *item, *cmp;
+
+    item = igraphmodule_attribute_values_get_item(values,
+        (Py_ssize_t)VECTOR(*ids)[i]);
+    if (item == 0)
+      return 1;
+
+    if (op == IGRAPHMODULE_FILTER_IN || op == IGRAPHMODULE_FILTER_NOTIN) {
+      result = PySequence_Contains(value, item);
+      if (result >= 0 && op == IGRAPHMODULE_FILTER_NOTIN)
+        result = !result;
+    } else {
+      /* not PyObject_RichCompareBool(), which treats identical objects as
+       * equal even if they are not (e.g., NaN) */
+      cmp = PyObject_RichCompare(item, value, op);
+      result = cmp ? PyObject_IsTrue(cmp) : -1;
+      Py_XDECREF(cmp);
+    }
+    Py_DECREF(item);
+
+    if (result < 0)
+      return 1;
+    if (result)
+      VECTOR(*ids)[j++] = VECTOR(*ids)[i];
+  }
+
+  igraph_vector_resize(ids, j);   /* shrinking never fails */
+  return 0;
+}
+
+/**
+ * \brief Extends a typed column storing a vertex or edge attribute with
+ *        missing values.
+ *
+ * If the buffer of the column is exported to another object, the column is
+ * replaced with a copy in the attribute dict so the exported buffer stays
+ * valid.
+ *
+ * \returns  0 if everything was OK, 1 otherwise
+ */
+static int igraphmodule_i_attribute_column_extend(PyObject* dict, PyObject* key,
+    PyObject* values, Py_ssize_t n) {
+  igraphmodule_ColumnObject* column = (igraphmodule_ColumnObject*)values;
+
+  if (column->exports > 0) {
+    column = (igraphmodule_ColumnObject*)igraphmodule_Column_copy(column);
+    if (column == 0)
+      return 1;
+    if (PyDict_SetItem(dict, key, (PyObject*)column)) {
+      Py_DECREF(column);
+      return 1;
+    }
+    Py_DECREF(column);   /* the dict holds a reference now */
+  }
+
+  return igraphmodule_Column_resize(column, column->size + n);
+}
+
 /**
  * \brief Creates a new edge attribute and sets the values to None.
  *
@@ -278,14 +1085,16 @@ PyObject* igraphmodule_create_edge_attribute(const igraph_t* graph,
  * \brief Returns the values of the given edge attribute for all edges in the
  *        given graph.
  *
- * This returns the actual list that we use to store the edge attributes, so
- * be careful when modifying it - any modification will propagate back to the
- * graph itself. You have been warned.
+ * This returns the actual object that we use to store the edge attributes,
+ * which is either a Python list or a typed column (see
+ * \ref igraphmodule_ColumnObject). Use \ref igraphmodule_attribute_values_get_item
+ * to read values from it. Use \ref igraphmodule_create_or_get_edge_attribute_values
+ * if you need to modify the values.
  *
  * \param  graph  the graph
  * \param  name   the name of the attribute being searched for
- * \returns  a Python list or \c NULL if there is no such attribute
- *           (no exception set). The returned reference is borrowed.
+ * \returns  a Python list, a typed column or \c NULL if there is no such
+ *           attribute (no exception set). The returned reference is borrowed.
  */
 PyObject* igraphmodule_get_edge_attribute_values(const igraph_t* graph,
     const char* name) {
@@ -301,7 +1110,8 @@ PyObject* igraphmodule_get_edge_attribute_values(const igraph_t* graph,
  *
  * This returns the actual list that we use to store the edge attributes, so
  * be careful when modifying it - any modification will propagate back to the
- * graph itself. You have been warned.
+ * graph itself. You have been warned. Typed columns are converted into
+ * lists first.
  *
  * \param  graph  the graph
  * \param  name   the name of the attribute being searched for
@@ -309,12 +1119,20 @@ PyObject* igraphmodule_get_edge_attribute_values(const igraph_t* graph,
  */
 PyObject* igraphmodule_create_or_get_edge_attribute_values(const igraph_t* graph,
     const char* name) {
-  PyObject *dict = ATTR_STRUCT_DICT(graph)[ATTRHASH_IDX_EDGE], *result;
+  PyObject *dict = ATTR_STRUCT_DICT(graph)[ATTRHASH_IDX_EDGE], *result, *key;
   if (dict == 0)
     return 0;
   result = PyDict_GetItemString(dict, name);
-  if (result != 0)
+  if (result != 0) {
+    key = PyString_FromString(name);
+    if (key == 0)
+      return 0;
+    /* The caller is likely to modify the values */
+    igraphmodule_i_attribute_struct_invalidate_edge_vector_cache(ATTR_STRUCT(graph), key);
+    result = igraphmodule_attribute_values_as_list(dict, key);
+    Py_DECREF(key);
     return result;
+  }
   return igraphmodule_create_edge_attribute(graph, name);
 }
 
@@ -427,7 +1245,11 @@ static int igraphmodule_i_attribute_copy(igraph_t *to, const igraph_t *from,
       pos = 0;
       while (PyDict_Next(fromattrs->attrs[i], &pos, &key, &value)) {
         /* value is only borrowed, so copy it */
-        if (i>0) {
+        if (i>0 && igraphmodule_Column_Check(value)) {
+          newval=igraphmodule_Column_copy((igraphmodule_ColumnObject*)value);
+          if (!newval)
+            IGRAPH_ERROR("can't copy attribute column", IGRAPH_ENOMEM);
+        } else if (i>0) {
           newval=PyList_New(PyList_GET_SIZE(value));
           for (j=0; j<PyList_GET_SIZE(value); j++) {
             o=PyList_GetItem(value, j);
@@ -458,6 +1280,10 @@ static int igraphmodule_i_attribute_add_vertices(igraph_t *graph, long int nv, i
   if (!graph->attr) return IGRAPH_SUCCESS;
   if (nv<0) return IGRAPH_SUCCESS;
 
+  /* Cached adjacency lists are now too short */
+  igraphmodule_i_attribute_struct_invalidate_adjacency(ATTR_STRUCT(graph));
+  igraphmodule_i_attribute_struct_invalidate_canonical_forms(ATTR_STRUCT(graph));
+
   if (attr) {
     added_attrs = (igraph_bool_t*)calloc((size_t)igraph_vector_ptr_size(attr),
                                          sizeof(igraph_bool_t));
@@ -471,8 +1297,6 @@ static int igraphmodule_i_attribute_add_vertices(igraph_t *graph, long int nv, i
     IGRAPH_ERROR("vertex attribute hash type mismatch", IGRAPH_EINVAL);
 
   while (PyDict_Next(dict, &pos, &key, &value)) {
-    if (!PyList_Check(value))
-      IGRAPH_ERROR("vertex attribute hash member is not a list", IGRAPH_EINVAL);
     /* Check if we have specific values for the given attribute */
     attr_rec=0;
     if (attr) {
@@ -486,6 +1310,19 @@ static int igraphmodule_i_attribute_add_vertices(igraph_t *graph, long int nv, i
         attr_rec=0;
       }
     }
+    if (igraphmodule_Column_Check(value)) {
+      if (!attr_rec) {
+        /* Typed columns are simply extended with missing values */
+        if (igraphmodule_i_attribute_column_extend(dict, key, value, nv))
+          IGRAPH_ERROR("can't extend a vertex attribute hash member", IGRAPH_FAILURE);
+        continue;
+      }
+      value = igraphmodule_attribute_values_as_list(dict, key);
+      if (!value)
+        IGRAPH_ERROR("can't extend a vertex attribute hash member", IGRAPH_FAILURE);
+    }
+    if (!PyList_Check(value))
+      IGRAPH_ERROR("vertex attribute hash member is not a list", IGRAPH_EINVAL);
     /* If we have specific values for the given attribute, attr_rec contains
      * the appropriate vector. If not, it is null. */
     if (attr_rec) {
@@ -516,15 +1353,26 @@ static int igraphmodule_i_attribute_add_vertices(igraph_t *graph, long int nv, i
         }
       }
 
-      /* Invalidate the vertex name index if needed */
-      if (!strcmp(attr_rec->name, "name"))
-        igraphmodule_i_attribute_struct_invalidate_vertex_name_index(ATTR_STRUCT(graph));
+      /* Add the new names to the vertex name index if needed */
+      if (!strcmp(attr_rec->name, "name")) {
+        k=PyList_GET_SIZE(value);
+        for (i=k-nv; i<k; i++) {
+          igraphmodule_i_attribute_struct_index_vertex_name(ATTR_STRUCT(graph),
+              PyList_GET_ITEM(value, i), i);
+        }
+      }
     } else {
       for (i=0; i<nv; i++) {
         if (PyList_Append(value, Py_None) == -1) {
           IGRAPH_ERROR("can't extend a vertex attribute hash member", IGRAPH_FAILURE);
         }
       }
+
+      /* The new vertices have no names yet */
+      if (nv > 0 && PyString_IsEqualToASCIIString(key, "name")) {
+        igraphmodule_i_attribute_struct_index_vertex_name(ATTR_STRUCT(graph),
+            Py_None, PyList_GET_SIZE(value)-nv);
+      }
     }
   }
 
@@ -585,43 +1433,176 @@ static int igraphmodule_i_attribute_add_vertices(igraph_t *graph, long int nv, i
   return IGRAPH_SUCCESS;
 }
 
+/**
+ * \brief Returns whether an index vector is strictly increasing, i.e. whether
+ *        it keeps a subset of the vertices or edges in their original order.
+ *
+ * This is the case when vertices or edges are deleted.
+ */
+static igraph_bool_t igraphmodule_i_attribute_idx_is_increasing(
+    const igraph_vector_t *idx) {
+  long int i, n = igraph_vector_size(idx);
+
+  if (n > 0 && VECTOR(*idx)[0] < 0)
+    return 0;
+
+  for (i = 1; i < n; i++) {
+    if (VECTOR(*idx)[i] <= VECTOR(*idx)[i-1])
+      return 0;
+  }
+
+  return 1;
+}
+
+/**
+ * \brief Creates a new list from the items of an attribute list with the
+ *        given indices.
+ */
+static PyObject* igraphmodule_i_attribute_list_select(PyObject *list,
+    const igraph_vector_t *idx) {
+  Py_ssize_t i, j, n = igraph_vector_size(idx), size = PyList_GET_SIZE(list);
+  PyObject **items = PySequence_Fast_ITEMS(list), *result, *o;
+
+  result = PyList_New(n);
+  if (!result)
+    return 0;
+
+  for (i = 0; i < n; i++) {
+    j = (Py_ssize_t)VECTOR(*idx)[i];
+    if (j < 0 || j >= size) {
+      PyErr_SetString(PyExc_IndexError, "attribute index out of range");
+      Py_DECREF(result);
+      return 0;
+    }
+    o = items[j];
+    Py_INCREF(o);
+    PyList_SET_ITEM(result, i, o);
+  }
+
+  return result;
+}
+
+/**
+ * \brief Keeps the items of an attribute list with the given indices and
+ *        drops the others, in place.
+ *
+ * The kept items are moved to the front of the list without touching their
+ * reference counts; the dropped items are moved behind them and released
+ * in a single slice deletion.
+ *
+ * \param idx  the indices of the items to keep, in strictly increasing order
+ */
+static int igraphmodule_i_attribute_list_compact(PyObject *list,
+    const igraph_vector_t *idx) {
+  Py_ssize_t i, kept = 0, dropped = 0, n = igraph_vector_size(idx);
+  Py_ssize_t size = PyList_GET_SIZE(list);
+  PyObject **items = PySequence_Fast_ITEMS(list), **removed;
+
+  if (n > 0 && VECTOR(*idx)[n-1] >= size) {
+    PyErr_SetString(PyExc_IndexError, "attribute index out of range");
+    return 1;
+  }
+
+  if (n == size)
+    return 0;
+
+  removed = (PyObject**) PyMem_Malloc((size - n) * sizeof(PyObject*));
+  if (!removed) {
+    PyErr_NoMemory();
+    return 1;
+  }
+
+  for (i = 0; i < size; i++) {
+    if (kept < n && VECTOR(*idx)[kept] == i) {
+      items[kept++] = items[i];
+    } else {
+      removed[dropped++] = items[i];
+    }
+  }
+  memcpy(items + n, removed, dropped * sizeof(PyObject*));
+  PyMem_Free(removed);
+
+  return PyList_SetSlice(list, n, size, NULL);
+}
+
+/**
+ * \brief Permutes the values in a vertex or edge attribute dict.
+ *
+ * When the graph is modified in place and the index vector is increasing
+ * (i.e. when edges are deleted), the lists and typed columns are compacted
+ * in place; otherwise new lists and columns are created. Typed columns are
+ * copied in runs of consecutive indices in both cases.
+ *
+ * \return a new dict with the permuted values, or \c NULL if an error
+ *         happened
+ */
+static PyObject* igraphmodule_i_attribute_permute_dict(PyObject *dict,
+    const igraph_vector_t *idx, igraph_bool_t in_place) {
+  PyObject *key, *value, *newdict, *newlist;
+  Py_ssize_t pos = 0;
+
+  newdict=PyDict_New();
+  if (!newdict) return 0;
+
+  in_place = in_place && igraphmodule_i_attribute_idx_is_increasing(idx);
+
+  while (PyDict_Next(dict, &pos, &key, &value)) {
+    if (igraphmodule_Column_Check(value)) {
+      if (in_place && ((igraphmodule_ColumnObject*)value)->exports == 0) {
+        if (igraphmodule_Column_compact((igraphmodule_ColumnObject*)value, idx))
+          break;
+        newlist = value;
+        Py_INCREF(newlist);
+      } else {
+        newlist=igraphmodule_Column_select((igraphmodule_ColumnObject*)value, idx);
+      }
+    } else if (!PyList_Check(value)) {
+      PyErr_SetString(PyExc_TypeError, "attribute hash member is not a list");
+      break;
+    } else if (in_place) {
+      if (igraphmodule_i_attribute_list_compact(value, idx))
+        break;
+      newlist = value;
+      Py_INCREF(newlist);
+    } else {
+      newlist = igraphmodule_i_attribute_list_select(value, idx);
+    }
+    if (!newlist || PyDict_SetItem(newdict, key, newlist)) {
+      Py_XDECREF(newlist);
+      break;
+    }
+    Py_DECREF(newlist);
+  }
+
+  if (PyErr_Occurred()) {
+    Py_DECREF(newdict);
+    return 0;
+  }
+
+  return newdict;
+}
+
 /* Permuting vertices */
 static int igraphmodule_i_attribute_permute_vertices(const igraph_t *graph,
     igraph_t *newgraph, const igraph_vector_t *idx) {
-  long int n, i;
-  PyObject *key, *value, *dict, *newdict, *newlist, *o;
-  Py_ssize_t pos=0;
-  
+  PyObject *dict, *newdict;
+
   dict=ATTR_STRUCT_DICT(graph)[ATTRHASH_IDX_VERTEX];
   if (!PyDict_Check(dict)) return 1;
 
-  newdict=PyDict_New();
-  if (!newdict) return 1;
-
-  n=igraph_vector_size(idx);
-  pos=0;
-
-  while (PyDict_Next(dict, &pos, &key, &value)) {
-    newlist=PyList_New(n);
-    for (i=0; i<n; i++) {
-      o = PyList_GetItem(value, (Py_ssize_t)VECTOR(*idx)[i]);
-      if (!o) {
-        PyErr_Clear();
-        return 1;
-      }
-      Py_INCREF(o);
-      PyList_SET_ITEM(newlist, i, o);
-    }
-    PyDict_SetItem(newdict, key, newlist);
-    Py_DECREF(newlist);
+  newdict = igraphmodule_i_attribute_permute_dict(dict, idx, graph == newgraph);
+  if (!newdict) {
+    PyErr_Clear();
+    return 1;
   }
 
   dict = ATTR_STRUCT_DICT(newgraph)[ATTRHASH_IDX_VERTEX];
   ATTR_STRUCT_DICT(newgraph)[ATTRHASH_IDX_VERTEX]=newdict;
   Py_DECREF(dict);
 
-  /* Invalidate the vertex name index */
+  /* Invalidate the vertex name index and the canonical forms */
   igraphmodule_i_attribute_struct_invalidate_vertex_name_index(ATTR_STRUCT(newgraph));
+  igraphmodule_i_attribute_struct_invalidate_canonical_forms(ATTR_STRUCT(newgraph));
 
   return 0;
 }
@@ -638,6 +1619,12 @@ static int igraphmodule_i_attribute_add_edges(igraph_t *graph, const igraph_vect
   ne=igraph_vector_size(edges)/2;
   if (!graph->attr) return IGRAPH_SUCCESS;
   if (ne<0) return IGRAPH_SUCCESS;
+
+  /* Cached edge attribute vectors are now too short */
+  igraphmodule_i_attribute_struct_invalidate_edge_vector_cache(ATTR_STRUCT(graph), 0);
+  igraphmodule_i_attribute_struct_invalidate_edge_index(ATTR_STRUCT(graph));
+  igraphmodule_i_attribute_struct_invalidate_adjacency(ATTR_STRUCT(graph));
+  igraphmodule_i_attribute_struct_invalidate_canonical_forms(ATTR_STRUCT(graph));
   
   if (attr) {
     added_attrs = (igraph_bool_t*)calloc((size_t)igraph_vector_ptr_size(attr),
@@ -651,9 +1638,6 @@ static int igraphmodule_i_attribute_add_edges(igraph_t *graph, const igraph_vect
   if (!PyDict_Check(dict)) 
     IGRAPH_ERROR("edge attribute hash type mismatch", IGRAPH_EINVAL);
   while (PyDict_Next(dict, &pos, &key, &value)) {
-    if (!PyList_Check(value))
-      IGRAPH_ERROR("edge attribute hash member is not a list", IGRAPH_EINVAL);
-
     /* Check if we have specific values for the given attribute */
     attr_rec=0;
     if (attr) {
@@ -667,6 +1651,19 @@ static int igraphmodule_i_attribute_add_edges(igraph_t *graph, const igraph_vect
         attr_rec=0;
       }
     }
+    if (igraphmodule_Column_Check(value)) {
+      if (!attr_rec) {
+        /* Typed columns are simply extended with missing values */
+        if (igraphmodule_i_attribute_column_extend(dict, key, value, ne))
+          IGRAPH_ERROR("can't extend an edge attribute hash member", IGRAPH_FAILURE);
+        continue;
+      }
+      value = igraphmodule_attribute_values_as_list(dict, key);
+      if (!value)
+        IGRAPH_ERROR("can't extend an edge attribute hash member", IGRAPH_FAILURE);
+    }
+    if (!PyList_Check(value))
+      IGRAPH_ERROR("edge attribute hash member is not a list", IGRAPH_EINVAL);
     /* If we have specific values for the given attribute, attr_rec contains
      * the appropriate vector. If not, it is null. */
     if (attr_rec) {
@@ -806,38 +1803,31 @@ static void igraphmodule_i_attribute_delete_edges(igraph_t *graph, const igraph_
 /* Permuting edges */
 static int igraphmodule_i_attribute_permute_edges(const igraph_t *graph,
     igraph_t *newgraph, const igraph_vector_t *idx) { 
-  long int n, i;
-  PyObject *key, *value, *dict, *newdict, *newlist, *o;
-  Py_ssize_t pos=0;
+  PyObject *dict, *newdict;
+
+  /* The edge IDs change, so the edge index and the adjacency lists must be
+   * rebuilt */
+  igraphmodule_i_attribute_struct_invalidate_edge_index(ATTR_STRUCT(newgraph));
+  igraphmodule_i_attribute_struct_invalidate_adjacency(ATTR_STRUCT(newgraph));
+  igraphmodule_i_attribute_struct_invalidate_canonical_forms(ATTR_STRUCT(newgraph));
 
   dict=ATTR_STRUCT_DICT(graph)[ATTRHASH_IDX_EDGE];
   if (!PyDict_Check(dict)) return 1;
 
-  newdict=PyDict_New();
-  if (!newdict) return 1;
-
-  n=igraph_vector_size(idx);
-  pos=0;
-
-  while (PyDict_Next(dict, &pos, &key, &value)) {
-    newlist=PyList_New(n);
-    for (i=0; i<n; i++) {
-      o=PyList_GetItem(value, (Py_ssize_t)VECTOR(*idx)[i]);
-      if (!o) {
-        PyErr_Clear();
-        return 1;
-      }
-      Py_INCREF(o);
-      PyList_SET_ITEM(newlist, i, o);
-    }
-    PyDict_SetItem(newdict, key, newlist);
-    Py_DECREF(newlist);
+  /* igraph_delete_edges() permutes the edges of the graph in place */
+  newdict = igraphmodule_i_attribute_permute_dict(dict, idx, graph == newgraph);
+  if (!newdict) {
+    PyErr_Clear();
+    return 1;
   }
 
   dict = ATTR_STRUCT_DICT(newgraph)[ATTRHASH_IDX_EDGE];
   ATTR_STRUCT_DICT(newgraph)[ATTRHASH_IDX_EDGE]=newdict;
   Py_DECREF(dict);
 
+  /* Invalidate the cached edge attribute vectors */
+  igraphmodule_i_attribute_struct_invalidate_edge_vector_cache(ATTR_STRUCT(newgraph), 0);
+
   return 0;
 }
 
@@ -876,38 +1866,48 @@ static PyObject* igraphmodule_i_ac_func(PyObject* values,
 }
 
 /* Auxiliary function for combining vertices/edges. Given a merge list
- * (which specifies the vertex/edge IDs that were merged, the source
- * attribute values and a name of a Python builtin function,
- * returns a new list with the new attribute values. Each new attribute
- * is derived by calling the given builtin function with the old
- * attributes of the set of merged vertices/edges as the first argument.
+ * (which specifies the vertex/edge IDs that were merged and the source
+ * attribute values, returns a new list with the new attribute values.
+ * Each new attribute is the smallest (op = Py_LT) or the largest
+ * (op = Py_GT) of the attributes of the merged vertices/edges. The items
+ * are compared in the same way as the min() and max() builtins would do
+ * it, but no temporary list is created for the merged items.
  */
-static PyObject* igraphmodule_i_ac_builtin_func(PyObject* values,
-    const igraph_vector_ptr_t *merges, const char* func_name) {
-  static PyObject* builtin_module_dict = 0;
-  PyObject* func = 0;
+static PyObject* igraphmodule_i_ac_minmax(PyObject* values,
+    const igraph_vector_ptr_t *merges, int op) {
+  long int i, len = igraph_vector_ptr_size(merges);
+  PyObject *res, *item, *best;
+  int cmp;
 
-  if (builtin_module_dict == 0) {
-#ifdef IGRAPH_PYTHON3
-    PyObject* builtin_module = PyImport_ImportModule("builtins");
-#else
-    PyObject* builtin_module = PyImport_ImportModule("__builtin__");
-#endif
-    if (builtin_module == 0)
-      return 0;
-    builtin_module_dict = PyModule_GetDict(builtin_module);
-    Py_DECREF(builtin_module);
-    if (builtin_module_dict == 0)
+  res = PyList_New(len);
+  for (i = 0; i < len; i++) {
+    igraph_vector_t *v = (igraph_vector_t*)VECTOR(*merges)[i];
+    long int j, n = igraph_vector_size(v);
+
+    if (n == 0) {
+      PyErr_Format(PyExc_ValueError, "%s() arg is an empty sequence",
+          op == Py_LT ? "min" : "max");
+      Py_DECREF(res);
       return 0;
-  }
+    }
 
-  func = PyDict_GetItemString(builtin_module_dict, func_name);
-  if (func == 0) {
-    PyErr_Format(PyExc_NameError, "no such builtin function; %s", func_name);
-    return 0;
+    best = PyList_GET_ITEM(values, (Py_ssize_t)VECTOR(*v)[0]);
+    for (j = 1; j < n; j++) {
+      item = PyList_GET_ITEM(values, (Py_ssize_t)VECTOR(*v)[j]);
+      cmp = PyObject_RichCompareBool(item, best, op);
+      if (cmp < 0) {
+        Py_DECREF(res);
+        return 0;
+      }
+      if (cmp > 0)
+        best = item;
+    }
+
+    Py_INCREF(best);
+    PyList_SET_ITEM(res, i, best);   /* reference to best stolen */
   }
 
-  return igraphmodule_i_ac_func(values, merges, func);
+  return res;
 }
 
 /* Auxiliary function for combining vertices/edges. Given a merge list
@@ -1168,6 +2168,223 @@ static PyObject* igraphmodule_i_ac_median(PyObject* values,
   return res;
 }
 
+static int igraphmodule_i_ac_long_long_cmp(const void* a, const void* b) {
+  PY_LONG_LONG la = *(const PY_LONG_LONG*)a, lb = *(const PY_LONG_LONG*)b;
+  return (la < lb) ? -1 : ((la > lb) ? 1 : 0);
+}
+
+/* Returns the given item of a typed column without missing values as an
+ * integer; only used for integer and boolean columns */
+static PY_LONG_LONG igraphmodule_i_ac_column_get_long_long(
+    const igraphmodule_ColumnObject* col, Py_ssize_t i) {
+  if (col->type == IGRAPHMODULE_COLUMN_INT)
+    return ((PY_LONG_LONG*)col->data)[i];
+  return col->data[i] ? 1 : 0;
+}
+
+/* Auxiliary function for combining vertices/edges stored in a typed
+ * column. Implements the built-in numeric combination functions (sum,
+ * product, mean, median, min, max, first and last) as plain C loops over
+ * the column and the merge list, and returns a new typed column with the
+ * new attribute values. The results are equal to what the list-based
+ * functions above would return for the same values.
+ *
+ * Returns a null pointer without setting an exception if the column (or
+ * the merge list) has to be handled by the list-based functions instead,
+ * i.e. if it contains missing values, if min, max or median is invoked
+ * on an empty set of merged items, which is an error there, or if the
+ * medians of an integer column would be a mix of integers and floats.
+ */
+static PyObject* igraphmodule_i_ac_column(igraphmodule_ColumnObject* col,
+    const igraph_vector_ptr_t *merges, igraph_attribute_combination_type_t type) {
+  long int i, j, n, len = igraph_vector_ptr_size(merges), maxn = 0;
+  igraphmodule_column_type_t restype;
+  igraphmodule_ColumnObject *res;
+  igraph_bool_t integral = (col->type != IGRAPHMODULE_COLUMN_FLOAT);
+  igraph_bool_t has_even = 0, has_odd = 0;
+  double *res_real, *real_buf = 0;
+  PY_LONG_LONG *int_buf = 0;
+  Py_ssize_t idx;
+
+  if (col->valid != 0)
+    return 0;
+
+  for (i = 0; i < len; i++) {
+    n = igraph_vector_size((igraph_vector_t*)VECTOR(*merges)[i]);
+    if (n == 0 && (type == IGRAPH_ATTRIBUTE_COMBINE_MIN ||
+          type == IGRAPH_ATTRIBUTE_COMBINE_MAX ||
+          type == IGRAPH_ATTRIBUTE_COMBINE_MEDIAN))
+      return 0;
+    if (n % 2 == 0)
+      has_even = 1;
+    else
+      has_odd = 1;
+    if (n > maxn)
+      maxn = n;
+  }
+
+  switch (type) {
+    case IGRAPH_ATTRIBUTE_COMBINE_SUM:
+    case IGRAPH_ATTRIBUTE_COMBINE_PROD:
+    case IGRAPH_ATTRIBUTE_COMBINE_MEAN:
+      restype = IGRAPHMODULE_COLUMN_FLOAT;
+      break;
+
+    case IGRAPH_ATTRIBUTE_COMBINE_MEDIAN:
+      /* The median of an even number of items is the mean of the two
+       * middle items, which is always a float, while the median of an odd
+       * number of items is the middle item itself. A column can not hold
+       * both for integers */
+      if (integral && has_even && has_odd)
+        return 0;
+      restype = has_even ? IGRAPHMODULE_COLUMN_FLOAT : col->type;
+      break;
+
+    case IGRAPH_ATTRIBUTE_COMBINE_MIN:
+    case IGRAPH_ATTRIBUTE_COMBINE_MAX:
+    case IGRAPH_ATTRIBUTE_COMBINE_FIRST:
+    case IGRAPH_ATTRIBUTE_COMBINE_LAST:
+      restype = col->type;
+      break;
+
+    default:
+      return 0;
+  }
+
+  res = (igraphmodule_ColumnObject*)igraphmodule_Column_New(restype, len);
+  if (res == 0)
+    return 0;
+
+  if (type == IGRAPH_ATTRIBUTE_COMBINE_MEDIAN) {
+    if (integral)
+      int_buf = (PY_LONG_LONG*)PyMem_Malloc(sizeof(PY_LONG_LONG) * (maxn > 0 ? maxn : 1));
+    else
+      real_buf = (double*)PyMem_Malloc(sizeof(double) * (maxn > 0 ? maxn : 1));
+    if (int_buf == 0 && real_buf == 0) {
+      Py_DECREF(res);
+      PyErr_NoMemory();
+      return 0;
+    }
+  }
+
+  res_real = (double*)res->data;
+  for (i = 0; i < len; i++) {
+    igraph_vector_t *v = (igraph_vector_t*)VECTOR(*merges)[i];
+    n = igraph_vector_size(v);
+
+    switch (type) {
+      case IGRAPH_ATTRIBUTE_COMBINE_SUM:
+      case IGRAPH_ATTRIBUTE_COMBINE_PROD:
+        {
+          double acc = (type == IGRAPH_ATTRIBUTE_COMBINE_SUM) ? 0.0 : 1.0;
+          for (j = 0; j < n; j++) {
+            double num = igraphmodule_Column_get_real(col, (Py_ssize_t)VECTOR(*v)[j]);
+            if (type == IGRAPH_ATTRIBUTE_COMBINE_SUM)
+              acc += num;
+            else
+              acc *= num;
+          }
+          res_real[i] = acc;
+        }
+        break;
+
+      case IGRAPH_ATTRIBUTE_COMBINE_MEAN:
+        {
+          double num, mean = 0.0;
+          for (j = 0; j < n; ) {
+            num = igraphmodule_Column_get_real(col, (Py_ssize_t)VECTOR(*v)[j]);
+            j++;
+            num -= mean;
+            mean += num / j;
+          }
+          res_real[i] = mean;
+        }
+        break;
+
+      case IGRAPH_ATTRIBUTE_COMBINE_MIN:
+      case IGRAPH_ATTRIBUTE_COMBINE_MAX:
+        /* Same tie breaking and NaN handling as the min() and max()
+         * builtins: the first item wins unless a later one compares
+         * strictly smaller (larger) */
+        idx = (Py_ssize_t)VECTOR(*v)[0];
+        if (integral) {
+          PY_LONG_LONG best = igraphmodule_i_ac_column_get_long_long(col, idx), num;
+          for (j = 1; j < n; j++) {
+            num = igraphmodule_i_ac_column_get_long_long(col, (Py_ssize_t)VECTOR(*v)[j]);
+            if (type == IGRAPH_ATTRIBUTE_COMBINE_MIN ? num < best : num > best)
+              best = num;
+          }
+          if (restype == IGRAPHMODULE_COLUMN_INT)
+            ((PY_LONG_LONG*)res->data)[i] = best;
+          else
+            res->data[i] = (char) best;
+        } else {
+          double best = ((double*)col->data)[idx], num;
+          for (j = 1; j < n; j++) {
+            num = ((double*)col->data)[(Py_ssize_t)VECTOR(*v)[j]];
+            if (type == IGRAPH_ATTRIBUTE_COMBINE_MIN ? num < best : num > best)
+              best = num;
+          }
+          res_real[i] = best;
+        }
+        break;
+
+      case IGRAPH_ATTRIBUTE_COMBINE_MEDIAN:
+        if (integral) {
+          for (j = 0; j < n; j++)
+            int_buf[j] = igraphmodule_i_ac_column_get_long_long(col, (Py_ssize_t)VECTOR(*v)[j]);
+          qsort(int_buf, n, sizeof(PY_LONG_LONG), igraphmodule_i_ac_long_long_cmp);
+          if (n % 2 == 0)
+            res_real[i] = ((double)int_buf[n / 2 - 1] + (double)int_buf[n / 2]) / 2;
+          else if (restype == IGRAPHMODULE_COLUMN_INT)
+            ((PY_LONG_LONG*)res->data)[i] = int_buf[n / 2];
+          else
+            res->data[i] = (char) int_buf[n / 2];
+        } else {
+          for (j = 0; j < n; j++)
+            real_buf[j] = ((double*)col->data)[(Py_ssize_t)VECTOR(*v)[j]];
+          qsort(real_buf, n, sizeof(double), igraphmodule_i_filter_double_cmp);
+          res_real[i] = (n % 2 == 0) ?
+            (real_buf[n / 2 - 1] + real_buf[n / 2]) / 2 : real_buf[n / 2];
+        }
+        break;
+
+      case IGRAPH_ATTRIBUTE_COMBINE_FIRST:
+      case IGRAPH_ATTRIBUTE_COMBINE_LAST:
+        if (n == 0) {
+          /* Nothing was merged here; the value is missing */
+          if (igraphmodule_Column_set_item(res, i, Py_None)) {
+            PyMem_Free(int_buf);
+            PyMem_Free(real_buf);
+            Py_DECREF(res);
+            return 0;
+          }
+          break;
+        }
+        idx = (Py_ssize_t)VECTOR(*v)[type == IGRAPH_ATTRIBUTE_COMBINE_FIRST ? 0 : n - 1];
+        switch (restype) {
+          case IGRAPHMODULE_COLUMN_FLOAT:
+            res_real[i] = ((double*)col->data)[idx];
+            break;
+          case IGRAPHMODULE_COLUMN_INT:
+            ((PY_LONG_LONG*)res->data)[i] = ((PY_LONG_LONG*)col->data)[idx];
+            break;
+          default:
+            res->data[i] = col->data[idx];
+        }
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  PyMem_Free(int_buf);
+  PyMem_Free(real_buf);
+
+  return (PyObject*)res;
+}
+
 static void igraphmodule_i_free_attribute_combination_records(
     igraph_attribute_combination_record_t* records) {
   igraph_attribute_combination_record_t* ptr = records;
@@ -1221,6 +2438,7 @@ static int igraphmodule_i_attribute_combine_dicts(PyObject *dict,
     PyObject *empty_str;
     PyObject *func;
     PyObject *newvalue;
+    PyObject *column_values = 0;
 
     /* Safety check */
     if (!PyString_IsEqualToASCIIString(key, todo[i].name)) {
@@ -1229,6 +2447,30 @@ static int igraphmodule_i_attribute_combine_dicts(PyObject *dict,
           "developers!", IGRAPH_FAILURE);
     }
 
+    /* Typed columns are combined by the typed kernels if possible; the
+     * remaining combination functions work on lists, so typed columns are
+     * converted temporarily */
+    if (igraphmodule_Column_Check(value)) {
+      newvalue = igraphmodule_i_ac_column((igraphmodule_ColumnObject*)value,
+          merges, todo[i].type);
+      if (newvalue) {
+        if (PyDict_SetItem(newdict, key, newvalue)) {
+          Py_DECREF(newvalue);
+          IGRAPH_ERROR("PyDict_SetItem failed when combining attributes.", IGRAPH_FAILURE);
+        }
+        Py_DECREF(newvalue);
+        i++;
+        continue;
+      } else if (PyErr_Occurred()) {
+        IGRAPH_ERROR("Unexpected failure when combining attributes", IGRAPH_FAILURE);
+      }
+
+      column_values = igraphmodule_Column_to_list((igraphmodule_ColumnObject*)value);
+      if (!column_values)
+        IGRAPH_ERROR("can't convert attribute column to a list", IGRAPH_ENOMEM);
+      value = column_values;
+    }
+
     newvalue = 0;
     switch (todo[i].type) {
       case IGRAPH_ATTRIBUTE_COMBINE_DEFAULT:
@@ -1249,11 +2491,11 @@ static int igraphmodule_i_attribute_combine_dicts(PyObject *dict,
         break;
 
       case IGRAPH_ATTRIBUTE_COMBINE_MIN:
-        newvalue = igraphmodule_i_ac_builtin_func(value, merges, "min");
+        newvalue = igraphmodule_i_ac_minmax(value, merges, Py_LT);
         break;
 
       case IGRAPH_ATTRIBUTE_COMBINE_MAX:
-        newvalue = igraphmodule_i_ac_builtin_func(value, merges, "max");
+        newvalue = igraphmodule_i_ac_minmax(value, merges, Py_GT);
         break;
 
       case IGRAPH_ATTRIBUTE_COMBINE_RANDOM:
@@ -1285,11 +2527,14 @@ static int igraphmodule_i_attribute_combine_dicts(PyObject *dict,
         break;
 
       default:
+        Py_XDECREF(column_values);
         IGRAPH_ERROR("Unsupported combination type. "
             "This should never happen. Please report the bug to the igraph "
             "developers!", IGRAPH_FAILURE);
     }
 
+    Py_XDECREF(column_values);
+
     if (newvalue) {
       if (PyDict_SetItem(newdict, key, newvalue)) {
         Py_DECREF(newvalue);  /* PyDict_SetItem does not steal reference */
@@ -1344,10 +2589,241 @@ static int igraphmodule_i_attribute_combine_edges(const igraph_t *graph,
   dict=ATTR_STRUCT_DICT(graph)[ATTRHASH_IDX_EDGE];
   newdict=ATTR_STRUCT_DICT(newgraph)[ATTRHASH_IDX_EDGE];
 
+  igraphmodule_i_attribute_struct_invalidate_edge_vector_cache(ATTR_STRUCT(newgraph), 0);
+
   return igraphmodule_i_attribute_combine_dicts(dict, newdict,
       merges, comb);
 }
 
+/**
+ * \brief Combines the edge attributes of several graphs into the edge
+ *        attributes of a graph that was created from them, e.g., their union.
+ *
+ * Each edge attribute of the source graphs is combined separately according
+ * to \c comb, in the same way as \c igraph_simplify() would do it. The values
+ * of the merged edges are passed to the combination function in the order of
+ * the source graphs; missing values (\c None) are skipped, and edges of the
+ * new graph that receive no values at all get \c None.
+ *
+ * \param  newgraph  the graph that receives the combined attributes
+ * \param  graphs    the source graphs
+ * \param  edgemaps  one vector for each source graph that maps its edges to
+ *                   the edges of \c newgraph; negative entries denote edges
+ *                   that have no counterpart in \c newgraph
+ * \param  comb      the attribute combination specification
+ * \returns  0 if everything was OK, 1 otherwise (with a Python exception set)
+ */
+int igraphmodule_attribute_combine_edges_many(igraph_t *newgraph,
+    const igraph_vector_ptr_t *graphs, const igraph_vector_ptr_t *edgemaps,
+    const igraph_attribute_combination_t *comb) {
+  long int i, j, t, no_of_graphs = igraph_vector_ptr_size(graphs);
+  long int no_of_edges = igraph_ecount(newgraph), no_of_present;
+  PyObject *names, *name, *values, *newdict, *stack = 0, *dict = 0, *result = 0;
+  PyObject *list, *item;
+  igraph_vector_long_t counts, starts, present, targets;
+  igraph_vector_t indices, *views = 0;
+  igraph_vector_ptr_t merges;
+  Py_ssize_t pos;
+  int retval = 1;
+
+  newdict = ATTR_STRUCT_DICT(newgraph)[ATTRHASH_IDX_EDGE];
+
+  /* Collect the names of all the edge attributes */
+  names = PyDict_New();
+  if (names == 0)
+    return 1;
+  for (i = 0; i < no_of_graphs; i++) {
+    PyObject *edict = ATTR_STRUCT_DICT((igraph_t*)VECTOR(*graphs)[i])[ATTRHASH_IDX_EDGE];
+    pos = 0;
+    while (PyDict_Next(edict, &pos, &name, &values)) {
+      if (PyDict_SetItem(names, name, Py_None)) {
+        Py_DECREF(names);
+        return 1;
+      }
+    }
+  }
+
+  if (igraph_vector_long_init(&counts, no_of_edges + 1)) {
+    Py_DECREF(names);
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+  if (igraph_vector_long_init(&starts, no_of_edges + 1)) {
+    Py_DECREF(names);
+    igraph_vector_long_destroy(&counts);
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+  if (igraph_vector_long_init(&present, 0)) {
+    Py_DECREF(names);
+    igraph_vector_long_destroy(&counts);
+    igraph_vector_long_destroy(&starts);
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+  if (igraph_vector_long_init(&targets, 0)) {
+    Py_DECREF(names);
+    igraph_vector_long_destroy(&counts);
+    igraph_vector_long_destroy(&starts);
+    igraph_vector_long_destroy(&present);
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+  if (igraph_vector_init(&indices, 0)) {
+    Py_DECREF(names);
+    igraph_vector_long_destroy(&counts);
+    igraph_vector_long_destroy(&starts);
+    igraph_vector_long_destroy(&present);
+    igraph_vector_long_destroy(&targets);
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+  if (igraph_vector_ptr_init(&merges, 0)) {
+    Py_DECREF(names);
+    igraph_vector_long_destroy(&counts);
+    igraph_vector_long_destroy(&starts);
+    igraph_vector_long_destroy(&present);
+    igraph_vector_long_destroy(&targets);
+    igraph_vector_destroy(&indices);
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+
+  pos = 0;
+  while (PyDict_Next(names, &pos, &name, &item)) {
+    /* Stack the non-missing values of the attribute and count how many of
+     * them end up at each edge of the new graph */
+    stack = PyList_New(0);
+    if (stack == 0)
+      goto cleanup;
+    igraph_vector_long_null(&counts);
+    igraph_vector_long_clear(&targets);
+    for (i = 0; i < no_of_graphs; i++) {
+      igraph_t *graph = (igraph_t*)VECTOR(*graphs)[i];
+      igraph_vector_t *map = (igraph_vector_t*)VECTOR(*edgemaps)[i];
+      long int n = igraph_vector_size(map);
+      values = PyDict_GetItem(ATTR_STRUCT_DICT(graph)[ATTRHASH_IDX_EDGE], name);
+      if (values == 0)
+        continue;
+      for (j = 0; j < n; j++) {
+        t = (long int)VECTOR(*map)[j];
+        if (t < 0)
+          continue;
+        item = igraphmodule_attribute_values_get_item(values, j);
+        if (item == 0)
+          goto cleanup;
+        if (item != Py_None) {
+          if (PyList_Append(stack, item)) {
+            Py_DECREF(item);
+            goto cleanup;
+          }
+          if (igraph_vector_long_push_back(&targets, t)) {
+            Py_DECREF(item);
+            igraphmodule_handle_igraph_error();
+            goto cleanup;
+          }
+          VECTOR(counts)[t]++;
+        }
+        Py_DECREF(item);
+      }
+    }
+
+    /* Lay out the indices of the stacked values edge by edge; the order of
+     * the source graphs is kept within each edge */
+    igraph_vector_long_clear(&present);
+    for (t = 0, j = 0; t < no_of_edges; t++) {
+      VECTOR(starts)[t] = j;
+      j += VECTOR(counts)[t];
+      if (VECTOR(counts)[t] > 0 && igraph_vector_long_push_back(&present, t)) {
+        igraphmodule_handle_igraph_error();
+        goto cleanup;
+      }
+    }
+    if (igraph_vector_resize(&indices, j)) {
+      igraphmodule_handle_igraph_error();
+      goto cleanup;
+    }
+    for (j = 0; j < igraph_vector_long_size(&targets); j++) {
+      t = VECTOR(targets)[j];
+      VECTOR(indices)[VECTOR(starts)[t]++] = j;
+    }
+
+    /* One merge list for each edge that received any values; starts[t]
+     * points past the range of edge t by now */
+    no_of_present = igraph_vector_long_size(&present);
+    free(views);
+    views = (igraph_vector_t*)calloc(no_of_present + 1, sizeof(igraph_vector_t));
+    if (views == 0) {
+      PyErr_NoMemory();
+      goto cleanup;
+    }
+    if (igraph_vector_ptr_resize(&merges, no_of_present)) {
+      igraphmodule_handle_igraph_error();
+      goto cleanup;
+    }
+    for (i = 0; i < no_of_present; i++) {
+      t = VECTOR(present)[i];
+      igraph_vector_view(&views[i], VECTOR(indices) + VECTOR(starts)[t] -
+          VECTOR(counts)[t], VECTOR(counts)[t]);
+      VECTOR(merges)[i] = &views[i];
+    }
+
+    dict = PyDict_New();
+    result = PyDict_New();
+    if (dict == 0 || result == 0 || PyDict_SetItem(dict, name, stack))
+      goto cleanup;
+    Py_CLEAR(stack);
+
+    if (igraphmodule_i_attribute_combine_dicts(dict, result, &merges, comb)) {
+      igraphmodule_handle_igraph_error();
+      goto cleanup;
+    }
+
+    /* Scatter the combined values to the edges of the new graph */
+    values = PyDict_GetItem(result, name);
+    if (values != 0) {
+      list = PyList_New(no_of_edges);
+      if (list == 0)
+        goto cleanup;
+      for (t = 0; t < no_of_edges; t++) {
+        Py_INCREF(Py_None);
+        PyList_SET_ITEM(list, t, Py_None);
+      }
+      for (i = 0; i < no_of_present; i++) {
+        item = PyList_GET_ITEM(values, i);
+        Py_INCREF(item);
+        PyList_SetItem(list, VECTOR(present)[i], item);
+      }
+      if (PyDict_SetItem(newdict, name, list)) {
+        Py_DECREF(list);
+        goto cleanup;
+      }
+      Py_DECREF(list);
+    }
+
+    Py_CLEAR(dict);
+    Py_CLEAR(result);
+  }
+
+  igraphmodule_i_attribute_struct_invalidate_edge_vector_cache(ATTR_STRUCT(newgraph), 0);
+  retval = 0;
+
+cleanup:
+  Py_XDECREF(stack);
+  Py_XDECREF(dict);
+  Py_XDECREF(result);
+  Py_DECREF(names);
+  free(views);
+  igraph_vector_ptr_destroy(&merges);
+  igraph_vector_destroy(&indices);
+  igraph_vector_long_destroy(&targets);
+  igraph_vector_long_destroy(&present);
+  igraph_vector_long_destroy(&starts);
+  igraph_vector_long_destroy(&counts);
+
+  return retval;
+}
+
 /* Getting attribute names and types */
 static int igraphmodule_i_attribute_get_info(const igraph_t *graph,
 					     igraph_strvector_t *gnames,
@@ -1384,7 +2860,13 @@ static int igraphmodule_i_attribute_get_info(const igraph_t *graph,
         int is_string = 1;
         int is_boolean = 1;
         values=PyDict_GetItem(dict, PyList_GetItem(keys, j));
-        if (PyList_Check(values)) {
+        if (igraphmodule_Column_Check(values)) {
+          is_string=0;
+          if (((igraphmodule_ColumnObject*)values)->type == IGRAPHMODULE_COLUMN_BOOL)
+            is_numeric=0;
+          else
+            is_boolean=0;
+        } else if (PyList_Check(values)) {
           m=PyList_Size(values);
           for (l=0; l<m && is_numeric; l++) {
             o=PyList_GetItem(values, l);
@@ -1465,6 +2947,16 @@ int igraphmodule_i_attribute_get_type(const igraph_t *graph,
   o = PyDict_GetItemString(dict, name);
   if (o == 0) IGRAPH_ERROR("No such attribute", IGRAPH_EINVAL);
 
+  /* Typed columns know their own type */
+  if (attrnum>0 && igraphmodule_Column_Check(o)) {
+    igraphmodule_ColumnObject* column = (igraphmodule_ColumnObject*)o;
+    if (column->size > 0 && column->type == IGRAPHMODULE_COLUMN_BOOL)
+      *type = IGRAPH_ATTRIBUTE_BOOLEAN;
+    else
+      *type = IGRAPH_ATTRIBUTE_NUMERIC;
+    return 0;
+  }
+
   /* Basic type check */
   if (!PyList_Check(o)) IGRAPH_ERROR("attribute hash type mismatch", IGRAPH_EINVAL);
   j = PyList_Size(o);
@@ -1614,7 +3106,27 @@ int igraphmodule_i_get_numeric_vertex_attr(const igraph_t *graph,
   list = PyDict_GetItemString(dict, name);
   if (!list) IGRAPH_ERROR("No such attribute", IGRAPH_EINVAL);
 
-  if (igraph_vs_is_all(&vs)) {
+  if (igraphmodule_Column_Check(list)) {
+    igraphmodule_ColumnObject* column = (igraphmodule_ColumnObject*)list;
+    if (igraph_vs_is_all(&vs)) {
+      if (igraphmodule_Column_to_vector_t(column, value))
+        IGRAPH_ERROR("Internal error", IGRAPH_EINVAL);
+    } else {
+      igraph_vit_t it;
+      long int i=0;
+      IGRAPH_CHECK(igraph_vit_create(graph, vs, &it));
+      IGRAPH_FINALLY(igraph_vit_destroy, &it);
+      IGRAPH_CHECK(igraph_vector_resize(value, IGRAPH_VIT_SIZE(it)));
+      while (!IGRAPH_VIT_END(it)) {
+        VECTOR(*value)[i] = igraphmodule_Column_get_real(column,
+            (Py_ssize_t)IGRAPH_VIT_GET(it));
+        IGRAPH_VIT_NEXT(it);
+        i++;
+      }
+      igraph_vit_destroy(&it);
+      IGRAPH_FINALLY_CLEAN(1);
+    }
+  } else if (igraph_vs_is_all(&vs)) {
     if (igraphmodule_PyObject_float_to_vector_t(list, &newvalue))
       IGRAPH_ERROR("Internal error", IGRAPH_EINVAL);
     igraph_vector_update(value, &newvalue);
@@ -1647,7 +3159,7 @@ int igraphmodule_i_get_string_vertex_attr(const igraph_t *graph,
 					  const char *name,
 					  igraph_vs_t vs,
 					  igraph_strvector_t *value) {
-  PyObject *dict, *list, *result;
+  PyObject *dict, *list, *result, *column_values = 0;
   igraph_strvector_t newvalue;
 
   dict = ATTR_STRUCT_DICT(graph)[ATTRHASH_IDX_VERTEX];
@@ -1655,6 +3167,15 @@ int igraphmodule_i_get_string_vertex_attr(const igraph_t *graph,
   if (!list)
     IGRAPH_ERROR("No such attribute", IGRAPH_EINVAL);
 
+  if (igraphmodule_Column_Check(list)) {
+    /* Typed columns are converted to a temporary list here */
+    column_values = igraphmodule_Column_to_list((igraphmodule_ColumnObject*)list);
+    if (!column_values)
+      IGRAPH_ERROR("can't convert attribute column to a list", IGRAPH_ENOMEM);
+    list = column_values;
+  }
+  IGRAPH_FINALLY(Py_DecRef, column_values);
+
   if (igraph_vs_is_all(&vs)) {
     if (igraphmodule_PyList_to_strvector_t(list, &newvalue))
       IGRAPH_ERROR("Internal error", IGRAPH_EINVAL);
@@ -1693,6 +3214,9 @@ int igraphmodule_i_get_string_vertex_attr(const igraph_t *graph,
     IGRAPH_FINALLY_CLEAN(1);
   }
 
+  Py_XDECREF(column_values);
+  IGRAPH_FINALLY_CLEAN(1);
+
   return 0;
 }
 
@@ -1708,7 +3232,22 @@ int igraphmodule_i_get_boolean_vertex_attr(const igraph_t *graph,
   list = PyDict_GetItemString(dict, name);
   if (!list) IGRAPH_ERROR("No such attribute", IGRAPH_EINVAL);
 
-  if (igraph_vs_is_all(&vs)) {
+  if (igraphmodule_Column_Check(list)) {
+    igraphmodule_ColumnObject* column = (igraphmodule_ColumnObject*)list;
+    igraph_vit_t it;
+    long int i=0;
+    IGRAPH_CHECK(igraph_vit_create(graph, vs, &it));
+    IGRAPH_FINALLY(igraph_vit_destroy, &it);
+    IGRAPH_CHECK(igraph_vector_bool_resize(value, IGRAPH_VIT_SIZE(it)));
+    while (!IGRAPH_VIT_END(it)) {
+      VECTOR(*value)[i] = igraphmodule_Column_get_bool(column,
+          (Py_ssize_t)IGRAPH_VIT_GET(it));
+      IGRAPH_VIT_NEXT(it);
+      i++;
+    }
+    igraph_vit_destroy(&it);
+    IGRAPH_FINALLY_CLEAN(1);
+  } else if (igraph_vs_is_all(&vs)) {
     if (igraphmodule_PyObject_to_vector_bool_t(list, &newvalue))
       IGRAPH_ERROR("Internal error", IGRAPH_EINVAL);
     igraph_vector_bool_update(value, &newvalue);
@@ -1744,7 +3283,27 @@ int igraphmodule_i_get_numeric_edge_attr(const igraph_t *graph,
   list = PyDict_GetItemString(dict, name);
   if (!list) IGRAPH_ERROR("No such attribute", IGRAPH_EINVAL);
 
-  if (igraph_es_is_all(&es)) {
+  if (igraphmodule_Column_Check(list)) {
+    igraphmodule_ColumnObject* column = (igraphmodule_ColumnObject*)list;
+    if (igraph_es_is_all(&es)) {
+      if (igraphmodule_Column_to_vector_t(column, value))
+        IGRAPH_ERROR("Internal error", IGRAPH_EINVAL);
+    } else {
+      igraph_eit_t it;
+      long int i=0;
+      IGRAPH_CHECK(igraph_eit_create(graph, es, &it));
+      IGRAPH_FINALLY(igraph_eit_destroy, &it);
+      IGRAPH_CHECK(igraph_vector_resize(value, IGRAPH_EIT_SIZE(it)));
+      while (!IGRAPH_EIT_END(it)) {
+        VECTOR(*value)[i] = igraphmodule_Column_get_real(column,
+            (Py_ssize_t)IGRAPH_EIT_GET(it));
+        IGRAPH_EIT_NEXT(it);
+        i++;
+      }
+      igraph_eit_destroy(&it);
+      IGRAPH_FINALLY_CLEAN(1);
+    }
+  } else if (igraph_es_is_all(&es)) {
     if (igraphmodule_PyObject_float_to_vector_t(list, &newvalue))
       IGRAPH_ERROR("Internal error", IGRAPH_EINVAL);
     igraph_vector_update(value, &newvalue);
@@ -1777,13 +3336,22 @@ int igraphmodule_i_get_string_edge_attr(const igraph_t *graph,
 					const char *name,
 					igraph_es_t es,
 					igraph_strvector_t *value) {
-  PyObject *dict, *list, *result;
+  PyObject *dict, *list, *result, *column_values = 0;
   igraph_strvector_t newvalue;
 
   dict = ATTR_STRUCT_DICT(graph)[ATTRHASH_IDX_EDGE];
   list = PyDict_GetItemString(dict, name);
   if (!list) IGRAPH_ERROR("No such attribute", IGRAPH_EINVAL);
 
+  if (igraphmodule_Column_Check(list)) {
+    /* Typed columns are converted to a temporary list here */
+    column_values = igraphmodule_Column_to_list((igraphmodule_ColumnObject*)list);
+    if (!column_values)
+      IGRAPH_ERROR("can't convert attribute column to a list", IGRAPH_ENOMEM);
+    list = column_values;
+  }
+  IGRAPH_FINALLY(Py_DecRef, column_values);
+
   if (igraph_es_is_all(&es)) {
     if (igraphmodule_PyList_to_strvector_t(list, &newvalue))
       IGRAPH_ERROR("Internal error", IGRAPH_EINVAL);
@@ -1821,6 +3389,9 @@ int igraphmodule_i_get_string_edge_attr(const igraph_t *graph,
     IGRAPH_FINALLY_CLEAN(1);
   }
 
+  Py_XDECREF(column_values);
+  IGRAPH_FINALLY_CLEAN(1);
+
   return 0;
 }
 
@@ -1836,7 +3407,22 @@ int igraphmodule_i_get_boolean_edge_attr(const igraph_t *graph,
   list = PyDict_GetItemString(dict, name);
   if (!list) IGRAPH_ERROR("No such attribute", IGRAPH_EINVAL);
 
-  if (igraph_es_is_all(&es)) {
+  if (igraphmodule_Column_Check(list)) {
+    igraphmodule_ColumnObject* column = (igraphmodule_ColumnObject*)list;
+    igraph_eit_t it;
+    long int i=0;
+    IGRAPH_CHECK(igraph_eit_create(graph, es, &it));
+    IGRAPH_FINALLY(igraph_eit_destroy, &it);
+    IGRAPH_CHECK(igraph_vector_bool_resize(value, IGRAPH_EIT_SIZE(it)));
+    while (!IGRAPH_EIT_END(it)) {
+      VECTOR(*value)[i] = igraphmodule_Column_get_bool(column,
+          (Py_ssize_t)IGRAPH_EIT_GET(it));
+      IGRAPH_EIT_NEXT(it);
+      i++;
+    }
+    igraph_eit_destroy(&it);
+    IGRAPH_FINALLY_CLEAN(1);
+  } else if (igraph_es_is_all(&es)) {
     if (igraphmodule_PyObject_to_vector_bool_t(list, &newvalue))
       IGRAPH_ERROR("Internal error", IGRAPH_EINVAL);
     igraph_vector_bool_update(value, &newvalue);
@@ -1860,28 +3446,118 @@ int igraphmodule_i_get_boolean_edge_attr(const igraph_t *graph,
   return 0;
 }
 
+/* The C core may call the attribute handler from a section that has
+ * released the GIL (see threading.h), therefore the attribute table points
+ * to thin wrappers that re-acquire the GIL around the actual handlers. */
+#define GIL_WRAPPER(rettype, name, params, args) \
+  static rettype name##_gil params { \
+    PyGILState_STATE gstate = PyGILState_Ensure(); \
+    rettype result = name args; \
+    PyGILState_Release(gstate); \
+    return result; \
+  }
+#define GIL_WRAPPER_VOID(name, params, args) \
+  static void name##_gil params { \
+    PyGILState_STATE gstate = PyGILState_Ensure(); \
+    name args; \
+    PyGILState_Release(gstate); \
+  }
+
+GIL_WRAPPER(int, igraphmodule_i_attribute_init,
+    (igraph_t *graph, igraph_vector_ptr_t *attr), (graph, attr))
+GIL_WRAPPER_VOID(igraphmodule_i_attribute_destroy,
+    (igraph_t *graph), (graph))
+GIL_WRAPPER(int, igraphmodule_i_attribute_copy,
+    (igraph_t *to, const igraph_t *from, igraph_bool_t ga, igraph_bool_t va,
+     igraph_bool_t ea), (to, from, ga, va, ea))
+GIL_WRAPPER(int, igraphmodule_i_attribute_add_vertices,
+    (igraph_t *graph, long int nv, igraph_vector_ptr_t *attr),
+    (graph, nv, attr))
+GIL_WRAPPER(int, igraphmodule_i_attribute_permute_vertices,
+    (const igraph_t *graph, igraph_t *newgraph, const igraph_vector_t *idx),
+    (graph, newgraph, idx))
+GIL_WRAPPER(int, igraphmodule_i_attribute_combine_vertices,
+    (const igraph_t *graph, igraph_t *newgraph,
+     const igraph_vector_ptr_t *merges,
+     const igraph_attribute_combination_t *comb),
+    (graph, newgraph, merges, comb))
+GIL_WRAPPER(int, igraphmodule_i_attribute_add_edges,
+    (igraph_t *graph, const igraph_vector_t *edges, igraph_vector_ptr_t *attr),
+    (graph, edges, attr))
+GIL_WRAPPER(int, igraphmodule_i_attribute_permute_edges,
+    (const igraph_t *graph, igraph_t *newgraph, const igraph_vector_t *idx),
+    (graph, newgraph, idx))
+GIL_WRAPPER(int, igraphmodule_i_attribute_combine_edges,
+    (const igraph_t *graph, igraph_t *newgraph,
+     const igraph_vector_ptr_t *merges,
+     const igraph_attribute_combination_t *comb),
+    (graph, newgraph, merges, comb))
+GIL_WRAPPER(int, igraphmodule_i_attribute_get_info,
+    (const igraph_t *graph, igraph_strvector_t *gnames,
+     igraph_vector_t *gtypes, igraph_strvector_t *vnames,
+     igraph_vector_t *vtypes, igraph_strvector_t *enames,
+     igraph_vector_t *etypes),
+    (graph, gnames, gtypes, vnames, vtypes, enames, etypes))
+GIL_WRAPPER(igraph_bool_t, igraphmodule_i_attribute_has_attr,
+    (const igraph_t *graph, igraph_attribute_elemtype_t type,
+     const char *name), (graph, type, name))
+GIL_WRAPPER(int, igraphmodule_i_attribute_get_type,
+    (const igraph_t *graph, igraph_attribute_type_t *type,
+     igraph_attribute_elemtype_t elemtype, const char *name),
+    (graph, type, elemtype, name))
+GIL_WRAPPER(int, igraphmodule_i_get_numeric_graph_attr,
+    (const igraph_t *graph, const char *name, igraph_vector_t *value),
+    (graph, name, value))
+GIL_WRAPPER(int, igraphmodule_i_get_string_graph_attr,
+    (const igraph_t *graph, const char *name, igraph_strvector_t *value),
+    (graph, name, value))
+GIL_WRAPPER(int, igraphmodule_i_get_boolean_graph_attr,
+    (const igraph_t *graph, const char *name, igraph_vector_bool_t *value),
+    (graph, name, value))
+GIL_WRAPPER(int, igraphmodule_i_get_numeric_vertex_attr,
+    (const igraph_t *graph, const char *name, igraph_vs_t vs,
+     igraph_vector_t *value), (graph, name, vs, value))
+GIL_WRAPPER(int, igraphmodule_i_get_string_vertex_attr,
+    (const igraph_t *graph, const char *name, igraph_vs_t vs,
+     igraph_strvector_t *value), (graph, name, vs, value))
+GIL_WRAPPER(int, igraphmodule_i_get_boolean_vertex_attr,
+    (const igraph_t *graph, const char *name, igraph_vs_t vs,
+     igraph_vector_bool_t *value), (graph, name, vs, value))
+GIL_WRAPPER(int, igraphmodule_i_get_numeric_edge_attr,
+    (const igraph_t *graph, const char *name, igraph_es_t es,
+     igraph_vector_t *value), (graph, name, es, value))
+GIL_WRAPPER(int, igraphmodule_i_get_string_edge_attr,
+    (const igraph_t *graph, const char *name, igraph_es_t es,
+     igraph_strvector_t *value), (graph, name, es, value))
+GIL_WRAPPER(int, igraphmodule_i_get_boolean_edge_attr,
+    (const igraph_t *graph, const char *name, igraph_es_t es,
+     igraph_vector_bool_t *value), (graph, name, es, value))
+
+#undef GIL_WRAPPER
+#undef GIL_WRAPPER_VOID
+
 static igraph_attribute_table_t igraphmodule_attribute_table = {
-  igraphmodule_i_attribute_init,
-  igraphmodule_i_attribute_destroy,
-  igraphmodule_i_attribute_copy,
-  igraphmodule_i_attribute_add_vertices,
-  igraphmodule_i_attribute_permute_vertices,
-  igraphmodule_i_attribute_combine_vertices,
-  igraphmodule_i_attribute_add_edges,
-  igraphmodule_i_attribute_permute_edges,
-  igraphmodule_i_attribute_combine_edges,
-  igraphmodule_i_attribute_get_info,
-  igraphmodule_i_attribute_has_attr,
-  igraphmodule_i_attribute_get_type,
-  igraphmodule_i_get_numeric_graph_attr,
-  igraphmodule_i_get_string_graph_attr,
-  igraphmodule_i_get_boolean_graph_attr,
-  igraphmodule_i_get_numeric_vertex_attr,
-  igraphmodule_i_get_string_vertex_attr,
-  igraphmodule_i_get_boolean_vertex_attr,
-  igraphmodule_i_get_numeric_edge_attr,
-  igraphmodule_i_get_string_edge_attr,
-  igraphmodule_i_get_boolean_edge_attr,
+  igraphmodule_i_attribute_init_gil,
+  igraphmodule_i_attribute_destroy_gil,
+  igraphmodule_i_attribute_copy_gil,
+  igraphmodule_i_attribute_add_vertices_gil,
+  igraphmodule_i_attribute_permute_vertices_gil,
+  igraphmodule_i_attribute_combine_vertices_gil,
+  igraphmodule_i_attribute_add_edges_gil,
+  igraphmodule_i_attribute_permute_edges_gil,
+  igraphmodule_i_attribute_combine_edges_gil,
+  igraphmodule_i_attribute_get_info_gil,
+  igraphmodule_i_attribute_has_attr_gil,
+  igraphmodule_i_attribute_get_type_gil,
+  igraphmodule_i_get_numeric_graph_attr_gil,
+  igraphmodule_i_get_string_graph_attr_gil,
+  igraphmodule_i_get_boolean_graph_attr_gil,
+  igraphmodule_i_get_numeric_vertex_attr_gil,
+  igraphmodule_i_get_string_vertex_attr_gil,
+  igraphmodule_i_get_boolean_vertex_attr_gil,
+  igraphmodule_i_get_numeric_edge_attr_gil,
+  igraphmodule_i_get_string_edge_attr_gil,
+  igraphmodule_i_get_boolean_edge_attr_gil,
 };
 
 void igraphmodule_initialize_attribute_handler(void) {
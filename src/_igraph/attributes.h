@@ -29,6 +29,8 @@
 #include <igraph_iterators.h>
 #include <igraph_strvector.h>
 #include <igraph_vector.h>
+#include "adjacency.h"
+#include "edgeindex.h"
 
 #define ATTRHASH_IDX_GRAPH  0
 #define ATTRHASH_IDX_VERTEX 1
@@ -37,6 +39,15 @@
 typedef struct {
   PyObject* attrs[3];
   PyObject* vertex_name_index;
+  PyObject* edge_vector_cache;
+  igraphmodule_edge_index_t* edge_index;
+  // Cached adjacency lists for IGRAPH_OUT, IGRAPH_IN and IGRAPH_ALL, and the
+  // number of queries that found no cached lists since the graph changed
+  igraphmodule_adjacency_t* adjacency[3];
+  long int adjacency_queries;
+  // Canonical forms of the graph computed by BLISS, keyed by the splitting
+  // heuristic and the vertex colors they were computed with
+  PyObject* canonical_forms;
 } igraphmodule_i_attribute_struct;
 
 #define ATTR_STRUCT(graph) ((igraphmodule_i_attribute_struct*)((graph)->attr))
@@ -82,7 +93,27 @@ int igraphmodule_attribute_name_check(PyObject* obj);
 void igraphmodule_initialize_attribute_handler(void);
 void igraphmodule_index_vertex_names(igraph_t *graph, igraph_bool_t force);
 void igraphmodule_invalidate_vertex_name_index(igraph_t *graph);
+void igraphmodule_update_vertex_name_index(igraph_t *graph, long int vid,
+    PyObject* old_name, PyObject* new_name);
 int igraphmodule_get_vertex_id_by_name(igraph_t *graph, PyObject* o, igraph_integer_t* id);
+int igraphmodule_get_vertex_ids_by_name(igraph_t *graph, PyObject* names,
+    igraph_vector_t* ids);
+
+const igraph_vector_t* igraphmodule_get_cached_edge_attribute_vector(
+    const igraph_t *graph, const char* name);
+int igraphmodule_cache_edge_attribute_vector(const igraph_t *graph,
+    const char* name, const igraph_vector_t* v);
+void igraphmodule_invalidate_edge_attribute_vector_cache(const igraph_t *graph,
+    PyObject* name);
+
+const igraphmodule_edge_index_t* igraphmodule_get_edge_index(const igraph_t *graph);
+void igraphmodule_set_edge_index(const igraph_t *graph,
+    igraphmodule_edge_index_t* index);
+
+PyObject* igraphmodule_get_cached_canonical_form(const igraph_t *graph,
+    PyObject* key);
+int igraphmodule_cache_canonical_form(const igraph_t *graph, PyObject* key,
+    PyObject* form);
 
 PyObject* igraphmodule_create_edge_attribute(const igraph_t* graph,
     const char* name);
@@ -91,6 +122,19 @@ PyObject* igraphmodule_create_or_get_edge_attribute_values(const igraph_t* graph
 PyObject* igraphmodule_get_edge_attribute_values(const igraph_t* graph,
     const char* name);
 
+Py_ssize_t igraphmodule_attribute_values_size(PyObject* values);
+PyObject* igraphmodule_attribute_values_get_item(PyObject* values, Py_ssize_t index);
+PyObject* igraphmodule_attribute_values_to_list(PyObject* values);
+PyObject* igraphmodule_attribute_values_as_list(PyObject* dict, PyObject* key);
+int igraphmodule_attribute_values_set_item(PyObject* dict, PyObject* key,
+    PyObject** values, Py_ssize_t index, PyObject* item);
+int igraphmodule_attribute_values_filter(PyObject* values, igraph_vector_t* ids,
+    PyObject* op, PyObject* value);
+
+int igraphmodule_attribute_combine_edges_many(igraph_t *newgraph,
+    const igraph_vector_ptr_t *graphs, const igraph_vector_ptr_t *edgemaps,
+    const igraph_attribute_combination_t *comb);
+
 igraph_bool_t igraphmodule_has_graph_attribute(const igraph_t *graph, const char* name);
 igraph_bool_t igraphmodule_has_vertex_attribute(const igraph_t *graph, const char* name);
 igraph_bool_t igraphmodule_has_edge_attribute(const igraph_t *graph, const char* name);
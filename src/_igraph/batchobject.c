@@ -0,0 +1,1234 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#include "attributes.h"
+#include "batchobject.h"
+#include "common.h"
+#include "convert.h"
+#include "edgeobject.h"
+#include "edgeseqobject.h"
+#include "error.h"
+#include "py2compat.h"
+#include "threading.h"
+#include "vertexobject.h"
+#include "vertexseqobject.h"
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Creates a new, empty batch of modifications of a graph
+ */
+PyObject* igraphmodule_GraphBatch_new(igraphmodule_GraphObject *g) {
+  igraphmodule_GraphBatchObject* o;
+
+  o = PyObject_GC_New(igraphmodule_GraphBatchObject, &igraphmodule_GraphBatchType);
+  if (!o)
+    return NULL;
+
+  Py_INCREF(g);
+  o->gref = g;
+  o->base_vcount = igraph_vcount(&g->g);
+  o->base_ecount = igraph_ecount(&g->g);
+  o->no_of_new_nodes = 0;
+  o->vertex_attrs = PyDict_New();
+  o->edge_attrs = PyDict_New();
+  o->new_names = PyDict_New();
+
+  if (igraph_vector_init(&o->new_edges, 0)) {
+    igraph_vector_init(&o->deleted_edges, 0);
+    igraph_vector_init(&o->deleted_vertices, 0);
+    igraphmodule_handle_igraph_error();
+    Py_DECREF(o);
+    return NULL;
+  }
+  if (igraph_vector_init(&o->deleted_edges, 0)) {
+    igraph_vector_init(&o->deleted_vertices, 0);
+    igraphmodule_handle_igraph_error();
+    Py_DECREF(o);
+    return NULL;
+  }
+  if (igraph_vector_init(&o->deleted_vertices, 0)) {
+    igraphmodule_handle_igraph_error();
+    Py_DECREF(o);
+    return NULL;
+  }
+
+  PyObject_GC_Track(o);
+
+  if (!o->vertex_attrs || !o->edge_attrs || !o->new_names) {
+    Py_DECREF(o);
+    return NULL;
+  }
+
+  RC_ALLOC("GraphBatch", o);
+
+  return (PyObject*)o;
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Support for cyclic garbage collection in Python
+ */
+static int igraphmodule_GraphBatch_traverse(igraphmodule_GraphBatchObject *self,
+    visitproc visit, void *arg) {
+  RC_TRAVERSE("GraphBatch", self);
+  Py_VISIT(self->gref);
+  Py_VISIT(self->vertex_attrs);
+  Py_VISIT(self->edge_attrs);
+  Py_VISIT(self->new_names);
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Clears the batch's subobjects (before deallocation)
+ */
+static int igraphmodule_GraphBatch_clear(igraphmodule_GraphBatchObject *self) {
+  Py_CLEAR(self->gref);
+  Py_CLEAR(self->vertex_attrs);
+  Py_CLEAR(self->edge_attrs);
+  Py_CLEAR(self->new_names);
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Deallocates a batch
+ */
+static void igraphmodule_GraphBatch_dealloc(igraphmodule_GraphBatchObject* self) {
+  PyObject_GC_UnTrack(self);
+  igraphmodule_GraphBatch_clear(self);
+  igraph_vector_destroy(&self->new_edges);
+  igraph_vector_destroy(&self->deleted_edges);
+  igraph_vector_destroy(&self->deleted_vertices);
+
+  RC_DEALLOC("GraphBatch", self);
+
+  PyObject_GC_Del(self);
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Returns whether the batch has no pending modifications
+ */
+static igraph_bool_t igraphmodule_i_GraphBatch_is_empty(
+    igraphmodule_GraphBatchObject *self) {
+  return self->no_of_new_nodes == 0 && igraph_vector_empty(&self->new_edges) &&
+    igraph_vector_empty(&self->deleted_edges) &&
+    igraph_vector_empty(&self->deleted_vertices) &&
+    PyDict_Size(self->vertex_attrs) == 0 && PyDict_Size(self->edge_attrs) == 0;
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Drops all the pending modifications of the batch
+ */
+static void igraphmodule_i_GraphBatch_reset(igraphmodule_GraphBatchObject *self) {
+  self->no_of_new_nodes = 0;
+  igraph_vector_clear(&self->new_edges);
+  igraph_vector_clear(&self->deleted_edges);
+  igraph_vector_clear(&self->deleted_vertices);
+  PyDict_Clear(self->vertex_attrs);
+  PyDict_Clear(self->edge_attrs);
+  PyDict_Clear(self->new_names);
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Checks that the graph has not been modified directly since the
+ *        first pending modification was added to the batch.
+ *
+ * An empty batch simply takes the current size of the graph as its base.
+ *
+ * \return zero if everything is OK, 1 otherwise (with an exception set)
+ */
+static int igraphmodule_i_GraphBatch_sync(igraphmodule_GraphBatchObject *self) {
+  long int vcount = igraph_vcount(&self->gref->g);
+  long int ecount = igraph_ecount(&self->gref->g);
+
+  if (igraphmodule_i_GraphBatch_is_empty(self)) {
+    self->base_vcount = vcount;
+    self->base_ecount = ecount;
+    return 0;
+  }
+
+  if (vcount != self->base_vcount || ecount != self->base_ecount) {
+    PyErr_SetString(PyExc_RuntimeError, "the graph was modified directly "
+        "while the batch had pending modifications");
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Converts a Python object to the ID of a vertex of the graph or of
+ *        a vertex added by the batch.
+ *
+ * Names are looked up among the vertices of the graph first and then among
+ * the vertices added by the batch.
+ */
+static int igraphmodule_i_GraphBatch_resolve_vertex(
+    igraphmodule_GraphBatchObject *self, PyObject *o, igraph_integer_t *vid) {
+  long int no_of_nodes = self->base_vcount + self->no_of_new_nodes;
+  PyObject *new_vid;
+
+  if (PyBaseString_Check(o)) {
+    if (!igraphmodule_get_vertex_id_by_name(&self->gref->g, o, vid))
+      return 0;
+    new_vid = PyDict_GetItem(self->new_names, o);
+    if (new_vid == 0)
+      return 1;
+    PyErr_Clear();
+    *vid = (igraph_integer_t) PyInt_AsLong(new_vid);
+    return 0;
+  }
+
+  if (igraphmodule_PyObject_to_vid(o, vid, 0))
+    return 1;
+
+  if (*vid < 0 || *vid >= no_of_nodes) {
+    PyErr_Format(PyExc_ValueError, "vertex ID %ld is out of range", (long) *vid);
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Converts a Python object to the ID of an edge of the graph or of
+ *        an edge added by the batch.
+ */
+static int igraphmodule_i_GraphBatch_resolve_edge(
+    igraphmodule_GraphBatchObject *self, PyObject *o, igraph_integer_t *eid) {
+  long int no_of_edges = self->base_ecount + igraph_vector_size(&self->new_edges) / 2;
+
+  if (o == Py_None || igraphmodule_PyObject_to_eid(o, eid, 0))
+    return 1;
+
+  if (*eid < 0 || *eid >= no_of_edges) {
+    PyErr_Format(PyExc_ValueError, "edge ID %ld is out of range", (long) *eid);
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Converts an edge list, given either as a numeric buffer with two
+ *        columns or as an iterable of pairs, to a vector of endpoints.
+ *
+ * \param vector  an initialized vector; the endpoints are appended to it
+ */
+static int igraphmodule_i_GraphBatch_parse_edges(
+    igraphmodule_GraphBatchObject *self, PyObject *o, igraph_vector_t *vector) {
+  long int no_of_nodes = self->base_vcount + self->no_of_new_nodes;
+  igraphmodule_buffer_item_kind_t kind;
+  Py_buffer buffer;
+  PyObject *it, *item, *u_o, *v_o;
+  igraph_integer_t u, v;
+  igraph_real_t ru, rv;
+  const char *row;
+  Py_ssize_t i, n;
+  int ok;
+
+  if (PyBaseString_Check(o)) {
+    PyErr_SetString(PyExc_TypeError, "expected a sequence or an iterable "
+        "containing integer or string pairs");
+    return 1;
+  }
+
+  if (PyObject_CheckBuffer(o)) {
+    if (PyObject_GetBuffer(o, &buffer, PyBUF_STRIDES | PyBUF_FORMAT))
+      return 1;
+    kind = igraphmodule_buffer_item_kind(&buffer);
+    if (kind == IGRAPHMODULE_BUFFER_ITEM_UNSUPPORTED) {
+      PyErr_SetString(PyExc_TypeError, "edge list must be a numeric buffer");
+      PyBuffer_Release(&buffer);
+      return 1;
+    }
+    if (buffer.ndim != 2 || buffer.shape[1] != 2) {
+      PyErr_SetString(PyExc_ValueError, "edge list must be a buffer with two columns");
+      PyBuffer_Release(&buffer);
+      return 1;
+    }
+
+    n = buffer.shape[0];
+    if (igraph_vector_reserve(vector, igraph_vector_size(vector) + 2 * n)) {
+      igraphmodule_handle_igraph_error();
+      PyBuffer_Release(&buffer);
+      return 1;
+    }
+
+    row = (const char*) buffer.buf;
+    for (i = 0; i < n; i++, row += buffer.strides[0]) {
+      ru = igraphmodule_buffer_item_as_real(row, kind, buffer.itemsize);
+      rv = igraphmodule_buffer_item_as_real(row + buffer.strides[1], kind,
+          buffer.itemsize);
+      if (!(ru >= 0 && ru < no_of_nodes && rv >= 0 && rv < no_of_nodes) ||
+          ru != (long int) ru || rv != (long int) rv) {
+        PyErr_Format(PyExc_ValueError, "invalid vertex ID in row %ld of edge list",
+            (long) i);
+        PyBuffer_Release(&buffer);
+        return 1;
+      }
+      igraph_vector_push_back(vector, ru);   /* reserved */
+      igraph_vector_push_back(vector, rv);   /* reserved */
+    }
+
+    PyBuffer_Release(&buffer);
+    return 0;
+  }
+
+  it = PyObject_GetIter(o);
+  if (!it)
+    return 1;
+
+  while ((item = PyIter_Next(it)) != 0) {
+    if (!PySequence_Check(item) || PySequence_Size(item) != 2) {
+      PyErr_SetString(PyExc_TypeError, "iterable must return pairs of integers or strings");
+      ok = 0;
+    } else {
+      u_o = PySequence_ITEM(item, 0);
+      v_o = u_o ? PySequence_ITEM(item, 1) : 0;
+      ok = (u_o != 0 && v_o != 0);
+      ok = ok && !igraphmodule_i_GraphBatch_resolve_vertex(self, u_o, &u);
+      ok = ok && !igraphmodule_i_GraphBatch_resolve_vertex(self, v_o, &v);
+      Py_XDECREF(u_o); Py_XDECREF(v_o);
+    }
+    Py_DECREF(item);
+
+    if (ok && (igraph_vector_push_back(vector, u) ||
+               igraph_vector_push_back(vector, v))) {
+      igraphmodule_handle_igraph_error();
+      ok = 0;
+    }
+
+    if (!ok) {
+      Py_DECREF(it);
+      return 1;
+    }
+  }
+
+  Py_DECREF(it);
+  return PyErr_Occurred() ? 1 : 0;
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Checks whether a dict of attribute values may be stored for
+ *        \c n new vertices or edges.
+ *
+ * \param single  whether the values of the dict are the values themselves
+ *                (for a single vertex or edge) and not sequences
+ */
+static int igraphmodule_i_GraphBatch_check_values(PyObject *values,
+    Py_ssize_t n, igraph_bool_t single) {
+  PyObject *key, *value;
+  Py_ssize_t pos = 0, size;
+
+  if (values == 0 || values == Py_None)
+    return 0;
+
+  if (!PyDict_Check(values)) {
+    PyErr_SetString(PyExc_TypeError, "attributes must be given in a dict");
+    return 1;
+  }
+
+  while (PyDict_Next(values, &pos, &key, &value)) {
+    if (!igraphmodule_attribute_name_check(key))
+      return 1;
+    if (single)
+      continue;
+    if (PyBaseString_Check(value) || !PySequence_Check(value)) {
+      PyErr_SetString(PyExc_TypeError, "attribute values must be given in a sequence");
+      return 1;
+    }
+    size = PySequence_Size(value);
+    if (size < 0)
+      return 1;
+    if (size != n) {
+      PyErr_Format(PyExc_ValueError, "expected %ld attribute values, got %ld",
+          (long) n, (long) size);
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Records that an attribute of a vertex or edge is set to a value
+ */
+static int igraphmodule_i_GraphBatch_store_value(PyObject *attrs,
+    PyObject *name, long int id, PyObject *value) {
+  PyObject *writes, *key;
+  int retval;
+
+  writes = PyDict_GetItem(attrs, name);
+  if (writes == 0) {
+    writes = PyDict_New();
+    if (writes == 0)
+      return 1;
+    if (PyDict_SetItem(attrs, name, writes)) {
+      Py_DECREF(writes);
+      return 1;
+    }
+    Py_DECREF(writes);    /* attrs holds a reference */
+  }
+
+  key = PyInt_FromLong(id);
+  if (key == 0)
+    return 1;
+  retval = PyDict_SetItem(writes, key, value);
+  Py_DECREF(key);
+
+  return retval ? 1 : 0;
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Records the attribute values of \c n new vertices or edges,
+ *        starting from ID \c first.
+ *
+ * The values must have been checked with
+ * \ref igraphmodule_i_GraphBatch_check_values() first.
+ */
+static int igraphmodule_i_GraphBatch_store_values(PyObject *attrs,
+    PyObject *values, long int first, Py_ssize_t n, igraph_bool_t single) {
+  PyObject *key, *value, *item;
+  Py_ssize_t pos = 0, i;
+  int retval;
+
+  if (values == 0 || values == Py_None)
+    return 0;
+
+  while (PyDict_Next(values, &pos, &key, &value)) {
+    if (single) {
+      if (igraphmodule_i_GraphBatch_store_value(attrs, key, first, value))
+        return 1;
+      continue;
+    }
+    for (i = 0; i < n; i++) {
+      item = PySequence_GetItem(value, i);
+      if (item == 0)
+        return 1;
+      retval = igraphmodule_i_GraphBatch_store_value(attrs, key, first + i, item);
+      Py_DECREF(item);
+      if (retval)
+        return 1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Records the new vertices with the given names
+ */
+static int igraphmodule_i_GraphBatch_store_names(igraphmodule_GraphBatchObject *self,
+    PyObject *names, long int first) {
+  PyObject *name_key, *item, *vid_o;
+  Py_ssize_t i, n = PySequence_Fast_GET_SIZE(names);
+  int retval = 0;
+
+  name_key = PyString_FromString("name");
+  if (name_key == 0)
+    return 1;
+
+  for (i = 0; i < n && !retval; i++) {
+    item = PySequence_Fast_GET_ITEM(names, i);
+    retval = igraphmodule_i_GraphBatch_store_value(self->vertex_attrs,
+        name_key, first + i, item);
+    /* The first vertex with a given name wins, as in the name index */
+    if (!retval && PyDict_GetItem(self->new_names, item) == 0) {
+      vid_o = PyInt_FromLong(first + i);
+      retval = vid_o == 0 || PyDict_SetItem(self->new_names, item, vid_o);
+      Py_XDECREF(vid_o);
+    }
+  }
+
+  Py_DECREF(name_key);
+  return retval ? 1 : 0;
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Writes the pending attribute values of the batch into the
+ *        attribute dict of the vertices or the edges of the graph.
+ */
+static int igraphmodule_i_GraphBatch_apply_values(igraphmodule_GraphBatchObject *self,
+    PyObject *attrs, int attr_type) {
+  igraph_t *graph = &self->gref->g;
+  PyObject *dict = ATTR_STRUCT_DICT(graph)[attr_type];
+  PyObject *name, *writes, *values, *key, *value, *old_name;
+  Py_ssize_t pos = 0, pos2, i, n;
+  igraph_bool_t is_name;
+  long int id;
+
+  n = attr_type == ATTRHASH_IDX_VERTEX ? igraph_vcount(graph) : igraph_ecount(graph);
+
+  while (PyDict_Next(attrs, &pos, &name, &writes)) {
+    is_name = attr_type == ATTRHASH_IDX_VERTEX &&
+      PyString_IsEqualToASCIIString(name, "name");
+    if (attr_type == ATTRHASH_IDX_EDGE)
+      igraphmodule_invalidate_edge_attribute_vector_cache(graph, name);
+
+    values = PyDict_GetItem(dict, name);
+    if (values == 0) {
+      /* New attribute; the vertex name index is rebuilt when needed */
+      if (is_name) {
+        igraphmodule_invalidate_vertex_name_index(graph);
+        is_name = 0;
+      }
+      values = PyList_New(n);
+      if (values == 0)
+        return 1;
+      for (i = 0; i < n; i++) {
+        Py_INCREF(Py_None);
+        PyList_SET_ITEM(values, i, Py_None);
+      }
+      if (PyDict_SetItem(dict, name, values)) {
+        Py_DECREF(values);
+        return 1;
+      }
+      Py_DECREF(values);    /* dict holds a reference */
+    }
+
+    pos2 = 0;
+    while (PyDict_Next(writes, &pos2, &key, &value)) {
+      id = PyInt_AsLong(key);
+      old_name = 0;
+      if (is_name) {
+        /* The name attribute is always stored in a list */
+        old_name = PyList_GetItem(values, id);
+        Py_XINCREF(old_name);
+      }
+      Py_INCREF(value);
+      if (igraphmodule_attribute_values_set_item(dict, name, &values, id, value)) {
+        Py_XDECREF(old_name);
+        return 1;
+      }
+      if (old_name) {
+        igraphmodule_update_vertex_name_index(graph, id, old_name, value);
+        Py_DECREF(old_name);
+      }
+    }
+  }
+
+  return 0;
+}
+
+/** \ingroup python_interface_batch
+ * \brief Adds vertices to the batch
+ */
+static PyObject* igraphmodule_GraphBatch_add_vertices(
+    igraphmodule_GraphBatchObject *self, PyObject *args, PyObject *kwds) {
+  static char *kwlist[] = { "n", "attributes", NULL };
+  PyObject *n_o, *attrs_o = Py_None, *names = 0, *tmp;
+  igraph_bool_t single = 0;
+  long int first, n = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &n_o, &attrs_o))
+    return NULL;
+
+  if (igraphmodule_i_GraphBatch_sync(self))
+    return NULL;
+
+  if (PyBaseString_Check(n_o)) {
+    /* A single vertex with a name; the attributes are the values themselves */
+    tmp = PyTuple_Pack(1, n_o);
+    if (tmp == 0)
+      return NULL;
+    names = PySequence_Fast(tmp, "");
+    Py_DECREF(tmp);
+    single = 1;
+  } else if (PyIndex_Check(n_o)) {
+    n = PyInt_AsLong(n_o);
+    if (n == -1 && PyErr_Occurred())
+      return NULL;
+    if (n < 0) {
+      PyErr_SetString(PyExc_ValueError, "number of vertices must be non-negative");
+      return NULL;
+    }
+  } else {
+    names = PySequence_Fast(n_o, "n must be an integer, a string or a "
+        "sequence of strings");
+  }
+
+  if (names) {
+    n = (long int) PySequence_Fast_GET_SIZE(names);
+  } else if (PyErr_Occurred()) {
+    return NULL;
+  }
+
+  if (igraphmodule_i_GraphBatch_check_values(attrs_o, n, single)) {
+    Py_XDECREF(names);
+    return NULL;
+  }
+
+  first = self->base_vcount + self->no_of_new_nodes;
+  if ((names && igraphmodule_i_GraphBatch_store_names(self, names, first)) ||
+      igraphmodule_i_GraphBatch_store_values(self->vertex_attrs, attrs_o,
+        first, n, single)) {
+    Py_XDECREF(names);
+    return NULL;
+  }
+  self->no_of_new_nodes += n;
+
+  Py_XDECREF(names);
+  Py_RETURN_NONE;
+}
+
+/** \ingroup python_interface_batch
+ * \brief Adds a single vertex to the batch
+ */
+static PyObject* igraphmodule_GraphBatch_add_vertex(
+    igraphmodule_GraphBatchObject *self, PyObject *args, PyObject *kwds) {
+  PyObject *name_o = Py_None, *attrs, *names;
+  long int first;
+
+  if (!PyArg_UnpackTuple(args, "add_vertex", 0, 1, &name_o))
+    return NULL;
+
+  if (igraphmodule_i_GraphBatch_sync(self))
+    return NULL;
+
+  attrs = kwds ? PyDict_Copy(kwds) : PyDict_New();
+  if (attrs == 0)
+    return NULL;
+  if (name_o == Py_None && (name_o = PyDict_GetItemString(attrs, "name")) != 0) {
+    Py_INCREF(name_o);
+    PyDict_DelItemString(attrs, "name");
+  } else {
+    Py_INCREF(name_o);
+  }
+
+  if (igraphmodule_i_GraphBatch_check_values(attrs, 1, 1)) {
+    Py_DECREF(name_o);
+    Py_DECREF(attrs);
+    return NULL;
+  }
+
+  first = self->base_vcount + self->no_of_new_nodes;
+  if (name_o != Py_None) {
+    names = PyTuple_Pack(1, name_o);
+    if (names == 0 || igraphmodule_i_GraphBatch_store_names(self, names, first)) {
+      Py_XDECREF(names);
+      Py_DECREF(name_o);
+      Py_DECREF(attrs);
+      return NULL;
+    }
+    Py_DECREF(names);
+  }
+  Py_DECREF(name_o);
+
+  if (igraphmodule_i_GraphBatch_store_values(self->vertex_attrs, attrs, first, 1, 1)) {
+    Py_DECREF(attrs);
+    return NULL;
+  }
+  self->no_of_new_nodes++;
+
+  Py_DECREF(attrs);
+  Py_RETURN_NONE;
+}
+
+/** \ingroup python_interface_batch
+ * \brief Adds edges to the batch
+ */
+static PyObject* igraphmodule_GraphBatch_add_edges(
+    igraphmodule_GraphBatchObject *self, PyObject *args, PyObject *kwds) {
+  static char *kwlist[] = { "es", "attributes", NULL };
+  PyObject *es_o, *attrs_o = Py_None;
+  igraph_vector_t edges;
+  long int first, n;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &es_o, &attrs_o))
+    return NULL;
+
+  if (igraphmodule_i_GraphBatch_sync(self))
+    return NULL;
+
+  if (igraph_vector_init(&edges, 0)) {
+    igraphmodule_handle_igraph_error();
+    return NULL;
+  }
+
+  if (igraphmodule_i_GraphBatch_parse_edges(self, es_o, &edges)) {
+    igraph_vector_destroy(&edges);
+    return NULL;
+  }
+
+  n = igraph_vector_size(&edges) / 2;
+  if (igraphmodule_i_GraphBatch_check_values(attrs_o, n, 0)) {
+    igraph_vector_destroy(&edges);
+    return NULL;
+  }
+
+  first = self->base_ecount + igraph_vector_size(&self->new_edges) / 2;
+  if (igraph_vector_append(&self->new_edges, &edges)) {
+    igraphmodule_handle_igraph_error();
+    igraph_vector_destroy(&edges);
+    return NULL;
+  }
+  igraph_vector_destroy(&edges);
+
+  if (igraphmodule_i_GraphBatch_store_values(self->edge_attrs, attrs_o, first, n, 0))
+    return NULL;
+
+  Py_RETURN_NONE;
+}
+
+/** \ingroup python_interface_batch
+ * \brief Adds a single edge to the batch
+ */
+static PyObject* igraphmodule_GraphBatch_add_edge(
+    igraphmodule_GraphBatchObject *self, PyObject *args, PyObject *kwds) {
+  PyObject *source_o, *target_o;
+  igraph_integer_t source, target;
+  long int first;
+
+  if (!PyArg_UnpackTuple(args, "add_edge", 2, 2, &source_o, &target_o))
+    return NULL;
+
+  if (igraphmodule_i_GraphBatch_sync(self))
+    return NULL;
+
+  if (igraphmodule_i_GraphBatch_resolve_vertex(self, source_o, &source) ||
+      igraphmodule_i_GraphBatch_resolve_vertex(self, target_o, &target) ||
+      igraphmodule_i_GraphBatch_check_values(kwds, 1, 1))
+    return NULL;
+
+  first = self->base_ecount + igraph_vector_size(&self->new_edges) / 2;
+  if (igraph_vector_push_back(&self->new_edges, source) ||
+      igraph_vector_push_back(&self->new_edges, target)) {
+    igraph_vector_resize(&self->new_edges, 2 * (first - self->base_ecount));
+    igraphmodule_handle_igraph_error();
+    return NULL;
+  }
+
+  if (igraphmodule_i_GraphBatch_store_values(self->edge_attrs, kwds, first, 1, 1))
+    return NULL;
+
+  Py_RETURN_NONE;
+}
+
+/** \ingroup python_interface_batch
+ * \brief Marks edges of the batch for deletion
+ */
+static PyObject* igraphmodule_GraphBatch_delete_edges(
+    igraphmodule_GraphBatchObject *self, PyObject *args, PyObject *kwds) {
+  static char *kwlist[] = { "es", NULL };
+  PyObject *es_o, *it, *item;
+  igraph_vector_t eids;
+  igraph_integer_t eid;
+  long int i, n, no_of_edges;
+  int ok = 1;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &es_o))
+    return NULL;
+
+  if (igraphmodule_i_GraphBatch_sync(self))
+    return NULL;
+
+  if (igraph_vector_init(&eids, 0)) {
+    igraphmodule_handle_igraph_error();
+    return NULL;
+  }
+
+  if (PyObject_IsInstance(es_o, (PyObject*)&igraphmodule_EdgeSeqType)) {
+    igraphmodule_EdgeSeqObject *eso = (igraphmodule_EdgeSeqObject*)es_o;
+    if (eso->gref != self->gref) {
+      PyErr_SetString(PyExc_ValueError, "edge sequence belongs to another graph");
+      ok = 0;
+    } else if (igraph_es_as_vector(&self->gref->g, eso->es, &eids)) {
+      igraphmodule_handle_igraph_error();
+      ok = 0;
+    }
+  } else if (PyIndex_Check(es_o) ||
+      PyObject_IsInstance(es_o, (PyObject*)&igraphmodule_EdgeType)) {
+    ok = !igraphmodule_i_GraphBatch_resolve_edge(self, es_o, &eid);
+    if (ok && igraph_vector_push_back(&eids, eid)) {
+      igraphmodule_handle_igraph_error();
+      ok = 0;
+    }
+  } else if ((it = PyObject_GetIter(es_o)) != 0) {
+    while (ok && (item = PyIter_Next(it)) != 0) {
+      ok = !igraphmodule_i_GraphBatch_resolve_edge(self, item, &eid);
+      Py_DECREF(item);
+      if (ok && igraph_vector_push_back(&eids, eid)) {
+        igraphmodule_handle_igraph_error();
+        ok = 0;
+      }
+    }
+    Py_DECREF(it);
+    ok = ok && !PyErr_Occurred();
+  } else {
+    ok = 0;
+  }
+
+  if (ok) {
+    no_of_edges = self->base_ecount + igraph_vector_size(&self->new_edges) / 2;
+    n = igraph_vector_size(&eids);
+    for (i = 0; i < n; i++) {
+      if (VECTOR(eids)[i] >= no_of_edges) {
+        PyErr_Format(PyExc_ValueError, "edge ID %ld is out of range",
+            (long) VECTOR(eids)[i]);
+        ok = 0;
+        break;
+      }
+    }
+  }
+
+  if (ok && igraph_vector_append(&self->deleted_edges, &eids)) {
+    igraphmodule_handle_igraph_error();
+    ok = 0;
+  }
+  igraph_vector_destroy(&eids);
+
+  if (!ok)
+    return NULL;
+
+  Py_RETURN_NONE;
+}
+
+/** \ingroup python_interface_batch
+ * \brief Marks vertices of the batch for deletion
+ */
+static PyObject* igraphmodule_GraphBatch_delete_vertices(
+    igraphmodule_GraphBatchObject *self, PyObject *args, PyObject *kwds) {
+  static char *kwlist[] = { "vs", NULL };
+  PyObject *vs_o, *it, *item;
+  igraph_vector_t vids;
+  igraph_integer_t vid;
+  int ok = 1;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &vs_o))
+    return NULL;
+
+  if (igraphmodule_i_GraphBatch_sync(self))
+    return NULL;
+
+  if (igraph_vector_init(&vids, 0)) {
+    igraphmodule_handle_igraph_error();
+    return NULL;
+  }
+
+  if (PyObject_IsInstance(vs_o, (PyObject*)&igraphmodule_VertexSeqType)) {
+    igraphmodule_VertexSeqObject *vso = (igraphmodule_VertexSeqObject*)vs_o;
+    if (vso->gref != self->gref) {
+      PyErr_SetString(PyExc_ValueError, "vertex sequence belongs to another graph");
+      ok = 0;
+    } else if (igraph_vs_as_vector(&self->gref->g, vso->vs, &vids)) {
+      igraphmodule_handle_igraph_error();
+      ok = 0;
+    }
+  } else if (PyBaseString_Check(vs_o) || PyIndex_Check(vs_o) ||
+      PyObject_IsInstance(vs_o, (PyObject*)&igraphmodule_VertexType)) {
+    ok = !igraphmodule_i_GraphBatch_resolve_vertex(self, vs_o, &vid);
+    if (ok && igraph_vector_push_back(&vids, vid)) {
+      igraphmodule_handle_igraph_error();
+      ok = 0;
+    }
+  } else if ((it = PyObject_GetIter(vs_o)) != 0) {
+    while (ok && (item = PyIter_Next(it)) != 0) {
+      ok = !igraphmodule_i_GraphBatch_resolve_vertex(self, item, &vid);
+      Py_DECREF(item);
+      if (ok && igraph_vector_push_back(&vids, vid)) {
+        igraphmodule_handle_igraph_error();
+        ok = 0;
+      }
+    }
+    Py_DECREF(it);
+    ok = ok && !PyErr_Occurred();
+  } else {
+    ok = 0;
+  }
+
+  if (ok && igraph_vector_append(&self->deleted_vertices, &vids)) {
+    igraphmodule_handle_igraph_error();
+    ok = 0;
+  }
+  igraph_vector_destroy(&vids);
+
+  if (!ok)
+    return NULL;
+
+  Py_RETURN_NONE;
+}
+
+/** \ingroup python_interface_batch
+ * \brief Records the value of an attribute of a vertex
+ */
+static PyObject* igraphmodule_GraphBatch_set_vertex_attribute(
+    igraphmodule_GraphBatchObject *self, PyObject *args, PyObject *kwds) {
+  static char *kwlist[] = { "vertex", "name", "value", NULL };
+  PyObject *vertex_o, *name_o, *value_o, *names;
+  igraph_integer_t vid;
+  int retval;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOO", kwlist, &vertex_o,
+                                   &name_o, &value_o))
+    return NULL;
+
+  if (igraphmodule_i_GraphBatch_sync(self) ||
+      igraphmodule_i_GraphBatch_resolve_vertex(self, vertex_o, &vid) ||
+      !igraphmodule_attribute_name_check(name_o))
+    return NULL;
+
+  /* Names of the new vertices are also recorded for resolving edges */
+  if (vid >= self->base_vcount && PyString_IsEqualToASCIIString(name_o, "name")) {
+    names = PyTuple_Pack(1, value_o);
+    if (names == 0)
+      return NULL;
+    retval = igraphmodule_i_GraphBatch_store_names(self, names, vid);
+    Py_DECREF(names);
+  } else {
+    retval = igraphmodule_i_GraphBatch_store_value(self->vertex_attrs, name_o,
+        vid, value_o);
+  }
+
+  if (retval)
+    return NULL;
+
+  Py_RETURN_NONE;
+}
+
+/** \ingroup python_interface_batch
+ * \brief Records the value of an attribute of an edge
+ */
+static PyObject* igraphmodule_GraphBatch_set_edge_attribute(
+    igraphmodule_GraphBatchObject *self, PyObject *args, PyObject *kwds) {
+  static char *kwlist[] = { "edge", "name", "value", NULL };
+  PyObject *edge_o, *name_o, *value_o;
+  igraph_integer_t eid;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOO", kwlist, &edge_o,
+                                   &name_o, &value_o))
+    return NULL;
+
+  if (igraphmodule_i_GraphBatch_sync(self) ||
+      igraphmodule_i_GraphBatch_resolve_edge(self, edge_o, &eid) ||
+      !igraphmodule_attribute_name_check(name_o) ||
+      igraphmodule_i_GraphBatch_store_value(self->edge_attrs, name_o, eid, value_o))
+    return NULL;
+
+  Py_RETURN_NONE;
+}
+
+/** \ingroup python_interface_batch
+ * \brief Applies the pending modifications of the batch to the graph
+ */
+static PyObject* igraphmodule_GraphBatch_commit(igraphmodule_GraphBatchObject *self) {
+  igraph_t *graph = &self->gref->g;
+  int retval = 0;
+
+  if (igraphmodule_i_GraphBatch_is_empty(self))
+    Py_RETURN_NONE;
+
+  if (!igraphmodule_Graph_check_not_busy(self->gref) ||
+      igraphmodule_i_GraphBatch_sync(self))
+    return NULL;
+
+  /* From here on the graph is modified; the batch is emptied even if
+   * something goes wrong so it does not refer to a graph that has changed */
+  if (self->no_of_new_nodes > 0 &&
+      igraph_add_vertices(graph, (igraph_integer_t) self->no_of_new_nodes, 0)) {
+    igraphmodule_handle_igraph_error();
+    retval = 1;
+  }
+
+  if (!retval && !igraph_vector_empty(&self->new_edges) &&
+      igraph_add_edges(graph, &self->new_edges, 0)) {
+    igraphmodule_handle_igraph_error();
+    retval = 1;
+  }
+
+  retval = retval ||
+    igraphmodule_i_GraphBatch_apply_values(self, self->vertex_attrs, ATTRHASH_IDX_VERTEX) ||
+    igraphmodule_i_GraphBatch_apply_values(self, self->edge_attrs, ATTRHASH_IDX_EDGE);
+
+  if (!retval && !igraph_vector_empty(&self->deleted_edges) &&
+      igraph_delete_edges(graph, igraph_ess_vector(&self->deleted_edges))) {
+    igraphmodule_handle_igraph_error();
+    retval = 1;
+  }
+
+  if (!retval && !igraph_vector_empty(&self->deleted_vertices) &&
+      igraph_delete_vertices(graph, igraph_vss_vector(&self->deleted_vertices))) {
+    igraphmodule_handle_igraph_error();
+    retval = 1;
+  }
+
+  igraphmodule_i_GraphBatch_reset(self);
+
+  if (retval)
+    return NULL;
+
+  Py_RETURN_NONE;
+}
+
+/** \ingroup python_interface_batch
+ * \brief Drops the pending modifications of the batch
+ */
+static PyObject* igraphmodule_GraphBatch_discard(igraphmodule_GraphBatchObject *self) {
+  igraphmodule_i_GraphBatch_reset(self);
+  Py_RETURN_NONE;
+}
+
+/** \ingroup python_interface_batch
+ * \brief Returns the batch itself when entering a \c with block
+ */
+static PyObject* igraphmodule_GraphBatch_enter(igraphmodule_GraphBatchObject *self) {
+  Py_INCREF(self);
+  return (PyObject*)self;
+}
+
+/** \ingroup python_interface_batch
+ * \brief Commits the batch when leaving a \c with block normally, discards
+ *        it when the block raised an exception
+ */
+static PyObject* igraphmodule_GraphBatch_exit(igraphmodule_GraphBatchObject *self,
+    PyObject *args) {
+  PyObject *exc_type = Py_None, *exc_value = Py_None, *traceback = Py_None;
+  PyObject *result;
+
+  if (!PyArg_UnpackTuple(args, "__exit__", 0, 3, &exc_type, &exc_value, &traceback))
+    return NULL;
+
+  if (exc_type == Py_None) {
+    result = igraphmodule_GraphBatch_commit(self);
+    if (result == 0)
+      return NULL;
+    Py_DECREF(result);
+  } else {
+    igraphmodule_i_GraphBatch_reset(self);
+  }
+
+  Py_RETURN_FALSE;
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Returns the number of vertices to be added by the batch
+ */
+static PyObject* igraphmodule_GraphBatch_get_vertices_added(
+    igraphmodule_GraphBatchObject* self, void* closure) {
+  return PyInt_FromLong(self->no_of_new_nodes);
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Returns the number of edges to be added by the batch
+ */
+static PyObject* igraphmodule_GraphBatch_get_edges_added(
+    igraphmodule_GraphBatchObject* self, void* closure) {
+  return PyInt_FromLong(igraph_vector_size(&self->new_edges) / 2);
+}
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Returns the graph modified by the batch
+ */
+static PyObject* igraphmodule_GraphBatch_get_graph(
+    igraphmodule_GraphBatchObject* self, void* closure) {
+  Py_INCREF(self->gref);
+  return (PyObject*)self->gref;
+}
+
+/**
+ * \ingroup python_interface_batch
+ * Method table for the \c igraph.GraphBatch object
+ */
+static PyMethodDef igraphmodule_GraphBatch_methods[] = {
+  {"add_vertex", (PyCFunction)igraphmodule_GraphBatch_add_vertex,
+    METH_VARARGS | METH_KEYWORDS,
+    "add_vertex(name=None, **kwds)\n\n"
+    "Adds a single vertex to the batch. Keyword arguments are assigned\n"
+    "to the vertex as attributes.\n\n"
+    "@param name: the name of the new vertex. Edges added to the batch\n"
+    "  later may refer to the vertex by its name.\n"
+  },
+  {"add_vertices", (PyCFunction)igraphmodule_GraphBatch_add_vertices,
+    METH_VARARGS | METH_KEYWORDS,
+    "add_vertices(n, attributes=None)\n\n"
+    "Adds some vertices to the batch.\n\n"
+    "@param n: the number of vertices to be added, or the name of a single\n"
+    "  vertex to be added, or a sequence of strings, each corresponding to\n"
+    "  the name of a vertex to be added.\n"
+    "@param attributes: dict of sequences, all of length equal to the\n"
+    "  number of vertices to be added, containing the attributes of the new\n"
+    "  vertices. If n is a string, the values of this dict are the\n"
+    "  attributes themselves.\n"
+  },
+  {"add_edge", (PyCFunction)igraphmodule_GraphBatch_add_edge,
+    METH_VARARGS | METH_KEYWORDS,
+    "add_edge(source, target, **kwds)\n\n"
+    "Adds a single edge to the batch. Keyword arguments are assigned\n"
+    "to the edge as attributes.\n\n"
+    "@param source: the source vertex of the edge or its name.\n"
+    "@param target: the target vertex of the edge or its name.\n"
+  },
+  {"add_edges", (PyCFunction)igraphmodule_GraphBatch_add_edges,
+    METH_VARARGS | METH_KEYWORDS,
+    "add_edges(es, attributes=None)\n\n"
+    "Adds some edges to the batch.\n\n"
+    "@param es: the list of edges to be added. Every edge is represented\n"
+    "  with a tuple containing the vertex IDs or names of the two\n"
+    "  endpoints. Numeric buffers with two columns (e.g., NumPy arrays of\n"
+    "  any integer or floating-point type) are also accepted and copied\n"
+    "  directly.\n"
+    "@param attributes: dict of sequences, all of length equal to the\n"
+    "  number of edges to be added, containing the attributes of the new\n"
+    "  edges.\n"
+  },
+  {"delete_edges", (PyCFunction)igraphmodule_GraphBatch_delete_edges,
+    METH_VARARGS | METH_KEYWORDS,
+    "delete_edges(es)\n\n"
+    "Marks some edges for deletion. The edges are removed after all the\n"
+    "additions of the batch, therefore edges added by the batch may be\n"
+    "deleted as well.\n\n"
+    "@param es: a single edge ID, a list of edge IDs or an L{EdgeSeq} of\n"
+    "  the graph.\n"
+  },
+  {"delete_vertices", (PyCFunction)igraphmodule_GraphBatch_delete_vertices,
+    METH_VARARGS | METH_KEYWORDS,
+    "delete_vertices(vs)\n\n"
+    "Marks some vertices for deletion, along with all their edges. The\n"
+    "vertices are removed after all the additions and the edge deletions\n"
+    "of the batch.\n\n"
+    "Repeated small deletions are much cheaper when they are collected\n"
+    "in a batch, since the graph and its attributes are compacted only\n"
+    "once, on commit.\n\n"
+    "@param vs: a single vertex ID or name, a list of vertex IDs or names\n"
+    "  or a L{VertexSeq} of the graph.\n"
+  },
+  {"set_vertex_attribute", (PyCFunction)igraphmodule_GraphBatch_set_vertex_attribute,
+    METH_VARARGS | METH_KEYWORDS,
+    "set_vertex_attribute(vertex, name, value)\n\n"
+    "Sets an attribute of a vertex of the graph or of a vertex added by\n"
+    "the batch.\n\n"
+    "@param vertex: the ID or the name of the vertex\n"
+    "@param name: the name of the attribute\n"
+    "@param value: the new value of the attribute\n"
+  },
+  {"set_edge_attribute", (PyCFunction)igraphmodule_GraphBatch_set_edge_attribute,
+    METH_VARARGS | METH_KEYWORDS,
+    "set_edge_attribute(edge, name, value)\n\n"
+    "Sets an attribute of an edge of the graph or of an edge added by\n"
+    "the batch.\n\n"
+    "@param edge: the ID of the edge\n"
+    "@param name: the name of the attribute\n"
+    "@param value: the new value of the attribute\n"
+  },
+  {"commit", (PyCFunction)igraphmodule_GraphBatch_commit, METH_NOARGS,
+    "commit()\n\n"
+    "Applies the pending modifications to the graph and empties the batch.\n"
+    "If something goes wrong while the graph is being modified, the batch\n"
+    "is discarded and the graph may be left partially modified.\n"
+  },
+  {"discard", (PyCFunction)igraphmodule_GraphBatch_discard, METH_NOARGS,
+    "discard()\n\n"
+    "Drops the pending modifications without applying them.\n"
+  },
+  {"__enter__", (PyCFunction)igraphmodule_GraphBatch_enter, METH_NOARGS,
+    "__enter__()\n\n"
+    "Returns the batch itself.\n"
+  },
+  {"__exit__", (PyCFunction)igraphmodule_GraphBatch_exit, METH_VARARGS,
+    "__exit__(exc_type, exc_value, traceback)\n\n"
+    "Commits the batch, or discards it if the block raised an exception.\n"
+  },
+  {NULL}
+};
+
+/**
+ * \ingroup python_interface_batch
+ * Getter/setter table for the \c igraph.GraphBatch object
+ */
+static PyGetSetDef igraphmodule_GraphBatch_getseters[] = {
+  {"graph", (getter)igraphmodule_GraphBatch_get_graph, NULL,
+    "The graph modified by the batch.", NULL
+  },
+  {"vertices_added", (getter)igraphmodule_GraphBatch_get_vertices_added, NULL,
+    "The number of vertices the batch adds to the graph.", NULL
+  },
+  {"edges_added", (getter)igraphmodule_GraphBatch_get_edges_added, NULL,
+    "The number of edges the batch adds to the graph.", NULL
+  },
+  {NULL}
+};
+
+/** \ingroup python_interface_batch
+ * Python type object referencing the methods Python calls when it performs
+ * various operations on a batch of modifications
+ */
+PyTypeObject igraphmodule_GraphBatchType = {
+  PyVarObject_HEAD_INIT(0, 0)
+  "igraph.GraphBatch",                        /* tp_name */
+  sizeof(igraphmodule_GraphBatchObject),      /* tp_basicsize */
+  0,                                          /* tp_itemsize */
+  (destructor)igraphmodule_GraphBatch_dealloc, /* tp_dealloc */
+  0,                                          /* tp_print */
+  0,                                          /* tp_getattr */
+  0,                                          /* tp_setattr */
+  0,                                          /* tp_compare (2.x) / tp_reserved (3.x) */
+  0,                                          /* tp_repr */
+  0,                                          /* tp_as_number */
+  0,                                          /* tp_as_sequence */
+  0,                                          /* tp_as_mapping */
+  0,                                          /* tp_hash */
+  0,                                          /* tp_call */
+  0,                                          /* tp_str */
+  0,                                          /* tp_getattro */
+  0,                                          /* tp_setattro */
+  0,                                          /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,    /* tp_flags */
+  "Pending modifications of a graph that are applied in one go.\n\n"
+  "Batches are created by L{Graph.batch_update()}. Adding edges to a graph\n"
+  "one call at a time rebuilds the indices of the graph and extends its\n"
+  "attributes every time; a batch collects the new vertices and edges,\n"
+  "the attribute values and the edges to delete in C arrays instead and\n"
+  "applies them with a single index rebuild when it is committed. Deleted\n"
+  "vertices and edges are only marked until then, so repeated small\n"
+  "deletions compact the graph and its attributes only once.\n\n"
+  "Vertex and edge IDs refer to the graph as it is after all the additions\n"
+  "of the batch but before its deletions. Vertex names are resolved among\n"
+  "the vertices of the graph first and then among the vertices added by\n"
+  "the batch. The graph itself may not be modified while the batch has\n"
+  "pending modifications.\n",
+  (traverseproc)igraphmodule_GraphBatch_traverse, /* tp_traverse */
+  (inquiry)igraphmodule_GraphBatch_clear,     /* tp_clear */
+  0,                                          /* tp_richcompare */
+  0,                                          /* tp_weaklistoffset */
+  0,                                          /* tp_iter */
+  0,                                          /* tp_iternext */
+  igraphmodule_GraphBatch_methods,            /* tp_methods */
+  0,                                          /* tp_members */
+  igraphmodule_GraphBatch_getseters,          /* tp_getset */
+};
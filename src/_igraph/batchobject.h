@@ -0,0 +1,75 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#ifndef PYTHON_BATCHOBJECT_H
+#define PYTHON_BATCHOBJECT_H
+
+#include <Python.h>
+#include <igraph.h>
+#include "graphobject.h"
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_batch Batched modifications of a graph
+ */
+extern PyTypeObject igraphmodule_GraphBatchType;
+
+/**
+ * \ingroup python_interface_batch
+ * \brief Vertices, edges and attribute values waiting to be added to a graph
+ *        or removed from it.
+ *
+ * The changes are applied in one go on commit: the new vertices are added
+ * with a single call to \c igraph_add_vertices(), the new edges with a single
+ * call to \c igraph_add_edges(), then the attribute values are written and
+ * finally the edges and the vertices are removed with a single call to
+ * \c igraph_delete_edges() and \c igraph_delete_vertices(), respectively.
+ * Vertex and edge IDs in a batch refer to the graph as it is after the
+ * additions but before the deletions.
+ */
+typedef struct
+{
+  PyObject_HEAD
+  igraphmodule_GraphObject* gref;
+  // Number of vertices and edges of the graph when the batch was started;
+  // the graph may not be modified directly while the batch is not empty
+  long int base_vcount;
+  long int base_ecount;
+  // Number of vertices to add and the endpoints of the edges to add
+  long int no_of_new_nodes;
+  igraph_vector_t new_edges;
+  // IDs of the edges and the vertices to remove
+  igraph_vector_t deleted_edges;
+  igraph_vector_t deleted_vertices;
+  // Attribute values to write; these dicts map attribute names to dicts
+  // that map vertex (edge) IDs to the values
+  PyObject* vertex_attrs;
+  PyObject* edge_attrs;
+  // Maps the names of the new vertices to their IDs
+  PyObject* new_names;
+} igraphmodule_GraphBatchObject;
+
+PyObject* igraphmodule_GraphBatch_new(igraphmodule_GraphObject *g);
+
+#endif
@@ -21,9 +21,11 @@
 */
 
 #include "bfsiter.h"
+#include "bufferobject.h"
 #include "common.h"
 #include "error.h"
 #include "py2compat.h"
+#include "threading.h"
 #include "vertexobject.h"
 
 /**
@@ -39,9 +41,14 @@ PyTypeObject igraphmodule_BFSIterType;
  * \param g the graph object being referenced
  * \param vid the root vertex index
  * \param advanced whether the iterator should be advanced (returning distance and parent as well)
+ * \param batch the number of vertices returned in one step as arrays, or
+ *   zero if the iterator should return one vertex at a time
+ * \param max_depth the distance from the root beyond which the search does
+ *   not proceed, or a negative number if the search is unlimited
  * \return the allocated PyObject
  */
-PyObject* igraphmodule_BFSIter_new(igraphmodule_GraphObject *g, PyObject *root, igraph_neimode_t mode, igraph_bool_t advanced) {
+PyObject* igraphmodule_BFSIter_new(igraphmodule_GraphObject *g, PyObject *root, igraph_neimode_t mode, igraph_bool_t advanced,
+    long int batch, long int max_depth) {
   igraphmodule_BFSIterObject* o;
   long int no_of_nodes, r;
   
@@ -66,8 +73,9 @@ PyObject* igraphmodule_BFSIter_new(igraphmodule_GraphObject *g, PyObject *root,
     PyErr_SetString(PyExc_MemoryError, "out of memory");
     return NULL;
   }
-  if (igraph_vector_init(&o->neis, 0)) {
-    PyErr_SetString(PyExc_MemoryError, "out of memory");
+  if (!igraph_is_directed(&g->g)) mode=IGRAPH_ALL;
+  o->adj = igraphmodule_acquire_adjacency(&g->g, mode);
+  if (o->adj == 0) {
     igraph_dqueue_destroy(&o->queue);
     return NULL;
   }
@@ -81,15 +89,16 @@ PyObject* igraphmodule_BFSIter_new(igraphmodule_GraphObject *g, PyObject *root,
       igraph_dqueue_push(&o->queue, 0) ||
       igraph_dqueue_push(&o->queue, -1)) {
     igraph_dqueue_destroy(&o->queue);
-    igraph_vector_destroy(&o->neis);
+    igraphmodule_adjacency_decref(o->adj);
     PyErr_SetString(PyExc_MemoryError, "out of memory");
     return NULL;
   }
   o->visited[r]=1;
   
-  if (!igraph_is_directed(&g->g)) mode=IGRAPH_ALL;
   o->mode=mode;
   o->advanced=advanced;
+  o->batch=batch;
+  o->max_depth=max_depth;
   
   PyObject_GC_Track(o);
   
@@ -133,7 +142,8 @@ int igraphmodule_BFSIter_clear(igraphmodule_BFSIterObject *self) {
   Py_XDECREF(tmp);
 
   igraph_dqueue_destroy(&self->queue);
-  igraph_vector_destroy(&self->neis);
+  igraphmodule_adjacency_decref(self->adj);
+  self->adj = 0;
   free(self->visited);
   self->visited=0;
   
@@ -157,30 +167,117 @@ PyObject* igraphmodule_BFSIter_iter(igraphmodule_BFSIterObject* self) {
   return (PyObject*)self;
 }
 
+/**
+ * \ingroup python_interface_bfsiter
+ * \brief Takes the next vertex from the queue and queues its unvisited
+ *        neighbors unless the depth limit has been reached.
+ *
+ * Does not touch the Python API, so it may be called without the GIL.
+ *
+ * \return 0 if everything was OK, an igraph error code otherwise
+ */
+static int igraphmodule_i_BFSIter_step(igraphmodule_BFSIterObject* self,
+    igraph_integer_t *vid, igraph_integer_t *dist, igraph_integer_t *parent) {
+  long int i, end;
+
+  *vid = (igraph_integer_t)igraph_dqueue_pop(&self->queue);
+  *dist = (igraph_integer_t)igraph_dqueue_pop(&self->queue);
+  *parent = (igraph_integer_t)igraph_dqueue_pop(&self->queue);
+
+  if (self->max_depth >= 0 && *dist >= self->max_depth)
+    return 0;
+
+  end = self->adj->offsets[(long int)*vid + 1];
+  for (i = self->adj->offsets[(long int)*vid]; i < end; i++) {
+    igraph_integer_t neighbor = (igraph_integer_t)self->adj->neighbors[i];
+    if (self->visited[neighbor]==0) {
+      self->visited[neighbor]=1;
+      IGRAPH_CHECK(igraph_dqueue_push(&self->queue, neighbor));
+      IGRAPH_CHECK(igraph_dqueue_push(&self->queue, *dist+1));
+      IGRAPH_CHECK(igraph_dqueue_push(&self->queue, *vid));
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_bfsiter
+ * \brief Returns the next batch of visited vertices as a tuple of three
+ *        buffers holding the vertex IDs, the distances and the parents.
+ *
+ * The traversal itself runs without the GIL.
+ */
+static PyObject* igraphmodule_i_BFSIter_next_batch(igraphmodule_BFSIterObject* self) {
+  igraph_vector_t vids, dists, parents;
+  igraph_integer_t vid, dist, parent;
+  PyObject *vids_o, *dists_o, *parents_o;
+  long int n = 0, size = self->batch;
+  int retval = 0;
+
+  if (size > igraph_vcount(self->graph))
+    size = igraph_vcount(self->graph);
+
+  if (igraph_vector_init(&vids, size))
+    return igraphmodule_handle_igraph_error();
+  if (igraph_vector_init(&dists, size)) {
+    igraph_vector_destroy(&vids);
+    return igraphmodule_handle_igraph_error();
+  }
+  if (igraph_vector_init(&parents, size)) {
+    igraph_vector_destroy(&vids); igraph_vector_destroy(&dists);
+    return igraphmodule_handle_igraph_error();
+  }
+
+  IGRAPHMODULE_BEGIN_NOGIL(self->gref);
+  while (n < size && !igraph_dqueue_empty(&self->queue)) {
+    retval = igraphmodule_i_BFSIter_step(self, &vid, &dist, &parent);
+    if (retval)
+      break;
+    VECTOR(vids)[n] = vid;
+    VECTOR(dists)[n] = dist;
+    VECTOR(parents)[n] = parent;
+    n++;
+  }
+  IGRAPHMODULE_END_NOGIL(self->gref);
+
+  if (retval) {
+    igraphmodule_handle_igraph_error();
+    igraph_vector_destroy(&vids); igraph_vector_destroy(&dists);
+    igraph_vector_destroy(&parents);
+    return NULL;
+  }
+
+  igraph_vector_resize(&vids, n);     /* shrinking never fails */
+  igraph_vector_resize(&dists, n);
+  igraph_vector_resize(&parents, n);
+
+  vids_o = igraphmodule_Buffer_from_vector_t(&vids);
+  dists_o = vids_o ? igraphmodule_Buffer_from_vector_t(&dists) : 0;
+  parents_o = dists_o ? igraphmodule_Buffer_from_vector_t(&parents) : 0;
+  igraph_vector_destroy(&vids); igraph_vector_destroy(&dists);
+  igraph_vector_destroy(&parents);
+
+  if (parents_o == 0) {
+    Py_XDECREF(vids_o);
+    Py_XDECREF(dists_o);
+    return NULL;
+  }
+
+  return Py_BuildValue("NNN", vids_o, dists_o, parents_o);
+}
+
 PyObject* igraphmodule_BFSIter_iternext(igraphmodule_BFSIterObject* self) {
   if (!igraph_dqueue_empty(&self->queue)) {
-    igraph_integer_t vid = (igraph_integer_t)igraph_dqueue_pop(&self->queue);
-    igraph_integer_t dist = (igraph_integer_t)igraph_dqueue_pop(&self->queue);
-    igraph_integer_t parent = (igraph_integer_t)igraph_dqueue_pop(&self->queue);
-    long int i;
-    
-    if (igraph_neighbors(self->graph, &self->neis, vid, self->mode)) {
+    igraph_integer_t vid, dist, parent;
+
+    if (self->batch > 0)
+      return igraphmodule_i_BFSIter_next_batch(self);
+
+    if (igraphmodule_i_BFSIter_step(self, &vid, &dist, &parent)) {
       igraphmodule_handle_igraph_error();
       return NULL;
     }
-	
-    for (i=0; i<igraph_vector_size(&self->neis); i++) {
-      igraph_integer_t neighbor = (igraph_integer_t)VECTOR(self->neis)[i];
-      if (self->visited[neighbor]==0) {
-	self->visited[neighbor]=1;
-	if (igraph_dqueue_push(&self->queue, neighbor) ||
-	    igraph_dqueue_push(&self->queue, dist+1) ||
-	    igraph_dqueue_push(&self->queue, vid)) {
-	  igraphmodule_handle_igraph_error();
-	  return NULL;
-	}
-      }
-    }
 
     if (self->advanced) {
       PyObject *vertexobj, *parentobj;
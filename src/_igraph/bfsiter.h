@@ -24,6 +24,7 @@
 #define PYTHON_BFSITER_H
 
 #include <Python.h>
+#include "adjacency.h"
 #include "graphobject.h"
 
 /**
@@ -35,14 +36,17 @@ typedef struct
   PyObject_HEAD
   igraphmodule_GraphObject* gref;
   igraph_dqueue_t queue;
-  igraph_vector_t neis;
+  igraphmodule_adjacency_t *adj;
   igraph_t *graph;
   char *visited;
   igraph_neimode_t mode;
   igraph_bool_t advanced;
+  long int batch;
+  long int max_depth;
 } igraphmodule_BFSIterObject;
 
-PyObject* igraphmodule_BFSIter_new(igraphmodule_GraphObject *g, PyObject *o, igraph_neimode_t mode, igraph_bool_t advanced);
+PyObject* igraphmodule_BFSIter_new(igraphmodule_GraphObject *g, PyObject *o, igraph_neimode_t mode, igraph_bool_t advanced,
+    long int batch, long int max_depth);
 int igraphmodule_BFSIter_traverse(igraphmodule_BFSIterObject *self,
 				  visitproc visit, void *arg);
 int igraphmodule_BFSIter_clear(igraphmodule_BFSIterObject *self);
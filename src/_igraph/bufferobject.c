@@ -0,0 +1,332 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include "bufferobject.h"
+#include "convert.h"
+#include "error.h"
+#include "memusage.h"
+#include "py2compat.h"
+
+/**
+ * \ingroup python_interface_buffer
+ * \brief Allocates a new, empty buffer object
+ */
+static igraphmodule_BufferObject* igraphmodule_Buffer_alloc(void) {
+  igraphmodule_BufferObject* self;
+
+  self = PyObject_New(igraphmodule_BufferObject, &igraphmodule_BufferType);
+  if (self == 0)
+    return 0;
+
+  self->is_matrix = 0;
+  self->shape[0] = self->shape[1] = 0;
+  self->strides[0] = self->strides[1] = sizeof(igraph_real_t);
+
+  return self;
+}
+
+/**
+ * \ingroup python_interface_buffer
+ * \brief Returns the number of bytes allocated for the wrapped storage
+ */
+static Py_ssize_t igraphmodule_Buffer_storage_bytes(igraphmodule_BufferObject* self) {
+  const igraph_vector_t* v = self->is_matrix ? &self->matrix.data : &self->vector;
+  return (v->stor_end - v->stor_begin) * sizeof(igraph_real_t);
+}
+
+/**
+ * \ingroup python_interface_buffer
+ * \brief Returns the number of bytes used by the buffer object, including
+ *        the wrapped storage
+ */
+Py_ssize_t igraphmodule_Buffer_allocated_bytes(igraphmodule_BufferObject* self) {
+  return Py_TYPE(self)->tp_basicsize + igraphmodule_Buffer_storage_bytes(self);
+}
+
+/**
+ * \ingroup python_interface_buffer
+ * \brief Creates a buffer object that takes over the storage of the given
+ *        vector.
+ *
+ * The vector is left empty (but initialized) after the call, so the caller
+ * may (and should) still destroy it as usual.
+ */
+PyObject* igraphmodule_Buffer_from_vector_t(igraph_vector_t *v) {
+  igraphmodule_BufferObject* self;
+  igraph_vector_t empty;
+
+  if (igraph_vector_init(&empty, 0)) {
+    igraphmodule_handle_igraph_error();
+    return 0;
+  }
+
+  self = igraphmodule_Buffer_alloc();
+  if (self == 0) {
+    igraph_vector_destroy(&empty);
+    return 0;
+  }
+
+  self->vector = *v;
+  *v = empty;
+
+  self->shape[0] = igraph_vector_size(&self->vector);
+  igraphmodule_memory_track(IGRAPHMODULE_MEMORY_BUFFERS,
+      igraphmodule_Buffer_storage_bytes(self), 1);
+
+  return (PyObject*)self;
+}
+
+/**
+ * \ingroup python_interface_buffer
+ * \brief Creates a buffer object that takes over the storage of the given
+ *        matrix.
+ *
+ * The matrix is left empty (but initialized) after the call, so the caller
+ * may (and should) still destroy it as usual.
+ */
+PyObject* igraphmodule_Buffer_from_matrix_t(igraph_matrix_t *m) {
+  igraphmodule_BufferObject* self;
+  igraph_matrix_t empty;
+
+  if (igraph_matrix_init(&empty, 0, 0)) {
+    igraphmodule_handle_igraph_error();
+    return 0;
+  }
+
+  self = igraphmodule_Buffer_alloc();
+  if (self == 0) {
+    igraph_matrix_destroy(&empty);
+    return 0;
+  }
+
+  self->is_matrix = 1;
+  self->matrix = *m;
+  *m = empty;
+
+  self->shape[0] = igraph_matrix_nrow(&self->matrix);
+  self->shape[1] = igraph_matrix_ncol(&self->matrix);
+  /* igraph matrices are stored in column-major order */
+  self->strides[0] = sizeof(igraph_real_t);
+  self->strides[1] = self->shape[0] * sizeof(igraph_real_t);
+  igraphmodule_memory_track(IGRAPHMODULE_MEMORY_BUFFERS,
+      igraphmodule_Buffer_storage_bytes(self), 1);
+
+  return (PyObject*)self;
+}
+
+/**
+ * \ingroup python_interface_buffer
+ * \brief Deallocates a buffer object, freeing the wrapped storage
+ */
+static void igraphmodule_Buffer_dealloc(igraphmodule_BufferObject* self) {
+  igraphmodule_memory_track(IGRAPHMODULE_MEMORY_BUFFERS,
+      -igraphmodule_Buffer_storage_bytes(self), -1);
+  if (self->is_matrix) {
+    igraph_matrix_destroy(&self->matrix);
+  } else {
+    igraph_vector_destroy(&self->vector);
+  }
+  PyObject_Del((PyObject*)self);
+}
+
+/**
+ * \ingroup python_interface_buffer
+ * \brief Fills a \c Py_buffer structure according to the buffer protocol
+ */
+static int igraphmodule_Buffer_getbuffer(igraphmodule_BufferObject* self,
+    Py_buffer* view, int flags) {
+  int ndim = self->is_matrix ? 2 : 1;
+  igraph_bool_t contiguous = !self->is_matrix ||
+    self->shape[0] <= 1 || self->shape[1] <= 1;
+
+  if (!contiguous) {
+    if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES) {
+      PyErr_SetString(PyExc_BufferError, "matrix buffers are stored in "
+          "column-major order and can only be exported with strides");
+      view->obj = 0;
+      return -1;
+    }
+    if ((flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS) {
+      PyErr_SetString(PyExc_BufferError, "matrix buffers are stored in "
+          "column-major order and are not C-contiguous");
+      view->obj = 0;
+      return -1;
+    }
+  }
+
+  view->buf = self->is_matrix ?
+    (void*)&MATRIX(self->matrix, 0, 0) : (void*)VECTOR(self->vector);
+  view->obj = (PyObject*)self;
+  Py_INCREF(self);
+  view->len = self->shape[0] * (self->is_matrix ? self->shape[1] : 1) *
+    sizeof(igraph_real_t);
+  view->readonly = 0;
+  view->itemsize = sizeof(igraph_real_t);
+  view->format = (flags & PyBUF_FORMAT) ? "d" : 0;
+  view->ndim = ndim;
+  view->shape = (flags & PyBUF_ND) ? self->shape : 0;
+  view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? self->strides : 0;
+  view->suboffsets = 0;
+  view->internal = 0;
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_buffer
+ * \brief Returns the length of the buffer along its first dimension
+ */
+static Py_ssize_t igraphmodule_Buffer_len(igraphmodule_BufferObject* self) {
+  return self->shape[0];
+}
+
+/**
+ * \ingroup python_interface_buffer
+ * \brief Returns the shape of the buffer as a tuple
+ */
+static PyObject* igraphmodule_Buffer_get_shape(igraphmodule_BufferObject* self,
+    void* closure) {
+  if (self->is_matrix)
+    return Py_BuildValue("nn", self->shape[0], self->shape[1]);
+  return Py_BuildValue("(n)", self->shape[0]);
+}
+
+/**
+ * \ingroup python_interface_buffer
+ * \brief Converts the contents of the buffer to a (nested) Python list
+ */
+static PyObject* igraphmodule_Buffer_tolist(igraphmodule_BufferObject* self) {
+  if (self->is_matrix)
+    return igraphmodule_matrix_t_to_PyList(&self->matrix, IGRAPHMODULE_TYPE_FLOAT);
+  return igraphmodule_vector_t_to_PyList(&self->vector, IGRAPHMODULE_TYPE_FLOAT);
+}
+
+/**
+ * \ingroup python_interface_buffer
+ * \brief Formats a buffer object in a human-consumable format
+ */
+static PyObject* igraphmodule_Buffer_repr(igraphmodule_BufferObject* self) {
+  if (self->is_matrix)
+    return PyString_FromFormat("<igraph.Buffer with shape (%ld, %ld)>",
+        (long)self->shape[0], (long)self->shape[1]);
+  return PyString_FromFormat("<igraph.Buffer with shape (%ld,)>",
+      (long)self->shape[0]);
+}
+
+/**
+ * \ingroup python_interface_buffer
+ * Method table for the \c igraph.Buffer object
+ */
+static PyMethodDef igraphmodule_Buffer_methods[] = {
+  {"tolist", (PyCFunction)igraphmodule_Buffer_tolist, METH_NOARGS,
+    "tolist()\n\n"
+    "Returns the contents of the buffer as a list (for vectors) or as a\n"
+    "list of lists (for matrices).\n"
+  },
+  {NULL}
+};
+
+/**
+ * \ingroup python_interface_buffer
+ * Getter/setter table for the \c igraph.Buffer object
+ */
+static PyGetSetDef igraphmodule_Buffer_getseters[] = {
+  {"shape", (getter)igraphmodule_Buffer_get_shape, NULL,
+    "The shape of the buffer as a tuple", NULL
+  },
+  {NULL}
+};
+
+/**
+ * \ingroup python_interface_buffer
+ * Sequence protocol methods of the \c igraph.Buffer object
+ */
+static PySequenceMethods igraphmodule_Buffer_as_sequence = {
+  (lenfunc)igraphmodule_Buffer_len,           /* sq_length */
+};
+
+/**
+ * \ingroup python_interface_buffer
+ * Buffer protocol methods of the \c igraph.Buffer object
+ */
+static PyBufferProcs igraphmodule_Buffer_as_buffer = {
+#ifndef IGRAPH_PYTHON3
+  0,                                          /* bf_getreadbuffer */
+  0,                                          /* bf_getwritebuffer */
+  0,                                          /* bf_getsegcount */
+  0,                                          /* bf_getcharbuffer */
+#endif
+  (getbufferproc)igraphmodule_Buffer_getbuffer, /* bf_getbuffer */
+  0,                                          /* bf_releasebuffer */
+};
+
+#ifdef IGRAPH_PYTHON3
+#  define IGRAPHMODULE_BUFFER_TPFLAGS Py_TPFLAGS_DEFAULT
+#else
+#  define IGRAPHMODULE_BUFFER_TPFLAGS (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_NEWBUFFER)
+#endif
+
+/** \ingroup python_interface_buffer
+ * Python type object referencing the methods Python calls when it performs
+ * various operations on a buffer object
+ */
+PyTypeObject igraphmodule_BufferType = {
+  PyVarObject_HEAD_INIT(0, 0)
+  "igraph.Buffer",                            /* tp_name */
+  sizeof(igraphmodule_BufferObject),          /* tp_basicsize */
+  0,                                          /* tp_itemsize */
+  (destructor)igraphmodule_Buffer_dealloc,    /* tp_dealloc */
+  0,                                          /* tp_print */
+  0,                                          /* tp_getattr */
+  0,                                          /* tp_setattr */
+  0,                                          /* tp_compare (2.x) / tp_reserved (3.x) */
+  (reprfunc)igraphmodule_Buffer_repr,         /* tp_repr */
+  0,                                          /* tp_as_number */
+  &igraphmodule_Buffer_as_sequence,           /* tp_as_sequence */
+  0,                                          /* tp_as_mapping */
+  0,                                          /* tp_hash */
+  0,                                          /* tp_call */
+  0,                                          /* tp_str */
+  0,                                          /* tp_getattro */
+  0,                                          /* tp_setattro */
+  &igraphmodule_Buffer_as_buffer,             /* tp_as_buffer */
+  IGRAPHMODULE_BUFFER_TPFLAGS,                /* tp_flags */
+  "Buffer holding the numeric result of an igraph calculation.\n\n"
+  "Objects of this class are returned by methods called with\n"
+  "C{return_type=\"buffer\"}. They own the memory allocated by the C core\n"
+  "of igraph and expose it through the buffer protocol as double\n"
+  "precision floats, so they can be wrapped without copying, e.g., by\n"
+  "C{numpy.asarray()} or C{memoryview()}. Matrices are exposed in\n"
+  "column-major (Fortran) order.\n\n"
+  "Use L{tolist()} to convert the contents to ordinary Python lists.\n",
+  0,                                          /* tp_traverse */
+  0,                                          /* tp_clear */
+  0,                                          /* tp_richcompare */
+  0,                                          /* tp_weaklistoffset */
+  0,                                          /* tp_iter */
+  0,                                          /* tp_iternext */
+  igraphmodule_Buffer_methods,               /* tp_methods */
+  0,                                          /* tp_members */
+  igraphmodule_Buffer_getseters,              /* tp_getset */
+};
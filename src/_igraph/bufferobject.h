@@ -0,0 +1,63 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef PYTHON_BUFFEROBJECT_H
+#define PYTHON_BUFFEROBJECT_H
+
+#include <Python.h>
+#include <igraph_vector.h>
+#include <igraph_matrix.h>
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_buffer Buffer objects wrapping igraph vectors and matrices
+ */
+extern PyTypeObject igraphmodule_BufferType;
+
+/**
+ * \ingroup python_interface_buffer
+ * \brief A Python object that owns the storage of an igraph vector or matrix
+ *        and exposes it via the buffer protocol.
+ *
+ * Matrices are stored in column-major order by igraph; this is reflected
+ * in the strides of the exported buffer, hence no copying is needed.
+ */
+typedef struct {
+  PyObject_HEAD
+  // Whether the object wraps a matrix (1) or a vector (0)
+  int is_matrix;
+  // The wrapped vector, valid if is_matrix is zero
+  igraph_vector_t vector;
+  // The wrapped matrix, valid if is_matrix is non-zero
+  igraph_matrix_t matrix;
+  // Shape and strides of the exported buffer
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+} igraphmodule_BufferObject;
+
+PyObject* igraphmodule_Buffer_from_vector_t(igraph_vector_t *v);
+PyObject* igraphmodule_Buffer_from_matrix_t(igraph_matrix_t *m);
+Py_ssize_t igraphmodule_Buffer_allocated_bytes(igraphmodule_BufferObject* self);
+
+#endif
@@ -0,0 +1,334 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#include "cancellation.h"
+#include "common.h"
+#include "error.h"
+#include "py2compat.h"
+#include "threading.h"
+
+/**
+ * \ingroup python_interface_cancellation
+ * \brief Maximum number of nested \c with blocks of tokens in a thread
+ */
+#define IGRAPHMODULE_CANCELLATION_MAX_DEPTH 32
+
+/**
+ * \ingroup python_interface_cancellation
+ * \brief The tokens activated by the current thread, innermost last.
+ *
+ * Only the owner thread modifies its stack (with the GIL) and reads it
+ * (possibly without the GIL), therefore no locking is needed. The stack
+ * holds a reference to each of the tokens.
+ */
+static IGRAPHMODULE_THREAD_LOCAL igraphmodule_CancellationTokenObject*
+  igraphmodule_i_active_tokens[IGRAPHMODULE_CANCELLATION_MAX_DEPTH];
+static IGRAPHMODULE_THREAD_LOCAL int igraphmodule_i_active_token_count = 0;
+
+/**
+ * \ingroup python_interface_cancellation
+ * \brief Returns the reason why the given token is cancelled, cancelling it
+ *        first if its deadline has passed.
+ *
+ * May be called without holding the GIL.
+ */
+static int igraphmodule_i_CancellationToken_poll(
+    igraphmodule_CancellationTokenObject* self) {
+  int reason = IGRAPHMODULE_ATOMIC_LOAD(&self->reason);
+
+  if (reason == IGRAPHMODULE_CANCELLATION_NONE && self->deadline >= 0 &&
+      igraphmodule_clock() >= self->deadline) {
+    reason = IGRAPHMODULE_CANCELLATION_TIMEOUT;
+    IGRAPHMODULE_ATOMIC_STORE(&self->reason, reason);
+  }
+
+  return reason;
+}
+
+/**
+ * \ingroup python_interface_cancellation
+ * \brief Checks whether any of the tokens activated by the current thread
+ *        has been cancelled.
+ *
+ * This is cheap enough to be called in every iteration of a loop and may
+ * be called without holding the GIL. When it returns non-zero, the caller
+ * should clean up, re-acquire the GIL, call
+ * \ref igraphmodule_cancellation_raise() and return an error.
+ *
+ * \return zero if the computation may go on, non-zero otherwise
+ */
+int igraphmodule_cancellation_check(void) {
+  int i;
+
+  for (i = igraphmodule_i_active_token_count - 1; i >= 0; i--) {
+    if (igraphmodule_i_CancellationToken_poll(igraphmodule_i_active_tokens[i]))
+      return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_cancellation
+ * \brief Raises a \c CancelledError for the first cancelled token of the
+ *        current thread.
+ *
+ * Must be called with the GIL held. Exceptions that are already set are
+ * not masked.
+ */
+void igraphmodule_cancellation_raise(void) {
+  int i, reason = IGRAPHMODULE_CANCELLATION_NONE;
+
+  if (PyErr_Occurred())
+    return;
+
+  for (i = igraphmodule_i_active_token_count - 1; i >= 0 && !reason; i--)
+    reason = IGRAPHMODULE_ATOMIC_LOAD(&igraphmodule_i_active_tokens[i]->reason);
+
+  PyErr_SetString(igraphmodule_CancelledError,
+      reason == IGRAPHMODULE_CANCELLATION_TIMEOUT ? "operation timed out" :
+      "operation cancelled");
+}
+
+/**
+ * \ingroup python_interface_cancellation
+ * \brief Allocates a new cancellation token
+ */
+static PyObject* igraphmodule_CancellationToken_new(PyTypeObject* type,
+    PyObject* args, PyObject* kwds) {
+  igraphmodule_CancellationTokenObject* self;
+
+  self = (igraphmodule_CancellationTokenObject*)type->tp_alloc(type, 0);
+  if (self == 0)
+    return NULL;
+
+  self->reason = IGRAPHMODULE_CANCELLATION_NONE;
+  self->deadline = -1;
+
+  return (PyObject*)self;
+}
+
+/**
+ * \ingroup python_interface_cancellation
+ * \brief Initializes a cancellation token with an optional timeout
+ */
+static int igraphmodule_CancellationToken_init(
+    igraphmodule_CancellationTokenObject* self, PyObject* args, PyObject* kwds) {
+  static char* kwlist[] = { "timeout", NULL };
+  PyObject* timeout_o = Py_None;
+  double timeout;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &timeout_o))
+    return -1;
+
+  self->deadline = -1;
+  if (timeout_o != Py_None) {
+    timeout = PyFloat_AsDouble(timeout_o);
+    if (timeout == -1 && PyErr_Occurred())
+      return -1;
+    if (timeout < 0) {
+      PyErr_SetString(PyExc_ValueError, "timeout must not be negative");
+      return -1;
+    }
+    self->deadline = igraphmodule_clock() + timeout;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_cancellation
+ * \brief Deallocates a cancellation token
+ */
+static void igraphmodule_CancellationToken_dealloc(
+    igraphmodule_CancellationTokenObject* self) {
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+/**
+ * \ingroup python_interface_cancellation
+ * \brief Cancels the computations of the threads that activated the token
+ */
+static PyObject* igraphmodule_CancellationToken_cancel(
+    igraphmodule_CancellationTokenObject* self) {
+  if (IGRAPHMODULE_ATOMIC_LOAD(&self->reason) == IGRAPHMODULE_CANCELLATION_NONE)
+    IGRAPHMODULE_ATOMIC_STORE(&self->reason, IGRAPHMODULE_CANCELLATION_REQUESTED);
+  Py_RETURN_NONE;
+}
+
+/**
+ * \ingroup python_interface_cancellation
+ * \brief Activates the token for the current thread
+ */
+static PyObject* igraphmodule_CancellationToken_enter(
+    igraphmodule_CancellationTokenObject* self) {
+  if (igraphmodule_i_active_token_count >= IGRAPHMODULE_CANCELLATION_MAX_DEPTH) {
+    PyErr_SetString(PyExc_RuntimeError, "too many nested cancellation tokens");
+    return NULL;
+  }
+
+  Py_INCREF(self);
+  igraphmodule_i_active_tokens[igraphmodule_i_active_token_count] = self;
+  igraphmodule_i_active_token_count++;
+
+  Py_INCREF(self);
+  return (PyObject*)self;
+}
+
+/**
+ * \ingroup python_interface_cancellation
+ * \brief Deactivates the token for the current thread
+ */
+static PyObject* igraphmodule_CancellationToken_exit(
+    igraphmodule_CancellationTokenObject* self, PyObject* args) {
+  int n = igraphmodule_i_active_token_count;
+
+  if (n == 0 || igraphmodule_i_active_tokens[n - 1] != self) {
+    PyErr_SetString(PyExc_RuntimeError, "cancellation token is not the "
+        "innermost active token of the current thread");
+    return NULL;
+  }
+
+  igraphmodule_i_active_token_count--;
+  igraphmodule_i_active_tokens[n - 1] = 0;
+  Py_DECREF(self);
+
+  Py_RETURN_FALSE;
+}
+
+/**
+ * \ingroup python_interface_cancellation
+ * \brief Returns whether the token has been cancelled
+ */
+static PyObject* igraphmodule_CancellationToken_get_cancelled(
+    igraphmodule_CancellationTokenObject* self, void* closure) {
+  return PyBool_FromLong(igraphmodule_i_CancellationToken_poll(self) !=
+      IGRAPHMODULE_CANCELLATION_NONE);
+}
+
+/**
+ * \ingroup python_interface_cancellation
+ * \brief Returns whether the token has been cancelled by its timeout
+ */
+static PyObject* igraphmodule_CancellationToken_get_timed_out(
+    igraphmodule_CancellationTokenObject* self, void* closure) {
+  return PyBool_FromLong(igraphmodule_i_CancellationToken_poll(self) ==
+      IGRAPHMODULE_CANCELLATION_TIMEOUT);
+}
+
+/**
+ * \ingroup python_interface_cancellation
+ * Method table for the \c igraph.CancellationToken object
+ */
+static PyMethodDef igraphmodule_CancellationToken_methods[] = {
+  {"cancel", (PyCFunction)igraphmodule_CancellationToken_cancel, METH_NOARGS,
+    "cancel()\n\n"
+    "Cancels the token. Computations running in threads that activated the\n"
+    "token stop at their next interruption check and raise\n"
+    "L{CancelledError}. May be called from any thread.\n"
+  },
+  {"__enter__", (PyCFunction)igraphmodule_CancellationToken_enter, METH_NOARGS,
+    "__enter__()\n\n"
+    "Activates the token for the current thread.\n"
+  },
+  {"__exit__", (PyCFunction)igraphmodule_CancellationToken_exit, METH_VARARGS,
+    "__exit__(exc_type, exc_value, traceback)\n\n"
+    "Deactivates the token for the current thread.\n"
+  },
+  {NULL}
+};
+
+/**
+ * \ingroup python_interface_cancellation
+ * Getter/setter table for the \c igraph.CancellationToken object
+ */
+static PyGetSetDef igraphmodule_CancellationToken_getseters[] = {
+  {"cancelled", (getter)igraphmodule_CancellationToken_get_cancelled, NULL,
+    "Whether the token has been cancelled, either explicitly or by its\n"
+    "timeout.", NULL
+  },
+  {"timed_out", (getter)igraphmodule_CancellationToken_get_timed_out, NULL,
+    "Whether the token has been cancelled by its timeout.", NULL
+  },
+  {NULL}
+};
+
+/** \ingroup python_interface_cancellation
+ * Python type object referencing the methods Python calls when it performs
+ * various operations on a cancellation token
+ */
+PyTypeObject igraphmodule_CancellationTokenType = {
+  PyVarObject_HEAD_INIT(0, 0)
+  "igraph.CancellationToken",                 /* tp_name */
+  sizeof(igraphmodule_CancellationTokenObject), /* tp_basicsize */
+  0,                                          /* tp_itemsize */
+  (destructor)igraphmodule_CancellationToken_dealloc, /* tp_dealloc */
+  0,                                          /* tp_print */
+  0,                                          /* tp_getattr */
+  0,                                          /* tp_setattr */
+  0,                                          /* tp_compare (2.x) / tp_reserved (3.x) */
+  0,                                          /* tp_repr */
+  0,                                          /* tp_as_number */
+  0,                                          /* tp_as_sequence */
+  0,                                          /* tp_as_mapping */
+  0,                                          /* tp_hash */
+  0,                                          /* tp_call */
+  0,                                          /* tp_str */
+  0,                                          /* tp_getattro */
+  0,                                          /* tp_setattro */
+  0,                                          /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT,                         /* tp_flags */
+  "CancellationToken(timeout=None)\n\n"
+  "Token for the cooperative cancellation of long computations.\n\n"
+  "Computations started inside a C{with token:} block poll the token\n"
+  "while they are running and raise L{CancelledError} once it has been\n"
+  "cancelled, either by calling L{cancel()} from any thread or by its\n"
+  "timeout. Polling the token does not call back to Python, therefore it\n"
+  "costs next to nothing even if the global interpreter lock is released.\n"
+  "Blocks may be nested; the computation stops if any of the active\n"
+  "tokens is cancelled.\n\n"
+  "Computations are only stopped at the points where the C core checks\n"
+  "for interruptions (the same points where C{KeyboardInterrupt} is\n"
+  "noticed). Tokens are not seen by the worker threads started by\n"
+  "methods that have a C{threads} argument.\n\n"
+  "@param timeout: the number of seconds after which the token cancels\n"
+  "  itself, measured from its creation. C{None} means no timeout.\n",
+  0,                                          /* tp_traverse */
+  0,                                          /* tp_clear */
+  0,                                          /* tp_richcompare */
+  0,                                          /* tp_weaklistoffset */
+  0,                                          /* tp_iter */
+  0,                                          /* tp_iternext */
+  igraphmodule_CancellationToken_methods,     /* tp_methods */
+  0,                                          /* tp_members */
+  igraphmodule_CancellationToken_getseters,   /* tp_getset */
+  0,                                          /* tp_base */
+  0,                                          /* tp_dict */
+  0,                                          /* tp_descr_get */
+  0,                                          /* tp_descr_set */
+  0,                                          /* tp_dictoffset */
+  (initproc)igraphmodule_CancellationToken_init, /* tp_init */
+  0,                                          /* tp_alloc */
+  igraphmodule_CancellationToken_new,         /* tp_new */
+};
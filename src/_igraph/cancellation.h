@@ -0,0 +1,68 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef PYTHON_CANCELLATION_H
+#define PYTHON_CANCELLATION_H
+
+#include <Python.h>
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_cancellation Cooperative cancellation of long computations
+ */
+extern PyTypeObject igraphmodule_CancellationTokenType;
+
+/**
+ * \ingroup python_interface_cancellation
+ * \brief A flag that tells long computations of the current thread to stop.
+ *
+ * Tokens are activated for a thread with a \c with block. The interruption
+ * and progress hooks of the C core poll the flags of the active tokens
+ * without the GIL, so a token may be cancelled from any thread while others
+ * are running a computation.
+ */
+typedef struct {
+  PyObject_HEAD
+  // Why the token was cancelled; see \ref igraphmodule_cancellation_reason_t.
+  // Accessed with IGRAPHMODULE_ATOMIC_LOAD and IGRAPHMODULE_ATOMIC_STORE
+  int reason;
+  // Point of time (in terms of igraphmodule_clock()) at which the token
+  // cancels itself, or a negative number if it has no timeout
+  double deadline;
+} igraphmodule_CancellationTokenObject;
+
+/**
+ * \ingroup python_interface_cancellation
+ * \brief Reasons of cancellation
+ */
+typedef enum {
+  IGRAPHMODULE_CANCELLATION_NONE = 0,
+  IGRAPHMODULE_CANCELLATION_REQUESTED,
+  IGRAPHMODULE_CANCELLATION_TIMEOUT
+} igraphmodule_cancellation_reason_t;
+
+int igraphmodule_cancellation_check(void);
+void igraphmodule_cancellation_raise(void);
+
+#endif
@@ -0,0 +1,571 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#include "attributes.h"
+#include "canonical.h"
+#include "convert.h"
+#include "error.h"
+#include "threading.h"
+#include <stdlib.h>
+
+/**
+ * \ingroup python_interface_canonical
+ * \brief Stores an unsigned 32-bit integer in little-endian byte order
+ */
+static unsigned char* igraphmodule_i_canonical_put(unsigned char *p,
+    unsigned long int x) {
+  p[0] = (unsigned char) (x & 0xff);
+  p[1] = (unsigned char) ((x >> 8) & 0xff);
+  p[2] = (unsigned char) ((x >> 16) & 0xff);
+  p[3] = (unsigned char) ((x >> 24) & 0xff);
+  return p + 4;
+}
+
+static int igraphmodule_i_canonical_edge_cmp(const void *a, const void *b) {
+  unsigned PY_LONG_LONG x = *(const unsigned PY_LONG_LONG*)a;
+  unsigned PY_LONG_LONG y = *(const unsigned PY_LONG_LONG*)b;
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+/**
+ * \ingroup python_interface_canonical
+ * \brief Computes the canonical form of a graph
+ *
+ * The form starts with a header holding a flag word (bit 0: directed,
+ * bit 1: colored), the number of vertices and the number of edges. The
+ * colors of the vertices follow in canonical order if the graph is
+ * colored, then the endpoints of the relabeled edges, sorted and with the
+ * smaller endpoint first for undirected graphs. Graphs with multiple
+ * edges are rejected since BLISS ignores edge multiplicities.
+ *
+ * Uses the error handling of the C core but does not touch Python objects.
+ *
+ * \param graph  the graph
+ * \param color  the colors of the vertices, or \c NULL
+ * \param sh     the splitting heuristic of BLISS
+ * \param form   an initialized vector; the form is returned here
+ * \return an igraph error code
+ */
+int igraphmodule_canonical_form(const igraph_t *graph,
+    const igraph_vector_int_t *color, igraph_bliss_sh_t sh,
+    igraph_vector_char_t *form) {
+  long int no_of_nodes = igraph_vcount(graph), no_of_edges = igraph_ecount(graph);
+  long int i, u, v;
+  igraph_bool_t directed = igraph_is_directed(graph), multiple;
+  igraph_vector_t labeling;
+  unsigned PY_LONG_LONG *edges;
+  unsigned char *p;
+
+  if (color && igraph_vector_int_size(color) != no_of_nodes) {
+    IGRAPH_ERROR("color vector length must match the number of vertices",
+        IGRAPH_EINVAL);
+  }
+  IGRAPH_CHECK(igraph_has_multiple(graph, &multiple));
+  if (multiple) {
+    IGRAPH_ERROR("canonical forms of graphs with multiple edges are not supported",
+        IGRAPH_EINVAL);
+  }
+
+  IGRAPH_VECTOR_INIT_FINALLY(&labeling, no_of_nodes);
+  IGRAPH_CHECK(igraph_canonical_permutation(graph, color, &labeling, sh, 0));
+
+  edges = (unsigned PY_LONG_LONG*) calloc(no_of_edges > 0 ? no_of_edges : 1,
+      sizeof(unsigned PY_LONG_LONG));
+  if (edges == 0) {
+    IGRAPH_ERROR("not enough memory for canonical form", IGRAPH_ENOMEM);
+  }
+  IGRAPH_FINALLY(free, edges);
+
+  for (i = 0; i < no_of_edges; i++) {
+    u = (long int) VECTOR(labeling)[(long int) IGRAPH_FROM(graph, i)];
+    v = (long int) VECTOR(labeling)[(long int) IGRAPH_TO(graph, i)];
+    if (!directed && u > v) {
+      long int tmp = u; u = v; v = tmp;
+    }
+    edges[i] = ((unsigned PY_LONG_LONG) u << 32) | (unsigned PY_LONG_LONG) v;
+  }
+  qsort(edges, no_of_edges, sizeof(unsigned PY_LONG_LONG),
+      igraphmodule_i_canonical_edge_cmp);
+
+  IGRAPH_CHECK(igraph_vector_char_resize(form,
+        4 * (3 + (color ? no_of_nodes : 0) + 2 * no_of_edges)));
+  p = (unsigned char*) VECTOR(*form);
+  p = igraphmodule_i_canonical_put(p, (directed ? 1 : 0) | (color ? 2 : 0));
+  p = igraphmodule_i_canonical_put(p, no_of_nodes);
+  p = igraphmodule_i_canonical_put(p, no_of_edges);
+  if (color) {
+    /* The vertex that gets canonical label k is preceded by k vertices */
+    for (i = 0; i < no_of_nodes; i++) {
+      igraphmodule_i_canonical_put(p + 4 * (long int) VECTOR(labeling)[i],
+          (unsigned long int) VECTOR(*color)[i]);
+    }
+    p += 4 * no_of_nodes;
+  }
+  for (i = 0; i < no_of_edges; i++) {
+    p = igraphmodule_i_canonical_put(p, (unsigned long int) (edges[i] >> 32));
+    p = igraphmodule_i_canonical_put(p, (unsigned long int) (edges[i] & 0xffffffffUL));
+  }
+
+  free(edges);
+  igraph_vector_destroy(&labeling);
+  IGRAPH_FINALLY_CLEAN(2);
+
+  return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup python_interface_canonical
+ * \brief Returns the 64-bit FNV-1a hash of a canonical form as a Python
+ *        integer
+ */
+PyObject* igraphmodule_canonical_form_hash(PyObject *form) {
+  unsigned PY_LONG_LONG hash = 14695981039346656037ULL;
+  const unsigned char *p = (const unsigned char*) PyBytes_AS_STRING(form);
+  Py_ssize_t i, n = PyBytes_GET_SIZE(form);
+
+  for (i = 0; i < n; i++) {
+    hash ^= p[i];
+    hash *= 1099511628211ULL;
+  }
+
+  return PyLong_FromUnsignedLongLong(hash);
+}
+
+/**
+ * \ingroup python_interface_canonical
+ * \brief Returns the key of a canonical form in the cache of a graph
+ *
+ * The key holds the colors themselves and not the name of the attribute
+ * they came from, so that a cached form is never returned after the
+ * colors were changed.
+ */
+static PyObject* igraphmodule_i_canonical_form_key(igraph_bliss_sh_t sh,
+    const igraph_vector_int_t *color) {
+  PyObject *color_o;
+
+  if (color) {
+    color_o = PyBytes_FromStringAndSize((const char*) VECTOR(*color),
+        igraph_vector_int_size(color) * sizeof(int));
+    if (color_o == 0)
+      return NULL;
+  } else {
+    Py_INCREF(Py_None);
+    color_o = Py_None;
+  }
+
+  return Py_BuildValue("iN", (int) sh, color_o);
+}
+
+/**
+ * \ingroup python_interface_canonical
+ * \brief Converts a canonical form to a Python bytes object and caches it
+ *        in the graph under the given key
+ */
+static PyObject* igraphmodule_i_canonical_form_store(igraphmodule_GraphObject *self,
+    PyObject *key, const igraph_vector_char_t *form) {
+  PyObject *result;
+
+  result = PyBytes_FromStringAndSize(VECTOR(*form), igraph_vector_char_size(form));
+  if (result == 0)
+    return NULL;
+
+  if (igraphmodule_cache_canonical_form(&self->g, key, result)) {
+    Py_DECREF(result);
+    return NULL;
+  }
+
+  return result;
+}
+
+/**
+ * \ingroup python_interface_canonical
+ * \brief Returns the canonical form of a graph as a Python bytes object,
+ *        computing it only if it is not cached yet
+ *
+ * \param sh_o     the splitting heuristic as a Python object
+ * \param color_o  the colors of the vertices as a list, the name of a
+ *                 vertex attribute or \c None
+ * \return a new reference to the form, or \c NULL if an exception was
+ *         raised
+ */
+PyObject* igraphmodule_Graph_canonical_form(igraphmodule_GraphObject *self,
+    PyObject *sh_o, PyObject *color_o) {
+  igraph_bliss_sh_t sh = IGRAPH_BLISS_FM;
+  igraph_vector_int_t *color = 0;
+  igraph_vector_char_t form;
+  PyObject *key, *result;
+  int retval;
+
+  if (igraphmodule_PyObject_to_bliss_sh_t(sh_o, &sh))
+    return NULL;
+
+  if (igraphmodule_attrib_to_vector_int_t(color_o, self, &color,
+        ATTRIBUTE_TYPE_VERTEX))
+    return NULL;
+
+  key = igraphmodule_i_canonical_form_key(sh, color);
+  if (key == 0) {
+    if (color) { igraph_vector_int_destroy(color); free(color); }
+    return NULL;
+  }
+
+  result = igraphmodule_get_cached_canonical_form(&self->g, key);
+  if (result) {
+    if (color) { igraph_vector_int_destroy(color); free(color); }
+    Py_DECREF(key);
+    Py_INCREF(result);
+    return result;
+  }
+
+  if (igraph_vector_char_init(&form, 0)) {
+    if (color) { igraph_vector_int_destroy(color); free(color); }
+    Py_DECREF(key);
+    return igraphmodule_handle_igraph_error();
+  }
+
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraphmodule_canonical_form(&self->g, color, sh, &form);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (color) { igraph_vector_int_destroy(color); free(color); }
+
+  if (retval) {
+    igraph_vector_char_destroy(&form);
+    Py_DECREF(key);
+    return igraphmodule_handle_igraph_error();
+  }
+
+  result = igraphmodule_i_canonical_form_store(self, key, &form);
+  igraph_vector_char_destroy(&form);
+  Py_DECREF(key);
+
+  return result;
+}
+
+/**
+ * \ingroup python_interface_canonical
+ * \brief A graph of a batch whose canonical form has to be computed
+ */
+typedef struct {
+  igraphmodule_GraphObject *graph;
+  igraph_vector_int_t *color;
+  PyObject *key;
+  igraph_vector_char_t form;
+  igraph_bool_t has_form;
+  // The form as a Python object, if it was found in the cache or has
+  // already been converted
+  PyObject *result;
+} igraphmodule_i_canonical_job_t;
+
+/**
+ * \ingroup python_interface_canonical
+ * \brief A worker of a batch; worker \em i canonicalizes the pending
+ *        graphs \em i, \em i+k, \em i+2k and so on where \em k is the
+ *        number of workers
+ */
+typedef struct {
+  igraphmodule_i_canonical_job_t **pending;
+  long int no_of_pending;
+  long int index;
+  long int no_of_workers;
+  igraph_bliss_sh_t sh;
+  int retval;
+  // Exception raised in the worker thread
+  PyObject *exc_type, *exc_value, *exc_traceback;
+} igraphmodule_i_canonical_worker_t;
+
+/**
+ * \ingroup python_interface_canonical
+ * \brief Carries out the work of a worker of a batch, stopping at the
+ *        first error. Does not touch the Python API.
+ */
+static int igraphmodule_i_canonical_work(igraphmodule_i_canonical_worker_t *worker) {
+  igraphmodule_i_canonical_job_t *job;
+  long int i;
+  int retval = 0;
+
+  for (i = worker->index; !retval && i < worker->no_of_pending; i += worker->no_of_workers) {
+    job = worker->pending[i];
+    retval = igraphmodule_canonical_form(&job->graph->g, job->color,
+        worker->sh, &job->form);
+  }
+
+  return retval;
+}
+
+/**
+ * \ingroup python_interface_canonical
+ * \brief Entry point of the worker threads of a batch
+ *
+ * The thread keeps a Python thread state of its own while it is working
+ * so that an exception raised by the error hook of the C core is not lost
+ * when the hook releases the GIL; the exception is moved to the worker
+ * when the work is finished.
+ */
+static void igraphmodule_i_canonical_thread(void *workers, long int index) {
+  igraphmodule_i_canonical_worker_t *worker =
+    &((igraphmodule_i_canonical_worker_t*)workers)[index];
+  PyGILState_STATE gstate;
+  PyThreadState *tstate;
+
+  gstate = PyGILState_Ensure();
+  tstate = PyEval_SaveThread();
+  worker->retval = igraphmodule_i_canonical_work(worker);
+  PyEval_RestoreThread(tstate);
+  if (worker->retval) {
+    PyErr_Fetch(&worker->exc_type, &worker->exc_value, &worker->exc_traceback);
+  }
+  PyGILState_Release(gstate);
+}
+
+/**
+ * \ingroup python_interface_canonical
+ * \brief Canonicalizes the pending graphs of a batch, using several
+ *        threads if the C core allows it
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception is
+ *         raised in the latter case.
+ */
+static int igraphmodule_i_canonical_run(igraphmodule_i_canonical_job_t **pending,
+    long int no_of_pending, igraph_bliss_sh_t sh, long int threads) {
+  igraphmodule_i_canonical_worker_t *workers = 0;
+  long int i;
+  int retval = 0, failed, busy = 0;
+
+  /* The graphs can only be canonicalized in parallel if the error handling
+   * of the C core is thread-local */
+  if (!IGRAPHMODULE_CORE_IS_THREAD_SAFE) {
+    threads = 1;
+  }
+  if (threads > no_of_pending) {
+    threads = no_of_pending > 0 ? no_of_pending : 1;
+  }
+
+  workers = (igraphmodule_i_canonical_worker_t*)calloc(threads,
+      sizeof(igraphmodule_i_canonical_worker_t));
+  if (!workers) {
+    retval = 1;
+    PyErr_NoMemory();
+  }
+  for (i = 0; !retval && i < threads; i++) {
+    workers[i].pending = pending;
+    workers[i].no_of_pending = no_of_pending;
+    workers[i].index = i;
+    workers[i].no_of_workers = threads;
+    workers[i].sh = sh;
+  }
+
+  if (!retval) {
+    for (i = 0; i < no_of_pending; i++) {
+      pending[i]->graph->busy++;
+    }
+    busy = 1;
+  }
+
+  if (!retval && threads == 1) {
+    IGRAPHMODULE_BEGIN_NOGIL(0);
+    retval = igraphmodule_i_canonical_work(&workers[0]);
+    IGRAPHMODULE_END_NOGIL(0);
+    if (retval) {
+      igraphmodule_handle_igraph_error();
+    }
+  } else if (!retval) {
+    /* The GIL must be released unconditionally here since the workers may
+     * need it to report errors */
+    Py_BEGIN_ALLOW_THREADS
+
+    igraphmodule_run_workers(igraphmodule_i_canonical_thread, workers,
+        threads, threads);
+    Py_END_ALLOW_THREADS
+
+    for (i = 0; i < threads; i++) {
+      failed = workers[i].retval != 0;
+      if (failed && workers[i].exc_type && !PyErr_Occurred()) {
+        PyErr_Restore(workers[i].exc_type, workers[i].exc_value,
+            workers[i].exc_traceback);
+      } else {
+        Py_XDECREF(workers[i].exc_type);
+        Py_XDECREF(workers[i].exc_value);
+        Py_XDECREF(workers[i].exc_traceback);
+      }
+      if (failed) {
+        retval = 1;
+      }
+    }
+    if (retval) {
+      igraphmodule_handle_igraph_error();
+    }
+  }
+
+  if (busy) {
+    for (i = 0; i < no_of_pending; i++) {
+      pending[i]->graph->busy--;
+    }
+  }
+  free(workers);
+
+  return retval;
+}
+
+/**
+ * \ingroup python_interface_canonical
+ * \brief Returns the canonical forms (or their hashes) of a list of graphs
+ *
+ * The forms that are not cached yet are computed with the GIL released,
+ * in parallel if the C core allows it, and are cached in the graphs.
+ */
+PyObject* igraphmodule_canonical_forms(PyObject *self, PyObject *args,
+    PyObject *kwds) {
+  static char* kwlist[] = { "graphs", "sh", "color", "hashes", "threads", NULL };
+  PyObject *graphs_o, *sh_o = Py_None, *color_o = Py_None, *hashes_o = Py_False;
+  PyObject *threads_o = Py_None, *seq, *o, *form, *result = 0;
+  igraphmodule_i_canonical_job_t *jobs = 0, **pending = 0, *job;
+  igraph_bliss_sh_t sh = IGRAPH_BLISS_FM;
+  long int i, n, no_of_pending = 0, threads = 1;
+  int hashes;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOOO", kwlist, &graphs_o,
+        &sh_o, &color_o, &hashes_o, &threads_o))
+    return NULL;
+
+  if (igraphmodule_PyObject_to_bliss_sh_t(sh_o, &sh))
+    return NULL;
+
+  if (threads_o != Py_None) {
+    threads = PyInt_AsLong(threads_o);
+    if (PyErr_Occurred())
+      return NULL;
+    if (threads <= 0) {
+      PyErr_SetString(PyExc_ValueError, "threads must be positive");
+      return NULL;
+    }
+  }
+
+  if (color_o != Py_None && !PyString_Check(color_o)) {
+    PyErr_SetString(PyExc_TypeError,
+        "color must be the name of a vertex attribute or None");
+    return NULL;
+  }
+
+  hashes = PyObject_IsTrue(hashes_o);
+  if (hashes < 0)
+    return NULL;
+
+  seq = PySequence_Fast(graphs_o, "graphs must be a sequence");
+  if (seq == 0)
+    return NULL;
+  n = PySequence_Fast_GET_SIZE(seq);
+
+  jobs = (igraphmodule_i_canonical_job_t*)calloc(n > 0 ? n : 1,
+      sizeof(igraphmodule_i_canonical_job_t));
+  pending = (igraphmodule_i_canonical_job_t**)calloc(n > 0 ? n : 1,
+      sizeof(igraphmodule_i_canonical_job_t*));
+  if (!jobs || !pending) {
+    PyErr_NoMemory();
+    goto cleanup;
+  }
+
+  /* Look up the forms in the caches and collect the graphs that need to be
+   * canonicalized */
+  for (i = 0; i < n; i++) {
+    job = &jobs[i];
+    o = PySequence_Fast_GET_ITEM(seq, i);
+    if (!PyObject_TypeCheck(o, &igraphmodule_GraphType)) {
+      PyErr_Format(PyExc_TypeError, "item %ld of the batch is not a graph", i);
+      goto cleanup;
+    }
+    job->graph = (igraphmodule_GraphObject*)o;
+
+    if (igraphmodule_attrib_to_vector_int_t(color_o, job->graph, &job->color,
+          ATTRIBUTE_TYPE_VERTEX))
+      goto cleanup;
+
+    job->key = igraphmodule_i_canonical_form_key(sh, job->color);
+    if (job->key == 0)
+      goto cleanup;
+
+    job->result = igraphmodule_get_cached_canonical_form(&job->graph->g, job->key);
+    if (job->result) {
+      Py_INCREF(job->result);
+      continue;
+    }
+
+    if (igraph_vector_char_init(&job->form, 0)) {
+      igraphmodule_handle_igraph_error();
+      goto cleanup;
+    }
+    job->has_form = 1;
+    pending[no_of_pending++] = job;
+  }
+
+  if (igraphmodule_i_canonical_run(pending, no_of_pending, sh, threads))
+    goto cleanup;
+
+  result = PyList_New(n);
+  if (result == 0)
+    goto cleanup;
+
+  for (i = 0; i < n; i++) {
+    job = &jobs[i];
+    if (job->result == 0) {
+      job->result = igraphmodule_i_canonical_form_store(job->graph, job->key,
+          &job->form);
+      if (job->result == 0) {
+        Py_CLEAR(result);
+        goto cleanup;
+      }
+    }
+
+    if (hashes) {
+      form = igraphmodule_canonical_form_hash(job->result);
+      if (form == 0) {
+        Py_CLEAR(result);
+        goto cleanup;
+      }
+    } else {
+      form = job->result;
+      Py_INCREF(form);
+    }
+    PyList_SET_ITEM(result, i, form);
+  }
+
+cleanup:
+  for (i = 0; jobs && i < n; i++) {
+    job = &jobs[i];
+    if (job->color) {
+      igraph_vector_int_destroy(job->color);
+      free(job->color);
+    }
+    if (job->has_form) {
+      igraph_vector_char_destroy(&job->form);
+    }
+    Py_XDECREF(job->key);
+    Py_XDECREF(job->result);
+  }
+  free(jobs);
+  free(pending);
+  Py_DECREF(seq);
+
+  return result;
+}
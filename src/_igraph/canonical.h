@@ -0,0 +1,56 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+
+#ifndef PYTHON_CANONICAL_H
+#define PYTHON_CANONICAL_H
+
+#include <Python.h>
+#include <igraph.h>
+#include "graphobject.h"
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_canonical Canonical forms
+ *
+ * Byte strings that are equal if and only if two graphs are isomorphic,
+ * built from the canonical labeling computed by BLISS. The form lists the
+ * number of vertices and edges, the colors of the vertices (if any) and
+ * the relabeled edges in sorted order, all as little-endian 32-bit
+ * integers, so the forms (and their hashes) can be compared across
+ * processes and platforms. The forms of a graph are cached in its
+ * attribute table until the graph is modified.
+ */
+
+int igraphmodule_canonical_form(const igraph_t *graph,
+    const igraph_vector_int_t *color, igraph_bliss_sh_t sh,
+    igraph_vector_char_t *form);
+PyObject* igraphmodule_canonical_form_hash(PyObject *form);
+
+PyObject* igraphmodule_Graph_canonical_form(igraphmodule_GraphObject *self,
+    PyObject *sh_o, PyObject *color_o);
+PyObject* igraphmodule_canonical_forms(PyObject *self, PyObject *args,
+    PyObject *kwds);
+
+#endif
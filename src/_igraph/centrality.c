@@ -0,0 +1,398 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#include "centrality.h"
+#include <math.h>
+#include <stdlib.h>
+#include "threading.h"
+
+/**
+ * \ingroup python_interface_centrality
+ * \brief Relative tolerance of comparing weighted path lengths
+ *
+ * Two path lengths that differ less than this (relative to their size) are
+ * considered equal, so that the rounding errors of summing the weights do
+ * not break ties between shortest paths.
+ */
+#define IGRAPHMODULE_CENTRALITY_EPSILON 1e-10
+
+/**
+ * \ingroup python_interface_centrality
+ * \brief Parameters and results shared by all the workers of a run
+ */
+typedef struct {
+  const igraphmodule_pathsearch_graph_t *graph;
+  // Paths longer than this are ignored; negative means no limit
+  igraph_real_t cutoff;
+  const igraph_vector_t *sources;
+  long int no_of_workers;
+  // Whether to sum the distances (closeness) instead of the dependencies
+  // of the vertices and edges (betweenness)
+  igraph_bool_t distances;
+  // Sum of the distances from each source, indexed like the sources
+  igraph_real_t *source_res;
+} igraphmodule_i_centrality_job_t;
+
+/**
+ * \ingroup python_interface_centrality
+ * \brief Workspace and accumulators of a single worker thread
+ *
+ * \c delta is kept at zero between searches.
+ */
+typedef struct {
+  const igraphmodule_i_centrality_job_t *job;
+  long int index;
+  igraphmodule_pathsearch_t search;
+  igraph_real_t *delta;
+  // Accumulated dependencies of the vertices and the edges, or the sums of
+  // the distances of the vertices from the sources
+  igraph_real_t *vertex_acc;
+  igraph_real_t *edge_acc;
+  igraph_real_t max_dist;
+} igraphmodule_i_centrality_worker_t;
+
+/**
+ * \ingroup python_interface_centrality
+ * \brief Accumulates the dependencies of the vertices and edges on the
+ *        source of the last search, in reverse order of the distances
+ */
+static void igraphmodule_i_centrality_accumulate(
+    igraphmodule_i_centrality_worker_t *w) {
+  const igraphmodule_pathsearch_graph_t *graph = w->job->graph;
+  const igraphmodule_pathsearch_t *search = &w->search;
+  const igraphmodule_adjacency_t *adj;
+  const igraph_real_t *dist = search->dist, *sigma = search->sigma;
+  long int i, j, k, end, v, u, e;
+  igraph_real_t c;
+  igraph_bool_t successor;
+
+  for (i = search->no_of_settled - 1; i >= 0; i--) {
+    v = search->order[i];
+    for (k = 0; k < 2 && graph->adj[k]; k++) {
+      adj = graph->adj[k];
+      end = adj->offsets[v + 1];
+      for (j = adj->offsets[v]; j < end; j++) {
+        u = adj->neighbors[j];
+        e = adj->edges[j];
+        if (dist[u] == IGRAPH_INFINITY || u == v)
+          continue;
+        if (graph->weights == 0)
+          successor = (dist[u] == dist[v] + 1);
+        else
+          successor = igraphmodule_pathsearch_compare(dist[v] + graph->weights[e],
+              dist[u], search->epsilon) == 0;
+        if (successor) {
+          c = sigma[v] / sigma[u] * (1 + w->delta[u]);
+          w->delta[v] += c;
+          if (w->edge_acc)
+            w->edge_acc[e] += c;
+        }
+      }
+    }
+    if (w->vertex_acc && i > 0)
+      w->vertex_acc[v] += w->delta[v];
+  }
+
+  for (i = 0; i < search->no_of_settled; i++)
+    w->delta[search->order[i]] = 0;
+}
+
+/**
+ * \ingroup python_interface_centrality
+ * \brief Adds up the distances from the source of the last search
+ *
+ * The distance of an unreachable vertex is taken to be the number of
+ * vertices, like in \c igraph_closeness().
+ */
+static void igraphmodule_i_centrality_distances(
+    igraphmodule_i_centrality_worker_t *w, long int source_index) {
+  const igraphmodule_i_centrality_job_t *job = w->job;
+  const igraphmodule_pathsearch_t *search = &w->search;
+  long int i, v, no_of_nodes = job->graph->no_of_nodes;
+  igraph_real_t sum = 0, d;
+
+  for (i = 1; i < search->no_of_settled; i++) {
+    v = search->order[i];
+    d = search->dist[v];
+    sum += d;
+    if (d > w->max_dist)
+      w->max_dist = d;
+    if (w->vertex_acc)
+      w->vertex_acc[v] += d - no_of_nodes;
+  }
+  sum += ((igraph_real_t) no_of_nodes) * (no_of_nodes - search->no_of_settled);
+
+  if (job->source_res)
+    job->source_res[source_index] = sum;
+}
+
+/**
+ * \ingroup python_interface_centrality
+ * \brief Searches from every source assigned to a worker
+ */
+static void igraphmodule_i_centrality_work(void *workers, long int index) {
+  igraphmodule_i_centrality_worker_t *w =
+    &((igraphmodule_i_centrality_worker_t*)workers)[index];
+  const igraphmodule_i_centrality_job_t *job = w->job;
+  long int i, n = igraph_vector_size(job->sources);
+
+  for (i = w->index; i < n; i += job->no_of_workers) {
+    igraphmodule_pathsearch_run(&w->search, (long int) VECTOR(*job->sources)[i],
+        job->cutoff);
+    if (job->distances)
+      igraphmodule_i_centrality_distances(w, i);
+    else
+      igraphmodule_i_centrality_accumulate(w);
+  }
+}
+
+static void igraphmodule_i_centrality_workers_destroy(
+    igraphmodule_i_centrality_worker_t *workers, long int no_of_workers) {
+  long int i;
+
+  for (i = 0; workers && i < no_of_workers; i++) {
+    igraphmodule_pathsearch_destroy(&workers[i].search);
+    free(workers[i].delta);
+    free(workers[i].vertex_acc);
+    free(workers[i].edge_acc);
+  }
+  free(workers);
+}
+
+/**
+ * \ingroup python_interface_centrality
+ * \brief Runs a job on the given number of threads
+ *
+ * The accumulators of the workers are summed into \c vertex_res and
+ * \c edge_res (either of them may be a null pointer). The largest finite
+ * distance seen by any of the workers is returned in \c max_dist if it is
+ * not a null pointer.
+ *
+ * \return \c IGRAPH_SUCCESS or \c IGRAPH_ENOMEM
+ */
+static int igraphmodule_i_centrality_run(igraphmodule_i_centrality_job_t *job,
+    long int threads, igraph_vector_t *vertex_res, igraph_vector_t *edge_res,
+    igraph_real_t *max_dist) {
+  igraphmodule_i_centrality_worker_t *workers, *w;
+  long int no_of_nodes = job->graph->no_of_nodes;
+  long int no_of_edges = job->graph->no_of_edges;
+  long int no_of_sources = igraph_vector_size(job->sources);
+  long int i, j, n = no_of_nodes > 0 ? no_of_nodes : 1;
+  int retval = 0;
+
+  if (threads > no_of_sources)
+    threads = no_of_sources > 0 ? no_of_sources : 1;
+  job->no_of_workers = threads;
+
+  workers = (igraphmodule_i_centrality_worker_t*)calloc(threads,
+      sizeof(igraphmodule_i_centrality_worker_t));
+  if (!workers)
+    return IGRAPH_ENOMEM;
+
+  for (i = 0; !retval && i < threads; i++) {
+    w = &workers[i];
+    w->job = job;
+    w->index = i;
+    if (igraphmodule_pathsearch_init(&w->search, job->graph, !job->distances,
+          IGRAPHMODULE_CENTRALITY_EPSILON)) {
+      retval = IGRAPH_ENOMEM;
+      break;
+    }
+    if (!job->distances)
+      w->delta = (igraph_real_t*)calloc(n, sizeof(igraph_real_t));
+    if (vertex_res)
+      w->vertex_acc = (igraph_real_t*)calloc(n, sizeof(igraph_real_t));
+    if (edge_res)
+      w->edge_acc = (igraph_real_t*)calloc(no_of_edges > 0 ? no_of_edges : 1,
+          sizeof(igraph_real_t));
+
+    if ((!job->distances && !w->delta) || (vertex_res && !w->vertex_acc) ||
+        (edge_res && !w->edge_acc)) {
+      retval = IGRAPH_ENOMEM;
+      break;
+    }
+  }
+
+  if (!retval && vertex_res && igraph_vector_resize(vertex_res, no_of_nodes))
+    retval = IGRAPH_ENOMEM;
+  if (!retval && edge_res && igraph_vector_resize(edge_res, no_of_edges))
+    retval = IGRAPH_ENOMEM;
+
+  if (!retval) {
+    igraphmodule_run_workers(igraphmodule_i_centrality_work, workers,
+        threads, threads);
+
+    /* Merge the accumulators in a fixed order so that the result does not
+     * depend on the scheduling of the threads */
+    if (vertex_res) {
+      igraph_vector_null(vertex_res);
+      for (i = 0; i < threads; i++)
+        for (j = 0; j < no_of_nodes; j++)
+          VECTOR(*vertex_res)[j] += workers[i].vertex_acc[j];
+    }
+    if (edge_res) {
+      igraph_vector_null(edge_res);
+      for (i = 0; i < threads; i++)
+        for (j = 0; j < no_of_edges; j++)
+          VECTOR(*edge_res)[j] += workers[i].edge_acc[j];
+    }
+    if (max_dist) {
+      *max_dist = 0;
+      for (i = 0; i < threads; i++)
+        if (workers[i].max_dist > *max_dist)
+          *max_dist = workers[i].max_dist;
+    }
+  }
+
+  igraphmodule_i_centrality_workers_destroy(workers, threads);
+
+  return retval;
+}
+
+/**
+ * \ingroup python_interface_centrality
+ * \brief Sums the betweenness dependencies of the vertices and edges on
+ *        the given source vertices
+ *
+ * This is Brandes' algorithm restricted to the given sources; with all
+ * the vertices as sources, the results are the betweenness scores of
+ * directed graphs (and twice the scores of undirected ones).
+ *
+ * \param graph the graph to search, in the direction in which the paths
+ *        are followed; its weights (if any) must all be positive
+ * \param cutoff paths longer than this are ignored; negative means no limit
+ * \param sources the source vertices
+ * \param threads the number of threads to use
+ * \param vertex_res the sums of the dependencies of the vertices are
+ *        returned here, unless it is a null pointer
+ * \param edge_res the sums of the dependencies of the edges are returned
+ *        here, unless it is a null pointer
+ * \return \c IGRAPH_SUCCESS or \c IGRAPH_ENOMEM
+ */
+int igraphmodule_betweenness_sources(const igraphmodule_pathsearch_graph_t *graph,
+    igraph_real_t cutoff, const igraph_vector_t *sources, long int threads,
+    igraph_vector_t *vertex_res, igraph_vector_t *edge_res) {
+  igraphmodule_i_centrality_job_t job;
+
+  job.graph = graph;
+  job.cutoff = cutoff;
+  job.sources = sources;
+  job.distances = 0;
+  job.source_res = 0;
+
+  return igraphmodule_i_centrality_run(&job, threads, vertex_res, edge_res, 0);
+}
+
+/**
+ * \ingroup python_interface_centrality
+ * \brief Sums the distances from the given source vertices
+ *
+ * The distance of an unreachable vertex (or one beyond the cutoff) is taken
+ * to be the number of vertices, like in \c igraph_closeness().
+ *
+ * \param graph the graph to search, in the direction in which the paths
+ *        are followed; its weights (if any) must all be positive
+ * \param cutoff paths longer than this are ignored; negative means no limit
+ * \param sources the source vertices
+ * \param threads the number of threads to use
+ * \param source_res the sum of the distances from each source to all other
+ *        vertices is returned here, in the order of the sources, unless it
+ *        is a null pointer
+ * \param target_res the sum of the distances from all the sources (other
+ *        than the vertex itself) to each vertex is returned here, unless it
+ *        is a null pointer
+ * \param max_dist the largest finite distance found is returned here
+ * \return \c IGRAPH_SUCCESS or \c IGRAPH_ENOMEM
+ */
+int igraphmodule_farness_sources(const igraphmodule_pathsearch_graph_t *graph,
+    igraph_real_t cutoff, const igraph_vector_t *sources, long int threads,
+    igraph_vector_t *source_res, igraph_vector_t *target_res,
+    igraph_real_t *max_dist) {
+  igraphmodule_i_centrality_job_t job;
+  long int i, no_of_nodes = graph->no_of_nodes;
+  long int no_of_sources = igraph_vector_size(sources);
+  int retval;
+
+  if (source_res && igraph_vector_resize(source_res, no_of_sources))
+    return IGRAPH_ENOMEM;
+
+  job.graph = graph;
+  job.cutoff = cutoff;
+  job.sources = sources;
+  job.distances = 1;
+  job.source_res = source_res ? VECTOR(*source_res) : 0;
+
+  retval = igraphmodule_i_centrality_run(&job, threads, target_res, 0, max_dist);
+  if (retval)
+    return retval;
+
+  /* The workers only added the differences from the distance assumed for
+   * the unreachable vertices */
+  if (target_res) {
+    for (i = 0; i < no_of_nodes; i++)
+      VECTOR(*target_res)[i] += ((igraph_real_t) no_of_nodes) * no_of_sources;
+    for (i = 0; i < no_of_sources; i++)
+      VECTOR(*target_res)[(long int) VECTOR(*sources)[i]] -= no_of_nodes;
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup python_interface_centrality
+ * \brief Draws a uniform random sample of distinct vertices
+ *
+ * \param samples the size of the sample; all the vertices are returned (in
+ *        increasing order) if it is not smaller than the number of vertices
+ * \param seed the seed of the random stream
+ * \return \c IGRAPH_SUCCESS or an error code of the C core
+ */
+int igraphmodule_sample_sources(long int no_of_nodes, long int samples,
+    unsigned long int seed, igraph_vector_t *sources) {
+  igraph_rng_t rng;
+  long int i, j;
+  igraph_real_t tmp;
+
+  IGRAPH_CHECK(igraph_vector_resize(sources, no_of_nodes));
+  for (i = 0; i < no_of_nodes; i++)
+    VECTOR(*sources)[i] = i;
+  if (samples >= no_of_nodes)
+    return IGRAPH_SUCCESS;
+
+  /* Partial Fisher-Yates shuffle */
+  IGRAPH_CHECK(igraph_rng_init(&rng, &igraph_rngtype_mt19937));
+  igraph_rng_seed(&rng, seed);
+  for (i = 0; i < samples; i++) {
+    j = (long int) igraph_rng_get_integer(&rng, i, no_of_nodes - 1);
+    tmp = VECTOR(*sources)[i];
+    VECTOR(*sources)[i] = VECTOR(*sources)[j];
+    VECTOR(*sources)[j] = tmp;
+  }
+  igraph_rng_destroy(&rng);
+
+  igraph_vector_resize(sources, samples);   /* shrinking, cannot fail */
+  igraph_vector_sort(sources);
+
+  return IGRAPH_SUCCESS;
+}
@@ -0,0 +1,56 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+
+#ifndef PYTHON_CENTRALITY_H
+#define PYTHON_CENTRALITY_H
+
+#include <Python.h>
+#include <igraph.h>
+#include "pathsearch.h"
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_centrality Parallel path-based centralities
+ *
+ * Brandes' algorithm for betweenness and the single-source searches of
+ * closeness, run on the cached adjacency lists of a graph by several
+ * threads at once. Each thread searches from its own share of the source
+ * vertices with a workspace and accumulators of its own; the accumulators
+ * are summed when all threads have finished. The functions below do not
+ * touch Python objects and do not use the error handling of the C core,
+ * so they can be called without holding the GIL.
+ */
+
+int igraphmodule_betweenness_sources(const igraphmodule_pathsearch_graph_t *graph,
+    igraph_real_t cutoff, const igraph_vector_t *sources, long int threads,
+    igraph_vector_t *vertex_res, igraph_vector_t *edge_res);
+int igraphmodule_farness_sources(const igraphmodule_pathsearch_graph_t *graph,
+    igraph_real_t cutoff, const igraph_vector_t *sources, long int threads,
+    igraph_vector_t *source_res, igraph_vector_t *target_res,
+    igraph_real_t *max_dist);
+int igraphmodule_sample_sources(long int no_of_nodes, long int samples,
+    unsigned long int seed, igraph_vector_t *sources);
+
+#endif
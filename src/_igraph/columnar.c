@@ -0,0 +1,685 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#include "columnar.h"
+#include "convert.h"
+#include "error.h"
+#include "threading.h"
+#include <limits.h>
+#include <string.h>
+
+/**
+ * \ingroup python_interface_columnar
+ * \brief Kinds of key columns
+ */
+typedef enum {
+  IGRAPHMODULE_I_KEYS_INT = 0,
+  IGRAPHMODULE_I_KEYS_STRING,
+  IGRAPHMODULE_I_KEYS_OBJECT
+} igraphmodule_i_keys_kind_t;
+
+/**
+ * \ingroup python_interface_columnar
+ * \brief A column of vertex keys
+ */
+typedef struct {
+  igraphmodule_i_keys_kind_t kind;
+  Py_ssize_t size;
+  // Integer keys, or the offsets of the string keys
+  Py_buffer values;
+  igraphmodule_buffer_item_kind_t item_kind;
+  int has_values;
+  // The UTF-8 encoded string keys
+  Py_buffer data;
+  int has_data;
+  // The keys as a list or tuple for the other kinds
+  PyObject *seq;
+} igraphmodule_i_key_column_t;
+
+/**
+ * \ingroup python_interface_columnar
+ * \brief Open addressing hash table mapping integer or string keys to
+ *        consecutive IDs
+ *
+ * The string keys are not copied, they point into the buffers of the key
+ * columns (or into the encoded vertex names).
+ */
+typedef struct {
+  // IDs of the keys in the slots, -1 for empty slots; the number of slots
+  // is a power of two and at most half of them are in use
+  long int *slots;
+  long int mask;
+  // The keys in the order of their IDs and their hashes
+  long int size;
+  long int capacity;
+  PY_LONG_LONG *ints;
+  const char **ptrs;
+  Py_ssize_t *lengths;
+  unsigned PY_LONG_LONG *hashes;
+} igraphmodule_i_factorizer_t;
+
+#define IGRAPHMODULE_I_NOT_FOUND -1
+#define IGRAPHMODULE_I_NO_MEMORY -2
+
+static unsigned PY_LONG_LONG igraphmodule_i_hash_int(PY_LONG_LONG key) {
+  /* Finalizer of splitmix64 */
+  unsigned PY_LONG_LONG x = (unsigned PY_LONG_LONG) key;
+  x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+static unsigned PY_LONG_LONG igraphmodule_i_hash_string(const char *ptr, Py_ssize_t length) {
+  /* 64-bit FNV-1a */
+  unsigned PY_LONG_LONG x = 0xcbf29ce484222325ULL;
+  Py_ssize_t i;
+  for (i = 0; i < length; i++) {
+    x ^= (unsigned char) ptr[i];
+    x *= 0x100000001b3ULL;
+  }
+  return x ^ (x >> 32);
+}
+
+static void igraphmodule_i_factorizer_destroy(igraphmodule_i_factorizer_t *f) {
+  free(f->slots);
+  free(f->ints);
+  free(f->ptrs);
+  free(f->lengths);
+  free(f->hashes);
+  memset(f, 0, sizeof(*f));
+}
+
+/**
+ * \ingroup python_interface_columnar
+ * \brief Doubles the number of slots of the table and the space for the keys
+ */
+static int igraphmodule_i_factorizer_grow(igraphmodule_i_factorizer_t *f,
+    igraphmodule_i_keys_kind_t kind) {
+  long int capacity = f->capacity > 0 ? 2 * f->capacity : 1024, i, j;
+  long int *slots = (long int*)malloc(2 * capacity * sizeof(long int));
+  void *p;
+
+  if (slots == 0)
+    return 1;
+  for (i = 0; i < 2 * capacity; i++)
+    slots[i] = -1;
+
+  p = realloc(f->hashes, capacity * sizeof(unsigned PY_LONG_LONG));
+  if (p == 0) {
+    free(slots);
+    return 1;
+  }
+  f->hashes = (unsigned PY_LONG_LONG*)p;
+  if (kind == IGRAPHMODULE_I_KEYS_INT) {
+    p = realloc(f->ints, capacity * sizeof(PY_LONG_LONG));
+    if (p == 0) {
+      free(slots);
+      return 1;
+    }
+    f->ints = (PY_LONG_LONG*)p;
+  } else {
+    p = realloc(f->ptrs, capacity * sizeof(const char*));
+    if (p == 0) {
+      free(slots);
+      return 1;
+    }
+    f->ptrs = (const char**)p;
+    p = realloc(f->lengths, capacity * sizeof(Py_ssize_t));
+    if (p == 0) {
+      free(slots);
+      return 1;
+    }
+    f->lengths = (Py_ssize_t*)p;
+  }
+
+  f->mask = 2 * capacity - 1;
+  for (i = 0; i < f->size; i++) {
+    for (j = (long int)(f->hashes[i] & f->mask); slots[j] >= 0; j = (j + 1) & f->mask);
+    slots[j] = i;
+  }
+  free(f->slots);
+  f->slots = slots;
+  f->capacity = capacity;
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_columnar
+ * \brief Looks up a key in the table, adding it if requested
+ *
+ * \param ptr the string key, or a null pointer for integer keys
+ * \return the ID of the key, \c IGRAPHMODULE_I_NOT_FOUND if the key is not
+ *         in the table and it should not be added, or
+ *         \c IGRAPHMODULE_I_NO_MEMORY
+ */
+static long int igraphmodule_i_factorizer_find(igraphmodule_i_factorizer_t *f,
+    PY_LONG_LONG key, const char *ptr, Py_ssize_t length, int insert) {
+  unsigned PY_LONG_LONG hash = ptr ? igraphmodule_i_hash_string(ptr, length) :
+    igraphmodule_i_hash_int(key);
+  igraphmodule_i_keys_kind_t kind = ptr ? IGRAPHMODULE_I_KEYS_STRING : IGRAPHMODULE_I_KEYS_INT;
+  long int j, id;
+
+  if (f->slots != 0) {
+    for (j = (long int)(hash & f->mask); (id = f->slots[j]) >= 0; j = (j + 1) & f->mask) {
+      if (f->hashes[id] != hash)
+        continue;
+      if (ptr ? (f->lengths[id] == length && memcmp(f->ptrs[id], ptr, length) == 0) :
+          f->ints[id] == key)
+        return id;
+    }
+  }
+
+  if (!insert)
+    return IGRAPHMODULE_I_NOT_FOUND;
+
+  if (f->size == f->capacity) {
+    if (igraphmodule_i_factorizer_grow(f, kind))
+      return IGRAPHMODULE_I_NO_MEMORY;
+    for (j = (long int)(hash & f->mask); f->slots[j] >= 0; j = (j + 1) & f->mask);
+  }
+
+  id = f->size++;
+  f->slots[j] = id;
+  f->hashes[id] = hash;
+  if (ptr) {
+    f->ptrs[id] = ptr;
+    f->lengths[id] = length;
+  } else {
+    f->ints[id] = key;
+  }
+
+  return id;
+}
+
+/**
+ * \ingroup python_interface_columnar
+ * \brief Reads an integer from a buffer item
+ */
+static PY_LONG_LONG igraphmodule_i_buffer_item_as_int(const char *ptr,
+    igraphmodule_buffer_item_kind_t kind, Py_ssize_t itemsize) {
+  if (kind == IGRAPHMODULE_BUFFER_ITEM_SIGNED) {
+    switch (itemsize) {
+      case 1: { signed char x; memcpy(&x, ptr, 1); return x; }
+      case 2: { short x; memcpy(&x, ptr, 2); return x; }
+      case 4: { int x; memcpy(&x, ptr, 4); return x; }
+      default: { PY_LONG_LONG x; memcpy(&x, ptr, 8); return x; }
+    }
+  }
+  switch (itemsize) {
+    case 1: { unsigned char x; memcpy(&x, ptr, 1); return x; }
+    case 2: { unsigned short x; memcpy(&x, ptr, 2); return x; }
+    case 4: { unsigned int x; memcpy(&x, ptr, 4); return x; }
+    default: { PY_LONG_LONG x; memcpy(&x, ptr, 8); return x; }
+  }
+}
+
+static void igraphmodule_i_key_column_destroy(igraphmodule_i_key_column_t *c) {
+  if (c->has_values)
+    PyBuffer_Release(&c->values);
+  if (c->has_data)
+    PyBuffer_Release(&c->data);
+  Py_XDECREF(c->seq);
+  c->has_values = c->has_data = 0;
+  c->seq = 0;
+}
+
+/**
+ * \ingroup python_interface_columnar
+ * \brief Acquires a one-dimensional integer buffer from an object
+ * \return 0 if the buffer was acquired, -1 if the object does not export a
+ *         suitable buffer; no exception is set in this case
+ */
+static int igraphmodule_i_get_int_buffer(PyObject *o, Py_buffer *buffer,
+    igraphmodule_buffer_item_kind_t *kind) {
+  if (PyBaseString_Check(o) || !PyObject_CheckBuffer(o))
+    return -1;
+  if (PyObject_GetBuffer(o, buffer, PyBUF_STRIDES | PyBUF_FORMAT)) {
+    PyErr_Clear();
+    return -1;
+  }
+  *kind = igraphmodule_buffer_item_kind(buffer);
+  if (buffer->ndim != 1 || (*kind != IGRAPHMODULE_BUFFER_ITEM_SIGNED &&
+        *kind != IGRAPHMODULE_BUFFER_ITEM_UNSIGNED) ||
+      (*kind == IGRAPHMODULE_BUFFER_ITEM_UNSIGNED && buffer->itemsize == 8)) {
+    PyBuffer_Release(buffer);
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_columnar
+ * \brief Sets up a key column from a Python object
+ */
+static int igraphmodule_i_key_column_init(igraphmodule_i_key_column_t *c,
+    PyObject *o, const char *name) {
+  Py_ssize_t data_size, i;
+  PY_LONG_LONG from, to, prev;
+  const char *ptr;
+
+  memset(c, 0, sizeof(*c));
+
+  if (PyTuple_Check(o) && PyTuple_GET_SIZE(o) == 2 &&
+      PyObject_CheckBuffer(PyTuple_GET_ITEM(o, 0))) {
+    /* Arrow-style string keys: offsets and data */
+    c->kind = IGRAPHMODULE_I_KEYS_STRING;
+    if (igraphmodule_i_get_int_buffer(PyTuple_GET_ITEM(o, 0), &c->values,
+          &c->item_kind) || c->values.shape[0] < 1) {
+      if (!PyErr_Occurred())
+        PyErr_Format(PyExc_TypeError, "the offsets of the %s column must be "
+            "a non-empty integer buffer", name);
+      return 1;
+    }
+    c->has_values = 1;
+    if (PyObject_GetBuffer(PyTuple_GET_ITEM(o, 1), &c->data, PyBUF_SIMPLE)) {
+      igraphmodule_i_key_column_destroy(c);
+      return 1;
+    }
+    c->has_data = 1;
+    c->size = c->values.shape[0] - 1;
+
+    /* The keys must lie within the data buffer one after the other */
+    data_size = c->data.len;
+    ptr = (const char*) c->values.buf;
+    prev = igraphmodule_i_buffer_item_as_int(ptr, c->item_kind, c->values.itemsize);
+    for (i = 0; i < c->size && prev >= 0; i++) {
+      from = prev;
+      ptr += c->values.strides[0];
+      to = igraphmodule_i_buffer_item_as_int(ptr, c->item_kind, c->values.itemsize);
+      if (to < from || to > data_size)
+        break;
+      prev = to;
+    }
+    if (prev < 0 || prev > data_size || i < c->size) {
+      PyErr_Format(PyExc_ValueError, "invalid offsets in the %s column", name);
+      igraphmodule_i_key_column_destroy(c);
+      return 1;
+    }
+    return 0;
+  }
+
+  if (igraphmodule_i_get_int_buffer(o, &c->values, &c->item_kind) == 0) {
+    c->kind = IGRAPHMODULE_I_KEYS_INT;
+    c->has_values = 1;
+    c->size = c->values.shape[0];
+    return 0;
+  }
+
+  c->kind = IGRAPHMODULE_I_KEYS_OBJECT;
+  c->seq = PySequence_Fast(o, "vertex key columns must be sequences or buffers");
+  if (c->seq == 0)
+    return 1;
+  c->size = PySequence_Fast_GET_SIZE(c->seq);
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_columnar
+ * \brief Returns the key in the given row of an integer or string column
+ */
+static void igraphmodule_i_key_column_get(const igraphmodule_i_key_column_t *c,
+    Py_ssize_t row, PY_LONG_LONG *key, const char **ptr, Py_ssize_t *length) {
+  const char *p = (const char*) c->values.buf + row * c->values.strides[0];
+  PY_LONG_LONG from;
+
+  if (c->kind == IGRAPHMODULE_I_KEYS_INT) {
+    *key = igraphmodule_i_buffer_item_as_int(p, c->item_kind, c->values.itemsize);
+    *ptr = 0;
+    *length = 0;
+  } else {
+    from = igraphmodule_i_buffer_item_as_int(p, c->item_kind, c->values.itemsize);
+    *key = 0;
+    *ptr = c->data.buf ? (const char*) c->data.buf + from : "";
+    *length = (Py_ssize_t) (igraphmodule_i_buffer_item_as_int(p + c->values.strides[0],
+          c->item_kind, c->values.itemsize) - from);
+  }
+}
+
+/**
+ * \ingroup python_interface_columnar
+ * \brief Converts the keys of the edges with native integer or string
+ *        columns; runs without the GIL
+ *
+ * \param f the table of the known keys, or a null pointer if the integer
+ *        keys are vertex IDs
+ * \param insert whether unknown keys are added to the table
+ * \param bad_row the first row with an invalid key is returned here
+ * \return 0, \c IGRAPHMODULE_I_NOT_FOUND or \c IGRAPHMODULE_I_NO_MEMORY
+ */
+static long int igraphmodule_i_columns_to_edgelist_native(
+    const igraphmodule_i_key_column_t *source,
+    const igraphmodule_i_key_column_t *target, igraphmodule_i_factorizer_t *f,
+    int insert, igraph_vector_t *edges, long int *no_of_nodes,
+    Py_ssize_t *bad_row) {
+  const igraphmodule_i_key_column_t *columns[2];
+  Py_ssize_t row, m = source->size, length;
+  PY_LONG_LONG key, max_id = -1;
+  const char *ptr;
+  long int id;
+  int k;
+
+  columns[0] = source;
+  columns[1] = target;
+
+  for (row = 0; row < m; row++) {
+    for (k = 0; k < 2; k++) {
+      igraphmodule_i_key_column_get(columns[k], row, &key, &ptr, &length);
+      if (f == 0) {
+        if (key < 0 || key > INT_MAX) {
+          *bad_row = row;
+          return IGRAPHMODULE_I_NOT_FOUND;
+        }
+        if (key > max_id)
+          max_id = key;
+        id = (long int) key;
+      } else {
+        id = igraphmodule_i_factorizer_find(f, key, ptr, length, insert);
+        if (id < 0) {
+          *bad_row = row;
+          return id;
+        }
+      }
+      VECTOR(*edges)[2 * row + k] = id;
+    }
+  }
+
+  *no_of_nodes = f ? f->size : (long int) (max_id + 1);
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_columnar
+ * \brief Adds the vertex names given by the user to the table of keys
+ *
+ * String names are encoded to UTF-8; the encoded names are stored in
+ * \c encoded, which must stay alive while the table is in use.
+ */
+static int igraphmodule_i_factorizer_add_names(igraphmodule_i_factorizer_t *f,
+    igraphmodule_i_keys_kind_t kind, PyObject *names, PyObject *encoded) {
+  Py_ssize_t i, n = PySequence_Fast_GET_SIZE(names);
+  PyObject *item, *bytes;
+  PY_LONG_LONG key = 0;
+  long int id;
+
+  for (i = 0; i < n; i++) {
+    item = PySequence_Fast_GET_ITEM(names, i);
+    if (kind == IGRAPHMODULE_I_KEYS_INT) {
+      key = PyLong_AsLongLong(item);
+      if (key == -1 && PyErr_Occurred())
+        return 1;
+      id = igraphmodule_i_factorizer_find(f, key, 0, 0, 1);
+    } else {
+      if (PyUnicode_Check(item)) {
+        bytes = PyUnicode_AsUTF8String(item);
+      } else if (PyBytes_Check(item)) {
+        Py_INCREF(item);
+        bytes = item;
+      } else {
+        PyErr_SetString(PyExc_TypeError, "vertex names must be strings when "
+            "the vertex keys are strings");
+        return 1;
+      }
+      if (bytes == 0)
+        return 1;
+      if (PyList_Append(encoded, bytes)) {
+        Py_DECREF(bytes);
+        return 1;
+      }
+      Py_DECREF(bytes);
+      id = igraphmodule_i_factorizer_find(f, 0, PyBytes_AS_STRING(bytes),
+          PyBytes_GET_SIZE(bytes), 1);
+    }
+    if (id == IGRAPHMODULE_I_NO_MEMORY) {
+      PyErr_NoMemory();
+      return 1;
+    }
+    if (id != i) {
+      PyErr_SetString(PyExc_ValueError, "vertex names must be unique");
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_columnar
+ * \brief Converts the keys of the edges with a Python dictionary
+ */
+static int igraphmodule_i_columns_to_edgelist_objects(
+    const igraphmodule_i_key_column_t *source,
+    const igraphmodule_i_key_column_t *target, PyObject *index, int insert,
+    igraph_vector_t *edges, PyObject *new_names) {
+  const igraphmodule_i_key_column_t *columns[2];
+  Py_ssize_t row, m = source->size;
+  PyObject *key, *id_o;
+  long int id;
+  int k;
+
+  columns[0] = source;
+  columns[1] = target;
+
+  for (row = 0; row < m; row++) {
+    for (k = 0; k < 2; k++) {
+      key = PySequence_Fast_GET_ITEM(columns[k]->seq, row);
+      id_o = PyDict_GetItem(index, key);
+      if (id_o != 0) {
+        id = PyInt_AsLong(id_o);
+      } else if (PyErr_Occurred()) {
+        return 1;
+      } else if (!insert) {
+        PyErr_Format(PyExc_KeyError, "the %s of edge %ld is not among the "
+            "vertex names", k == 0 ? "source" : "target", (long int) row);
+        return 1;
+      } else {
+        id = (long int) PyDict_Size(index);
+        id_o = PyInt_FromLong(id);
+        if (id_o == 0)
+          return 1;
+        if (PyDict_SetItem(index, key, id_o) || PyList_Append(new_names, key)) {
+          Py_DECREF(id_o);
+          return 1;
+        }
+        Py_DECREF(id_o);
+      }
+      VECTOR(*edges)[2 * row + k] = id;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_columnar
+ * \brief Creates the names of the vertices from the keys in the table
+ */
+static PyObject* igraphmodule_i_factorizer_to_PyList(const igraphmodule_i_factorizer_t *f,
+    igraphmodule_i_keys_kind_t kind) {
+  PyObject *result = PyList_New(f->size), *item;
+  long int i;
+
+  for (i = 0; result && i < f->size; i++) {
+    if (kind == IGRAPHMODULE_I_KEYS_INT)
+      item = PyLong_FromLongLong(f->ints[i]);
+    else
+      item = PyUnicode_DecodeUTF8(f->ptrs[i], f->lengths[i], "strict");
+    if (item == 0) {
+      Py_DECREF(result);
+      return NULL;
+    }
+    PyList_SET_ITEM(result, i, item);
+  }
+
+  return result;
+}
+
+/**
+ * \ingroup python_interface_columnar
+ * \brief Converts two columns of vertex keys to an edge list
+ *
+ * \param source the keys of the source vertices of the edges: a
+ *        one-dimensional integer buffer, a pair of buffers holding string
+ *        keys in the layout of Arrow string arrays (offsets and UTF-8 data)
+ *        or any other sequence
+ * \param target the keys of the target vertices, of the same kind
+ * \param vertex_names \c None to use integer keys as vertex IDs and to
+ *        factorize other keys, \c True to factorize all keys, or the
+ *        sequence of the keys of the vertices in the order of their IDs
+ * \param edges an uninitialized vector, the edge list is returned here
+ * \param no_of_nodes the number of vertices is returned here
+ * \param names the keys of the vertices are returned here as a new list
+ *        if they were factorized and \c vertex_names was not a sequence,
+ *        otherwise \c None
+ * \return 0 if everything went well, 1 otherwise (with an exception set)
+ */
+int igraphmodule_columns_to_edgelist(PyObject *source, PyObject *target,
+    PyObject *vertex_names, igraph_vector_t *edges, long int *no_of_nodes,
+    PyObject **names) {
+  igraphmodule_i_key_column_t columns[2];
+  igraphmodule_i_factorizer_t f;
+  PyObject *vocabulary = 0, *encoded = 0, *index = 0;
+  int factorize, insert, retval = 1;
+  Py_ssize_t bad_row = 0;
+  long int status;
+
+  *names = 0;
+  memset(&f, 0, sizeof(f));
+
+  if (igraphmodule_i_key_column_init(&columns[0], source, "source"))
+    return 1;
+  if (igraphmodule_i_key_column_init(&columns[1], target, "target")) {
+    igraphmodule_i_key_column_destroy(&columns[0]);
+    return 1;
+  }
+
+  if (columns[0].kind != columns[1].kind) {
+    PyErr_SetString(PyExc_TypeError, "the source and target columns must be "
+        "of the same kind");
+    goto cleanup;
+  }
+  if (columns[0].size != columns[1].size) {
+    PyErr_SetString(PyExc_ValueError, "the source and target columns must "
+        "have the same length");
+    goto cleanup;
+  }
+
+  insert = 1;
+  factorize = columns[0].kind != IGRAPHMODULE_I_KEYS_INT;
+  if (vertex_names == Py_True) {
+    factorize = 1;
+  } else if (vertex_names != Py_None) {
+    factorize = 1;
+    insert = 0;
+    vocabulary = PySequence_Fast(vertex_names, "vertex_names must be None, "
+        "True or a sequence");
+    if (vocabulary == 0)
+      goto cleanup;
+  }
+
+  if (igraph_vector_init(edges, 2 * columns[0].size)) {
+    igraphmodule_handle_igraph_error();
+    goto cleanup;
+  }
+
+  if (columns[0].kind == IGRAPHMODULE_I_KEYS_OBJECT) {
+    index = PyDict_New();
+    *names = insert ? PyList_New(0) : 0;
+    if (index == 0 || (insert && *names == 0))
+      goto error;
+    if (vocabulary) {
+      Py_ssize_t i, n = PySequence_Fast_GET_SIZE(vocabulary);
+      for (i = 0; i < n; i++) {
+        PyObject *id_o = PyInt_FromLong((long int) i);
+        if (id_o == 0 || PyDict_SetItem(index, PySequence_Fast_GET_ITEM(vocabulary, i), id_o)) {
+          Py_XDECREF(id_o);
+          goto error;
+        }
+        Py_DECREF(id_o);
+      }
+      if (PyDict_Size(index) != n) {
+        PyErr_SetString(PyExc_ValueError, "vertex names must be unique");
+        goto error;
+      }
+    }
+    if (igraphmodule_i_columns_to_edgelist_objects(&columns[0], &columns[1],
+          index, insert, edges, *names))
+      goto error;
+    *no_of_nodes = (long int) PyDict_Size(index);
+  } else {
+    if (vocabulary) {
+      encoded = PyList_New(0);
+      if (encoded == 0 || igraphmodule_i_factorizer_add_names(&f, columns[0].kind,
+            vocabulary, encoded))
+        goto error;
+    }
+
+    IGRAPHMODULE_BEGIN_NOGIL(0);
+    status = igraphmodule_i_columns_to_edgelist_native(&columns[0], &columns[1],
+        factorize ? &f : 0, insert, edges, no_of_nodes, &bad_row);
+    IGRAPHMODULE_END_NOGIL(0);
+
+    if (status == IGRAPHMODULE_I_NO_MEMORY) {
+      PyErr_NoMemory();
+      goto error;
+    } else if (status == IGRAPHMODULE_I_NOT_FOUND && factorize) {
+      PyErr_Format(PyExc_KeyError, "the source or target of edge %ld is not "
+          "among the vertex names", (long int) bad_row);
+      goto error;
+    } else if (status == IGRAPHMODULE_I_NOT_FOUND) {
+      PyErr_Format(PyExc_ValueError, "invalid vertex ID in edge %ld",
+          (long int) bad_row);
+      goto error;
+    }
+
+    if (factorize && insert) {
+      *names = igraphmodule_i_factorizer_to_PyList(&f, columns[0].kind);
+      if (*names == 0)
+        goto error;
+    }
+  }
+
+  if (*names == 0) {
+    Py_INCREF(Py_None);
+    *names = Py_None;
+  }
+  retval = 0;
+  goto cleanup;
+
+error:
+  igraph_vector_destroy(edges);
+  Py_XDECREF(*names);
+  *names = 0;
+
+cleanup:
+  igraphmodule_i_factorizer_destroy(&f);
+  igraphmodule_i_key_column_destroy(&columns[0]);
+  igraphmodule_i_key_column_destroy(&columns[1]);
+  Py_XDECREF(vocabulary);
+  Py_XDECREF(encoded);
+  Py_XDECREF(index);
+
+  return retval;
+}
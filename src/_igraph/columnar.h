@@ -0,0 +1,50 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+
+#ifndef PYTHON_COLUMNAR_H
+#define PYTHON_COLUMNAR_H
+
+#include <Python.h>
+#include <igraph.h>
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_columnar Graph construction from columns
+ *
+ * Turns two columns of vertex keys (the sources and the targets of the
+ * edges) into an edge list. Integer buffers are read without creating
+ * Python objects and may be used as vertex IDs directly; integer and
+ * string keys are factorized into vertex IDs with a hash table, in the
+ * order of their first appearance. String keys are given in the layout of
+ * Apache Arrow string arrays: a pair of an offset buffer and a buffer
+ * holding the UTF-8 encoded keys one after the other. Other sequences are
+ * factorized with a Python dictionary.
+ */
+
+int igraphmodule_columns_to_edgelist(PyObject *source, PyObject *target,
+    PyObject *vertex_names, igraph_vector_t *edges, long int *no_of_nodes,
+    PyObject **names);
+
+#endif
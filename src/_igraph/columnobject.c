@@ -0,0 +1,1002 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include "columnobject.h"
+#include "convert.h"
+#include "error.h"
+#include "memusage.h"
+#include "py2compat.h"
+
+/**
+ * \ingroup python_interface_column
+ * \brief Names of the column types, indexed by \c igraphmodule_column_type_t
+ */
+static const char* igraphmodule_Column_type_names[] = { "float", "int", "bool" };
+
+/**
+ * \ingroup python_interface_column
+ * \brief Returns the size of a single item in a column of the given type
+ */
+static size_t igraphmodule_Column_itemsize(igraphmodule_column_type_t type) {
+  switch (type) {
+    case IGRAPHMODULE_COLUMN_FLOAT: return sizeof(double);
+    case IGRAPHMODULE_COLUMN_INT:   return sizeof(PY_LONG_LONG);
+    default:                        return sizeof(char);
+  }
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Returns the number of bytes allocated for the items and the
+ *        validity mask of the column
+ */
+static Py_ssize_t igraphmodule_Column_storage_bytes(igraphmodule_ColumnObject* self) {
+  return self->capacity * igraphmodule_Column_itemsize(self->type) +
+    (self->valid ? self->capacity : 0);
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Returns the number of bytes used by the column, including the
+ *        storage of its items
+ */
+Py_ssize_t igraphmodule_Column_allocated_bytes(igraphmodule_ColumnObject* self) {
+  return Py_TYPE(self)->tp_basicsize + igraphmodule_Column_storage_bytes(self);
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Makes sure that the column has room for at least the given number
+ *        of items
+ *
+ * \return 0 if everything was OK, 1 otherwise (with a \c MemoryError)
+ */
+static int igraphmodule_Column_reserve(igraphmodule_ColumnObject* self,
+    Py_ssize_t capacity) {
+  size_t itemsize = igraphmodule_Column_itemsize(self->type);
+  Py_ssize_t allocated = igraphmodule_Column_storage_bytes(self);
+  char *data, *valid;
+
+  if (capacity <= self->capacity)
+    return 0;
+
+  data = (char*)PyMem_Realloc(self->data, capacity * itemsize);
+  if (data == 0) {
+    PyErr_NoMemory();
+    return 1;
+  }
+  self->data = data;
+
+  if (self->valid) {
+    valid = (char*)PyMem_Realloc(self->valid, capacity);
+    if (valid == 0) {
+      PyErr_NoMemory();
+      return 1;
+    }
+    self->valid = valid;
+  }
+
+  self->capacity = capacity;
+  igraphmodule_memory_track(IGRAPHMODULE_MEMORY_COLUMNS,
+      igraphmodule_Column_storage_bytes(self) - allocated, 0);
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Allocates the validity mask of the column, marking all items valid
+ *
+ * \return 0 if everything was OK, 1 otherwise (with a \c MemoryError)
+ */
+static int igraphmodule_Column_create_mask(igraphmodule_ColumnObject* self) {
+  if (self->valid)
+    return 0;
+
+  self->valid = (char*)PyMem_Malloc(self->capacity > 0 ? self->capacity : 1);
+  if (self->valid == 0) {
+    PyErr_NoMemory();
+    return 1;
+  }
+
+  memset(self->valid, 1, self->capacity);
+  igraphmodule_memory_track(IGRAPHMODULE_MEMORY_COLUMNS, self->capacity, 0);
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Marks the given item of the column as missing
+ *
+ * \return 0 if everything was OK, 1 otherwise (with a \c MemoryError)
+ */
+static int igraphmodule_Column_set_missing(igraphmodule_ColumnObject* self,
+    Py_ssize_t i) {
+  if (igraphmodule_Column_create_mask(self))
+    return 1;
+
+  self->valid[i] = 0;
+  switch (self->type) {
+    case IGRAPHMODULE_COLUMN_FLOAT:
+      ((double*)self->data)[i] = IGRAPH_NAN;
+      break;
+    case IGRAPHMODULE_COLUMN_INT:
+      ((PY_LONG_LONG*)self->data)[i] = 0;
+      break;
+    default:
+      self->data[i] = 0;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Creates a new column of the given type and size
+ *
+ * All the items of the column are valid and set to zero.
+ */
+PyObject* igraphmodule_Column_New(igraphmodule_column_type_t type, Py_ssize_t size) {
+  igraphmodule_ColumnObject* self;
+
+  self = PyObject_New(igraphmodule_ColumnObject, &igraphmodule_ColumnType);
+  if (self == 0)
+    return 0;
+
+  self->type = type;
+  self->size = 0;
+  self->capacity = 0;
+  self->data = 0;
+  self->valid = 0;
+  self->exports = 0;
+  self->ndim = 1;
+  self->shape[0] = self->shape[1] = 0;
+  self->strides[0] = self->strides[1] = igraphmodule_Column_itemsize(type);
+  igraphmodule_memory_track(IGRAPHMODULE_MEMORY_COLUMNS, 0, 1);
+
+  if (igraphmodule_Column_reserve(self, size > 0 ? size : 1)) {
+    Py_DECREF(self);
+    return 0;
+  }
+
+  memset(self->data, 0, size * igraphmodule_Column_itemsize(type));
+  self->size = size;
+
+  return (PyObject*)self;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Creates a new column from a Python object exporting a
+ *        one-dimensional numeric buffer (e.g., a NumPy array)
+ *
+ * Floating-point buffers become float columns, integer buffers become
+ * integer columns and boolean buffers become boolean columns. Contiguous
+ * buffers of doubles are copied with a single \c memcpy().
+ *
+ * \param o the Python object to be converted
+ * \param result the new column is returned here
+ * \return 0 if everything was OK, 1 if an error happened (an exception is
+ *         set in this case) and -1 if the object does not export a suitable
+ *         buffer. In the latter case, no exception is set.
+ */
+int igraphmodule_Column_from_buffer(PyObject* o, PyObject** result) {
+  igraphmodule_ColumnObject* self;
+  igraphmodule_column_type_t type;
+  Py_buffer buffer;
+  Py_ssize_t i, n;
+  const char *ptr;
+
+  if (PyBaseString_Check(o) || !PyObject_CheckBuffer(o))
+    return -1;
+
+  if (PyObject_GetBuffer(o, &buffer, PyBUF_STRIDES | PyBUF_FORMAT)) {
+    PyErr_Clear();
+    return -1;
+  }
+
+  if (buffer.ndim != 1) {
+    PyBuffer_Release(&buffer);
+    return -1;
+  }
+
+  switch (igraphmodule_buffer_item_kind(&buffer)) {
+    case IGRAPHMODULE_BUFFER_ITEM_FLOAT:
+      type = IGRAPHMODULE_COLUMN_FLOAT;
+      break;
+
+    case IGRAPHMODULE_BUFFER_ITEM_SIGNED:
+      type = IGRAPHMODULE_COLUMN_INT;
+      break;
+
+    case IGRAPHMODULE_BUFFER_ITEM_UNSIGNED:
+      /* 64-bit unsigned integers may not fit into the column */
+      if (buffer.itemsize >= (Py_ssize_t)sizeof(PY_LONG_LONG)) {
+        PyBuffer_Release(&buffer);
+        return -1;
+      }
+      type = IGRAPHMODULE_COLUMN_INT;
+      break;
+
+    case IGRAPHMODULE_BUFFER_ITEM_BOOL:
+      type = IGRAPHMODULE_COLUMN_BOOL;
+      break;
+
+    default:
+      PyBuffer_Release(&buffer);
+      return -1;
+  }
+
+  n = buffer.shape[0];
+  self = (igraphmodule_ColumnObject*)igraphmodule_Column_New(type, n);
+  if (self == 0) {
+    PyBuffer_Release(&buffer);
+    return 1;
+  }
+
+  ptr = (const char*)buffer.buf;
+  if (type == IGRAPHMODULE_COLUMN_FLOAT && buffer.itemsize == sizeof(double) &&
+      buffer.strides[0] == sizeof(double)) {
+    memcpy(self->data, ptr, n * sizeof(double));
+  } else if (type == IGRAPHMODULE_COLUMN_FLOAT) {
+    for (i = 0; i < n; i++, ptr += buffer.strides[0]) {
+      ((double*)self->data)[i] = igraphmodule_buffer_item_as_real(ptr,
+          IGRAPHMODULE_BUFFER_ITEM_FLOAT, buffer.itemsize);
+    }
+  } else if (type == IGRAPHMODULE_COLUMN_BOOL) {
+    for (i = 0; i < n; i++, ptr += buffer.strides[0]) {
+      self->data[i] = *ptr ? 1 : 0;
+    }
+  } else {
+    int is_signed = igraphmodule_buffer_item_kind(&buffer) == IGRAPHMODULE_BUFFER_ITEM_SIGNED;
+    for (i = 0; i < n; i++, ptr += buffer.strides[0]) {
+      PY_LONG_LONG value;
+      switch (buffer.itemsize) {
+        case 1:
+          value = is_signed ? *(const signed char*)ptr : *(const unsigned char*)ptr;
+          break;
+        case 2: {
+          short x; memcpy(&x, ptr, 2);
+          value = is_signed ? x : (unsigned short)x;
+          break;
+        }
+        case 4: {
+          int x; memcpy(&x, ptr, 4);
+          value = is_signed ? x : (unsigned int)x;
+          break;
+        }
+        default:
+          memcpy(&value, ptr, sizeof(PY_LONG_LONG));
+      }
+      ((PY_LONG_LONG*)self->data)[i] = value;
+    }
+  }
+
+  PyBuffer_Release(&buffer);
+
+  *result = (PyObject*)self;
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Creates a new column from a Python list of numbers, booleans or
+ *        \c None values
+ *
+ * The type of the column is inferred from the items: a list of booleans
+ * becomes a boolean column, a list of integers becomes an integer column
+ * and a list of integers and floats becomes a float column. \c None is
+ * accepted everywhere and marks a missing value.
+ *
+ * \return the new column, or \c NULL if the list cannot be represented as
+ *         a column. No exception is set in the latter case unless there
+ *         was a memory allocation error.
+ */
+PyObject* igraphmodule_Column_from_list(PyObject* list) {
+  igraphmodule_ColumnObject* self;
+  igraphmodule_column_type_t type;
+  igraph_bool_t has_bool = 0, has_int = 0, has_float = 0;
+  Py_ssize_t i, n;
+  PyObject* item;
+
+  if (!PyList_Check(list))
+    return 0;
+
+  n = PyList_GET_SIZE(list);
+  for (i = 0; i < n; i++) {
+    item = PyList_GET_ITEM(list, i);
+    if (item == Py_None) {
+      continue;
+    } else if (PyBool_Check(item)) {
+      has_bool = 1;
+    } else if (PyFloat_Check(item)) {
+      has_float = 1;
+    } else if (PyIndex_Check(item)) {
+      has_int = 1;
+    } else {
+      return 0;
+    }
+  }
+
+  if (has_bool && (has_int || has_float))
+    return 0;
+
+  if (has_bool)
+    type = IGRAPHMODULE_COLUMN_BOOL;
+  else if (has_int && !has_float)
+    type = IGRAPHMODULE_COLUMN_INT;
+  else
+    type = IGRAPHMODULE_COLUMN_FLOAT;
+
+  self = (igraphmodule_ColumnObject*)igraphmodule_Column_New(type, n);
+  if (self == 0)
+    return 0;
+
+  for (i = 0; i < n; i++) {
+    int retval = igraphmodule_Column_set_item(self, i, PyList_GET_ITEM(list, i));
+    if (retval) {
+      /* integer too large to be stored in the column, or out of memory */
+      Py_DECREF(self);
+      return 0;
+    }
+  }
+
+  return (PyObject*)self;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Returns the length of the run of consecutive indices starting at
+ *        position \c i of an index vector
+ *
+ * \return the length of the run, or zero if the first index of the run is
+ *         out of range
+ */
+static Py_ssize_t igraphmodule_i_Column_index_run(const igraph_vector_t* idx,
+    Py_ssize_t i, Py_ssize_t size) {
+  Py_ssize_t j = (Py_ssize_t)VECTOR(*idx)[i], n = igraph_vector_size(idx), run = 1;
+
+  if (j < 0 || j >= size)
+    return 0;
+
+  while (i + run < n && j + run < size && VECTOR(*idx)[i + run] == j + run)
+    run++;
+
+  return run;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Creates a new column containing the given items of another column
+ *
+ * \param idx the indices of the items to keep, in the order they should
+ *        appear in the new column
+ */
+PyObject* igraphmodule_Column_select(igraphmodule_ColumnObject* self,
+    const igraph_vector_t* idx) {
+  igraphmodule_ColumnObject* result;
+  size_t itemsize = igraphmodule_Column_itemsize(self->type);
+  Py_ssize_t i, j, run, n = igraph_vector_size(idx);
+
+  result = (igraphmodule_ColumnObject*)igraphmodule_Column_New(self->type, n);
+  if (result == 0)
+    return 0;
+
+  if (self->valid && igraphmodule_Column_create_mask(result)) {
+    Py_DECREF(result);
+    return 0;
+  }
+
+  /* Copy runs of consecutive indices at once; deletions keep long runs */
+  for (i = 0; i < n; i += run) {
+    j = (Py_ssize_t)VECTOR(*idx)[i];
+    run = igraphmodule_i_Column_index_run(idx, i, self->size);
+    if (run == 0) {
+      PyErr_SetString(PyExc_IndexError, "column index out of range");
+      Py_DECREF(result);
+      return 0;
+    }
+    memcpy(result->data + i * itemsize, self->data + j * itemsize, run * itemsize);
+    if (self->valid)
+      memcpy(result->valid + i, self->valid + j, run);
+  }
+
+  return (PyObject*)result;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Keeps the given items of a column and drops the others, in place
+ *
+ * The items are moved in runs of consecutive indices, so deleting a few
+ * items from a large column costs a few \c memmove() calls.
+ *
+ * \param idx the indices of the items to keep, in strictly increasing order
+ * \return zero if successful, 1 if the indices are invalid or the buffer of
+ *         the column is exported (with an exception set)
+ */
+int igraphmodule_Column_compact(igraphmodule_ColumnObject* self,
+    const igraph_vector_t* idx) {
+  size_t itemsize = igraphmodule_Column_itemsize(self->type);
+  Py_ssize_t i, j, run, n = igraph_vector_size(idx);
+
+  if (self->exports > 0) {
+    PyErr_SetString(PyExc_BufferError, "column cannot be compacted while "
+        "its buffer is in use");
+    return 1;
+  }
+
+  for (i = 0; i < n; i++) {
+    j = (Py_ssize_t)VECTOR(*idx)[i];
+    if (j < i || j >= self->size || (i > 0 && j <= VECTOR(*idx)[i-1])) {
+      PyErr_SetString(PyExc_IndexError, "column indices must be increasing "
+          "and in range");
+      return 1;
+    }
+  }
+
+  for (i = 0; i < n; i += run) {
+    j = (Py_ssize_t)VECTOR(*idx)[i];
+    run = igraphmodule_i_Column_index_run(idx, i, self->size);
+    if (i != j) {
+      memmove(self->data + i * itemsize, self->data + j * itemsize, run * itemsize);
+      if (self->valid)
+        memmove(self->valid + i, self->valid + j, run);
+    }
+  }
+  self->size = n;
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Creates an independent copy of a column
+ */
+PyObject* igraphmodule_Column_copy(igraphmodule_ColumnObject* self) {
+  igraphmodule_ColumnObject* result;
+
+  result = (igraphmodule_ColumnObject*)igraphmodule_Column_New(self->type, self->size);
+  if (result == 0)
+    return 0;
+
+  memcpy(result->data, self->data, self->size * igraphmodule_Column_itemsize(self->type));
+  if (self->valid) {
+    if (igraphmodule_Column_create_mask(result)) {
+      Py_DECREF(result);
+      return 0;
+    }
+    memcpy(result->valid, self->valid, self->size);
+  }
+
+  return (PyObject*)result;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Returns the given item of the column as a Python object
+ *
+ * \return a new reference to a Python float, integer or boolean, or to
+ *         \c None if the item is missing
+ */
+PyObject* igraphmodule_Column_get_item(igraphmodule_ColumnObject* self, Py_ssize_t i) {
+  if (self->valid && !self->valid[i])
+    Py_RETURN_NONE;
+
+  switch (self->type) {
+    case IGRAPHMODULE_COLUMN_FLOAT:
+      return PyFloat_FromDouble(((double*)self->data)[i]);
+
+    case IGRAPHMODULE_COLUMN_INT:
+#ifdef IGRAPH_PYTHON3
+      return PyLong_FromLongLong(((PY_LONG_LONG*)self->data)[i]);
+#else
+      {
+        PY_LONG_LONG value = ((PY_LONG_LONG*)self->data)[i];
+        if (value >= LONG_MIN && value <= LONG_MAX)
+          return PyInt_FromLong((long)value);
+        return PyLong_FromLongLong(value);
+      }
+#endif
+
+    default:
+      return PyBool_FromLong(self->data[i]);
+  }
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Sets the given item of the column from a Python object
+ *
+ * \c None marks the item as missing. Float columns accept floats and
+ * integers, integer columns accept integers that fit into 64 bits and
+ * boolean columns accept \c True and \c False only.
+ *
+ * \return 0 if everything was OK, 1 if the value cannot be stored in the
+ *         column (no exception is set in this case) and -1 if there was
+ *         an error (with an exception set).
+ */
+int igraphmodule_Column_set_item(igraphmodule_ColumnObject* self, Py_ssize_t i,
+    PyObject* value) {
+  if (value == Py_None)
+    return igraphmodule_Column_set_missing(self, i) ? -1 : 0;
+
+  switch (self->type) {
+    case IGRAPHMODULE_COLUMN_FLOAT:
+      if (PyBool_Check(value) || !(PyFloat_Check(value) || PyIndex_Check(value)))
+        return 1;
+      ((double*)self->data)[i] = PyFloat_AsDouble(value);
+      if (((double*)self->data)[i] == -1.0 && PyErr_Occurred()) {
+        PyErr_Clear();
+        return 1;
+      }
+      break;
+
+    case IGRAPHMODULE_COLUMN_INT:
+      if (PyBool_Check(value) || !PyIndex_Check(value))
+        return 1;
+      {
+        PyObject* index = PyNumber_Index(value);
+        PY_LONG_LONG x;
+        if (index == 0) {
+          PyErr_Clear();
+          return 1;
+        }
+        x = PyLong_AsLongLong(index);
+        Py_DECREF(index);
+        if (x == -1 && PyErr_Occurred()) {
+          PyErr_Clear();
+          return 1;
+        }
+        ((PY_LONG_LONG*)self->data)[i] = x;
+      }
+      break;
+
+    default:
+      if (value != Py_True && value != Py_False)
+        return 1;
+      self->data[i] = (value == Py_True);
+  }
+
+  if (self->valid)
+    self->valid[i] = 1;
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Returns the given item of the column as a real number
+ *
+ * Missing items are returned as NaN.
+ */
+igraph_real_t igraphmodule_Column_get_real(igraphmodule_ColumnObject* self, Py_ssize_t i) {
+  if (self->valid && !self->valid[i])
+    return IGRAPH_NAN;
+
+  switch (self->type) {
+    case IGRAPHMODULE_COLUMN_FLOAT:
+      return ((double*)self->data)[i];
+    case IGRAPHMODULE_COLUMN_INT:
+      return (igraph_real_t)((PY_LONG_LONG*)self->data)[i];
+    default:
+      return self->data[i] ? 1 : 0;
+  }
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Returns the truth value of the given item of the column
+ *
+ * Missing items are considered false, just like \c None in Python.
+ */
+igraph_bool_t igraphmodule_Column_get_bool(igraphmodule_ColumnObject* self, Py_ssize_t i) {
+  if (self->valid && !self->valid[i])
+    return 0;
+
+  switch (self->type) {
+    case IGRAPHMODULE_COLUMN_FLOAT:
+      return ((double*)self->data)[i] != 0;
+    case IGRAPHMODULE_COLUMN_INT:
+      return ((PY_LONG_LONG*)self->data)[i] != 0;
+    default:
+      return self->data[i] != 0;
+  }
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Resizes the column
+ *
+ * Items added to the end of the column are marked as missing. The column
+ * may not be resized while its buffer is exported to another object.
+ *
+ * \return 0 if everything was OK, 1 otherwise (with an exception set)
+ */
+int igraphmodule_Column_resize(igraphmodule_ColumnObject* self, Py_ssize_t size) {
+  Py_ssize_t i, capacity;
+
+  if (size <= self->size) {
+    self->size = size;
+    return 0;
+  }
+
+  if (size > self->capacity) {
+    if (self->exports > 0) {
+      PyErr_SetString(PyExc_BufferError, "column cannot be resized while "
+          "its buffer is in use");
+      return 1;
+    }
+    capacity = self->capacity * 2;
+    if (capacity < size)
+      capacity = size;
+    if (igraphmodule_Column_reserve(self, capacity))
+      return 1;
+  }
+
+  if (igraphmodule_Column_create_mask(self))
+    return 1;
+
+  for (i = self->size; i < size; i++) {
+    igraphmodule_Column_set_missing(self, i);
+  }
+  self->size = size;
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Converts the column to a Python list
+ */
+PyObject* igraphmodule_Column_to_list(igraphmodule_ColumnObject* self) {
+  PyObject *result, *item;
+  Py_ssize_t i;
+
+  result = PyList_New(self->size);
+  if (result == 0)
+    return 0;
+
+  for (i = 0; i < self->size; i++) {
+    item = igraphmodule_Column_get_item(self, i);
+    if (item == 0) {
+      Py_DECREF(result);
+      return 0;
+    }
+    PyList_SET_ITEM(result, i, item);  /* reference stolen */
+  }
+
+  return result;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Copies the contents of the column into an igraph vector
+ *
+ * Missing items are represented by NaN. The vector must be initialized;
+ * it is resized as needed.
+ *
+ * \return 0 if everything was OK, 1 otherwise (with an exception set)
+ */
+int igraphmodule_Column_to_vector_t(igraphmodule_ColumnObject* self, igraph_vector_t* v) {
+  Py_ssize_t i;
+
+  if (igraph_vector_resize(v, self->size)) {
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+
+  if (self->type == IGRAPHMODULE_COLUMN_FLOAT && sizeof(double) == sizeof(igraph_real_t)) {
+    if (self->size > 0)
+      memcpy(VECTOR(*v), self->data, self->size * sizeof(double));
+  } else {
+    for (i = 0; i < self->size; i++) {
+      VECTOR(*v)[i] = igraphmodule_Column_get_real(self, i);
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Deallocates a column object
+ */
+static void igraphmodule_Column_dealloc(igraphmodule_ColumnObject* self) {
+  igraphmodule_memory_track(IGRAPHMODULE_MEMORY_COLUMNS,
+      -igraphmodule_Column_storage_bytes(self), -1);
+  PyMem_Free(self->data);
+  PyMem_Free(self->valid);
+  PyObject_Del((PyObject*)self);
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Returns the number of items in the column
+ */
+static Py_ssize_t igraphmodule_Column_len(igraphmodule_ColumnObject* self) {
+  return self->size;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Returns the item of the column with the given index
+ */
+static PyObject* igraphmodule_Column_sq_item(igraphmodule_ColumnObject* self,
+    Py_ssize_t i) {
+  if (i < 0 || i >= self->size) {
+    PyErr_SetString(PyExc_IndexError, "column index out of range");
+    return 0;
+  }
+  return igraphmodule_Column_get_item(self, i);
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Gives the column the shape of a matrix stored in row-major order
+ *
+ * Only the buffers exported from the column are affected; indexing and
+ * iteration stay one-dimensional. The column falls back to a single
+ * dimension when its size changes.
+ *
+ * \return 0 if everything was OK, 1 otherwise (with a \c ValueError)
+ */
+int igraphmodule_Column_reshape(igraphmodule_ColumnObject* self, Py_ssize_t rows,
+    Py_ssize_t cols) {
+  if (rows < 0 || cols < 0 || rows * cols != self->size) {
+    PyErr_SetString(PyExc_ValueError, "shape does not match the size of the column");
+    return 1;
+  }
+
+  self->ndim = 2;
+  self->shape[0] = rows;
+  self->shape[1] = cols;
+  self->strides[0] = cols * igraphmodule_Column_itemsize(self->type);
+  self->strides[1] = igraphmodule_Column_itemsize(self->type);
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Brings the shape of the exported buffers up to date with the size
+ *        of the column
+ */
+static void igraphmodule_i_Column_update_shape(igraphmodule_ColumnObject* self) {
+  if (self->ndim == 2 && self->shape[0] * self->shape[1] != self->size) {
+    /* The column was resized since it was reshaped */
+    self->ndim = 1;
+    self->strides[0] = igraphmodule_Column_itemsize(self->type);
+  }
+  if (self->ndim == 1) {
+    self->shape[0] = self->size;
+  }
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Fills a \c Py_buffer structure according to the buffer protocol
+ *
+ * The exported buffer is read-only; it would be too easy to bypass the
+ * validity mask otherwise.
+ */
+static int igraphmodule_Column_getbuffer(igraphmodule_ColumnObject* self,
+    Py_buffer* view, int flags) {
+  static char* formats[] = { "d", "q", "?" };
+
+  if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE) {
+    PyErr_SetString(PyExc_BufferError, "attribute columns are read-only");
+    view->obj = 0;
+    return -1;
+  }
+
+  view->buf = self->data;
+  view->obj = (PyObject*)self;
+  Py_INCREF(self);
+  view->itemsize = igraphmodule_Column_itemsize(self->type);
+  view->len = self->size * view->itemsize;
+  view->readonly = 1;
+  view->format = (flags & PyBUF_FORMAT) ? formats[self->type] : 0;
+  igraphmodule_i_Column_update_shape(self);
+  view->ndim = self->ndim;
+  view->shape = (flags & PyBUF_ND) ? self->shape : 0;
+  view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? self->strides : 0;
+  view->suboffsets = 0;
+  view->internal = 0;
+
+  self->exports++;
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Releases a buffer exported by \ref igraphmodule_Column_getbuffer()
+ */
+static void igraphmodule_Column_releasebuffer(igraphmodule_ColumnObject* self,
+    Py_buffer* view) {
+  self->exports--;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Returns the type of the column as a string
+ */
+static PyObject* igraphmodule_Column_get_type(igraphmodule_ColumnObject* self,
+    void* closure) {
+  return PyString_FromString(igraphmodule_Column_type_names[self->type]);
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Returns the shape of the exported buffers as a tuple
+ */
+static PyObject* igraphmodule_Column_get_shape(igraphmodule_ColumnObject* self,
+    void* closure) {
+  igraphmodule_i_Column_update_shape(self);
+  if (self->ndim == 2)
+    return Py_BuildValue("nn", self->shape[0], self->shape[1]);
+  return Py_BuildValue("(n)", self->shape[0]);
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Returns a list of booleans telling which items are not missing
+ */
+static PyObject* igraphmodule_Column_get_valid(igraphmodule_ColumnObject* self,
+    void* closure) {
+  PyObject* result;
+  Py_ssize_t i;
+
+  result = PyList_New(self->size);
+  if (result == 0)
+    return 0;
+
+  for (i = 0; i < self->size; i++) {
+    PyList_SET_ITEM(result, i, PyBool_FromLong(!self->valid || self->valid[i]));
+  }
+
+  return result;
+}
+
+/**
+ * \ingroup python_interface_column
+ * \brief Formats a column object in a human-consumable format
+ */
+static PyObject* igraphmodule_Column_repr(igraphmodule_ColumnObject* self) {
+  return PyString_FromFormat("<igraph.AttributeColumn of type %s with %ld items>",
+      igraphmodule_Column_type_names[self->type], (long)self->size);
+}
+
+/**
+ * \ingroup python_interface_column
+ * Method table for the \c igraph.AttributeColumn object
+ */
+static PyMethodDef igraphmodule_Column_methods[] = {
+  {"tolist", (PyCFunction)igraphmodule_Column_to_list, METH_NOARGS,
+    "tolist()\n\n"
+    "Returns the contents of the column as a list. Missing values are\n"
+    "represented by C{None}.\n"
+  },
+  {NULL}
+};
+
+/**
+ * \ingroup python_interface_column
+ * Getter/setter table for the \c igraph.AttributeColumn object
+ */
+static PyGetSetDef igraphmodule_Column_getseters[] = {
+  {"type", (getter)igraphmodule_Column_get_type, NULL,
+    "The type of the items in the column: C{\"float\"}, C{\"int\"} or C{\"bool\"}",
+    NULL
+  },
+  {"valid", (getter)igraphmodule_Column_get_valid, NULL,
+    "A list of booleans, C{False} for each item that is missing", NULL
+  },
+  {"shape", (getter)igraphmodule_Column_get_shape, NULL,
+    "The shape of the buffer exported by the column as a tuple. Columns\n"
+    "holding a matrix in row-major order export it two-dimensionally;\n"
+    "indexing the column is always one-dimensional.", NULL
+  },
+  {NULL}
+};
+
+/**
+ * \ingroup python_interface_column
+ * Sequence protocol methods of the \c igraph.AttributeColumn object
+ */
+static PySequenceMethods igraphmodule_Column_as_sequence = {
+  (lenfunc)igraphmodule_Column_len,           /* sq_length */
+  0,                                          /* sq_concat */
+  0,                                          /* sq_repeat */
+  (ssizeargfunc)igraphmodule_Column_sq_item,  /* sq_item */
+};
+
+/**
+ * \ingroup python_interface_column
+ * Buffer protocol methods of the \c igraph.AttributeColumn object
+ */
+static PyBufferProcs igraphmodule_Column_as_buffer = {
+#ifndef IGRAPH_PYTHON3
+  0,                                          /* bf_getreadbuffer */
+  0,                                          /* bf_getwritebuffer */
+  0,                                          /* bf_getsegcount */
+  0,                                          /* bf_getcharbuffer */
+#endif
+  (getbufferproc)igraphmodule_Column_getbuffer, /* bf_getbuffer */
+  (releasebufferproc)igraphmodule_Column_releasebuffer, /* bf_releasebuffer */
+};
+
+#ifdef IGRAPH_PYTHON3
+#  define IGRAPHMODULE_COLUMN_TPFLAGS Py_TPFLAGS_DEFAULT
+#else
+#  define IGRAPHMODULE_COLUMN_TPFLAGS (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_NEWBUFFER)
+#endif
+
+/** \ingroup python_interface_column
+ * Python type object referencing the methods Python calls when it performs
+ * various operations on an attribute column
+ */
+PyTypeObject igraphmodule_ColumnType = {
+  PyVarObject_HEAD_INIT(0, 0)
+  "igraph.AttributeColumn",                   /* tp_name */
+  sizeof(igraphmodule_ColumnObject),          /* tp_basicsize */
+  0,                                          /* tp_itemsize */
+  (destructor)igraphmodule_Column_dealloc,    /* tp_dealloc */
+  0,                                          /* tp_print */
+  0,                                          /* tp_getattr */
+  0,                                          /* tp_setattr */
+  0,                                          /* tp_compare (2.x) / tp_reserved (3.x) */
+  (reprfunc)igraphmodule_Column_repr,         /* tp_repr */
+  0,                                          /* tp_as_number */
+  &igraphmodule_Column_as_sequence,           /* tp_as_sequence */
+  0,                                          /* tp_as_mapping */
+  0,                                          /* tp_hash */
+  0,                                          /* tp_call */
+  0,                                          /* tp_str */
+  0,                                          /* tp_getattro */
+  0,                                          /* tp_setattro */
+  &igraphmodule_Column_as_buffer,             /* tp_as_buffer */
+  IGRAPHMODULE_COLUMN_TPFLAGS,                /* tp_flags */
+  "Typed storage of a numeric or Boolean vertex or edge attribute.\n\n"
+  "Numeric and Boolean attributes assigned from an object supporting the\n"
+  "buffer protocol (e.g., a NumPy array) are stored in a contiguous array\n"
+  "of C{double}, 64-bit integer or C{bool} values instead of a Python\n"
+  "list. The values are still returned as ordinary Python lists when\n"
+  "the attribute is queried, but the C core of igraph can access them\n"
+  "without any conversion.\n\n"
+  "Columns are returned by L{VertexSeq.get_attribute_column()} and\n"
+  "L{EdgeSeq.get_attribute_column()}. They support the sequence protocol\n"
+  "and expose their contents through the buffer protocol in read-only\n"
+  "mode, so they can be wrapped without copying, e.g., by\n"
+  "C{numpy.asarray()}. Missing values are stored as NaN (in float\n"
+  "columns) or zero (otherwise); see the C{valid} property.\n",
+  0,                                          /* tp_traverse */
+  0,                                          /* tp_clear */
+  0,                                          /* tp_richcompare */
+  0,                                          /* tp_weaklistoffset */
+  0,                                          /* tp_iter */
+  0,                                          /* tp_iternext */
+  igraphmodule_Column_methods,                /* tp_methods */
+  0,                                          /* tp_members */
+  igraphmodule_Column_getseters,              /* tp_getset */
+};
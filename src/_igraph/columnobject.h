@@ -0,0 +1,104 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef PYTHON_COLUMNOBJECT_H
+#define PYTHON_COLUMNOBJECT_H
+
+#include <Python.h>
+#include <igraph_types.h>
+#include <igraph_vector.h>
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_column Typed columns storing vertex and edge attributes
+ */
+extern PyTypeObject igraphmodule_ColumnType;
+
+/**
+ * \ingroup python_interface_column
+ * \brief Item types of a typed attribute column
+ */
+typedef enum {
+  IGRAPHMODULE_COLUMN_FLOAT = 0,
+  IGRAPHMODULE_COLUMN_INT,
+  IGRAPHMODULE_COLUMN_BOOL
+} igraphmodule_column_type_t;
+
+/**
+ * \ingroup python_interface_column
+ * \brief A contiguous array of doubles, 64-bit integers or booleans with
+ *        a validity mask, used in place of a Python list to store a numeric
+ *        vertex or edge attribute.
+ *
+ * Missing values (\c None on the Python side) are marked in the validity
+ * mask; the mask is not allocated until the first missing value appears.
+ * Missing floats are also stored as NaN so the contents of the column can
+ * be handed to the C core directly.
+ */
+typedef struct {
+  PyObject_HEAD
+  // Type of the items in the column
+  igraphmodule_column_type_t type;
+  // Number of items in the column and the number of items allocated
+  Py_ssize_t size;
+  Py_ssize_t capacity;
+  // The items of the column
+  char* data;
+  // Validity mask (non-zero = valid), null pointer if all items are valid
+  char* valid;
+  // Number of buffers currently exported from the column
+  Py_ssize_t exports;
+  // Number of dimensions, shape and strides of the exported buffers. A
+  // column is one-dimensional unless it was given a row-major matrix shape
+  // with igraphmodule_Column_reshape()
+  int ndim;
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+} igraphmodule_ColumnObject;
+
+#define igraphmodule_Column_Check(o) PyObject_TypeCheck((o), &igraphmodule_ColumnType)
+
+PyObject* igraphmodule_Column_New(igraphmodule_column_type_t type, Py_ssize_t size);
+int igraphmodule_Column_from_buffer(PyObject* o, PyObject** result);
+PyObject* igraphmodule_Column_from_list(PyObject* list);
+PyObject* igraphmodule_Column_copy(igraphmodule_ColumnObject* self);
+PyObject* igraphmodule_Column_select(igraphmodule_ColumnObject* self,
+    const igraph_vector_t* idx);
+int igraphmodule_Column_compact(igraphmodule_ColumnObject* self,
+    const igraph_vector_t* idx);
+Py_ssize_t igraphmodule_Column_allocated_bytes(igraphmodule_ColumnObject* self);
+int igraphmodule_Column_reshape(igraphmodule_ColumnObject* self, Py_ssize_t rows,
+    Py_ssize_t cols);
+
+PyObject* igraphmodule_Column_get_item(igraphmodule_ColumnObject* self, Py_ssize_t i);
+int igraphmodule_Column_set_item(igraphmodule_ColumnObject* self, Py_ssize_t i,
+    PyObject* value);
+igraph_real_t igraphmodule_Column_get_real(igraphmodule_ColumnObject* self, Py_ssize_t i);
+igraph_bool_t igraphmodule_Column_get_bool(igraphmodule_ColumnObject* self, Py_ssize_t i);
+
+int igraphmodule_Column_resize(igraphmodule_ColumnObject* self, Py_ssize_t size);
+PyObject* igraphmodule_Column_to_list(igraphmodule_ColumnObject* self);
+int igraphmodule_Column_to_vector_t(igraphmodule_ColumnObject* self, igraph_vector_t* v);
+
+#endif
@@ -22,6 +22,7 @@
 
 #include "common.h"
 #include "structmember.h"
+#include <time.h>
 
 /**
  * \ingroup python_interface
@@ -69,3 +70,89 @@ PyObject* igraphmodule_resolve_graph_weakref(PyObject* ref) {
   }
   return o;
 }
+
+/**
+ * \ingroup python_interface
+ * \brief Returns the value of a monotonic clock in seconds
+ *
+ * Used to measure the running time of computations and to enforce time
+ * budgets; may be called without holding the GIL.
+ */
+double igraphmodule_clock(void) {
+#if defined(_POSIX_TIMERS) && defined(CLOCK_MONOTONIC)
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+  return ((double)clock()) / CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+ * \ingroup python_interface
+ * \brief Derives the seed of an independent random stream (e.g. a single
+ *        run of an ensemble or a block of random walks) from a base seed
+ *        (SplitMix64 finalizer)
+ */
+unsigned long int igraphmodule_stream_seed(unsigned long int seed, long int index) {
+  unsigned long long int z = (unsigned long long int) seed +
+    0x9E3779B97F4A7C15ULL * (unsigned long long int) (index + 1);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return (unsigned long int) ((z ^ (z >> 31)) & 0xffffffffUL);
+}
+
+/**
+ * \ingroup python_interface
+ * \brief Builds an alias table for sampling from a discrete distribution
+ *        in constant time (Vose's method)
+ *
+ * Item \em j is sampled by drawing \em j uniformly and keeping it with
+ * probability \c prob[j], taking \c alias[j] otherwise. May be called
+ * without holding the GIL.
+ *
+ * \param n the number of items
+ * \param prob the non-negative weights of the items on entry (not all of
+ *        them zero) and the probabilities of keeping them on exit
+ * \param alias the aliases of the items on exit
+ * \param scaled scratch space of \p n doubles
+ * \param small scratch space of \p n integers
+ * \param large scratch space of \p n integers
+ */
+void igraphmodule_alias_table(long int n, double *prob, long int *alias,
+    double *scaled, long int *small, long int *large) {
+  long int j, k, no_of_small = 0, no_of_large = 0;
+  double sum = 0;
+
+  for (j = 0; j < n; j++) {
+    sum += prob[j];
+  }
+  for (j = 0; j < n; j++) {
+    scaled[j] = prob[j] * n / sum;
+    if (scaled[j] < 1) {
+      small[no_of_small++] = j;
+    } else {
+      large[no_of_large++] = j;
+    }
+  }
+  while (no_of_small > 0 && no_of_large > 0) {
+    j = small[--no_of_small];
+    k = large[no_of_large - 1];
+    prob[j] = scaled[j];
+    alias[j] = k;
+    scaled[k] -= 1 - scaled[j];
+    if (scaled[k] < 1) {
+      no_of_large--;
+      small[no_of_small++] = k;
+    }
+  }
+  /* The rest have a probability of one, up to rounding errors */
+  while (no_of_large > 0) {
+    j = large[--no_of_large];
+    prob[j] = 1; alias[j] = j;
+  }
+  while (no_of_small > 0) {
+    j = small[--no_of_small];
+    prob[j] = 1; alias[j] = j;
+  }
+}
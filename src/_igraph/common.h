@@ -75,4 +75,8 @@
 
 PyObject* igraphmodule_unimplemented(PyObject* self, PyObject* args, PyObject* kwds);
 PyObject* igraphmodule_resolve_graph_weakref(PyObject* ref);
+double igraphmodule_clock(void);
+unsigned long int igraphmodule_stream_seed(unsigned long int seed, long int index);
+void igraphmodule_alias_table(long int n, double *prob, long int *alias,
+    double *scaled, long int *small, long int *large);
 #endif
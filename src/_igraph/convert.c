@@ -25,6 +25,8 @@
 #include <Python.h>
 #include <limits.h>
 #include "attributes.h"
+#include "bufferobject.h"
+#include "columnobject.h"
 #include "graphobject.h"
 #include "vertexseqobject.h"
 #include "vertexobject.h"
@@ -538,6 +540,20 @@ int igraphmodule_PyObject_to_reciprocity_t(PyObject *o, igraph_reciprocity_t *re
   return igraphmodule_PyObject_to_enum(o, reciprocity_tt, (int*)result);
 }
 
+/**
+ * \brief Converts a Python object to an \c igraphmodule_return_type_t
+ */
+int igraphmodule_PyObject_to_return_type_t(PyObject *o,
+    igraphmodule_return_type_t *result) {
+  static igraphmodule_enum_translation_table_entry_t return_type_tt[] = {
+    {"list", IGRAPHMODULE_RETURN_LIST},
+    {"buffer", IGRAPHMODULE_RETURN_BUFFER},
+    {0,0}
+  };
+
+  return igraphmodule_PyObject_to_enum(o, return_type_tt, (int*)result);
+}
+
 /**
  * \brief Converts a Python object to an igraph \c igraph_rewiring_t
  */
@@ -797,6 +813,264 @@ int igraphmodule_PyObject_to_real_t(PyObject *object, igraph_real_t *v) {
   return 1;
 }
 
+/**
+ * \ingroup python_interface_conversion
+ * \brief Determines the kind of the items in a buffer from its format string
+ *
+ * Only single numeric items in native byte order are supported; everything
+ * else is reported as \c IGRAPHMODULE_BUFFER_ITEM_UNSUPPORTED so the caller
+ * can fall back to the generic, iterator-based conversion.
+ */
+igraphmodule_buffer_item_kind_t igraphmodule_buffer_item_kind(
+    const Py_buffer *buffer) {
+  const char *format = buffer->format ? buffer->format : "B";
+  const int one = 1;
+  int little_endian = *((const char*)&one);
+
+  if (*format == '@' || *format == '=') {
+    format++;
+  } else if (*format == '<') {
+    if (!little_endian)
+      return IGRAPHMODULE_BUFFER_ITEM_UNSUPPORTED;
+    format++;
+  } else if (*format == '>' || *format == '!') {
+    if (little_endian)
+      return IGRAPHMODULE_BUFFER_ITEM_UNSUPPORTED;
+    format++;
+  }
+
+  if (format[0] == 0 || format[1] != 0)
+    return IGRAPHMODULE_BUFFER_ITEM_UNSUPPORTED;
+
+  switch (buffer->itemsize) {
+    case 1: case 2: case 4: case 8:
+      break;
+    default:
+      return IGRAPHMODULE_BUFFER_ITEM_UNSUPPORTED;
+  }
+
+  switch (format[0]) {
+    case 'b': case 'h': case 'i': case 'l': case 'q': case 'n':
+      return IGRAPHMODULE_BUFFER_ITEM_SIGNED;
+
+    case 'B': case 'H': case 'I': case 'L': case 'Q': case 'N':
+      return IGRAPHMODULE_BUFFER_ITEM_UNSIGNED;
+
+    case 'f': case 'd':
+      if (buffer->itemsize != sizeof(float) && buffer->itemsize != sizeof(double))
+        return IGRAPHMODULE_BUFFER_ITEM_UNSUPPORTED;
+      return IGRAPHMODULE_BUFFER_ITEM_FLOAT;
+
+    case '?':
+      return IGRAPHMODULE_BUFFER_ITEM_BOOL;
+
+    default:
+      return IGRAPHMODULE_BUFFER_ITEM_UNSUPPORTED;
+  }
+}
+
+/**
+ * \ingroup python_interface_conversion
+ * \brief Reads a single item from a buffer as an \c igraph_real_t
+ *
+ * The item is copied to a local variable first as items of strided buffers
+ * are not necessarily aligned.
+ */
+igraph_real_t igraphmodule_buffer_item_as_real(const char *ptr,
+    igraphmodule_buffer_item_kind_t kind, Py_ssize_t itemsize) {
+  switch (kind) {
+    case IGRAPHMODULE_BUFFER_ITEM_SIGNED:
+      switch (itemsize) {
+        case 1: { signed char x; memcpy(&x, ptr, 1); return x; }
+        case 2: { short x; memcpy(&x, ptr, 2); return x; }
+        case 4: { int x; memcpy(&x, ptr, 4); return x; }
+        default: { PY_LONG_LONG x; memcpy(&x, ptr, 8); return (igraph_real_t)x; }
+      }
+
+    case IGRAPHMODULE_BUFFER_ITEM_UNSIGNED:
+      switch (itemsize) {
+        case 1: { unsigned char x; memcpy(&x, ptr, 1); return x; }
+        case 2: { unsigned short x; memcpy(&x, ptr, 2); return x; }
+        case 4: { unsigned int x; memcpy(&x, ptr, 4); return x; }
+        default: { unsigned PY_LONG_LONG x; memcpy(&x, ptr, 8); return (igraph_real_t)x; }
+      }
+
+    case IGRAPHMODULE_BUFFER_ITEM_FLOAT:
+      if (itemsize == sizeof(float)) {
+        float x; memcpy(&x, ptr, sizeof(float)); return x;
+      } else {
+        double x; memcpy(&x, ptr, sizeof(double)); return x;
+      }
+
+    case IGRAPHMODULE_BUFFER_ITEM_BOOL:
+      return *ptr ? 1 : 0;
+
+    default:
+      return 0;
+  }
+}
+
+/**
+ * \ingroup python_interface_conversion
+ * \brief Tries to convert a Python object exporting a one-dimensional numeric
+ *        buffer (e.g., a NumPy array or an \c array.array) to an igraph
+ *        \c igraph_vector_t
+ *
+ * Contiguous buffers of doubles are copied with a single \c memcpy(); other
+ * numeric buffers are converted item by item without creating Python
+ * objects. The incoming \c igraph_vector_t should be uninitialized.
+ *
+ * \param o the Python object to be converted
+ * \param v the \c igraph_vector_t containing the result
+ * \param need_integer if true, the items are truncated to integers and
+ *        checked against the range of \c igraph_integer_t
+ * \param need_non_negative if true, checks whether all elements are non-negative
+ * \return 0 if everything was OK, 1 if an error happened (an exception is
+ *         set in this case) and -1 if the object does not export a suitable
+ *         buffer. In the latter case, no exception is set and the vector is
+ *         left uninitialized.
+ */
+static int igraphmodule_i_buffer_to_vector_t(PyObject *o, igraph_vector_t *v,
+    igraph_bool_t need_integer, igraph_bool_t need_non_negative) {
+  Py_buffer buffer;
+  igraphmodule_buffer_item_kind_t kind;
+  Py_ssize_t i, n;
+  const char *ptr;
+  igraph_real_t value;
+
+  if (!PyObject_CheckBuffer(o))
+    return -1;
+
+  if (PyObject_GetBuffer(o, &buffer, PyBUF_STRIDES | PyBUF_FORMAT)) {
+    PyErr_Clear();
+    return -1;
+  }
+
+  kind = igraphmodule_buffer_item_kind(&buffer);
+  if (kind == IGRAPHMODULE_BUFFER_ITEM_UNSUPPORTED || buffer.ndim != 1) {
+    PyBuffer_Release(&buffer);
+    return -1;
+  }
+
+  n = buffer.shape[0];
+  if (igraph_vector_init(v, n)) {
+    igraphmodule_handle_igraph_error();
+    PyBuffer_Release(&buffer);
+    return 1;
+  }
+
+  if (kind == IGRAPHMODULE_BUFFER_ITEM_FLOAT && !need_integer &&
+      buffer.itemsize == sizeof(igraph_real_t) &&
+      buffer.strides[0] == sizeof(igraph_real_t)) {
+    memcpy(VECTOR(*v), buffer.buf, n * sizeof(igraph_real_t));
+    PyBuffer_Release(&buffer);
+    return 0;
+  }
+
+  ptr = (const char*)buffer.buf;
+  for (i = 0; i < n; i++, ptr += buffer.strides[0]) {
+    value = igraphmodule_buffer_item_as_real(ptr, kind, buffer.itemsize);
+
+    if (need_integer) {
+      if (value != value) {
+        PyErr_SetString(PyExc_ValueError, "cannot convert NaN to integer");
+        break;
+      }
+      if (value <= INT_MIN - 1.0) {
+        PyErr_SetString(PyExc_OverflowError,
+            "integer too small for conversion to C int");
+        break;
+      }
+      if (value >= INT_MAX + 1.0) {
+        PyErr_SetString(PyExc_OverflowError,
+            "integer too large for conversion to C int");
+        break;
+      }
+      /* truncate towards zero, just like int() would do */
+      value = (igraph_integer_t)value;
+      if (need_non_negative && value < 0) {
+        PyErr_SetString(PyExc_ValueError, "iterable must yield non-negative integers");
+        break;
+      }
+    }
+
+    VECTOR(*v)[i] = value;
+  }
+
+  PyBuffer_Release(&buffer);
+
+  if (i < n) {
+    igraph_vector_destroy(v);
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_conversion
+ * \brief Tries to convert a Python object exporting a two-dimensional numeric
+ *        buffer (e.g., a NumPy array) to an igraph \c igraph_matrix_t
+ *
+ * Fortran-contiguous buffers of doubles are copied with a single
+ * \c memcpy() as their layout matches the column-major layout of igraph;
+ * other numeric buffers are converted item by item without creating Python
+ * objects. The incoming \c igraph_matrix_t should be uninitialized.
+ *
+ * \return 0 if everything was OK, 1 if an error happened (an exception is
+ *         set in this case) and -1 if the object does not export a suitable
+ *         buffer. In the latter case, no exception is set and the matrix is
+ *         left uninitialized.
+ */
+static int igraphmodule_i_buffer_to_matrix_t(PyObject *o, igraph_matrix_t *m) {
+  Py_buffer buffer;
+  igraphmodule_buffer_item_kind_t kind;
+  Py_ssize_t i, j, nr, nc;
+  const char *ptr;
+
+  if (!PyObject_CheckBuffer(o))
+    return -1;
+
+  if (PyObject_GetBuffer(o, &buffer, PyBUF_STRIDES | PyBUF_FORMAT)) {
+    PyErr_Clear();
+    return -1;
+  }
+
+  kind = igraphmodule_buffer_item_kind(&buffer);
+  if (kind == IGRAPHMODULE_BUFFER_ITEM_UNSUPPORTED || buffer.ndim != 2) {
+    PyBuffer_Release(&buffer);
+    return -1;
+  }
+
+  nr = buffer.shape[0];
+  nc = buffer.shape[1];
+  if (igraph_matrix_init(m, nr, nc)) {
+    igraphmodule_handle_igraph_error();
+    PyBuffer_Release(&buffer);
+    return 1;
+  }
+
+  if (kind == IGRAPHMODULE_BUFFER_ITEM_FLOAT &&
+      buffer.itemsize == sizeof(igraph_real_t) &&
+      (nr <= 1 || buffer.strides[0] == sizeof(igraph_real_t)) &&
+      (nc <= 1 || buffer.strides[1] == nr * sizeof(igraph_real_t))) {
+    if (nr > 0 && nc > 0) {
+      memcpy(&MATRIX(*m, 0, 0), buffer.buf, nr * nc * sizeof(igraph_real_t));
+    }
+  } else {
+    for (j = 0; j < nc; j++) {
+      ptr = (const char*)buffer.buf + j * buffer.strides[1];
+      for (i = 0; i < nr; i++, ptr += buffer.strides[0]) {
+        MATRIX(*m, i, j) = igraphmodule_buffer_item_as_real(ptr, kind,
+            buffer.itemsize);
+      }
+    }
+  }
+
+  PyBuffer_Release(&buffer);
+  return 0;
+}
+
 /**
  * \ingroup python_interface_conversion
  * \brief Converts a Python object to an igraph \c igraph_vector_t
@@ -811,7 +1085,7 @@ int igraphmodule_PyObject_to_real_t(PyObject *object, igraph_real_t *v) {
 int igraphmodule_PyObject_to_vector_t(PyObject *list, igraph_vector_t *v, igraph_bool_t need_non_negative) {
   PyObject *item, *it;
   Py_ssize_t size_hint;
-  int ok;
+  int ok, retval;
   igraph_integer_t number;
 
   if (PyBaseString_Check(list)) {
@@ -821,6 +1095,12 @@ int igraphmodule_PyObject_to_vector_t(PyObject *list, igraph_vector_t *v, igraph
     return 1;
   }
 
+  /* objects exporting a numeric buffer (e.g., NumPy arrays) are converted
+   * without iterating over them */
+  retval = igraphmodule_i_buffer_to_vector_t(list, v, 1, need_non_negative);
+  if (retval >= 0)
+    return retval;
+
   /* if the list is a sequence, we can pre-allocate the vector to its length */
   if (PySequence_Check(list)) {
     size_hint = PySequence_Size(list);
@@ -913,7 +1193,7 @@ int igraphmodule_PyObject_to_vector_t(PyObject *list, igraph_vector_t *v, igraph
 int igraphmodule_PyObject_float_to_vector_t(PyObject *list, igraph_vector_t *v) {
   PyObject *item, *it;
   Py_ssize_t size_hint;
-  int ok;
+  int ok, retval;
   igraph_real_t number;
 
   if (PyBaseString_Check(list)) {
@@ -923,6 +1203,13 @@ int igraphmodule_PyObject_float_to_vector_t(PyObject *list, igraph_vector_t *v)
     return 1;
   }
 
+  /* objects exporting a numeric buffer (e.g., NumPy arrays) are converted
+   * without iterating over them; contiguous buffers of doubles are simply
+   * copied */
+  retval = igraphmodule_i_buffer_to_vector_t(list, v, 0, 0);
+  if (retval >= 0)
+    return retval;
+
   /* if the list is a sequence, we can pre-allocate the vector to its length */
   if (PySequence_Check(list)) {
     size_hint = PySequence_Size(list);
@@ -1592,7 +1879,9 @@ int igraphmodule_PyObject_to_edgelist(
  * edge or vertex weights. The function checks the given Python object. If
  * it is None, returns a null pointer instead of an \c igraph_vector_t.
  * If it is a sequence, it converts the sequence to a newly allocated
- * \c igraph_vector_t and return a pointer to it. Otherwise it interprets the
+ * \c igraph_vector_t and return a pointer to it. Objects exporting a
+ * numeric buffer (e.g., NumPy arrays) are copied without being iterated
+ * over. Otherwise it interprets the
  * object as an attribute name and returns the attribute values corresponding
  * to the name as an \c igraph_vector_t, or returns a null pointer if the attribute
  * does not exist.
@@ -1619,6 +1908,7 @@ int igraphmodule_attrib_to_vector_t(PyObject *o, igraphmodule_GraphObject *self,
     /* Check whether the attribute exists and is numeric */
     igraph_attribute_type_t at;
     igraph_attribute_elemtype_t et;
+    const igraph_vector_t *cached;
     long int n;
     char *name = PyString_CopyAsString(o);
 
@@ -1628,6 +1918,24 @@ int igraphmodule_attrib_to_vector_t(PyObject *o, igraphmodule_GraphObject *self,
     } else {
       et = IGRAPH_ATTRIBUTE_EDGE;
       n = igraph_ecount(&self->g);
+      /* Edge attributes used as weights are cached as C vectors until the
+       * attribute or the edge set is modified */
+      cached = igraphmodule_get_cached_edge_attribute_vector(&self->g, name);
+      if (cached != 0) {
+        free(name);
+        result = (igraph_vector_t*)calloc(1, sizeof(igraph_vector_t));
+        if (result==0) {
+          PyErr_NoMemory();
+          return 1;
+        }
+        if (igraph_vector_copy(result, cached)) {
+          igraphmodule_handle_igraph_error();
+          free(result);
+          return 1;
+        }
+        *vptr = result;
+        return 0;
+      }
     }
 
     if (igraphmodule_i_attribute_get_type(&self->g, &at, et, name)) {
@@ -1667,10 +1975,16 @@ int igraphmodule_attrib_to_vector_t(PyObject *o, igraphmodule_GraphObject *self,
         free(result);
         return 1;
       }
+      if (igraphmodule_cache_edge_attribute_vector(&self->g, name, result)) {
+        igraph_vector_destroy(result);
+        free(name);
+        free(result);
+        return 1;
+      }
     }
     free(name);
     *vptr = result;
-  } else if (PySequence_Check(o)) {
+  } else if (PySequence_Check(o) || PyObject_CheckBuffer(o)) {
     result = (igraph_vector_t*)calloc(1, sizeof(igraph_vector_t));
     if (result==0) {
       PyErr_NoMemory();
@@ -2060,6 +2374,48 @@ PyObject* igraphmodule_matrix_t_to_PyList(const igraph_matrix_t *m,
    return list;
 }
 
+/**
+ * \ingroup python_interface_conversion
+ * \brief Converts an igraph \c igraph_vector_t to a Python list or to a
+ *        buffer object, depending on the requested return type
+ *
+ * When a buffer is requested, the buffer takes over the storage of the
+ * vector without copying and the vector is left empty; it must still be
+ * destroyed by the caller.
+ *
+ * \param v the \c igraph_vector_t to be converted
+ * \param type the type of conversion if a list is requested
+ * \param return_type whether to return a list or a buffer
+ * \return the new Python object or \c NULL if an error occurred
+ */
+PyObject* igraphmodule_vector_t_to_PyObject(igraph_vector_t *v,
+    igraphmodule_conv_t type, igraphmodule_return_type_t return_type) {
+  if (return_type == IGRAPHMODULE_RETURN_BUFFER)
+    return igraphmodule_Buffer_from_vector_t(v);
+  return igraphmodule_vector_t_to_PyList(v, type);
+}
+
+/**
+ * \ingroup python_interface_conversion
+ * \brief Converts an igraph \c igraph_matrix_t to a Python list of lists or
+ *        to a buffer object, depending on the requested return type
+ *
+ * When a buffer is requested, the buffer takes over the storage of the
+ * matrix without copying and the matrix is left empty; it must still be
+ * destroyed by the caller.
+ *
+ * \param m the \c igraph_matrix_t to be converted
+ * \param type the type of conversion if a list is requested
+ * \param return_type whether to return a list or a buffer
+ * \return the new Python object or \c NULL if an error occurred
+ */
+PyObject* igraphmodule_matrix_t_to_PyObject(igraph_matrix_t *m,
+    igraphmodule_conv_t type, igraphmodule_return_type_t return_type) {
+  if (return_type == IGRAPHMODULE_RETURN_BUFFER)
+    return igraphmodule_Buffer_from_matrix_t(m);
+  return igraphmodule_matrix_t_to_PyList(m, type);
+}
+
 /**
  * \ingroup python_interface_conversion
  * \brief Converts an igraph \c igraph_vector_ptr_t to a Python list of lists
@@ -2093,6 +2449,9 @@ PyObject* igraphmodule_vector_ptr_t_to_PyList(const igraph_vector_ptr_t *v,
  * \ingroup python_interface_conversion
  * \brief Converts a Python list of lists to an \c igraph_matrix_t
  *
+ * Objects exporting a two-dimensional numeric buffer (e.g., NumPy arrays)
+ * are also accepted and converted without iterating over them.
+ *
  * \param o the Python object representing the list of lists
  * \param m the address of an uninitialized \c igraph_matrix_t
  * \return 0 if everything was OK, 1 otherwise. Sets appropriate exceptions.
@@ -2100,7 +2459,13 @@ PyObject* igraphmodule_vector_ptr_t_to_PyList(const igraph_vector_ptr_t *v,
 int igraphmodule_PyList_to_matrix_t(PyObject* o, igraph_matrix_t *m) {
   Py_ssize_t nr, nc, n, i, j;
   PyObject *row, *item;
-  int was_warned=0;
+  int was_warned=0, retval;
+
+  if (!PyBaseString_Check(o)) {
+    retval = igraphmodule_i_buffer_to_matrix_t(o, m);
+    if (retval >= 0)
+      return retval;
+  }
 
   /* calculate the matrix dimensions */
   if (!PySequence_Check(o) || PyString_Check(o)) {
@@ -2453,6 +2818,29 @@ int igraphmodule_PyObject_to_vid(PyObject *o, igraph_integer_t *vid, igraph_t *g
   return 0;
 }
 
+/**
+ * \ingroup python_interface_conversion
+ * \brief Checks whether a Python object is a non-empty list or tuple
+ *        containing strings only
+ */
+static igraph_bool_t igraphmodule_i_PySequence_is_all_strings(PyObject *o) {
+  Py_ssize_t i, n;
+
+  if (!PyList_Check(o) && !PyTuple_Check(o))
+    return 0;
+
+  n = PySequence_Fast_GET_SIZE(o);
+  if (n == 0)
+    return 0;
+
+  for (i = 0; i < n; i++) {
+    if (!PyBaseString_Check(PySequence_Fast_GET_ITEM(o, i)))
+      return 0;
+  }
+
+  return 1;
+}
+
 /**
  * \ingroup python_interface_conversion
  * \brief Tries to interpret a Python object as a vertex selector
@@ -2542,6 +2930,25 @@ int igraphmodule_PyObject_to_vs_t(PyObject *o, igraph_vs_t *vs,
     /* Clear the exception set by igraphmodule_PyObject_to_vid */
     PyErr_Clear();
 
+    if (graph != 0 && igraphmodule_i_PySequence_is_all_strings(o)) {
+      /* Lists and tuples of vertex names are looked up in one go */
+      IGRAPH_CHECK(igraph_vector_init(&vector, 0));
+      IGRAPH_FINALLY(igraph_vector_destroy, &vector);
+      if (igraphmodule_get_vertex_ids_by_name(graph, o, &vector)) {
+        igraph_vector_destroy(&vector);
+        IGRAPH_FINALLY_CLEAN(1);
+        return 1;
+      }
+      IGRAPH_CHECK(igraph_vs_vector_copy(vs, &vector));
+      igraph_vector_destroy(&vector);
+      IGRAPH_FINALLY_CLEAN(1);
+
+      if (return_single)
+        *return_single = 0;
+
+      return 0;
+    }
+
     iterator = PyObject_GetIter(o);
 
     if (iterator == NULL) {
@@ -2834,6 +3241,20 @@ int igraphmodule_PyObject_to_attribute_values(PyObject *o,
     }
   }
 
+  if (igraphmodule_Column_Check(list)) {
+    /* Typed columns: missing values are replaced by the default */
+    igraphmodule_ColumnObject* column = (igraphmodule_ColumnObject*)list;
+    n=column->size;
+    if (igraph_vector_init(v, n)) return 1;
+    for (i=0; i<n; i++) {
+      if (column->valid && !column->valid[i])
+        VECTOR(*v)[i] = def;
+      else
+        VECTOR(*v)[i] = igraphmodule_Column_get_real(column, i);
+    }
+    return 0;
+  }
+
   n=PyList_Size(list);
   if (igraph_vector_init(v, n)) return 1;
 
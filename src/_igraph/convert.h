@@ -36,6 +36,17 @@
 typedef enum { IGRAPHMODULE_TYPE_INT=0, IGRAPHMODULE_TYPE_FLOAT }
 igraphmodule_conv_t;
 
+typedef enum { IGRAPHMODULE_RETURN_LIST=0, IGRAPHMODULE_RETURN_BUFFER }
+igraphmodule_return_type_t;
+
+typedef enum {
+  IGRAPHMODULE_BUFFER_ITEM_UNSUPPORTED = 0,
+  IGRAPHMODULE_BUFFER_ITEM_SIGNED,
+  IGRAPHMODULE_BUFFER_ITEM_UNSIGNED,
+  IGRAPHMODULE_BUFFER_ITEM_FLOAT,
+  IGRAPHMODULE_BUFFER_ITEM_BOOL
+} igraphmodule_buffer_item_kind_t;
+
 typedef struct {
   const char* name;
   int value;
@@ -65,6 +76,7 @@ int igraphmodule_PyObject_to_neimode_t(PyObject *o, igraph_neimode_t *result);
 int igraphmodule_PyObject_to_pagerank_algo_t(PyObject *o, igraph_pagerank_algo_t *result);
 int igraphmodule_PyObject_to_random_walk_stuck_t(PyObject *o, igraph_random_walk_stuck_t *result);
 int igraphmodule_PyObject_to_reciprocity_t(PyObject *o, igraph_reciprocity_t *result);
+int igraphmodule_PyObject_to_return_type_t(PyObject *o, igraphmodule_return_type_t *result);
 int igraphmodule_PyObject_to_rewiring_t(PyObject *o, igraph_rewiring_t *result);
 int igraphmodule_PyObject_to_spinglass_implementation_t(PyObject *o, igraph_spinglass_implementation_t *result);
 int igraphmodule_PyObject_to_spincomm_update_t(PyObject *o, igraph_spincomm_update_t *result);
@@ -75,6 +87,12 @@ int igraphmodule_PyObject_to_transitivity_mode_t(PyObject *o, igraph_transitivit
 int igraphmodule_PyObject_to_tree_mode_t(PyObject *o, igraph_tree_mode_t *result);
 int igraphmodule_PyObject_to_vconn_nei_t(PyObject *o, igraph_vconn_nei_t *result);
 
+/* Reading items of objects supporting the buffer protocol */
+
+igraphmodule_buffer_item_kind_t igraphmodule_buffer_item_kind(const Py_buffer *buffer);
+igraph_real_t igraphmodule_buffer_item_as_real(const char *ptr,
+    igraphmodule_buffer_item_kind_t kind, Py_ssize_t itemsize);
+
 /* Conversion from PyObject to igraph types */
 
 int igraphmodule_PyObject_to_integer_t(PyObject *object, igraph_integer_t *v);
@@ -149,4 +167,8 @@ PyObject* igraphmodule_vector_int_t_to_PyList(const igraph_vector_int_t *v);
 PyObject* igraphmodule_vector_long_t_to_PyList(const igraph_vector_long_t *v);
 PyObject* igraphmodule_matrix_t_to_PyList(const igraph_matrix_t *m,
         igraphmodule_conv_t type);
+PyObject* igraphmodule_vector_t_to_PyObject(igraph_vector_t *v,
+        igraphmodule_conv_t type, igraphmodule_return_type_t return_type);
+PyObject* igraphmodule_matrix_t_to_PyObject(igraph_matrix_t *m,
+        igraphmodule_conv_t type, igraphmodule_return_type_t return_type);
 #endif
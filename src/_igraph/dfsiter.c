@@ -21,9 +21,11 @@
 */
 
 #include "dfsiter.h"
+#include "bufferobject.h"
 #include "common.h"
 #include "error.h"
 #include "py2compat.h"
+#include "threading.h"
 #include "vertexobject.h"
 
 /**
@@ -39,9 +41,14 @@ PyTypeObject igraphmodule_DFSIterType;
  * \param g the graph object being referenced
  * \param vid the root vertex index
  * \param advanced whether the iterator should be advanced (returning distance and parent as well)
+ * \param batch the number of vertices returned in one step as arrays, or
+ *   zero if the iterator should return one vertex at a time
+ * \param max_depth the distance from the root beyond which the search does
+ *   not proceed, or a negative number if the search is unlimited
  * \return the allocated PyObject
  */
-PyObject* igraphmodule_DFSIter_new(igraphmodule_GraphObject *g, PyObject *root, igraph_neimode_t mode, igraph_bool_t advanced) {
+PyObject* igraphmodule_DFSIter_new(igraphmodule_GraphObject *g, PyObject *root, igraph_neimode_t mode, igraph_bool_t advanced,
+    long int batch, long int max_depth) {
   igraphmodule_DFSIterObject* o;
   long int no_of_nodes, r;
 
@@ -66,8 +73,9 @@ PyObject* igraphmodule_DFSIter_new(igraphmodule_GraphObject *g, PyObject *root,
     PyErr_SetString(PyExc_MemoryError, "out of memory");
     return NULL;
   }
-  if (igraph_vector_init(&o->neis, 0)) {
-    PyErr_SetString(PyExc_MemoryError, "out of memory");
+  if (!igraph_is_directed(&g->g)) mode=IGRAPH_ALL;
+  o->adj = igraphmodule_acquire_adjacency(&g->g, mode);
+  if (o->adj == 0) {
     igraph_stack_destroy(&o->stack);
     return NULL;
   }
@@ -77,20 +85,24 @@ PyObject* igraphmodule_DFSIter_new(igraphmodule_GraphObject *g, PyObject *root,
   } else {
     r = ((igraphmodule_VertexObject*)root)->idx;
   }
-  /* push the root onto the stack */
+  /* push the root onto the stack; every entry on the stack consists of
+   * the vertex ID, its distance from the root, its parent and the index
+   * of the next neighbor to be checked */
   if (igraph_stack_push(&o->stack, r) ||
       igraph_stack_push(&o->stack, 0) ||
-      igraph_stack_push(&o->stack, -1)) {
+      igraph_stack_push(&o->stack, -1) ||
+      igraph_stack_push(&o->stack, 0)) {
     igraph_stack_destroy(&o->stack);
-    igraph_vector_destroy(&o->neis);
+    igraphmodule_adjacency_decref(o->adj);
     PyErr_SetString(PyExc_MemoryError, "out of memory");
     return NULL;
   }
   o->visited[r] = 1;
   
-  if (!igraph_is_directed(&g->g)) mode=IGRAPH_ALL;
   o->mode=mode;
   o->advanced=advanced;
+  o->batch=batch;
+  o->max_depth=max_depth;
   
   PyObject_GC_Track(o);
   
@@ -134,7 +146,8 @@ int igraphmodule_DFSIter_clear(igraphmodule_DFSIterObject *self) {
   Py_XDECREF(tmp);
 
   igraph_stack_destroy(&self->stack);
-  igraph_vector_destroy(&self->neis);
+  igraphmodule_adjacency_decref(self->adj);
+  self->adj = 0;
   free(self->visited);
   self->visited = 0;
   
@@ -158,68 +171,150 @@ PyObject* igraphmodule_DFSIter_iter(igraphmodule_DFSIterObject* self) {
   return (PyObject*)self;
 }
 
+/**
+ * \ingroup python_interface_dfsiter
+ * \brief Returns the vertex on the top of the stack and advances the search
+ *        to the next unvisited vertex.
+ *
+ * The entries on the stack remember where the scan of their neighbor lists
+ * stopped, so every neighbor list is scanned only once. Does not touch the
+ * Python API, so it may be called without the GIL.
+ *
+ * \return 0 if everything was OK, an igraph error code otherwise
+ */
+static int igraphmodule_i_DFSIter_step(igraphmodule_DFSIterObject* self,
+    igraph_integer_t *vid_out, igraph_integer_t *dist_out,
+    igraph_integer_t *parent_out) {
+  long int size = igraph_stack_size(&self->stack);
+
+  /* the top of the stack is returned, but it stays on the stack until the
+   * whole subtree below it has been found */
+  *vid_out = (igraph_integer_t)self->stack.stor_begin[size-4];
+  *dist_out = (igraph_integer_t)self->stack.stor_begin[size-3];
+  *parent_out = (igraph_integer_t)self->stack.stor_begin[size-2];
+
+  /* look for an unvisited neighbor of the vertex on the top of the stack
+   * until we have found one or until we have exhausted the stack */
+  while (!igraph_stack_empty(&self->stack)) {
+    long int pos = (long int)igraph_stack_pop(&self->stack);
+    igraph_integer_t parent = (igraph_integer_t)igraph_stack_pop(&self->stack);
+    igraph_integer_t dist = (igraph_integer_t)igraph_stack_pop(&self->stack);
+    igraph_integer_t vid = (igraph_integer_t)igraph_stack_pop(&self->stack);
+    const long int *neis = self->adj->neighbors + self->adj->offsets[(long int)vid];
+    long int n = 0;
+
+    if (self->max_depth < 0 || dist < self->max_depth) {
+      n = IGRAPHMODULE_ADJACENCY_DEGREE(self->adj, (long int)vid);
+      while (pos < n && self->visited[neis[pos]])
+        pos++;
+    }
+
+    if (pos < n) {
+      /* new neighbor, put the current vertex back and push the neighbor
+       * on top of it */
+      igraph_integer_t neighbor = (igraph_integer_t)neis[pos];
+      self->visited[neighbor] = 1;
+      IGRAPH_CHECK(igraph_stack_push(&self->stack, vid));
+      IGRAPH_CHECK(igraph_stack_push(&self->stack, dist));
+      IGRAPH_CHECK(igraph_stack_push(&self->stack, parent));
+      IGRAPH_CHECK(igraph_stack_push(&self->stack, pos+1));
+      IGRAPH_CHECK(igraph_stack_push(&self->stack, neighbor));
+      IGRAPH_CHECK(igraph_stack_push(&self->stack, dist+1));
+      IGRAPH_CHECK(igraph_stack_push(&self->stack, vid));
+      IGRAPH_CHECK(igraph_stack_push(&self->stack, 0));
+      break;
+    }
+
+    /* no new neighbors, end of subtree; the entry stays off the stack */
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_dfsiter
+ * \brief Returns the next batch of visited vertices as a tuple of three
+ *        buffers holding the vertex IDs, the distances and the parents.
+ *
+ * The traversal itself runs without the GIL.
+ */
+static PyObject* igraphmodule_i_DFSIter_next_batch(igraphmodule_DFSIterObject* self) {
+  igraph_vector_t vids, dists, parents;
+  igraph_integer_t vid, dist, parent;
+  PyObject *vids_o, *dists_o, *parents_o;
+  long int n = 0, size = self->batch;
+  int retval = 0;
+
+  if (size > igraph_vcount(self->graph))
+    size = igraph_vcount(self->graph);
+
+  if (igraph_vector_init(&vids, size))
+    return igraphmodule_handle_igraph_error();
+  if (igraph_vector_init(&dists, size)) {
+    igraph_vector_destroy(&vids);
+    return igraphmodule_handle_igraph_error();
+  }
+  if (igraph_vector_init(&parents, size)) {
+    igraph_vector_destroy(&vids); igraph_vector_destroy(&dists);
+    return igraphmodule_handle_igraph_error();
+  }
+
+  IGRAPHMODULE_BEGIN_NOGIL(self->gref);
+  while (n < size && !igraph_stack_empty(&self->stack)) {
+    retval = igraphmodule_i_DFSIter_step(self, &vid, &dist, &parent);
+    if (retval)
+      break;
+    VECTOR(vids)[n] = vid;
+    VECTOR(dists)[n] = dist;
+    VECTOR(parents)[n] = parent;
+    n++;
+  }
+  IGRAPHMODULE_END_NOGIL(self->gref);
+
+  if (retval) {
+    igraphmodule_handle_igraph_error();
+    igraph_vector_destroy(&vids); igraph_vector_destroy(&dists);
+    igraph_vector_destroy(&parents);
+    return NULL;
+  }
+
+  igraph_vector_resize(&vids, n);     /* shrinking never fails */
+  igraph_vector_resize(&dists, n);
+  igraph_vector_resize(&parents, n);
+
+  vids_o = igraphmodule_Buffer_from_vector_t(&vids);
+  dists_o = vids_o ? igraphmodule_Buffer_from_vector_t(&dists) : 0;
+  parents_o = dists_o ? igraphmodule_Buffer_from_vector_t(&parents) : 0;
+  igraph_vector_destroy(&vids); igraph_vector_destroy(&dists);
+  igraph_vector_destroy(&parents);
+
+  if (parents_o == 0) {
+    Py_XDECREF(vids_o);
+    Py_XDECREF(dists_o);
+    return NULL;
+  }
+
+  return Py_BuildValue("NNN", vids_o, dists_o, parents_o);
+}
+
 PyObject* igraphmodule_DFSIter_iternext(igraphmodule_DFSIterObject* self) {
-  /* the design is to return the top of the stack and then proceed until
-   * we have found an unvisited neighbor and push that on top */
   igraph_integer_t parent_out, dist_out, vid_out;
-  igraph_bool_t any = 0;
+  PyObject *vertexobj;
 
   /* nothing on the stack, end of iterator */
   if(igraph_stack_empty(&self->stack)) {
     return NULL;
   }
 
-  /* peek at the top element on the stack
-   * because we save three things, pop 3 in inverse order and push them back */
-  parent_out = (igraph_integer_t)igraph_stack_pop(&self->stack);
-  dist_out = (igraph_integer_t)igraph_stack_pop(&self->stack);
-  vid_out = (igraph_integer_t)igraph_stack_pop(&self->stack);
-  igraph_stack_push(&self->stack, (long int) vid_out);
-  igraph_stack_push(&self->stack, (long int) dist_out);
-  igraph_stack_push(&self->stack, (long int) parent_out);
-
-  /* look for neighbors until you found one or until you have exausted the graph */
-  while (!any && !igraph_stack_empty(&self->stack)) {
-    igraph_integer_t parent = (igraph_integer_t)igraph_stack_pop(&self->stack);
-    igraph_integer_t dist = (igraph_integer_t)igraph_stack_pop(&self->stack);
-    igraph_integer_t vid = (igraph_integer_t)igraph_stack_pop(&self->stack);
-    igraph_stack_push(&self->stack, (long int) vid);
-    igraph_stack_push(&self->stack, (long int) dist);
-    igraph_stack_push(&self->stack, (long int) parent);
-    long int i;
-    /* the values above are returned at at this stage. However, we must
-     * prepare for the next iteration by putting the next unvisited
-     * neighbor onto the stack */
-    if (igraph_neighbors(self->graph, &self->neis, vid, self->mode)) {
-      igraphmodule_handle_igraph_error();
-      return NULL;
-    }
-    for (i=0; i<igraph_vector_size(&self->neis); i++) {
-      igraph_integer_t neighbor = (igraph_integer_t)VECTOR(self->neis)[i];
-      /* new neighbor, push the next item onto the stack */
-      if (self->visited[neighbor] == 0) {
-        any = 1;
-        self->visited[neighbor]=1;
-        if (igraph_stack_push(&self->stack, neighbor) ||
-            igraph_stack_push(&self->stack, dist+1) ||
-            igraph_stack_push(&self->stack, vid)) {
-          igraphmodule_handle_igraph_error();
-          return NULL;
-        }
-        break;
-      }
-    }
-    /* no new neighbors, end of subtree */
-    if (!any) {
-       igraph_stack_pop(&self->stack);
-       igraph_stack_pop(&self->stack);
-       igraph_stack_pop(&self->stack);
-    }
+  if (self->batch > 0)
+    return igraphmodule_i_DFSIter_next_batch(self);
+
+  if (igraphmodule_i_DFSIter_step(self, &vid_out, &dist_out, &parent_out)) {
+    igraphmodule_handle_igraph_error();
+    return NULL;
   }
 
-  /* no matter what the stack situation is: that is a worry for the next cycle
-   * now just return the top of the stack as it was at the function entry */
-  PyObject *vertexobj = igraphmodule_Vertex_New(self->gref, vid_out);
+  vertexobj = igraphmodule_Vertex_New(self->gref, vid_out);
   if (self->advanced) {
     PyObject *parentobj;
     if (!vertexobj)
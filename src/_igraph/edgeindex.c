@@ -0,0 +1,181 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#include "edgeindex.h"
+#include <stdlib.h>
+
+/* Vertex IDs are packed into the two halves of a 64-bit key */
+#define IGRAPHMODULE_EDGE_INDEX_MAX_NODES 0xffffffffUL
+
+/**
+ * \ingroup python_interface_edgeindex
+ * \brief Mixes the bits of a key (SplitMix64 finalizer)
+ */
+static unsigned long long int igraphmodule_i_edge_index_hash(unsigned long long int z) {
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+static unsigned long long int igraphmodule_i_edge_index_key(
+    const igraphmodule_edge_index_t* index, long int from, long int to) {
+  long int tmp;
+
+  if (!index->directed && from > to) {
+    tmp = from; from = to; to = tmp;
+  }
+
+  return ((unsigned long long int) from << 32) | (unsigned long long int) to;
+}
+
+/**
+ * \ingroup python_interface_edgeindex
+ * \brief Returns whether an edge index can be built for the given graph
+ */
+int igraphmodule_edge_index_supported(const igraph_t* graph) {
+  return igraph_vcount(graph) <= IGRAPHMODULE_EDGE_INDEX_MAX_NODES;
+}
+
+/**
+ * \ingroup python_interface_edgeindex
+ * \brief Builds the edge index of a graph
+ *
+ * The table is kept at most half full so that lookups of missing pairs
+ * (which probe until an empty slot) stay short.
+ *
+ * \param graph the graph
+ * \param index the new index is returned here; it must be freed with
+ *        \ref igraphmodule_edge_index_destroy()
+ * \return \c IGRAPH_SUCCESS, \c IGRAPH_ENOMEM if there was not enough
+ *         memory or \c IGRAPH_EINVAL if the graph has too many vertices
+ */
+int igraphmodule_edge_index_build(const igraph_t* graph,
+    igraphmodule_edge_index_t** index) {
+  igraphmodule_edge_index_t* result;
+  igraphmodule_edge_index_slot_t* slot;
+  unsigned long long int size = 16, key, i;
+  long int e, no_of_edges = igraph_ecount(graph);
+
+  *index = 0;
+
+  if (!igraphmodule_edge_index_supported(graph))
+    return IGRAPH_EINVAL;
+
+  while (size < 2 * (unsigned long long int) no_of_edges)
+    size <<= 1;
+
+  result = (igraphmodule_edge_index_t*) malloc(sizeof(igraphmodule_edge_index_t));
+  if (result == 0)
+    return IGRAPH_ENOMEM;
+
+  result->slots = (igraphmodule_edge_index_slot_t*) malloc(
+      (size_t) size * sizeof(igraphmodule_edge_index_slot_t));
+  if (result->slots == 0) {
+    free(result);
+    return IGRAPH_ENOMEM;
+  }
+
+  result->directed = igraph_is_directed(graph);
+  result->mask = size - 1;
+  for (i = 0; i < size; i++) {
+    result->slots[i].eid = -1;
+  }
+
+  /* Edges are inserted in increasing order of their IDs and existing keys
+   * are kept, so multiple edges resolve to the lowest ID */
+  for (e = 0; e < no_of_edges; e++) {
+    key = igraphmodule_i_edge_index_key(result,
+        (long int) VECTOR(graph->from)[e], (long int) VECTOR(graph->to)[e]);
+    i = igraphmodule_i_edge_index_hash(key) & result->mask;
+    for (slot = &result->slots[i]; slot->eid >= 0 && slot->key != key;
+         slot = &result->slots[i]) {
+      i = (i + 1) & result->mask;
+    }
+    if (slot->eid < 0) {
+      slot->key = key;
+      slot->eid = e;
+    }
+  }
+
+  *index = result;
+  return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup python_interface_edgeindex
+ * \brief Frees an edge index; a null pointer is ignored
+ */
+void igraphmodule_edge_index_destroy(igraphmodule_edge_index_t* index) {
+  if (index) {
+    free(index->slots);
+    free(index);
+  }
+}
+
+static long int igraphmodule_i_edge_index_find(const igraphmodule_edge_index_t* index,
+    long int from, long int to) {
+  unsigned long long int key = igraphmodule_i_edge_index_key(index, from, to);
+  unsigned long long int i = igraphmodule_i_edge_index_hash(key) & index->mask;
+  const igraphmodule_edge_index_slot_t* slot;
+
+  for (slot = &index->slots[i]; slot->eid >= 0; slot = &index->slots[i]) {
+    if (slot->key == key)
+      return slot->eid;
+    i = (i + 1) & index->mask;
+  }
+
+  return -1;
+}
+
+/**
+ * \ingroup python_interface_edgeindex
+ * \brief Looks up the lowest ID of the edges between two vertices
+ *
+ * The vertex IDs must be valid. Just like \c igraph_get_eid(), undirected
+ * lookups in a directed graph try the edges from \p from to \p to first.
+ *
+ * \param directed whether to consider the direction of the edges in
+ *        directed graphs
+ * \return the ID of the edge or -1 if the vertices are not connected
+ */
+long int igraphmodule_edge_index_lookup(const igraphmodule_edge_index_t* index,
+    long int from, long int to, igraph_bool_t directed) {
+  long int eid = igraphmodule_i_edge_index_find(index, from, to);
+
+  if (eid < 0 && index->directed && !directed)
+    eid = igraphmodule_i_edge_index_find(index, to, from);
+
+  return eid;
+}
+
+/**
+ * \ingroup python_interface_edgeindex
+ * \brief Returns the number of bytes used by an edge index
+ */
+size_t igraphmodule_edge_index_bytes(const igraphmodule_edge_index_t* index) {
+  if (index == 0)
+    return 0;
+  return sizeof(igraphmodule_edge_index_t) +
+    (size_t) (index->mask + 1) * sizeof(igraphmodule_edge_index_slot_t);
+}
@@ -0,0 +1,70 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#ifndef PYTHON_EDGEINDEX_H
+#define PYTHON_EDGEINDEX_H
+
+#include <igraph.h>
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_edgeindex Hashed edge lookup
+ *
+ * The C core finds the edge between two vertices by a binary search in the
+ * incidence list of one of them, which is slow for hub vertices when
+ * millions of pairs are looked up. The edge index maps every ordered pair
+ * of endpoints (the smaller one first in undirected graphs) to the lowest
+ * ID of the edges between them in an open-addressing hash table.
+ *
+ * The index is built on demand and kept in the attribute table of the
+ * graph; adding, deleting or permuting edges drops it. None of the
+ * functions below touch Python objects, so they may be called without
+ * holding the GIL.
+ */
+
+/**
+ * \ingroup python_interface_edgeindex
+ * \brief A slot of the hash table; \c eid is -1 for empty slots
+ */
+typedef struct {
+  unsigned long long int key;
+  long int eid;
+} igraphmodule_edge_index_slot_t;
+
+typedef struct igraphmodule_edge_index_s {
+  igraph_bool_t directed;
+  // Number of slots minus one; the number of slots is a power of two
+  unsigned long long int mask;
+  igraphmodule_edge_index_slot_t* slots;
+} igraphmodule_edge_index_t;
+
+int igraphmodule_edge_index_supported(const igraph_t* graph);
+int igraphmodule_edge_index_build(const igraph_t* graph,
+    igraphmodule_edge_index_t** index);
+void igraphmodule_edge_index_destroy(igraphmodule_edge_index_t* index);
+long int igraphmodule_edge_index_lookup(const igraphmodule_edge_index_t* index,
+    long int from, long int to, igraph_bool_t directed);
+size_t igraphmodule_edge_index_bytes(const igraphmodule_edge_index_t* index);
+
+#endif
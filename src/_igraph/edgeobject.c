@@ -23,6 +23,7 @@
 */
 
 #include "attributes.h"
+#include "columnobject.h"
 #include "edgeobject.h"
 #include "error.h"
 #include "graphobject.h"
@@ -37,6 +38,15 @@
 
 PyTypeObject igraphmodule_EdgeType;
 
+/**
+ * \ingroup python_interface_edge
+ * \brief Edge objects released recently, kept for reuse by
+ *        \c igraphmodule_Edge_New() like the vertices in vertexobject.c
+ */
+#define IGRAPHMODULE_EDGE_FREELIST_MAX_SIZE 256
+static igraphmodule_EdgeObject* igraphmodule_i_edge_freelist[IGRAPHMODULE_EDGE_FREELIST_MAX_SIZE];
+static int igraphmodule_i_edge_freelist_size = 0;
+
 /**
  * \ingroup python_interface_edge
  * \brief Checks whether the given Python object is an edge
@@ -101,7 +111,12 @@ int igraphmodule_Edge_Validate(PyObject* obj) {
  */
 PyObject* igraphmodule_Edge_New(igraphmodule_GraphObject *gref, igraph_integer_t idx) {
   igraphmodule_EdgeObject* self;
-  self=PyObject_New(igraphmodule_EdgeObject, &igraphmodule_EdgeType);
+  if (igraphmodule_i_edge_freelist_size > 0) {
+    self = igraphmodule_i_edge_freelist[--igraphmodule_i_edge_freelist_size];
+    (void) PyObject_INIT(self, &igraphmodule_EdgeType);
+  } else {
+    self=PyObject_New(igraphmodule_EdgeObject, &igraphmodule_EdgeType);
+  }
   if (self) {
     RC_ALLOC("Edge", self);
     Py_INCREF(gref);
@@ -135,9 +150,25 @@ void igraphmodule_Edge_dealloc(igraphmodule_EdgeObject* self) {
 
   RC_DEALLOC("Edge", self);
 
+  /* Instances of subclasses are larger, they cannot be recycled */
+  if (Py_TYPE(self) == &igraphmodule_EdgeType &&
+      igraphmodule_i_edge_freelist_size < IGRAPHMODULE_EDGE_FREELIST_MAX_SIZE) {
+    igraphmodule_i_edge_freelist[igraphmodule_i_edge_freelist_size++] = self;
+    return;
+  }
+
   PyObject_Del((PyObject*)self);
 }
 
+/**
+ * \ingroup python_interface_edge
+ * \brief Releases the memory of the edge objects kept for reuse
+ */
+void igraphmodule_Edge_clear_freelist(void) {
+  while (igraphmodule_i_edge_freelist_size > 0)
+    PyObject_Del((PyObject*)igraphmodule_i_edge_freelist[--igraphmodule_i_edge_freelist_size]);
+}
+
 /** \ingroup python_interface_edge
  * \brief Formats an \c igraph.Edge object as a string
  * 
@@ -300,10 +331,10 @@ PyObject* igraphmodule_Edge_attributes(igraphmodule_EdgeObject* self) {
       PyObject *dictit;
       dictit = PyDict_GetItem(((PyObject**)o->g.attr)[ATTRHASH_IDX_EDGE], name);
       if (dictit) {
-        PyObject *value = PyList_GetItem(dictit, self->idx);
+        PyObject *value = igraphmodule_attribute_values_get_item(dictit, self->idx);
         if (value) {
-          /* no need to Py_INCREF, PyDict_SetItem will do that */
           PyDict_SetItem(dict, name, value);
+          Py_DECREF(value);
         }
       }
     }
@@ -345,14 +376,13 @@ PyObject* igraphmodule_Edge_get_attribute(igraphmodule_EdgeObject* self,
 
   result=PyDict_GetItem(((PyObject**)o->g.attr)[2], s);
   if (result) {
-    /* result is a list, so get the element with index self->idx */
-    if (!PyList_Check(result)) {
+    /* result is a list or a typed column, so get the element with index
+     * self->idx */
+    if (!PyList_Check(result) && !igraphmodule_Column_Check(result)) {
       PyErr_SetString(igraphmodule_InternalError, "Edge attribute dict member is not a list");
       return NULL;
     }
-    result=PyList_GetItem(result, self->idx);
-    Py_INCREF(result);
-    return result;
+    return igraphmodule_attribute_values_get_item(result, self->idx);
   }
   
   /* result is NULL, check whether there was an error */
@@ -379,23 +409,26 @@ int igraphmodule_Edge_set_attribute(igraphmodule_EdgeObject* self, PyObject* k,
   if (!igraphmodule_attribute_name_check(k))
     return -1;
 
+  igraphmodule_invalidate_edge_attribute_vector_cache(&o->g, k);
+
   if (v==NULL)
     // we are deleting attribute
     return PyDict_DelItem(((PyObject**)o->g.attr)[2], k);
   
   result=PyDict_GetItem(((PyObject**)o->g.attr)[2], k);
   if (result) {
-    /* result is a list, so set the element with index self->idx */
-    if (!PyList_Check(result)) {
-      PyErr_SetString(igraphmodule_InternalError, "Vertex attribute dict member is not a list");
+    /* result is a list or a typed column, so set the element with index
+     * self->idx */
+    if (!PyList_Check(result) && !igraphmodule_Column_Check(result)) {
+      PyErr_SetString(igraphmodule_InternalError, "Edge attribute dict member is not a list");
       return -1;
     }
     /* we actually don't own a reference here to v, so we must increase
      * its reference count, because PyList_SetItem will "steal" a reference!
      * It took me 1.5 hours between London and Manchester to figure it out */
     Py_INCREF(v);
-    r=PyList_SetItem(result, self->idx, v);
-    if (r == -1) { Py_DECREF(v); }
+    r=igraphmodule_attribute_values_set_item(((PyObject**)o->g.attr)[2], k,
+        &result, self->idx, v);
     return r;
   }
   
@@ -40,6 +40,7 @@ typedef struct {
 
 int igraphmodule_Edge_clear(igraphmodule_EdgeObject *self);
 void igraphmodule_Edge_dealloc(igraphmodule_EdgeObject* self);
+void igraphmodule_Edge_clear_freelist(void);
 
 int igraphmodule_Edge_Check(PyObject *obj);
 int igraphmodule_Edge_Validate(PyObject *obj);
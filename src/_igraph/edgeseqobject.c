@@ -23,6 +23,7 @@
 */
 
 #include "attributes.h"
+#include "columnobject.h"
 #include "common.h"
 #include "convert.h"
 #include "edgeseqobject.h"
@@ -273,15 +274,7 @@ PyObject* igraphmodule_EdgeSeq_get_attribute_values(igraphmodule_EdgeSeqObject*
       break;
 
     case IGRAPH_ES_ALL:
-      n = PyList_Size(values);
-      result = PyList_New(n);
-      if (!result) return 0;
-
-      for (i=0; i<n; i++) {
-          item = PyList_GET_ITEM(values, i);
-          Py_INCREF(item);
-          PyList_SET_ITEM(result, i, item);
-      }
+      result = igraphmodule_attribute_values_to_list(values);
       break;
 
     case IGRAPH_ES_VECTOR:
@@ -291,8 +284,12 @@ PyObject* igraphmodule_EdgeSeq_get_attribute_values(igraphmodule_EdgeSeqObject*
       if (!result) return 0;
 
       for (i=0; i<n; i++) {
-        item = PyList_GET_ITEM(values, (long)VECTOR(*self->es.data.vecptr)[i]);
-        Py_INCREF(item);
+        item = igraphmodule_attribute_values_get_item(values,
+            (long)VECTOR(*self->es.data.vecptr)[i]);
+        if (!item) {
+          Py_DECREF(result);
+          return 0;
+        }
         PyList_SET_ITEM(result, i, item);
       }
       break;
@@ -303,8 +300,12 @@ PyObject* igraphmodule_EdgeSeq_get_attribute_values(igraphmodule_EdgeSeqObject*
       if (!result) return 0;
 
       for (i=0; i<n; i++) {
-        item = PyList_GET_ITEM(values, (long)self->es.data.seq.from+i);
-        Py_INCREF(item);
+        item = igraphmodule_attribute_values_get_item(values,
+            (long)self->es.data.seq.from+i);
+        if (!item) {
+          Py_DECREF(result);
+          return 0;
+        }
         PyList_SET_ITEM(result, i, item);
       }
       break;
@@ -322,6 +323,45 @@ PyObject* igraphmodule_EdgeSeq_is_all(igraphmodule_EdgeSeqObject* self) {
   Py_RETURN_FALSE;
 }
 
+/** \ingroup python_interface_edgeseq
+ * \brief Returns the typed column storing a given attribute, converting the
+ *        attribute to a typed column first if needed
+ */
+PyObject* igraphmodule_EdgeSeq_get_attribute_column(igraphmodule_EdgeSeqObject* self, PyObject* o) {
+  igraphmodule_GraphObject *gr = self->gref;
+  PyObject *dict, *values, *column;
+
+  if (!igraphmodule_attribute_name_check(o))
+    return 0;
+
+  dict = ATTR_STRUCT_DICT(&gr->g)[ATTRHASH_IDX_EDGE];
+  values = PyDict_GetItem(dict, o);
+  if (!values) {
+    PyErr_SetString(PyExc_KeyError, "Attribute does not exist");
+    return NULL;
+  }
+
+  if (igraphmodule_Column_Check(values)) {
+    Py_INCREF(values);
+    return values;
+  }
+
+  column = igraphmodule_Column_from_list(values);
+  if (!column) {
+    if (!PyErr_Occurred())
+      PyErr_SetString(PyExc_TypeError, "attribute values must be all "
+          "numbers, all booleans or None to be stored in a typed column");
+    return NULL;
+  }
+
+  if (PyDict_SetItem(dict, o, column)) {
+    Py_DECREF(column);
+    return NULL;
+  }
+
+  return column;
+}
+
 PyObject* igraphmodule_EdgeSeq_get_attribute_values_mapping(igraphmodule_EdgeSeqObject *self, PyObject *o) {
   Py_ssize_t index;
 
@@ -365,6 +405,8 @@ int igraphmodule_EdgeSeq_set_attribute_values_mapping(igraphmodule_EdgeSeqObject
   if (!igraphmodule_attribute_name_check(attrname))
     return -1;
 
+  igraphmodule_invalidate_edge_attribute_vector_cache(&gr->g, attrname);
+
   if (values == 0) {
     if (igraph_es_type(&self->es) == IGRAPH_ES_ALL)
       return PyDict_DelItem(dict, attrname);
@@ -372,6 +414,23 @@ int igraphmodule_EdgeSeq_set_attribute_values_mapping(igraphmodule_EdgeSeqObject
     return -1;
   }
 
+  if (igraph_es_type(&self->es) == IGRAPH_ES_ALL) {
+    /* One-dimensional numeric buffers (e.g., NumPy arrays) spanning all the
+     * edges are stored in a typed column instead of a list */
+    PyObject *column;
+    int retval = igraphmodule_Column_from_buffer(values, &column);
+    if (retval == 1)
+      return -1;
+    if (retval == 0) {
+      if (((igraphmodule_ColumnObject*)column)->size == (long)igraph_ecount(&gr->g)) {
+        retval = PyDict_SetItem(dict, attrname, column);
+        Py_DECREF(column);
+        return retval;
+      }
+      Py_DECREF(column);
+    }
+  }
+
  if (PyString_Check(values) || !PySequence_Check(values)) {
     /* If values is a string or not a sequence, we construct a list with a
      * single element (the value itself) and then call ourselves again */
@@ -395,8 +454,11 @@ int igraphmodule_EdgeSeq_set_attribute_values_mapping(igraphmodule_EdgeSeqObject
       return -1;
     }
 
-    /* Check if we already have attributes with the given name */
+    /* Check if we already have attributes with the given name. Typed columns
+     * are replaced with a list; the values may not fit into the column */
     list = PyDict_GetItem(dict, attrname);
+    if (list != 0 && igraphmodule_Column_Check(list))
+      list = 0;
     if (list != 0) {
       /* Yes, we have. Modify its items to the items found in values */
       for (i=0, j=0; i<no_of_edges; i++, j++) {
@@ -455,11 +517,11 @@ int igraphmodule_EdgeSeq_set_attribute_values_mapping(igraphmodule_EdgeSeqObject
         item = PySequence_GetItem(values, j);
         if (item == 0) { igraph_vector_destroy(&es); return -1; }
         /* No need to Py_INCREF(item), PySequence_GetItem returns a new reference */
-        if (PyList_SetItem(list, (long)VECTOR(es)[i], item)) {
-          Py_DECREF(item);
+        if (igraphmodule_attribute_values_set_item(dict, attrname, &list,
+              (long)VECTOR(es)[i], item)) {
           igraph_vector_destroy(&es);
           return -1;
-        } /* PyList_SetItem stole a reference to the item automatically */
+        } /* the reference to the item was stolen automatically */
       }
       igraph_vector_destroy(&es);
     } else if (values != 0) {
@@ -790,6 +852,66 @@ PyObject* igraphmodule_EdgeSeq_select(igraphmodule_EdgeSeqObject *self, PyObject
 }
 
 
+/**
+ * \ingroup python_interface_edgeseq
+ * \brief Selects the edges of the sequence whose attribute values match a
+ *        condition, e.g., <tt>weight_gt=50</tt> in \c EdgeSeq.select()
+ */
+PyObject* igraphmodule_EdgeSeq_select_by_attribute(igraphmodule_EdgeSeqObject *self,
+  PyObject *args) {
+  igraphmodule_EdgeSeqObject *result;
+  igraphmodule_GraphObject *gr = self->gref;
+  PyObject *name, *op, *value, *values;
+  igraph_vector_t ids;
+
+  if (!PyArg_ParseTuple(args, "OOO", &name, &op, &value))
+    return NULL;
+
+  if (!igraphmodule_attribute_name_check(name))
+    return NULL;
+
+  values = PyDict_GetItem(ATTR_STRUCT_DICT(&gr->g)[ATTRHASH_IDX_EDGE], name);
+  if (!values) {
+    PyErr_SetString(PyExc_KeyError, "Attribute does not exist");
+    return NULL;
+  }
+
+  if (igraph_vector_init(&ids, 0)) {
+    igraphmodule_handle_igraph_error();
+    return NULL;
+  }
+  if (igraph_es_as_vector(&gr->g, self->es, &ids)) {
+    igraphmodule_handle_igraph_error();
+    igraph_vector_destroy(&ids);
+    return NULL;
+  }
+
+  /* The values are evaluated on the current members of the sequence only,
+   * so chained filters narrow down the same index vector */
+  if (igraphmodule_attribute_values_filter(values, &ids, op, value)) {
+    igraph_vector_destroy(&ids);
+    return NULL;
+  }
+
+  result = igraphmodule_EdgeSeq_copy(self);
+  if (result == 0) {
+    igraph_vector_destroy(&ids);
+    return NULL;
+  }
+
+  igraph_es_destroy(&result->es);
+  if (igraph_es_vector_copy(&result->es, &ids)) {
+    igraph_es_none(&result->es);
+    Py_DECREF(result);
+    igraphmodule_handle_igraph_error();
+    igraph_vector_destroy(&ids);
+    return NULL;
+  }
+  igraph_vector_destroy(&ids);
+
+  return (PyObject*)result;
+}
+
 /**
  * \ingroup python_interface_edgeseq
  * Method table for the \c igraph.EdgeSeq object
@@ -805,6 +927,21 @@ PyMethodDef igraphmodule_EdgeSeq_methods[] = {
    "find(condition) -> Edge\n\n"
    "For internal use only.\n"
   },
+  {"get_attribute_column", (PyCFunction)igraphmodule_EdgeSeq_get_attribute_column,
+   METH_O,
+   "get_attribute_column(attrname) -> AttributeColumn\n\n"
+   "Returns the typed column that stores the values of a given edge\n"
+   "attribute for all edges.\n\n"
+   "Numeric and boolean attributes may be stored in a contiguous typed\n"
+   "column instead of a list. Attributes assigned from one-dimensional\n"
+   "numeric buffers (e.g., NumPy arrays) are stored this way automatically;\n"
+   "this method converts attributes stored in a list on demand. The column\n"
+   "supports the buffer protocol, so it can be wrapped without copying,\n"
+   "e.g., by C{numpy.asarray()} or C{memoryview()}. The exported buffer is\n"
+   "read-only; assigning new values to the attribute works as usual.\n\n"
+   "@param attrname: the name of the attribute\n"
+   "@return: an L{AttributeColumn} object\n"
+  },
   {"get_attribute_values", (PyCFunction)igraphmodule_EdgeSeq_get_attribute_values,
    METH_O,
    "get_attribute_values(attrname) -> list\n\n"
@@ -829,6 +966,14 @@ PyMethodDef igraphmodule_EdgeSeq_methods[] = {
    "select(...) -> VertexSeq\n\n"
    "For internal use only.\n"
   },
+  {"_select_by_attribute", (PyCFunction)igraphmodule_EdgeSeq_select_by_attribute,
+   METH_VARARGS,
+   "_select_by_attribute(attrname, op, value) -> EdgeSeq\n\n"
+   "Selects the edges whose value of the given attribute satisfies\n"
+   "C{attrvalue op value}, where C{op} is one of C{\"lt\"}, C{\"le\"},\n"
+   "C{\"eq\"}, C{\"ne\"}, C{\"gt\"}, C{\"ge\"}, C{\"in\"} or C{\"notin\"}.\n\n"
+   "For internal use only; see L{EdgeSeq.select()}.\n"
+  },
   {NULL}
 };
 
@@ -52,6 +52,8 @@ PyObject* igraphmodule_EdgeSeq_find(igraphmodule_EdgeSeqObject *self,
   PyObject *args);
 PyObject* igraphmodule_EdgeSeq_select(igraphmodule_EdgeSeqObject *self,
   PyObject *args);
+PyObject* igraphmodule_EdgeSeq_select_by_attribute(igraphmodule_EdgeSeqObject *self,
+  PyObject *args);
 
 PyObject* igraphmodule_EdgeSeq_get_graph(igraphmodule_EdgeSeqObject *self,
   void* closure);
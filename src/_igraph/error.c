@@ -28,6 +28,12 @@
  */
 PyObject* igraphmodule_InternalError;
 
+/** \ingroup python_interface_errors
+ * \brief Exception type to be returned when a computation is stopped by a
+ *        cancellation token.
+ */
+PyObject* igraphmodule_CancelledError;
+
 /**
  * \ingroup python_interface_errors
  * \brief Generic error handler for internal \c igraph errors.
@@ -54,22 +60,34 @@ PyObject* igraphmodule_handle_igraph_error()
 /**
  * \ingroup python_interface_errors
  * \brief Warning hook for \c igraph
+ *
+ * May be called from a section that has released the GIL, hence the
+ * GIL is re-acquired here.
  */
 void igraphmodule_igraph_warning_hook(const char *reason, const char *file,
 				    int line, int igraph_errno) {
   char buf[4096];
+  PyGILState_STATE gstate;
+
   snprintf(buf, sizeof(buf), "%s at %s:%i", reason, file, line);
+
+  gstate = PyGILState_Ensure();
   PyErr_Warn(PyExc_RuntimeWarning, buf);
+  PyGILState_Release(gstate);
 }
 
 /**
  * \ingroup python_interface_errors
  * \brief Error hook for \c igraph
+ *
+ * May be called from a section that has released the GIL, hence the
+ * GIL is re-acquired here.
  */
 void igraphmodule_igraph_error_hook(const char *reason, const char *file,
 				    int line, int igraph_errno) {
   char buf[4096];
   PyObject *exc = igraphmodule_InternalError;
+  PyGILState_STATE gstate;
 
   if (igraph_errno == IGRAPH_UNIMPLEMENTED)
       exc = PyExc_NotImplementedError;
@@ -82,6 +100,8 @@ void igraphmodule_igraph_error_hook(const char *reason, const char *file,
   IGRAPH_FINALLY_FREE();
 
   /* make sure we are not masking already thrown exceptions */
+  gstate = PyGILState_Ensure();
   if (!PyErr_Occurred())
     PyErr_SetString(exc, buf);
+  PyGILState_Release(gstate);
 }
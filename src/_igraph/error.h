@@ -36,6 +36,7 @@ void igraphmodule_igraph_error_hook(const char *reason, const char *file,
 				    int line, int igraph_errno);
 
 extern PyObject* igraphmodule_InternalError;
+extern PyObject* igraphmodule_CancelledError;
 
 #define IGRAPH_PYCHECK(a) do { \
 	int igraph_i_pyret=(a); \
@@ -23,6 +23,428 @@
 #include "filehandle.h"
 #include "py2compat.h"
 #include "pyhelpers.h"
+#include <errno.h>
+
+/* Size of the buffer of streams read through readinto() */
+#define IGRAPHMODULE_FILEHANDLE_STREAM_BUFFER_SIZE (1 << 20)
+
+#if defined(__GLIBC__)
+#  define IGRAPHMODULE_FILEHANDLE_HAVE_FOPENCOOKIE
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || \
+      defined(__OpenBSD__) || defined(__DragonFly__)
+#  define IGRAPHMODULE_FILEHANDLE_HAVE_FUNOPEN
+#endif
+
+/**
+ * \ingroup python_interface_filehandle
+ * \brief Reads at most \c size bytes from a Python stream into \c buf
+ * by calling its \c readinto() method.
+ *
+ * This is called by the C core while parsing a file, typically without
+ * holding the GIL, so the GIL is acquired only for the duration of the
+ * call. Exceptions raised by the stream are stored in the stream state and
+ * re-raised by \ref igraphmodule_filehandle_destroy().
+ *
+ * \return the number of bytes read, 0 at the end of the stream or -1 if
+ *   an error happened
+ */
+static long igraphmodule_i_filehandle_stream_read(
+        igraphmodule_filehandle_stream_t* stream, char* buf, size_t size) {
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    PyObject *view, *result, *released;
+    long n = -1;
+
+    if (stream->exc_type != 0) {
+        /* The stream failed already */
+        PyGILState_Release(gstate);
+        errno = EIO;
+        return -1;
+    }
+
+#ifdef IGRAPH_PYTHON3
+    view = PyMemoryView_FromMemory(buf, size, PyBUF_WRITE);
+#else
+    view = PyByteArray_FromStringAndSize(0, size);
+#endif
+    if (view != 0) {
+        result = PyObject_CallFunctionObjArgs(stream->readinto, view, NULL);
+        if (result == Py_None) {
+            PyErr_SetString(PyExc_IOError, "non-blocking streams are not supported");
+        } else if (result != 0) {
+            n = PyInt_AsLong(result);
+            if (n == -1 && PyErr_Occurred()) {
+                n = -1;
+            } else if (n < 0 || (size_t)n > size) {
+                PyErr_SetString(PyExc_IOError, "readinto() returned an invalid "
+                        "number of bytes");
+                n = -1;
+            }
+#ifndef IGRAPH_PYTHON3
+            if (n > 0) {
+                memcpy(buf, PyByteArray_AS_STRING(view), n);
+            }
+#endif
+        }
+        Py_XDECREF(result);
+
+#ifdef IGRAPH_PYTHON3
+        /* The memory belongs to the FILE* object, make sure that the stream
+         * does not hold on to it */
+        released = PyObject_CallMethod(view, "release", NULL);
+        Py_XDECREF(released);
+#else
+        released = 0;
+        (void)released;
+#endif
+        Py_DECREF(view);
+    }
+
+    if (n < 0) {
+        PyErr_Fetch(&stream->exc_type, &stream->exc_value, &stream->exc_traceback);
+        if (stream->exc_type == 0) {
+            Py_INCREF(PyExc_IOError);
+            stream->exc_type = PyExc_IOError;
+        }
+        errno = EIO;
+    }
+
+    PyGILState_Release(gstate);
+    return n;
+}
+
+/**
+ * \ingroup python_interface_filehandle
+ * \brief Writes \c size bytes from \c buf to a Python stream by calling its
+ * \c write() method.
+ *
+ * This is called whenever the buffer of the \c FILE* object is flushed,
+ * without holding the GIL if the writer released it, so the GIL is acquired
+ * only for the duration of the call. Text streams receive the data decoded from UTF-8;
+ * an incomplete multi-byte sequence at the end of the data is held back
+ * until the next call unless \c final is true. Exceptions raised by the
+ * stream are stored in the stream state and re-raised by
+ * \ref igraphmodule_filehandle_destroy().
+ *
+ * \return \c size if everything was OK, -1 if an error happened
+ */
+static long igraphmodule_i_filehandle_stream_write(
+        igraphmodule_filehandle_stream_t* stream, const char* buf, size_t size,
+        int final) {
+    PyGILState_STATE gstate = PyGILState_Ensure();
+    PyObject *data = 0, *result = 0;
+    const char* start = buf;
+    char* joined = 0;
+    size_t length = size;
+
+    if (stream->exc_type != 0) {
+        /* The stream failed already */
+        PyGILState_Release(gstate);
+        errno = EIO;
+        return -1;
+    }
+
+    if (stream->pending_size > 0) {
+        joined = (char*)malloc(stream->pending_size + size + 1);
+        if (joined == 0) {
+            PyErr_NoMemory();
+        } else {
+            memcpy(joined, stream->pending, stream->pending_size);
+            memcpy(joined + stream->pending_size, buf, size);
+            start = joined;
+            length += stream->pending_size;
+            stream->pending_size = 0;
+        }
+    }
+
+    if (start != buf || stream->pending_size == 0) {
+#ifdef IGRAPH_PYTHON3
+        if (stream->text) {
+            Py_ssize_t consumed = length;
+            data = PyUnicode_DecodeUTF8Stateful(start, length, "strict",
+                    final ? 0 : &consumed);
+            if (data != 0 && (size_t)consumed < length) {
+                stream->pending_size = length - consumed;
+                memcpy(stream->pending, start + consumed, stream->pending_size);
+            }
+        } else {
+            data = PyBytes_FromStringAndSize(start, length);
+        }
+#else
+        (void)final;
+        data = PyBytes_FromStringAndSize(start, length);
+#endif
+    }
+    free(joined);
+
+    if (data != 0) {
+        result = PyObject_CallFunctionObjArgs(stream->write, data, NULL);
+        Py_DECREF(data);
+    }
+
+    if (result == 0) {
+        PyErr_Fetch(&stream->exc_type, &stream->exc_value, &stream->exc_traceback);
+        if (stream->exc_type == 0) {
+            Py_INCREF(PyExc_IOError);
+            stream->exc_type = PyExc_IOError;
+        }
+        PyGILState_Release(gstate);
+        errno = EIO;
+        return -1;
+    }
+
+    Py_DECREF(result);
+    PyGILState_Release(gstate);
+    return (long)size;
+}
+
+#if defined(IGRAPHMODULE_FILEHANDLE_HAVE_FOPENCOOKIE)
+static ssize_t igraphmodule_i_filehandle_cookie_read(void* cookie, char* buf,
+        size_t size) {
+    return igraphmodule_i_filehandle_stream_read(cookie, buf, size);
+}
+
+static ssize_t igraphmodule_i_filehandle_cookie_write(void* cookie,
+        const char* buf, size_t size) {
+    /* Short writes are reported as errors, see fopencookie(3) */
+    long n = igraphmodule_i_filehandle_stream_write(cookie, buf, size, 0);
+    return n < 0 ? 0 : n;
+}
+
+static int igraphmodule_i_filehandle_cookie_close(void* cookie) {
+    /* The stream state is freed by igraphmodule_filehandle_destroy() */
+    return 0;
+}
+#elif defined(IGRAPHMODULE_FILEHANDLE_HAVE_FUNOPEN)
+static int igraphmodule_i_filehandle_cookie_read(void* cookie, char* buf,
+        int size) {
+    return (int)igraphmodule_i_filehandle_stream_read(cookie, buf, size);
+}
+
+static int igraphmodule_i_filehandle_cookie_write(void* cookie,
+        const char* buf, int size) {
+    return (int)igraphmodule_i_filehandle_stream_write(cookie, buf, size, 0);
+}
+
+static int igraphmodule_i_filehandle_cookie_close(void* cookie) {
+    /* The stream state is freed by igraphmodule_filehandle_destroy() */
+    return 0;
+}
+#endif
+
+/**
+ * \ingroup python_interface_filehandle
+ * \brief Makes a file handle use a buffer of the given size.
+ *
+ * Must be called right after the \c FILE* object was created and only for
+ * \c FILE* objects that are closed by \ref igraphmodule_filehandle_destroy(),
+ * since the buffer is freed there.
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate Python
+ *   exception is raised in this case.
+ */
+static int igraphmodule_i_filehandle_set_buffer(igraphmodule_filehandle_t* handle,
+        size_t buffer_size) {
+    if (buffer_size == 0) {
+        buffer_size = IGRAPHMODULE_FILEHANDLE_STREAM_BUFFER_SIZE;
+    }
+
+    /* setvbuf() ignores the size if it has to allocate the buffer itself */
+    handle->buffer = (char*)malloc(buffer_size);
+    if (handle->buffer == 0) {
+        PyErr_NoMemory();
+        return 1;
+    }
+
+    if (setvbuf(handle->fp, handle->buffer, _IOFBF, buffer_size)) {
+        PyErr_SetString(PyExc_RuntimeError, "setvbuf() failed unexpectedly");
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * \ingroup python_interface_filehandle
+ * \brief Constructs a file handle that reads from a Python stream with a
+ * \c readinto() method (e.g., \c io.BytesIO, \c gzip.GzipFile or a
+ * stream from an object storage client) or writes to a Python stream with
+ * a \c write() method.
+ *
+ * Where the C library supports custom streams, the data is read in large
+ * chunks directly into the buffer of the \c FILE* object while the file is
+ * being parsed, and written from it whenever the buffer is full. Elsewhere
+ * the stream is copied into a temporary file first or the temporary file
+ * is copied into the stream when the handle is destroyed.
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate Python
+ *   exception is raised in this case.
+ */
+static int igraphmodule_i_filehandle_init_stream(igraphmodule_filehandle_t* handle,
+        PyObject* object, char* mode, size_t buffer_size) {
+    igraphmodule_filehandle_stream_t* stream;
+    int writing = (mode[0] == 'w');
+
+    handle->object = 0;
+    handle->fp = 0;
+    handle->need_close = 0;
+    handle->stream = 0;
+
+    stream = (igraphmodule_filehandle_stream_t*)calloc(1, sizeof(*stream));
+    if (stream == 0) {
+        PyErr_NoMemory();
+        return 1;
+    }
+
+    if (writing) {
+        stream->write = PyObject_GetAttrString(object, "write");
+    } else {
+        stream->readinto = PyObject_GetAttrString(object, "readinto");
+    }
+    if (stream->write == 0 && stream->readinto == 0) {
+        free(stream);
+        return 1;
+    }
+
+#ifdef IGRAPH_PYTHON3
+    if (writing && strchr(mode, 'b') == 0) {
+        PyObject *io = PyImport_ImportModule("io"), *text_io_base = 0;
+        if (io != 0) {
+            text_io_base = PyObject_GetAttrString(io, "TextIOBase");
+            Py_DECREF(io);
+        }
+        stream->text = text_io_base ? PyObject_IsInstance(object, text_io_base) : -1;
+        Py_XDECREF(text_io_base);
+        if (stream->text < 0) {
+            Py_DECREF(stream->write);
+            free(stream);
+            return 1;
+        }
+    }
+#endif
+
+    handle->object = object;
+    Py_INCREF(handle->object);
+    handle->stream = stream;
+
+#if defined(IGRAPHMODULE_FILEHANDLE_HAVE_FOPENCOOKIE)
+    {
+        cookie_io_functions_t funcs = {
+            igraphmodule_i_filehandle_cookie_read, 0, 0,
+            igraphmodule_i_filehandle_cookie_close
+        };
+        if (writing) {
+            funcs.read = 0;
+            funcs.write = igraphmodule_i_filehandle_cookie_write;
+        }
+        handle->fp = fopencookie(stream, writing ? "w" : "r", funcs);
+    }
+#elif defined(IGRAPHMODULE_FILEHANDLE_HAVE_FUNOPEN)
+    if (writing) {
+        handle->fp = funopen(stream, 0, igraphmodule_i_filehandle_cookie_write, 0,
+                igraphmodule_i_filehandle_cookie_close);
+    } else {
+        handle->fp = funopen(stream, igraphmodule_i_filehandle_cookie_read, 0, 0,
+                igraphmodule_i_filehandle_cookie_close);
+    }
+#else
+    handle->fp = tmpfile();
+    if (handle->fp != 0 && !writing) {
+        char* buf = (char*)malloc(IGRAPHMODULE_FILEHANDLE_STREAM_BUFFER_SIZE);
+        long n;
+
+        if (buf == 0) {
+            igraphmodule_filehandle_destroy(handle);
+            PyErr_NoMemory();
+            return 1;
+        }
+
+        while ((n = igraphmodule_i_filehandle_stream_read(stream, buf,
+                        IGRAPHMODULE_FILEHANDLE_STREAM_BUFFER_SIZE)) > 0) {
+            if (fwrite(buf, 1, n, handle->fp) != (size_t)n) {
+                break;
+            }
+        }
+        free(buf);
+
+        if (n != 0) {
+            /* Re-raises the exception of the stream if there was one */
+            if (!stream->exc_type) {
+                PyErr_SetFromErrno(PyExc_IOError);
+            }
+            igraphmodule_filehandle_destroy(handle);
+            return 1;
+        }
+
+        rewind(handle->fp);
+    }
+#endif
+
+    if (handle->fp == 0) {
+        igraphmodule_filehandle_destroy(handle);
+        PyErr_SetFromErrno(PyExc_IOError);
+        return 1;
+    }
+
+    if (igraphmodule_i_filehandle_set_buffer(handle, buffer_size)) {
+        igraphmodule_filehandle_destroy(handle);
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * \ingroup python_interface_filehandle
+ * \brief Constructs a file handle that writes to the file with the given
+ * name.
+ *
+ * The file is opened by the C library instead of Python so that the size
+ * of its buffer can be chosen by the caller.
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate Python
+ *   exception is raised in this case.
+ */
+static int igraphmodule_i_filehandle_init_path(igraphmodule_filehandle_t* handle,
+        PyObject* object, char* mode, size_t buffer_size) {
+    PyObject* path;
+
+    handle->object = 0;
+    handle->fp = 0;
+    handle->need_close = 0;
+    handle->stream = 0;
+
+#ifdef IGRAPH_PYTHON3
+    if (!PyUnicode_FSConverter(object, &path)) {
+        return 1;
+    }
+#else
+    if (PyUnicode_Check(object)) {
+        path = PyUnicode_AsEncodedString(object, Py_FileSystemDefaultEncoding,
+                "strict");
+        if (path == 0) {
+            return 1;
+        }
+    } else {
+        path = object;
+        Py_INCREF(path);
+    }
+#endif
+
+    handle->fp = fopen(PyBytes_AS_STRING(path), mode);
+    Py_DECREF(path);
+    if (handle->fp == 0) {
+        PyErr_SetFromErrnoWithFilenameObject(PyExc_IOError, object);
+        return 1;
+    }
+    handle->need_close = 1;
+
+    if (igraphmodule_i_filehandle_set_buffer(handle, buffer_size)) {
+        igraphmodule_filehandle_destroy(handle);
+        return 1;
+    }
+
+    return 0;
+}
 
 #ifndef PYPY_VERSION
 #  ifndef IGRAPH_PYTHON3
@@ -301,6 +723,43 @@ static int igraphmodule_i_filehandle_init_pypy_3(igraphmodule_filehandle_t* hand
  */
 int igraphmodule_filehandle_init(igraphmodule_filehandle_t* handle,
         PyObject* object, char* mode) {
+    return igraphmodule_filehandle_init_buffered(handle, object, mode, 0);
+}
+
+/**
+ * \ingroup python_interface_filehandle
+ * \brief Constructs a new file handle object from a Python object, using a
+ * buffer of the given size.
+ *
+ * The size of the buffer is honoured for file names opened for writing and
+ * for Python streams; it is ignored for files opened by Python that are
+ * accessed through their file descriptors.
+ *
+ * \param buffer_size the size of the buffer in bytes; zero means the
+ *   default size
+ * \return 0 if everything was OK, 1 otherwise. An appropriate Python
+ *   exception is raised in this case.
+ */
+int igraphmodule_filehandle_init_buffered(igraphmodule_filehandle_t* handle,
+        PyObject* object, char* mode, size_t buffer_size) {
+    handle->stream = 0;
+    handle->buffer = 0;
+
+    /* Streams that can be read into a buffer are read through readinto()
+     * and streams that can be written are written through write() even if
+     * they have a file descriptor, because the descriptor of wrapper streams
+     * (e.g., gzip.GzipFile) belongs to the underlying file */
+    if (object != 0 && !PyBaseString_Check(object) && PyObject_HasAttrString(
+                object, mode[0] == 'r' ? "readinto" : "write")) {
+        return igraphmodule_i_filehandle_init_stream(handle, object, mode,
+                buffer_size);
+    }
+
+    if (object != 0 && mode[0] == 'w' && PyBaseString_Check(object)) {
+        return igraphmodule_i_filehandle_init_path(handle, object, mode,
+                buffer_size);
+    }
+
 #ifdef PYPY_VERSION
 #  ifdef IGRAPH_PYTHON3
     return igraphmodule_i_filehandle_init_pypy_3(handle, object, mode);
@@ -325,12 +784,48 @@ void igraphmodule_filehandle_destroy(igraphmodule_filehandle_t* handle) {
 
     if (handle->fp != 0) {
         fflush(handle->fp);
-        if (handle->need_close && !handle->object) {
+#if !defined(IGRAPHMODULE_FILEHANDLE_HAVE_FOPENCOOKIE) && \
+    !defined(IGRAPHMODULE_FILEHANDLE_HAVE_FUNOPEN)
+        if (handle->stream != 0 && handle->stream->write != 0) {
+            /* Copy the temporary file into the stream */
+            char* buf = (char*)malloc(IGRAPHMODULE_FILEHANDLE_STREAM_BUFFER_SIZE);
+            size_t n;
+
+            rewind(handle->fp);
+            while (buf != 0 && (n = fread(buf, 1,
+                            IGRAPHMODULE_FILEHANDLE_STREAM_BUFFER_SIZE, handle->fp)) > 0) {
+                if (igraphmodule_i_filehandle_stream_write(handle->stream, buf, n, 0) < 0) {
+                    break;
+                }
+            }
+            free(buf);
+        }
+#endif
+        if ((handle->need_close && !handle->object) || handle->stream) {
             fclose(handle->fp);
         }
     }
 
     handle->fp = 0;
+    free(handle->buffer);
+    handle->buffer = 0;
+
+    if (handle->stream != 0) {
+        igraphmodule_filehandle_stream_t* stream = handle->stream;
+        handle->stream = 0;
+        if (stream->write != 0 && stream->pending_size > 0) {
+            /* Raises an error for the truncated UTF-8 sequence */
+            igraphmodule_i_filehandle_stream_write(stream, "", 0, 1);
+        }
+        if (stream->exc_type != 0) {
+            /* The exception raised by the stream is more informative than
+             * the parse error reported by igraph, so it replaces the latter */
+            PyErr_Restore(stream->exc_type, stream->exc_value, stream->exc_traceback);
+        }
+        Py_XDECREF(stream->readinto);
+        Py_XDECREF(stream->write);
+        free(stream);
+    }
     
     if (handle->object != 0) {
         /* PyFile_Close might mess up the stored exception, so let's
@@ -350,6 +845,37 @@ void igraphmodule_filehandle_destroy(igraphmodule_filehandle_t* handle) {
     handle->need_close = 0;
 }
 
+/**
+ * \ingroup python_interface_filehandle
+ * \brief Flushes and destroys the file handle object, reporting errors that
+ * happened while writing.
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate Python
+ *   exception is raised in this case.
+ */
+int igraphmodule_filehandle_close(igraphmodule_filehandle_t* handle) {
+    int failed = 0, saved_errno = 0;
+
+    if (handle->fp != 0 && (fflush(handle->fp) || ferror(handle->fp))) {
+        failed = 1;
+        saved_errno = errno;
+    }
+
+    igraphmodule_filehandle_destroy(handle);
+
+    if (PyErr_Occurred()) {
+        return 1;
+    }
+
+    if (failed) {
+        errno = saved_errno ? saved_errno : EIO;
+        PyErr_SetFromErrno(PyExc_IOError);
+        return 1;
+    }
+
+    return 0;
+}
+
 /**
  * \ingroup python_interface_filehandle
  * \brief Returns the file encapsulated by the given \c igraphmodule_filehandle_t.
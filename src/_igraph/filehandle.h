@@ -30,6 +30,24 @@
  * \defgroup python_interface_filehandle File handle object
  */
 
+/**
+ * \ingroup python_interface_filehandle
+ * \brief State of a \c FILE* pointer that reads from a Python stream
+ * through its \c readinto() method or writes to it through its \c write()
+ * method.
+ */
+typedef struct {
+    PyObject* readinto;
+    PyObject* write;
+    /* Whether write() expects strings instead of bytes */
+    int text;
+    /* Incomplete UTF-8 sequence held back from the last write to a text
+     * stream */
+    char pending[4];
+    size_t pending_size;
+    PyObject *exc_type, *exc_value, *exc_traceback;
+} igraphmodule_filehandle_stream_t;
+
 /**
  * \ingroup python_interface_filehandle
  * \brief A structure encapsulating a Python object and a \c FILE* pointer
@@ -39,12 +57,17 @@ typedef struct {
     PyObject* object;
     FILE* fp;
     unsigned short int need_close;
+    igraphmodule_filehandle_stream_t* stream;
+    char* buffer;
 } igraphmodule_filehandle_t;
 
 
 int igraphmodule_filehandle_init(igraphmodule_filehandle_t* handle,
         PyObject* object, char* mode);
+int igraphmodule_filehandle_init_buffered(igraphmodule_filehandle_t* handle,
+        PyObject* object, char* mode, size_t buffer_size);
 FILE* igraphmodule_filehandle_get(const igraphmodule_filehandle_t* handle);
+int igraphmodule_filehandle_close(igraphmodule_filehandle_t* handle);
 void igraphmodule_filehandle_destroy(igraphmodule_filehandle_t* handle);
 
 #endif
@@ -0,0 +1,900 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#include "forcelayout.h"
+#include "threading.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <igraph_random.h>
+
+/** \ingroup python_interface_forcelayout
+ * \brief Maximum number of vertices in a leaf of the tree */
+#define IGRAPHMODULE_BH_LEAF_SIZE 8
+
+/** \ingroup python_interface_forcelayout
+ * \brief Maximum depth of the tree; deeper cells (i.e. vertices that are
+ *        almost at the same position) are kept in a single leaf */
+#define IGRAPHMODULE_BH_MAX_DEPTH 32
+
+/** \ingroup python_interface_forcelayout
+ * \brief Maximum number of levels of the multilevel scheme */
+#define IGRAPHMODULE_BH_MAX_LEVELS 64
+
+/** \ingroup python_interface_forcelayout
+ * \brief Graphs with at most this many vertices are not coarsened further */
+#define IGRAPHMODULE_BH_COARSEST_SIZE 50
+
+/** \ingroup python_interface_forcelayout
+ * \brief Coarsening stops if a level has more than this fraction of the
+ *        vertices of the finer one */
+#define IGRAPHMODULE_BH_COARSENING_RATIO 0.75
+
+/** \ingroup python_interface_forcelayout
+ * \brief Relative strength of the repulsive forces */
+#define IGRAPHMODULE_BH_REPULSION 0.2
+
+/** \ingroup python_interface_forcelayout
+ * \brief Cooling factor of the adaptive step length */
+#define IGRAPHMODULE_BH_COOLING 0.9
+
+/** \ingroup python_interface_forcelayout
+ * \brief A level stops when its step length drops below this fraction of
+ *        the mean spacing of the vertices */
+#define IGRAPHMODULE_BH_TOLERANCE 1e-2
+
+/** \ingroup python_interface_forcelayout
+ * \brief Levels with fewer vertices per thread than this run on a single
+ *        thread, because starting the threads would cost more than the
+ *        iteration itself */
+#define IGRAPHMODULE_BH_MIN_VERTICES_PER_THREAD 1024
+
+/**
+ * \ingroup python_interface_forcelayout
+ * \brief A level of the multilevel scheme
+ *
+ * The graph of the level in the compressed sparse row format, both
+ * directions of every edge included. Multiple edges of a coarse level are
+ * merged and their weights summed; each coarse vertex has the total mass
+ * of the vertices it stands for.
+ */
+typedef struct {
+  long int no_of_nodes;
+  long int *offsets;
+  long int *neighbors;
+  igraph_real_t *weights;
+  igraph_real_t *mass;
+  // The vertex of the next coarser level each vertex was collapsed into
+  long int *parent;
+} igraphmodule_i_bh_level_t;
+
+/**
+ * \ingroup python_interface_forcelayout
+ * \brief A cell of the quadtree or octree
+ *
+ * Leaves refer to the range <tt>[start, end)</tt> of the permutation of
+ * the vertices in the tree; the vertices of every cell are contiguous in
+ * the permutation.
+ */
+typedef struct {
+  igraph_real_t center[3];
+  igraph_real_t half;
+  igraph_real_t com[3];
+  igraph_real_t mass;
+  long int child[8];
+  long int start, end;
+  igraph_bool_t leaf;
+} igraphmodule_i_bh_cell_t;
+
+typedef struct {
+  igraphmodule_i_bh_cell_t *cells;
+  long int size, capacity;
+  long int *perm;
+  long int *tmp;
+} igraphmodule_i_bh_tree_t;
+
+/**
+ * \ingroup python_interface_forcelayout
+ * \brief Data shared by the workers of an iteration
+ */
+typedef struct {
+  const igraphmodule_i_bh_level_t *level;
+  const igraphmodule_i_bh_tree_t *tree;
+  long int dim;
+  igraph_real_t theta;
+  // Natural spring length
+  igraph_real_t k;
+  igraph_real_t step;
+  const igraph_real_t *pos;
+  igraph_real_t *new_pos;
+} igraphmodule_i_bh_job_t;
+
+typedef struct {
+  const igraphmodule_i_bh_job_t *job;
+  long int from, to;
+  // Sum of the squared forces on the vertices of the worker
+  igraph_real_t energy;
+} igraphmodule_i_bh_worker_t;
+
+static void igraphmodule_i_bh_level_destroy(igraphmodule_i_bh_level_t *level) {
+  free(level->offsets);
+  free(level->neighbors);
+  free(level->weights);
+  free(level->mass);
+  free(level->parent);
+  memset(level, 0, sizeof(igraphmodule_i_bh_level_t));
+}
+
+/**
+ * \ingroup python_interface_forcelayout
+ * \brief Creates the finest level from the cached adjacency lists
+ */
+static int igraphmodule_i_bh_level_from_graph(igraphmodule_i_bh_level_t *level,
+    const igraph_t *graph, const igraphmodule_adjacency_t *adj,
+    const igraph_vector_t *weights) {
+  long int n = adj->no_of_nodes, v, j, e, m = adj->offsets[n];
+
+  level->no_of_nodes = n;
+  level->offsets = (long int*)calloc(n + 1, sizeof(long int));
+  level->neighbors = (long int*)calloc(m > 0 ? m : 1, sizeof(long int));
+  level->weights = (igraph_real_t*)calloc(m > 0 ? m : 1, sizeof(igraph_real_t));
+  level->mass = (igraph_real_t*)calloc(n > 0 ? n : 1, sizeof(igraph_real_t));
+  if (!level->offsets || !level->neighbors || !level->weights || !level->mass) {
+    igraphmodule_i_bh_level_destroy(level);
+    return IGRAPH_ENOMEM;
+  }
+
+  memcpy(level->offsets, adj->offsets, (n + 1) * sizeof(long int));
+  for (v = 0; v < n; v++) {
+    level->mass[v] = 1;
+    for (j = adj->offsets[v]; j < adj->offsets[v + 1]; j++) {
+      /* the neighbors and the edges of an IGRAPH_ALL list do not match item
+       * by item in directed graphs, so the neighbor is taken from the edge */
+      e = adj->edges[j];
+      level->neighbors[j] = IGRAPH_FROM(graph, e) == v ?
+        (long int) IGRAPH_TO(graph, e) : (long int) IGRAPH_FROM(graph, e);
+      level->weights[j] = weights ? VECTOR(*weights)[e] : 1;
+    }
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup python_interface_forcelayout
+ * \brief Collapses a level into a coarser one
+ *
+ * Every vertex is matched with the unmatched neighbor it is connected to by
+ * the heaviest edge, visiting the vertices in random order. Vertices left
+ * without a partner join the lightest group among their neighbors, so
+ * that the leaves of a star are collapsed into its center instead of
+ * stopping the coarsening. The \c parent array of the fine level is filled.
+ */
+static int igraphmodule_i_bh_coarsen(igraphmodule_i_bh_level_t *fine,
+    igraphmodule_i_bh_level_t *coarse, igraph_rng_t *rng) {
+  long int n = fine->no_of_nodes, nc = 0, i, j, k, v, u, c, t, best, tmp;
+  long int *order, *members, *member_offsets, *marker;
+  igraph_real_t best_weight, *group_mass;
+
+  fine->parent = (long int*)calloc(n, sizeof(long int));
+  order = (long int*)calloc(n, sizeof(long int));
+  if (!fine->parent || !order) {
+    free(order);
+    return IGRAPH_ENOMEM;
+  }
+
+  for (v = 0; v < n; v++) {
+    order[v] = v;
+    fine->parent[v] = -1;
+  }
+  for (i = 0; i < n - 1; i++) {
+    j = (long int) igraph_rng_get_integer(rng, i, n - 1);
+    tmp = order[i]; order[i] = order[j]; order[j] = tmp;
+  }
+
+  /* Heavy edge matching */
+  for (i = 0; i < n; i++) {
+    v = order[i];
+    if (fine->parent[v] >= 0)
+      continue;
+    best = -1;
+    best_weight = 0;
+    for (j = fine->offsets[v]; j < fine->offsets[v + 1]; j++) {
+      u = fine->neighbors[j];
+      if (u != v && fine->parent[u] < 0 && (best < 0 || fine->weights[j] > best_weight)) {
+        best = u;
+        best_weight = fine->weights[j];
+      }
+    }
+    if (best >= 0) {
+      fine->parent[v] = fine->parent[best] = nc++;
+    }
+  }
+
+  group_mass = (igraph_real_t*)calloc(nc > 0 ? nc : 1, sizeof(igraph_real_t));
+  if (!group_mass) {
+    free(order);
+    return IGRAPH_ENOMEM;
+  }
+  for (v = 0; v < n; v++) {
+    if (fine->parent[v] >= 0)
+      group_mass[fine->parent[v]] += fine->mass[v];
+  }
+
+  /* Unmatched vertices join the lightest neighboring pair; the ones with no
+   * matched neighbor become coarse vertices on their own */
+  for (i = 0; i < n; i++) {
+    v = order[i];
+    if (fine->parent[v] >= 0)
+      continue;
+    best = -1;
+    for (j = fine->offsets[v]; j < fine->offsets[v + 1]; j++) {
+      c = fine->parent[fine->neighbors[j]];
+      if (c >= 0 && c < nc && (best < 0 || group_mass[c] < group_mass[best]))
+        best = c;
+    }
+    if (best >= 0) {
+      fine->parent[v] = best;
+      group_mass[best] += fine->mass[v];
+    } else {
+      fine->parent[v] = -2 - v;    /* resolved below */
+    }
+  }
+  free(group_mass);
+  for (v = 0; v < n; v++) {
+    if (fine->parent[v] < 0)
+      fine->parent[v] = nc++;
+  }
+  free(order);
+
+  /* Members of the coarse vertices, sorted by counting */
+  member_offsets = (long int*)calloc(nc + 1, sizeof(long int));
+  members = (long int*)calloc(n, sizeof(long int));
+  marker = (long int*)calloc(nc, sizeof(long int));
+  coarse->no_of_nodes = nc;
+  coarse->offsets = (long int*)calloc(nc + 1, sizeof(long int));
+  /* a coarse level never has more adjacency entries than the fine one */
+  k = fine->offsets[n] > 0 ? fine->offsets[n] : 1;
+  coarse->neighbors = (long int*)calloc(k, sizeof(long int));
+  coarse->weights = (igraph_real_t*)calloc(k, sizeof(igraph_real_t));
+  coarse->mass = (igraph_real_t*)calloc(nc, sizeof(igraph_real_t));
+  if (!member_offsets || !members || !marker || !coarse->offsets ||
+      !coarse->neighbors || !coarse->weights || !coarse->mass) {
+    free(member_offsets);
+    free(members);
+    free(marker);
+    igraphmodule_i_bh_level_destroy(coarse);
+    return IGRAPH_ENOMEM;
+  }
+
+  for (v = 0; v < n; v++) {
+    member_offsets[fine->parent[v] + 1]++;
+    coarse->mass[fine->parent[v]] += fine->mass[v];
+  }
+  for (c = 0; c < nc; c++)
+    member_offsets[c + 1] += member_offsets[c];
+  for (v = 0; v < n; v++)
+    members[member_offsets[fine->parent[v]]++] = v;
+  for (c = nc; c > 0; c--)
+    member_offsets[c] = member_offsets[c - 1];
+  member_offsets[0] = 0;
+
+  /* Coarse edges; marker[t] is the position of t in the row being built */
+  for (c = 0; c < nc; c++)
+    marker[c] = -1;
+  k = 0;
+  for (c = 0; c < nc; c++) {
+    coarse->offsets[c] = k;
+    for (i = member_offsets[c]; i < member_offsets[c + 1]; i++) {
+      v = members[i];
+      for (j = fine->offsets[v]; j < fine->offsets[v + 1]; j++) {
+        t = fine->parent[fine->neighbors[j]];
+        if (t == c)
+          continue;
+        if (marker[t] >= coarse->offsets[c]) {
+          coarse->weights[marker[t]] += fine->weights[j];
+        } else {
+          marker[t] = k;
+          coarse->neighbors[k] = t;
+          coarse->weights[k] = fine->weights[j];
+          k++;
+        }
+      }
+    }
+  }
+  coarse->offsets[nc] = k;
+
+  free(member_offsets);
+  free(members);
+  free(marker);
+
+  return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup python_interface_forcelayout
+ * \brief Builds a subtree from the vertices <tt>perm[lo..hi)</tt>
+ *
+ * \return the index of the new cell or -1 if the memory ran out
+ */
+static long int igraphmodule_i_bh_tree_build(igraphmodule_i_bh_tree_t *tree,
+    const igraph_real_t *pos, const igraph_real_t *mass, long int dim,
+    long int lo, long int hi, const igraph_real_t *center, igraph_real_t half,
+    int depth) {
+  igraphmodule_i_bh_cell_t *cell;
+  igraph_real_t child_center[3], m;
+  long int counts[9], index, i, b, d, v, child, no_of_children = 1L << dim;
+
+  if (tree->size == tree->capacity) {
+    igraphmodule_i_bh_cell_t *cells = (igraphmodule_i_bh_cell_t*)realloc(
+        tree->cells, 2 * tree->capacity * sizeof(igraphmodule_i_bh_cell_t));
+    if (!cells)
+      return -1;
+    tree->cells = cells;
+    tree->capacity *= 2;
+  }
+
+  index = tree->size++;
+  cell = &tree->cells[index];
+  memset(cell, 0, sizeof(igraphmodule_i_bh_cell_t));
+  for (d = 0; d < dim; d++)
+    cell->center[d] = center[d];
+  cell->half = half;
+  for (b = 0; b < 8; b++)
+    cell->child[b] = -1;
+  cell->start = lo;
+  cell->end = hi;
+
+  if (hi - lo <= IGRAPHMODULE_BH_LEAF_SIZE || depth >= IGRAPHMODULE_BH_MAX_DEPTH) {
+    cell->leaf = 1;
+    for (i = lo; i < hi; i++) {
+      v = tree->perm[i];
+      cell->mass += mass[v];
+      for (d = 0; d < dim; d++)
+        cell->com[d] += mass[v] * pos[v * dim + d];
+    }
+    for (d = 0; cell->mass > 0 && d < dim; d++)
+      cell->com[d] /= cell->mass;
+    return index;
+  }
+
+  /* Sort the vertices by the child cell they fall into */
+  memset(counts, 0, sizeof(counts));
+  for (i = lo; i < hi; i++) {
+    v = tree->perm[i];
+    for (b = 0, d = 0; d < dim; d++)
+      if (pos[v * dim + d] >= center[d])
+        b |= 1L << d;
+    counts[b + 1]++;
+  }
+  counts[0] = lo;
+  for (b = 1; b <= no_of_children; b++)
+    counts[b] += counts[b - 1];
+  for (i = lo; i < hi; i++) {
+    v = tree->perm[i];
+    for (b = 0, d = 0; d < dim; d++)
+      if (pos[v * dim + d] >= center[d])
+        b |= 1L << d;
+    tree->tmp[counts[b]++] = v;
+  }
+  memcpy(tree->perm + lo, tree->tmp + lo, (hi - lo) * sizeof(long int));
+
+  /* counts[b] is the end of the range of child b now */
+  for (b = 0; b < no_of_children; b++) {
+    i = b > 0 ? counts[b - 1] : lo;
+    if (counts[b] == i)
+      continue;
+    for (d = 0; d < dim; d++)
+      child_center[d] = center[d] + ((b >> d) & 1 ? half : -half) / 2;
+    child = igraphmodule_i_bh_tree_build(tree, pos, mass, dim, i, counts[b],
+        child_center, half / 2, depth + 1);
+    if (child < 0)
+      return -1;
+    /* the cells may have been moved by the recursive call */
+    tree->cells[index].child[b] = child;
+  }
+
+  cell = &tree->cells[index];
+  for (b = 0; b < no_of_children; b++) {
+    if (cell->child[b] < 0)
+      continue;
+    m = tree->cells[cell->child[b]].mass;
+    cell->mass += m;
+    for (d = 0; d < dim; d++)
+      cell->com[d] += m * tree->cells[cell->child[b]].com[d];
+  }
+  for (d = 0; cell->mass > 0 && d < dim; d++)
+    cell->com[d] /= cell->mass;
+
+  return index;
+}
+
+/**
+ * \ingroup python_interface_forcelayout
+ * \brief Rebuilds the tree for the given positions
+ */
+static int igraphmodule_i_bh_tree_rebuild(igraphmodule_i_bh_tree_t *tree,
+    const igraph_real_t *pos, const igraph_real_t *mass, long int n, long int dim) {
+  igraph_real_t lo[3], hi[3], center[3], half = 0;
+  long int v, d;
+
+  for (d = 0; d < dim; d++) {
+    lo[d] = IGRAPH_INFINITY;
+    hi[d] = -IGRAPH_INFINITY;
+  }
+  for (v = 0; v < n; v++) {
+    tree->perm[v] = v;
+    for (d = 0; d < dim; d++) {
+      if (pos[v * dim + d] < lo[d]) lo[d] = pos[v * dim + d];
+      if (pos[v * dim + d] > hi[d]) hi[d] = pos[v * dim + d];
+    }
+  }
+  for (d = 0; d < dim; d++) {
+    center[d] = (lo[d] + hi[d]) / 2;
+    if (hi[d] - lo[d] > half)
+      half = hi[d] - lo[d];
+  }
+  /* make sure that the points on the upper boundary are inside the root */
+  half = half / 2 * (1 + 1e-9) + 1e-12;
+
+  tree->size = 0;
+  if (igraphmodule_i_bh_tree_build(tree, pos, mass, dim, 0, n, center, half, 0) < 0)
+    return IGRAPH_ENOMEM;
+
+  return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup python_interface_forcelayout
+ * \brief Adds the repulsion of a point mass at \c p to the force on a vertex
+ *        at \c x; coincident vertices are pushed apart along the first axis
+ */
+static void igraphmodule_i_bh_repulse(const igraph_real_t *x, long int v,
+    const igraph_real_t *p, long int u, igraph_real_t strength, igraph_real_t k,
+    long int dim, igraph_real_t *force) {
+  igraph_real_t diff[3], d2 = 0;
+  long int d;
+
+  for (d = 0; d < dim; d++) {
+    diff[d] = x[d] - p[d];
+    d2 += diff[d] * diff[d];
+  }
+  if (d2 > 0) {
+    for (d = 0; d < dim; d++)
+      force[d] += diff[d] * strength / d2;
+  } else if (u != v) {
+    force[0] += (v < u ? -strength : strength) / k;
+  }
+}
+
+/**
+ * \ingroup python_interface_forcelayout
+ * \brief Calculates the force on a vertex: the repulsion of all the others,
+ *        approximated with the tree, and the attraction of its neighbors
+ */
+static void igraphmodule_i_bh_force(const igraphmodule_i_bh_job_t *job,
+    long int v, igraph_real_t *force) {
+  const igraphmodule_i_bh_level_t *level = job->level;
+  const igraphmodule_i_bh_tree_t *tree = job->tree;
+  const igraphmodule_i_bh_cell_t *cell;
+  const igraph_real_t *x = job->pos + v * job->dim, *p;
+  igraph_real_t c = IGRAPHMODULE_BH_REPULSION * job->k * job->k * level->mass[v];
+  igraph_real_t theta2 = job->theta * job->theta, diff[3], d2, dist;
+  long int stack[IGRAPHMODULE_BH_MAX_DEPTH * 8 + 1], sp = 0;
+  long int dim = job->dim, i, j, u, d, b;
+  igraph_bool_t inside;
+
+  for (d = 0; d < dim; d++)
+    force[d] = 0;
+
+  stack[sp++] = 0;
+  while (sp > 0) {
+    cell = &tree->cells[stack[--sp]];
+    if (cell->leaf) {
+      for (i = cell->start; i < cell->end; i++) {
+        u = tree->perm[i];
+        if (u != v)
+          igraphmodule_i_bh_repulse(x, v, job->pos + u * dim, u,
+              c * level->mass[u], job->k, dim, force);
+      }
+      continue;
+    }
+
+    /* cells containing the vertex itself are always opened */
+    inside = 1;
+    d2 = 0;
+    for (d = 0; d < dim; d++) {
+      diff[d] = x[d] - cell->com[d];
+      d2 += diff[d] * diff[d];
+      if (fabs(x[d] - cell->center[d]) > cell->half)
+        inside = 0;
+    }
+    if (!inside && 4 * cell->half * cell->half < theta2 * d2) {
+      igraphmodule_i_bh_repulse(x, v, cell->com, -1, c * cell->mass, job->k,
+          dim, force);
+      continue;
+    }
+    for (b = 0; b < (1L << dim); b++) {
+      if (cell->child[b] >= 0)
+        stack[sp++] = cell->child[b];
+    }
+  }
+
+  for (j = level->offsets[v]; j < level->offsets[v + 1]; j++) {
+    u = level->neighbors[j];
+    if (u == v)
+      continue;
+    p = job->pos + u * dim;
+    for (d2 = 0, d = 0; d < dim; d++) {
+      diff[d] = p[d] - x[d];
+      d2 += diff[d] * diff[d];
+    }
+    dist = sqrt(d2);
+    for (d = 0; d < dim; d++)
+      force[d] += diff[d] * dist * level->weights[j] / job->k;
+  }
+}
+
+/**
+ * \ingroup python_interface_forcelayout
+ * \brief Moves the vertices of a worker by one step along their forces
+ */
+static void igraphmodule_i_bh_work(void *workers, long int index) {
+  igraphmodule_i_bh_worker_t *w = &((igraphmodule_i_bh_worker_t*)workers)[index];
+  const igraphmodule_i_bh_job_t *job = w->job;
+  igraph_real_t force[3], norm;
+  long int v, d, dim = job->dim;
+
+  w->energy = 0;
+  for (v = w->from; v < w->to; v++) {
+    igraphmodule_i_bh_force(job, v, force);
+    for (norm = 0, d = 0; d < dim; d++)
+      norm += force[d] * force[d];
+    w->energy += norm;
+    norm = sqrt(norm);
+    for (d = 0; d < dim; d++) {
+      job->new_pos[v * dim + d] = job->pos[v * dim + d] +
+        (norm > 0 ? job->step * force[d] / norm : 0);
+    }
+  }
+}
+
+/**
+ * \ingroup python_interface_forcelayout
+ * \brief Runs the iterations of a level
+ *
+ * The step length is adapted as in Hu's algorithm: it is enlarged after
+ * five consecutive iterations that decreased the energy and shortened
+ * whenever the energy did not decrease. Both the initial step and the
+ * tolerance are relative to the mean spacing of the vertices, i.e. the
+ * width of their bounding box divided by the dim-th root of their number,
+ * because the scale of the layout grows with the size of the graph.
+ *
+ * \param pos the initial positions, overwritten with the result
+ * \param work scratch space of the same size as \c pos
+ * \param step the initial step length relative to the mean spacing
+ * \param adaptive whether the step may grow again; if not, it only cools
+ */
+static int igraphmodule_i_bh_refine(const igraphmodule_i_bh_level_t *level,
+    igraphmodule_i_bh_tree_t *tree, igraph_real_t *pos, igraph_real_t *work,
+    igraph_real_t k, igraph_real_t step, igraph_bool_t adaptive,
+    const igraphmodule_barnes_hut_options_t *opts) {
+  igraphmodule_i_bh_job_t job;
+  igraphmodule_i_bh_worker_t *workers;
+  igraph_real_t energy, energy0 = IGRAPH_INFINITY, *tmp, *result = pos, spacing;
+  long int n = level->no_of_nodes, threads = opts->threads, i, iter;
+  int progress = 0, retval = IGRAPH_SUCCESS;
+
+  if (threads > n / IGRAPHMODULE_BH_MIN_VERTICES_PER_THREAD)
+    threads = n / IGRAPHMODULE_BH_MIN_VERTICES_PER_THREAD;
+  if (threads < 1)
+    threads = 1;
+
+  workers = (igraphmodule_i_bh_worker_t*)calloc(threads,
+      sizeof(igraphmodule_i_bh_worker_t));
+  if (!workers)
+    return IGRAPH_ENOMEM;
+
+  job.level = level;
+  job.tree = tree;
+  job.dim = opts->dim;
+  job.theta = opts->theta;
+  job.k = k;
+
+  for (i = 0; i < threads; i++) {
+    workers[i].job = &job;
+    workers[i].from = n * i / threads;
+    workers[i].to = n * (i + 1) / threads;
+  }
+
+  for (iter = 0; !retval && iter < opts->niter && n > 1; iter++) {
+    if (igraphmodule_i_bh_tree_rebuild(tree, pos, level->mass, n, opts->dim)) {
+      retval = IGRAPH_ENOMEM;
+      break;
+    }
+
+    spacing = 2 * tree->cells[0].half / pow(n, 1.0 / opts->dim);
+    if (iter == 0)
+      step *= spacing;
+    if (step < IGRAPHMODULE_BH_TOLERANCE * spacing)
+      break;
+
+    job.step = step;
+    job.pos = pos;
+    job.new_pos = work;
+
+    igraphmodule_run_workers(igraphmodule_i_bh_work, workers, threads, threads);
+
+    energy = 0;
+    for (i = 0; i < threads; i++)
+      energy += workers[i].energy;
+
+    tmp = pos; pos = work; work = tmp;
+
+    if (adaptive && energy < energy0) {
+      if (++progress >= 5) {
+        progress = 0;
+        step /= IGRAPHMODULE_BH_COOLING;
+      }
+    } else {
+      progress = 0;
+      step *= IGRAPHMODULE_BH_COOLING;
+    }
+    energy0 = energy;
+  }
+
+  /* the last positions have to end up in the array of the caller */
+  if (pos != result)
+    memcpy(result, pos, n * opts->dim * sizeof(igraph_real_t));
+
+  free(workers);
+
+  return retval;
+}
+
+/**
+ * \ingroup python_interface_forcelayout
+ * \brief Initial positions of an incremental layout
+ *
+ * The rows of the seed layout give the positions of the first vertices;
+ * rows beyond the end of the seed or with coordinates that are not finite
+ * mark vertices without a position. These are placed in breadth-first
+ * order from the positioned ones, at the mean of their already positioned
+ * neighbors with a little noise; the vertices of components without any
+ * positioned vertex are scattered randomly over the bounding box of the
+ * seed. The natural spring length is estimated from the positioned
+ * vertices so that the seed keeps its scale.
+ *
+ * \param queue scratch space for the vertices
+ */
+static int igraphmodule_i_bh_place_seed(const igraphmodule_i_bh_level_t *level,
+    const igraph_matrix_t *seed, long int dim, igraph_rng_t *rng,
+    igraph_real_t *pos, long int *queue, igraph_real_t *k) {
+  long int n = level->no_of_nodes, rows = igraph_matrix_nrow(seed);
+  long int head = 0, tail = 0, next = 0, v, u, i, j, d, count;
+  igraph_real_t lo[3], hi[3], diff, d2, sum = 0, pairs;
+  char *placed;
+
+  placed = (char*)calloc(n, sizeof(char));
+  if (!placed)
+    return IGRAPH_ENOMEM;
+
+  for (d = 0; d < dim; d++) {
+    lo[d] = IGRAPH_INFINITY;
+    hi[d] = -IGRAPH_INFINITY;
+  }
+  for (v = 0; v < n && v < rows; v++) {
+    placed[v] = 1;
+    for (d = 0; d < dim; d++) {
+      pos[v * dim + d] = MATRIX(*seed, v, d);
+      if (!igraph_finite(pos[v * dim + d]))
+        placed[v] = 0;
+    }
+    if (!placed[v])
+      continue;
+    queue[tail++] = v;
+    for (d = 0; d < dim; d++) {
+      if (pos[v * dim + d] < lo[d]) lo[d] = pos[v * dim + d];
+      if (pos[v * dim + d] > hi[d]) hi[d] = pos[v * dim + d];
+    }
+  }
+
+  /* In equilibrium the virial of the attractive forces, the sum of
+   * w * d^3 / k over the edges, equals that of the repulsive ones, the sum
+   * of C * k^2 over the pairs of vertices */
+  for (v = 0; v < n; v++) {
+    for (j = level->offsets[v]; placed[v] && j < level->offsets[v + 1]; j++) {
+      u = level->neighbors[j];
+      if (u <= v || !placed[u])
+        continue;
+      for (d2 = 0, d = 0; d < dim; d++) {
+        diff = pos[u * dim + d] - pos[v * dim + d];
+        d2 += diff * diff;
+      }
+      sum += level->weights[j] * d2 * sqrt(d2);
+    }
+  }
+  pairs = ((igraph_real_t) tail) * (tail - 1) / 2;
+  *k = sum > 0 && pairs > 0 ? pow(sum / (IGRAPHMODULE_BH_REPULSION * pairs), 1.0 / 3) : 1;
+
+  if (tail == 0) {
+    for (d = 0; d < dim; d++) {
+      lo[d] = -sqrt(n) * *k / 2;
+      hi[d] = sqrt(n) * *k / 2;
+    }
+  }
+
+  while (tail < n) {
+    if (head == tail) {
+      /* a component without positioned vertices, started at random */
+      while (placed[next])
+        next++;
+      for (d = 0; d < dim; d++)
+        pos[next * dim + d] = lo[d] + igraph_rng_get_unif01(rng) * (hi[d] - lo[d]);
+      placed[next] = 1;
+      queue[tail++] = next;
+    }
+
+    v = queue[head++];
+    for (j = level->offsets[v]; j < level->offsets[v + 1]; j++) {
+      u = level->neighbors[j];
+      if (placed[u])
+        continue;
+      /* u has at least one positioned neighbor, namely v */
+      for (d = 0; d < dim; d++)
+        pos[u * dim + d] = 0;
+      for (count = 0, i = level->offsets[u]; i < level->offsets[u + 1]; i++) {
+        if (!placed[level->neighbors[i]])
+          continue;
+        for (d = 0; d < dim; d++)
+          pos[u * dim + d] += pos[level->neighbors[i] * dim + d];
+        count++;
+      }
+      for (d = 0; d < dim; d++) {
+        pos[u * dim + d] = pos[u * dim + d] / count +
+          (igraph_rng_get_unif01(rng) - 0.5) * *k / 2;
+      }
+      placed[u] = 1;
+      queue[tail++] = u;
+    }
+  }
+
+  free(placed);
+
+  return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup python_interface_forcelayout
+ * \brief Calculates a Barnes-Hut force-directed layout
+ *
+ * \param adj the cached adjacency lists of the graph for \c IGRAPH_ALL
+ * \param weights the weights of the edges (multiplying their attraction),
+ *        or a null pointer
+ * \param seed a seed layout with \c dim columns and at most as many rows as
+ *        there are vertices, or a null pointer to start from scratch
+ * \param res the layout is returned here, one row per vertex
+ * \return \c IGRAPH_SUCCESS or an error code of the C core
+ */
+int igraphmodule_layout_barnes_hut(const igraph_t *graph,
+    const igraphmodule_adjacency_t *adj, const igraph_vector_t *weights,
+    const igraph_matrix_t *seed, const igraphmodule_barnes_hut_options_t *opts,
+    igraph_matrix_t *res) {
+  igraphmodule_i_bh_level_t levels[IGRAPHMODULE_BH_MAX_LEVELS];
+  igraphmodule_i_bh_level_t *level;
+  igraphmodule_i_bh_tree_t tree;
+  igraph_rng_t rng;
+  igraph_real_t *pos, *work, *tmp, k = 1, side;
+  long int n = adj->no_of_nodes, dim = opts->dim, no_of_levels = 1, l, v, d;
+  int retval;
+
+  IGRAPH_CHECK(igraph_matrix_resize(res, n, dim));
+  if (n == 0)
+    return IGRAPH_SUCCESS;
+
+  IGRAPH_CHECK(igraph_rng_init(&rng, &igraph_rngtype_mt19937));
+  igraph_rng_seed(&rng, opts->seed);
+
+  memset(levels, 0, sizeof(levels));
+  memset(&tree, 0, sizeof(tree));
+  tree.capacity = 64;
+  tree.cells = (igraphmodule_i_bh_cell_t*)calloc(tree.capacity,
+      sizeof(igraphmodule_i_bh_cell_t));
+  tree.perm = (long int*)calloc(n, sizeof(long int));
+  tree.tmp = (long int*)calloc(n, sizeof(long int));
+  pos = (igraph_real_t*)calloc(n * dim, sizeof(igraph_real_t));
+  work = (igraph_real_t*)calloc(n * dim, sizeof(igraph_real_t));
+
+  retval = igraphmodule_i_bh_level_from_graph(&levels[0], graph, adj, weights);
+  if (!retval && (!tree.cells || !tree.perm || !tree.tmp || !pos || !work))
+    retval = IGRAPH_ENOMEM;
+
+  if (!retval && seed) {
+    /* Incremental layout: refine the seed on the original graph only, with
+     * a short and only decreasing step so that the seed is not torn apart */
+    retval = igraphmodule_i_bh_place_seed(&levels[0], seed, dim, &rng, pos,
+        tree.perm, &k);
+    if (!retval)
+      retval = igraphmodule_i_bh_refine(&levels[0], &tree, pos, work, k,
+          0.1, 0, opts);
+  } else if (!retval) {
+    while (!retval && opts->multilevel && no_of_levels < IGRAPHMODULE_BH_MAX_LEVELS &&
+        levels[no_of_levels - 1].no_of_nodes > IGRAPHMODULE_BH_COARSEST_SIZE) {
+      retval = igraphmodule_i_bh_coarsen(&levels[no_of_levels - 1],
+          &levels[no_of_levels], &rng);
+      if (retval)
+        break;
+      if (levels[no_of_levels].no_of_nodes >
+          IGRAPHMODULE_BH_COARSENING_RATIO * levels[no_of_levels - 1].no_of_nodes) {
+        /* not worth another level */
+        igraphmodule_i_bh_level_destroy(&levels[no_of_levels]);
+        free(levels[no_of_levels - 1].parent);
+        levels[no_of_levels - 1].parent = 0;
+        break;
+      }
+      no_of_levels++;
+    }
+
+    /* The coarsest level starts from random positions; the total mass of
+     * every level is the number of vertices of the original graph */
+    level = &levels[no_of_levels - 1];
+    side = sqrt(n) * k;
+    for (v = 0; v < level->no_of_nodes * dim; v++)
+      pos[v] = (igraph_rng_get_unif01(&rng) - 0.5) * side;
+    if (!retval)
+      retval = igraphmodule_i_bh_refine(level, &tree, pos, work, k, 1, 1, opts);
+
+    /* Each finer level starts from the positions of the coarse vertices
+     * its vertices were collapsed into, with a little noise to separate
+     * the vertices of the same coarse vertex */
+    for (l = no_of_levels - 2; !retval && l >= 0; l--) {
+      level = &levels[l];
+      for (v = 0; v < level->no_of_nodes; v++) {
+        for (d = 0; d < dim; d++) {
+          work[v * dim + d] = pos[level->parent[v] * dim + d] +
+            (igraph_rng_get_unif01(&rng) - 0.5) * k / 10;
+        }
+      }
+      tmp = pos; pos = work; work = tmp;
+      retval = igraphmodule_i_bh_refine(level, &tree, pos, work, k, 0.5, 1, opts);
+    }
+  }
+
+  if (!retval) {
+    for (v = 0; v < n; v++)
+      for (d = 0; d < dim; d++)
+        MATRIX(*res, v, d) = pos[v * dim + d];
+  }
+
+  for (l = 0; l < IGRAPHMODULE_BH_MAX_LEVELS; l++)
+    igraphmodule_i_bh_level_destroy(&levels[l]);
+  free(tree.cells);
+  free(tree.perm);
+  free(tree.tmp);
+  free(pos);
+  free(work);
+  igraph_rng_destroy(&rng);
+
+  return retval;
+}
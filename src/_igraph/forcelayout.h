@@ -0,0 +1,74 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+
+#ifndef PYTHON_FORCELAYOUT_H
+#define PYTHON_FORCELAYOUT_H
+
+#include <Python.h>
+#include <igraph.h>
+#include "adjacency.h"
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_forcelayout Barnes-Hut force-directed layout
+ *
+ * A multilevel spring-electrical layout in the style of Yifan Hu's
+ * algorithm. The repulsion between all pairs of vertices is approximated
+ * with a quadtree (or an octree in 3D) in the manner of Barnes and Hut, so
+ * an iteration takes O(n log n + m) time instead of O(n^2). The graph is
+ * coarsened by collapsing matched edges first; the coarsest graph is laid
+ * out from random positions and each finer graph is refined from the
+ * layout of the coarser one. The forces of an iteration are calculated by
+ * several threads, each of them working on its own range of vertices.
+ *
+ * The functions below do not touch Python objects, so they can be called
+ * without holding the GIL.
+ */
+
+/**
+ * \ingroup python_interface_forcelayout
+ * \brief Parameters of the Barnes-Hut layout
+ */
+typedef struct {
+  // Number of dimensions, 2 or 3
+  long int dim;
+  // Maximum number of iterations on each level of the multilevel scheme
+  long int niter;
+  // Opening criterion: a cell is approximated by its center of mass if its
+  // width divided by its distance is smaller than this
+  igraph_real_t theta;
+  // Whether to coarsen the graph; ignored when a seed layout is given
+  igraph_bool_t multilevel;
+  long int threads;
+  // Seed of the random stream of the initial positions
+  unsigned long int seed;
+} igraphmodule_barnes_hut_options_t;
+
+int igraphmodule_layout_barnes_hut(const igraph_t *graph,
+    const igraphmodule_adjacency_t *adj, const igraph_vector_t *weights,
+    const igraph_matrix_t *seed, const igraphmodule_barnes_hut_options_t *opts,
+    igraph_matrix_t *res);
+
+#endif
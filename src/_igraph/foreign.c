@@ -0,0 +1,848 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include "foreign.h"
+#include "attributes.h"
+#include "columnobject.h"
+#include "error.h"
+#include "py2compat.h"
+#include "pyhelpers.h"
+#include "threading.h"
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+/* Number of vertices or edges whose attributes are copied at once */
+#define IGRAPHMODULE_FOREIGN_CHUNK_SIZE 65536
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief File formats written by the native writers
+ */
+typedef enum {
+  IGRAPHMODULE_FOREIGN_GRAPHML = 0,
+  IGRAPHMODULE_FOREIGN_GML
+} igraphmodule_i_foreign_format_t;
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief The values of an attribute for a chunk of vertices or edges
+ */
+typedef struct {
+  // The list or column holding the values
+  PyObject *values;
+  // The name of the attribute as it appears in the file
+  char *name;
+  // The type of the attribute; numeric, string or Boolean
+  igraph_attribute_type_t type;
+  // The values of a numeric or Boolean attribute
+  double *numbers;
+  char *booleans;
+  // The values of a string attribute as UTF-8 strings in a pool
+  size_t *offsets;
+  char *pool;
+  size_t pool_size, pool_capacity;
+} igraphmodule_i_foreign_column_t;
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief The attributes of the graph, of its vertices or of its edges
+ */
+typedef struct {
+  long int no_of_columns;
+  igraphmodule_i_foreign_column_t *columns;
+  // Whether the columns hold graph attributes, i.e. single values
+  int is_graph;
+} igraphmodule_i_foreign_columns_t;
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Formats a chunk of records without touching any Python object
+ *
+ * \return zero if everything was OK, or the forbidden control character
+ *   found in a string
+ */
+typedef int igraphmodule_i_foreign_chunk_t(FILE *fp, const igraph_t *graph,
+    const igraphmodule_i_foreign_columns_t *cols, int attrnum, long int start,
+    long int end, const void *extra);
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Whether a character may not appear in an XML document at all
+ */
+static int igraphmodule_i_foreign_xml_forbidden(unsigned char ch) {
+  return ch < 0x20 && ch != 0x09 && ch != 0x0A && ch != 0x0D;
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Returns the XML entity replacing a character, if any
+ */
+static const char *igraphmodule_i_foreign_xml_entity(char ch) {
+  switch (ch) {
+    case '&': return "&amp;";
+    case '<': return "&lt;";
+    case '>': return "&gt;";
+    case '"': return "&quot;";
+    case '\'': return "&apos;";
+    default: return 0;
+  }
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Writes a string to an XML file, escaping special characters
+ *
+ * \return zero if everything was OK, or the forbidden control character
+ *   found in the string
+ */
+static int igraphmodule_i_foreign_print_xml(FILE *fp, const char *s) {
+  const char *run = s, *entity;
+
+  for (; *s; s++) {
+    if (igraphmodule_i_foreign_xml_forbidden((unsigned char) *s))
+      return (unsigned char) *s;
+    entity = igraphmodule_i_foreign_xml_entity(*s);
+    if (entity) {
+      fwrite(run, 1, s - run, fp);
+      fputs(entity, fp);
+      run = s + 1;
+    }
+  }
+
+  fwrite(run, 1, s - run, fp);
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Escapes the special characters of a string for XML
+ *
+ * \return the escaped string, or a null pointer if an exception was raised
+ */
+static char *igraphmodule_i_foreign_xml_escape(const char *s) {
+  const char *p, *entity;
+  char *result, *q;
+  size_t length = 1;
+
+  for (p = s; *p; p++) {
+    if (igraphmodule_i_foreign_xml_forbidden((unsigned char) *p)) {
+      PyErr_Format(PyExc_ValueError, "forbidden control character 0x%02X "
+          "in an attribute name", (unsigned char) *p);
+      return 0;
+    }
+    entity = igraphmodule_i_foreign_xml_entity(*p);
+    length += entity ? strlen(entity) : 1;
+  }
+
+  result = (char*) malloc(length);
+  if (result == 0) {
+    PyErr_NoMemory();
+    return 0;
+  }
+
+  for (p = s, q = result; *p; p++) {
+    entity = igraphmodule_i_foreign_xml_entity(*p);
+    if (entity) {
+      strcpy(q, entity);
+      q += strlen(entity);
+    } else {
+      *(q++) = *p;
+    }
+  }
+  *q = 0;
+
+  return result;
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Converts an attribute name to a GML key
+ *
+ * GML keys consist of alphanumeric characters and start with a letter;
+ * other characters are dropped and names not starting with a letter get
+ * an \c igraph prefix, like in the C core.
+ *
+ * \return the key, or a null pointer if an exception was raised
+ */
+static char *igraphmodule_i_foreign_gml_key(const char *s) {
+  const char *prefix = isalpha((unsigned char) s[0]) ? "" : "igraph";
+  char *result, *q;
+
+  result = (char*) malloc(strlen(prefix) + strlen(s) + 1);
+  if (result == 0) {
+    PyErr_NoMemory();
+    return 0;
+  }
+
+  strcpy(result, prefix);
+  for (q = result + strlen(prefix); *s; s++) {
+    if (isalnum((unsigned char) *s))
+      *(q++) = *s;
+  }
+  *q = 0;
+
+  return result;
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Writes a real number with full precision
+ */
+static void igraphmodule_i_foreign_print_real(FILE *fp, double value) {
+  if (isnan(value))
+    fputs("NaN", fp);
+  else if (isinf(value))
+    fputs(value < 0 ? "-Inf" : "Inf", fp);
+  else
+    fprintf(fp, "%.15g", value);
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Frees the attribute columns
+ */
+static void igraphmodule_i_foreign_columns_destroy(igraphmodule_i_foreign_columns_t *cols) {
+  long int i;
+
+  for (i = 0; i < cols->no_of_columns; i++) {
+    igraphmodule_i_foreign_column_t *col = &cols->columns[i];
+    Py_XDECREF(col->values);
+    free(col->name);
+    free(col->numbers);
+    free(col->booleans);
+    free(col->offsets);
+    free(col->pool);
+  }
+
+  free(cols->columns);
+  cols->columns = 0;
+  cols->no_of_columns = 0;
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Sets up the columns for the graph, vertex or edge attributes
+ *
+ * Attributes that are neither numeric, nor strings, nor Boolean are ignored
+ * with a warning, like in the C core. The \c id vertex attribute and the
+ * \c source and \c target edge attributes are not columns in GML files.
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate Python
+ *   exception is raised in this case.
+ */
+static int igraphmodule_i_foreign_columns_init(igraphmodule_i_foreign_columns_t *cols,
+    const igraph_t *graph, int attrnum, igraphmodule_i_foreign_format_t format) {
+  static const igraph_attribute_elemtype_t elemtypes[3] = {
+    IGRAPH_ATTRIBUTE_GRAPH, IGRAPH_ATTRIBUTE_VERTEX, IGRAPH_ATTRIBUTE_EDGE
+  };
+  PyObject *dict = ATTR_STRUCT_DICT(graph)[attrnum], *key, *values;
+  Py_ssize_t pos = 0;
+  long int size = (attrnum == ATTRHASH_IDX_GRAPH) ? 1 : IGRAPHMODULE_FOREIGN_CHUNK_SIZE;
+  igraph_attribute_type_t type;
+  char *name;
+  int skip;
+
+  cols->no_of_columns = 0;
+  cols->is_graph = (attrnum == ATTRHASH_IDX_GRAPH);
+  cols->columns = (igraphmodule_i_foreign_column_t*) calloc(PyDict_Size(dict) + 1,
+      sizeof(igraphmodule_i_foreign_column_t));
+  if (cols->columns == 0) {
+    PyErr_NoMemory();
+    return 1;
+  }
+
+  while (PyDict_Next(dict, &pos, &key, &values)) {
+    igraphmodule_i_foreign_column_t *col = &cols->columns[cols->no_of_columns];
+
+    name = igraphmodule_PyObject_ConvertToCString(key);
+    if (name == 0) {
+      igraphmodule_i_foreign_columns_destroy(cols);
+      return 1;
+    }
+
+    if (igraphmodule_i_attribute_get_type(graph, &type, elemtypes[attrnum], name)) {
+      free(name);
+      igraphmodule_i_foreign_columns_destroy(cols);
+      igraphmodule_handle_igraph_error();
+      return 1;
+    }
+
+    skip = 0;
+    if (format == IGRAPHMODULE_FOREIGN_GML) {
+      skip = (attrnum == ATTRHASH_IDX_VERTEX && !strcmp(name, "id")) ||
+        (attrnum == ATTRHASH_IDX_EDGE && (!strcmp(name, "source") ||
+                                          !strcmp(name, "target")));
+    }
+    if (!skip && type != IGRAPH_ATTRIBUTE_NUMERIC &&
+        type != IGRAPH_ATTRIBUTE_STRING && type != IGRAPH_ATTRIBUTE_BOOLEAN) {
+      char message[256];
+      skip = 1;
+      PyOS_snprintf(message, sizeof(message), "attribute '%.128s' is not "
+          "numeric, string or Boolean, ignored", name);
+      if (PyErr_WarnEx(PyExc_RuntimeWarning, message, 1)) {
+        free(name);
+        igraphmodule_i_foreign_columns_destroy(cols);
+        return 1;
+      }
+    }
+    if (skip) {
+      free(name);
+      continue;
+    }
+
+    col->values = values;
+    Py_INCREF(values);
+    col->type = type;
+    col->name = (format == IGRAPHMODULE_FOREIGN_GML) ?
+      igraphmodule_i_foreign_gml_key(name) : igraphmodule_i_foreign_xml_escape(name);
+    free(name);
+    cols->no_of_columns++;
+    if (col->name == 0) {
+      igraphmodule_i_foreign_columns_destroy(cols);
+      return 1;
+    }
+
+    if (type == IGRAPH_ATTRIBUTE_NUMERIC) {
+      col->numbers = (double*) calloc(size, sizeof(double));
+    } else if (type == IGRAPH_ATTRIBUTE_BOOLEAN) {
+      col->booleans = (char*) calloc(size, sizeof(char));
+    } else {
+      col->offsets = (size_t*) calloc(size, sizeof(size_t));
+    }
+    if (col->numbers == 0 && col->booleans == 0 && col->offsets == 0) {
+      igraphmodule_i_foreign_columns_destroy(cols);
+      PyErr_NoMemory();
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Appends the string form of a value to the pool of a string column
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate Python
+ *   exception is raised in this case.
+ */
+static int igraphmodule_i_foreign_column_add_string(igraphmodule_i_foreign_column_t *col,
+    long int index, PyObject *item) {
+  PyObject *str;
+  const char *utf8;
+  Py_ssize_t length;
+
+#ifdef IGRAPH_PYTHON3
+  if (PyUnicode_Check(item) || PyBytes_Check(item)) {
+    str = item;
+    Py_INCREF(str);
+  } else {
+    str = PyObject_Str(item);
+  }
+  if (str == 0)
+    return 1;
+  if (PyBytes_Check(str)) {
+    utf8 = PyBytes_AS_STRING(str);
+    length = PyBytes_GET_SIZE(str);
+  } else {
+    utf8 = PyUnicode_AsUTF8AndSize(str, &length);
+  }
+#else
+  if (PyUnicode_Check(item)) {
+    str = PyUnicode_AsUTF8String(item);
+  } else if (PyString_Check(item)) {
+    str = item;
+    Py_INCREF(str);
+  } else {
+    str = PyObject_Str(item);
+  }
+  if (str == 0)
+    return 1;
+  utf8 = PyString_AsString(str);
+  length = utf8 ? PyString_GET_SIZE(str) : 0;
+#endif
+
+  if (utf8 == 0) {
+    Py_DECREF(str);
+    return 1;
+  }
+
+  if (col->pool_size + length + 1 > col->pool_capacity) {
+    size_t capacity = 2 * col->pool_capacity;
+    char *pool;
+    if (capacity < col->pool_size + length + 1)
+      capacity = col->pool_size + length + 1;
+    pool = (char*) realloc(col->pool, capacity);
+    if (pool == 0) {
+      Py_DECREF(str);
+      PyErr_NoMemory();
+      return 1;
+    }
+    col->pool = pool;
+    col->pool_capacity = capacity;
+  }
+
+  memcpy(col->pool + col->pool_size, utf8, length);
+  col->pool[col->pool_size + length] = 0;
+  col->offsets[index] = col->pool_size;
+  col->pool_size += length + 1;
+
+  Py_DECREF(str);
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Copies the attribute values of the records from \c start to \c end
+ *        into the columns
+ *
+ * Values are converted like in the attribute handler: \c None becomes NaN
+ * in numeric attributes and other values of string attributes are
+ * converted with \c str().
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate Python
+ *   exception is raised in this case.
+ */
+static int igraphmodule_i_foreign_columns_fill(igraphmodule_i_foreign_columns_t *cols,
+    long int start, long int end) {
+  long int i, j;
+  PyObject *item;
+  double value;
+  int truth;
+
+  for (j = 0; j < cols->no_of_columns; j++) {
+    igraphmodule_i_foreign_column_t *col = &cols->columns[j];
+    igraphmodule_ColumnObject *column = 0;
+
+    if (!cols->is_graph && igraphmodule_Column_Check(col->values))
+      column = (igraphmodule_ColumnObject*) col->values;
+
+    col->pool_size = 0;
+    for (i = start; i < end; i++) {
+      if (column != 0 && i >= column->size) {
+        PyErr_SetString(PyExc_IndexError, "attribute index out of range");
+        return 1;
+      }
+
+      /* Typed columns are copied without creating Python objects */
+      if (column != 0 && col->type == IGRAPH_ATTRIBUTE_NUMERIC) {
+        col->numbers[i - start] = igraphmodule_Column_get_real(column, i);
+        continue;
+      }
+      if (column != 0 && col->type == IGRAPH_ATTRIBUTE_BOOLEAN) {
+        col->booleans[i - start] = igraphmodule_Column_get_bool(column, i);
+        continue;
+      }
+
+      if (cols->is_graph) {
+        item = col->values;
+        Py_INCREF(item);
+      } else {
+        item = igraphmodule_attribute_values_get_item(col->values, i);
+        if (item == 0)
+          return 1;
+      }
+
+      if (col->type == IGRAPH_ATTRIBUTE_NUMERIC) {
+        value = (item == Py_None) ? NAN : PyFloat_AsDouble(item);
+        Py_DECREF(item);
+        if (value == -1.0 && PyErr_Occurred())
+          return 1;
+        col->numbers[i - start] = value;
+      } else if (col->type == IGRAPH_ATTRIBUTE_BOOLEAN) {
+        truth = PyObject_IsTrue(item);
+        Py_DECREF(item);
+        if (truth < 0)
+          return 1;
+        col->booleans[i - start] = truth;
+      } else {
+        truth = igraphmodule_i_foreign_column_add_string(col, i - start, item);
+        Py_DECREF(item);
+        if (truth)
+          return 1;
+      }
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Writes the records of the graph, its vertices or its edges in
+ *        chunks, releasing the GIL while formatting each chunk if the C core
+ *        is thread-safe
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate Python
+ *   exception is raised in this case.
+ */
+static int igraphmodule_i_foreign_write_records(igraphmodule_GraphObject *self,
+    FILE *fp, igraphmodule_i_foreign_columns_t *cols, int attrnum, long int n,
+    igraphmodule_i_foreign_chunk_t *write_chunk, const void *extra) {
+  long int start, end;
+  int forbidden;
+
+  for (start = 0; start < n; start = end) {
+    end = (n - start > IGRAPHMODULE_FOREIGN_CHUNK_SIZE) ?
+      start + IGRAPHMODULE_FOREIGN_CHUNK_SIZE : n;
+
+    if (igraphmodule_i_foreign_columns_fill(cols, start, end))
+      return 1;
+
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    forbidden = write_chunk(fp, &self->g, cols, attrnum, start, end, extra);
+    IGRAPHMODULE_END_NOGIL(self);
+
+    if (forbidden) {
+      PyErr_Format(PyExc_ValueError, "forbidden control character 0x%02X "
+          "in a string attribute", forbidden);
+      return 1;
+    }
+    if (ferror(fp)) {
+      PyErr_SetFromErrno(PyExc_IOError);
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Writes the \c data elements of a GraphML record
+ */
+static int igraphmodule_i_foreign_graphml_data(FILE *fp,
+    const igraphmodule_i_foreign_columns_t *cols, long int index,
+    const char *indent, const char *prefix) {
+  long int j;
+  int forbidden;
+
+  for (j = 0; j < cols->no_of_columns; j++) {
+    const igraphmodule_i_foreign_column_t *col = &cols->columns[j];
+    if (col->type == IGRAPH_ATTRIBUTE_NUMERIC) {
+      if (!isnan(col->numbers[index])) {
+        fprintf(fp, "%s<data key=\"%s%s\">", indent, prefix, col->name);
+        igraphmodule_i_foreign_print_real(fp, col->numbers[index]);
+        fputs("</data>\n", fp);
+      }
+    } else if (col->type == IGRAPH_ATTRIBUTE_BOOLEAN) {
+      fprintf(fp, "%s<data key=\"%s%s\">%s</data>\n", indent, prefix, col->name,
+          col->booleans[index] ? "true" : "false");
+    } else {
+      fprintf(fp, "%s<data key=\"%s%s\">", indent, prefix, col->name);
+      forbidden = igraphmodule_i_foreign_print_xml(fp, col->pool + col->offsets[index]);
+      if (forbidden)
+        return forbidden;
+      fputs("</data>\n", fp);
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Writes a chunk of the GraphML file
+ */
+static int igraphmodule_i_foreign_graphml_chunk(FILE *fp, const igraph_t *graph,
+    const igraphmodule_i_foreign_columns_t *cols, int attrnum, long int start,
+    long int end, const void *extra) {
+  const char *prefix = (const char*) extra;
+  long int i;
+  int forbidden;
+
+  for (i = start; i < end; i++) {
+    if (attrnum == ATTRHASH_IDX_VERTEX) {
+      fprintf(fp, "    <node id=\"n%ld\">\n", i);
+    } else if (attrnum == ATTRHASH_IDX_EDGE) {
+      fprintf(fp, "    <edge source=\"n%ld\" target=\"n%ld\">\n",
+          (long int) IGRAPH_FROM(graph, i), (long int) IGRAPH_TO(graph, i));
+    }
+
+    forbidden = igraphmodule_i_foreign_graphml_data(fp, cols, i - start,
+        attrnum == ATTRHASH_IDX_GRAPH ? "    " : "      ", prefix);
+    if (forbidden)
+      return forbidden;
+
+    if (attrnum == ATTRHASH_IDX_VERTEX) {
+      fputs("    </node>\n", fp);
+    } else if (attrnum == ATTRHASH_IDX_EDGE) {
+      fputs("    </edge>\n", fp);
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Writes the graph to a GraphML file
+ *
+ * \param prefixattr whether to prefix the keys of the attributes with
+ *        \c g_, \c v_ and \c e_ (so graph, vertex and edge attributes with
+ *        the same name do not clash)
+ * \return 0 if everything was OK, 1 otherwise. An appropriate Python
+ *   exception is raised in this case.
+ */
+int igraphmodule_write_graphml(igraphmodule_GraphObject *self, FILE *fp,
+    igraph_bool_t prefixattr) {
+  static const char *elements[3] = { "graph", "node", "edge" };
+  const char *prefixes[3] = { "g_", "v_", "e_" };
+  igraphmodule_i_foreign_columns_t cols[3];
+  long int counts[3];
+  long int i, j;
+  int retval = 0;
+
+  counts[0] = 1;
+  counts[1] = igraph_vcount(&self->g);
+  counts[2] = igraph_ecount(&self->g);
+  if (!prefixattr) {
+    prefixes[0] = prefixes[1] = prefixes[2] = "";
+  }
+
+  memset(cols, 0, sizeof(cols));
+  for (i = 0; i < 3 && !retval; i++) {
+    retval = igraphmodule_i_foreign_columns_init(&cols[i], &self->g, i,
+        IGRAPHMODULE_FOREIGN_GRAPHML);
+  }
+
+  if (!retval) {
+    fputs("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\"\n"
+        "         xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"\n"
+        "         xsi:schemaLocation=\"http://graphml.graphdrawing.org/xmlns\n"
+        "         http://graphml.graphdrawing.org/xmlns/1.0/graphml.xsd\">\n"
+        "<!-- Created by igraph -->\n", fp);
+    for (i = 0; i < 3; i++) {
+      for (j = 0; j < cols[i].no_of_columns; j++) {
+        igraph_attribute_type_t type = cols[i].columns[j].type;
+        fprintf(fp, "  <key id=\"%s%s\" for=\"%s\" attr.name=\"%s\" attr.type=\"%s\"/>\n",
+            prefixes[i], cols[i].columns[j].name, elements[i], cols[i].columns[j].name,
+            type == IGRAPH_ATTRIBUTE_NUMERIC ? "double" :
+            type == IGRAPH_ATTRIBUTE_BOOLEAN ? "boolean" : "string");
+      }
+    }
+    fprintf(fp, "  <graph id=\"G\" edgedefault=\"%s\">\n",
+        igraph_is_directed(&self->g) ? "directed" : "undirected");
+  }
+
+  for (i = 0; i < 3 && !retval; i++) {
+    retval = igraphmodule_i_foreign_write_records(self, fp, &cols[i], i, counts[i],
+        igraphmodule_i_foreign_graphml_chunk, prefixes[i]);
+  }
+
+  if (!retval) {
+    fputs("  </graph>\n</graphml>\n", fp);
+  }
+
+  for (i = 0; i < 3; i++) {
+    igraphmodule_i_foreign_columns_destroy(&cols[i]);
+  }
+
+  return retval;
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Writes the attributes of a GML record
+ */
+static void igraphmodule_i_foreign_gml_data(FILE *fp,
+    const igraphmodule_i_foreign_columns_t *cols, long int index,
+    const char *indent) {
+  long int j;
+
+  for (j = 0; j < cols->no_of_columns; j++) {
+    const igraphmodule_i_foreign_column_t *col = &cols->columns[j];
+    if (col->type == IGRAPH_ATTRIBUTE_NUMERIC) {
+      fprintf(fp, "%s%s ", indent, col->name);
+      igraphmodule_i_foreign_print_real(fp, col->numbers[index]);
+      fputc('\n', fp);
+    } else if (col->type == IGRAPH_ATTRIBUTE_BOOLEAN) {
+      fprintf(fp, "%s%s %d\n", indent, col->name, col->booleans[index] ? 1 : 0);
+    } else {
+      fprintf(fp, "%s%s \"%s\"\n", indent, col->name, col->pool + col->offsets[index]);
+    }
+  }
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Writes a chunk of the GML file
+ */
+static int igraphmodule_i_foreign_gml_chunk(FILE *fp, const igraph_t *graph,
+    const igraphmodule_i_foreign_columns_t *cols, int attrnum, long int start,
+    long int end, const void *extra) {
+  const long int *ids = (const long int*) extra;
+  long int i, from, to;
+
+  for (i = start; i < end; i++) {
+    if (attrnum == ATTRHASH_IDX_VERTEX) {
+      fprintf(fp, "  node\n  [\n    id %ld\n", ids ? ids[i] : i);
+    } else if (attrnum == ATTRHASH_IDX_EDGE) {
+      from = IGRAPH_FROM(graph, i);
+      to = IGRAPH_TO(graph, i);
+      fprintf(fp, "  edge\n  [\n    source %ld\n    target %ld\n",
+          ids ? ids[from] : from, ids ? ids[to] : to);
+    }
+
+    igraphmodule_i_foreign_gml_data(fp, cols, i - start,
+        attrnum == ATTRHASH_IDX_GRAPH ? "  " : "    ");
+
+    if (attrnum != ATTRHASH_IDX_GRAPH) {
+      fputs("  ]\n", fp);
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Determines the GML identifiers of the vertices
+ *
+ * The identifiers are taken from \c id if it is given, from the numeric
+ * \c id vertex attribute if there is one, otherwise the vertex IDs are
+ * used and \c *ids is set to a null pointer.
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate Python
+ *   exception is raised in this case.
+ */
+static int igraphmodule_i_foreign_gml_ids(const igraph_t *graph,
+    const igraph_vector_t *id, long int **ids) {
+  long int i, n = igraph_vcount(graph);
+  igraph_attribute_type_t type;
+  PyObject *values = 0, *item;
+  double value;
+
+  *ids = 0;
+
+  if (id != 0) {
+    if (igraph_vector_size(id) != n) {
+      PyErr_SetString(PyExc_ValueError, "the length of the ID list must be "
+          "equal to the number of vertices");
+      return 1;
+    }
+  } else {
+    values = PyDict_GetItemString(ATTR_STRUCT_DICT(graph)[ATTRHASH_IDX_VERTEX], "id");
+    if (values == 0)
+      return 0;
+    if (igraphmodule_i_attribute_get_type(graph, &type, IGRAPH_ATTRIBUTE_VERTEX, "id")) {
+      igraphmodule_handle_igraph_error();
+      return 1;
+    }
+    if (type != IGRAPH_ATTRIBUTE_NUMERIC)
+      return 0;
+  }
+
+  *ids = (long int*) calloc(n > 0 ? n : 1, sizeof(long int));
+  if (*ids == 0) {
+    PyErr_NoMemory();
+    return 1;
+  }
+
+  for (i = 0; i < n; i++) {
+    if (id != 0) {
+      value = VECTOR(*id)[i];
+    } else {
+      item = igraphmodule_attribute_values_get_item(values, i);
+      if (item == 0) {
+        free(*ids); *ids = 0;
+        return 1;
+      }
+      value = (item == Py_None) ? NAN : PyFloat_AsDouble(item);
+      Py_DECREF(item);
+      if (value == -1.0 && PyErr_Occurred()) {
+        free(*ids); *ids = 0;
+        return 1;
+      }
+    }
+    (*ids)[i] = (long int) value;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_foreign
+ * \brief Writes the graph to a GML file
+ *
+ * \param id the GML identifiers of the vertices, or a null pointer to use
+ *        the \c id vertex attribute or the vertex IDs
+ * \param creator the value of the \c Creator field, or a null pointer to
+ *        use the version of igraph and the current date
+ * \return 0 if everything was OK, 1 otherwise. An appropriate Python
+ *   exception is raised in this case.
+ */
+int igraphmodule_write_gml(igraphmodule_GraphObject *self, FILE *fp,
+    const igraph_vector_t *id, const char *creator) {
+  igraphmodule_i_foreign_columns_t cols[3];
+  long int counts[3];
+  long int i, *ids = 0;
+  int retval = 0;
+
+  counts[0] = 1;
+  counts[1] = igraph_vcount(&self->g);
+  counts[2] = igraph_ecount(&self->g);
+
+  memset(cols, 0, sizeof(cols));
+  for (i = 0; i < 3 && !retval; i++) {
+    retval = igraphmodule_i_foreign_columns_init(&cols[i], &self->g, i,
+        IGRAPHMODULE_FOREIGN_GML);
+  }
+  if (!retval) {
+    retval = igraphmodule_i_foreign_gml_ids(&self->g, id, &ids);
+  }
+
+  if (!retval) {
+    if (creator) {
+      fprintf(fp, "Creator \"%s\"\n", creator);
+    } else {
+      time_t now = time(0);
+      char *timestr = ctime(&now);
+      timestr[strlen(timestr) - 1] = 0;   /* remove the trailing newline */
+      fprintf(fp, "Creator \"igraph version %s %s\"\n", IGRAPH_VERSION, timestr);
+    }
+    fprintf(fp, "Version 1\ngraph\n[\n  directed %d\n",
+        igraph_is_directed(&self->g) ? 1 : 0);
+  }
+
+  for (i = 0; i < 3 && !retval; i++) {
+    retval = igraphmodule_i_foreign_write_records(self, fp, &cols[i], i, counts[i],
+        igraphmodule_i_foreign_gml_chunk, ids);
+  }
+
+  if (!retval) {
+    fputs("]\n", fp);
+  }
+
+  free(ids);
+  for (i = 0; i < 3; i++) {
+    igraphmodule_i_foreign_columns_destroy(&cols[i]);
+  }
+
+  return retval;
+}
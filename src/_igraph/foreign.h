@@ -0,0 +1,49 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef PYTHON_FOREIGN_H
+#define PYTHON_FOREIGN_H
+
+#include <Python.h>
+#include <stdio.h>
+#include "graphobject.h"
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_foreign Writing graphs with attributes to files
+ *
+ * These writers produce the same output as the writers of the C core, but
+ * they do not query the attribute handler once per vertex or edge. The
+ * attributes are copied into typed C arrays in chunks of vertices and edges
+ * instead, and each chunk is formatted in \ref IGRAPHMODULE_BEGIN_NOGIL,
+ * i.e. without holding the GIL if the C core is thread-safe. The core
+ * bundled with python-igraph is not, so the GIL is kept with it.
+ */
+
+int igraphmodule_write_graphml(igraphmodule_GraphObject *self, FILE *fp,
+    igraph_bool_t prefixattr);
+int igraphmodule_write_gml(igraphmodule_GraphObject *self, FILE *fp,
+    const igraph_vector_t *id, const char *creator);
+
+#endif
@@ -0,0 +1,850 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include "generators.h"
+#include "common.h"
+#include "convert.h"
+#include "error.h"
+#include "filehandle.h"
+#include "graphobject.h"
+#include "py2compat.h"
+#include "threading.h"
+#include <errno.h>
+#include <math.h>
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Number of rows of the adjacency matrix in a block of an SBM
+ */
+#define IGRAPHMODULE_GENERATOR_ROWS_PER_BLOCK 1024
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Number of edges in a block of the fitness and ring models
+ */
+#define IGRAPHMODULE_GENERATOR_EDGES_PER_BLOCK 65536
+
+/**
+ * \ingroup python_interface_generators
+ * \brief A worker of the generator, generating one block in every round
+ */
+typedef struct {
+  igraphmodule_generator_t *gen;
+  // The block to generate in the current round, -1 if there is none
+  long int block;
+  igraph_rng_t rng;
+  igraph_bool_t has_rng;
+  // Endpoints of the edges of the block; edge i is (edges[2i], edges[2i+1])
+  PY_LONG_LONG *edges;
+  long int size, capacity;
+  // Whether the worker ran out of memory
+  igraph_bool_t nomem;
+} igraphmodule_i_generator_worker_t;
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Initializes a generator with no model
+ */
+void igraphmodule_generator_init(igraphmodule_generator_t *gen) {
+  memset(gen, 0, sizeof(igraphmodule_generator_t));
+  gen->threads = 1;
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Frees the memory used by a generator
+ */
+void igraphmodule_generator_destroy(igraphmodule_generator_t *gen) {
+  free(gen->block_start);
+  free(gen->pref);
+  free(gen->out_prob);
+  free(gen->out_alias);
+  free(gen->in_prob);
+  free(gen->in_alias);
+  igraphmodule_generator_init(gen);
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Sets the number of threads and the seed of a generator
+ *
+ * \param threads_o the number of threads; \c None means one
+ * \param seed_o the seed of the random streams; \c None means a seed drawn
+ *        from the default random number generator of igraph
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+int igraphmodule_generator_set_options(igraphmodule_generator_t *gen,
+    PyObject *threads_o, PyObject *seed_o) {
+  if (threads_o != 0 && threads_o != Py_None) {
+    gen->threads = PyInt_AsLong(threads_o);
+    if (PyErr_Occurred())
+      return 1;
+    if (gen->threads <= 0) {
+      PyErr_SetString(PyExc_ValueError, "threads must be positive");
+      return 1;
+    }
+  }
+
+  if (seed_o == 0 || seed_o == Py_None) {
+    gen->seed = (unsigned long int) igraph_rng_get_integer(igraph_rng_default(),
+        0, 0x7fffffffL);
+  } else {
+    gen->seed = PyLong_AsUnsignedLongMask(seed_o);
+    if (PyErr_Occurred())
+      return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Sets up a stochastic block model
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+int igraphmodule_generator_set_sbm(igraphmodule_generator_t *gen,
+    long int n, const igraph_matrix_t *pref, const igraph_vector_int_t *block_sizes,
+    igraph_bool_t directed, igraph_bool_t loops) {
+  long int i, j, k = igraph_vector_int_size(block_sizes);
+  double p;
+
+  if (n < 0) {
+    PyErr_SetString(PyExc_ValueError, "number of vertices must be non-negative");
+    return 1;
+  }
+  if (igraph_matrix_nrow(pref) != k || igraph_matrix_ncol(pref) != k) {
+    PyErr_SetString(PyExc_ValueError, "preference matrix must be a square "
+        "matrix with one row per block");
+    return 1;
+  }
+  for (i = 0; i < k; i++) {
+    for (j = 0; j < k; j++) {
+      p = MATRIX(*pref, i, j);
+      if (!(p >= 0 && p <= 1)) {
+        PyErr_SetString(PyExc_ValueError, "edge probabilities must be "
+            "between 0 and 1");
+        return 1;
+      }
+      if (!directed && p != MATRIX(*pref, j, i)) {
+        PyErr_SetString(PyExc_ValueError, "preference matrix must be "
+            "symmetric for undirected graphs");
+        return 1;
+      }
+    }
+  }
+
+  gen->block_start = (long int*)calloc(k + 1, sizeof(long int));
+  gen->pref = (double*)calloc(k > 0 ? k * k : 1, sizeof(double));
+  if (!gen->block_start || !gen->pref) {
+    PyErr_NoMemory();
+    return 1;
+  }
+  for (i = 0; i < k; i++) {
+    if (VECTOR(*block_sizes)[i] < 0) {
+      PyErr_SetString(PyExc_ValueError, "block sizes must be non-negative");
+      return 1;
+    }
+    gen->block_start[i + 1] = gen->block_start[i] + VECTOR(*block_sizes)[i];
+    for (j = 0; j < k; j++) {
+      gen->pref[i * k + j] = MATRIX(*pref, i, j);
+    }
+  }
+  if (gen->block_start[k] != n) {
+    PyErr_SetString(PyExc_ValueError, "block sizes must sum up to the number "
+        "of vertices");
+    return 1;
+  }
+
+  gen->model = IGRAPHMODULE_GENERATOR_SBM;
+  gen->no_of_nodes = n;
+  gen->no_of_blocks = k;
+  gen->directed = directed;
+  gen->loops = loops;
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Sets up an Erdos-Renyi G(n,p) model, i.e. an SBM with one block
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+int igraphmodule_generator_set_gnp(igraphmodule_generator_t *gen,
+    long int n, double p, igraph_bool_t directed, igraph_bool_t loops) {
+  if (n < 0) {
+    PyErr_SetString(PyExc_ValueError, "number of vertices must be non-negative");
+    return 1;
+  }
+  if (!(p >= 0 && p <= 1)) {
+    PyErr_SetString(PyExc_ValueError, "edge probability must be between 0 and 1");
+    return 1;
+  }
+
+  gen->block_start = (long int*)calloc(2, sizeof(long int));
+  gen->pref = (double*)calloc(1, sizeof(double));
+  if (!gen->block_start || !gen->pref) {
+    PyErr_NoMemory();
+    return 1;
+  }
+  gen->block_start[1] = n;
+  gen->pref[0] = p;
+
+  gen->model = IGRAPHMODULE_GENERATOR_SBM;
+  gen->no_of_nodes = n;
+  gen->no_of_blocks = 1;
+  gen->directed = directed;
+  gen->loops = loops;
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Builds the alias table of a fitness vector
+ *
+ * \param fitness the fitness values; overwritten by the probabilities of
+ *        the alias table
+ * \param no_of_positive the number of positive fitness values on exit
+ * \param positive the index of a positive fitness value on exit
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+static int igraphmodule_i_generator_alias_table(long int n, double *fitness,
+    long int **alias, long int *no_of_positive, long int *positive) {
+  double *scaled;
+  long int i, *small, *large;
+
+  for (i = 0, *no_of_positive = 0; i < n; i++) {
+    if (!(fitness[i] >= 0) || !igraph_finite(fitness[i])) {
+      PyErr_SetString(PyExc_ValueError, "fitness values must be finite and "
+          "non-negative");
+      return 1;
+    }
+    if (fitness[i] > 0) {
+      (*no_of_positive)++;
+      *positive = i;
+    }
+  }
+
+  *alias = (long int*)calloc(n > 0 ? n : 1, sizeof(long int));
+  scaled = (double*)calloc(n > 0 ? n : 1, sizeof(double));
+  small = (long int*)calloc(n > 0 ? n : 1, sizeof(long int));
+  large = (long int*)calloc(n > 0 ? n : 1, sizeof(long int));
+  if (!*alias || !scaled || !small || !large) {
+    free(scaled); free(small); free(large);
+    PyErr_NoMemory();
+    return 1;
+  }
+
+  if (*no_of_positive > 0) {
+    igraphmodule_alias_table(n, fitness, *alias, scaled, small, large);
+  }
+
+  free(scaled); free(small); free(large);
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Sets up a static fitness model from fitness arrays
+ *
+ * The generator takes over the arrays.
+ */
+static int igraphmodule_i_generator_set_fitness(igraphmodule_generator_t *gen,
+    long int m, long int n, double *fitness_out, double *fitness_in,
+    igraph_bool_t loops) {
+  long int positive_out, positive_in = 0, out_index = -1, in_index = -1;
+
+  gen->out_prob = fitness_out;
+  gen->in_prob = fitness_in;
+
+  if (m < 0) {
+    PyErr_SetString(PyExc_ValueError, "number of edges must be non-negative");
+    return 1;
+  }
+  if (igraphmodule_i_generator_alias_table(n, gen->out_prob, &gen->out_alias,
+        &positive_out, &out_index))
+    return 1;
+  if (fitness_in && igraphmodule_i_generator_alias_table(n, gen->in_prob,
+        &gen->in_alias, &positive_in, &in_index))
+    return 1;
+
+  if (m > 0) {
+    if (positive_out == 0 || (fitness_in && positive_in == 0)) {
+      PyErr_SetString(PyExc_ValueError, "at least one fitness value must "
+          "be positive");
+      return 1;
+    }
+    /* Without loops, the only possible edge must not be a loop */
+    if (!loops && positive_out == 1 && (!fitness_in || positive_in == 1) &&
+        (!fitness_in || out_index == in_index)) {
+      PyErr_SetString(PyExc_ValueError, "at least two fitness values must "
+          "be positive if loops are not allowed");
+      return 1;
+    }
+  }
+
+  gen->model = IGRAPHMODULE_GENERATOR_FITNESS;
+  gen->no_of_nodes = n;
+  gen->no_of_edges = m;
+  gen->directed = fitness_in != 0;
+  gen->loops = loops;
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Copies an igraph vector into a newly allocated array
+ */
+static double* igraphmodule_i_generator_copy_vector(const igraph_vector_t *v) {
+  long int i, n = igraph_vector_size(v);
+  double *result = (double*)calloc(n > 0 ? n : 1, sizeof(double));
+
+  if (!result) {
+    PyErr_NoMemory();
+    return 0;
+  }
+  for (i = 0; i < n; i++) {
+    result[i] = VECTOR(*v)[i];
+  }
+
+  return result;
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Sets up a static fitness model where multiple edges are allowed
+ *
+ * \param fitness_in the in-fitness of the vertices in a directed graph, or
+ *        a null pointer for undirected graphs
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+int igraphmodule_generator_set_fitness(igraphmodule_generator_t *gen,
+    long int m, const igraph_vector_t *fitness_out, const igraph_vector_t *fitness_in,
+    igraph_bool_t loops) {
+  long int n = igraph_vector_size(fitness_out);
+  double *out, *in = 0;
+
+  if (fitness_in && igraph_vector_size(fitness_in) != n) {
+    PyErr_SetString(PyExc_ValueError, "fitness_out and fitness_in must have "
+        "the same length");
+    return 1;
+  }
+
+  out = igraphmodule_i_generator_copy_vector(fitness_out);
+  if (!out)
+    return 1;
+  if (fitness_in) {
+    in = igraphmodule_i_generator_copy_vector(fitness_in);
+    if (!in) {
+      free(out);
+      return 1;
+    }
+  }
+
+  return igraphmodule_i_generator_set_fitness(gen, m, n, out, in, loops);
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Computes the fitness values of a static power-law model in the
+ *        same way as \c igraph_static_power_law_game()
+ */
+static double* igraphmodule_i_generator_power_law_fitness(long int n,
+    double exponent, igraph_bool_t finite_size_correction) {
+  double alpha = -1.0 / (exponent - 1), j = n, *fitness;
+  long int i;
+
+  fitness = (double*)calloc(n > 0 ? n : 1, sizeof(double));
+  if (!fitness) {
+    PyErr_NoMemory();
+    return 0;
+  }
+
+  /* See the paper of Cho et al, first page first column + footnote 7 */
+  if (finite_size_correction && alpha < -0.5) {
+    j = pow(n, 1 + 0.5 / alpha) * pow(10 * sqrt(2) * (1 + alpha), -1.0 / alpha) - 1;
+  }
+  if (j < n) {
+    j = n;
+  }
+  for (i = 0; i < n; i++, j--) {
+    fitness[i] = pow(j, alpha);
+  }
+
+  return fitness;
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Sets up a static power-law model where multiple edges are allowed
+ *
+ * \param exponent_in the exponent of the in-degree distribution, or a
+ *        negative number for undirected graphs
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+int igraphmodule_generator_set_power_law(igraphmodule_generator_t *gen,
+    long int n, long int m, double exponent_out, double exponent_in,
+    igraph_bool_t loops, igraph_bool_t finite_size_correction) {
+  double *out, *in = 0;
+
+  if (n < 0) {
+    PyErr_SetString(PyExc_ValueError, "number of vertices must be non-negative");
+    return 1;
+  }
+  if (exponent_out < 2) {
+    PyErr_SetString(PyExc_ValueError, "out-degree exponent must be >= 2");
+    return 1;
+  }
+  if (exponent_in >= 0 && exponent_in < 2) {
+    PyErr_SetString(PyExc_ValueError, "in-degree exponent must be >= 2 "
+        "(or negative for undirected graphs)");
+    return 1;
+  }
+
+  out = igraphmodule_i_generator_power_law_fitness(n, exponent_out,
+      finite_size_correction);
+  if (!out)
+    return 1;
+  if (exponent_in >= 0) {
+    in = igraphmodule_i_generator_power_law_fitness(n, exponent_in,
+        finite_size_correction);
+    if (!in) {
+      free(out);
+      return 1;
+    }
+  }
+
+  return igraphmodule_i_generator_set_fitness(gen, m, n, out, in, loops);
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Sets up a one-dimensional Watts-Strogatz model where the rewired
+ *        edges may become multiple edges
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+int igraphmodule_generator_set_ring(igraphmodule_generator_t *gen,
+    long int n, long int nei, double p, igraph_bool_t loops) {
+  if (nei < 1 || 2 * nei >= n) {
+    PyErr_SetString(PyExc_ValueError, "neighborhood size must be positive "
+        "and less than half of the number of vertices");
+    return 1;
+  }
+  if (!(p >= 0 && p <= 1)) {
+    PyErr_SetString(PyExc_ValueError, "rewiring probability must be between "
+        "0 and 1");
+    return 1;
+  }
+
+  gen->model = IGRAPHMODULE_GENERATOR_RING;
+  gen->no_of_nodes = n;
+  gen->no_of_edges = n * nei;
+  gen->nei = nei;
+  gen->p = p;
+  gen->directed = 0;
+  gen->loops = loops;
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Returns the number of blocks the edges of a generator are
+ *        divided into
+ */
+static long int igraphmodule_i_generator_no_of_blocks(const igraphmodule_generator_t *gen) {
+  if (gen->model == IGRAPHMODULE_GENERATOR_SBM) {
+    return (gen->no_of_nodes + IGRAPHMODULE_GENERATOR_ROWS_PER_BLOCK - 1) /
+      IGRAPHMODULE_GENERATOR_ROWS_PER_BLOCK;
+  }
+  return (gen->no_of_edges + IGRAPHMODULE_GENERATOR_EDGES_PER_BLOCK - 1) /
+    IGRAPHMODULE_GENERATOR_EDGES_PER_BLOCK;
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Appends an edge to the current block of a worker
+ *
+ * \return 0 if everything was OK, 1 if the worker ran out of memory
+ */
+static int igraphmodule_i_generator_push(igraphmodule_i_generator_worker_t *w,
+    long int from, long int to) {
+  PY_LONG_LONG *edges;
+  long int capacity;
+
+  if (w->size + 2 > w->capacity) {
+    capacity = w->capacity > 0 ? 2 * w->capacity : 1024;
+    edges = (PY_LONG_LONG*)realloc(w->edges, capacity * sizeof(PY_LONG_LONG));
+    if (!edges) {
+      w->nomem = 1;
+      return 1;
+    }
+    w->edges = edges;
+    w->capacity = capacity;
+  }
+
+  w->edges[w->size++] = from;
+  w->edges[w->size++] = to;
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Draws an item from an alias table
+ */
+static long int igraphmodule_i_generator_sample(igraph_rng_t *rng, long int n,
+    const double *prob, const long int *alias) {
+  long int j = (long int) igraph_rng_get_integer(rng, 0, n - 1);
+  return igraph_rng_get_unif01(rng) < prob[j] ? j : alias[j];
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Generates a block of rows of a stochastic block model
+ *
+ * The columns of every row are visited block by block; the gaps between
+ * the edges in a block are geometrically distributed, so the running time
+ * is proportional to the number of edges.
+ */
+static void igraphmodule_i_generator_sbm_block(igraphmodule_i_generator_worker_t *w) {
+  igraphmodule_generator_t *gen = w->gen;
+  long int u, u_end, r, s, k = gen->no_of_blocks, lo, hi, v;
+  double p, lp, skip;
+
+  u = w->block * IGRAPHMODULE_GENERATOR_ROWS_PER_BLOCK;
+  u_end = u + IGRAPHMODULE_GENERATOR_ROWS_PER_BLOCK;
+  if (u_end > gen->no_of_nodes) {
+    u_end = gen->no_of_nodes;
+  }
+
+  for (r = 0; gen->block_start[r + 1] <= u; r++);
+
+  for (; u < u_end; u++) {
+    while (gen->block_start[r + 1] <= u) {
+      r++;
+    }
+    for (s = 0; s < k; s++) {
+      lo = gen->block_start[s];
+      hi = gen->block_start[s + 1];
+      if (!gen->directed) {
+        /* Only the upper triangle of the adjacency matrix is generated */
+        if (lo < u + (gen->loops ? 0 : 1)) {
+          lo = u + (gen->loops ? 0 : 1);
+        }
+      }
+      p = gen->pref[r * k + s];
+      if (lo >= hi || p <= 0) {
+        continue;
+      }
+
+      if (p >= 1) {
+        for (v = lo; v < hi; v++) {
+          if ((v != u || gen->loops) && igraphmodule_i_generator_push(w, u, v))
+            return;
+        }
+        continue;
+      }
+
+      lp = log1p(-p);
+      v = lo - 1;
+      while (1) {
+        skip = floor(log(1 - igraph_rng_get_unif01(&w->rng)) / lp);
+        if (v + 1 + skip >= hi) {
+          break;
+        }
+        v += 1 + (long int) skip;
+        if ((v != u || gen->loops) && igraphmodule_i_generator_push(w, u, v))
+          return;
+      }
+    }
+  }
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Generates a block of edges of a static fitness model
+ */
+static void igraphmodule_i_generator_fitness_block(igraphmodule_i_generator_worker_t *w) {
+  igraphmodule_generator_t *gen = w->gen;
+  long int e, e_end, from, to, n = gen->no_of_nodes;
+
+  e = w->block * IGRAPHMODULE_GENERATOR_EDGES_PER_BLOCK;
+  e_end = e + IGRAPHMODULE_GENERATOR_EDGES_PER_BLOCK;
+  if (e_end > gen->no_of_edges) {
+    e_end = gen->no_of_edges;
+  }
+
+  while (e < e_end) {
+    from = igraphmodule_i_generator_sample(&w->rng, n, gen->out_prob, gen->out_alias);
+    if (gen->in_prob) {
+      to = igraphmodule_i_generator_sample(&w->rng, n, gen->in_prob, gen->in_alias);
+    } else {
+      to = igraphmodule_i_generator_sample(&w->rng, n, gen->out_prob, gen->out_alias);
+    }
+    if (from == to && !gen->loops) {
+      continue;
+    }
+    if (igraphmodule_i_generator_push(w, from, to))
+      return;
+    e++;
+  }
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Generates a block of edges of a rewired ring lattice
+ *
+ * Edge \em e of the lattice connects vertex \em e / nei to the vertex
+ * (\em e mod nei) + 1 steps ahead of it; the latter endpoint is replaced by
+ * a uniformly chosen vertex with probability \em p.
+ */
+static void igraphmodule_i_generator_ring_block(igraphmodule_i_generator_worker_t *w) {
+  igraphmodule_generator_t *gen = w->gen;
+  long int e, e_end, u, v, n = gen->no_of_nodes;
+
+  e = w->block * IGRAPHMODULE_GENERATOR_EDGES_PER_BLOCK;
+  e_end = e + IGRAPHMODULE_GENERATOR_EDGES_PER_BLOCK;
+  if (e_end > gen->no_of_edges) {
+    e_end = gen->no_of_edges;
+  }
+
+  for (; e < e_end; e++) {
+    u = e / gen->nei;
+    v = (u + e % gen->nei + 1) % n;
+    if (gen->p > 0 && igraph_rng_get_unif01(&w->rng) < gen->p) {
+      if (gen->loops) {
+        v = (long int) igraph_rng_get_integer(&w->rng, 0, n - 1);
+      } else {
+        v = (long int) igraph_rng_get_integer(&w->rng, 0, n - 2);
+        if (v >= u) {
+          v++;
+        }
+      }
+    }
+    if (igraphmodule_i_generator_push(w, u, v))
+      return;
+  }
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Generates the current block of a worker
+ *
+ * Neither the Python API nor the error handling of the C core is used here.
+ */
+static void igraphmodule_i_generator_work(void *workers, long int index) {
+  igraphmodule_i_generator_worker_t *w =
+    &((igraphmodule_i_generator_worker_t*)workers)[index];
+
+  w->size = 0;
+  if (w->block < 0) {
+    return;
+  }
+
+  igraph_rng_seed(&w->rng, igraphmodule_stream_seed(w->gen->seed, w->block));
+
+  switch (w->gen->model) {
+    case IGRAPHMODULE_GENERATOR_SBM:
+      igraphmodule_i_generator_sbm_block(w);
+      break;
+    case IGRAPHMODULE_GENERATOR_FITNESS:
+      igraphmodule_i_generator_fitness_block(w);
+      break;
+    case IGRAPHMODULE_GENERATOR_RING:
+      igraphmodule_i_generator_ring_block(w);
+      break;
+  }
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Writes the current block of a worker to a file
+ *
+ * \return 0 if everything was OK, 1 if writing failed
+ */
+static int igraphmodule_i_generator_write(igraphmodule_i_generator_worker_t *w,
+    FILE *fp, int binary) {
+  long int i;
+
+  if (binary) {
+    return fwrite(w->edges, sizeof(PY_LONG_LONG), w->size, fp) != (size_t) w->size;
+  }
+
+  for (i = 0; i < w->size; i += 2) {
+    if (fprintf(fp, "%ld %ld\n", (long int) w->edges[i], (long int) w->edges[i + 1]) < 0)
+      return 1;
+  }
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Generates a random graph, using several threads
+ *
+ * The blocks are generated in rounds; in every round, each worker generates
+ * one block and the blocks are then appended to the edge list of the graph
+ * or written to the file in order. At most one block per worker is held in
+ * memory when writing to a file.
+ *
+ * \param type the type of the graph object to create
+ * \param file_o the file (name or file object) to write the edges to
+ *        instead of creating a graph, or \c None
+ * \param format_o the format of the file; \c "edgelist" for "from to" lines
+ *        or \c "binary" for pairs of native 64-bit integers
+ * \return the graph, or the number of edges written to the file
+ */
+PyObject* igraphmodule_generator_run(igraphmodule_generator_t *gen,
+    PyTypeObject *type, PyObject *file_o, PyObject *format_o) {
+  static igraphmodule_enum_translation_table_entry_t format_tt[] = {
+        {"edgelist", 0},
+        {"binary", 1},
+        {0,0}
+    };
+  igraphmodule_i_generator_worker_t *workers = 0;
+  igraphmodule_filehandle_t fobj;
+  igraph_vector_t edges;
+  igraph_t g;
+  FILE *fp = 0;
+  long int i, j, first, no_of_blocks, threads, no_of_edges = 0, size;
+  int format = 0, retval = 0, io_error = 0, saved_errno = 0;
+  PyObject *result = 0;
+
+  if (igraphmodule_PyObject_to_enum(format_o, format_tt, &format))
+    return NULL;
+
+  no_of_blocks = igraphmodule_i_generator_no_of_blocks(gen);
+  threads = gen->threads;
+  if (threads > no_of_blocks) {
+    threads = no_of_blocks > 0 ? no_of_blocks : 1;
+  }
+
+  if (file_o != 0 && file_o != Py_None) {
+    if (igraphmodule_filehandle_init(&fobj, file_o, format ? "wb" : "w"))
+      return igraphmodule_handle_igraph_error();
+    fp = igraphmodule_filehandle_get(&fobj);
+  } else if (igraph_vector_init(&edges, 0)) {
+    return igraphmodule_handle_igraph_error();
+  }
+
+  workers = (igraphmodule_i_generator_worker_t*)calloc(threads,
+      sizeof(igraphmodule_i_generator_worker_t));
+  if (!workers) {
+    retval = 1;
+    PyErr_NoMemory();
+  }
+  for (i = 0; !retval && i < threads; i++) {
+    workers[i].gen = gen;
+    if (igraph_rng_init(&workers[i].rng, &igraph_rngtype_mt19937)) {
+      retval = 1;
+      igraphmodule_handle_igraph_error();
+      break;
+    }
+    workers[i].has_rng = 1;
+  }
+
+  if (!retval) {
+    /* The workers do not use the error handling of the C core, hence they
+     * may run in parallel even if it is not thread-local */
+    IGRAPHMODULE_BEGIN_NOGIL(0);
+
+    for (first = 0; !retval && first < no_of_blocks; first += threads) {
+      for (i = 0; i < threads; i++) {
+        workers[i].block = first + i < no_of_blocks ? first + i : -1;
+      }
+
+      igraphmodule_run_workers(igraphmodule_i_generator_work, workers,
+          threads, threads);
+
+      for (i = 0; !retval && i < threads; i++) {
+        if (workers[i].nomem) {
+          retval = IGRAPH_ENOMEM;
+        } else if (fp) {
+          if (igraphmodule_i_generator_write(&workers[i], fp, format)) {
+            saved_errno = errno;
+            io_error = 1;
+            retval = 1;
+          }
+        } else {
+          size = igraph_vector_size(&edges);
+          retval = igraph_vector_resize(&edges, size + workers[i].size);
+          for (j = 0; !retval && j < workers[i].size; j++) {
+            VECTOR(edges)[size + j] = workers[i].edges[j];
+          }
+        }
+        no_of_edges += workers[i].size / 2;
+      }
+    }
+
+    if (!retval && !fp) {
+      retval = igraph_create(&g, &edges, gen->no_of_nodes, gen->directed);
+    }
+
+    IGRAPHMODULE_END_NOGIL(0);
+
+    if (retval == IGRAPH_ENOMEM && !PyErr_Occurred()) {
+      PyErr_NoMemory();
+    } else if (io_error) {
+      errno = saved_errno;
+      PyErr_SetFromErrno(PyExc_IOError);
+    } else if (retval) {
+      igraphmodule_handle_igraph_error();
+    }
+  }
+
+  for (i = 0; workers && i < threads; i++) {
+    free(workers[i].edges);
+    if (workers[i].has_rng) {
+      igraph_rng_destroy(&workers[i].rng);
+    }
+  }
+  free(workers);
+
+  if (fp) {
+    igraphmodule_filehandle_destroy(&fobj);
+    if (!retval && PyErr_Occurred()) {
+      retval = 1;
+    }
+    if (!retval) {
+      result = PyInt_FromLong(no_of_edges);
+    }
+  } else {
+    igraph_vector_destroy(&edges);
+    if (!retval) {
+      result = igraphmodule_Graph_subclass_from_igraph_t(type, &g);
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,106 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef PYTHON_GENERATORS_H
+#define PYTHON_GENERATORS_H
+
+#include <Python.h>
+#include <igraph.h>
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_generators Parallel and streaming random graph generators
+ */
+
+/**
+ * \ingroup python_interface_generators
+ * \brief Random graph models supported by the parallel generator
+ */
+typedef enum {
+  // Independent edges with a probability depending on the blocks of the
+  // endpoints (stochastic block model, Erdos-Renyi G(n,p) with one block)
+  IGRAPHMODULE_GENERATOR_SBM = 0,
+  // A fixed number of edges with endpoints drawn independently in
+  // proportion to their fitness (static fitness and power-law models)
+  IGRAPHMODULE_GENERATOR_FITNESS,
+  // A ring lattice whose edges are rewired independently (Watts-Strogatz)
+  IGRAPHMODULE_GENERATOR_RING
+} igraphmodule_generator_model_t;
+
+/**
+ * \ingroup python_interface_generators
+ * \brief A random graph model and the parameters of generating it.
+ *
+ * The edges of the graph are divided into fixed-size blocks (of rows of
+ * the adjacency matrix or of edge indices). Every block is generated from
+ * a random stream of its own, seeded from the seed of the generator and the
+ * index of the block, and the blocks are emitted in order. The result thus
+ * only depends on the seed, regardless of the number of threads.
+ */
+typedef struct {
+  igraphmodule_generator_model_t model;
+  long int no_of_nodes;
+  igraph_bool_t directed;
+  igraph_bool_t loops;
+  // SBM: vertex i is in block k if block_start[k] <= i < block_start[k+1];
+  // the edge probabilities between the blocks are in pref (row-major)
+  long int no_of_blocks;
+  long int *block_start;
+  double *pref;
+  // Fitness: the number of edges and the alias tables of the endpoints;
+  // in_prob and in_alias are null pointers if the graph is undirected
+  long int no_of_edges;
+  double *out_prob, *in_prob;
+  long int *out_alias, *in_alias;
+  // Ring: the neighborhood size and the rewiring probability
+  long int nei;
+  double p;
+  // Number of threads and the seed of the random streams
+  long int threads;
+  unsigned long int seed;
+} igraphmodule_generator_t;
+
+void igraphmodule_generator_init(igraphmodule_generator_t *gen);
+void igraphmodule_generator_destroy(igraphmodule_generator_t *gen);
+
+int igraphmodule_generator_set_options(igraphmodule_generator_t *gen,
+    PyObject *threads_o, PyObject *seed_o);
+int igraphmodule_generator_set_gnp(igraphmodule_generator_t *gen,
+    long int n, double p, igraph_bool_t directed, igraph_bool_t loops);
+int igraphmodule_generator_set_sbm(igraphmodule_generator_t *gen,
+    long int n, const igraph_matrix_t *pref, const igraph_vector_int_t *block_sizes,
+    igraph_bool_t directed, igraph_bool_t loops);
+int igraphmodule_generator_set_fitness(igraphmodule_generator_t *gen,
+    long int m, const igraph_vector_t *fitness_out, const igraph_vector_t *fitness_in,
+    igraph_bool_t loops);
+int igraphmodule_generator_set_power_law(igraphmodule_generator_t *gen,
+    long int n, long int m, double exponent_out, double exponent_in,
+    igraph_bool_t loops, igraph_bool_t finite_size_correction);
+int igraphmodule_generator_set_ring(igraphmodule_generator_t *gen,
+    long int n, long int nei, double p, igraph_bool_t loops);
+
+PyObject* igraphmodule_generator_run(igraphmodule_generator_t *gen,
+    PyTypeObject *type, PyObject *file_o, PyObject *format_o);
+
+#endif
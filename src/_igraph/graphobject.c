@@ -21,19 +21,38 @@
 */
 
 #include "attributes.h"
+#include "adjacency.h"
 #include "arpackobject.h"
+#include "batchobject.h"
 #include "bfsiter.h"
+#include "bufferobject.h"
+#include "canonical.h"
+#include "motifs.h"
+#include "centrality.h"
+#include "columnar.h"
+#include "columnobject.h"
 #include "dfsiter.h"
 #include "common.h"
 #include "convert.h"
 #include "edgeseqobject.h"
 #include "error.h"
 #include "filehandle.h"
+#include "foreign.h"
+#include "forcelayout.h"
+#include "generators.h"
 #include "graphobject.h"
 #include "indexing.h"
 #include "memory.h"
+#include "memusage.h"
+#include "pagerank.h"
+#include "pathsiter.h"
 #include "py2compat.h"
+#include "profiling.h"
 #include "pyhelpers.h"
+#include "searchiter.h"
+#include "serialization.h"
+#include "similarity.h"
+#include "threading.h"
 #include "vertexseqobject.h"
 #include <float.h>
 
@@ -72,6 +91,8 @@ void igraphmodule_Graph_init_internal(igraphmodule_GraphObject * self)
 
   self->destructor = NULL;
   self->weakreflist = NULL;
+  self->busy = 0;
+  self->snapshot = NULL;
 }
 
 /**
@@ -167,8 +188,18 @@ void igraphmodule_Graph_dealloc(igraphmodule_GraphObject * self)
   if (self->weakreflist != NULL)
      PyObject_ClearWeakRefs((PyObject *) self);
 
+  if (self->snapshot != NULL) {
+    /* The vectors of the graph point into the snapshot */
+    igraphmodule_snapshot_detach_igraph_t(&self->g);
+  }
+
   igraph_destroy(&self->g);
 
+  if (self->snapshot != NULL) {
+    PyBuffer_Release(&self->snapshot_view);
+    Py_CLEAR(self->snapshot);
+  }
+
   if (self->destructor != NULL && PyCallable_Check(self->destructor)) {
     r = PyObject_CallObject(self->destructor, NULL);
     if (r) {
@@ -549,6 +580,9 @@ PyObject *igraphmodule_Graph_add_vertices(igraphmodule_GraphObject * self,
   if (!PyArg_ParseTuple(args, "l", &n))
     return NULL;
 
+  if (!igraphmodule_Graph_check_not_busy(self))
+    return NULL;
+
   if (igraph_add_vertices(&self->g, (igraph_integer_t) n, 0)) {
     igraphmodule_handle_igraph_error();
     return NULL;
@@ -572,6 +606,9 @@ PyObject *igraphmodule_Graph_delete_vertices(igraphmodule_GraphObject * self,
 
   if (!PyArg_ParseTuple(args, "|O", &list)) return NULL;
 
+  if (!igraphmodule_Graph_check_not_busy(self))
+    return NULL;
+
   /* no arguments means delete all. */
 
   /*Py_None also means all for now, but it is deprecated */
@@ -612,6 +649,9 @@ PyObject *igraphmodule_Graph_add_edges(igraphmodule_GraphObject * self,
   if (!PyArg_ParseTuple(args, "O", &list))
     return NULL;
 
+  if (!igraphmodule_Graph_check_not_busy(self))
+    return NULL;
+
   if (igraphmodule_PyObject_to_edgelist(list, &v, &self->g, &v_owned))
     return NULL;
 
@@ -631,6 +671,15 @@ PyObject *igraphmodule_Graph_add_edges(igraphmodule_GraphObject * self,
   Py_RETURN_NONE;
 }
 
+/** \ingroup python_interface_graph
+ * \brief Starts a batch of modifications of an \c igraph.Graph
+ * \sa igraphmodule_GraphBatch_new
+ */
+PyObject *igraphmodule_Graph_batch_update(igraphmodule_GraphObject * self)
+{
+  return igraphmodule_GraphBatch_new(self);
+}
+
 /** \ingroup python_interface_graph
  * \brief Deletes edges from an \c igraph.Graph
  * \return the extended \c igraph.Graph object
@@ -649,6 +698,9 @@ PyObject *igraphmodule_Graph_delete_edges(igraphmodule_GraphObject * self,
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &list))
     return NULL;
 
+  if (!igraphmodule_Graph_check_not_busy(self))
+    return NULL;
+
   /* no arguments means delete all. */
 
   /*Py_None also means all for now, but it is deprecated */
@@ -690,15 +742,22 @@ PyObject *igraphmodule_Graph_degree(igraphmodule_GraphObject * self,
   PyObject *loops = Py_True;
   PyObject *dtype_o = Py_None;
   PyObject *dmode_o = Py_None;
+  PyObject *return_type_o = Py_None;
   igraph_neimode_t dmode = IGRAPH_ALL;
+  igraphmodule_return_type_t return_type = IGRAPHMODULE_RETURN_LIST;
   igraph_vector_t result;
   igraph_vs_t vs;
   igraph_bool_t return_single = 0;
 
-  static char *kwlist[] = { "vertices", "mode", "loops", "type", NULL };
+  static char *kwlist[] = { "vertices", "mode", "loops", "type",
+    "return_type", NULL };
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOO", kwlist,
-                                   &list, &dmode_o, &loops, &dtype_o))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOO", kwlist,
+                                   &list, &dmode_o, &loops, &dtype_o,
+                                   &return_type_o))
+    return NULL;
+
+  if (igraphmodule_PyObject_to_return_type_t(return_type_o, &return_type))
     return NULL;
 
   if (dmode_o == Py_None && dtype_o != Py_None) {
@@ -727,7 +786,8 @@ PyObject *igraphmodule_Graph_degree(igraphmodule_GraphObject * self,
   }
 
   if (!return_single)
-    list = igraphmodule_vector_t_to_PyList(&result, IGRAPHMODULE_TYPE_INT);
+    list = igraphmodule_vector_t_to_PyObject(&result, IGRAPHMODULE_TYPE_INT,
+        return_type);
   else
     list = PyInt_FromLong((long int)VECTOR(result)[0]);
 
@@ -826,17 +886,22 @@ PyObject *igraphmodule_Graph_strength(igraphmodule_GraphObject * self,
   PyObject *dtype_o = Py_None;
   PyObject *dmode_o = Py_None;
   PyObject *weights_o = Py_None;
+  PyObject *return_type_o = Py_None;
   igraph_neimode_t dmode = IGRAPH_ALL;
+  igraphmodule_return_type_t return_type = IGRAPHMODULE_RETURN_LIST;
   igraph_vector_t result, *weights = 0;
   igraph_vs_t vs;
   igraph_bool_t return_single = 0;
 
   static char *kwlist[] = { "vertices", "mode", "loops", "weights",
-    "type", NULL };
+    "type", "return_type", NULL };
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOO", kwlist,
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOOO", kwlist,
                                    &list, &dmode_o, &loops, &weights_o,
-                                   &dtype_o))
+                                   &dtype_o, &return_type_o))
+    return NULL;
+
+  if (igraphmodule_PyObject_to_return_type_t(return_type_o, &return_type))
     return NULL;
 
   if (dmode_o == Py_None && dtype_o != Py_None) {
@@ -876,7 +941,8 @@ PyObject *igraphmodule_Graph_strength(igraphmodule_GraphObject * self,
   if (weights) { igraph_vector_destroy(weights); free(weights); }
 
   if (!return_single)
-    list = igraphmodule_vector_t_to_PyList(&result, IGRAPHMODULE_TYPE_FLOAT);
+    list = igraphmodule_vector_t_to_PyObject(&result, IGRAPHMODULE_TYPE_FLOAT,
+        return_type);
   else
     list = PyFloat_FromDouble(VECTOR(result)[0]);
 
@@ -1163,6 +1229,20 @@ PyObject *igraphmodule_Graph_count_multiple(igraphmodule_GraphObject *self,
   return list;
 }
 
+/** \ingroup python_interface_graph
+ * \brief Returns the cached adjacency lists to be used for looking up the
+ *        neighbors of a single vertex, or \c NULL if the C core should be
+ *        queried (e.g., because the vertex ID is invalid and the C core is
+ *        the one to report it)
+ */
+static igraphmodule_adjacency_t* igraphmodule_i_Graph_adjacency_of_vertex(
+    igraphmodule_GraphObject * self, igraph_integer_t vid, igraph_neimode_t mode)
+{
+  if (vid < 0 || vid >= igraph_vcount(&self->g))
+    return 0;
+  return igraphmodule_get_adjacency(&self->g, mode, 0);
+}
+
 /** \ingroup python_interface_graph
  * \brief The neighbors of a given vertex in an \c igraph.Graph
  * This method accepts a single vertex ID as a parameter, and returns the
@@ -1181,6 +1261,7 @@ PyObject *igraphmodule_Graph_neighbors(igraphmodule_GraphObject * self,
   igraph_neimode_t dmode = IGRAPH_ALL;
   igraph_integer_t idx;
   igraph_vector_t result;
+  igraphmodule_adjacency_t *adj;
 
   static char *kwlist[] = { "vertex", "mode", "type", NULL };
 
@@ -1199,6 +1280,10 @@ PyObject *igraphmodule_Graph_neighbors(igraphmodule_GraphObject * self,
   if (igraphmodule_PyObject_to_vid(index_o, &idx, &self->g))
     return NULL;
 
+  adj = igraphmodule_i_Graph_adjacency_of_vertex(self, idx, dmode);
+  if (adj)
+    return igraphmodule_adjacency_to_PyList(adj, (long int) idx, 0);
+
   if (igraph_vector_init(&result, 1))
     return igraphmodule_handle_igraph_error();
 
@@ -1232,6 +1317,7 @@ PyObject *igraphmodule_Graph_incident(igraphmodule_GraphObject * self,
   igraph_neimode_t dmode = IGRAPH_OUT;
   igraph_integer_t idx;
   igraph_vector_t result;
+  igraphmodule_adjacency_t *adj;
 
   static char *kwlist[] = { "vertex", "mode", "type", NULL };
 
@@ -1250,6 +1336,10 @@ PyObject *igraphmodule_Graph_incident(igraphmodule_GraphObject * self,
   if (igraphmodule_PyObject_to_vid(index_o, &idx, &self->g))
     return NULL;
 
+  adj = igraphmodule_i_Graph_adjacency_of_vertex(self, idx, dmode);
+  if (adj)
+    return igraphmodule_adjacency_to_PyList(adj, (long int) idx, 1);
+
   igraph_vector_init(&result, 1);
   if (igraph_incident(&self->g, &result, idx, dmode)) {
     igraphmodule_handle_igraph_error();
@@ -1305,6 +1395,7 @@ PyObject *igraphmodule_Graph_successors(igraphmodule_GraphObject * self,
   PyObject *list, *index_o;
   igraph_integer_t idx;
   igraph_vector_t result;
+  igraphmodule_adjacency_t *adj;
 
   static char *kwlist[] = { "vertex", NULL };
 
@@ -1314,6 +1405,10 @@ PyObject *igraphmodule_Graph_successors(igraphmodule_GraphObject * self,
   if (igraphmodule_PyObject_to_vid(index_o, &idx, &self->g))
     return NULL;
 
+  adj = igraphmodule_i_Graph_adjacency_of_vertex(self, idx, IGRAPH_OUT);
+  if (adj)
+    return igraphmodule_adjacency_to_PyList(adj, (long int) idx, 0);
+
   igraph_vector_init(&result, 1);
   if (igraph_neighbors(&self->g, &result, idx, IGRAPH_OUT)) {
     igraphmodule_handle_igraph_error();
@@ -1342,6 +1437,7 @@ PyObject *igraphmodule_Graph_predecessors(igraphmodule_GraphObject * self,
   PyObject *list, *index_o;
   igraph_integer_t idx;
   igraph_vector_t result;
+  igraphmodule_adjacency_t *adj;
 
   static char *kwlist[] = { "vertex", NULL };
 
@@ -1351,6 +1447,10 @@ PyObject *igraphmodule_Graph_predecessors(igraphmodule_GraphObject * self,
   if (igraphmodule_PyObject_to_vid(index_o, &idx, &self->g))
     return NULL;
 
+  adj = igraphmodule_i_Graph_adjacency_of_vertex(self, idx, IGRAPH_IN);
+  if (adj)
+    return igraphmodule_adjacency_to_PyList(adj, (long int) idx, 0);
+
   igraph_vector_init(&result, 1);
   if (igraph_neighbors(&self->g, &result, idx, IGRAPH_IN)) {
     igraphmodule_handle_igraph_error();
@@ -1393,6 +1493,18 @@ PyObject *igraphmodule_Graph_is_connected(igraphmodule_GraphObject * self,
   Py_RETURN_FALSE;
 }
 
+/** \ingroup python_interface_graph
+ * \brief Checks whether both vertex IDs of a pair are valid, so that the
+ *        edge index can be used for the pair. Invalid pairs are left to the
+ *        C core which raises the error.
+ */
+static igraph_bool_t igraphmodule_i_Graph_valid_vertex_pair(
+    igraphmodule_GraphObject * self, igraph_real_t from, igraph_real_t to)
+{
+  igraph_real_t n = igraph_vcount(&self->g);
+  return from >= 0 && from < n && to >= 0 && to < n;
+}
+
 /** \ingroup python_interface_graph
  * \brief Decides whether there is an edge from a given vertex to an other one.
  * \return Py_True if the vertices are directly connected, Py_False otherwise
@@ -1405,6 +1517,7 @@ PyObject *igraphmodule_Graph_are_connected(igraphmodule_GraphObject * self,
   PyObject *v1, *v2;
   igraph_integer_t idx1, idx2;
   igraph_bool_t res;
+  const igraphmodule_edge_index_t *index;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO", kwlist, &v1, &v2))
     return NULL;
@@ -1415,7 +1528,10 @@ PyObject *igraphmodule_Graph_are_connected(igraphmodule_GraphObject * self,
   if (igraphmodule_PyObject_to_vid(v2, &idx2, &self->g))
     return NULL;
 
-  if (igraph_are_connected(&self->g, idx1, idx2, &res))
+  index = igraphmodule_get_edge_index(&self->g);
+  if (index && igraphmodule_i_Graph_valid_vertex_pair(self, idx1, idx2)) {
+    res = igraphmodule_edge_index_lookup(index, idx1, idx2, 1) >= 0;
+  } else if (igraph_are_connected(&self->g, idx1, idx2, &res))
     return igraphmodule_handle_igraph_error();
 
   if (res)
@@ -1436,6 +1552,7 @@ PyObject *igraphmodule_Graph_get_eid(igraphmodule_GraphObject * self,
   PyObject *error = Py_True;
   igraph_integer_t idx1, idx2;
   igraph_integer_t result;
+  const igraphmodule_edge_index_t *index;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|OO", kwlist, &v1, &v2,
                                    &directed, &error))
@@ -1447,6 +1564,15 @@ PyObject *igraphmodule_Graph_get_eid(igraphmodule_GraphObject * self,
   if (igraphmodule_PyObject_to_vid(v2, &idx2, &self->g))
     return NULL;
 
+  /* Missing edges are left to the C core so that it raises the error */
+  index = igraphmodule_get_edge_index(&self->g);
+  if (index && igraphmodule_i_Graph_valid_vertex_pair(self, idx1, idx2)) {
+    result = igraphmodule_edge_index_lookup(index, idx1, idx2,
+        PyObject_IsTrue(directed));
+    if (result >= 0 || !PyObject_IsTrue(error))
+      return Py_BuildValue("l", (long)result);
+  }
+
   if (igraph_get_eid(&self->g, &result, idx1, idx2,
         PyObject_IsTrue(directed), PyObject_IsTrue(error)))
     return igraphmodule_handle_igraph_error();
@@ -1468,6 +1594,8 @@ PyObject *igraphmodule_Graph_get_eids(igraphmodule_GraphObject * self,
   PyObject *result = NULL;
   igraph_vector_t pairs, path, res;
   igraph_bool_t pairs_owned = 0;
+  const igraphmodule_edge_index_t *index;
+  long int i, n;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOO", kwlist,
                                    &pairs_o, &path_o, &directed,
@@ -1494,6 +1622,39 @@ PyObject *igraphmodule_Graph_get_eids(igraphmodule_GraphObject * self,
     }
   }
 
+  /* Pairs without a path can be resolved via the edge index if it has been
+   * built already; missing edges are left to the C core so that it raises
+   * the error */
+  index = igraphmodule_get_edge_index(&self->g);
+  if (index && pairs_o != Py_None && path_o == Py_None) {
+    n = igraph_vector_size(&pairs) / 2;
+    if (igraph_vector_resize(&res, n)) {
+      if (pairs_owned) {
+        igraph_vector_destroy(&pairs);
+      }
+      igraph_vector_destroy(&res);
+      return igraphmodule_handle_igraph_error();
+    }
+    for (i = 0; i < n; i++) {
+      if (!igraphmodule_i_Graph_valid_vertex_pair(self,
+            VECTOR(pairs)[2 * i], VECTOR(pairs)[2 * i + 1]))
+        break;
+      VECTOR(res)[i] = igraphmodule_edge_index_lookup(index,
+          (long int) VECTOR(pairs)[2 * i], (long int) VECTOR(pairs)[2 * i + 1],
+          PyObject_IsTrue(directed));
+      if (VECTOR(res)[i] < 0 && PyObject_IsTrue(error))
+        break;
+    }
+    if (i == n) {
+      if (pairs_owned) {
+        igraph_vector_destroy(&pairs);
+      }
+      result = igraphmodule_vector_t_to_PyList(&res, IGRAPHMODULE_TYPE_INT);
+      igraph_vector_destroy(&res);
+      return result;
+    }
+  }
+
   if (igraph_get_eids(&self->g, &res,
         pairs_o == Py_None ? 0 : &pairs,
         path_o  == Py_None ? 0 : &path,
@@ -1521,6 +1682,131 @@ PyObject *igraphmodule_Graph_get_eids(igraphmodule_GraphObject * self,
   return result;
 }
 
+/** \ingroup python_interface_graph
+ * \brief Returns the IDs of the edges between many pairs of vertices at once
+ *
+ * The pairs are read directly from an (n x 2) numeric buffer if possible.
+ * The lookups run without the GIL, via the hashed edge index (which is built
+ * if needed) or via the C core if the index is not to be used.
+ *
+ * \return an integer \c AttributeColumn with -1 for the missing edges
+ */
+PyObject *igraphmodule_Graph_get_eids_batch(igraphmodule_GraphObject * self,
+                                            PyObject * args, PyObject * kwds)
+{
+  static char *kwlist[] = { "pairs", "directed", "index", NULL };
+  PyObject *pairs_o, *directed_o = Py_True, *index_o = Py_True;
+  PyObject *result;
+  Py_buffer buffer;
+  igraph_vector_t pairs;
+  igraph_bool_t have_buffer = 0, pairs_owned = 0, directed;
+  igraphmodule_buffer_item_kind_t kind = IGRAPHMODULE_BUFFER_ITEM_UNSUPPORTED;
+  const igraphmodule_edge_index_t *index;
+  igraphmodule_edge_index_t *new_index = 0;
+  const char *row;
+  Py_ssize_t i, n, row_stride, col_stride, itemsize, bad = -1;
+  long int no_of_nodes = igraph_vcount(&self->g);
+  PY_LONG_LONG *out;
+  igraph_real_t u, v;
+  igraph_integer_t eid;
+  int retval = 0, out_of_memory = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OO", kwlist, &pairs_o,
+                                   &directed_o, &index_o))
+    return NULL;
+
+  directed = PyObject_IsTrue(directed_o);
+
+  if (PyObject_CheckBuffer(pairs_o)) {
+    if (PyObject_GetBuffer(pairs_o, &buffer, PyBUF_STRIDES | PyBUF_FORMAT))
+      return NULL;
+    have_buffer = 1;
+    kind = igraphmodule_buffer_item_kind(&buffer);
+    if (kind == IGRAPHMODULE_BUFFER_ITEM_UNSUPPORTED) {
+      PyErr_SetString(PyExc_TypeError, "pairs must be a numeric buffer");
+      PyBuffer_Release(&buffer);
+      return NULL;
+    }
+    if (buffer.ndim != 2 || buffer.shape[1] != 2) {
+      PyErr_SetString(PyExc_ValueError, "pairs must be a buffer with two columns");
+      PyBuffer_Release(&buffer);
+      return NULL;
+    }
+    row = (const char*) buffer.buf;
+    n = buffer.shape[0];
+    row_stride = buffer.strides[0];
+    col_stride = buffer.strides[1];
+    itemsize = buffer.itemsize;
+  } else {
+    if (igraphmodule_PyObject_to_edgelist(pairs_o, &pairs, &self->g, &pairs_owned))
+      return NULL;
+    kind = IGRAPHMODULE_BUFFER_ITEM_FLOAT;
+    row = (const char*) VECTOR(pairs);
+    n = igraph_vector_size(&pairs) / 2;
+    row_stride = 2 * sizeof(igraph_real_t);
+    col_stride = itemsize = sizeof(igraph_real_t);
+  }
+
+  result = igraphmodule_Column_New(IGRAPHMODULE_COLUMN_INT, n);
+  if (result != 0) {
+    out = (PY_LONG_LONG*) ((igraphmodule_ColumnObject*) result)->data;
+    index = igraphmodule_get_edge_index(&self->g);
+
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    if (index == 0 && PyObject_IsTrue(index_o) &&
+        igraphmodule_edge_index_supported(&self->g)) {
+      out_of_memory = igraphmodule_edge_index_build(&self->g, &new_index) != 0;
+      index = new_index;
+    }
+    for (i = 0; i < n && !out_of_memory && !retval; i++, row += row_stride) {
+      u = igraphmodule_buffer_item_as_real(row, kind, itemsize);
+      v = igraphmodule_buffer_item_as_real(row + col_stride, kind, itemsize);
+      if (!(u >= 0 && u < no_of_nodes && v >= 0 && v < no_of_nodes)) {
+        bad = i;
+        break;
+      }
+      if (index) {
+        out[i] = igraphmodule_edge_index_lookup(index, (long int) u,
+            (long int) v, directed);
+      } else {
+        retval = igraph_get_eid(&self->g, &eid, (igraph_integer_t) u,
+            (igraph_integer_t) v, directed, 0);
+        out[i] = eid;
+      }
+    }
+    IGRAPHMODULE_END_NOGIL(self);
+
+    /* Somebody else may have built an index in the meantime while we were
+     * not holding the GIL; that one may be in use, so it is kept */
+    if (new_index && igraphmodule_get_edge_index(&self->g) == 0) {
+      igraphmodule_set_edge_index(&self->g, new_index);
+    } else {
+      igraphmodule_edge_index_destroy(new_index);
+    }
+
+    if (out_of_memory) {
+      PyErr_NoMemory();
+      Py_CLEAR(result);
+    } else if (retval) {
+      igraphmodule_handle_igraph_error();
+      Py_CLEAR(result);
+    } else if (bad >= 0) {
+      PyErr_Format(PyExc_ValueError, "invalid vertex ID in row %ld of pairs",
+          (long) bad);
+      Py_CLEAR(result);
+    }
+  }
+
+  if (have_buffer) {
+    PyBuffer_Release(&buffer);
+  }
+  if (pairs_owned) {
+    igraph_vector_destroy(&pairs);
+  }
+
+  return result;
+}
+
 /** \ingroup python_interface_graph
  * \brief Calculates the diameter of an \c igraph.Graph
  * This method accepts two optional parameters: the first one is
@@ -1539,6 +1825,8 @@ PyObject *igraphmodule_Graph_diameter(igraphmodule_GraphObject * self,
   PyObject *dir = Py_True, *vcount_if_unconnected = Py_True;
   PyObject *weights_o = Py_None;
   igraph_vector_t *weights = 0;
+  igraph_bool_t directed, unconn;
+  int retval;
 
   static char *kwlist[] = {
     "directed", "unconn", "weights", NULL
@@ -1552,10 +1840,16 @@ PyObject *igraphmodule_Graph_diameter(igraphmodule_GraphObject * self,
   if (igraphmodule_attrib_to_vector_t(weights_o, self, &weights,
 	  ATTRIBUTE_TYPE_EDGE)) return NULL;
 
+  directed = PyObject_IsTrue(dir);
+  unconn = PyObject_IsTrue(vcount_if_unconnected);
+
   if (weights) {
     igraph_real_t i;
-    if (igraph_diameter_dijkstra(&self->g, weights, &i, 0, 0, 0,
-          PyObject_IsTrue(dir), PyObject_IsTrue(vcount_if_unconnected))) {
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraph_diameter_dijkstra(&self->g, weights, &i, 0, 0, 0,
+        directed, unconn);
+    IGRAPHMODULE_END_NOGIL(self);
+    if (retval) {
       igraphmodule_handle_igraph_error();
       igraph_vector_destroy(weights); free(weights);
       return NULL;
@@ -1564,8 +1858,10 @@ PyObject *igraphmodule_Graph_diameter(igraphmodule_GraphObject * self,
     return PyFloat_FromDouble((double)i);
   } else {
     igraph_integer_t i;
-    if (igraph_diameter(&self->g, &i, 0, 0, 0, PyObject_IsTrue(dir),
-                        PyObject_IsTrue(vcount_if_unconnected))) {
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraph_diameter(&self->g, &i, 0, 0, 0, directed, unconn);
+    IGRAPHMODULE_END_NOGIL(self);
+    if (retval) {
       igraphmodule_handle_igraph_error();
       return NULL;
     }
@@ -1894,8 +2190,8 @@ PyObject *igraphmodule_Graph_Adjacency(PyTypeObject * type,
 
   static char *kwlist[] = { "matrix", "mode", NULL };
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!|O", kwlist,
-                                   &PyList_Type, &matrix, &mode_o))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist,
+                                   &matrix, &mode_o))
     return NULL;
   if (igraphmodule_PyObject_to_adjacency_t(mode_o, &mode)) return NULL;
 
@@ -2151,6 +2447,26 @@ PyObject *igraphmodule_Graph_Degree_Sequence(PyTypeObject * type,
   return (PyObject *) self;
 }
 
+/** \ingroup python_interface_graph
+ * \brief Whether a random graph generator call asks for the parallel
+ *        generator, i.e. whether any of its options were given
+ */
+#define IGRAPHMODULE_PARALLEL_GENERATOR_REQUESTED(threads_o, seed_o, file_o) \
+  ((threads_o) != Py_None || (seed_o) != Py_None || (file_o) != Py_None)
+
+/** \ingroup python_interface_graph
+ * \brief Runs the parallel generator unless setting it up has failed,
+ *        then destroys it
+ * \return the generated graph or the number of edges written to the file
+ */
+static PyObject *igraphmodule_i_Graph_run_generator(igraphmodule_generator_t *gen,
+    int failed, PyTypeObject *type, PyObject *file_o, PyObject *format_o) {
+  PyObject *result = failed ? 0 : igraphmodule_generator_run(gen, type,
+      file_o, format_o);
+  igraphmodule_generator_destroy(gen);
+  return result;
+}
+
 /** \ingroup python_interface_graph
  * \brief Generates a graph based on the Erdos-Renyi model
  * \return a reference to the newly generated Python igraph object
@@ -2165,13 +2481,18 @@ PyObject *igraphmodule_Graph_Erdos_Renyi(PyTypeObject * type,
   double p = -1.0;
   igraph_erdos_renyi_t t;
   PyObject *loops = Py_False, *directed = Py_False;
+  PyObject *threads_o = Py_None, *seed_o = Py_None;
+  PyObject *file_o = Py_None, *format_o = Py_None;
+  igraphmodule_generator_t gen;
 
-  static char *kwlist[] = { "n", "p", "m", "directed", "loops", NULL };
+  static char *kwlist[] = { "n", "p", "m", "directed", "loops", "threads",
+    "seed", "file", "format", NULL };
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "l|dlOO", kwlist,
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "l|dlOOOOOO", kwlist,
                                    &n, &p, &m,
                                    &directed,
-                                   &loops))
+                                   &loops, &threads_o, &seed_o, &file_o,
+                                   &format_o))
     return NULL;
 
   if (m == -1 && p == -1.0) {
@@ -2185,6 +2506,19 @@ PyObject *igraphmodule_Graph_Erdos_Renyi(PyTypeObject * type,
     return NULL;
   }
 
+  if (IGRAPHMODULE_PARALLEL_GENERATOR_REQUESTED(threads_o, seed_o, file_o)) {
+    if (m != -1) {
+      PyErr_SetString(PyExc_ValueError, "the parallel generator supports "
+          "the G(n,p) model only");
+      return NULL;
+    }
+    igraphmodule_generator_init(&gen);
+    return igraphmodule_i_Graph_run_generator(&gen,
+        igraphmodule_generator_set_options(&gen, threads_o, seed_o) ||
+        igraphmodule_generator_set_gnp(&gen, n, p, PyObject_IsTrue(directed),
+          PyObject_IsTrue(loops)), type, file_o, format_o);
+  }
+
   t = (m == -1) ? IGRAPH_ERDOS_RENYI_GNP : IGRAPH_ERDOS_RENYI_GNM;
 
   if (igraph_erdos_renyi_game(&g, t, (igraph_integer_t) n,
@@ -2294,6 +2628,58 @@ PyObject *igraphmodule_Graph_Famous(PyTypeObject * type,
 }
 
 
+/** \ingroup python_interface_graph
+ * \brief Creates a graph from two columns of vertex keys
+ *
+ * The keys are converted to vertex IDs and the graph is built without
+ * holding the GIL if the columns are integer buffers or string columns in
+ * the Arrow layout.
+ *
+ * \return a tuple containing the new graph and the list of the factorized
+ *   vertex keys (or \c None)
+ * \sa igraphmodule_columns_to_edgelist
+ */
+PyObject *igraphmodule_Graph__from_columns(PyTypeObject * type,
+                                           PyObject * args, PyObject * kwds) {
+  igraphmodule_GraphObject *self;
+  PyObject *source_o, *target_o, *directed_o = Py_False, *names_o = Py_None;
+  PyObject *names;
+  igraph_vector_t edges;
+  long int n;
+  igraph_t g;
+  int retval;
+
+  static char *kwlist[] = { "source", "target", "directed", "vertex_names", NULL };
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|OO", kwlist, &source_o,
+        &target_o, &directed_o, &names_o))
+    return NULL;
+
+  if (igraphmodule_columns_to_edgelist(source_o, target_o, names_o, &edges,
+        &n, &names))
+    return NULL;
+
+  IGRAPHMODULE_BEGIN_NOGIL(0);
+  retval = igraph_create(&g, &edges, (igraph_integer_t) n,
+      PyObject_IsTrue(directed_o));
+  IGRAPHMODULE_END_NOGIL(0);
+
+  igraph_vector_destroy(&edges);
+  if (retval) {
+    Py_DECREF(names);
+    return igraphmodule_handle_igraph_error();
+  }
+
+  CREATE_GRAPH_FROM_TYPE(self, g, type);
+  if (self == 0) {
+    igraph_destroy(&g);
+    Py_DECREF(names);
+    return NULL;
+  }
+
+  return Py_BuildValue("NN", self, names);
+}
+
 /** \ingroup python_interface_graph
  * \brief Generates a graph based on the forest fire model
  * \return a reference to the newly generated Python igraph object
@@ -3140,16 +3526,20 @@ PyObject *igraphmodule_Graph_SBM(PyTypeObject * type,
   PyObject *block_sizes_o, *pref_matrix_o;
   PyObject *directed_o = Py_False;
   PyObject *loops_o = Py_False;
+  PyObject *threads_o = Py_None, *seed_o = Py_None;
+  PyObject *file_o = Py_None, *format_o = Py_None, *result;
   igraph_matrix_t pref_matrix;
   igraph_vector_int_t block_sizes;
+  igraphmodule_generator_t gen;
 
   static char *kwlist[] = { "n", "pref_matrix", "block_sizes", "directed",
-	"loops", NULL };
+	"loops", "threads", "seed", "file", "format", NULL };
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "lO!O!|OO", kwlist,
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "lO!O!|OOOOOO", kwlist,
                                    &n, &PyList_Type, &pref_matrix_o,
                                    &PyList_Type, &block_sizes_o,
-                                   &directed_o, &loops_o))
+                                   &directed_o, &loops_o, &threads_o,
+                                   &seed_o, &file_o, &format_o))
     return NULL;
 
   if (igraphmodule_PyList_to_matrix_t(pref_matrix_o, &pref_matrix)) return NULL;
@@ -3158,6 +3548,18 @@ PyObject *igraphmodule_Graph_SBM(PyTypeObject * type,
     return NULL;
   }
 
+  if (IGRAPHMODULE_PARALLEL_GENERATOR_REQUESTED(threads_o, seed_o, file_o)) {
+    igraphmodule_generator_init(&gen);
+    result = igraphmodule_i_Graph_run_generator(&gen,
+        igraphmodule_generator_set_options(&gen, threads_o, seed_o) ||
+        igraphmodule_generator_set_sbm(&gen, n, &pref_matrix, &block_sizes,
+          PyObject_IsTrue(directed_o), PyObject_IsTrue(loops_o)),
+        type, file_o, format_o);
+    igraph_matrix_destroy(&pref_matrix);
+    igraph_vector_int_destroy(&block_sizes);
+    return result;
+  }
+
   if (igraph_sbm_game(&g, (igraph_integer_t) n, &pref_matrix, &block_sizes,
                       PyObject_IsTrue(directed_o), PyObject_IsTrue(loops_o))) {
     igraphmodule_handle_igraph_error();
@@ -3234,14 +3636,18 @@ PyObject *igraphmodule_Graph_Static_Fitness(PyTypeObject *type,
   PyObject *fitness_out_o = Py_None, *fitness_in_o = Py_None;
   PyObject *fitness_o = Py_None;
   PyObject *multiple = Py_False, *loops = Py_False;
+  PyObject *threads_o = Py_None, *seed_o = Py_None;
+  PyObject *file_o = Py_None, *format_o = Py_None, *result;
   igraph_vector_t fitness_out, fitness_in;
+  igraphmodule_generator_t gen;
 
   static char *kwlist[] = { "m", "fitness_out", "fitness_in",
-    "loops", "multiple", "fitness", NULL };
+    "loops", "multiple", "fitness", "threads", "seed", "file", "format", NULL };
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "l|OOOOO", kwlist,
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "l|OOOOOOOOO", kwlist,
                                    &m, &fitness_out_o, &fitness_in_o,
-                                   &loops, &multiple, &fitness_o))
+                                   &loops, &multiple, &fitness_o,
+                                   &threads_o, &seed_o, &file_o, &format_o))
     return NULL;
 
   /* This trickery allows us to use "fitness" or "fitness_out" as
@@ -3265,6 +3671,25 @@ PyObject *igraphmodule_Graph_Static_Fitness(PyTypeObject *type,
     }
   }
 
+  if (IGRAPHMODULE_PARALLEL_GENERATOR_REQUESTED(threads_o, seed_o, file_o)) {
+    igraphmodule_generator_init(&gen);
+    if (!PyObject_IsTrue(multiple)) {
+      PyErr_SetString(PyExc_ValueError, "the parallel generator requires "
+          "multiple=True");
+      result = NULL;
+    } else {
+      result = igraphmodule_i_Graph_run_generator(&gen,
+          igraphmodule_generator_set_options(&gen, threads_o, seed_o) ||
+          igraphmodule_generator_set_fitness(&gen, m, &fitness_out,
+            fitness_in_o == Py_None ? 0 : &fitness_in, PyObject_IsTrue(loops)),
+          type, file_o, format_o);
+    }
+    igraph_vector_destroy(&fitness_out);
+    if (fitness_in_o != Py_None)
+      igraph_vector_destroy(&fitness_in);
+    return result;
+  }
+
   if (igraph_static_fitness_game(&g, (igraph_integer_t) m, &fitness_out,
         fitness_in_o == Py_None ? 0 : &fitness_in,
         PyObject_IsTrue(loops), PyObject_IsTrue(multiple))) {
@@ -3297,14 +3722,19 @@ PyObject *igraphmodule_Graph_Static_Power_Law(PyTypeObject *type,
   float exponent_out = -1.0f, exponent_in = -1.0f, exponent = -1.0f;
   PyObject *multiple = Py_False, *loops = Py_False;
   PyObject *finite_size_correction = Py_True;
+  PyObject *threads_o = Py_None, *seed_o = Py_None;
+  PyObject *file_o = Py_None, *format_o = Py_None;
+  igraphmodule_generator_t gen;
 
   static char *kwlist[] = { "n", "m", "exponent_out", "exponent_in",
-    "loops", "multiple", "finite_size_correction", "exponent", NULL };
+    "loops", "multiple", "finite_size_correction", "exponent", "threads",
+    "seed", "file", "format", NULL };
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "ll|ffOOOf", kwlist,
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "ll|ffOOOfOOOO", kwlist,
                                    &n, &m, &exponent_out, &exponent_in,
                                    &loops, &multiple, &finite_size_correction,
-                                   &exponent))
+                                   &exponent, &threads_o, &seed_o, &file_o,
+                                   &format_o))
     return NULL;
 
   /* This trickery allows us to use "exponent" or "exponent_out" as
@@ -3318,6 +3748,21 @@ PyObject *igraphmodule_Graph_Static_Power_Law(PyTypeObject *type,
     return NULL;
   }
 
+  if (IGRAPHMODULE_PARALLEL_GENERATOR_REQUESTED(threads_o, seed_o, file_o)) {
+    if (!PyObject_IsTrue(multiple)) {
+      PyErr_SetString(PyExc_ValueError, "the parallel generator requires "
+          "multiple=True");
+      return NULL;
+    }
+    igraphmodule_generator_init(&gen);
+    return igraphmodule_i_Graph_run_generator(&gen,
+        igraphmodule_generator_set_options(&gen, threads_o, seed_o) ||
+        igraphmodule_generator_set_power_law(&gen, n, m, exponent_out,
+          exponent_in, PyObject_IsTrue(loops),
+          PyObject_IsTrue(finite_size_correction)),
+        type, file_o, format_o);
+  }
+
   if (igraph_static_power_law_game(&g, (igraph_integer_t) n, (igraph_integer_t) m,
         exponent_out, exponent_in,
         PyObject_IsTrue(loops), PyObject_IsTrue(multiple),
@@ -3387,15 +3832,33 @@ PyObject *igraphmodule_Graph_Watts_Strogatz(PyTypeObject * type,
   double p;
   PyObject* loops = Py_False;
   PyObject* multiple = Py_False;
+  PyObject *threads_o = Py_None, *seed_o = Py_None;
+  PyObject *file_o = Py_None, *format_o = Py_None;
   igraphmodule_GraphObject *self;
+  igraphmodule_generator_t gen;
   igraph_t g;
 
-  static char *kwlist[] = { "dim", "size", "nei", "p", "loops", "multiple", NULL };
+  static char *kwlist[] = { "dim", "size", "nei", "p", "loops", "multiple",
+    "threads", "seed", "file", "format", NULL };
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "llld|OO", kwlist,
-                                   &dim, &size, &nei, &p, &loops, &multiple))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "llld|OOOOOO", kwlist,
+                                   &dim, &size, &nei, &p, &loops, &multiple,
+                                   &threads_o, &seed_o, &file_o, &format_o))
     return NULL;
 
+  if (IGRAPHMODULE_PARALLEL_GENERATOR_REQUESTED(threads_o, seed_o, file_o)) {
+    if (dim != 1 || !PyObject_IsTrue(multiple)) {
+      PyErr_SetString(PyExc_ValueError, "the parallel generator requires "
+          "dim=1 and multiple=True");
+      return NULL;
+    }
+    igraphmodule_generator_init(&gen);
+    return igraphmodule_i_Graph_run_generator(&gen,
+        igraphmodule_generator_set_options(&gen, threads_o, seed_o) ||
+        igraphmodule_generator_set_ring(&gen, size, nei, p, PyObject_IsTrue(loops)),
+        type, file_o, format_o);
+  }
+
   if (igraph_watts_strogatz_game(&g, (igraph_integer_t) dim,
         (igraph_integer_t) size, (igraph_integer_t) nei, p,
         PyObject_IsTrue(loops), PyObject_IsTrue(multiple))) {
@@ -3425,9 +3888,8 @@ PyObject *igraphmodule_Graph_Weighted_Adjacency(PyTypeObject * type,
 
   static char *kwlist[] = { "matrix", "mode", "attr", "loops", NULL };
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!|OOO", kwlist,
-                                   &PyList_Type, &matrix, &mode_o, &attr_o,
-                                   &loops))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOO", kwlist,
+                                   &matrix, &mode_o, &attr_o, &loops))
     return NULL;
 
   if (igraphmodule_PyObject_to_adjacency_t(mode_o, &mode))
@@ -3600,6 +4062,7 @@ PyObject *igraphmodule_Graph_authority_score(
   PyObject *res_o;
   igraph_real_t value;
   igraph_vector_t res, *weights = 0;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOO!O", kwlist, &weights_o,
 	                               &scale_o, &igraphmodule_ARPACKOptionsType,
@@ -3612,8 +4075,17 @@ PyObject *igraphmodule_Graph_authority_score(
 	  ATTRIBUTE_TYPE_EDGE)) return NULL;
 
   arpack_options = (igraphmodule_ARPACKOptionsObject*)arpack_options_o;
-  if (igraph_authority_score(&self->g, &res, &value, PyObject_IsTrue(scale_o),
-      weights, igraphmodule_ARPACKOptions_get(arpack_options))) {
+  if (igraphmodule_ARPACKSession_Check(arpack_options_o)) {
+    retval = igraphmodule_ARPACKSession_solve(
+        (igraphmodule_ARPACKSessionObject*)arpack_options_o, &self->g,
+        IGRAPHMODULE_ARPACK_AUTHORITY_SCORE, PyObject_IsTrue(scale_o), weights,
+        &res, &value);
+  } else {
+    retval = igraph_authority_score(&self->g, &res, &value,
+        PyObject_IsTrue(scale_o), weights,
+        igraphmodule_ARPACKOptions_get(arpack_options));
+  }
+  if (retval) {
     igraphmodule_handle_igraph_error();
     if (weights) { igraph_vector_destroy(weights); free(weights); }
     igraph_vector_destroy(&res);
@@ -3651,14 +4123,19 @@ PyObject *igraphmodule_Graph_average_path_length(igraphmodule_GraphObject *
   char *kwlist[] = { "directed", "unconn", NULL };
   PyObject *directed = Py_True, *unconn = Py_True;
   igraph_real_t res;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O!O!", kwlist,
                                    &PyBool_Type, &directed,
                                    &PyBool_Type, &unconn))
     return NULL;
 
-  if (igraph_average_path_length(&self->g, &res, (directed == Py_True),
-                                 (unconn == Py_True))) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_average_path_length(&self->g, &res, (directed == Py_True),
+                                      (unconn == Py_True));
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraphmodule_handle_igraph_error();
     return NULL;
   }
@@ -3666,95 +4143,484 @@ PyObject *igraphmodule_Graph_average_path_length(igraphmodule_GraphObject *
   return PyFloat_FromDouble(res);
 }
 
-/** \ingroup python_interface_graph
- * \brief Calculates the betweennesses of some vertices in a graph.
- * \return the betweennesses as a list (or a single float)
- * \sa igraph_betweenness
+/**
+ * \ingroup python_interface_graph
+ * \brief Number of sampled source vertices of the approximate centralities
+ *        if the user did not specify it
  */
-PyObject *igraphmodule_Graph_betweenness(igraphmodule_GraphObject * self,
-                                         PyObject * args, PyObject * kwds)
-{
-  static char *kwlist[] = { "vertices", "directed", "cutoff", "weights",
-    "nobigint", NULL };
-  PyObject *directed = Py_True;
-  PyObject *vobj = Py_None, *list;
-  PyObject *cutoff = Py_None;
-  PyObject *weights_o = Py_None;
-  PyObject *nobigint = Py_True;
-  igraph_vector_t res, *weights = 0;
-  igraph_bool_t return_single = 0;
-  igraph_vs_t vs;
+#define IGRAPHMODULE_CENTRALITY_DEFAULT_SAMPLES 256
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOO", kwlist,
-                                   &vobj, &directed, &cutoff, &weights_o,
-                                   &nobigint)) {
-    return NULL;
-  }
+/**
+ * \ingroup python_interface_graph
+ * \brief Probability with which the error bound of an approximate centrality
+ *        may be exceeded by at least one of the vertices or edges
+ */
+#define IGRAPHMODULE_CENTRALITY_ERROR_PROBABILITY 0.05
 
-  if (igraphmodule_attrib_to_vector_t(weights_o, self, &weights,
-	  ATTRIBUTE_TYPE_EDGE)) return NULL;
+/**
+ * \ingroup python_interface_graph
+ * \brief Options of the parallel and approximate centralities
+ */
+typedef struct {
+  igraph_bool_t approximate;
+  long int samples;
+  unsigned long int seed;
+  long int threads;
+} igraphmodule_i_centrality_options_t;
 
-  if (igraphmodule_PyObject_to_vs_t(vobj, &vs, &self->g, &return_single, 0)) {
-    if (weights) { igraph_vector_destroy(weights); free(weights); }
-    igraphmodule_handle_igraph_error();
-    return NULL;
+/**
+ * \ingroup python_interface_graph
+ * \brief Converts the keyword arguments of the parallel and approximate
+ *        centralities
+ *
+ * \param use_kernel set to true if any of the arguments asks for the
+ *        parallel kernels of the module instead of the C core
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+static int igraphmodule_i_centrality_options_init(
+    igraphmodule_i_centrality_options_t *opts, PyObject *approximate_o,
+    PyObject *samples_o, PyObject *seed_o, PyObject *threads_o,
+    igraph_bool_t *use_kernel) {
+  opts->approximate = PyObject_IsTrue(approximate_o);
+  opts->samples = IGRAPHMODULE_CENTRALITY_DEFAULT_SAMPLES;
+  opts->threads = 1;
+  opts->seed = 0;
+
+  if (samples_o != Py_None) {
+    opts->samples = PyInt_AsLong(samples_o);
+    if (PyErr_Occurred())
+      return 1;
+    if (opts->samples <= 0) {
+      PyErr_SetString(PyExc_ValueError, "samples must be positive");
+      return 1;
+    }
   }
 
-  if (igraph_vector_init(&res, 0)) {
-    igraph_vs_destroy(&vs);
-    if (weights) { igraph_vector_destroy(weights); free(weights); }
-    return igraphmodule_handle_igraph_error();
+  if (threads_o != Py_None) {
+    opts->threads = PyInt_AsLong(threads_o);
+    if (PyErr_Occurred())
+      return 1;
+    if (opts->threads <= 0) {
+      PyErr_SetString(PyExc_ValueError, "threads must be positive");
+      return 1;
+    }
   }
 
-  if (cutoff == Py_None) {
-    if (igraph_betweenness(&self->g, &res, vs, PyObject_IsTrue(directed),
-          weights, PyObject_IsTrue(nobigint))) {
-      igraph_vs_destroy(&vs);
-      igraph_vector_destroy(&res);
-      if (weights) { igraph_vector_destroy(weights); free(weights); }
-      igraphmodule_handle_igraph_error();
-      return NULL;
-    }
-  } else if (PyNumber_Check(cutoff)) {
-    PyObject *cutoff_num = PyNumber_Float(cutoff);
-    if (cutoff_num == NULL) {
-      igraph_vs_destroy(&vs);
-      igraph_vector_destroy(&res);
-      if (weights) { igraph_vector_destroy(weights); free(weights); }
-      return NULL;
-    }
-    if (igraph_betweenness_estimate(&self->g, &res, vs, PyObject_IsTrue(directed),
-        (igraph_real_t)PyFloat_AsDouble(cutoff_num), weights,
-        PyObject_IsTrue(nobigint))) {
-      igraph_vs_destroy(&vs);
-      igraph_vector_destroy(&res);
-      if (weights) { igraph_vector_destroy(weights); free(weights); }
-      Py_DECREF(cutoff_num);
-      igraphmodule_handle_igraph_error();
-      return NULL;
+  if (opts->approximate) {
+    if (seed_o == Py_None) {
+      opts->seed = (unsigned long int) igraph_rng_get_integer(igraph_rng_default(),
+          0, 0x7fffffffL);
+    } else {
+      opts->seed = PyLong_AsUnsignedLongMask(seed_o);
+      if (PyErr_Occurred())
+        return 1;
     }
-    Py_DECREF(cutoff_num);
-  } else {
-    PyErr_SetString(PyExc_TypeError, "cutoff value must be None or integer");
-    igraph_vs_destroy(&vs);
-    igraph_vector_destroy(&res);
-    if (weights) { igraph_vector_destroy(weights); free(weights); }
-    return NULL;
   }
 
-  if (!return_single)
-    list = igraphmodule_vector_t_to_PyList(&res, IGRAPHMODULE_TYPE_FLOAT);
-  else
-    list = PyFloat_FromDouble(VECTOR(res)[0]);
-
-  igraph_vector_destroy(&res);
-  igraph_vs_destroy(&vs);
-  if (weights) { igraph_vector_destroy(weights); free(weights); }
+  *use_kernel = opts->approximate || threads_o != Py_None;
 
-  return list;
+  return 0;
 }
 
-/** \ingroup python_interface_graph
+/**
+ * \ingroup python_interface_graph
+ * \brief Converts the cutoff of a centrality for the parallel kernels;
+ *        \c None becomes -1, meaning no cutoff
+ */
+static int igraphmodule_i_centrality_cutoff(PyObject *cutoff_o, igraph_real_t *cutoff) {
+  PyObject *cutoff_num;
+
+  if (cutoff_o == Py_None) {
+    *cutoff = -1;
+    return 0;
+  }
+
+  if (!PyNumber_Check(cutoff_o)) {
+    PyErr_SetString(PyExc_TypeError, "cutoff value must be None or integer");
+    return 1;
+  }
+
+  cutoff_num = PyNumber_Float(cutoff_o);
+  if (cutoff_num == NULL)
+    return 1;
+  *cutoff = (igraph_real_t)PyFloat_AsDouble(cutoff_num);
+  Py_DECREF(cutoff_num);
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Calculates vertex and/or edge betweenness scores with the parallel
+ *        kernel, from all the vertices or from a sample of them
+ *
+ * With a sample of \c k sources out of \c n, the dependencies are scaled
+ * by <tt>n/k</tt>. The error bound follows from Hoeffding's inequality and
+ * the union bound over all the vertices (edges): the dependency of a vertex
+ * (edge) on a single source is at most <tt>n-2</tt> (<tt>n-1</tt>).
+ *
+ * \param vertex_res the vertex betweenness scores of all the vertices are
+ *        returned here, unless it is a null pointer
+ * \param edge_res the edge betweenness scores of all the edges are returned
+ *        here, unless it is a null pointer
+ * \param error the error bound of the scores is returned here; zero if all
+ *        the vertices were used as sources
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+static int igraphmodule_i_Graph_betweenness_kernel(igraphmodule_GraphObject *self,
+    const igraph_vector_t *weights, igraph_bool_t directed, igraph_real_t cutoff,
+    const igraphmodule_i_centrality_options_t *opts,
+    igraph_vector_t *vertex_res, igraph_vector_t *edge_res, igraph_real_t *error) {
+  igraph_t *g = &self->g;
+  long int no_of_nodes = igraph_vcount(g), no_of_edges = igraph_ecount(g), k;
+  igraph_bool_t undirected = !directed || !igraph_is_directed(g);
+  igraphmodule_pathsearch_graph_t graph;
+  igraph_vector_t sources;
+  igraph_real_t scale, range, items;
+  int retval;
+
+  if (weights && igraph_vector_size(weights) > 0 && !(igraph_vector_min(weights) > 0)) {
+    PyErr_SetString(PyExc_ValueError, "weights must be positive");
+    return 1;
+  }
+
+  if (igraph_vector_init(&sources, 0)) {
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+  if (igraphmodule_sample_sources(no_of_nodes,
+        opts->approximate ? opts->samples : no_of_nodes, opts->seed, &sources)) {
+    igraph_vector_destroy(&sources);
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+
+  if (igraphmodule_pathsearch_graph_init(&graph, g,
+        undirected ? IGRAPH_ALL : IGRAPH_OUT, weights)) {
+    igraph_vector_destroy(&sources);
+    return 1;
+  }
+
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraphmodule_betweenness_sources(&graph, cutoff, &sources,
+      opts->threads, vertex_res, edge_res);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  k = igraph_vector_size(&sources);
+  igraphmodule_pathsearch_graph_destroy(&graph);
+  igraph_vector_destroy(&sources);
+
+  if (retval) {
+    PyErr_NoMemory();
+    return 1;
+  }
+
+  /* Every path is counted from both of its ends in undirected graphs */
+  scale = (k > 0 ? ((igraph_real_t) no_of_nodes) / k : 0) * (undirected ? 0.5 : 1);
+  if (vertex_res)
+    igraph_vector_scale(vertex_res, scale);
+  if (edge_res)
+    igraph_vector_scale(edge_res, scale);
+
+  *error = 0;
+  if (k < no_of_nodes) {
+    items = vertex_res ? no_of_nodes : no_of_edges;
+    range = ((igraph_real_t) no_of_nodes) * (vertex_res ? no_of_nodes - 2 : no_of_nodes - 1);
+    if (items > 0 && range > 0) {
+      *error = range * sqrt(log(2 * items / IGRAPHMODULE_CENTRALITY_ERROR_PROBABILITY) / (2 * k));
+      if (undirected)
+        *error /= 2;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Calculates closeness centralities with the parallel kernel, using
+ *        all the vertices or a sample of them as the other endpoints
+ *
+ * The exact scores are calculated with one search from each of the given
+ * vertices. The approximate scores are calculated from \c k searches
+ * from sampled vertices in the opposite direction: the sum of the
+ * distances of a vertex to the sample, scaled by <tt>(n-1)/k</tt>,
+ * estimates the sum of its distances to all the others. The error bound
+ * applies to these sums and follows from Hoeffding's inequality and the
+ * union bound over all the vertices.
+ *
+ * \param vids the vertices to calculate the closeness of
+ * \param res the closeness centralities of the given vertices are returned
+ *        here
+ * \param error the error bound of the sum of the distances is returned
+ *        here; zero if the scores are exact
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+static int igraphmodule_i_Graph_closeness_kernel(igraphmodule_GraphObject *self,
+    const igraph_vector_t *vids, igraph_neimode_t mode,
+    const igraph_vector_t *weights, igraph_real_t cutoff,
+    igraph_bool_t normalized, const igraphmodule_i_centrality_options_t *opts,
+    igraph_vector_t *res, igraph_real_t *error) {
+  igraph_t *g = &self->g;
+  long int i, k, v, pos, no_of_nodes = igraph_vcount(g), n = igraph_vector_size(vids);
+  igraph_bool_t approximate = opts->approximate && opts->samples < no_of_nodes;
+  igraphmodule_pathsearch_graph_t graph;
+  igraph_vector_t sources, sums;
+  igraph_real_t max_dist = 0, far;
+  int retval;
+
+  if (weights && igraph_vector_size(weights) > 0 && !(igraph_vector_min(weights) > 0)) {
+    PyErr_SetString(PyExc_ValueError, "weights must be positive");
+    return 1;
+  }
+
+  if (!igraph_is_directed(g))
+    mode = IGRAPH_ALL;
+  /* The approximation searches towards the vertices, not from them */
+  if (approximate && mode != IGRAPH_ALL)
+    mode = (mode == IGRAPH_OUT) ? IGRAPH_IN : IGRAPH_OUT;
+
+  if (igraph_vector_init(&sources, 0)) {
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+  if (igraph_vector_init(&sums, 0)) {
+    igraph_vector_destroy(&sources);
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+  if (approximate ?
+      igraphmodule_sample_sources(no_of_nodes, opts->samples, opts->seed, &sources) :
+      igraph_vector_update(&sources, vids)) {
+    igraph_vector_destroy(&sums);
+    igraph_vector_destroy(&sources);
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+
+  if (igraphmodule_pathsearch_graph_init(&graph, g, mode, weights)) {
+    igraph_vector_destroy(&sums);
+    igraph_vector_destroy(&sources);
+    return 1;
+  }
+
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  if (approximate)
+    retval = igraphmodule_farness_sources(&graph, cutoff, &sources,
+        opts->threads, 0, &sums, &max_dist);
+  else
+    retval = igraphmodule_farness_sources(&graph, cutoff, &sources,
+        opts->threads, &sums, 0, 0);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  igraphmodule_pathsearch_graph_destroy(&graph);
+
+  if (retval || igraph_vector_resize(res, n)) {
+    igraph_vector_destroy(&sums);
+    igraph_vector_destroy(&sources);
+    PyErr_NoMemory();
+    return 1;
+  }
+
+  k = igraph_vector_size(&sources);
+  for (i = 0; i < n; i++) {
+    if (approximate) {
+      v = (long int) VECTOR(*vids)[i];
+      far = VECTOR(sums)[v];
+      if (igraph_vector_binsearch(&sources, v, &pos))
+        far = (k > 1) ? far * (no_of_nodes - 1) / (k - 1) : IGRAPH_NAN;
+      else
+        far = far * (no_of_nodes - 1) / k;
+    } else {
+      far = VECTOR(sums)[i];
+    }
+    VECTOR(*res)[i] = 1.0 / far;
+    if (normalized)
+      VECTOR(*res)[i] *= (no_of_nodes - 1);
+  }
+
+  *error = 0;
+  if (approximate && no_of_nodes > 1) {
+    if (max_dist < no_of_nodes)
+      max_dist = no_of_nodes;
+    *error = (no_of_nodes - 1) * max_dist *
+      sqrt(log(2.0 * no_of_nodes / IGRAPHMODULE_CENTRALITY_ERROR_PROBABILITY) / (2 * k));
+  }
+
+  igraph_vector_destroy(&sums);
+  igraph_vector_destroy(&sources);
+
+  return 0;
+}
+
+/** \ingroup python_interface_graph
+ * \brief Calculates the betweennesses of some vertices in a graph.
+ * \return the betweennesses as a list (or a single float)
+ * \sa igraph_betweenness
+ */
+PyObject *igraphmodule_Graph_betweenness(igraphmodule_GraphObject * self,
+                                         PyObject * args, PyObject * kwds)
+{
+  static char *kwlist[] = { "vertices", "directed", "cutoff", "weights",
+    "nobigint", "return_type", "approximate", "samples", "seed", "threads",
+    NULL };
+  PyObject *directed = Py_True;
+  PyObject *vobj = Py_None, *list;
+  PyObject *cutoff = Py_None;
+  PyObject *weights_o = Py_None;
+  PyObject *nobigint = Py_True;
+  PyObject *return_type_o = Py_None;
+  PyObject *approximate_o = Py_False, *samples_o = Py_None;
+  PyObject *seed_o = Py_None, *threads_o = Py_None;
+  igraphmodule_return_type_t return_type = IGRAPHMODULE_RETURN_LIST;
+  igraphmodule_i_centrality_options_t opts;
+  igraph_vector_t res, *weights = 0;
+  igraph_bool_t return_single = 0, use_kernel;
+  igraph_real_t error = 0;
+  igraph_vs_t vs;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOOOOOOO", kwlist,
+                                   &vobj, &directed, &cutoff, &weights_o,
+                                   &nobigint, &return_type_o, &approximate_o,
+                                   &samples_o, &seed_o, &threads_o)) {
+    return NULL;
+  }
+
+  if (igraphmodule_PyObject_to_return_type_t(return_type_o, &return_type))
+    return NULL;
+
+  if (igraphmodule_i_centrality_options_init(&opts, approximate_o, samples_o,
+        seed_o, threads_o, &use_kernel))
+    return NULL;
+
+  if (igraphmodule_attrib_to_vector_t(weights_o, self, &weights,
+	  ATTRIBUTE_TYPE_EDGE)) return NULL;
+
+  if (igraphmodule_PyObject_to_vs_t(vobj, &vs, &self->g, &return_single, 0)) {
+    if (weights) { igraph_vector_destroy(weights); free(weights); }
+    igraphmodule_handle_igraph_error();
+    return NULL;
+  }
+
+  if (igraph_vector_init(&res, 0)) {
+    igraph_vs_destroy(&vs);
+    if (weights) { igraph_vector_destroy(weights); free(weights); }
+    return igraphmodule_handle_igraph_error();
+  }
+
+  if (use_kernel) {
+    /* The kernel calculates the scores of all the vertices */
+    igraph_vector_t all, vids;
+    igraph_real_t cutoff_value;
+    long int i;
+    int retval = 1;
+
+    if (!igraphmodule_i_centrality_cutoff(cutoff, &cutoff_value)) {
+      if (igraph_vector_init(&all, 0)) {
+        igraphmodule_handle_igraph_error();
+      } else {
+        if (!igraphmodule_i_Graph_betweenness_kernel(self, weights,
+              PyObject_IsTrue(directed), cutoff_value, &opts, &all, 0, &error)) {
+          if (igraph_vector_init(&vids, 0)) {
+            igraphmodule_handle_igraph_error();
+          } else {
+            if (igraph_vs_as_vector(&self->g, vs, &vids) ||
+                igraph_vector_resize(&res, igraph_vector_size(&vids))) {
+              igraphmodule_handle_igraph_error();
+            } else {
+              for (i = 0; i < igraph_vector_size(&vids); i++)
+                VECTOR(res)[i] = VECTOR(all)[(long int) VECTOR(vids)[i]];
+              retval = 0;
+            }
+            igraph_vector_destroy(&vids);
+          }
+        }
+        igraph_vector_destroy(&all);
+      }
+    }
+
+    if (retval) {
+      igraph_vs_destroy(&vs);
+      igraph_vector_destroy(&res);
+      if (weights) { igraph_vector_destroy(weights); free(weights); }
+      return NULL;
+    }
+  } else if (cutoff == Py_None) {
+    igraph_bool_t is_directed = PyObject_IsTrue(directed);
+    igraph_bool_t is_nobigint = PyObject_IsTrue(nobigint);
+    int retval;
+
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraph_betweenness(&self->g, &res, vs, is_directed, weights,
+        is_nobigint);
+    IGRAPHMODULE_END_NOGIL(self);
+
+    if (retval) {
+      igraph_vs_destroy(&vs);
+      igraph_vector_destroy(&res);
+      if (weights) { igraph_vector_destroy(weights); free(weights); }
+      igraphmodule_handle_igraph_error();
+      return NULL;
+    }
+  } else if (PyNumber_Check(cutoff)) {
+    PyObject *cutoff_num = PyNumber_Float(cutoff);
+    igraph_bool_t is_directed, is_nobigint;
+    igraph_real_t cutoff_value;
+    int retval;
+
+    if (cutoff_num == NULL) {
+      igraph_vs_destroy(&vs);
+      igraph_vector_destroy(&res);
+      if (weights) { igraph_vector_destroy(weights); free(weights); }
+      return NULL;
+    }
+
+    is_directed = PyObject_IsTrue(directed);
+    is_nobigint = PyObject_IsTrue(nobigint);
+    cutoff_value = (igraph_real_t)PyFloat_AsDouble(cutoff_num);
+
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraph_betweenness_estimate(&self->g, &res, vs, is_directed,
+        cutoff_value, weights, is_nobigint);
+    IGRAPHMODULE_END_NOGIL(self);
+
+    if (retval) {
+      igraph_vs_destroy(&vs);
+      igraph_vector_destroy(&res);
+      if (weights) { igraph_vector_destroy(weights); free(weights); }
+      Py_DECREF(cutoff_num);
+      igraphmodule_handle_igraph_error();
+      return NULL;
+    }
+    Py_DECREF(cutoff_num);
+  } else {
+    PyErr_SetString(PyExc_TypeError, "cutoff value must be None or integer");
+    igraph_vs_destroy(&vs);
+    igraph_vector_destroy(&res);
+    if (weights) { igraph_vector_destroy(weights); free(weights); }
+    return NULL;
+  }
+
+  if (!return_single)
+    list = igraphmodule_vector_t_to_PyObject(&res, IGRAPHMODULE_TYPE_FLOAT,
+        return_type);
+  else
+    list = PyFloat_FromDouble(VECTOR(res)[0]);
+
+  igraph_vector_destroy(&res);
+  igraph_vs_destroy(&vs);
+  if (weights) { igraph_vector_destroy(weights); free(weights); }
+
+  if (list && opts.approximate)
+    return Py_BuildValue("Nd", list, (double) error);
+
+  return list;
+}
+
+/** \ingroup python_interface_graph
  * \brief Calculates the bibliographic coupling of some vertices in a graph.
  * \return the bibliographic coupling values in a matrix
  * \sa igraph_bibcoupling
@@ -4027,18 +4893,35 @@ PyObject *igraphmodule_Graph_closeness(igraphmodule_GraphObject * self,
                                        PyObject * args, PyObject * kwds)
 {
   static char *kwlist[] = { "vertices", "mode", "cutoff", "weights",
-			    "normalized", NULL };
+			    "normalized", "return_type", "approximate", "samples",
+			    "seed", "threads", NULL };
   PyObject *vobj = Py_None, *list = NULL, *cutoff = Py_None,
-           *mode_o = Py_None, *weights_o = Py_None, *normalized_o = Py_True;
+           *mode_o = Py_None, *weights_o = Py_None, *normalized_o = Py_True,
+           *return_type_o = Py_None, *approximate_o = Py_False,
+           *samples_o = Py_None, *seed_o = Py_None, *threads_o = Py_None;
   igraph_vector_t res, *weights = 0;
   igraph_neimode_t mode = IGRAPH_ALL;
-  int return_single = 0;
+  igraphmodule_return_type_t return_type = IGRAPHMODULE_RETURN_LIST;
+  igraphmodule_i_centrality_options_t opts;
+  int return_single = 0, retval;
+  igraph_bool_t normalized, use_kernel;
+  igraph_real_t error = 0;
   igraph_vs_t vs;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOO", kwlist, &vobj,
-      &mode_o, &cutoff, &weights_o, &normalized_o))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOOOOOOO", kwlist, &vobj,
+      &mode_o, &cutoff, &weights_o, &normalized_o, &return_type_o,
+      &approximate_o, &samples_o, &seed_o, &threads_o))
     return NULL;
 
+  if (igraphmodule_PyObject_to_return_type_t(return_type_o, &return_type))
+    return NULL;
+
+  if (igraphmodule_i_centrality_options_init(&opts, approximate_o, samples_o,
+        seed_o, threads_o, &use_kernel))
+    return NULL;
+
+  normalized = PyObject_IsTrue(normalized_o);
+
   if (igraphmodule_PyObject_to_neimode_t(mode_o, &mode)) return NULL;
   if (igraphmodule_PyObject_to_vs_t(vobj, &vs, &self->g, &return_single, 0)) {
     igraphmodule_handle_igraph_error();
@@ -4057,9 +4940,36 @@ PyObject *igraphmodule_Graph_closeness(igraphmodule_GraphObject * self,
     return NULL;
   }
 
-  if (cutoff == Py_None) {
-    if (igraph_closeness(&self->g, &res, vs, mode, weights,
-			 PyObject_IsTrue(normalized_o))) {
+  if (use_kernel) {
+    igraph_vector_t vids;
+    igraph_real_t cutoff_value;
+
+    retval = 1;
+    if (!igraphmodule_i_centrality_cutoff(cutoff, &cutoff_value)) {
+      if (igraph_vector_init(&vids, 0)) {
+        igraphmodule_handle_igraph_error();
+      } else {
+        if (igraph_vs_as_vector(&self->g, vs, &vids)) {
+          igraphmodule_handle_igraph_error();
+        } else {
+          retval = igraphmodule_i_Graph_closeness_kernel(self, &vids, mode,
+              weights, cutoff_value, normalized, &opts, &res, &error);
+        }
+        igraph_vector_destroy(&vids);
+      }
+    }
+
+    if (retval) {
+      igraph_vs_destroy(&vs);
+      igraph_vector_destroy(&res);
+      if (weights) { igraph_vector_destroy(weights); free(weights); }
+      return NULL;
+    }
+  } else if (cutoff == Py_None) {
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraph_closeness(&self->g, &res, vs, mode, weights, normalized);
+    IGRAPHMODULE_END_NOGIL(self);
+    if (retval) {
       igraph_vs_destroy(&vs);
       igraph_vector_destroy(&res);
       if (weights) { igraph_vector_destroy(weights); free(weights); }
@@ -4068,13 +4978,17 @@ PyObject *igraphmodule_Graph_closeness(igraphmodule_GraphObject * self,
     }
   } else if (PyNumber_Check(cutoff)) {
     PyObject *cutoff_num = PyNumber_Float(cutoff);
+    igraph_real_t cutoff_value;
     if (cutoff_num == NULL) {
       igraph_vs_destroy(&vs); igraph_vector_destroy(&res);
       return NULL;
     }
-    if (igraph_closeness_estimate(&self->g, &res, vs, mode,
-        (igraph_real_t)PyFloat_AsDouble(cutoff_num), weights,
-	PyObject_IsTrue(normalized_o))) {
+    cutoff_value = (igraph_real_t)PyFloat_AsDouble(cutoff_num);
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraph_closeness_estimate(&self->g, &res, vs, mode,
+        cutoff_value, weights, normalized);
+    IGRAPHMODULE_END_NOGIL(self);
+    if (retval) {
       igraph_vs_destroy(&vs);
       igraph_vector_destroy(&res);
       if (weights) { igraph_vector_destroy(weights); free(weights); }
@@ -4088,13 +5002,17 @@ PyObject *igraphmodule_Graph_closeness(igraphmodule_GraphObject * self,
   if (weights) { igraph_vector_destroy(weights); free(weights); }
 
   if (!return_single)
-    list = igraphmodule_vector_t_to_PyList(&res, IGRAPHMODULE_TYPE_FLOAT);
+    list = igraphmodule_vector_t_to_PyObject(&res, IGRAPHMODULE_TYPE_FLOAT,
+        return_type);
   else
     list = PyFloat_FromDouble(VECTOR(res)[0]);
 
   igraph_vector_destroy(&res);
   igraph_vs_destroy(&vs);
 
+  if (list && opts.approximate)
+    return Py_BuildValue("Nd", list, (double) error);
+
   return list;
 }
 
@@ -4249,6 +5167,9 @@ PyObject *igraphmodule_Graph_contract_vertices(igraphmodule_GraphObject * self,
 		&combination_o))
 	return NULL;
 
+  if (!igraphmodule_Graph_check_not_busy(self))
+    return NULL;
+
   if (igraphmodule_PyObject_to_attribute_combination_t(
 		combination_o, &combination))
 	return NULL;
@@ -4430,13 +5351,27 @@ PyObject *igraphmodule_Graph_edge_betweenness(igraphmodule_GraphObject * self,
                                               PyObject * args,
                                               PyObject * kwds)
 {
-  static char *kwlist[] = { "directed", "cutoff", "weights", NULL };
+  static char *kwlist[] = { "directed", "cutoff", "weights", "approximate",
+    "samples", "seed", "threads", NULL };
   igraph_vector_t res, *weights = 0;
   PyObject *list, *directed = Py_True, *cutoff = Py_None;
-  PyObject *weights_o = Py_None;
+  PyObject *weights_o = Py_None, *approximate_o = Py_False;
+  PyObject *samples_o = Py_None, *seed_o = Py_None, *threads_o = Py_None;
+  igraphmodule_i_centrality_options_t opts;
+  igraph_bool_t is_directed, use_kernel;
+  igraph_real_t error = 0;
+  int retval;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOO", kwlist,
-                                   &directed, &cutoff, &weights_o))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOOOO", kwlist,
+                                   &directed, &cutoff, &weights_o,
+                                   &approximate_o, &samples_o, &seed_o,
+                                   &threads_o))
+    return NULL;
+
+  is_directed = PyObject_IsTrue(directed);
+
+  if (igraphmodule_i_centrality_options_init(&opts, approximate_o, samples_o,
+        seed_o, threads_o, &use_kernel))
     return NULL;
 
   if (igraphmodule_attrib_to_vector_t(weights_o, self, &weights,
@@ -4444,8 +5379,21 @@ PyObject *igraphmodule_Graph_edge_betweenness(igraphmodule_GraphObject * self,
 
   igraph_vector_init(&res, igraph_ecount(&self->g));
 
-  if (cutoff == Py_None) {
-    if (igraph_edge_betweenness(&self->g, &res, PyObject_IsTrue(directed), weights)) {
+  if (use_kernel) {
+    igraph_real_t cutoff_value;
+
+    if (igraphmodule_i_centrality_cutoff(cutoff, &cutoff_value) ||
+        igraphmodule_i_Graph_betweenness_kernel(self, weights, is_directed,
+          cutoff_value, &opts, 0, &res, &error)) {
+      if (weights) { igraph_vector_destroy(weights); free(weights); }
+      igraph_vector_destroy(&res);
+      return NULL;
+    }
+  } else if (cutoff == Py_None) {
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraph_edge_betweenness(&self->g, &res, is_directed, weights);
+    IGRAPHMODULE_END_NOGIL(self);
+    if (retval) {
       igraphmodule_handle_igraph_error();
       if (weights) { igraph_vector_destroy(weights); free(weights); }
       igraph_vector_destroy(&res);
@@ -4453,12 +5401,17 @@ PyObject *igraphmodule_Graph_edge_betweenness(igraphmodule_GraphObject * self,
     }
   } else if (PyNumber_Check(cutoff)) {
     PyObject *cutoff_num = PyNumber_Float(cutoff);
+    igraph_real_t cutoff_value;
     if (!cutoff_num) {
       if (weights) { igraph_vector_destroy(weights); free(weights); }
       igraph_vector_destroy(&res); return NULL;
     }
-    if (igraph_edge_betweenness_estimate(&self->g, &res, PyObject_IsTrue(directed),
-        (igraph_real_t)PyFloat_AsDouble(cutoff_num), weights)) {
+    cutoff_value = (igraph_real_t)PyFloat_AsDouble(cutoff_num);
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraph_edge_betweenness_estimate(&self->g, &res, is_directed,
+        cutoff_value, weights);
+    IGRAPHMODULE_END_NOGIL(self);
+    if (retval) {
       igraphmodule_handle_igraph_error();
       igraph_vector_destroy(&res);
       if (weights) { igraph_vector_destroy(weights); free(weights); }
@@ -4476,6 +5429,10 @@ PyObject *igraphmodule_Graph_edge_betweenness(igraphmodule_GraphObject * self,
 
   list = igraphmodule_vector_t_to_PyList(&res, IGRAPHMODULE_TYPE_FLOAT);
   igraph_vector_destroy(&res);
+
+  if (list && opts.approximate)
+    return Py_BuildValue("Nd", list, (double) error);
+
   return list;
 }
 
@@ -4534,11 +5491,12 @@ PyObject *igraphmodule_Graph_eigenvector_centrality(
   PyObject *res_o;
   igraph_real_t value;
   igraph_vector_t *weights=0, res;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOO!O", kwlist,
                                    &directed_o, &scale_o, &weights_o,
                                    &igraphmodule_ARPACKOptionsType,
-                                   &arpack_options, &return_eigenvalue))
+                                   &arpack_options_o, &return_eigenvalue))
     return NULL;
 
   if (igraphmodule_attrib_to_vector_t(weights_o, self, &weights,
@@ -4550,9 +5508,19 @@ PyObject *igraphmodule_Graph_eigenvector_centrality(
   }
 
   arpack_options = (igraphmodule_ARPACKOptionsObject*)arpack_options_o;
-  if (igraph_eigenvector_centrality(&self->g, &res, &value,
-      PyObject_IsTrue(directed_o), PyObject_IsTrue(scale_o),
-      weights, igraphmodule_ARPACKOptions_get(arpack_options))) {
+  if (igraphmodule_ARPACKSession_Check(arpack_options_o)) {
+    retval = igraphmodule_ARPACKSession_solve(
+        (igraphmodule_ARPACKSessionObject*)arpack_options_o, &self->g,
+        PyObject_IsTrue(directed_o) && igraph_is_directed(&self->g) ?
+          IGRAPHMODULE_ARPACK_EIGENVECTOR_CENTRALITY_DIRECTED :
+          IGRAPHMODULE_ARPACK_EIGENVECTOR_CENTRALITY,
+        PyObject_IsTrue(scale_o), weights, &res, &value);
+  } else {
+    retval = igraph_eigenvector_centrality(&self->g, &res, &value,
+        PyObject_IsTrue(directed_o), PyObject_IsTrue(scale_o),
+        weights, igraphmodule_ARPACKOptions_get(arpack_options));
+  }
+  if (retval) {
     igraphmodule_handle_igraph_error();
     if (weights) { igraph_vector_destroy(weights); free(weights); }
     igraph_vector_destroy(&res);
@@ -4900,10 +5868,11 @@ PyObject *igraphmodule_Graph_hub_score(
   PyObject *res_o;
   igraph_real_t value;
   igraph_vector_t res, *weights = 0;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOO!O", kwlist, &weights_o,
                                    &scale_o, &igraphmodule_ARPACKOptionsType,
-                                   &arpack_options, &return_eigenvalue))
+                                   &arpack_options_o, &return_eigenvalue))
     return NULL;
 
   if (igraph_vector_init(&res, 0)) return igraphmodule_handle_igraph_error();
@@ -4912,8 +5881,16 @@ PyObject *igraphmodule_Graph_hub_score(
     ATTRIBUTE_TYPE_EDGE)) return NULL;
 
   arpack_options = (igraphmodule_ARPACKOptionsObject*)arpack_options_o;
-  if (igraph_hub_score(&self->g, &res, &value, PyObject_IsTrue(scale_o),
-      weights, igraphmodule_ARPACKOptions_get(arpack_options))) {
+  if (igraphmodule_ARPACKSession_Check(arpack_options_o)) {
+    retval = igraphmodule_ARPACKSession_solve(
+        (igraphmodule_ARPACKSessionObject*)arpack_options_o, &self->g,
+        IGRAPHMODULE_ARPACK_HUB_SCORE, PyObject_IsTrue(scale_o), weights,
+        &res, &value);
+  } else {
+    retval = igraph_hub_score(&self->g, &res, &value, PyObject_IsTrue(scale_o),
+        weights, igraphmodule_ARPACKOptions_get(arpack_options));
+  }
+  if (retval) {
     igraphmodule_handle_igraph_error();
     if (weights) { igraph_vector_destroy(weights); free(weights); }
     igraph_vector_destroy(&res);
@@ -4960,25 +5937,72 @@ PyObject *igraphmodule_Graph_linegraph(igraphmodule_GraphObject * self) {
 
 /**
  * \ingroup python_interface_graph
- * \brief Returns the k-neighborhood of some vertices in the
- *   graph.
- * \sa igraph_neighborhood
+ * \brief Returns the cached adjacency lists to be used for a neighborhood
+ *   query, or \c NULL if the C core should do the job (e.g., because the
+ *   arguments are invalid and the C core is the one to report it)
  */
-PyObject *igraphmodule_Graph_neighborhood(igraphmodule_GraphObject *self,
-    PyObject *args, PyObject *kwds) {
-  static char *kwlist[] = { "vertices", "order", "mode", "mindist", NULL };
-  PyObject *vobj = Py_None;
-  PyObject *mode_o = 0;
-  PyObject *result;
-  long int order = 1;
-  int mindist = 0;
-  igraph_neimode_t mode = IGRAPH_ALL;
-  igraph_bool_t return_single = 0;
-  igraph_vs_t vs;
-  igraph_vector_ptr_t res;
+static igraphmodule_adjacency_t* igraphmodule_i_Graph_adjacency_for_neighborhood(
+    igraphmodule_GraphObject *self, igraph_neimode_t mode, long int order,
+    long int mindist, igraph_bool_t single) {
+  if (order < 0 || mindist < 0 || mindist > order)
+    return 0;
+  /* the first-order neighborhood of a single vertex is not worth building
+   * the adjacency lists for right away */
+  return igraphmodule_get_adjacency(&self->g, mode, !single || order > 1);
+}
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OlOi", kwlist,
-        &vobj, &order, &mode_o, &mindist))
+/**
+ * \ingroup python_interface_graph
+ * \brief Calculates neighborhoods or their sizes from the cached adjacency
+ *   lists, without holding the GIL
+ * \sa igraphmodule_adjacency_neighborhood
+ */
+static int igraphmodule_i_Graph_cached_neighborhood(igraphmodule_GraphObject *self,
+    igraphmodule_adjacency_t *adj, igraph_vs_t vs, long int order,
+    long int mindist, igraph_vector_ptr_t *res, igraph_vector_t *sizes) {
+  igraph_vector_t vids;
+  int retval;
+
+  if (igraph_vector_init(&vids, 0))
+    return IGRAPH_ENOMEM;
+
+  retval = igraph_vs_as_vector(&self->g, vs, &vids);
+  if (!retval) {
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraphmodule_adjacency_neighborhood(adj, &vids, order, mindist,
+        res, sizes);
+    IGRAPHMODULE_END_NOGIL(self);
+    if (retval && !PyErr_Occurred())
+      PyErr_NoMemory();
+  }
+
+  igraph_vector_destroy(&vids);
+  return retval;
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Returns the k-neighborhood of some vertices in the
+ *   graph.
+ * \sa igraph_neighborhood
+ */
+PyObject *igraphmodule_Graph_neighborhood(igraphmodule_GraphObject *self,
+    PyObject *args, PyObject *kwds) {
+  static char *kwlist[] = { "vertices", "order", "mode", "mindist", NULL };
+  PyObject *vobj = Py_None;
+  PyObject *mode_o = 0;
+  PyObject *result;
+  long int order = 1;
+  int mindist = 0;
+  igraph_neimode_t mode = IGRAPH_ALL;
+  igraph_bool_t return_single = 0;
+  igraph_vs_t vs;
+  igraph_vector_ptr_t res;
+  igraphmodule_adjacency_t *adj;
+  int retval;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OlOi", kwlist,
+        &vobj, &order, &mode_o, &mindist))
     return NULL;
 
   if (igraphmodule_PyObject_to_neimode_t(mode_o, &mode))
@@ -4993,9 +6017,19 @@ PyObject *igraphmodule_Graph_neighborhood(igraphmodule_GraphObject *self,
     return igraphmodule_handle_igraph_error();
   }
 
-  if (igraph_neighborhood(&self->g, &res, vs, (igraph_integer_t) order, mode,
-		mindist)) {
+  adj = igraphmodule_i_Graph_adjacency_for_neighborhood(self, mode, order,
+      mindist, return_single);
+  if (adj) {
+    retval = igraphmodule_i_Graph_cached_neighborhood(self, adj, vs, order,
+        mindist, &res, 0);
+  } else {
+    retval = igraph_neighborhood(&self->g, &res, vs, (igraph_integer_t) order,
+        mode, mindist);
+  }
+
+  if (retval) {
     igraph_vs_destroy(&vs);
+    igraph_vector_ptr_destroy(&res);
     return igraphmodule_handle_igraph_error();
   }
 
@@ -5031,6 +6065,8 @@ PyObject *igraphmodule_Graph_neighborhood_size(igraphmodule_GraphObject *self,
   igraph_bool_t return_single = 0;
   igraph_vs_t vs;
   igraph_vector_t res;
+  igraphmodule_adjacency_t *adj;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OlOi", kwlist,
         &vobj, &order, &mode_o, &mindist))
@@ -5048,9 +6084,19 @@ PyObject *igraphmodule_Graph_neighborhood_size(igraphmodule_GraphObject *self,
     return igraphmodule_handle_igraph_error();
   }
 
-  if (igraph_neighborhood_size(&self->g, &res, vs, (igraph_integer_t) order, mode,
-		mindist)) {
+  adj = igraphmodule_i_Graph_adjacency_for_neighborhood(self, mode, order,
+      mindist, return_single);
+  if (adj) {
+    retval = igraphmodule_i_Graph_cached_neighborhood(self, adj, vs, order,
+        mindist, 0, &res);
+  } else {
+    retval = igraph_neighborhood_size(&self->g, &res, vs,
+        (igraph_integer_t) order, mode, mindist);
+  }
+
+  if (retval) {
     igraph_vs_destroy(&vs);
+    igraph_vector_destroy(&res);
     return igraphmodule_handle_igraph_error();
   }
 
@@ -5066,6 +6112,166 @@ PyObject *igraphmodule_Graph_neighborhood_size(igraphmodule_GraphObject *self,
   return result;
 }
 
+/** \ingroup python_interface_graph
+ * \brief Returns the neighbors (and optionally the incident edges) of many
+ *   vertices at once in the compressed sparse row format.
+ *
+ * The neighbors are gathered from the cached adjacency lists without
+ * holding the GIL, straight into typed columns.
+ *
+ * \return a tuple of two typed columns (offsets, ids), or three columns
+ *   (offsets, ids, eids) if the incident edges were requested
+ * \sa igraphmodule_adjacency_neighborhood_csr
+ */
+PyObject *igraphmodule_Graph_neighbors_batch(igraphmodule_GraphObject *self,
+    PyObject *args, PyObject *kwds) {
+  static char *kwlist[] = { "vertices", "mode", "order", "mindist", "edges", NULL };
+  PyObject *vobj = Py_None, *mode_o = Py_None, *edges_o = Py_False;
+  PyObject *offsets_o = 0, *ids_o = 0, *eids_o = 0;
+  long int order = 1, mindist = 1;
+  igraph_neimode_t mode = IGRAPH_ALL;
+  igraph_bool_t with_edges;
+  igraph_vs_t vs;
+  igraph_vector_t vids;
+  igraph_vector_long_t offsets, ids;
+  igraphmodule_adjacency_t *adj;
+  igraph_t *g = &self->g;
+  PY_LONG_LONG *out_offsets, *out_ids, *out_eids = 0;
+  long int i, j, k, n, end, total, v, e;
+  int retval = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOllO", kwlist, &vobj,
+        &mode_o, &order, &mindist, &edges_o))
+    return NULL;
+
+  if (igraphmodule_PyObject_to_neimode_t(mode_o, &mode))
+    return NULL;
+
+  with_edges = PyObject_IsTrue(edges_o);
+  if (order < 1 || mindist < 0 || mindist > order) {
+    PyErr_SetString(PyExc_ValueError, "order must be positive and mindist "
+        "must be between zero and order");
+    return NULL;
+  }
+  if (with_edges && (order != 1 || mindist != 1)) {
+    PyErr_SetString(PyExc_ValueError, "incident edges can only be returned "
+        "if order and mindist are both 1");
+    return NULL;
+  }
+
+  if (igraphmodule_PyObject_to_vs_t(vobj, &vs, g, 0, 0))
+    return NULL;
+
+  if (igraph_vector_init(&vids, 0)) {
+    igraph_vs_destroy(&vs);
+    return igraphmodule_handle_igraph_error();
+  }
+  retval = igraph_vs_as_vector(g, vs, &vids);
+  igraph_vs_destroy(&vs);
+  if (retval) {
+    igraph_vector_destroy(&vids);
+    return igraphmodule_handle_igraph_error();
+  }
+
+  adj = igraphmodule_acquire_adjacency(g, mode);
+  if (adj == 0) {
+    igraph_vector_destroy(&vids);
+    return NULL;
+  }
+
+  n = igraph_vector_size(&vids);
+
+  if (order == 1 && mindist == 1) {
+    /* Plain neighbor lists; their sizes are known in advance */
+    for (i = 0, total = 0; i < n; i++)
+      total += IGRAPHMODULE_ADJACENCY_DEGREE(adj, (long int) VECTOR(vids)[i]);
+
+    offsets_o = igraphmodule_Column_New(IGRAPHMODULE_COLUMN_INT, n + 1);
+    ids_o = offsets_o ? igraphmodule_Column_New(IGRAPHMODULE_COLUMN_INT, total) : 0;
+    eids_o = (ids_o && with_edges) ?
+      igraphmodule_Column_New(IGRAPHMODULE_COLUMN_INT, total) : 0;
+
+    if (ids_o && (eids_o || !with_edges)) {
+      out_offsets = (PY_LONG_LONG*) ((igraphmodule_ColumnObject*) offsets_o)->data;
+      out_ids = (PY_LONG_LONG*) ((igraphmodule_ColumnObject*) ids_o)->data;
+      if (with_edges)
+        out_eids = (PY_LONG_LONG*) ((igraphmodule_ColumnObject*) eids_o)->data;
+
+      IGRAPHMODULE_BEGIN_NOGIL(self);
+      for (i = 0, k = 0; i < n; i++) {
+        v = (long int) VECTOR(vids)[i];
+        out_offsets[i] = k;
+        end = adj->offsets[v + 1];
+        if (with_edges) {
+          /* The neighbors are listed in the order of the incident edges so
+           * that the two columns match item by item */
+          for (j = adj->offsets[v]; j < end; j++, k++) {
+            e = adj->edges[j];
+            out_eids[k] = e;
+            out_ids[k] = (IGRAPH_FROM(g, e) == v) ? IGRAPH_TO(g, e) : IGRAPH_FROM(g, e);
+          }
+        } else {
+          for (j = adj->offsets[v]; j < end; j++, k++)
+            out_ids[k] = adj->neighbors[j];
+        }
+      }
+      out_offsets[n] = k;
+      IGRAPHMODULE_END_NOGIL(self);
+    } else {
+      retval = 1;
+    }
+  } else if (igraph_vector_long_init(&offsets, 0)) {
+    igraphmodule_handle_igraph_error();
+    retval = 1;
+  } else if (igraph_vector_long_init(&ids, 0)) {
+    igraph_vector_long_destroy(&offsets);
+    igraphmodule_handle_igraph_error();
+    retval = 1;
+  } else {
+    /* Higher-order neighborhoods */
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraphmodule_adjacency_neighborhood_csr(adj, &vids, order, mindist,
+        &offsets, &ids);
+    IGRAPHMODULE_END_NOGIL(self);
+
+    if (retval) {
+      PyErr_NoMemory();
+    } else {
+      total = igraph_vector_long_size(&ids);
+      offsets_o = igraphmodule_Column_New(IGRAPHMODULE_COLUMN_INT, n + 1);
+      ids_o = offsets_o ? igraphmodule_Column_New(IGRAPHMODULE_COLUMN_INT, total) : 0;
+      if (ids_o) {
+        out_offsets = (PY_LONG_LONG*) ((igraphmodule_ColumnObject*) offsets_o)->data;
+        out_ids = (PY_LONG_LONG*) ((igraphmodule_ColumnObject*) ids_o)->data;
+        for (i = 0; i <= n; i++)
+          out_offsets[i] = VECTOR(offsets)[i];
+        for (k = 0; k < total; k++)
+          out_ids[k] = VECTOR(ids)[k];
+      } else {
+        retval = 1;
+      }
+    }
+
+    igraph_vector_long_destroy(&offsets);
+    igraph_vector_long_destroy(&ids);
+  }
+
+  igraphmodule_adjacency_decref(adj);
+  igraph_vector_destroy(&vids);
+
+  if (retval) {
+    Py_XDECREF(offsets_o);
+    Py_XDECREF(ids_o);
+    Py_XDECREF(eids_o);
+    return NULL;
+  }
+
+  if (with_edges)
+    return Py_BuildValue("NNN", offsets_o, ids_o, eids_o);
+
+  return Py_BuildValue("NN", offsets_o, ids_o);
+}
+
 /** \ingroup python_interface_graph
  * \brief Calculates the Google personalized PageRank value of some vertices in the graph.
  * \return the personalized PageRank values
@@ -5076,7 +6282,8 @@ PyObject *igraphmodule_Graph_personalized_pagerank(igraphmodule_GraphObject *sel
 {
   static char *kwlist[] =
     { "vertices", "directed", "damping", "reset", "reset_vertices", "weights",
-      "arpack_options", "implementation", "niter", "eps", NULL };
+      "arpack_options", "implementation", "niter", "eps", "return_type",
+      NULL };
   PyObject *directed = Py_True;
   PyObject *vobj = Py_None, *wobj = Py_None, *robj = Py_None, *rvsobj = Py_None;
   PyObject *list;
@@ -5090,19 +6297,27 @@ PyObject *igraphmodule_Graph_personalized_pagerank(igraphmodule_GraphObject *sel
   igraph_vs_t vs, reset_vs;
   igraph_pagerank_algo_t algo=IGRAPH_PAGERANK_ALGO_PRPACK;
   PyObject *algo_o = Py_None;
+  PyObject *return_type_o = Py_None;
+  igraphmodule_return_type_t return_type = IGRAPHMODULE_RETURN_LIST;
   long niter=1000;
   float eps=0.001f;
   igraph_pagerank_power_options_t popts;
+  igraph_arpack_options_t arpack_opts;
+  igraph_bool_t is_directed;
   void *opts;
   int retval;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOdOOOO!Olf", kwlist, &vobj,
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOdOOOO!OlfO", kwlist, &vobj,
                                    &directed, &damping, &robj,
 				   &rvsobj, &wobj,
                                    &igraphmodule_ARPACKOptionsType,
-                                   &arpack_options_o, &algo_o, &niter, &eps))
+                                   &arpack_options_o, &algo_o, &niter, &eps,
+                                   &return_type_o))
+
 
+    return NULL;
 
+  if (igraphmodule_PyObject_to_return_type_t(return_type_o, &return_type))
     return NULL;
 
   if (robj != Py_None && rvsobj != Py_None) {
@@ -5155,17 +6370,28 @@ PyObject *igraphmodule_Graph_personalized_pagerank(igraphmodule_GraphObject *sel
   if (algo == IGRAPH_PAGERANK_ALGO_POWER) {
     opts = &popts;
   } else if (algo == IGRAPH_PAGERANK_ALGO_ARPACK) {
-    opts = igraphmodule_ARPACKOptions_get(arpack_options);
+    /* work on a private copy; the options object may be shared with
+     * other threads while the GIL is released */
+    arpack_opts = *igraphmodule_ARPACKOptions_get(arpack_options);
+    opts = &arpack_opts;
   } else {
     opts = 0;
   }
 
+  is_directed = PyObject_IsTrue(directed);
+
+  IGRAPHMODULE_BEGIN_NOGIL(self);
   if (rvsobj != Py_None)
     retval = igraph_personalized_pagerank_vs(&self->g, algo, &res, 0, vs,
-	     PyObject_IsTrue(directed), damping, reset_vs, &weights, opts);
+	     is_directed, damping, reset_vs, &weights, opts);
   else
     retval = igraph_personalized_pagerank(&self->g, algo, &res, 0, vs,
-	     PyObject_IsTrue(directed), damping, reset, &weights, opts);
+	     is_directed, damping, reset, &weights, opts);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (opts == &arpack_opts) {
+    arpack_options->params_out = arpack_opts;
+  }
 
   if (retval) {
     igraphmodule_handle_igraph_error();
@@ -5178,7 +6404,8 @@ PyObject *igraphmodule_Graph_personalized_pagerank(igraphmodule_GraphObject *sel
   }
 
   if (!return_single)
-    list = igraphmodule_vector_t_to_PyList(&res, IGRAPHMODULE_TYPE_FLOAT);
+    list = igraphmodule_vector_t_to_PyObject(&res, IGRAPHMODULE_TYPE_FLOAT,
+        return_type);
   else
     list = PyFloat_FromDouble(VECTOR(res)[0]);
 
@@ -5191,6 +6418,272 @@ PyObject *igraphmodule_Graph_personalized_pagerank(igraphmodule_GraphObject *sel
   return list;
 }
 
+/**
+ * \ingroup python_interface_graph
+ * \brief Converts the seed sets of the batched personalized PageRank to the
+ *        compressed sparse row format
+ *
+ * Every item of the iterable is interpreted as a vertex selector, so it may
+ * be a single vertex or a sequence of vertices.
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+static int igraphmodule_i_PyObject_to_seed_sets(PyObject *o,
+    igraphmodule_GraphObject *self, igraph_vector_long_t *offsets,
+    igraph_vector_long_t *seeds) {
+  PyObject *it, *item;
+  igraph_vs_t vs;
+  igraph_vector_t vids;
+  long int i, n;
+
+  it = PyObject_GetIter(o);
+  if (it == 0)
+    return 1;
+
+  if (igraph_vector_init(&vids, 0)) {
+    Py_DECREF(it);
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+
+  if (igraph_vector_long_push_back(offsets, 0)) {
+    igraph_vector_destroy(&vids);
+    Py_DECREF(it);
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+
+  while ((item = PyIter_Next(it)) != 0) {
+    if (igraphmodule_PyObject_to_vs_t(item, &vs, &self->g, 0, 0)) {
+      Py_DECREF(item);
+      igraphmodule_handle_igraph_error();
+      break;
+    }
+    Py_DECREF(item);
+    if (igraph_vs_as_vector(&self->g, vs, &vids)) {
+      igraph_vs_destroy(&vs);
+      igraphmodule_handle_igraph_error();
+      break;
+    }
+    igraph_vs_destroy(&vs);
+
+    n = igraph_vector_size(&vids);
+    if (n == 0) {
+      PyErr_SetString(PyExc_ValueError, "seed sets must not be empty");
+      break;
+    }
+    for (i = 0; i < n; i++) {
+      if (VECTOR(vids)[i] >= igraph_vcount(&self->g)) {
+        PyErr_SetString(PyExc_ValueError, "vertex index out of range");
+        break;
+      }
+      if (igraph_vector_long_push_back(seeds, (long int) VECTOR(vids)[i])) {
+        igraphmodule_handle_igraph_error();
+        break;
+      }
+    }
+    if (i < n)
+      break;
+    if (igraph_vector_long_push_back(offsets, igraph_vector_long_size(seeds))) {
+      igraphmodule_handle_igraph_error();
+      break;
+    }
+  }
+
+  igraph_vector_destroy(&vids);
+  Py_DECREF(it);
+
+  return PyErr_Occurred() ? 1 : 0;
+}
+
+/** \ingroup python_interface_graph
+ * \brief Calculates personalized PageRank values for many seed sets at once
+ *
+ * The transition structure is set up once and the seed sets are solved by
+ * several threads without holding the GIL.
+ *
+ * \return a list of lists or a buffer of the scores (one row per seed
+ *   set), or the top scoring vertices of each seed set
+ * \sa igraphmodule_personalized_pagerank_batch
+ */
+PyObject *igraphmodule_Graph_personalized_pagerank_batch(
+    igraphmodule_GraphObject *self, PyObject *args, PyObject *kwds) {
+  static char *kwlist[] =
+    { "seeds", "directed", "damping", "weights", "threads", "top_k", "niter",
+      "eps", "return_type", NULL };
+  PyObject *seeds_o, *directed_o = Py_True, *weights_o = Py_None;
+  PyObject *threads_o = Py_None, *top_k_o = Py_None, *return_type_o = Py_None;
+  PyObject *result = 0, *ids_o = 0, *scores_o = 0, *row, *pair;
+  igraphmodule_return_type_t return_type = IGRAPHMODULE_RETURN_LIST;
+  igraphmodule_pagerank_output_t output;
+  igraphmodule_adjacency_t *adj;
+  igraph_vector_long_t offsets, seeds;
+  igraph_vector_t *weights = 0;
+  igraph_matrix_t m;
+  igraph_bool_t directed;
+  double damping = 0.85, eps = 1e-10;
+  long int niter = 1000, threads = 1, top_k = 0, no_of_sets, n, s, i;
+  int retval;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OdOOOldO", kwlist, &seeds_o,
+                                   &directed_o, &damping, &weights_o,
+                                   &threads_o, &top_k_o, &niter, &eps,
+                                   &return_type_o))
+    return NULL;
+
+  if (igraphmodule_PyObject_to_return_type_t(return_type_o, &return_type))
+    return NULL;
+
+  if (!(damping >= 0 && damping <= 1)) {
+    PyErr_SetString(PyExc_ValueError, "damping factor must be between 0 and 1");
+    return NULL;
+  }
+  if (niter < 0 || !(eps >= 0)) {
+    PyErr_SetString(PyExc_ValueError, "niter and eps must be non-negative");
+    return NULL;
+  }
+
+  if (threads_o != Py_None) {
+    threads = PyInt_AsLong(threads_o);
+    if (PyErr_Occurred())
+      return NULL;
+    if (threads <= 0) {
+      PyErr_SetString(PyExc_ValueError, "threads must be positive");
+      return NULL;
+    }
+  }
+
+  if (top_k_o != Py_None) {
+    top_k = PyInt_AsLong(top_k_o);
+    if (PyErr_Occurred())
+      return NULL;
+    if (top_k <= 0) {
+      PyErr_SetString(PyExc_ValueError, "top_k must be positive");
+      return NULL;
+    }
+  }
+
+  if (igraph_vector_long_init(&offsets, 0))
+    return igraphmodule_handle_igraph_error();
+  if (igraph_vector_long_init(&seeds, 0)) {
+    igraph_vector_long_destroy(&offsets);
+    return igraphmodule_handle_igraph_error();
+  }
+  if (igraphmodule_i_PyObject_to_seed_sets(seeds_o, self, &offsets, &seeds)) {
+    igraph_vector_long_destroy(&offsets);
+    igraph_vector_long_destroy(&seeds);
+    return NULL;
+  }
+
+  if (igraphmodule_attrib_to_vector_t(weights_o, self, &weights, ATTRIBUTE_TYPE_EDGE)) {
+    igraph_vector_long_destroy(&offsets);
+    igraph_vector_long_destroy(&seeds);
+    return NULL;
+  }
+  if (weights && igraph_vector_size(weights) > 0 && !(igraph_vector_min(weights) >= 0)) {
+    PyErr_SetString(PyExc_ValueError, "weights must be non-negative");
+    igraph_vector_destroy(weights); free(weights);
+    igraph_vector_long_destroy(&offsets);
+    igraph_vector_long_destroy(&seeds);
+    return NULL;
+  }
+
+#define DESTROY_INPUTS { \
+  if (weights) { igraph_vector_destroy(weights); free(weights); } \
+  igraph_vector_long_destroy(&offsets); \
+  igraph_vector_long_destroy(&seeds); \
+}
+
+  no_of_sets = igraph_vector_long_size(&offsets) - 1;
+  n = igraph_vcount(&self->g);
+  if (top_k > n)
+    top_k = n;
+
+  output.top_k = top_k;
+  if (top_k_o == Py_None) {
+    if (igraph_matrix_init(&m, no_of_sets, n)) {
+      DESTROY_INPUTS;
+      return igraphmodule_handle_igraph_error();
+    }
+    output.scores = &MATRIX(m, 0, 0);
+    output.ids = 0;
+    output.seed_stride = 1;
+    output.vertex_stride = no_of_sets;
+  } else {
+    ids_o = igraphmodule_Column_New(IGRAPHMODULE_COLUMN_INT, no_of_sets * top_k);
+    scores_o = ids_o ?
+      igraphmodule_Column_New(IGRAPHMODULE_COLUMN_FLOAT, no_of_sets * top_k) : 0;
+    if (scores_o == 0) {
+      Py_XDECREF(ids_o);
+      DESTROY_INPUTS;
+      return NULL;
+    }
+    output.ids = (PY_LONG_LONG*) ((igraphmodule_ColumnObject*) ids_o)->data;
+    output.scores = (igraph_real_t*) ((igraphmodule_ColumnObject*) scores_o)->data;
+    output.seed_stride = output.vertex_stride = 0;
+  }
+
+  directed = PyObject_IsTrue(directed_o) && igraph_is_directed(&self->g);
+  adj = igraphmodule_acquire_adjacency(&self->g, directed ? IGRAPH_IN : IGRAPH_ALL);
+  if (adj == 0) {
+    if (top_k_o == Py_None)
+      igraph_matrix_destroy(&m);
+    Py_XDECREF(ids_o);
+    Py_XDECREF(scores_o);
+    DESTROY_INPUTS;
+    return NULL;
+  }
+
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraphmodule_personalized_pagerank_batch(&self->g, adj, weights,
+      damping, eps, niter, &offsets, &seeds, threads, &output);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  igraphmodule_adjacency_decref(adj);
+  DESTROY_INPUTS;
+
+#undef DESTROY_INPUTS
+
+  if (top_k_o == Py_None) {
+    if (!retval)
+      result = igraphmodule_matrix_t_to_PyObject(&m, IGRAPHMODULE_TYPE_FLOAT,
+          return_type);
+    igraph_matrix_destroy(&m);
+  } else if (!retval && return_type == IGRAPHMODULE_RETURN_BUFFER) {
+    return Py_BuildValue("NN", ids_o, scores_o);
+  } else if (!retval) {
+    /* A list of (vertex, score) pairs for each seed set */
+    result = PyList_New(no_of_sets);
+    for (s = 0; result && s < no_of_sets; s++) {
+      row = PyList_New(top_k);
+      for (i = 0; row && i < top_k; i++) {
+        pair = Py_BuildValue("nd", (Py_ssize_t) output.ids[s * top_k + i],
+            (double) output.scores[s * top_k + i]);
+        if (pair == 0) {
+          Py_DECREF(row);
+          row = 0;
+          break;
+        }
+        PyList_SET_ITEM(row, i, pair);
+      }
+      if (row == 0) {
+        Py_DECREF(result);
+        result = 0;
+        break;
+      }
+      PyList_SET_ITEM(result, s, row);
+    }
+  }
+  Py_XDECREF(ids_o);
+  Py_XDECREF(scores_o);
+
+  if (retval)
+    return PyErr_NoMemory();
+
+  return result;
+}
+
 /** \ingroup python_interface_graph
  * \brief Calculates the path length histogram of the graph
  * \sa igraph_path_length_hist
@@ -5266,6 +6759,9 @@ PyObject *igraphmodule_Graph_rewire(igraphmodule_GraphObject * self,
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|lO", kwlist, &n, &mode_o))
     return NULL;
 
+  if (!igraphmodule_Graph_check_not_busy(self))
+    return NULL;
+
   if (igraphmodule_PyObject_to_rewiring_t(mode_o, &mode))
     return NULL;
 
@@ -5293,6 +6789,9 @@ PyObject *igraphmodule_Graph_rewire_edges(igraphmodule_GraphObject * self,
         &prob, &loops_o, &multiple_o))
     return NULL;
 
+  if (!igraphmodule_Graph_check_not_busy(self))
+    return NULL;
+
   if (igraph_rewire_edges(&self->g, prob, PyObject_IsTrue(loops_o),
         PyObject_IsTrue(multiple_o))) {
     igraphmodule_handle_igraph_error();
@@ -5302,6 +6801,39 @@ PyObject *igraphmodule_Graph_rewire_edges(igraphmodule_GraphObject * self,
   Py_RETURN_NONE;
 }
 
+/** \ingroup python_interface_graph
+ * \brief Converts the source, target, weights and mode arguments of the
+ *        shortest path methods.
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised and everything allocated so far is freed in the latter case.
+ */
+static int igraphmodule_i_Graph_shortest_paths_args(
+    igraphmodule_GraphObject *self, PyObject *from_o, PyObject *to_o,
+    PyObject *weights_o, PyObject *mode_o, igraph_vs_t *from_vs,
+    igraph_vs_t *to_vs, igraph_vector_t **weights, igraph_neimode_t *mode) {
+  int return_single_from = 0, return_single_to = 0;
+
+  if (igraphmodule_PyObject_to_neimode_t(mode_o, mode)) return 1;
+  if (igraphmodule_PyObject_to_vs_t(from_o, from_vs, &self->g, &return_single_from, 0)) {
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+  if (igraphmodule_PyObject_to_vs_t(to_o, to_vs, &self->g, &return_single_to, 0)) {
+    igraph_vs_destroy(from_vs);
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+  if (igraphmodule_attrib_to_vector_t(weights_o, self, weights,
+      ATTRIBUTE_TYPE_EDGE)) {
+    igraph_vs_destroy(from_vs);
+    igraph_vs_destroy(to_vs);
+    return 1;
+  }
+
+  return 0;
+}
+
 /** \ingroup python_interface_graph
  * \brief Calculates shortest paths in a graph.
  * \return the shortest path lengths for the given vertices
@@ -5311,35 +6843,27 @@ PyObject *igraphmodule_Graph_rewire_edges(igraphmodule_GraphObject * self,
 PyObject *igraphmodule_Graph_shortest_paths(igraphmodule_GraphObject * self,
                                             PyObject * args, PyObject * kwds)
 {
-  static char *kwlist[] = { "source", "target", "weights", "mode", NULL };
+  static char *kwlist[] = { "source", "target", "weights", "mode",
+    "return_type", NULL };
   PyObject *from_o = NULL, *to_o = NULL, *mode_o = NULL, *weights_o = Py_None;
+  PyObject *return_type_o = Py_None;
   PyObject *list = NULL;
   igraph_matrix_t res;
   igraph_vector_t *weights=0;
   igraph_neimode_t mode = IGRAPH_OUT;
-  int return_single_from = 0, return_single_to = 0, e = 0;
+  igraphmodule_return_type_t return_type = IGRAPHMODULE_RETURN_LIST;
+  int e = 0;
   igraph_vs_t from_vs, to_vs;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOO", kwlist,
-        &from_o, &to_o, &weights_o, &mode_o))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOO", kwlist,
+        &from_o, &to_o, &weights_o, &mode_o, &return_type_o))
     return NULL;
 
-  if (igraphmodule_PyObject_to_neimode_t(mode_o, &mode)) return 0;
-  if (igraphmodule_PyObject_to_vs_t(from_o, &from_vs, &self->g, &return_single_from, 0)) {
-    igraphmodule_handle_igraph_error();
+  if (igraphmodule_PyObject_to_return_type_t(return_type_o, &return_type))
     return NULL;
-  }
-  if (igraphmodule_PyObject_to_vs_t(to_o, &to_vs, &self->g, &return_single_to, 0)) {
-    igraph_vs_destroy(&from_vs);
-    igraphmodule_handle_igraph_error();
+  if (igraphmodule_i_Graph_shortest_paths_args(self, from_o, to_o, weights_o,
+        mode_o, &from_vs, &to_vs, &weights, &mode))
     return NULL;
-  }
-  if (igraphmodule_attrib_to_vector_t(weights_o, self, &weights,
-      ATTRIBUTE_TYPE_EDGE)) {
-    igraph_vs_destroy(&from_vs);
-    igraph_vs_destroy(&to_vs);
-    return NULL;
-  }
 
   if (igraph_matrix_init(&res, 1, igraph_vcount(&self->g))) {
     if (weights) { igraph_vector_destroy(weights); free(weights); }
@@ -5349,6 +6873,7 @@ PyObject *igraphmodule_Graph_shortest_paths(igraphmodule_GraphObject * self,
   }
 
   /* Select the most suitable algorithm */
+  IGRAPHMODULE_BEGIN_NOGIL(self);
   if (weights) {
     if (igraph_vector_min(weights) > 0) {
       /* Only positive weights, use Dijkstra's algorithm */
@@ -5370,6 +6895,7 @@ PyObject *igraphmodule_Graph_shortest_paths(igraphmodule_GraphObject * self,
     /* No weights, use a simple BFS */
     e = igraph_shortest_paths(&self->g, &res, from_vs, to_vs, mode);
   }
+  IGRAPHMODULE_END_NOGIL(self);
 
   if (e) {
     if (weights) igraph_vector_destroy(weights);
@@ -5382,9 +6908,11 @@ PyObject *igraphmodule_Graph_shortest_paths(igraphmodule_GraphObject * self,
 
   if (weights) {
     igraph_vector_destroy(weights);
-    list = igraphmodule_matrix_t_to_PyList(&res, IGRAPHMODULE_TYPE_FLOAT);
+    list = igraphmodule_matrix_t_to_PyObject(&res, IGRAPHMODULE_TYPE_FLOAT,
+        return_type);
   } else {
-    list = igraphmodule_matrix_t_to_PyList(&res, IGRAPHMODULE_TYPE_INT);
+    list = igraphmodule_matrix_t_to_PyObject(&res, IGRAPHMODULE_TYPE_INT,
+        return_type);
   }
 
   if (weights) { igraph_vector_destroy(weights); free(weights); }
@@ -5396,6 +6924,186 @@ PyObject *igraphmodule_Graph_shortest_paths(igraphmodule_GraphObject * self,
   return list;
 }
 
+/** \ingroup python_interface_graph
+ * \brief Calculates shortest path lengths from many sources in blocks,
+ *        using several threads.
+ * \return a \c ShortestPathsIter object
+ */
+PyObject *igraphmodule_Graph_shortest_paths_iter(igraphmodule_GraphObject * self,
+                                                 PyObject * args, PyObject * kwds)
+{
+  static char *kwlist[] = { "source", "target", "weights", "mode",
+    "chunk", "threads", "reduce", NULL };
+  PyObject *from_o = NULL, *to_o = NULL, *mode_o = NULL, *weights_o = Py_None;
+  PyObject *reduce_o = Py_None, *result;
+  igraph_vector_t *weights = 0;
+  igraph_neimode_t mode = IGRAPH_OUT;
+  igraph_vs_t from_vs, to_vs;
+  long int chunk = 1024, threads = 1;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOllO", kwlist,
+        &from_o, &to_o, &weights_o, &mode_o, &chunk, &threads, &reduce_o))
+    return NULL;
+
+  if (igraphmodule_i_Graph_shortest_paths_args(self, from_o, to_o, weights_o,
+        mode_o, &from_vs, &to_vs, &weights, &mode))
+    return NULL;
+
+  result = igraphmodule_ShortestPathsIter_new(self, from_vs, to_vs, weights,
+      mode, chunk, threads, reduce_o);
+
+  if (weights) { igraph_vector_destroy(weights); free(weights); }
+  igraph_vs_destroy(&from_vs);
+  igraph_vs_destroy(&to_vs);
+
+  return result;
+}
+
+/** \ingroup python_interface_graph
+ * \brief Lists the most similar vertices of some vertices in the compressed
+ *   sparse row format; the common part of the sparse modes of
+ *   \c similarity_jaccard(), \c similarity_dice() and
+ *   \c similarity_inverse_log_weighted().
+ *
+ * \return a tuple of three typed columns (offsets, ids, scores)
+ * \sa igraphmodule_similarity_sparse
+ */
+static PyObject *igraphmodule_i_Graph_similarity_sparse(
+    igraphmodule_GraphObject *self, PyObject *vertices_o, igraph_neimode_t mode,
+    igraph_bool_t loops, igraphmodule_similarity_t type, PyObject *top_k_o,
+    PyObject *threshold_o, PyObject *threads_o) {
+  PyObject *offsets_o = 0, *ids_o = 0, *scores_o = 0;
+  igraphmodule_adjacency_t *adj, *rev;
+  igraph_vector_long_t offsets, ids;
+  igraph_vector_t vids, scores;
+  igraph_neimode_t rev_mode;
+  igraph_vs_t vs;
+  igraph_real_t threshold = 0;
+  long int top_k = 0, threads = 1, i, n, total;
+  PY_LONG_LONG *out_offsets, *out_ids;
+  double *out_scores;
+  int retval;
+
+  if (top_k_o != Py_None) {
+    top_k = PyInt_AsLong(top_k_o);
+    if (PyErr_Occurred())
+      return NULL;
+    if (top_k <= 0) {
+      PyErr_SetString(PyExc_ValueError, "top_k must be positive");
+      return NULL;
+    }
+  }
+
+  if (threshold_o != Py_None) {
+    threshold = PyFloat_AsDouble(threshold_o);
+    if (PyErr_Occurred())
+      return NULL;
+  }
+
+  if (threads_o != Py_None) {
+    threads = PyInt_AsLong(threads_o);
+    if (PyErr_Occurred())
+      return NULL;
+    if (threads <= 0) {
+      PyErr_SetString(PyExc_ValueError, "threads must be positive");
+      return NULL;
+    }
+  }
+
+  if (igraphmodule_PyObject_to_vs_t(vertices_o, &vs, &self->g, 0, 0))
+    return NULL;
+  if (igraph_vector_init(&vids, 0)) {
+    igraph_vs_destroy(&vs);
+    return igraphmodule_handle_igraph_error();
+  }
+  retval = igraph_vs_as_vector(&self->g, vs, &vids);
+  igraph_vs_destroy(&vs);
+  if (retval) {
+    igraph_vector_destroy(&vids);
+    return igraphmodule_handle_igraph_error();
+  }
+  n = igraph_vector_size(&vids);
+  for (i = 0; i < n; i++) {
+    if (VECTOR(vids)[i] >= igraph_vcount(&self->g)) {
+      PyErr_SetString(PyExc_ValueError, "vertex index out of range");
+      igraph_vector_destroy(&vids);
+      return NULL;
+    }
+  }
+
+  /* The candidates are the vertices that have a neighbor of the source as
+   * their neighbor, so the lists of the opposite direction are needed too */
+  if (!igraph_is_directed(&self->g))
+    mode = IGRAPH_ALL;
+  rev_mode = mode == IGRAPH_OUT ? IGRAPH_IN : (mode == IGRAPH_IN ? IGRAPH_OUT : IGRAPH_ALL);
+  adj = igraphmodule_acquire_adjacency(&self->g, mode);
+  rev = adj ? igraphmodule_acquire_adjacency(&self->g, rev_mode) : 0;
+  if (rev == 0) {
+    if (adj)
+      igraphmodule_adjacency_decref(adj);
+    igraph_vector_destroy(&vids);
+    return NULL;
+  }
+
+  if (igraph_vector_long_init(&offsets, 0)) {
+    igraphmodule_handle_igraph_error();
+    retval = 1;
+  } else if (igraph_vector_long_init(&ids, 0)) {
+    igraph_vector_long_destroy(&offsets);
+    igraphmodule_handle_igraph_error();
+    retval = 1;
+  } else if (igraph_vector_init(&scores, 0)) {
+    igraph_vector_long_destroy(&offsets);
+    igraph_vector_long_destroy(&ids);
+    igraphmodule_handle_igraph_error();
+    retval = 1;
+  } else {
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraphmodule_similarity_sparse(adj, rev, type, loops, &vids,
+        top_k, threshold, threads, &offsets, &ids, &scores);
+    IGRAPHMODULE_END_NOGIL(self);
+
+    if (retval) {
+      PyErr_NoMemory();
+    } else {
+      total = igraph_vector_long_size(&ids);
+      offsets_o = igraphmodule_Column_New(IGRAPHMODULE_COLUMN_INT, n + 1);
+      ids_o = offsets_o ? igraphmodule_Column_New(IGRAPHMODULE_COLUMN_INT, total) : 0;
+      scores_o = ids_o ? igraphmodule_Column_New(IGRAPHMODULE_COLUMN_FLOAT, total) : 0;
+      if (scores_o) {
+        out_offsets = (PY_LONG_LONG*) ((igraphmodule_ColumnObject*) offsets_o)->data;
+        out_ids = (PY_LONG_LONG*) ((igraphmodule_ColumnObject*) ids_o)->data;
+        out_scores = (double*) ((igraphmodule_ColumnObject*) scores_o)->data;
+        for (i = 0; i <= n; i++)
+          out_offsets[i] = VECTOR(offsets)[i];
+        for (i = 0; i < total; i++) {
+          out_ids[i] = VECTOR(ids)[i];
+          out_scores[i] = VECTOR(scores)[i];
+        }
+      } else {
+        retval = 1;
+      }
+    }
+
+    igraph_vector_long_destroy(&offsets);
+    igraph_vector_long_destroy(&ids);
+    igraph_vector_destroy(&scores);
+  }
+
+  igraphmodule_adjacency_decref(adj);
+  igraphmodule_adjacency_decref(rev);
+  igraph_vector_destroy(&vids);
+
+  if (retval) {
+    Py_XDECREF(offsets_o);
+    Py_XDECREF(ids_o);
+    Py_XDECREF(scores_o);
+    return NULL;
+  }
+
+  return Py_BuildValue("NNN", offsets_o, ids_o, scores_o);
+}
+
 /** \ingroup python_interface_graph
  * \brief Calculates the Jaccard similarities of some vertices in a graph.
  * \return the similarity scores in a matrix
@@ -5403,13 +7111,15 @@ PyObject *igraphmodule_Graph_shortest_paths(igraphmodule_GraphObject * self,
  */
 PyObject *igraphmodule_Graph_similarity_jaccard(igraphmodule_GraphObject * self,
   PyObject * args, PyObject * kwds) {
-  static char *kwlist[] = { "vertices", "pairs", "mode", "loops", NULL };
+  static char *kwlist[] = { "vertices", "pairs", "mode", "loops", "top_k",
+    "threshold", "threads", NULL };
   PyObject *vertices_o = Py_None, *pairs_o = Py_None;
   PyObject *list = NULL, *loops = Py_True, *mode_o = Py_None;
+  PyObject *top_k_o = Py_None, *threshold_o = Py_None, *threads_o = Py_None;
   igraph_neimode_t mode = IGRAPH_ALL;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOO", kwlist, &vertices_o,
-        &pairs_o, &mode_o, &loops))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOOOO", kwlist, &vertices_o,
+        &pairs_o, &mode_o, &loops, &top_k_o, &threshold_o, &threads_o))
     return NULL;
 
   if (igraphmodule_PyObject_to_neimode_t(mode_o, &mode))
@@ -5421,6 +7131,17 @@ PyObject *igraphmodule_Graph_similarity_jaccard(igraphmodule_GraphObject * self,
     return NULL;
   }
 
+  if (top_k_o != Py_None || threshold_o != Py_None) {
+    if (pairs_o != Py_None) {
+      PyErr_SetString(PyExc_ValueError, "`top_k` and `threshold` cannot be "
+          "used with `pairs`");
+      return NULL;
+    }
+    return igraphmodule_i_Graph_similarity_sparse(self, vertices_o, mode,
+        PyObject_IsTrue(loops), IGRAPHMODULE_SIMILARITY_JACCARD, top_k_o,
+        threshold_o, threads_o);
+  }
+
   if (pairs_o == Py_None) {
     /* Case #1: vertices, returning matrix */
     igraph_matrix_t res;
@@ -5489,13 +7210,15 @@ PyObject *igraphmodule_Graph_similarity_jaccard(igraphmodule_GraphObject * self,
  */
 PyObject *igraphmodule_Graph_similarity_dice(igraphmodule_GraphObject * self,
   PyObject * args, PyObject * kwds) {
-  static char *kwlist[] = { "vertices", "pairs", "mode", "loops", NULL };
+  static char *kwlist[] = { "vertices", "pairs", "mode", "loops", "top_k",
+    "threshold", "threads", NULL };
   PyObject *vertices_o = Py_None, *pairs_o = Py_None;
   PyObject *list = NULL, *loops = Py_True, *mode_o = Py_None;
+  PyObject *top_k_o = Py_None, *threshold_o = Py_None, *threads_o = Py_None;
   igraph_neimode_t mode = IGRAPH_ALL;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOO", kwlist, &vertices_o,
-        &pairs_o, &mode_o, &loops))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOOOO", kwlist, &vertices_o,
+        &pairs_o, &mode_o, &loops, &top_k_o, &threshold_o, &threads_o))
     return NULL;
 
   if (igraphmodule_PyObject_to_neimode_t(mode_o, &mode))
@@ -5507,6 +7230,17 @@ PyObject *igraphmodule_Graph_similarity_dice(igraphmodule_GraphObject * self,
     return NULL;
   }
 
+  if (top_k_o != Py_None || threshold_o != Py_None) {
+    if (pairs_o != Py_None) {
+      PyErr_SetString(PyExc_ValueError, "`top_k` and `threshold` cannot be "
+          "used with `pairs`");
+      return NULL;
+    }
+    return igraphmodule_i_Graph_similarity_sparse(self, vertices_o, mode,
+        PyObject_IsTrue(loops), IGRAPHMODULE_SIMILARITY_DICE, top_k_o,
+        threshold_o, threads_o);
+  }
+
   if (pairs_o == Py_None) {
     /* Case #1: vertices, returning matrix */
     igraph_matrix_t res;
@@ -5578,17 +7312,27 @@ PyObject *igraphmodule_Graph_similarity_dice(igraphmodule_GraphObject * self,
  */
 PyObject *igraphmodule_Graph_similarity_inverse_log_weighted(
   igraphmodule_GraphObject * self, PyObject * args, PyObject * kwds) {
-  static char *kwlist[] = { "vertices", "mode", NULL };
+  static char *kwlist[] = { "vertices", "mode", "top_k", "threshold",
+    "threads", NULL };
   PyObject *vobj = NULL, *list = NULL, *mode_o = Py_None;
+  PyObject *top_k_o = Py_None, *threshold_o = Py_None, *threads_o = Py_None;
   igraph_matrix_t res;
   igraph_neimode_t mode = IGRAPH_ALL;
   int return_single = 0;
   igraph_vs_t vs;
+  int retval;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", kwlist, &vobj, &mode_o))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOOOO", kwlist, &vobj,
+        &mode_o, &top_k_o, &threshold_o, &threads_o))
     return NULL;
 
   if (igraphmodule_PyObject_to_neimode_t(mode_o, &mode)) return NULL;
+
+  if (top_k_o != Py_None || threshold_o != Py_None)
+    return igraphmodule_i_Graph_similarity_sparse(self,
+        vobj ? vobj : Py_None, mode, 0,
+        IGRAPHMODULE_SIMILARITY_INVERSE_LOG_WEIGHTED, top_k_o, threshold_o,
+        threads_o);
   if (igraphmodule_PyObject_to_vs_t(vobj, &vs, &self->g, &return_single, 0)) return NULL;
 
   if (igraph_matrix_init(&res, 0, 0)) {
@@ -5596,7 +7340,11 @@ PyObject *igraphmodule_Graph_similarity_inverse_log_weighted(
     return igraphmodule_handle_igraph_error();
   }
 
-  if (igraph_similarity_inverse_log_weighted(&self->g,&res,vs,mode)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_similarity_inverse_log_weighted(&self->g,&res,vs,mode);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraph_matrix_destroy(&res);
     igraph_vs_destroy(&vs);
     igraphmodule_handle_igraph_error();
@@ -5668,6 +7416,9 @@ PyObject *igraphmodule_Graph_simplify(igraphmodule_GraphObject * self,
                                    &multiple, &loops, &comb_o))
     return NULL;
 
+  if (!igraphmodule_Graph_check_not_busy(self))
+    return NULL;
+
   if (igraphmodule_PyObject_to_attribute_combination_t(comb_o, &comb))
   return NULL;
 
@@ -5803,6 +7554,7 @@ PyObject *igraphmodule_Graph_transitivity_undirected(igraphmodule_GraphObject
   igraph_real_t res;
   PyObject *r, *mode_o = Py_None;
   igraph_transitivity_mode_t mode = IGRAPH_TRANSITIVITY_NAN;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &mode_o))
     return NULL;
@@ -5811,7 +7563,11 @@ PyObject *igraphmodule_Graph_transitivity_undirected(igraphmodule_GraphObject
     return NULL;
 
 
-  if (igraph_transitivity_undirected(&self->g, &res, mode)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_transitivity_undirected(&self->g, &res, mode);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraphmodule_handle_igraph_error();
     return NULL;
   }
@@ -5832,6 +7588,7 @@ PyObject *igraphmodule_Graph_transitivity_avglocal_undirected(igraphmodule_Graph
   igraph_real_t res;
   PyObject *r, *mode_o = Py_None;
   igraph_transitivity_mode_t mode = IGRAPH_TRANSITIVITY_NAN;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &mode_o))
     return NULL;
@@ -5839,7 +7596,11 @@ PyObject *igraphmodule_Graph_transitivity_avglocal_undirected(igraphmodule_Graph
   if (igraphmodule_PyObject_to_transitivity_mode_t(mode_o, &mode))
     return NULL;
 
-  if (igraph_transitivity_avglocal_undirected(&self->g, &res, mode)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_transitivity_avglocal_undirected(&self->g, &res, mode);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraphmodule_handle_igraph_error();
     return NULL;
   }
@@ -5891,11 +7652,13 @@ PyObject
     return NULL;
   }
 
+  IGRAPHMODULE_BEGIN_NOGIL(self);
   if (weights == 0) {
     retval = igraph_transitivity_local_undirected(&self->g, &result, vs, mode);
   } else {
     retval = igraph_transitivity_barrat(&self->g, &result, vs, weights, mode);
   }
+  IGRAPHMODULE_END_NOGIL(self);
 
   igraph_vs_destroy(&vs);
   if (weights) {
@@ -6070,14 +7833,243 @@ PyObject *igraphmodule_Graph_is_bipartite(igraphmodule_GraphObject *self,
  * Motifs, dyad and triad census                                      *
  **********************************************************************/
 
+/**
+ * Minimum number of roots handled in a round of the parallel motif search;
+ * the progress handler is called and pending signals are checked between
+ * two rounds
+ */
+#define IGRAPHMODULE_MOTIFS_MIN_ROUND 1024
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Parses the \c threads argument of the motif and census functions
+ */
+static int igraphmodule_i_Graph_motifs_threads(PyObject *threads_o, long int *threads) {
+  *threads = 1;
+  if (threads_o != Py_None) {
+    *threads = PyInt_AsLong(threads_o);
+    if (PyErr_Occurred())
+      return 1;
+    if (*threads <= 0) {
+      PyErr_SetString(PyExc_ValueError, "threads must be positive");
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Sets up a parallel motif search on a graph
+ *
+ * Looks up the class table, converts the cut probabilities and acquires the
+ * adjacency lists of the graph. The search must be released with
+ * \ref igraphmodule_i_Graph_motifs_destroy() if this function succeeds.
+ *
+ * \param seed_o  the seed of the random streams, \c None to draw one from
+ *                the random number generator of igraph, or \c NULL if the
+ *                search needs no random numbers
+ * \param triads  whether the subgraphs are classified by triad type
+ * \param cut_prob the converted cut probabilities are stored here
+ * \return 0 if everything was OK, 1 otherwise with a Python exception set
+ */
+static int igraphmodule_i_Graph_motifs_init(igraphmodule_GraphObject *self,
+    long int size, PyObject *cut_prob_o, PyObject *seed_o, igraph_bool_t triads,
+    igraphmodule_motifs_t *motifs, igraph_vector_t *cut_prob) {
+  igraph_bool_t directed = igraph_is_directed(&self->g);
+  long int i;
+
+  memset(motifs, 0, sizeof(igraphmodule_motifs_t));
+
+  motifs->table = igraphmodule_motif_table(size, directed || triads, triads);
+  if (motifs->table == 0)
+    return 1;
+
+  if (cut_prob_o == Py_None) {
+    if (igraph_vector_init(cut_prob, 0)) {
+      igraphmodule_handle_igraph_error();
+      return 1;
+    }
+  } else {
+    if (igraphmodule_PyObject_float_to_vector_t(cut_prob_o, cut_prob))
+      return 1;
+    if (igraph_vector_size(cut_prob) < size) {
+      PyErr_SetString(PyExc_ValueError, "cut_prob must have an item for every "
+          "level of the search tree");
+      igraph_vector_destroy(cut_prob);
+      return 1;
+    }
+    for (i = 0; i < size; i++) {
+      if (!(VECTOR(*cut_prob)[i] >= 0 && VECTOR(*cut_prob)[i] <= 1)) {
+        PyErr_SetString(PyExc_ValueError, "cut probabilities must be between 0 and 1");
+        igraph_vector_destroy(cut_prob);
+        return 1;
+      }
+      if (VECTOR(*cut_prob)[i] > 0)
+        motifs->cut_prob = VECTOR(*cut_prob);
+    }
+  }
+
+  /* The default random number generator calls back into Python, so the
+   * seed of the random streams is drawn before the GIL is released */
+  if (seed_o == Py_None) {
+    motifs->seed = (unsigned long int) igraph_rng_get_integer(igraph_rng_default(),
+        0, 0x7fffffffL);
+  } else if (seed_o != 0) {
+    motifs->seed = PyLong_AsUnsignedLongMask(seed_o);
+    if (PyErr_Occurred()) {
+      igraph_vector_destroy(cut_prob);
+      return 1;
+    }
+  }
+
+  motifs->all = igraphmodule_acquire_adjacency(&self->g, IGRAPH_ALL);
+  if (motifs->all == 0) {
+    igraph_vector_destroy(cut_prob);
+    return 1;
+  }
+  motifs->out = igraphmodule_acquire_adjacency(&self->g, directed ? IGRAPH_OUT : IGRAPH_ALL);
+  if (motifs->out == 0) {
+    igraphmodule_adjacency_decref((igraphmodule_adjacency_t*) motifs->all);
+    igraph_vector_destroy(cut_prob);
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Releases a motif search set up by
+ *        \ref igraphmodule_i_Graph_motifs_init()
+ */
+static void igraphmodule_i_Graph_motifs_destroy(igraphmodule_motifs_t *motifs,
+    igraph_vector_t *cut_prob) {
+  igraphmodule_adjacency_decref((igraphmodule_adjacency_t*) motifs->out);
+  igraphmodule_adjacency_decref((igraphmodule_adjacency_t*) motifs->all);
+  igraph_vector_destroy(cut_prob);
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Calls the progress handler and checks for pending signals between
+ *        two rounds of a motif search
+ * \return 0 if the search may go on, 1 otherwise with a Python exception set
+ */
+static int igraphmodule_i_Graph_motifs_report(const char *message,
+    igraph_real_t percent) {
+  if (igraph_progress(message, percent, 0) || igraph_allow_interruption(0)) {
+    if (!PyErr_Occurred())
+      PyErr_SetNone(PyExc_KeyboardInterrupt);
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Counts the motifs of a graph from every root, in rounds
+ *
+ * \param counts the number of motifs of each class followed by the total
+ *               number of motifs are added here
+ * \return 0 if everything was OK, 1 otherwise with a Python exception set
+ */
+static int igraphmodule_i_Graph_motifs_exact(igraphmodule_GraphObject *self,
+    const igraphmodule_motifs_t *motifs, long int threads, const char *message,
+    igraph_real_t *counts) {
+  long int n = igraph_vcount(&self->g), i, round, no_of_roots;
+  long int *roots;
+  int retval = 0;
+
+  roots = (long int*) calloc(n > 0 ? n : 1, sizeof(long int));
+  if (roots == 0) {
+    PyErr_NoMemory();
+    return 1;
+  }
+  for (i = 0; i < n; i++)
+    roots[i] = i;
+
+  round = n / 100;
+  if (round < IGRAPHMODULE_MOTIFS_MIN_ROUND)
+    round = IGRAPHMODULE_MOTIFS_MIN_ROUND;
+
+  if (igraphmodule_i_Graph_motifs_report(message, 0)) {
+    free(roots);
+    return 1;
+  }
+  for (i = 0; i < n && !retval; i += round) {
+    no_of_roots = n - i < round ? n - i : round;
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraphmodule_motifs_count(motifs, roots + i, no_of_roots, threads,
+        counts, 0);
+    IGRAPHMODULE_END_NOGIL(self);
+    if (retval) {
+      PyErr_NoMemory();
+    } else if (igraphmodule_i_Graph_motifs_report(message,
+          100.0 * (i + no_of_roots) / n)) {
+      retval = 1;
+    }
+  }
+  free(roots);
+
+  return retval ? 1 : 0;
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Stores the motif counts of the connected classes in a vector, with
+ *        NaN for the classes of unconnected graphs like the C core does
+ */
+static int igraphmodule_i_Graph_motifs_to_vector(const igraphmodule_motif_table_t *table,
+    const igraph_real_t *counts, igraph_vector_t *result) {
+  long int i;
+
+  IGRAPH_CHECK(igraph_vector_resize(result, table->no_of_classes));
+  for (i = 0; i < table->no_of_classes; i++)
+    VECTOR(*result)[i] = table->connected[i] ? counts[i] : IGRAPH_NAN;
+
+  return IGRAPH_SUCCESS;
+}
+
 /** \ingroup python_interface_graph
  * \brief Calculates the dyad census of the graph
  * \return the dyad census as a 3-tuple
  * \sa igraph_dyad_census
  */
-PyObject *igraphmodule_Graph_dyad_census(igraphmodule_GraphObject *self) {
+PyObject *igraphmodule_Graph_dyad_census(igraphmodule_GraphObject *self,
+  PyObject *args, PyObject *kwds) {
+  static char* kwlist[] = {"threads", NULL};
   igraph_integer_t mut, asym, nul;
-  PyObject *list;
+  igraph_real_t mut_r, asym_r, n;
+  igraphmodule_adjacency_t *adj;
+  PyObject *list, *threads_o = Py_None;
+  long int threads;
+  int retval;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &threads_o))
+    return NULL;
+
+  if (threads_o != Py_None) {
+    if (igraphmodule_i_Graph_motifs_threads(threads_o, &threads))
+      return NULL;
+
+    adj = igraphmodule_acquire_adjacency(&self->g,
+        igraph_is_directed(&self->g) ? IGRAPH_OUT : IGRAPH_ALL);
+    if (adj == 0)
+      return NULL;
+
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraphmodule_dyads_count(adj, threads, &asym_r, &mut_r);
+    IGRAPHMODULE_END_NOGIL(self);
+
+    igraphmodule_adjacency_decref(adj);
+    if (retval)
+      return PyErr_NoMemory();
+
+    n = igraph_vcount(&self->g);
+    return Py_BuildValue("lll", (long)mut_r, (long)asym_r,
+        (long)(n * (n - 1) / 2 - mut_r - asym_r));
+  }
 
   if (igraph_dyad_census(&self->g, &mut, &asym, &nul)) {
     return igraphmodule_handle_igraph_error();
@@ -6120,6 +8112,60 @@ igraph_bool_t igraphmodule_i_Graph_motifs_randesu_callback(const igraph_t *graph
   return retval;
 }
 
+/** \ingroup python_interface_graph
+ * \brief Counts the motifs of the graph with the parallel kernel
+ * \param total whether to return the total number of motifs only
+ * \return the list of counts or the total number of motifs
+ */
+static PyObject *igraphmodule_i_Graph_motifs_randesu_threads(igraphmodule_GraphObject *self,
+  long int size, PyObject *cut_prob_o, PyObject *threads_o, PyObject *seed_o,
+  igraph_bool_t total) {
+  igraphmodule_motifs_t motifs;
+  igraph_vector_t cut_prob, result;
+  igraph_real_t *counts;
+  long int threads;
+  PyObject *list;
+
+  if (igraphmodule_i_Graph_motifs_threads(threads_o, &threads))
+    return NULL;
+  if (igraphmodule_i_Graph_motifs_init(self, size, cut_prob_o,
+        cut_prob_o == Py_None ? 0 : seed_o, 0, &motifs, &cut_prob))
+    return NULL;
+
+  counts = (igraph_real_t*) calloc(motifs.table->no_of_classes + 1,
+      sizeof(igraph_real_t));
+  if (counts == 0) {
+    igraphmodule_i_Graph_motifs_destroy(&motifs, &cut_prob);
+    return PyErr_NoMemory();
+  }
+
+  if (igraphmodule_i_Graph_motifs_exact(self, &motifs, threads,
+        "Counting motifs", counts)) {
+    free(counts);
+    igraphmodule_i_Graph_motifs_destroy(&motifs, &cut_prob);
+    return NULL;
+  }
+  igraphmodule_i_Graph_motifs_destroy(&motifs, &cut_prob);
+
+  if (total) {
+    list = PyInt_FromLong((long) counts[motifs.table->no_of_classes]);
+    free(counts);
+    return list;
+  }
+
+  if (igraph_vector_init(&result, 0) ||
+      igraphmodule_i_Graph_motifs_to_vector(motifs.table, counts, &result)) {
+    free(counts);
+    return igraphmodule_handle_igraph_error();
+  }
+  free(counts);
+
+  list = igraphmodule_vector_t_to_PyList(&result, IGRAPHMODULE_TYPE_INT);
+  igraph_vector_destroy(&result);
+
+  return list;
+}
+
 /** \ingroup python_interface_graph
  * \brief Counts the motifs of the graph sorted by isomorphism classes
  * \return the number of motifs found for each isomorphism class
@@ -6131,13 +8177,24 @@ PyObject *igraphmodule_Graph_motifs_randesu(igraphmodule_GraphObject *self,
   long int size=3;
   PyObject* cut_prob_list=Py_None;
   PyObject* callback=Py_None;
+  PyObject* threads_o=Py_None, *seed_o=Py_None;
   PyObject *list;
-  static char* kwlist[] = {"size", "cut_prob", "callback", NULL};
+  static char* kwlist[] = {"size", "cut_prob", "callback", "threads", "seed", NULL};
+  int retval;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|lOO", kwlist, &size,
-        &cut_prob_list, &callback))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|lOOOO", kwlist, &size,
+        &cut_prob_list, &callback, &threads_o, &seed_o))
     return NULL;
 
+  if (threads_o != Py_None) {
+    if (callback != Py_None) {
+      PyErr_SetString(PyExc_ValueError, "callback cannot be used together with threads");
+      return NULL;
+    }
+    return igraphmodule_i_Graph_motifs_randesu_threads(self, size,
+        cut_prob_list, threads_o, seed_o, 0);
+  }
+
   if (cut_prob_list == Py_None) {
     if (igraph_vector_init(&cut_prob, size)) {
       return igraphmodule_handle_igraph_error();
@@ -6153,7 +8210,11 @@ PyObject *igraphmodule_Graph_motifs_randesu(igraphmodule_GraphObject *self,
       igraph_vector_destroy(&cut_prob);
       return igraphmodule_handle_igraph_error();
     }
-    if (igraph_motifs_randesu(&self->g, &result, (igraph_integer_t) size, &cut_prob)) {
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraph_motifs_randesu(&self->g, &result, (igraph_integer_t) size, &cut_prob);
+    IGRAPHMODULE_END_NOGIL(self);
+
+    if (retval) {
       igraphmodule_handle_igraph_error();
       igraph_vector_destroy(&result);
       igraph_vector_destroy(&cut_prob);
@@ -6197,11 +8258,17 @@ PyObject *igraphmodule_Graph_motifs_randesu_no(igraphmodule_GraphObject *self,
   igraph_integer_t result;
   long int size=3;
   PyObject* cut_prob_list=Py_None;
-  static char* kwlist[] = {"size", "cut_prob", NULL};
+  PyObject* threads_o=Py_None, *seed_o=Py_None;
+  static char* kwlist[] = {"size", "cut_prob", "threads", "seed", NULL};
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|lO", kwlist, &size, &cut_prob_list))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|lOOO", kwlist, &size,
+        &cut_prob_list, &threads_o, &seed_o))
     return NULL;
 
+  if (threads_o != Py_None)
+    return igraphmodule_i_Graph_motifs_randesu_threads(self, size,
+        cut_prob_list, threads_o, seed_o, 1);
+
   if (cut_prob_list == Py_None) {
     if (igraph_vector_init(&cut_prob, size)) {
       return igraphmodule_handle_igraph_error();
@@ -6285,30 +8352,290 @@ PyObject *igraphmodule_Graph_motifs_randesu_estimate(igraphmodule_GraphObject *s
 }
 
 /** \ingroup python_interface_graph
- * \brief Calculates the triad census of the graph
- * \return the triad census as a list
- * \sa igraph_triad_census
+ * \brief Converts the running estimates of a motif sample to Python lists
+ *
+ * \param n       the number of vertices of the graph
+ * \param s       the number of roots sampled so far
+ * \param z       the quantile of the standard normal distribution
+ *                belonging to the confidence level
+ * \param total   if not \c NULL, the estimated total number of motifs and
+ *                the half-width of its confidence interval are stored here
+ * \return a new reference to the tuple of the estimates and the lower and
+ *         upper bounds of the confidence intervals, or \c NULL
  */
-PyObject *igraphmodule_Graph_triad_census(igraphmodule_GraphObject *self) {
-  igraph_vector_t result;
-  PyObject *list;
-
-  if (igraph_vector_init(&result, 16)) {
+static PyObject *igraphmodule_i_Graph_motifs_estimates(const igraphmodule_motif_table_t *table,
+    const igraph_real_t *acc, const igraph_real_t *sq, igraph_real_t n,
+    igraph_real_t s, igraph_real_t z, igraph_real_t *total) {
+  igraph_vector_t est, lower, upper;
+  igraph_real_t mean, var, half;
+  PyObject *est_o, *lower_o, *upper_o;
+  long int i;
+
+  if (igraph_vector_init(&est, table->no_of_classes))
+    return igraphmodule_handle_igraph_error();
+  if (igraph_vector_init(&lower, table->no_of_classes)) {
+    igraph_vector_destroy(&est);
     return igraphmodule_handle_igraph_error();
   }
-  if (igraph_triad_census(&self->g, &result)) {
-    igraphmodule_handle_igraph_error();
-    igraph_vector_destroy(&result);
-    return NULL;
+  if (igraph_vector_init(&upper, table->no_of_classes)) {
+    igraph_vector_destroy(&lower);
+    igraph_vector_destroy(&est);
+    return igraphmodule_handle_igraph_error();
   }
 
-  list = igraphmodule_vector_t_to_PyTuple(&result);
-  igraph_vector_destroy(&result);
-
-  return list;
-}
-
-/**********************************************************************
+  /* The count of a class is n times the mean count over the sampled roots;
+   * the confidence interval comes from the central limit theorem */
+  for (i = 0; i <= table->no_of_classes; i++) {
+    if (s == 0) {
+      mean = var = 0;
+      half = n > 0 ? IGRAPH_INFINITY : 0;
+    } else {
+      mean = acc[i] / s;
+      var = s > 1 ? (sq[i] - s * mean * mean) / (s - 1) : 0;
+      if (var < 0)
+        var = 0;
+      half = s > 1 ? z * n * sqrt(var / s) : IGRAPH_INFINITY;
+    }
+    if (i == table->no_of_classes) {
+      if (total) {
+        total[0] = n * mean;
+        total[1] = half;
+      }
+      break;
+    }
+    if (table->connected[i]) {
+      VECTOR(est)[i] = n * mean;
+      VECTOR(lower)[i] = n * mean > half ? n * mean - half : 0;
+      VECTOR(upper)[i] = n * mean + half;
+    } else {
+      VECTOR(est)[i] = VECTOR(lower)[i] = VECTOR(upper)[i] = IGRAPH_NAN;
+    }
+  }
+
+  est_o = igraphmodule_vector_t_to_PyList(&est, IGRAPHMODULE_TYPE_FLOAT);
+  lower_o = igraphmodule_vector_t_to_PyList(&lower, IGRAPHMODULE_TYPE_FLOAT);
+  upper_o = igraphmodule_vector_t_to_PyList(&upper, IGRAPHMODULE_TYPE_FLOAT);
+  igraph_vector_destroy(&upper);
+  igraph_vector_destroy(&lower);
+  igraph_vector_destroy(&est);
+
+  if (!est_o || !lower_o || !upper_o) {
+    Py_XDECREF(est_o);
+    Py_XDECREF(lower_o);
+    Py_XDECREF(upper_o);
+    return NULL;
+  }
+
+  return Py_BuildValue("NNN", est_o, lower_o, upper_o);
+}
+
+/** \ingroup python_interface_graph
+ * \brief Estimates the number of motifs of each isomorphism class from a
+ *        growing random sample of root vertices
+ * \return the estimates and the bounds of their confidence intervals
+ */
+PyObject *igraphmodule_Graph_motifs_randesu_sample(igraphmodule_GraphObject *self,
+  PyObject *args, PyObject *kwds) {
+  static char* kwlist[] = {"size", "samples", "cut_prob", "threads", "seed",
+    "confidence", "callback", NULL};
+  igraphmodule_motifs_t motifs;
+  igraph_vector_t cut_prob;
+  igraph_real_t *acc = 0, *sq = 0, z, total[2];
+  igraph_rng_t rng;
+  long int size = 3, samples = 1000, threads, n, done, round, no_of_roots, i;
+  long int *roots = 0;
+  double confidence = 0.95;
+  PyObject *cut_prob_o = Py_None, *threads_o = Py_None, *seed_o = Py_None;
+  PyObject *callback = Py_None, *result = 0, *cb_result;
+  char message[128];
+  igraph_bool_t stop = 0;
+  int retval;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|llOOOdO", kwlist, &size,
+        &samples, &cut_prob_o, &threads_o, &seed_o, &confidence, &callback))
+    return NULL;
+
+  if (samples <= 0) {
+    PyErr_SetString(PyExc_ValueError, "samples must be positive");
+    return NULL;
+  }
+  if (!(confidence > 0 && confidence < 1)) {
+    PyErr_SetString(PyExc_ValueError, "confidence must be between 0 and 1");
+    return NULL;
+  }
+  if (callback != Py_None && !PyCallable_Check(callback)) {
+    PyErr_SetString(PyExc_TypeError, "callback must be callable or None");
+    return NULL;
+  }
+  if (igraphmodule_i_Graph_motifs_threads(threads_o, &threads))
+    return NULL;
+  if (igraphmodule_i_Graph_motifs_init(self, size, cut_prob_o, seed_o, 0,
+        &motifs, &cut_prob))
+    return NULL;
+
+  n = igraph_vcount(&self->g);
+  z = igraphmodule_normal_quantile((1 + confidence) / 2);
+
+  if (igraph_rng_init(&rng, &igraph_rngtype_mt19937)) {
+    igraphmodule_i_Graph_motifs_destroy(&motifs, &cut_prob);
+    return igraphmodule_handle_igraph_error();
+  }
+  igraph_rng_seed(&rng, motifs.seed);
+
+  round = samples / 100;
+  if (round < 64 * threads)
+    round = 64 * threads;
+  if (round > samples)
+    round = samples;
+
+  acc = (igraph_real_t*) calloc(motifs.table->no_of_classes + 1, sizeof(igraph_real_t));
+  sq = (igraph_real_t*) calloc(motifs.table->no_of_classes + 1, sizeof(igraph_real_t));
+  roots = (long int*) calloc(round, sizeof(long int));
+  if (!acc || !sq || !roots) {
+    PyErr_NoMemory();
+    goto cleanup;
+  }
+
+  if (igraphmodule_i_Graph_motifs_report("Sampling motifs", 0))
+    goto cleanup;
+
+  /* Every round draws its roots uniformly with replacement, counts the
+   * motifs found from them and reports the running estimates */
+  for (done = 0; done < samples && n > 0 && !stop; done += no_of_roots) {
+    no_of_roots = samples - done < round ? samples - done : round;
+    for (i = 0; i < no_of_roots; i++)
+      roots[i] = igraph_rng_get_integer(&rng, 0, n - 1);
+
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraphmodule_motifs_count(&motifs, roots, no_of_roots, threads, acc, sq);
+    IGRAPHMODULE_END_NOGIL(self);
+    if (retval) {
+      PyErr_NoMemory();
+      goto cleanup;
+    }
+
+    Py_XDECREF(result);
+    result = igraphmodule_i_Graph_motifs_estimates(motifs.table, acc, sq, n,
+        done + no_of_roots, z, total);
+    if (result == 0)
+      goto cleanup;
+
+    snprintf(message, sizeof(message), "Sampling motifs: %.0f +/- %.0f in total",
+        total[0], total[1]);
+    if (igraphmodule_i_Graph_motifs_report(message,
+          100.0 * (done + no_of_roots) / samples)) {
+      Py_CLEAR(result);
+      goto cleanup;
+    }
+
+    if (callback != Py_None) {
+      cb_result = PyObject_CallFunction(callback, "lOOO", done + no_of_roots,
+          PyTuple_GET_ITEM(result, 0), PyTuple_GET_ITEM(result, 1),
+          PyTuple_GET_ITEM(result, 2));
+      if (cb_result == 0) {
+        Py_CLEAR(result);
+        goto cleanup;
+      }
+      stop = PyObject_IsTrue(cb_result);
+      Py_DECREF(cb_result);
+    }
+  }
+
+  if (result == 0) {
+    /* The graph has no vertices */
+    result = igraphmodule_i_Graph_motifs_estimates(motifs.table, acc, sq, n,
+        0, z, 0);
+  }
+
+cleanup:
+  free(roots);
+  free(sq);
+  free(acc);
+  igraph_rng_destroy(&rng);
+  igraphmodule_i_Graph_motifs_destroy(&motifs, &cut_prob);
+
+  return result;
+}
+
+/** \ingroup python_interface_graph
+ * \brief Calculates the triad census of the graph
+ * \return the triad census as a list
+ * \sa igraph_triad_census
+ */
+PyObject *igraphmodule_Graph_triad_census(igraphmodule_GraphObject *self,
+  PyObject *args, PyObject *kwds) {
+  static char* kwlist[] = {"threads", NULL};
+  igraphmodule_motifs_t motifs;
+  igraph_vector_t result, cut_prob;
+  igraph_real_t counts[17], asym, mutual, n, sum;
+  PyObject *list, *threads_o = Py_None;
+  long int threads, i;
+  int retval;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &threads_o))
+    return NULL;
+
+  if (igraph_vector_init(&result, 16)) {
+    return igraphmodule_handle_igraph_error();
+  }
+
+  if (threads_o != Py_None) {
+    if (igraphmodule_i_Graph_motifs_threads(threads_o, &threads) ||
+        igraphmodule_i_Graph_motifs_init(self, 3, Py_None, 0, 1,
+          &motifs, &cut_prob)) {
+      igraph_vector_destroy(&result);
+      return NULL;
+    }
+    if (!igraph_is_directed(&self->g) &&
+        PyErr_WarnEx(PyExc_RuntimeWarning,
+          "Triad census called on an undirected graph", 1)) {
+      igraphmodule_i_Graph_motifs_destroy(&motifs, &cut_prob);
+      igraph_vector_destroy(&result);
+      return NULL;
+    }
+
+    /* The connected triads are found by the motif search, the ones with
+     * a single connected pair from the pairs of adjacent vertices and
+     * the empty ones make up the rest */
+    memset(counts, 0, sizeof(counts));
+    if (igraphmodule_i_Graph_motifs_exact(self, &motifs, threads,
+          "Triad census", counts)) {
+      igraphmodule_i_Graph_motifs_destroy(&motifs, &cut_prob);
+      igraph_vector_destroy(&result);
+      return NULL;
+    }
+
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraphmodule_triads_dyadic(motifs.all, motifs.out, threads,
+        &asym, &mutual);
+    IGRAPHMODULE_END_NOGIL(self);
+    igraphmodule_i_Graph_motifs_destroy(&motifs, &cut_prob);
+    if (retval) {
+      igraph_vector_destroy(&result);
+      return PyErr_NoMemory();
+    }
+
+    counts[1] = asym;
+    counts[2] = mutual;
+    for (sum = 0, i = 1; i < 16; i++) {
+      VECTOR(result)[i] = counts[i];
+      sum += counts[i];
+    }
+    n = igraph_vcount(&self->g);
+    VECTOR(result)[0] = n * (n - 1) * (n - 2) / 6 - sum;
+  } else if (igraph_triad_census(&self->g, &result)) {
+    igraphmodule_handle_igraph_error();
+    igraph_vector_destroy(&result);
+    return NULL;
+  }
+
+  list = igraphmodule_vector_t_to_PyTuple(&result);
+  igraph_vector_destroy(&result);
+
+  return list;
+}
+
+/**********************************************************************
  * Graph layout algorithms                                            *
  **********************************************************************/
 
@@ -6617,6 +8944,7 @@ PyObject *igraphmodule_Graph_layout_kamada_kawai(igraphmodule_GraphObject *
       return NULL;
     }
   }
+  IGRAPHMODULE_BEGIN_NOGIL(self);
   if (dim == 2)
     ret = igraph_layout_kamada_kawai
       (&self->g, &m, use_seed, (igraph_integer_t) niter, epsilon, kkconst,
@@ -6625,6 +8953,7 @@ PyObject *igraphmodule_Graph_layout_kamada_kawai(igraphmodule_GraphObject *
     ret = igraph_layout_kamada_kawai_3d
       (&self->g, &m, use_seed, (igraph_integer_t) niter, epsilon, kkconst,
        /*weights=*/ 0, /*bounds*/ minx, maxx, miny, maxy, minz, maxz);
+  IGRAPHMODULE_END_NOGIL(self);
 
   DESTROY_VECTORS;
 
@@ -6799,11 +9128,13 @@ PyObject* igraphmodule_Graph_layout_drl(igraphmodule_GraphObject *self,
     return NULL;
   }
 
+  IGRAPHMODULE_BEGIN_NOGIL(self);
   if (dim == 2) {
 	retval = igraph_layout_drl(&self->g, &m, use_seed, &options, weights, fixed);
   } else {
 	retval = igraph_layout_drl_3d(&self->g, &m, use_seed, &options, weights, fixed);
   }
+  IGRAPHMODULE_END_NOGIL(self);
 
   if (retval) {
     igraph_matrix_destroy(&m);
@@ -6935,6 +9266,7 @@ PyObject
     }
   }
 
+  IGRAPHMODULE_BEGIN_NOGIL(self);
   if (dim == 2) {
     ret = igraph_layout_fruchterman_reingold
       (&self->g, &m, use_seed, (igraph_integer_t) niter,
@@ -6944,6 +9276,7 @@ PyObject
       (&self->g, &m, use_seed, (igraph_integer_t) niter,
        start_temp, weights, minx, maxx, miny, maxy, minz, maxz);
   }
+  IGRAPHMODULE_END_NOGIL(self);
 
   DESTROY_VECTORS;
 
@@ -6979,6 +9312,7 @@ PyObject *igraphmodule_Graph_layout_graphopt(igraphmodule_GraphObject *self,
   double spring_constant = 1, max_sa_movement = 5;
   PyObject *result, *seed_o = Py_None;
   igraph_bool_t use_seed=0;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|lddlddO", kwlist,
                                    &niter, &node_charge, &node_mass,
@@ -6997,9 +9331,13 @@ PyObject *igraphmodule_Graph_layout_graphopt(igraphmodule_GraphObject *self,
 			return NULL;
   }
 
-  if (igraph_layout_graphopt(&self->g, &m, (igraph_integer_t) niter,
-        node_charge, node_mass, spring_length, spring_constant,
-        max_sa_movement, use_seed)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_layout_graphopt(&self->g, &m, (igraph_integer_t) niter,
+      node_charge, node_mass, spring_length, spring_constant,
+      max_sa_movement, use_seed);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraph_matrix_destroy(&m);
     igraphmodule_handle_igraph_error();
     return NULL;
@@ -7010,6 +9348,139 @@ PyObject *igraphmodule_Graph_layout_graphopt(igraphmodule_GraphObject *self,
   return (PyObject *) result;
 }
 
+/** \ingroup python_interface_graph
+ * \brief Places the vertices of a graph with a multilevel, multi-threaded
+ * force-directed algorithm whose repulsion is approximated with the
+ * Barnes-Hut method
+ * \return the calculated coordinates as a Python list of lists or a buffer
+ * \sa igraphmodule_layout_barnes_hut
+ */
+PyObject *igraphmodule_Graph_layout_barnes_hut(igraphmodule_GraphObject *self,
+  PyObject *args, PyObject *kwds) {
+  static char *kwlist[] =
+    { "weights", "niter", "seed", "dim", "theta", "multilevel", "threads",
+      "random_seed", "return_type", NULL };
+  igraphmodule_barnes_hut_options_t opts;
+  igraphmodule_adjacency_t *adj;
+  igraphmodule_return_type_t return_type = IGRAPHMODULE_RETURN_LIST;
+  igraph_matrix_t m, seed;
+  igraph_vector_t *weights = 0;
+  igraph_bool_t use_seed = 0;
+  long int niter = 500, dim = 2;
+  double theta = 0.8;
+  PyObject *result, *weights_o = Py_None, *seed_o = Py_None;
+  PyObject *multilevel_o = Py_True, *threads_o = Py_None;
+  PyObject *random_seed_o = Py_None, *return_type_o = Py_None;
+  int retval;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OlOldOOOO", kwlist,
+                                   &weights_o, &niter, &seed_o, &dim, &theta,
+                                   &multilevel_o, &threads_o, &random_seed_o,
+                                   &return_type_o))
+    return NULL;
+
+  if (dim != 2 && dim != 3) {
+    PyErr_SetString(PyExc_ValueError, "number of dimensions must be either 2 or 3");
+    return NULL;
+  }
+  if (niter < 0) {
+    PyErr_SetString(PyExc_ValueError, "number of iterations must be non-negative");
+    return NULL;
+  }
+  if (!(theta >= 0)) {
+    PyErr_SetString(PyExc_ValueError, "theta must be non-negative");
+    return NULL;
+  }
+
+  if (igraphmodule_PyObject_to_return_type_t(return_type_o, &return_type))
+    return NULL;
+
+  opts.dim = dim;
+  opts.niter = niter;
+  opts.theta = theta;
+  opts.multilevel = PyObject_IsTrue(multilevel_o);
+  opts.threads = 1;
+  if (threads_o != Py_None) {
+    opts.threads = PyInt_AsLong(threads_o);
+    if (PyErr_Occurred())
+      return NULL;
+    if (opts.threads <= 0) {
+      PyErr_SetString(PyExc_ValueError, "threads must be positive");
+      return NULL;
+    }
+  }
+
+  /* The default random number generator calls back into Python, so the
+   * seed of the random stream is drawn before the GIL is released */
+  if (random_seed_o == Py_None) {
+    opts.seed = (unsigned long int) igraph_rng_get_integer(igraph_rng_default(),
+        0, 0x7fffffffL);
+  } else {
+    opts.seed = PyLong_AsUnsignedLongMask(random_seed_o);
+    if (PyErr_Occurred())
+      return NULL;
+  }
+
+  if (seed_o != Py_None) {
+    if (igraphmodule_PyList_to_matrix_t(seed_o, &seed))
+      return NULL;
+    use_seed = 1;
+    if (igraph_matrix_nrow(&seed) > igraph_vcount(&self->g) ||
+        (igraph_matrix_nrow(&seed) > 0 && igraph_matrix_ncol(&seed) != dim)) {
+      PyErr_SetString(PyExc_ValueError, "seed layout must have at most as many "
+          "rows as there are vertices and as many columns as dimensions");
+      igraph_matrix_destroy(&seed);
+      return NULL;
+    }
+  }
+
+  if (igraphmodule_attrib_to_vector_t(weights_o, self, &weights, ATTRIBUTE_TYPE_EDGE)) {
+    if (use_seed) igraph_matrix_destroy(&seed);
+    return NULL;
+  }
+  if (weights && igraph_vector_size(weights) > 0 && !(igraph_vector_min(weights) >= 0)) {
+    PyErr_SetString(PyExc_ValueError, "weights must be non-negative");
+    igraph_vector_destroy(weights); free(weights);
+    if (use_seed) igraph_matrix_destroy(&seed);
+    return NULL;
+  }
+
+  if (igraph_matrix_init(&m, 0, 0)) {
+    if (weights) { igraph_vector_destroy(weights); free(weights); }
+    if (use_seed) igraph_matrix_destroy(&seed);
+    return igraphmodule_handle_igraph_error();
+  }
+
+  adj = igraphmodule_acquire_adjacency(&self->g, IGRAPH_ALL);
+  if (adj == 0) {
+    igraph_matrix_destroy(&m);
+    if (weights) { igraph_vector_destroy(weights); free(weights); }
+    if (use_seed) igraph_matrix_destroy(&seed);
+    return NULL;
+  }
+
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraphmodule_layout_barnes_hut(&self->g, adj, weights,
+      use_seed ? &seed : 0, &opts, &m);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  igraphmodule_adjacency_decref(adj);
+  if (weights) { igraph_vector_destroy(weights); free(weights); }
+  if (use_seed) igraph_matrix_destroy(&seed);
+
+  if (retval) {
+    igraph_matrix_destroy(&m);
+    if (retval == IGRAPH_ENOMEM)
+      return PyErr_NoMemory();
+    return igraphmodule_handle_igraph_error();
+  }
+
+  result = igraphmodule_matrix_t_to_PyObject(&m, IGRAPHMODULE_TYPE_FLOAT,
+      return_type);
+  igraph_matrix_destroy(&m);
+  return result;
+}
+
 /** \ingroup python_interface_graph
  * \brief Places the vertices of a graph according to the Large Graph Layout
  * \return the calculated coordinates as a Python list of lists
@@ -7423,6 +9894,132 @@ PyObject *igraphmodule_Graph_get_adjacency(igraphmodule_GraphObject * self,
   return result;
 }
 
+/** \ingroup python_interface_graph
+ * \brief Returns the adjacency matrix of a graph in compressed sparse row
+ *        (CSR) or coordinate (COO) format.
+ *
+ * The arrays are filled in a single pass over the incidence index of the
+ * graph (\c oi and \c ii in \c igraph_t), which lists the edges of every
+ * vertex sorted by the other endpoint, so the column indices within every
+ * row are sorted as well.
+ *
+ * \return a tuple of three typed columns (indptr, indices, data) for CSR or
+ *         (row, col, data) for COO
+ */
+PyObject *igraphmodule_Graph_get_adjacency_arrays(igraphmodule_GraphObject * self,
+                                                  PyObject * args, PyObject * kwds)
+{
+  static char *kwlist[] = { "format", "weights", "mode", NULL };
+  static igraphmodule_enum_translation_table_entry_t format_tt[] = {
+        {"csr", 0},
+        {"coo", 1},
+        {0,0}
+    };
+  PyObject *format_o = Py_None, *weights_o = Py_None, *mode_o = Py_None;
+  PyObject *rows_o = 0, *indices_o = 0, *data_o = 0;
+  igraph_neimode_t mode = IGRAPH_OUT;
+  igraph_vector_t *weights = 0;
+  igraph_t *g = &self->g;
+  PY_LONG_LONG *rows, *indices;
+  char *data;
+  long int v, n, m, p, p_end, q, q_end, k, capacity;
+  int format = 0;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOO", kwlist, &format_o,
+        &weights_o, &mode_o))
+    return NULL;
+
+  if (igraphmodule_PyObject_to_enum(format_o, format_tt, &format))
+    return NULL;
+  if (igraphmodule_PyObject_to_neimode_t(mode_o, &mode))
+    return NULL;
+  if (igraphmodule_attrib_to_vector_t(weights_o, self, &weights,
+        ATTRIBUTE_TYPE_EDGE))
+    return NULL;
+
+  if (!igraph_is_directed(g))
+    mode = IGRAPH_ALL;
+
+  n = igraph_vcount(g);
+  m = igraph_ecount(g);
+  capacity = (mode == IGRAPH_ALL) ? 2 * m : m;
+
+  rows_o = igraphmodule_Column_New(IGRAPHMODULE_COLUMN_INT,
+      format == 0 ? n + 1 : capacity);
+  indices_o = rows_o ? igraphmodule_Column_New(IGRAPHMODULE_COLUMN_INT, capacity) : 0;
+  data_o = indices_o ? igraphmodule_Column_New(weights ?
+      IGRAPHMODULE_COLUMN_FLOAT : IGRAPHMODULE_COLUMN_INT, capacity) : 0;
+  if (data_o == 0) {
+    Py_XDECREF(rows_o);
+    Py_XDECREF(indices_o);
+    if (weights) { igraph_vector_destroy(weights); free(weights); }
+    return NULL;
+  }
+
+  rows = (PY_LONG_LONG*)((igraphmodule_ColumnObject*)rows_o)->data;
+  indices = (PY_LONG_LONG*)((igraphmodule_ColumnObject*)indices_o)->data;
+  data = ((igraphmodule_ColumnObject*)data_o)->data;
+
+#define EMIT(row, col, eid) { \
+    if (format != 0) rows[k] = row; \
+    indices[k] = col; \
+    if (weights) ((double*)data)[k] = VECTOR(*weights)[eid]; \
+    else ((PY_LONG_LONG*)data)[k] = 1; \
+    k++; \
+  }
+
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  for (v = 0, k = 0; v < n; v++) {
+    if (format == 0)
+      rows[v] = k;
+
+    p = (mode != IGRAPH_IN) ? (long int)VECTOR(g->os)[v] : 0;
+    p_end = (mode != IGRAPH_IN) ? (long int)VECTOR(g->os)[v+1] : 0;
+    q = (mode != IGRAPH_OUT) ? (long int)VECTOR(g->is)[v] : 0;
+    q_end = (mode != IGRAPH_OUT) ? (long int)VECTOR(g->is)[v+1] : 0;
+
+    /* merge the successors and the predecessors of v; both are sorted.
+     * Loop edges appear among both, they are emitted only once */
+    while (p < p_end || q < q_end) {
+      long int e, col;
+      if (mode == IGRAPH_ALL && q < q_end) {
+        e = (long int)VECTOR(g->ii)[q];
+        if (IGRAPH_FROM(g, e) == IGRAPH_TO(g, e)) {
+          /* loop edge, emitted among the successors */
+          q++;
+          continue;
+        }
+      }
+      if (q >= q_end || (p < p_end &&
+            IGRAPH_TO(g, (long int)VECTOR(g->oi)[p]) <=
+            IGRAPH_FROM(g, (long int)VECTOR(g->ii)[q]))) {
+        e = (long int)VECTOR(g->oi)[p++];
+        col = (long int)IGRAPH_TO(g, e);
+      } else {
+        e = (long int)VECTOR(g->ii)[q++];
+        col = (long int)IGRAPH_FROM(g, e);
+      }
+      EMIT(v, col, e);
+    }
+  }
+  if (format == 0)
+    rows[n] = k;
+  IGRAPHMODULE_END_NOGIL(self);
+
+#undef EMIT
+
+  if (weights) { igraph_vector_destroy(weights); free(weights); }
+
+  /* loop edges of undirected graphs take only one slot; shrinking never
+   * fails */
+  if (format != 0)
+    igraphmodule_Column_resize((igraphmodule_ColumnObject*)rows_o, k);
+  igraphmodule_Column_resize((igraphmodule_ColumnObject*)indices_o, k);
+  igraphmodule_Column_resize((igraphmodule_ColumnObject*)data_o, k);
+
+  return Py_BuildValue("NNN", rows_o, indices_o, data_o);
+}
+
 /** \ingroup python_interface_graph
  * \brief Returns the incidence matrix of a bipartite graph.
  * \return the incidence matrix as a Python list of lists
@@ -7575,6 +10172,9 @@ PyObject *igraphmodule_Graph_to_undirected(igraphmodule_GraphObject * self,
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", kwlist, &mode_o, &comb_o))
     return NULL;
 
+  if (!igraphmodule_Graph_check_not_busy(self))
+    return NULL;
+
   if (igraphmodule_PyObject_to_to_undirected_t(mode_o, &mode))
     return NULL;
 
@@ -7607,6 +10207,10 @@ PyObject *igraphmodule_Graph_to_directed(igraphmodule_GraphObject * self,
   static char *kwlist[] = { "mutual", NULL };
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &mutual))
     return NULL;
+
+  if (!igraphmodule_Graph_check_not_busy(self))
+    return NULL;
+
   mode =
     (PyObject_IsTrue(mutual) ? IGRAPH_TO_DIRECTED_MUTUAL :
      IGRAPH_TO_DIRECTED_ARBITRARY);
@@ -7709,70 +10313,250 @@ PyObject *igraphmodule_Graph_Read_DL(PyTypeObject * type,
 }
 
 /** \ingroup python_interface_graph
- * \brief Reads an edge list from a file and creates a graph from it.
+ * \brief Reads a graph and its attributes from a file in the compact binary
+ *        format of \c write_binary()
  * \return the graph
- * \sa igraph_read_graph_edgelist
  */
-PyObject *igraphmodule_Graph_Read_Edgelist(PyTypeObject * type,
-                                           PyObject * args, PyObject * kwds)
+PyObject *igraphmodule_Graph_Read_Binary(PyTypeObject * type,
+                                         PyObject * args, PyObject * kwds)
 {
   igraphmodule_GraphObject *self;
-  PyObject *directed = Py_True, *fname = NULL;
+  PyObject *fname = NULL, *data;
   igraphmodule_filehandle_t fobj;
+  FILE *fp;
+  size_t size = 0, capacity = 65536, n;
   igraph_t g;
 
-  static char *kwlist[] = { "f", "directed", NULL };
+  static char *kwlist[] = { "f", NULL };
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist,
-                                   &fname, &directed))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &fname))
     return NULL;
 
-  if (igraphmodule_filehandle_init(&fobj, fname, "r"))
+  if (igraphmodule_filehandle_init(&fobj, fname, "rb"))
     return NULL;
 
-  if (igraph_read_graph_edgelist(&g, igraphmodule_filehandle_get(&fobj),
-        0, PyObject_IsTrue(directed))) {
-    igraphmodule_handle_igraph_error();
+  data = PyBytes_FromStringAndSize(0, capacity);
+  if (data == 0) {
     igraphmodule_filehandle_destroy(&fobj);
     return NULL;
   }
 
+  fp = igraphmodule_filehandle_get(&fobj);
+  while ((n = fread(PyBytes_AS_STRING(data) + size, 1, capacity - size, fp)) > 0) {
+    size += n;
+    if (size == capacity) {
+      capacity *= 2;
+      if (_PyBytes_Resize(&data, capacity)) {
+        igraphmodule_filehandle_destroy(&fobj);
+        return NULL;
+      }
+    }
+  }
+
+  if (ferror(fp)) {
+    PyErr_SetFromErrno(PyExc_IOError);
+    Py_DECREF(data);
+    igraphmodule_filehandle_destroy(&fobj);
+    return NULL;
+  }
   igraphmodule_filehandle_destroy(&fobj);
+
+  if (_PyBytes_Resize(&data, size))
+    return NULL;
+
+  if (igraphmodule_binary_to_igraph_t(data, &g)) {
+    Py_DECREF(data);
+    return NULL;
+  }
+  Py_DECREF(data);
+
   CREATE_GRAPH_FROM_TYPE(self, g, type);
 
   return (PyObject *) self;
 }
 
 /** \ingroup python_interface_graph
- * \brief Reads an edge list from an NCOL file and creates a graph from it.
- * \return the graph
- * \sa igraph_read_graph_ncol
+ * \brief Maps a file into memory in read-only mode
+ * \return the \c mmap object or \c NULL if an error happened
  */
-PyObject *igraphmodule_Graph_Read_Ncol(PyTypeObject * type, PyObject * args,
-                                       PyObject * kwds)
+static PyObject *igraphmodule_i_Graph_map_file(PyObject * fname)
 {
-  igraphmodule_GraphObject *self;
-  PyObject *names = Py_True, *weights = Py_None, *directed = Py_True;
-  PyObject *fname = NULL;
-  igraphmodule_filehandle_t fobj;
-  igraph_add_weights_t add_weights = IGRAPH_ADD_WEIGHTS_IF_PRESENT;
-  igraph_t g;
+  PyObject *io_module, *mmap_module, *fobj, *fileno, *mmap_func, *access;
+  PyObject *args, *kwds, *result = NULL;
 
-  static char *kwlist[] = { "f", "names", "weights", "directed", NULL };
-
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOO", kwlist,
-                                   &fname, &names, &weights, &directed))
+  io_module = PyImport_ImportModule("io");
+  if (io_module == NULL)
+    return NULL;
+  fobj = PyObject_CallMethod(io_module, "open", "Os", fname, "rb");
+  Py_DECREF(io_module);
+  if (fobj == NULL)
+    return NULL;
+
+  mmap_module = PyImport_ImportModule("mmap");
+  if (mmap_module == NULL) {
+    Py_DECREF(fobj);
+    return NULL;
+  }
+
+  fileno = PyObject_CallMethod(fobj, "fileno", NULL);
+  mmap_func = PyObject_GetAttrString(mmap_module, "mmap");
+  access = PyObject_GetAttrString(mmap_module, "ACCESS_READ");
+  Py_DECREF(mmap_module);
+
+  if (fileno != NULL && mmap_func != NULL && access != NULL) {
+    args = Py_BuildValue("Oi", fileno, 0);
+    kwds = Py_BuildValue("{sO}", "access", access);
+    if (args != NULL && kwds != NULL)
+      result = PyObject_Call(mmap_func, args, kwds);
+    Py_XDECREF(args);
+    Py_XDECREF(kwds);
+  }
+  Py_XDECREF(fileno);
+  Py_XDECREF(mmap_func);
+  Py_XDECREF(access);
+
+  /* The mapping stays valid after the file is closed */
+  if (result != NULL) {
+    PyObject *r = PyObject_CallMethod(fobj, "close", NULL);
+    if (r == NULL) {
+      Py_CLEAR(result);
+    } else {
+      Py_DECREF(r);
+    }
+  }
+  Py_DECREF(fobj);
+
+  return result;
+}
+
+/** \ingroup python_interface_graph
+ * \brief Opens a snapshot written by \c write_snapshot() as a read-only
+ *        graph whose vectors point into the memory-mapped snapshot
+ * \return the graph
+ */
+PyObject *igraphmodule_Graph_Open_Snapshot(PyTypeObject * type,
+                                           PyObject * args, PyObject * kwds)
+{
+  igraphmodule_GraphObject *self;
+  PyObject *f = NULL, *snapshot;
+  Py_buffer view;
+  igraph_t g;
+
+  static char *kwlist[] = { "f", NULL };
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &f))
+    return NULL;
+
+  if (PyBaseString_Check(f)) {
+    snapshot = igraphmodule_i_Graph_map_file(f);
+    if (snapshot == NULL)
+      return NULL;
+  } else {
+    snapshot = f;
+    Py_INCREF(snapshot);
+  }
+
+  if (igraphmodule_snapshot_to_igraph_t(snapshot, &view, &g)) {
+    Py_DECREF(snapshot);
+    return NULL;
+  }
+
+  CREATE_GRAPH_FROM_TYPE(self, g, type);
+  if (self == NULL) {
+    igraphmodule_snapshot_detach_igraph_t(&g);
+    igraph_destroy(&g);
+    PyBuffer_Release(&view);
+    Py_DECREF(snapshot);
+    return NULL;
+  }
+
+  self->snapshot = snapshot;
+  self->snapshot_view = view;
+
+  return (PyObject *) self;
+}
+
+/** \ingroup python_interface_graph
+ * \brief Reads an edge list from a file and creates a graph from it.
+ * \return the graph
+ * \sa igraph_read_graph_edgelist
+ */
+PyObject *igraphmodule_Graph_Read_Edgelist(PyTypeObject * type,
+                                           PyObject * args, PyObject * kwds)
+{
+  igraphmodule_GraphObject *self;
+  PyObject *directed = Py_True, *fname = NULL;
+  igraphmodule_filehandle_t fobj;
+  igraph_bool_t is_directed;
+  igraph_t g;
+  int retval;
+
+  static char *kwlist[] = { "f", "directed", NULL };
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist,
+                                   &fname, &directed))
+    return NULL;
+
+  is_directed = PyObject_IsTrue(directed);
+
+  if (igraphmodule_filehandle_init(&fobj, fname, "r"))
+    return NULL;
+
+  IGRAPHMODULE_BEGIN_NOGIL(0);
+  retval = igraph_read_graph_edgelist(&g, igraphmodule_filehandle_get(&fobj),
+        0, is_directed);
+  IGRAPHMODULE_END_NOGIL(0);
+
+  if (retval) {
+    igraphmodule_handle_igraph_error();
+    igraphmodule_filehandle_destroy(&fobj);
+    return NULL;
+  }
+
+  igraphmodule_filehandle_destroy(&fobj);
+  CREATE_GRAPH_FROM_TYPE(self, g, type);
+
+  return (PyObject *) self;
+}
+
+/** \ingroup python_interface_graph
+ * \brief Reads an edge list from an NCOL file and creates a graph from it.
+ * \return the graph
+ * \sa igraph_read_graph_ncol
+ */
+PyObject *igraphmodule_Graph_Read_Ncol(PyTypeObject * type, PyObject * args,
+                                       PyObject * kwds)
+{
+  igraphmodule_GraphObject *self;
+  PyObject *names = Py_True, *weights = Py_None, *directed = Py_True;
+  PyObject *fname = NULL;
+  igraphmodule_filehandle_t fobj;
+  igraph_add_weights_t add_weights = IGRAPH_ADD_WEIGHTS_IF_PRESENT;
+  igraph_bool_t use_names, is_directed;
+  igraph_t g;
+  int retval;
+
+  static char *kwlist[] = { "f", "names", "weights", "directed", NULL };
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOO", kwlist,
+                                   &fname, &names, &weights, &directed))
     return NULL;
 
   if (igraphmodule_PyObject_to_add_weights_t(weights, &add_weights))
     return NULL;
 
+  use_names = PyObject_IsTrue(names);
+  is_directed = PyObject_IsTrue(directed);
+
   if (igraphmodule_filehandle_init(&fobj, fname, "r"))
     return NULL;
 
-  if (igraph_read_graph_ncol(&g, igraphmodule_filehandle_get(&fobj), 0,
-      PyObject_IsTrue(names), add_weights,
-      PyObject_IsTrue(directed))) {
+  IGRAPHMODULE_BEGIN_NOGIL(0);
+  retval = igraph_read_graph_ncol(&g, igraphmodule_filehandle_get(&fobj), 0,
+      use_names, add_weights, is_directed);
+  IGRAPHMODULE_END_NOGIL(0);
+
+  if (retval) {
     igraphmodule_handle_igraph_error();
     igraphmodule_filehandle_destroy(&fobj);
     return NULL;
@@ -7797,7 +10581,9 @@ PyObject *igraphmodule_Graph_Read_Lgl(PyTypeObject * type, PyObject * args,
   PyObject *fname = NULL;
   igraphmodule_filehandle_t fobj;
   igraph_add_weights_t add_weights = IGRAPH_ADD_WEIGHTS_IF_PRESENT;
+  igraph_bool_t use_names, is_directed;
   igraph_t g;
+  int retval;
 
   static char *kwlist[] = { "f", "names", "weights", "directed", NULL };
 
@@ -7808,6 +10594,9 @@ PyObject *igraphmodule_Graph_Read_Lgl(PyTypeObject * type, PyObject * args,
   if (igraphmodule_PyObject_to_add_weights_t(weights, &add_weights))
     return NULL;
 
+  use_names = PyObject_IsTrue(names);
+  is_directed = PyObject_IsTrue(directed);
+
   if (kwds && PyDict_Check(kwds) && \
       PyDict_GetItemString(kwds, "directed") == NULL) {
     if (PyErr_Occurred())
@@ -7817,9 +10606,12 @@ PyObject *igraphmodule_Graph_Read_Lgl(PyTypeObject * type, PyObject * args,
   if (igraphmodule_filehandle_init(&fobj, fname, "r"))
     return NULL;
 
-  if (igraph_read_graph_lgl(&g, igraphmodule_filehandle_get(&fobj),
-        PyObject_IsTrue(names), add_weights,
-        PyObject_IsTrue(directed))) {
+  IGRAPHMODULE_BEGIN_NOGIL(0);
+  retval = igraph_read_graph_lgl(&g, igraphmodule_filehandle_get(&fobj),
+        use_names, add_weights, is_directed);
+  IGRAPHMODULE_END_NOGIL(0);
+
+  if (retval) {
     igraphmodule_handle_igraph_error();
     igraphmodule_filehandle_destroy(&fobj);
     return NULL;
@@ -7944,6 +10736,7 @@ PyObject *igraphmodule_Graph_Read_GraphML(PyTypeObject * type,
   long int index = 0;
   igraph_t g;
   igraphmodule_filehandle_t fobj;
+  int retval;
 
   static char *kwlist[] = { "f", "index", NULL };
 
@@ -7953,8 +10746,12 @@ PyObject *igraphmodule_Graph_Read_GraphML(PyTypeObject * type,
   if (igraphmodule_filehandle_init(&fobj, fname, "r"))
     return NULL;
 
-  if (igraph_read_graph_graphml(&g, igraphmodule_filehandle_get(&fobj),
-        (igraph_integer_t) index)) {
+  IGRAPHMODULE_BEGIN_NOGIL(0);
+  retval = igraph_read_graph_graphml(&g, igraphmodule_filehandle_get(&fobj),
+        (igraph_integer_t) index);
+  IGRAPHMODULE_END_NOGIL(0);
+
+  if (retval) {
     igraphmodule_handle_igraph_error();
     igraphmodule_filehandle_destroy(&fobj);
     return NULL;
@@ -8050,6 +10847,109 @@ PyObject *igraphmodule_Graph_write_dot(igraphmodule_GraphObject * self,
   Py_RETURN_NONE;
 }
 
+/** \ingroup python_interface_graph
+ * \brief Writes the graph and its attributes to a file in a compact binary
+ *        format
+ * \return none
+ */
+PyObject *igraphmodule_Graph_write_binary(igraphmodule_GraphObject * self,
+                                          PyObject * args, PyObject * kwds)
+{
+  PyObject *fname = NULL, *compress = Py_False, *data;
+  igraphmodule_filehandle_t fobj;
+  FILE *fp;
+  static char *kwlist[] = { "f", "compress", NULL };
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &fname, &compress))
+    return NULL;
+
+  data = igraphmodule_igraph_t_to_binary(&self->g, PyObject_IsTrue(compress));
+  if (data == 0)
+    return NULL;
+
+  if (igraphmodule_filehandle_init(&fobj, fname, "wb")) {
+    Py_DECREF(data);
+    return NULL;
+  }
+
+  fp = igraphmodule_filehandle_get(&fobj);
+  if (fwrite(PyBytes_AS_STRING(data), 1, PyBytes_GET_SIZE(data), fp) !=
+      (size_t)PyBytes_GET_SIZE(data) || fflush(fp)) {
+    PyErr_SetFromErrno(PyExc_IOError);
+    Py_DECREF(data);
+    igraphmodule_filehandle_destroy(&fobj);
+    return NULL;
+  }
+
+  Py_DECREF(data);
+  igraphmodule_filehandle_destroy(&fobj);
+
+  Py_RETURN_NONE;
+}
+
+/** \ingroup python_interface_graph
+ * \brief Writes the graph and its attributes to a file as a snapshot that
+ *        can be opened with \c Open_Snapshot()
+ * \return none
+ */
+PyObject *igraphmodule_Graph_write_snapshot(igraphmodule_GraphObject * self,
+                                            PyObject * args, PyObject * kwds)
+{
+  PyObject *fname = NULL, *data;
+  igraphmodule_filehandle_t fobj;
+  FILE *fp;
+  static char *kwlist[] = { "f", NULL };
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &fname))
+    return NULL;
+
+  data = igraphmodule_igraph_t_to_snapshot(&self->g);
+  if (data == 0)
+    return NULL;
+
+  if (igraphmodule_filehandle_init(&fobj, fname, "wb")) {
+    Py_DECREF(data);
+    return NULL;
+  }
+
+  fp = igraphmodule_filehandle_get(&fobj);
+  if (fwrite(PyBytes_AS_STRING(data), 1, PyBytes_GET_SIZE(data), fp) !=
+      (size_t)PyBytes_GET_SIZE(data) || fflush(fp)) {
+    PyErr_SetFromErrno(PyExc_IOError);
+    Py_DECREF(data);
+    igraphmodule_filehandle_destroy(&fobj);
+    return NULL;
+  }
+
+  Py_DECREF(data);
+  igraphmodule_filehandle_destroy(&fobj);
+
+  Py_RETURN_NONE;
+}
+
+/** \ingroup python_interface_graph
+ * \brief Opens the file that a graph is written to, using the buffer size
+ *        given by the user
+ * \return 0 if everything was OK, 1 otherwise. An appropriate Python
+ *   exception is raised in this case.
+ */
+static int igraphmodule_i_Graph_open_output(igraphmodule_filehandle_t *fobj,
+    PyObject *fname, PyObject *buffer_size_o) {
+  long int buffer_size = 0;
+
+  if (buffer_size_o != Py_None) {
+    buffer_size = PyInt_AsLong(buffer_size_o);
+    if (buffer_size == -1 && PyErr_Occurred())
+      return 1;
+    if (buffer_size <= 0) {
+      PyErr_SetString(PyExc_ValueError, "buffer size must be positive");
+      return 1;
+    }
+  }
+
+  return igraphmodule_filehandle_init_buffered(fobj, fname, "w", buffer_size);
+}
+
 /** \ingroup python_interface_graph
  * \brief Writes the edge list to a file
  * \return none
@@ -8058,22 +10958,29 @@ PyObject *igraphmodule_Graph_write_dot(igraphmodule_GraphObject * self,
 PyObject *igraphmodule_Graph_write_edgelist(igraphmodule_GraphObject * self,
                                             PyObject * args, PyObject * kwds)
 {
-  PyObject *fname = NULL;
+  PyObject *fname = NULL, *buffer_size_o = Py_None;
   igraphmodule_filehandle_t fobj;
-  static char *kwlist[] = { "f", NULL };
+  static char *kwlist[] = { "f", "buffer_size", NULL };
+  int retval;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &fname))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &fname,
+                                   &buffer_size_o))
     return NULL;
 
-  if (igraphmodule_filehandle_init(&fobj, fname, "w"))
+  if (igraphmodule_i_Graph_open_output(&fobj, fname, buffer_size_o))
     return NULL;
 
-  if (igraph_write_graph_edgelist(&self->g, igraphmodule_filehandle_get(&fobj))) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_write_graph_edgelist(&self->g, igraphmodule_filehandle_get(&fobj));
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraphmodule_handle_igraph_error();
     igraphmodule_filehandle_destroy(&fobj);
     return NULL;
   }
-  igraphmodule_filehandle_destroy(&fobj);
+  if (igraphmodule_filehandle_close(&fobj))
+    return NULL;
 
   Py_RETURN_NONE;
 }
@@ -8088,19 +10995,20 @@ PyObject *igraphmodule_Graph_write_gml(igraphmodule_GraphObject * self,
                                        PyObject * args, PyObject * kwds)
 {
   PyObject *ids = Py_None, *fname = NULL;
-  PyObject *creator = Py_None;
+  PyObject *creator = Py_None, *buffer_size_o = Py_None;
   igraph_vector_t idvec, *idvecptr=0;
   char *creator_str=0;
   igraphmodule_filehandle_t fobj;
 
   static char *kwlist[] = {
-    "f", "creator", "ids", NULL
+    "f", "creator", "ids", "buffer_size", NULL
   };
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OO", kwlist, &fname, &creator, &ids))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOO", kwlist, &fname, &creator,
+                                   &ids, &buffer_size_o))
     return NULL;
 
-  if (igraphmodule_filehandle_init(&fobj, fname, "w"))
+  if (igraphmodule_i_Graph_open_output(&fobj, fname, buffer_size_o))
     return NULL;
 
   if (PyList_Check(ids)) {
@@ -8117,6 +11025,7 @@ PyObject *igraphmodule_Graph_write_gml(igraphmodule_GraphObject * self,
       if (idvecptr)
         igraph_vector_destroy(idvecptr);
       igraphmodule_filehandle_destroy(&fobj);
+      return NULL;
     }
 
     creator_str = PyString_CopyAsString(o);
@@ -8126,22 +11035,23 @@ PyObject *igraphmodule_Graph_write_gml(igraphmodule_GraphObject * self,
       if (idvecptr)
         igraph_vector_destroy(idvecptr);
       igraphmodule_filehandle_destroy(&fobj);
+      return NULL;
     }
   }
 
-  if (igraph_write_graph_gml(&self->g, igraphmodule_filehandle_get(&fobj),
+  if (igraphmodule_write_gml(self, igraphmodule_filehandle_get(&fobj),
         idvecptr, creator_str)) {
     if (idvecptr) { igraph_vector_destroy(idvecptr); }
     if (creator_str)
       free(creator_str);
     igraphmodule_filehandle_destroy(&fobj);
-    igraphmodule_handle_igraph_error();
     return NULL;
   }
   if (idvecptr) { igraph_vector_destroy(idvecptr); }
   if (creator_str)
     free(creator_str);
-  igraphmodule_filehandle_destroy(&fobj);
+  if (igraphmodule_filehandle_close(&fobj))
+    return NULL;
 
   Py_RETURN_NONE;
 }
@@ -8154,27 +11064,33 @@ PyObject *igraphmodule_Graph_write_gml(igraphmodule_GraphObject * self,
 PyObject *igraphmodule_Graph_write_ncol(igraphmodule_GraphObject * self,
                                         PyObject * args, PyObject * kwds)
 {
-  PyObject *fname = NULL;
+  PyObject *fname = NULL, *buffer_size_o = Py_None;
   char *names = "name";
   char *weights = "weight";
   igraphmodule_filehandle_t fobj;
+  int retval;
 
-  static char *kwlist[] = { "f", "names", "weights", NULL };
+  static char *kwlist[] = { "f", "names", "weights", "buffer_size", NULL };
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|zz", kwlist,
-                                   &fname, &names, &weights))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|zzO", kwlist,
+                                   &fname, &names, &weights, &buffer_size_o))
     return NULL;
 
-  if (igraphmodule_filehandle_init(&fobj, fname, "w"))
+  if (igraphmodule_i_Graph_open_output(&fobj, fname, buffer_size_o))
     return NULL;
 
-  if (igraph_write_graph_ncol(&self->g, igraphmodule_filehandle_get(&fobj),
-        names, weights)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_write_graph_ncol(&self->g, igraphmodule_filehandle_get(&fobj),
+      names, weights);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraphmodule_handle_igraph_error();
     igraphmodule_filehandle_destroy(&fobj);
     return NULL;
   }
-  igraphmodule_filehandle_destroy(&fobj);
+  if (igraphmodule_filehandle_close(&fobj))
+    return NULL;
 
   Py_RETURN_NONE;
 }
@@ -8220,22 +11136,29 @@ PyObject *igraphmodule_Graph_write_lgl(igraphmodule_GraphObject * self,
  */
 PyObject *igraphmodule_Graph_write_pajek(igraphmodule_GraphObject * self,
   PyObject * args, PyObject * kwds) {
-  PyObject *fname = NULL;
-  static char *kwlist[] = { "f", NULL };
+  PyObject *fname = NULL, *buffer_size_o = Py_None;
+  static char *kwlist[] = { "f", "buffer_size", NULL };
   igraphmodule_filehandle_t fobj;
+  int retval;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &fname))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &fname,
+                                   &buffer_size_o))
     return NULL;
 
-  if (igraphmodule_filehandle_init(&fobj, fname, "w"))
+  if (igraphmodule_i_Graph_open_output(&fobj, fname, buffer_size_o))
     return NULL;
 
-  if (igraph_write_graph_pajek(&self->g, igraphmodule_filehandle_get(&fobj))) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_write_graph_pajek(&self->g, igraphmodule_filehandle_get(&fobj));
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraphmodule_handle_igraph_error();
     igraphmodule_filehandle_destroy(&fobj);
     return NULL;
   }
-  igraphmodule_filehandle_destroy(&fobj);
+  if (igraphmodule_filehandle_close(&fobj))
+    return NULL;
 
   Py_RETURN_NONE;
 }
@@ -8248,23 +11171,24 @@ PyObject *igraphmodule_Graph_write_pajek(igraphmodule_GraphObject * self,
 PyObject *igraphmodule_Graph_write_graphml(igraphmodule_GraphObject * self,
                                            PyObject * args, PyObject * kwds)
 {
-  PyObject *fname = NULL;
-  static char *kwlist[] = { "f", NULL };
+  PyObject *fname = NULL, *buffer_size_o = Py_None;
+  static char *kwlist[] = { "f", "buffer_size", NULL };
   igraphmodule_filehandle_t fobj;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", kwlist, &fname))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist, &fname,
+                                   &buffer_size_o))
     return NULL;
 
-  if (igraphmodule_filehandle_init(&fobj, fname, "w"))
+  if (igraphmodule_i_Graph_open_output(&fobj, fname, buffer_size_o))
     return NULL;
 
-  if (igraph_write_graph_graphml(&self->g, igraphmodule_filehandle_get(&fobj),
+  if (igraphmodule_write_graphml(self, igraphmodule_filehandle_get(&fobj),
 				 /*prefixattr=*/ 1)) {
-    igraphmodule_handle_igraph_error();
     igraphmodule_filehandle_destroy(&fobj);
     return NULL;
   }
-  igraphmodule_filehandle_destroy(&fobj);
+  if (igraphmodule_filehandle_close(&fobj))
+    return NULL;
 
   Py_RETURN_NONE;
 }
@@ -8354,6 +11278,48 @@ PyObject *igraphmodule_Graph_canonical_permutation(
   return list;
 }
 
+/**
+ * \ingroup python_interface_graph
+ * \brief Returns the canonical form of a graph as a byte string
+ * \sa igraphmodule_canonical_form
+ */
+PyObject *igraphmodule_Graph_canonical_form_bytes(
+    igraphmodule_GraphObject *self, PyObject *args, PyObject *kwds) {
+  static char *kwlist[] = { "sh", "color", NULL };
+  PyObject *sh_o = Py_None;
+  PyObject *color_o = Py_None;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", kwlist, &sh_o, &color_o))
+    return NULL;
+
+  return igraphmodule_Graph_canonical_form(self, sh_o, color_o);
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Returns a 64-bit hash of the canonical form of a graph
+ * \sa igraphmodule_canonical_form
+ */
+PyObject *igraphmodule_Graph_canonical_hash(
+    igraphmodule_GraphObject *self, PyObject *args, PyObject *kwds) {
+  static char *kwlist[] = { "sh", "color", NULL };
+  PyObject *sh_o = Py_None;
+  PyObject *color_o = Py_None;
+  PyObject *form, *result;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", kwlist, &sh_o, &color_o))
+    return NULL;
+
+  form = igraphmodule_Graph_canonical_form(self, sh_o, color_o);
+  if (form == 0)
+    return NULL;
+
+  result = igraphmodule_canonical_form_hash(form);
+  Py_DECREF(form);
+
+  return result;
+}
+
 /** \ingroup python_interface_graph
  * \brief Calculates the isomorphism class of a graph or its subgraph
  * \sa igraph_isoclass, igraph_isoclass_subgraph
@@ -9291,21 +12257,92 @@ PyObject *igraphmodule_Graph_get_subisomorphisms_vf2(igraphmodule_GraphObject *s
 }
 
 /** \ingroup python_interface_graph
- * \brief Determines whether a subgraph of the graph is isomorphic to another graph
- *        using the LAD algorithm.
+ * \brief Returns an iterator over the subisomorphisms of two given graphs
  *
- * \sa igraph_subisomorphic_lad
+ * \sa igraph_subisomorphic_function_vf2
  */
-PyObject *igraphmodule_Graph_subisomorphic_lad(igraphmodule_GraphObject * self,
-                                        PyObject * args, PyObject * kwds)
-{
-  igraph_bool_t result = 0;
-  PyObject *o, *return_mapping=Py_False, *domains_o=Py_None, *induced=Py_False;
-  float time_limit = 0;
+PyObject *igraphmodule_Graph_get_subisomorphisms_vf2_iter(igraphmodule_GraphObject *self,
+  PyObject *args, PyObject *kwds) {
+  PyObject *o;
+  PyObject *color1_o=Py_None, *color2_o=Py_None;
+  PyObject *edge_color1_o=Py_None, *edge_color2_o=Py_None;
+  PyObject *node_compat_fn=Py_None, *edge_compat_fn=Py_None;
+  PyObject *batch_o=Py_None, *max_results_o=Py_None, *time_limit_o=Py_None;
   igraphmodule_GraphObject *other;
-  igraph_vector_ptr_t domains;
-  igraph_vector_ptr_t* p_domains = 0;
-  igraph_vector_t mapping, *map=0;
+  igraphmodule_SearchIterObject *iter;
+
+  static char *kwlist[] = { "other", "color1", "color2", "edge_color1",
+    "edge_color2", "node_compat_fn", "edge_compat_fn", "batch",
+    "max_results", "time_limit", NULL };
+
+  if (!PyArg_ParseTupleAndKeywords
+      (args, kwds, "O!|OOOOOOOOO", kwlist, &igraphmodule_GraphType, &o,
+       &color1_o, &color2_o, &edge_color1_o, &edge_color2_o,
+       &node_compat_fn, &edge_compat_fn, &batch_o, &max_results_o,
+       &time_limit_o))
+    return NULL;
+
+  other=(igraphmodule_GraphObject*)o;
+
+  if (node_compat_fn != Py_None && !PyCallable_Check(node_compat_fn)) {
+    PyErr_SetString(PyExc_TypeError, "node_compat_fn must be None or callable");
+    return NULL;
+  }
+
+  if (edge_compat_fn != Py_None && !PyCallable_Check(edge_compat_fn)) {
+    PyErr_SetString(PyExc_TypeError, "edge_compat_fn must be None or callable");
+    return NULL;
+  }
+
+  iter = (igraphmodule_SearchIterObject*)igraphmodule_SearchIter_new(self,
+      IGRAPHMODULE_SEARCH_SUBISOMORPHISMS_VF2, batch_o, max_results_o,
+      time_limit_o);
+  if (iter == NULL)
+    return NULL;
+
+  Py_INCREF(other);
+  iter->other = other;
+  if (node_compat_fn != Py_None) {
+    Py_INCREF(node_compat_fn);
+    iter->node_compat_fn = node_compat_fn;
+  }
+  if (edge_compat_fn != Py_None) {
+    Py_INCREF(edge_compat_fn);
+    iter->edge_compat_fn = edge_compat_fn;
+  }
+
+  /* The iterator takes care of the color vectors from now on */
+  if (igraphmodule_attrib_to_vector_int_t(color1_o, self, &iter->color1,
+        ATTRIBUTE_TYPE_VERTEX) ||
+      igraphmodule_attrib_to_vector_int_t(color2_o, other, &iter->color2,
+        ATTRIBUTE_TYPE_VERTEX) ||
+      igraphmodule_attrib_to_vector_int_t(edge_color1_o, self, &iter->edge_color1,
+        ATTRIBUTE_TYPE_EDGE) ||
+      igraphmodule_attrib_to_vector_int_t(edge_color2_o, other, &iter->edge_color2,
+        ATTRIBUTE_TYPE_EDGE)) {
+    Py_DECREF(iter);
+    return NULL;
+  }
+
+  return (PyObject*)iter;
+}
+
+/** \ingroup python_interface_graph
+ * \brief Determines whether a subgraph of the graph is isomorphic to another graph
+ *        using the LAD algorithm.
+ *
+ * \sa igraph_subisomorphic_lad
+ */
+PyObject *igraphmodule_Graph_subisomorphic_lad(igraphmodule_GraphObject * self,
+                                        PyObject * args, PyObject * kwds)
+{
+  igraph_bool_t result = 0;
+  PyObject *o, *return_mapping=Py_False, *domains_o=Py_None, *induced=Py_False;
+  float time_limit = 0;
+  igraphmodule_GraphObject *other;
+  igraph_vector_ptr_t domains;
+  igraph_vector_ptr_t* p_domains = 0;
+  igraph_vector_t mapping, *map=0;
 
   static char *kwlist[] = { "pattern", "domains", "induced", "time_limit",
       "return_mapping", NULL };
@@ -9488,6 +12525,9 @@ int igraphmodule_Graph_mp_assign_subscript(igraphmodule_GraphObject * self,
     /* Adjacency matrix representation */
     PyObject *ri, *ci, *attr;
 
+    if (!igraphmodule_Graph_check_not_busy(self))
+      return -1;
+
     if (v == NULL) {
       PyErr_SetString(PyExc_NotImplementedError, "cannot delete parts "
           "of the adjacency matrix of a graph");
@@ -9712,15 +12752,35 @@ PyObject *igraphmodule_Graph_bfs(igraphmodule_GraphObject * self,
 PyObject *igraphmodule_Graph_bfsiter(igraphmodule_GraphObject * self,
                                      PyObject * args, PyObject * kwds)
 {
-  char *kwlist[] = { "vid", "mode", "advanced", NULL };
+  char *kwlist[] = { "vid", "mode", "advanced", "batch", "max_depth", NULL };
   PyObject *root, *adv = Py_False, *mode_o = Py_None;
+  PyObject *batch_o = Py_None, *max_depth_o = Py_None;
   igraph_neimode_t mode = IGRAPH_OUT;
+  igraph_integer_t batch = 0, max_depth = -1;
 
   if (!PyArg_ParseTupleAndKeywords
-      (args, kwds, "O|OO", kwlist, &root, &mode_o, &adv))
+      (args, kwds, "O|OOOO", kwlist, &root, &mode_o, &adv, &batch_o,
+       &max_depth_o))
     return NULL;
   if (igraphmodule_PyObject_to_neimode_t(mode_o, &mode)) return NULL;
-  return igraphmodule_BFSIter_new(self, root, mode, PyObject_IsTrue(adv));
+
+  if (batch_o != Py_None) {
+    if (igraphmodule_PyObject_to_integer_t(batch_o, &batch)) return NULL;
+    if (batch <= 0) {
+      PyErr_SetString(PyExc_ValueError, "batch must be positive");
+      return NULL;
+    }
+  }
+  if (max_depth_o != Py_None) {
+    if (igraphmodule_PyObject_to_integer_t(max_depth_o, &max_depth)) return NULL;
+    if (max_depth < 0) {
+      PyErr_SetString(PyExc_ValueError, "max_depth must be non-negative");
+      return NULL;
+    }
+  }
+
+  return igraphmodule_BFSIter_new(self, root, mode, PyObject_IsTrue(adv),
+      batch, max_depth);
 }
 
 /** \ingroup python_interface_graph
@@ -9791,15 +12851,35 @@ PyObject *igraphmodule_Graph_unfold_tree(igraphmodule_GraphObject * self,
 PyObject *igraphmodule_Graph_dfsiter(igraphmodule_GraphObject * self,
                                      PyObject * args, PyObject * kwds)
 {
-  char *kwlist[] = { "vid", "mode", "advanced", NULL };
+  char *kwlist[] = { "vid", "mode", "advanced", "batch", "max_depth", NULL };
   PyObject *root, *adv = Py_False, *mode_o = Py_None;
+  PyObject *batch_o = Py_None, *max_depth_o = Py_None;
   igraph_neimode_t mode = IGRAPH_OUT;
+  igraph_integer_t batch = 0, max_depth = -1;
 
   if (!PyArg_ParseTupleAndKeywords
-      (args, kwds, "O|OO", kwlist, &root, &mode_o, &adv))
+      (args, kwds, "O|OOOO", kwlist, &root, &mode_o, &adv, &batch_o,
+       &max_depth_o))
     return NULL;
   if (igraphmodule_PyObject_to_neimode_t(mode_o, &mode)) return NULL;
-  return igraphmodule_DFSIter_new(self, root, mode, PyObject_IsTrue(adv));
+
+  if (batch_o != Py_None) {
+    if (igraphmodule_PyObject_to_integer_t(batch_o, &batch)) return NULL;
+    if (batch <= 0) {
+      PyErr_SetString(PyExc_ValueError, "batch must be positive");
+      return NULL;
+    }
+  }
+  if (max_depth_o != Py_None) {
+    if (igraphmodule_PyObject_to_integer_t(max_depth_o, &max_depth)) return NULL;
+    if (max_depth < 0) {
+      PyErr_SetString(PyExc_ValueError, "max_depth must be non-negative");
+      return NULL;
+    }
+  }
+
+  return igraphmodule_DFSIter_new(self, root, mode, PyObject_IsTrue(adv),
+      batch, max_depth);
 }
 
 /**********************************************************************
@@ -9898,6 +12978,7 @@ PyObject *igraphmodule_Graph_maxflow(igraphmodule_GraphObject * self,
   igraph_integer_t v1, v2;
   igraph_vector_t flow, cut, partition;
   igraph_maxflow_stats_t stats;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "ll|O", kwlist,
                                    &vid1, &vid2, &capacity_object))
@@ -9928,8 +13009,12 @@ PyObject *igraphmodule_Graph_maxflow(igraphmodule_GraphObject * self,
     return igraphmodule_handle_igraph_error();
   }
 
-  if (igraph_maxflow(&self->g, &result, &flow, &cut, &partition, 0,
-		     v1, v2, &capacity_vector, &stats)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_maxflow(&self->g, &result, &flow, &cut, &partition, 0,
+      v1, v2, &capacity_vector, &stats);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraph_vector_destroy(&capacity_vector);
     igraph_vector_destroy(&flow);
     igraph_vector_destroy(&cut);
@@ -10036,6 +13121,7 @@ PyObject *igraphmodule_Graph_all_st_mincuts(igraphmodule_GraphObject * self,
   igraph_vector_t capacity_vector;
   PyObject *source_o, *target_o, *capacity_o = Py_None;
   PyObject *cuts_o, *partition1s_o;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOO", kwlist,
                                    &source_o, &target_o, &capacity_o))
@@ -10062,8 +13148,12 @@ PyObject *igraphmodule_Graph_all_st_mincuts(igraphmodule_GraphObject * self,
     return igraphmodule_handle_igraph_error();
   }
 
-  if (igraph_all_st_mincuts(&self->g, &value, &cuts, &partition1s,
-        source, target, &capacity_vector)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_all_st_mincuts(&self->g, &value, &cuts, &partition1s,
+      source, target, &capacity_vector);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraph_vector_ptr_destroy(&cuts);
     igraph_vector_ptr_destroy(&partition1s);
     igraph_vector_destroy(&capacity_vector);
@@ -10274,6 +13364,7 @@ PyObject *igraphmodule_Graph_gomory_hu_tree(igraphmodule_GraphObject * self,
   PyObject *capacity_o = Py_None;
   PyObject *flow_o;
   igraphmodule_GraphObject *tree_o;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &capacity_o))
     return NULL;
@@ -10288,7 +13379,11 @@ PyObject *igraphmodule_Graph_gomory_hu_tree(igraphmodule_GraphObject * self,
     return igraphmodule_handle_igraph_error();
   }
 
-  if (igraph_gomory_hu_tree(&self->g, &tree, &flow_vector, &capacity_vector)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_gomory_hu_tree(&self->g, &tree, &flow_vector, &capacity_vector);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraph_vector_destroy(&flow_vector);
     igraph_vector_destroy(&capacity_vector);
     return igraphmodule_handle_igraph_error();
@@ -10607,6 +13702,7 @@ PyObject *igraphmodule_Graph_cliques(igraphmodule_GraphObject * self,
   long int min_size = 0, max_size = 0;
   long int i, j, n;
   igraph_vector_ptr_t result;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|ll", kwlist,
                                    &min_size, &max_size))
@@ -10617,8 +13713,12 @@ PyObject *igraphmodule_Graph_cliques(igraphmodule_GraphObject * self,
     return NULL;
   }
 
-  if (igraph_cliques(&self->g, &result, (igraph_integer_t) min_size,
-        (igraph_integer_t) max_size)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_cliques(&self->g, &result, (igraph_integer_t) min_size,
+      (igraph_integer_t) max_size);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraph_vector_ptr_destroy(&result);
     return igraphmodule_handle_igraph_error();
   }
@@ -10656,13 +13756,18 @@ PyObject *igraphmodule_Graph_largest_cliques(igraphmodule_GraphObject * self)
   PyObject *list, *item;
   long int i, j, n;
   igraph_vector_ptr_t result;
+  int retval;
 
   if (igraph_vector_ptr_init(&result, 0)) {
     PyErr_SetString(PyExc_MemoryError, "");
     return NULL;
   }
 
-  if (igraph_largest_cliques(&self->g, &result)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_largest_cliques(&self->g, &result);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraph_vector_ptr_destroy(&result);
     return igraphmodule_handle_igraph_error();
   }
@@ -10755,6 +13860,7 @@ PyObject *igraphmodule_Graph_maximal_cliques(igraphmodule_GraphObject * self,
   Py_ssize_t n;
   igraph_vector_ptr_t result;
   igraphmodule_filehandle_t filehandle;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|llO", kwlist, &i, &j, &file))
     return NULL;
@@ -10768,7 +13874,11 @@ PyObject *igraphmodule_Graph_maximal_cliques(igraphmodule_GraphObject * self,
       return NULL;
     }
 
-    if (igraph_maximal_cliques(&self->g, &result, min, max)) {
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    retval = igraph_maximal_cliques(&self->g, &result, min, max);
+    IGRAPHMODULE_END_NOGIL(self);
+
+    if (retval) {
       igraph_vector_ptr_destroy(&result);
       return igraphmodule_handle_igraph_error();
     }
@@ -10810,6 +13920,50 @@ PyObject *igraphmodule_Graph_maximal_cliques(igraphmodule_GraphObject * self,
   }
 }
 
+/** \ingroup python_interface_graph
+ * \brief Creates an iterator over the cliques or maximal cliques of a graph
+ */
+static PyObject *igraphmodule_i_Graph_cliques_iter(igraphmodule_GraphObject * self,
+    PyObject* args, PyObject* kwds, igraphmodule_search_t search) {
+  static char* kwlist[] = { "min", "max", "batch", "max_results",
+    "time_limit", NULL };
+  PyObject *batch_o = Py_None, *max_results_o = Py_None, *time_limit_o = Py_None;
+  long int min_size = 0, max_size = 0;
+  igraphmodule_SearchIterObject *iter;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|llOOO", kwlist,
+        &min_size, &max_size, &batch_o, &max_results_o, &time_limit_o))
+    return NULL;
+
+  iter = (igraphmodule_SearchIterObject*)igraphmodule_SearchIter_new(self,
+      search, batch_o, max_results_o, time_limit_o);
+  if (iter == NULL)
+    return NULL;
+
+  iter->min_size = (igraph_integer_t) min_size;
+  iter->max_size = (igraph_integer_t) max_size;
+
+  return (PyObject*)iter;
+}
+
+/** \ingroup python_interface_graph
+ * \brief Returns an iterator over the cliques of a graph
+ */
+PyObject *igraphmodule_Graph_cliques_iter(igraphmodule_GraphObject * self,
+    PyObject* args, PyObject* kwds) {
+  return igraphmodule_i_Graph_cliques_iter(self, args, kwds,
+      IGRAPHMODULE_SEARCH_CLIQUES);
+}
+
+/** \ingroup python_interface_graph
+ * \brief Returns an iterator over the maximal cliques of a graph
+ */
+PyObject *igraphmodule_Graph_maximal_cliques_iter(igraphmodule_GraphObject * self,
+    PyObject* args, PyObject* kwds) {
+  return igraphmodule_i_Graph_cliques_iter(self, args, kwds,
+      IGRAPHMODULE_SEARCH_MAXIMAL_CLIQUES);
+}
+
 /** \ingroup python_interface_graph
  * \brief Returns the clique number of the graph
  */
@@ -10837,6 +13991,7 @@ PyObject *igraphmodule_Graph_independent_vertex_sets(igraphmodule_GraphObject
   long int min_size = 0, max_size = 0;
   long int i, j, n;
   igraph_vector_ptr_t result;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|ll", kwlist,
                                    &min_size, &max_size))
@@ -10847,8 +14002,12 @@ PyObject *igraphmodule_Graph_independent_vertex_sets(igraphmodule_GraphObject
     return NULL;
   }
 
-  if (igraph_independent_vertex_sets(&self->g, &result,
-        (igraph_integer_t) min_size, (igraph_integer_t) max_size)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_independent_vertex_sets(&self->g, &result,
+      (igraph_integer_t) min_size, (igraph_integer_t) max_size);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraph_vector_ptr_destroy(&result);
     return igraphmodule_handle_igraph_error();
   }
@@ -10888,13 +14047,18 @@ PyObject
   PyObject *list, *item;
   long int i, j, n;
   igraph_vector_ptr_t result;
+  int retval;
 
   if (igraph_vector_ptr_init(&result, 0)) {
     PyErr_SetString(PyExc_MemoryError, "");
     return NULL;
   }
 
-  if (igraph_largest_independent_vertex_sets(&self->g, &result)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_largest_independent_vertex_sets(&self->g, &result);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraph_vector_ptr_destroy(&result);
     return igraphmodule_handle_igraph_error();
   }
@@ -10934,13 +14098,18 @@ PyObject
   PyObject *list, *item;
   long int i, j, n;
   igraph_vector_ptr_t result;
+  int retval;
 
   if (igraph_vector_ptr_init(&result, 0)) {
     PyErr_SetString(PyExc_MemoryError, "");
     return NULL;
   }
 
-  if (igraph_maximal_independent_vertex_sets(&self->g, &result)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_maximal_independent_vertex_sets(&self->g, &result);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraph_vector_ptr_destroy(&result);
     return igraphmodule_handle_igraph_error();
   }
@@ -11001,6 +14170,7 @@ PyObject *igraphmodule_Graph_coreness(igraphmodule_GraphObject * self,
   igraph_neimode_t mode = IGRAPH_ALL;
   igraph_vector_t result;
   PyObject *o, *mode_o = Py_None;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &mode_o))
     return NULL;
@@ -11010,7 +14180,11 @@ PyObject *igraphmodule_Graph_coreness(igraphmodule_GraphObject * self,
   if (igraph_vector_init(&result, igraph_vcount(&self->g)))
     return igraphmodule_handle_igraph_error();
 
-  if (igraph_coreness(&self->g, &result, mode)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_coreness(&self->g, &result, mode);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraph_vector_destroy(&result);
     return igraphmodule_handle_igraph_error();
   }
@@ -11067,10 +14241,14 @@ PyObject *igraphmodule_Graph_community_edge_betweenness(igraphmodule_GraphObject
   igraph_matrix_t merges;
   igraph_vector_t q;
   igraph_vector_t *weights = 0;
+  igraph_bool_t is_directed;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", kwlist, &directed, &weights_o))
     return NULL;
 
+  is_directed = PyObject_IsTrue(directed);
+
   if (igraphmodule_attrib_to_vector_t(weights_o, self, &weights,
 	  ATTRIBUTE_TYPE_EDGE)) return NULL;
 
@@ -11089,15 +14267,19 @@ PyObject *igraphmodule_Graph_community_edge_betweenness(igraphmodule_GraphObject
     return igraphmodule_handle_igraph_error();
   }
 
-  if (igraph_community_edge_betweenness(&self->g,
-        /* removed_edges = */ 0,
-        /* edge_betweenness = */ 0,
-        /* merges = */ &merges,
-        /* bridges = */ 0,
-        /* modularity = */ weights ? 0 : &q,
-        /* membership = */ 0,
-        PyObject_IsTrue(directed),
-        weights)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_community_edge_betweenness(&self->g,
+      /* removed_edges = */ 0,
+      /* edge_betweenness = */ 0,
+      /* merges = */ &merges,
+      /* bridges = */ 0,
+      /* modularity = */ weights ? 0 : &q,
+      /* membership = */ 0,
+      is_directed,
+      weights);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraphmodule_handle_igraph_error();
     if (weights != 0) {
       igraph_vector_destroy(weights); free(weights);
@@ -11220,6 +14402,7 @@ PyObject *igraphmodule_Graph_community_fastgreedy(igraphmodule_GraphObject * sel
   PyObject *ms, *qs, *res, *weights = Py_None;
   igraph_matrix_t merges;
   igraph_vector_t q, *ws=0;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &weights)) {
     return NULL;
@@ -11230,7 +14413,11 @@ PyObject *igraphmodule_Graph_community_fastgreedy(igraphmodule_GraphObject * sel
 
   igraph_matrix_init(&merges, 0, 0);
   igraph_vector_init(&q, 0);
-  if (igraph_community_fastgreedy(&self->g, ws, &merges, &q, 0)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_community_fastgreedy(&self->g, ws, &merges, &q, 0);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     if (ws) {
       igraph_vector_destroy(ws); free(ws);
     }
@@ -11276,6 +14463,7 @@ PyObject *igraphmodule_Graph_community_infomap(igraphmodule_GraphObject * self,
   igraph_vector_t membership;
   PyObject *res = Py_False;
   igraph_real_t codelength;
+  int retval;
 
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOI", kwlist, &e_weights,
@@ -11302,10 +14490,14 @@ PyObject *igraphmodule_Graph_community_infomap(igraphmodule_GraphObject * self,
     return NULL;
   }
 
-  if (igraph_community_infomap(/*in */ &self->g,
-                                    /*e_weight=*/ e_ws, /*v_weight=*/ v_ws,
-                                    /*nb_trials=*/nb_trials,
-                              /*out*/ &membership, &codelength)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_community_infomap(/*in */ &self->g,
+      /*e_weight=*/ e_ws, /*v_weight=*/ v_ws,
+      /*nb_trials=*/nb_trials,
+      /*out*/ &membership, &codelength);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
 	igraphmodule_handle_igraph_error();
 	igraph_vector_destroy(&membership);
     if (e_ws) {
@@ -11350,6 +14542,7 @@ PyObject *igraphmodule_Graph_community_label_propagation(
   PyObject *result;
   igraph_vector_t membership, *ws = 0, *initial = 0;
   igraph_vector_bool_t fixed;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OOO", kwlist, &weights_o, &initial_o, &fixed_o)) {
     return NULL;
@@ -11372,8 +14565,12 @@ PyObject *igraphmodule_Graph_community_label_propagation(
   }
 
   igraph_vector_init(&membership, igraph_vcount(&self->g));
-  if (igraph_community_label_propagation(&self->g, &membership,
-        ws, initial, (fixed_o != Py_None ? &fixed : 0), 0)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_community_label_propagation(&self->g, &membership,
+      ws, initial, (fixed_o != Py_None ? &fixed : 0), 0);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     if (fixed_o != Py_None) igraph_vector_bool_destroy(&fixed);
     if (ws) { igraph_vector_destroy(ws); free(ws); }
     if (initial) { igraph_vector_destroy(initial); free(initial); }
@@ -11403,6 +14600,7 @@ PyObject *igraphmodule_Graph_community_multilevel(igraphmodule_GraphObject *self
   igraph_matrix_t memberships;
   igraph_vector_t membership, modularity;
   igraph_vector_t *ws;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OO", kwlist, &weights, &return_levels)) {
     return NULL;
@@ -11415,8 +14613,12 @@ PyObject *igraphmodule_Graph_community_multilevel(igraphmodule_GraphObject *self
   igraph_vector_init(&membership, 0);
   igraph_vector_init(&modularity, 0);
 
-  if (igraph_community_multilevel(&self->g, ws, &membership, &memberships,
-        &modularity)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_community_multilevel(&self->g, ws, &membership, &memberships,
+      &modularity);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     if (ws) { igraph_vector_destroy(ws); free(ws); }
     igraph_vector_destroy(&membership);
     igraph_vector_destroy(&modularity);
@@ -11514,6 +14716,7 @@ PyObject *igraphmodule_Graph_community_spinglass(igraphmodule_GraphObject *self,
   PyObject *update_rule_o = Py_None;
   PyObject *impl_o = Py_None;
   PyObject *res;
+  int retval;
 
   long int spins = 25;
   double start_temp = 1.0;
@@ -11524,12 +14727,15 @@ PyObject *igraphmodule_Graph_community_spinglass(igraphmodule_GraphObject *self,
   double gamma = 1;
   double lambda = 1;
   igraph_vector_t *weights = 0, membership;
+  igraph_bool_t parupdate;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OlOdddOdOd", kwlist,
         &weights_o, &spins, &parupdate_o, &start_temp, &stop_temp,
         &cool_fact, &update_rule_o, &gamma, &impl_o, &lambda))
     return NULL;
 
+  parupdate = PyObject_IsTrue(parupdate_o);
+
   if (igraphmodule_PyObject_to_spincomm_update_t(update_rule_o, &update_rule)) {
     return NULL;
   }
@@ -11549,11 +14755,15 @@ PyObject *igraphmodule_Graph_community_spinglass(igraphmodule_GraphObject *self,
     return NULL;
   }
 
-  if (igraph_community_spinglass(&self->g, weights,
-              0, 0, &membership, 0, (igraph_integer_t) spins,
-              PyObject_IsTrue(parupdate_o),
-              start_temp, stop_temp, cool_fact,
-              update_rule, gamma, impl, lambda)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_community_spinglass(&self->g, weights,
+      0, 0, &membership, 0, (igraph_integer_t) spins,
+      parupdate,
+      start_temp, stop_temp, cool_fact,
+      update_rule, gamma, impl, lambda);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     igraphmodule_handle_igraph_error();
     igraph_vector_destroy(&membership);
     if (weights != 0) {
@@ -11584,6 +14794,7 @@ PyObject *igraphmodule_Graph_community_walktrap(igraphmodule_GraphObject * self,
   igraph_matrix_t merges;
   int steps=4;
   igraph_vector_t q, *ws=0;
+  int retval;
 
   if (!PyArg_ParseTupleAndKeywords(args, kwds, "|Oi", kwlist, &weights,
       &steps))
@@ -11595,7 +14806,11 @@ PyObject *igraphmodule_Graph_community_walktrap(igraphmodule_GraphObject * self,
   igraph_matrix_init(&merges, 0, 0);
   igraph_vector_init(&q, 0);
 
-  if (igraph_community_walktrap(&self->g, ws, steps, &merges, &q, 0)) {
+  IGRAPHMODULE_BEGIN_NOGIL(self);
+  retval = igraph_community_walktrap(&self->g, ws, steps, &merges, &q, 0);
+  IGRAPHMODULE_END_NOGIL(self);
+
+  if (retval) {
     if (ws) {
       igraph_vector_destroy(ws); free(ws);
     }
@@ -11662,142 +14877,898 @@ PyObject *igraphmodule_Graph_community_leiden(igraphmodule_GraphObject *self,
     error = -1;
   }
 
-  /* Get node weights */
-  if (!error && igraphmodule_attrib_to_vector_t(node_weights_o, self, &node_weights,
-    ATTRIBUTE_TYPE_VERTEX)) {
-    igraphmodule_handle_igraph_error();
-    error = -1;
+  /* Get node weights */
+  if (!error && igraphmodule_attrib_to_vector_t(node_weights_o, self, &node_weights,
+    ATTRIBUTE_TYPE_VERTEX)) {
+    igraphmodule_handle_igraph_error();
+    error = -1;
+  }
+
+  /* Get initial membership */
+  if (!error && igraphmodule_attrib_to_vector_t(initial_membership_o, self, &membership,
+    ATTRIBUTE_TYPE_VERTEX)) {
+    igraphmodule_handle_igraph_error();
+    error = -1;
+  }
+
+  if (!error && membership == 0) {
+    start = 0;
+    membership = (igraph_vector_t*)calloc(1, sizeof(igraph_vector_t));
+    if (membership==0) {
+      PyErr_NoMemory();
+      error = -1;
+    } else {
+      igraph_vector_init(membership, 0);
+    }
+  }
+
+  if (normalize_resolution)
+  {
+    /* If we need to normalize the resolution parameter,
+     * we will need to have node weights. */
+    if (node_weights == 0)
+    {
+      node_weights = (igraph_vector_t*)calloc(1, sizeof(igraph_vector_t));
+      if (node_weights==0) {
+        PyErr_NoMemory();
+        error = -1;
+      } else {
+        igraph_vector_init(node_weights, 0);
+        if (igraph_strength(&self->g, node_weights, igraph_vss_all(), IGRAPH_ALL, 0, edge_weights)) {
+          igraphmodule_handle_igraph_error();
+          error = -1;
+        }
+      }
+    }
+    resolution_parameter /= igraph_vector_sum(node_weights);
+  }
+
+  /* Run actual Leiden algorithm for several iterations. */
+  if (!error) {
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    if (n_iterations >= 0) {
+      for (i = 0; !error && i < n_iterations; i++) {
+        error = igraph_community_leiden(&self->g,
+                                        edge_weights, node_weights,
+                                        resolution_parameter, beta,
+                                        start, membership,
+                                        &nb_clusters, &quality);
+        start = 1;
+      }
+    } else {
+      while (!error && prev_quality < quality) {
+        prev_quality = quality;
+        error = igraph_community_leiden(&self->g,
+                                        edge_weights, node_weights,
+                                        resolution_parameter, beta,
+                                        start, membership,
+                                        &nb_clusters, &quality);
+        start = 1;
+      }
+    }
+    IGRAPHMODULE_END_NOGIL(self);
+  }
+
+  if (edge_weights != 0) {
+    igraph_vector_destroy(edge_weights);
+    free(edge_weights);
+  }
+  if (node_weights != 0) {
+    igraph_vector_destroy(node_weights);
+    free(node_weights);
+  }
+
+  if (!error && membership != 0) {
+    res = igraphmodule_vector_t_to_PyList(membership, IGRAPHMODULE_TYPE_INT);
+  }
+
+  if (membership != 0) {
+    igraph_vector_destroy(membership);
+    free(membership);
+  }
+
+  if (!error)
+  {  return res; }
+  else
+  {  return NULL; }
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Community detection methods supported by \c community_ensemble()
+ */
+typedef enum {
+  IGRAPHMODULE_ENSEMBLE_LEIDEN = 0,
+  IGRAPHMODULE_ENSEMBLE_MULTILEVEL,
+  IGRAPHMODULE_ENSEMBLE_LABEL_PROPAGATION,
+  IGRAPHMODULE_ENSEMBLE_INFOMAP
+} igraphmodule_i_ensemble_method_t;
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Read-only input and the results of an ensemble of community
+ *        detection runs, shared by all the workers
+ */
+typedef struct {
+  const igraph_t *graph;
+  igraphmodule_i_ensemble_method_t method;
+  const igraph_vector_t *weights;
+  const igraph_vector_t *node_weights;
+  igraph_real_t resolution_parameter;
+  igraph_real_t beta;
+  long int n_iterations;
+  long int trials;
+  long int n_runs;
+  long int no_of_workers;
+  unsigned long int seed;
+  // Membership vector of run i is row i of the matrix
+  igraph_matrix_t memberships;
+  igraph_vector_t modularity;
+} igraphmodule_i_ensemble_t;
+
+/**
+ * \ingroup python_interface_graph
+ * \brief A worker of an ensemble; worker \em i carries out runs \em i,
+ *        \em i+k, \em i+2k and so on where \em k is the number of workers
+ */
+typedef struct {
+  igraphmodule_i_ensemble_t *ensemble;
+  long int index;
+  int retval;
+  // Exception raised in the worker thread
+  PyObject *exc_type, *exc_value, *exc_traceback;
+} igraphmodule_i_ensemble_worker_t;
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Carries out the runs of a worker of an ensemble
+ *
+ * Each run uses a Mersenne Twister of its own, seeded from the seed of the
+ * ensemble and the index of the run, so the results do not depend on the
+ * number of workers. The community detection functions of the C core take
+ * no generator argument, so the Mersenne Twister is installed as the
+ * default generator while the runs are carried out; the original default
+ * generator is restored before returning, whether the runs succeeded or
+ * not. Unless the C core was compiled with thread-local storage, the
+ * default generator is shared by all the threads and the caller must hold
+ * the GIL. Does not touch the Python API.
+ *
+ * \return 0 if everything was OK, an igraph error code otherwise
+ */
+static int igraphmodule_i_ensemble_work(igraphmodule_i_ensemble_worker_t *worker) {
+  igraphmodule_i_ensemble_t *ens = worker->ensemble;
+  igraph_rng_t rng, old_default;
+  igraph_vector_t membership;
+  igraph_integer_t nb_clusters;
+  igraph_real_t quality, codelength;
+  long int run, i, j, n = igraph_vcount(ens->graph);
+  int retval;
+
+  retval = igraph_rng_init(&rng, &igraph_rngtype_mt19937);
+  if (retval) {
+    return retval;
+  }
+  retval = igraph_vector_init(&membership, n);
+  if (retval) {
+    igraph_rng_destroy(&rng);
+    return retval;
+  }
+
+  old_default = *igraph_rng_default();
+  igraph_rng_set_default(&rng);
+
+  for (run = worker->index; !retval && run < ens->n_runs; run += ens->no_of_workers) {
+    igraph_rng_seed(&rng, igraphmodule_stream_seed(ens->seed, run));
+
+    switch (ens->method) {
+      case IGRAPHMODULE_ENSEMBLE_LEIDEN:
+        for (i = 0; !retval && i < ens->n_iterations; i++) {
+          retval = igraph_community_leiden(ens->graph, ens->weights,
+              ens->node_weights, ens->resolution_parameter, ens->beta,
+              /* start = */ i > 0, &membership, &nb_clusters, &quality);
+        }
+        break;
+
+      case IGRAPHMODULE_ENSEMBLE_MULTILEVEL:
+        retval = igraph_community_multilevel(ens->graph, ens->weights,
+            &membership, 0, 0);
+        break;
+
+      case IGRAPHMODULE_ENSEMBLE_LABEL_PROPAGATION:
+        retval = igraph_community_label_propagation(ens->graph, &membership,
+            ens->weights, 0, 0, 0);
+        break;
+
+      case IGRAPHMODULE_ENSEMBLE_INFOMAP:
+        retval = igraph_community_infomap(ens->graph, ens->weights, 0,
+            ens->trials, &membership, &codelength);
+        break;
+    }
+
+    if (!retval) {
+      retval = igraph_modularity(ens->graph, &membership,
+          &VECTOR(ens->modularity)[run], ens->weights);
+    }
+    if (!retval) {
+      for (j = 0; j < n; j++) {
+        MATRIX(ens->memberships, run, j) = VECTOR(membership)[j];
+      }
+    }
+  }
+
+  igraph_rng_set_default(&old_default);
+  igraph_vector_destroy(&membership);
+  igraph_rng_destroy(&rng);
+
+  return retval;
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Entry point of the worker threads of an ensemble
+ *
+ * The thread keeps a Python thread state of its own while it is working so
+ * that an exception raised by the error hook of the C core is not lost when
+ * the hook releases the GIL; the exception is moved to the worker when the
+ * work is finished.
+ */
+static void igraphmodule_i_ensemble_thread(void *workers, long int index) {
+  igraphmodule_i_ensemble_worker_t *worker =
+    &((igraphmodule_i_ensemble_worker_t*)workers)[index];
+  PyGILState_STATE gstate;
+  PyThreadState *tstate;
+
+  gstate = PyGILState_Ensure();
+  tstate = PyEval_SaveThread();
+  worker->retval = igraphmodule_i_ensemble_work(worker);
+  PyEval_RestoreThread(tstate);
+  if (worker->retval) {
+    PyErr_Fetch(&worker->exc_type, &worker->exc_value, &worker->exc_traceback);
+  }
+  PyGILState_Release(gstate);
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Runs a stochastic community detection method many times with
+ *        different random seeds, using several threads
+ * \return the memberships and the modularities of the runs
+ */
+PyObject *igraphmodule_Graph_community_ensemble(igraphmodule_GraphObject *self,
+        PyObject *args, PyObject *kwds) {
+  static char *kwlist[] = { "method", "n_runs", "threads", "seed", "weights",
+    "resolution_parameter", "beta", "n_iterations", "trials", NULL };
+  static igraphmodule_enum_translation_table_entry_t method_tt[] = {
+        {"leiden", IGRAPHMODULE_ENSEMBLE_LEIDEN},
+        {"multilevel", IGRAPHMODULE_ENSEMBLE_MULTILEVEL},
+        {"label_propagation", IGRAPHMODULE_ENSEMBLE_LABEL_PROPAGATION},
+        {"infomap", IGRAPHMODULE_ENSEMBLE_INFOMAP},
+        {0,0}
+    };
+  PyObject *method_o = Py_None, *seed_o = Py_None, *weights_o = Py_None;
+  PyObject *memberships_o, *modularity_o;
+  igraphmodule_i_ensemble_t ens;
+  igraphmodule_i_ensemble_worker_t *workers;
+  igraph_vector_t *weights = 0, node_weights;
+  igraph_bool_t has_node_weights = 0;
+  long int i, threads = 1;
+  int retval = 0, failed;
+
+  ens.method = IGRAPHMODULE_ENSEMBLE_MULTILEVEL;
+  ens.n_runs = 50;
+  ens.resolution_parameter = 1.0;
+  ens.beta = 0.01;
+  ens.n_iterations = 2;
+  ens.trials = 10;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OllOOddll", kwlist,
+        &method_o, &ens.n_runs, &threads, &seed_o, &weights_o,
+        &ens.resolution_parameter, &ens.beta, &ens.n_iterations, &ens.trials))
+    return NULL;
+
+  if (igraphmodule_PyObject_to_enum(method_o, method_tt, (int*)&ens.method))
+    return NULL;
+
+  if (ens.n_runs < 0) {
+    PyErr_SetString(PyExc_ValueError, "n_runs must be non-negative");
+    return NULL;
+  }
+  if (threads <= 0) {
+    PyErr_SetString(PyExc_ValueError, "threads must be positive");
+    return NULL;
+  }
+  if (ens.n_iterations <= 0) {
+    PyErr_SetString(PyExc_ValueError, "n_iterations must be positive");
+    return NULL;
+  }
+  if (ens.trials <= 0) {
+    PyErr_SetString(PyExc_ValueError, "trials must be positive");
+    return NULL;
+  }
+
+  if (seed_o == Py_None) {
+    ens.seed = (unsigned long int) igraph_rng_get_integer(igraph_rng_default(),
+        0, 0x7fffffffL);
+  } else {
+    ens.seed = PyLong_AsUnsignedLongMask(seed_o);
+    if (PyErr_Occurred())
+      return NULL;
+  }
+
+  if (igraphmodule_attrib_to_vector_t(weights_o, self, &weights,
+      ATTRIBUTE_TYPE_EDGE))
+    return NULL;
+
+  /* Leiden optimizes modularity; this needs the strengths of the vertices
+   * as node weights and a resolution normalized by their sum */
+  if (ens.method == IGRAPHMODULE_ENSEMBLE_LEIDEN) {
+    if (igraph_vector_init(&node_weights, 0)) {
+      if (weights) { igraph_vector_destroy(weights); free(weights); }
+      return igraphmodule_handle_igraph_error();
+    }
+    if (igraph_strength(&self->g, &node_weights, igraph_vss_all(), IGRAPH_ALL,
+          IGRAPH_LOOPS, weights)) {
+      igraph_vector_destroy(&node_weights);
+      if (weights) { igraph_vector_destroy(weights); free(weights); }
+      return igraphmodule_handle_igraph_error();
+    }
+    has_node_weights = 1;
+    ens.resolution_parameter /= igraph_vector_sum(&node_weights);
+  }
+
+  ens.graph = &self->g;
+  ens.weights = weights;
+  ens.node_weights = has_node_weights ? &node_weights : 0;
+
+  if (igraph_matrix_init(&ens.memberships, ens.n_runs, igraph_vcount(&self->g))) {
+    if (has_node_weights) igraph_vector_destroy(&node_weights);
+    if (weights) { igraph_vector_destroy(weights); free(weights); }
+    return igraphmodule_handle_igraph_error();
+  }
+  if (igraph_vector_init(&ens.modularity, ens.n_runs)) {
+    igraph_matrix_destroy(&ens.memberships);
+    if (has_node_weights) igraph_vector_destroy(&node_weights);
+    if (weights) { igraph_vector_destroy(weights); free(weights); }
+    return igraphmodule_handle_igraph_error();
+  }
+
+  /* The runs can only be carried out in parallel if the error handling
+   * of the C core is thread-local */
+  if (!IGRAPHMODULE_CORE_IS_THREAD_SAFE) {
+    threads = 1;
+  }
+  if (threads > ens.n_runs) {
+    threads = ens.n_runs > 0 ? ens.n_runs : 1;
+  }
+  ens.no_of_workers = threads;
+
+  workers = (igraphmodule_i_ensemble_worker_t*)calloc(threads,
+      sizeof(igraphmodule_i_ensemble_worker_t));
+  if (!workers) {
+    retval = 1;
+    PyErr_NoMemory();
+  }
+  for (i = 0; !retval && i < threads; i++) {
+    workers[i].ensemble = &ens;
+    workers[i].index = i;
+  }
+
+  if (!retval && !IGRAPHMODULE_CORE_IS_THREAD_SAFE) {
+    /* The default random number generator replaced by the runs is shared
+     * with all the other threads, so the GIL is kept */
+    self->busy++;
+    retval = igraphmodule_i_ensemble_work(&workers[0]);
+    self->busy--;
+  } else if (!retval) {
+    /* The GIL must be released unconditionally here since the workers may
+     * need it to report errors */
+    self->busy++;
+    Py_BEGIN_ALLOW_THREADS
+    igraphmodule_run_workers(igraphmodule_i_ensemble_thread, workers,
+        threads, threads);
+    Py_END_ALLOW_THREADS
+    self->busy--;
+
+    for (i = 0; i < threads; i++) {
+      failed = workers[i].retval != 0;
+      if (failed && workers[i].exc_type && !PyErr_Occurred()) {
+        PyErr_Restore(workers[i].exc_type, workers[i].exc_value,
+            workers[i].exc_traceback);
+      } else {
+        Py_XDECREF(workers[i].exc_type);
+        Py_XDECREF(workers[i].exc_value);
+        Py_XDECREF(workers[i].exc_traceback);
+      }
+      if (failed) {
+        retval = 1;
+      }
+    }
+  }
+
+  free(workers);
+  if (has_node_weights) igraph_vector_destroy(&node_weights);
+  if (weights) { igraph_vector_destroy(weights); free(weights); }
+
+  if (retval) {
+    igraph_matrix_destroy(&ens.memberships);
+    igraph_vector_destroy(&ens.modularity);
+    return igraphmodule_handle_igraph_error();
+  }
+
+  memberships_o = igraphmodule_Buffer_from_matrix_t(&ens.memberships);
+  igraph_matrix_destroy(&ens.memberships);
+  modularity_o = igraphmodule_Buffer_from_vector_t(&ens.modularity);
+  igraph_vector_destroy(&ens.modularity);
+  if (!memberships_o || !modularity_o) {
+    Py_XDECREF(memberships_o);
+    Py_XDECREF(modularity_o);
+    return NULL;
+  }
+
+  return Py_BuildValue("NN", memberships_o, modularity_o);
+}
+
+/**********************************************************************
+ * Random walks                                                       *
+ **********************************************************************/
+
+/**
+ * Simple random walk of a given length
+ */
+PyObject *igraphmodule_Graph_random_walk(igraphmodule_GraphObject * self,
+  PyObject * args, PyObject * kwds) {
+  static char *kwlist[] = { "start", "steps", "mode", "stuck", NULL };
+  PyObject *start_o, *mode_o = Py_None, *stuck_o = Py_None, *res;
+  igraph_integer_t start;
+  int steps=10;
+  igraph_neimode_t mode = IGRAPH_OUT;
+  igraph_random_walk_stuck_t stuck = IGRAPH_RANDOM_WALK_STUCK_RETURN;
+  igraph_vector_t walk;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OiOO", kwlist, &start_o,
+		&steps, &mode_o, &stuck_o))
+    return NULL;
+
+  if (igraphmodule_PyObject_to_vid(start_o, &start, &self->g))
+	return NULL;
+
+  if (igraphmodule_PyObject_to_neimode_t(mode_o, &mode))
+	return NULL;
+
+  if (igraphmodule_PyObject_to_random_walk_stuck_t(stuck_o, &stuck))
+	return NULL;
+
+  if (igraph_vector_init(&walk, steps))
+	return igraphmodule_handle_igraph_error();
+
+  if (igraph_random_walk(&self->g, &walk, start, mode, steps, stuck)) {
+	igraph_vector_destroy(&walk);
+	return igraphmodule_handle_igraph_error();
+  }
+
+  res = igraphmodule_vector_t_to_PyList(&walk, IGRAPHMODULE_TYPE_INT);
+  igraph_vector_destroy(&walk);
+
+  return res;
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Number of consecutive walks drawn from the same random stream
+ *        by \c random_walks()
+ */
+#define IGRAPHMODULE_WALKS_BLOCK_SIZE 256
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Read-only input and the output of a batch of random walks, shared
+ *        by all the workers
+ */
+typedef struct {
+  // Adjacency lists in the direction of the walks. Walks in both
+  // directions of a directed graph use the out-lists and the in-lists, so
+  // that each neighbor is found next to the edge leading to it; adj[1] is a
+  // null pointer otherwise
+  igraphmodule_adjacency_t *adj[2];
+  // Alias tables of the transitions, null pointers if they are uniform. The
+  // transitions from vertex v start at index first(v) = adj[0]->offsets[v]
+  // + adj[1]->offsets[v]; alias[first(v)] is -1 if all the edges of v
+  // have zero weight
+  double *prob;
+  long int *alias;
+  // Start vertices; walk i starts from starts[i / walks_per_node]
+  igraph_vector_t starts;
+  long int steps;
+  long int walks_per_node;
+  long int no_of_walks;
+  long int no_of_workers;
+  unsigned long int seed;
+  // Vertex t of walk i is walks[i * steps + t]
+  PY_LONG_LONG *walks;
+} igraphmodule_i_walks_t;
+
+/**
+ * \ingroup python_interface_graph
+ * \brief A worker of a batch of random walks; worker \em i generates blocks
+ *        \em i, \em i+k, \em i+2k and so on where \em k is the number of
+ *        workers
+ */
+typedef struct {
+  igraphmodule_i_walks_t *walks;
+  long int index;
+  igraph_rng_t rng;
+  igraph_bool_t has_rng;
+  // Whether any of the walks of the worker got stuck
+  igraph_bool_t stuck;
+} igraphmodule_i_walks_worker_t;
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Index of the first transition from a vertex in the alias tables
+ */
+static long int igraphmodule_i_walks_first(const igraphmodule_i_walks_t *w,
+    long int v) {
+  return w->adj[0]->offsets[v] + (w->adj[1] ? w->adj[1]->offsets[v] : 0);
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Takes the adjacency lists and builds the alias tables of a batch
+ *        of random walks
+ *
+ * The alias tables are built with Vose's method so that a weighted
+ * transition can be sampled in constant time. Edges with zero weight are
+ * never followed.
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+static int igraphmodule_i_walks_init_transitions(igraphmodule_i_walks_t *w,
+    const igraph_t *graph, const igraph_vector_t *weights, igraph_neimode_t mode) {
+  const igraphmodule_adjacency_t *adj;
+  long int i, j, k, v, d, first, positive, max_degree = 0;
+  long int no_of_nodes = igraph_vcount(graph), no_of_edges = igraph_ecount(graph);
+  long int no_of_entries;
+  long int *small = 0, *large = 0;
+  double *scaled = 0;
+
+  if (weights) {
+    if (igraph_vector_size(weights) != no_of_edges) {
+      PyErr_SetString(PyExc_ValueError, "weight vector length must match "
+          "the number of edges");
+      return 1;
+    }
+    for (i = 0; i < no_of_edges; i++) {
+      if (!(VECTOR(*weights)[i] >= 0) || !igraph_finite(VECTOR(*weights)[i])) {
+        PyErr_SetString(PyExc_ValueError, "weights must be finite and non-negative");
+        return 1;
+      }
+    }
+  }
+
+  if (!igraph_is_directed(graph)) {
+    mode = IGRAPH_ALL;
+  } else if (mode == IGRAPH_ALL) {
+    w->adj[1] = igraphmodule_acquire_adjacency(graph, IGRAPH_IN);
+    if (!w->adj[1]) {
+      return 1;
+    }
+    mode = IGRAPH_OUT;
+  }
+  w->adj[0] = igraphmodule_acquire_adjacency(graph, mode);
+  if (!w->adj[0]) {
+    return 1;
+  }
+
+  if (!weights)
+    return 0;
+
+  no_of_entries = igraphmodule_i_walks_first(w, no_of_nodes);
+  for (v = 0; v < no_of_nodes; v++) {
+    d = igraphmodule_i_walks_first(w, v + 1) - igraphmodule_i_walks_first(w, v);
+    if (d > max_degree) max_degree = d;
+  }
+
+  w->prob = (double*)calloc(no_of_entries > 0 ? no_of_entries : 1, sizeof(double));
+  w->alias = (long int*)calloc(no_of_entries > 0 ? no_of_entries : 1, sizeof(long int));
+  scaled = (double*)calloc(max_degree > 0 ? max_degree : 1, sizeof(double));
+  small = (long int*)calloc(max_degree > 0 ? max_degree : 1, sizeof(long int));
+  large = (long int*)calloc(max_degree > 0 ? max_degree : 1, sizeof(long int));
+  if (!w->prob || !w->alias || !scaled || !small || !large) {
+    free(scaled); free(small); free(large);
+    PyErr_NoMemory();
+    return 1;
+  }
+
+  for (v = 0; v < no_of_nodes; v++) {
+    /* The weights are kept in prob until the alias table is built */
+    first = igraphmodule_i_walks_first(w, v);
+    d = 0;
+    for (k = 0; k < 2 && w->adj[k]; k++) {
+      adj = w->adj[k];
+      for (j = adj->offsets[v]; j < adj->offsets[v + 1]; j++) {
+        w->prob[first + d++] = VECTOR(*weights)[adj->edges[j]];
+      }
+    }
+
+    positive = -1;
+    for (j = 0; j < d; j++) {
+      if (positive < 0 && w->prob[first + j] > 0) {
+        positive = j;
+      }
+    }
+    if (d == 0) {
+      continue;
+    }
+    if (positive < 0) {
+      w->alias[first] = -1;
+      continue;
+    }
+
+    igraphmodule_alias_table(d, w->prob + first, w->alias + first,
+        scaled, small, large);
+    /* Rounding errors may leave a zero-weight edge with a probability of
+     * one; the edges in the adjacency lists cannot simply be left out */
+    for (j = 0; j < d; j++) {
+      if (w->alias[first + j] == j && scaled[j] == 0) {
+        w->prob[first + j] = 0;
+        w->alias[first + j] = positive;
+      }
+    }
+  }
+
+  free(scaled);
+  free(small);
+  free(large);
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Generates the walks of a worker of a batch of random walks
+ *
+ * Each block of walks uses a random stream of its own, seeded from the
+ * seed of the batch and the index of the block, so the walks do not depend
+ * on the number of workers. Neither the Python API nor the error handling
+ * of the C core is used here.
+ */
+static void igraphmodule_i_walks_work(void *workers, long int index) {
+  igraphmodule_i_walks_worker_t *worker =
+    &((igraphmodule_i_walks_worker_t*)workers)[index];
+  igraphmodule_i_walks_t *w = worker->walks;
+  igraph_rng_t *rng = &worker->rng;
+  long int block, i, i_end, t, v, j, d, d0, first;
+
+  for (block = worker->index;
+      block * IGRAPHMODULE_WALKS_BLOCK_SIZE < w->no_of_walks;
+      block += w->no_of_workers) {
+    igraph_rng_seed(rng, igraphmodule_stream_seed(w->seed, block));
+
+    i = block * IGRAPHMODULE_WALKS_BLOCK_SIZE;
+    i_end = i + IGRAPHMODULE_WALKS_BLOCK_SIZE;
+    if (i_end > w->no_of_walks) {
+      i_end = w->no_of_walks;
+    }
+
+    for (; i < i_end; i++) {
+      v = (long int) VECTOR(w->starts)[i / w->walks_per_node];
+      for (t = 0; t < w->steps; t++) {
+        if (t > 0) {
+          first = igraphmodule_i_walks_first(w, v);
+          d = igraphmodule_i_walks_first(w, v + 1) - first;
+          if (d == 0 || (w->alias && w->alias[first] < 0)) {
+            worker->stuck = 1;
+            for (; t < w->steps; t++) {
+              w->walks[i * w->steps + t] = -1;
+            }
+            break;
+          }
+          j = (long int) igraph_rng_get_integer(rng, 0, d - 1);
+          if (w->prob && igraph_rng_get_unif01(rng) >= w->prob[first + j]) {
+            j = w->alias[first + j];
+          }
+          d0 = IGRAPHMODULE_ADJACENCY_DEGREE(w->adj[0], v);
+          v = (j < d0) ? w->adj[0]->neighbors[w->adj[0]->offsets[v] + j] :
+            w->adj[1]->neighbors[w->adj[1]->offsets[v] + j - d0];
+        }
+        w->walks[i * w->steps + t] = v;
+      }
+    }
+  }
+}
+
+/**
+ * Many random walks of a given length, generated by several threads
+ */
+PyObject *igraphmodule_Graph_random_walks(igraphmodule_GraphObject * self,
+  PyObject * args, PyObject * kwds) {
+  static char *kwlist[] = { "starts", "steps", "walks_per_node", "mode",
+    "stuck", "weights", "threads", "seed", NULL };
+  PyObject *starts_o = Py_None, *mode_o = Py_None, *stuck_o = Py_None;
+  PyObject *weights_o = Py_None, *seed_o = Py_None, *result = 0;
+  igraph_neimode_t mode = IGRAPH_OUT;
+  igraph_random_walk_stuck_t stuck = IGRAPH_RANDOM_WALK_STUCK_RETURN;
+  igraph_vector_t *weights = 0;
+  igraph_vs_t vs;
+  igraphmodule_i_walks_t w;
+  igraphmodule_i_walks_worker_t *workers = 0;
+  long int i, no_of_blocks, threads = 1;
+  igraph_bool_t any_stuck = 0;
+  int retval = 0;
+
+  w.steps = 10;
+  w.walks_per_node = 1;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OllOOOlO", kwlist, &starts_o,
+        &w.steps, &w.walks_per_node, &mode_o, &stuck_o, &weights_o,
+        &threads, &seed_o))
+    return NULL;
+
+  if (w.steps < 0) {
+    PyErr_SetString(PyExc_ValueError, "steps must be non-negative");
+    return NULL;
+  }
+  if (w.walks_per_node < 0) {
+    PyErr_SetString(PyExc_ValueError, "walks_per_node must be non-negative");
+    return NULL;
+  }
+  if (threads <= 0) {
+    PyErr_SetString(PyExc_ValueError, "threads must be positive");
+    return NULL;
+  }
+
+  if (igraphmodule_PyObject_to_neimode_t(mode_o, &mode))
+    return NULL;
+
+  if (igraphmodule_PyObject_to_random_walk_stuck_t(stuck_o, &stuck))
+    return NULL;
+
+  if (seed_o == Py_None) {
+    w.seed = (unsigned long int) igraph_rng_get_integer(igraph_rng_default(),
+        0, 0x7fffffffL);
+  } else {
+    w.seed = PyLong_AsUnsignedLongMask(seed_o);
+    if (PyErr_Occurred())
+      return NULL;
+  }
+
+  if (igraphmodule_PyObject_to_vs_t(starts_o, &vs, &self->g, 0, 0))
+    return NULL;
+  if (igraph_vector_init(&w.starts, 0)) {
+    igraph_vs_destroy(&vs);
+    return igraphmodule_handle_igraph_error();
+  }
+  if (igraph_vs_as_vector(&self->g, vs, &w.starts)) {
+    igraph_vector_destroy(&w.starts);
+    igraph_vs_destroy(&vs);
+    return igraphmodule_handle_igraph_error();
   }
+  igraph_vs_destroy(&vs);
 
-  /* Get initial membership */
-  if (!error && igraphmodule_attrib_to_vector_t(initial_membership_o, self, &membership,
-    ATTRIBUTE_TYPE_VERTEX)) {
-    igraphmodule_handle_igraph_error();
-    error = -1;
+  if (igraphmodule_attrib_to_vector_t(weights_o, self, &weights,
+      ATTRIBUTE_TYPE_EDGE)) {
+    igraph_vector_destroy(&w.starts);
+    return NULL;
   }
 
-  if (!error && membership == 0) {
-    start = 0;
-    membership = (igraph_vector_t*)calloc(1, sizeof(igraph_vector_t));
-    if (membership==0) {
-      PyErr_NoMemory();
-      error = -1;
+  w.adj[0] = w.adj[1] = 0;
+  w.prob = 0;
+  w.alias = 0;
+  w.no_of_walks = igraph_vector_size(&w.starts) * w.walks_per_node;
+  retval = igraphmodule_i_walks_init_transitions(&w, &self->g, weights, mode);
+  if (weights) { igraph_vector_destroy(weights); free(weights); }
+
+  if (!retval) {
+    result = igraphmodule_Column_New(IGRAPHMODULE_COLUMN_INT,
+        w.no_of_walks * w.steps);
+    if (!result || igraphmodule_Column_reshape(
+          (igraphmodule_ColumnObject*) result, w.no_of_walks, w.steps)) {
+      retval = 1;
     } else {
-      igraph_vector_init(membership, 0);
+      w.walks = (PY_LONG_LONG*) ((igraphmodule_ColumnObject*) result)->data;
     }
   }
 
-  if (normalize_resolution)
-  {
-    /* If we need to normalize the resolution parameter,
-     * we will need to have node weights. */
-    if (node_weights == 0)
-    {
-      node_weights = (igraph_vector_t*)calloc(1, sizeof(igraph_vector_t));
-      if (node_weights==0) {
-        PyErr_NoMemory();
-        error = -1;
-      } else {
-        igraph_vector_init(node_weights, 0);
-        if (igraph_strength(&self->g, node_weights, igraph_vss_all(), IGRAPH_ALL, 0, edge_weights)) {
-          igraphmodule_handle_igraph_error();
-          error = -1;
-        }
-      }
-    }
-    resolution_parameter /= igraph_vector_sum(node_weights);
+  no_of_blocks = (w.no_of_walks + IGRAPHMODULE_WALKS_BLOCK_SIZE - 1) /
+    IGRAPHMODULE_WALKS_BLOCK_SIZE;
+  if (threads > no_of_blocks) {
+    threads = no_of_blocks > 0 ? no_of_blocks : 1;
   }
+  w.no_of_workers = threads;
 
-  /* Run actual Leiden algorithm for several iterations. */
-  if (!error) {
-    if (n_iterations >= 0) {
-      for (i = 0; !error && i < n_iterations; i++) {
-        error = igraph_community_leiden(&self->g,
-                                        edge_weights, node_weights,
-                                        resolution_parameter, beta,
-                                        start, membership,
-                                        &nb_clusters, &quality);
-        start = 1;
-      }
-    } else {
-      while (!error && prev_quality < quality) {
-        prev_quality = quality;
-        error = igraph_community_leiden(&self->g,
-                                        edge_weights, node_weights,
-                                        resolution_parameter, beta,
-                                        start, membership,
-                                        &nb_clusters, &quality);
-        start = 1;
-      }
+  if (!retval) {
+    workers = (igraphmodule_i_walks_worker_t*)calloc(threads,
+        sizeof(igraphmodule_i_walks_worker_t));
+    if (!workers) {
+      retval = 1;
+      PyErr_NoMemory();
     }
   }
-
-  if (edge_weights != 0) {
-    igraph_vector_destroy(edge_weights);
-    free(edge_weights);
-  }
-  if (node_weights != 0) {
-    igraph_vector_destroy(node_weights);
-    free(node_weights);
+  for (i = 0; !retval && i < threads; i++) {
+    workers[i].walks = &w;
+    workers[i].index = i;
+    if (igraph_rng_init(&workers[i].rng, &igraph_rngtype_mt19937)) {
+      retval = 1;
+      igraphmodule_handle_igraph_error();
+      break;
+    }
+    workers[i].has_rng = 1;
+  }
+
+  if (!retval && threads == 1) {
+    IGRAPHMODULE_BEGIN_NOGIL(self);
+    igraphmodule_i_walks_work(workers, 0);
+    IGRAPHMODULE_END_NOGIL(self);
+  } else if (!retval) {
+    /* The workers do not use the error handling of the C core, hence they
+     * may run in parallel even if it is not thread-local */
+    self->busy++;
+    Py_BEGIN_ALLOW_THREADS
+    igraphmodule_run_workers(igraphmodule_i_walks_work, workers, threads, threads);
+    Py_END_ALLOW_THREADS
+    self->busy--;
+  }
+
+  for (i = 0; workers && i < threads; i++) {
+    if (workers[i].stuck) {
+      any_stuck = 1;
+    }
+    if (workers[i].has_rng) {
+      igraph_rng_destroy(&workers[i].rng);
+    }
   }
+  free(workers);
+  if (w.adj[0]) igraphmodule_adjacency_decref(w.adj[0]);
+  if (w.adj[1]) igraphmodule_adjacency_decref(w.adj[1]);
+  free(w.prob);
+  free(w.alias);
+  igraph_vector_destroy(&w.starts);
 
-  if (!error && membership != 0) {
-    res = igraphmodule_vector_t_to_PyList(membership, IGRAPHMODULE_TYPE_INT);
+  if (!retval && any_stuck && stuck == IGRAPH_RANDOM_WALK_STUCK_ERROR) {
+    PyErr_SetString(igraphmodule_InternalError, "Random walk got stuck");
+    retval = 1;
   }
 
-  if (membership != 0) {
-    igraph_vector_destroy(membership);
-    free(membership);
+  if (retval) {
+    Py_XDECREF(result);
+    return NULL;
   }
 
-  if (!error)
-  {  return res; }
-  else
-  {  return NULL; }
+  return result;
 }
 
 /**********************************************************************
- * Random walks                                                       *
+ * Memory accounting                                                  *
  **********************************************************************/
 
-/**
- * Simple random walk of a given length
+/** \ingroup python_interface_graph
+ * \brief Returns the breakdown of the memory used by the graph
+ * \return a new dict
  */
-PyObject *igraphmodule_Graph_random_walk(igraphmodule_GraphObject * self,
-  PyObject * args, PyObject * kwds) {
-  static char *kwlist[] = { "start", "steps", "mode", "stuck", NULL };
-  PyObject *start_o, *mode_o = Py_None, *stuck_o = Py_None, *res;
-  igraph_integer_t start;
-  int steps=10;
-  igraph_neimode_t mode = IGRAPH_OUT;
-  igraph_random_walk_stuck_t stuck = IGRAPH_RANDOM_WALK_STUCK_RETURN;
-  igraph_vector_t walk;
+PyObject *igraphmodule_Graph_memory_usage(igraphmodule_GraphObject * self,
+                                          PyObject * args, PyObject * kwds)
+{
+  static char *kwlist[] = { "deep", NULL };
+  PyObject *deep_o = Py_True;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|OiOO", kwlist, &start_o,
-		&steps, &mode_o, &stuck_o))
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &deep_o))
     return NULL;
 
-  if (igraphmodule_PyObject_to_vid(start_o, &start, &self->g))
-	return NULL;
-
-  if (igraphmodule_PyObject_to_neimode_t(mode_o, &mode))
-	return NULL;
-
-  if (igraphmodule_PyObject_to_random_walk_stuck_t(stuck_o, &stuck))
-	return NULL;
-
-  if (igraph_vector_init(&walk, steps))
-	return igraphmodule_handle_igraph_error();
+  return igraphmodule_Graph_memory_usage_dict(self, PyObject_IsTrue(deep_o));
+}
 
-  if (igraph_random_walk(&self->g, &walk, start, mode, steps, stuck)) {
-	igraph_vector_destroy(&walk);
-	return igraphmodule_handle_igraph_error();
-  }
+/** \ingroup python_interface_graph
+ * \brief Returns the number of bytes used by the graph, for \c sys.getsizeof()
+ */
+PyObject *igraphmodule_Graph___sizeof__(igraphmodule_GraphObject * self)
+{
+  Py_ssize_t size = igraphmodule_Graph_memory_usage_total(self);
 
-  res = igraphmodule_vector_t_to_PyList(&walk, IGRAPHMODULE_TYPE_INT);
-  igraph_vector_destroy(&walk);
+  if (size < 0)
+    return NULL;
 
-  return res;
+  return PyLong_FromSsize_t(size);
 }
 
 /**********************************************************************
@@ -11836,6 +15807,36 @@ PyObject *igraphmodule_Graph__raw_pointer(igraphmodule_GraphObject *self) {
   return PyInt_FromLong((long int)&self->g);
 }
 
+/** \ingroup python_interface_internal
+ * \brief Returns the graph and its attributes in the binary format of
+ *        \c write_binary(), for pickling
+ * \return a new bytes object
+ */
+PyObject *igraphmodule_Graph___getstate__(igraphmodule_GraphObject * self) {
+  return igraphmodule_igraph_t_to_binary(&self->g, 0);
+}
+
+/** \ingroup python_interface_internal
+ * \brief Replaces the graph and its attributes with the ones stored in the
+ *        given binary data, for unpickling
+ * \return none
+ */
+PyObject *igraphmodule_Graph___setstate__(igraphmodule_GraphObject * self,
+                                          PyObject * state) {
+  igraph_t g;
+
+  if (!igraphmodule_Graph_check_not_busy(self))
+    return NULL;
+
+  if (igraphmodule_binary_to_igraph_t(state, &g))
+    return NULL;
+
+  igraph_destroy(&self->g);
+  self->g = g;
+
+  Py_RETURN_NONE;
+}
+
 /** \ingroup python_interface_internal
  * \brief Registers a destructor to be called when the object is destroyed
  * \return the previous destructor (if any)
@@ -11871,6 +15872,71 @@ PyObject *igraphmodule_Graph___register_destructor__(igraphmodule_GraphObject
  */
 #define OFF(x) offsetof(igraphmodule_GraphObject, x)
 
+/** \ingroup python_interface
+ * Documentation of the options of the parallel random graph generator,
+ * shared by the generators supporting it
+ */
+#define IGRAPHMODULE_PARALLEL_GENERATOR_DOC \
+   "@param threads: the number of threads generating the edges. If any of\n" \
+   "  C{threads}, C{seed} or C{file} is given, the edges are created by a\n" \
+   "  parallel generator that does not use the random number generator of\n" \
+   "  Python. It divides the edges into fixed-size blocks and draws each\n" \
+   "  block from an independent random stream derived from C{seed}, so the\n" \
+   "  result depends on the seed only and not on the number of threads.\n" \
+   "@param seed: the seed of the random streams of the parallel generator.\n" \
+   "@param file: a file name or file object to write the edges to instead\n" \
+   "  of creating a graph; the number of edges written is returned then.\n" \
+   "@param format: the format of C{file}; C{\"edgelist\"} for one\n" \
+   "  \"source target\" line per edge or C{\"binary\"} for pairs of native\n" \
+   "  64-bit integers.\n"
+
+/** \ingroup python_interface
+ * Instrumented wrappers of the methods that release the GIL around their
+ * core call; see \ref python_interface_profiling
+ */
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_Read_Edgelist, PyTypeObject*, "Graph.Read_Edgelist")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_Read_GraphML, PyTypeObject*, "Graph.Read_GraphML")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_Read_Lgl, PyTypeObject*, "Graph.Read_Lgl")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_Read_Ncol, PyTypeObject*, "Graph.Read_Ncol")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_all_st_mincuts, igraphmodule_GraphObject*, "Graph.all_st_mincuts")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_average_path_length, igraphmodule_GraphObject*, "Graph.average_path_length")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_betweenness, igraphmodule_GraphObject*, "Graph.betweenness")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_cliques, igraphmodule_GraphObject*, "Graph.cliques")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_closeness, igraphmodule_GraphObject*, "Graph.closeness")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_community_edge_betweenness, igraphmodule_GraphObject*, "Graph.community_edge_betweenness")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_community_ensemble, igraphmodule_GraphObject*, "Graph.community_ensemble")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_community_fastgreedy, igraphmodule_GraphObject*, "Graph.community_fastgreedy")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_community_infomap, igraphmodule_GraphObject*, "Graph.community_infomap")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_community_label_propagation, igraphmodule_GraphObject*, "Graph.community_label_propagation")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_community_leiden, igraphmodule_GraphObject*, "Graph.community_leiden")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_community_multilevel, igraphmodule_GraphObject*, "Graph.community_multilevel")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_community_spinglass, igraphmodule_GraphObject*, "Graph.community_spinglass")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_community_walktrap, igraphmodule_GraphObject*, "Graph.community_walktrap")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_coreness, igraphmodule_GraphObject*, "Graph.coreness")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_diameter, igraphmodule_GraphObject*, "Graph.diameter")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_edge_betweenness, igraphmodule_GraphObject*, "Graph.edge_betweenness")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_get_adjacency_arrays, igraphmodule_GraphObject*, "Graph.get_adjacency_arrays")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_gomory_hu_tree, igraphmodule_GraphObject*, "Graph.gomory_hu_tree")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_independent_vertex_sets, igraphmodule_GraphObject*, "Graph.independent_vertex_sets")
+IGRAPHMODULE_DEFINE_PROFILED_NOARGS(igraphmodule_Graph_largest_cliques, igraphmodule_GraphObject*, "Graph.largest_cliques")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_layout_drl, igraphmodule_GraphObject*, "Graph.layout_drl")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_layout_graphopt, igraphmodule_GraphObject*, "Graph.layout_graphopt")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_layout_kamada_kawai, igraphmodule_GraphObject*, "Graph.layout_kamada_kawai")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_maxflow, igraphmodule_GraphObject*, "Graph.maxflow")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_maximal_cliques, igraphmodule_GraphObject*, "Graph.maximal_cliques")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_motifs_randesu, igraphmodule_GraphObject*, "Graph.motifs_randesu")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_personalized_pagerank, igraphmodule_GraphObject*, "Graph.personalized_pagerank")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_random_walks, igraphmodule_GraphObject*, "Graph.random_walks")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_shortest_paths, igraphmodule_GraphObject*, "Graph.shortest_paths")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_similarity_inverse_log_weighted, igraphmodule_GraphObject*, "Graph.similarity_inverse_log_weighted")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_transitivity_avglocal_undirected, igraphmodule_GraphObject*, "Graph.transitivity_avglocal_undirected")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_transitivity_undirected, igraphmodule_GraphObject*, "Graph.transitivity_undirected")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_write_edgelist, igraphmodule_GraphObject*, "Graph.write_edgelist")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_write_gml, igraphmodule_GraphObject*, "Graph.write_gml")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_write_graphml, igraphmodule_GraphObject*, "Graph.write_graphml")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_write_ncol, igraphmodule_GraphObject*, "Graph.write_ncol")
+IGRAPHMODULE_DEFINE_PROFILED(igraphmodule_Graph_write_pajek, igraphmodule_GraphObject*, "Graph.write_pajek")
+
 /** \ingroup python_interface
  * \brief Method list of the \c igraph.Graph object type
  */
@@ -11942,6 +16008,25 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  represented with a tuple, containing the vertex IDs of the\n"
    "  two endpoints. Vertices are enumerated from zero.\n"},
 
+  {"batch_update", (PyCFunction) igraphmodule_Graph_batch_update,
+   METH_NOARGS,
+   "batch_update()\n\n"
+   "Starts a batch of modifications of the graph.\n\n"
+   "The returned L{GraphBatch} collects new vertices, new edges, attribute\n"
+   "values and the vertices and edges to delete, and applies them to the\n"
+   "graph in one go when it is committed. This is much faster than many\n"
+   "small calls to L{add_edges()}, L{add_vertices()} or L{delete_edges()},\n"
+   "since those rebuild the indices of the graph each time. The batch is\n"
+   "committed automatically at the end of a C{with} block, or discarded if\n"
+   "the block raises an exception::\n\n"
+   "  >>> g = Graph()\n"
+   "  >>> with g.batch_update() as batch:\n"
+   "  ...     batch.add_vertices([\"a\", \"b\", \"c\"])\n"
+   "  ...     batch.add_edges([(\"a\", \"b\"), (\"b\", \"c\")], {\"weight\": [1, 2]})\n"
+   "  >>> g.get_edgelist()\n"
+   "  [(0, 1), (1, 2)]\n\n"
+   "@return: a new L{GraphBatch} for the graph\n"},
+
   /* interface to igraph_delete_edges */
   {"delete_edges", (PyCFunction) igraphmodule_Graph_delete_edges,
    METH_VARARGS | METH_KEYWORDS,
@@ -11956,7 +16041,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
   /* interface to igraph_degree */
   {"degree", (PyCFunction) igraphmodule_Graph_degree,
    METH_VARARGS | METH_KEYWORDS,
-   "degree(vertices, mode=ALL, loops=True)\n\n"
+   "degree(vertices, mode=ALL, loops=True, return_type=None)\n\n"
    "Returns some vertex degrees from the graph.\n\n"
    "This method accepts a single vertex ID or a list of vertex IDs as a\n"
    "parameter, and returns the degree of the given vertices (in the\n"
@@ -11966,12 +16051,17 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@param vertices: a single vertex ID or a list of vertex IDs\n"
    "@param mode: the type of degree to be returned (L{OUT} for\n"
    "  out-degrees, L{IN} IN for in-degrees or L{ALL} for the sum of\n"
-   "  them).\n" "@param loops: whether self-loops should be counted.\n"},
+   "  them).\n" "@param loops: whether self-loops should be counted.\n"
+   "@param return_type: C{\"list\"} (or C{None}) returns the result\n"
+   "  as a Python list, C{\"buffer\"} returns a L{Buffer} that exposes\n"
+   "  the result without copying via the buffer protocol (e.g., to\n"
+   "  C{numpy.asarray()}).\n"},
 
   /* interface to igraph_strength */
   {"strength", (PyCFunction) igraphmodule_Graph_strength,
    METH_VARARGS | METH_KEYWORDS,
-   "strength(vertices, mode=ALL, loops=True, weights=None)\n\n"
+   "strength(vertices, mode=ALL, loops=True, weights=None,\n"
+   "  return_type=None)\n\n"
    "Returns the strength (weighted degree) of some vertices from the graph\n\n"
    "This method accepts a single vertex ID or a list of vertex IDs as a\n"
    "parameter, and returns the strength (that is, the sum of the weights\n"
@@ -11987,6 +16077,10 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@param weights: edge weights to be used. Can be a sequence or iterable or\n"
    "  even an edge attribute name. ``None`` means to treat the graph as\n"
    "  unweighted, falling back to ordinary degree calculations.\n"
+   "@param return_type: C{\"list\"} (or C{None}) returns the result\n"
+   "  as a Python list, C{\"buffer\"} returns a L{Buffer} that exposes\n"
+   "  the result without copying via the buffer protocol (e.g., to\n"
+   "  C{numpy.asarray()}).\n"
   },
 
   /* interface to igraph_is_loop */
@@ -12114,6 +16208,29 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  edge does not exist. If C{False}, -1 will be returned in\n"
    "  that case.\n"
    "@return: the edge IDs in a list\n"},
+  {"get_eids_batch", (PyCFunction) igraphmodule_Graph_get_eids_batch,
+   METH_VARARGS | METH_KEYWORDS,
+   "get_eids_batch(pairs, directed=True, index=True)\n\n"
+   "Returns the edge IDs of the edges between many pairs of vertices.\n\n"
+   "The pairs are read directly from an object exporting a numeric buffer\n"
+   "with two columns (e.g., an M{n x 2} NumPy array), without creating a\n"
+   "Python object for each pair; lists of pairs (including pairs of\n"
+   "vertex names) are accepted as well. The lookups run without holding\n"
+   "the global interpreter lock.\n\n"
+   "Unless C{index} is C{False}, the lookups use a hash table of the edges\n"
+   "that is built on the first call and kept until the edges of the graph\n"
+   "are modified. L{get_eid()}, L{get_eids()} and L{are_connected()} use\n"
+   "the table as well once it exists. The table takes 32 to 64 bytes per\n"
+   "edge (see L{memory_usage()}). If there are multiple edges between a\n"
+   "pair of vertices, the table resolves the pair to the lowest edge ID.\n\n"
+   "@param pairs: the source-target vertex pairs to look up\n"
+   "@param directed: whether edge directions should be considered in\n"
+   "  directed graphs. Ignored for undirected graphs.\n"
+   "@param index: whether to build and use the hash table of the edges.\n"
+   "  If C{False} and the table does not exist, every pair is looked up\n"
+   "  with a binary search in the incidence list of its source vertex.\n"
+   "@return: the edge IDs as an integer L{AttributeColumn}, with -1 for\n"
+   "  the pairs that are not connected\n"},
 
   /* interface to igraph_incident */
   {"incident", (PyCFunction) igraphmodule_Graph_incident,
@@ -12134,7 +16251,9 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    METH_CLASS | METH_VARARGS | METH_KEYWORDS,
    "Adjacency(matrix, mode=ADJ_DIRECTED)\n\n"
    "Generates a graph from its adjacency matrix.\n\n"
-   "@param matrix: the adjacency matrix\n"
+   "@param matrix: the adjacency matrix as a list of lists or as a\n"
+   "  two-dimensional object supporting the buffer protocol (e.g., a\n"
+   "  NumPy array), which is converted without iterating over its rows\n"
    "@param mode: the mode to be used. Possible values are:\n"
    "\n"
    "  - C{ADJ_DIRECTED} - the graph will be directed and a matrix\n"
@@ -12277,13 +16396,16 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
   // interface to igraph_erdos_renyi_game
   {"Erdos_Renyi", (PyCFunction) igraphmodule_Graph_Erdos_Renyi,
    METH_VARARGS | METH_CLASS | METH_KEYWORDS,
-   "Erdos_Renyi(n, p, m, directed=False, loops=False)\n\n"
+   "Erdos_Renyi(n, p, m, directed=False, loops=False, threads=None,\n"
+   "  seed=None, file=None, format=\"edgelist\")\n\n"
    "Generates a graph based on the Erdos-Renyi model.\n\n"
    "@param n: the number of vertices.\n"
    "@param p: the probability of edges. If given, C{m} must be missing.\n"
-   "@param m: the number of edges. If given, C{p} must be missing.\n"
+   "@param m: the number of edges. If given, C{p} must be missing. Not\n"
+   "  supported by the parallel generator.\n"
    "@param directed: whether to generate a directed graph.\n"
-   "@param loops: whether self-loops are allowed.\n"},
+   "@param loops: whether self-loops are allowed.\n"
+   IGRAPHMODULE_PARALLEL_GENERATOR_DOC},
 
   /* interface to igraph_famous */
 	{"Famous", (PyCFunction) igraphmodule_Graph_Famous,
@@ -12298,6 +16420,16 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
 	 "@param name: the name of the graph to be generated.\n"
 	},
 
+  {"_from_columns", (PyCFunction) igraphmodule_Graph__from_columns,
+   METH_VARARGS | METH_CLASS | METH_KEYWORDS,
+   "_from_columns(source, target, directed=False, vertex_names=None)\n\n"
+   "Creates a graph from two columns of vertex keys.\n\n"
+   "Internal function, undocumented; see L{Graph.from_columns()}.\n\n"
+   "@return: the graph and the list of the vertex keys in the order of the\n"
+   "  vertex IDs if the keys were factorized without a list of\n"
+   "  C{vertex_names}, C{None} otherwise.\n"
+  },
+
   /* interface to igraph_forest_fire_game */
   {"Forest_Fire", (PyCFunction) igraphmodule_Graph_Forest_Fire,
    METH_VARARGS | METH_CLASS | METH_KEYWORDS,
@@ -12451,7 +16583,8 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
   /* interface to igraph_sbm_game */
   {"SBM", (PyCFunction) igraphmodule_Graph_SBM,
    METH_VARARGS | METH_CLASS | METH_KEYWORDS,
-   "SBM(n, pref_matrix, block_sizes, directed=False, loops=False)\n\n"
+   "SBM(n, pref_matrix, block_sizes, directed=False, loops=False,\n"
+   "  threads=None, seed=None, file=None, format=\"edgelist\")\n\n"
    "Generates a graph based on a stochastic blockmodel.\n\n"
    "A given number of vertices are generated. Every vertex is assigned to a\n"
    "vertex type according to the given block sizes. Vertices of the same\n"
@@ -12465,7 +16598,8 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@param block_sizes: list giving the number of vertices in each block; must\n"
    "  sum up to I{n}.\n"
    "@param directed: whether to generate a directed graph.\n"
-   "@param loops: whether loop edges are allowed.\n"},
+   "@param loops: whether loop edges are allowed.\n"
+   IGRAPHMODULE_PARALLEL_GENERATOR_DOC},
 
   // interface to igraph_star
   {"Star", (PyCFunction) igraphmodule_Graph_Star,
@@ -12519,7 +16653,8 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
   /* interface to igraph_static_fitness_game */
   {"Static_Fitness", (PyCFunction) igraphmodule_Graph_Static_Fitness,
    METH_VARARGS | METH_CLASS | METH_KEYWORDS,
-   "Static_Fitness(m, fitness_out, fitness_in=None, loops=False, multiple=False)\n\n"
+   "Static_Fitness(m, fitness_out, fitness_in=None, loops=False, multiple=False,\n"
+   "  threads=None, seed=None, file=None, format=\"edgelist\")\n\n"
    "Generates a non-growing graph with edge probabilities proportional to node\n"
    "fitnesses.\n\n"
    "The algorithm randomly selects vertex pairs and connects them until the given\n"
@@ -12535,7 +16670,9 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  vertex. These values represent the in-fitness scores for directed graphs.\n"
    "  For undirected graphs, this argument must be C{None}.\n"
    "@param loops: whether loop edges are allowed.\n"
-   "@param multiple: whether multiple edges are allowed.\n"
+   "@param multiple: whether multiple edges are allowed. Must be C{True} for\n"
+   "  the parallel generator.\n"
+   IGRAPHMODULE_PARALLEL_GENERATOR_DOC
    "@return: a directed or undirected graph with the prescribed power-law\n"
    "  degree distributions.\n"
   },
@@ -12544,7 +16681,8 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
   {"Static_Power_Law", (PyCFunction) igraphmodule_Graph_Static_Power_Law,
    METH_VARARGS | METH_CLASS | METH_KEYWORDS,
    "Static_Power_Law(n, m, exponent_out, exponent_in=-1, loops=False,\n"
-   "    multiple=False, finite_size_correction=True)\n\n"
+   "    multiple=False, finite_size_correction=True, threads=None,\n"
+   "    seed=None, file=None, format=\"edgelist\")\n\n"
    "Generates a non-growing graph with prescribed power-law degree distributions.\n\n"
    "@param n: the number of vertices in the graph\n"
    "@param m: the number of edges in the graph\n"
@@ -12557,10 +16695,12 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  must be between 2 and infinity (inclusive) It can also be negative, in\n"
    "  which case an undirected graph will be generated.\n"
    "@param loops: whether loop edges are allowed.\n"
-   "@param multiple: whether multiple edges are allowed.\n"
+   "@param multiple: whether multiple edges are allowed. Must be C{True} for\n"
+   "  the parallel generator.\n"
    "@param finite_size_correction: whether to apply a finite-size correction\n"
    "  to the generated fitness values for exponents less than 3. See the\n"
    "  paper of Cho et al for more details.\n"
+   IGRAPHMODULE_PARALLEL_GENERATOR_DOC
    "@return: a directed or undirected graph with the prescribed power-law\n"
    "  degree distributions.\n"
    "\n"
@@ -12629,14 +16769,18 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
   /* interface to igraph_watts_strogatz_game */
   {"Watts_Strogatz", (PyCFunction) igraphmodule_Graph_Watts_Strogatz,
    METH_VARARGS | METH_CLASS | METH_KEYWORDS,
-   "Watts_Strogatz(dim, size, nei, p, loops=False, multiple=False)\n\n"
+   "Watts_Strogatz(dim, size, nei, p, loops=False, multiple=False,\n"
+   "  threads=None, seed=None, file=None, format=\"edgelist\")\n\n"
    "@param dim: the dimension of the lattice\n"
    "@param size: the size of the lattice along all dimensions\n"
    "@param nei: value giving the distance (number of steps) within which\n"
    "   two vertices will be connected.\n"
    "@param p: rewiring probability\n\n"
    "@param loops: specifies whether loop edges are allowed\n"
-   "@param multiple: specifies whether multiple edges are allowed\n"
+   "@param multiple: specifies whether multiple edges are allowed. The\n"
+   "  parallel generator requires C{multiple=True} and C{dim=1}; it rewires\n"
+   "  the edges of vertex M{i} to M{i+1}, ..., M{i+nei} independently.\n"
+   IGRAPHMODULE_PARALLEL_GENERATOR_DOC
    "@see: L{Lattice()}, L{rewire()}, L{rewire_edges()} if more flexibility is\n"
    "  needed\n"
    "@newfield ref: Reference\n"
@@ -12648,7 +16792,9 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    METH_CLASS | METH_VARARGS | METH_KEYWORDS,
    "Weighted_Adjacency(matrix, mode=ADJ_DIRECTED, attr=\"weight\", loops=True)\n\n"
    "Generates a graph from its adjacency matrix.\n\n"
-   "@param matrix: the adjacency matrix\n"
+   "@param matrix: the adjacency matrix as a list of lists or as a\n"
+   "  two-dimensional object supporting the buffer protocol (e.g., a\n"
+   "  NumPy array), which is converted without iterating over its rows\n"
    "@param mode: the mode to be used. Possible values are:\n"
    "\n"
    "  - C{ADJ_DIRECTED} - the graph will be directed and a matrix\n"
@@ -12760,7 +16906,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
 
   /* interface to igraph_average_path_length */
   {"average_path_length",
-   (PyCFunction) igraphmodule_Graph_average_path_length,
+   (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_average_path_length),
    METH_VARARGS | METH_KEYWORDS,
    "average_path_length(directed=True, unconn=True)\n\n"
    "Calculates the average path length in a graph.\n\n"
@@ -12783,7 +16929,8 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  is 1.\n"
    "@param arpack_options: an L{ARPACKOptions} object used to fine-tune\n"
    "  the ARPACK eigenvector calculation. If omitted, the module-level\n"
-   "  variable called C{arpack_options} is used.\n"
+   "  variable called C{arpack_options} is used. An L{ARPACKSession}\n"
+   "  starts from the result of its previous authority score calculation.\n"
    "@param return_eigenvalue: whether to return the largest eigenvalue\n"
    "@return: the authority scores in a list and optionally the largest eigenvalue\n"
    "  as a second member of a tuple\n\n"
@@ -12791,9 +16938,11 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
   },
 
   /* interface to igraph_betweenness[_estimate] */
-  {"betweenness", (PyCFunction) igraphmodule_Graph_betweenness,
+  {"betweenness", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_betweenness),
    METH_VARARGS | METH_KEYWORDS,
-   "betweenness(vertices=None, directed=True, cutoff=None, weights=None, nobigint=True)\n\n"
+   "betweenness(vertices=None, directed=True, cutoff=None, weights=None,\n"
+   "  nobigint=True, return_type=None, approximate=False, samples=None,\n"
+   "  seed=None, threads=None)\n\n"
    "Calculates or estimates the betweenness of vertices in a graph.\n\n"
    "Keyword arguments:\n"
    "@param vertices: the vertices for which the betweennesses must be returned.\n"
@@ -12811,7 +16960,28 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  To prevent this, use C{nobigint=False}, which forces igraph to use\n"
    "  arbitrary precision integers at the expense of increased computation\n"
    "  time.\n"
-   "@return: the (possibly estimated) betweenness of the given vertices in a list\n"},
+   "@param return_type: C{\"list\"} (or C{None}) returns the result\n"
+   "  as a Python list, C{\"buffer\"} returns a L{Buffer} that exposes\n"
+   "  the result without copying via the buffer protocol (e.g., to\n"
+   "  C{numpy.asarray()}).\n"
+   "@param approximate: if C{True}, the shortest paths are only searched\n"
+   "  from a uniform random sample of I{samples} vertices, and the\n"
+   "  result is scaled up accordingly. The result is then a tuple of the\n"
+   "  estimates and a bound on their error that holds for all the vertices\n"
+   "  at the same time with a probability of at least 95%.\n"
+   "@param samples: the number of vertices to sample if I{approximate} is\n"
+   "  C{True}; C{None} means 256. The result is exact if this is not\n"
+   "  smaller than the number of vertices.\n"
+   "@param seed: the seed of the random sample; C{None} draws one from\n"
+   "  the default random number generator of igraph.\n"
+   "@param threads: the number of threads searching from different\n"
+   "  vertices in parallel, with the global interpreter lock released.\n"
+   "  Specifying it (or I{approximate}) selects the parallel implementation\n"
+   "  of this module instead of the C core of igraph; this one requires\n"
+   "  positive weights and does not support I{nobigint}.\n"
+   "@return: the (possibly estimated) betweenness of the given vertices in a\n"
+   "  list, or a tuple of the list and the error bound if I{approximate} is\n"
+   "  C{True}\n"},
 
   /* interface to biconnected_components */
   {"biconnected_components", (PyCFunction) igraphmodule_Graph_biconnected_components,
@@ -12851,10 +17021,11 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
   },
 
   /* interface to igraph_closeness */
-  {"closeness", (PyCFunction) igraphmodule_Graph_closeness,
+  {"closeness", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_closeness),
    METH_VARARGS | METH_KEYWORDS,
    "closeness(vertices=None, mode=ALL, cutoff=None, weights=None,\n"
-   "          normalized=True)\n\n"
+   "          normalized=True, return_type=None, approximate=False,\n"
+   "          samples=None, seed=None, threads=None)\n\n"
    "Calculates the closeness centralities of given vertices in a graph.\n\n"
    "The closeness centerality of a vertex measures how easily other\n"
    "vertices can be reached from it (or the other way: how easily it\n"
@@ -12881,7 +17052,29 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  even an edge attribute name.\n"
    "@param normalized: Whether to normalize the raw closeness scores by\n"
    "  multiplying by the number of vertices minus one.\n"
-   "@return: the calculated closenesses in a list\n"},
+   "@param return_type: C{\"list\"} (or C{None}) returns the result\n"
+   "  as a Python list, C{\"buffer\"} returns a L{Buffer} that exposes\n"
+   "  the result without copying via the buffer protocol (e.g., to\n"
+   "  C{numpy.asarray()}).\n"
+   "@param approximate: if C{True}, the distances of each vertex are only\n"
+   "  calculated to (from) a uniform random sample of I{samples} vertices,\n"
+   "  and their sum is scaled up to the number of vertices minus one. The\n"
+   "  result is then a tuple of the estimated closenesses and a bound on\n"
+   "  the error of the estimated sums of the distances (the reciprocals\n"
+   "  of the unnormalized closenesses) that holds for all the vertices at\n"
+   "  the same time with a probability of at least 95%.\n"
+   "@param samples: the number of vertices to sample if I{approximate} is\n"
+   "  C{True}; C{None} means 256. The result is exact if this is not\n"
+   "  smaller than the number of vertices.\n"
+   "@param seed: the seed of the random sample; C{None} draws one from\n"
+   "  the default random number generator of igraph.\n"
+   "@param threads: the number of threads searching from different\n"
+   "  vertices in parallel, with the global interpreter lock released.\n"
+   "  Specifying it (or I{approximate}) selects the parallel implementation\n"
+   "  of this module instead of the C core of igraph; this one requires\n"
+   "  positive weights.\n"
+   "@return: the calculated closenesses in a list, or a tuple of the list\n"
+   "  and the error bound if I{approximate} is C{True}\n"},
 
   /* interface to igraph_clusters */
   {"clusters", (PyCFunction) igraphmodule_Graph_clusters,
@@ -12973,7 +17166,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@return: the density of the graph."},
 
   /* interfaces to igraph_diameter */
-  {"diameter", (PyCFunction) igraphmodule_Graph_diameter,
+  {"diameter", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_diameter),
    METH_VARARGS | METH_KEYWORDS,
    "diameter(directed=True, unconn=True, weights=None)\n\n"
    "Calculates the diameter of the graph.\n\n"
@@ -13058,9 +17251,10 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  a single vertex was supplied.\n"},
 
   /* interface to igraph_edge_betweenness[_estimate] */
-  {"edge_betweenness", (PyCFunction) igraphmodule_Graph_edge_betweenness,
+  {"edge_betweenness", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_edge_betweenness),
    METH_VARARGS | METH_KEYWORDS,
-   "edge_betweenness(directed=True, cutoff=None, weights=None)\n\n"
+   "edge_betweenness(directed=True, cutoff=None, weights=None,\n"
+   "  approximate=False, samples=None, seed=None, threads=None)\n\n"
    "Calculates or estimates the edge betweennesses in a graph.\n\n"
    "@param directed: whether to consider directed paths.\n"
    "@param cutoff: if it is an integer, only paths less than or equal to this\n"
@@ -13069,8 +17263,24 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  returned.\n"
    "@param weights: edge weights to be used. Can be a sequence or iterable or\n"
    "  even an edge attribute name.\n"
+   "@param approximate: if C{True}, the shortest paths are only searched\n"
+   "  from a uniform random sample of I{samples} vertices, and the\n"
+   "  result is scaled up accordingly. The result is then a tuple of the\n"
+   "  estimates and a bound on their error that holds for all the edges at\n"
+   "  the same time with a probability of at least 95%.\n"
+   "@param samples: the number of vertices to sample if I{approximate} is\n"
+   "  C{True}; C{None} means 256. The result is exact if this is not\n"
+   "  smaller than the number of vertices.\n"
+   "@param seed: the seed of the random sample; C{None} draws one from\n"
+   "  the default random number generator of igraph.\n"
+   "@param threads: the number of threads searching from different\n"
+   "  vertices in parallel, with the global interpreter lock released.\n"
+   "  Specifying it (or I{approximate}) selects the parallel implementation\n"
+   "  of this module instead of the C core of igraph; this one requires\n"
+   "  positive weights.\n"
    "@return: a list with the (exact or estimated) edge betweennesses of all\n"
-   "  edges.\n"},
+   "  edges, or a tuple of the list and the error bound if I{approximate}\n"
+   "  is C{True}.\n"},
 
 	{"eigen_adjacency", (PyCFunction) igraphmodule_Graph_eigen_adjacency,
 	 METH_VARARGS | METH_KEYWORDS,
@@ -13132,7 +17342,9 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  eigenvalue along with the centralities\n"
    "@param arpack_options: an L{ARPACKOptions} object that can be used\n"
    "  to fine-tune the calculation. If it is omitted, the module-level\n"
-   "  variable called C{arpack_options} is used.\n"
+   "  variable called C{arpack_options} is used. An L{ARPACKSession}\n"
+   "  starts from the result of its previous eigenvector centrality\n"
+   "  calculation.\n"
    "@return: the eigenvector centralities in a list and optionally the\n"
    "  largest eigenvalue (as a second member of a tuple)"
   },
@@ -13256,7 +17468,8 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  is 1.\n"
    "@param arpack_options: an L{ARPACKOptions} object used to fine-tune\n"
    "  the ARPACK eigenvector calculation. If omitted, the module-level\n"
-   "  variable called C{arpack_options} is used.\n"
+   "  variable called C{arpack_options} is used. An L{ARPACKSession}\n"
+   "  starts from the result of its previous hub score calculation.\n"
    "@param return_eigenvalue: whether to return the largest eigenvalue\n"
    "@return: the hub scores in a list and optionally the largest eigenvalue\n"
    "  as a second member of a tuple\n\n"
@@ -13418,13 +17631,45 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  if I{vertices} was a list or C{None}.\n"
   },
 
+  {"neighbors_batch", (PyCFunction) igraphmodule_Graph_neighbors_batch,
+   METH_VARARGS | METH_KEYWORDS,
+   "neighbors_batch(vertices=None, mode=ALL, order=1, mindist=1, edges=False)\n\n"
+   "Returns the neighbors of many vertices at once in the compressed\n"
+   "sparse row format.\n\n"
+   "The neighbors of the I{i}th vertex are C{ids[offsets[i]:offsets[i+1]]},\n"
+   "therefore the differences of consecutive offsets are the degrees of\n"
+   "the vertices. The result is returned in typed L{AttributeColumn}\n"
+   "objects that can be converted to NumPy arrays without copying, so no\n"
+   "Python object is created for the individual neighbors. The lists are\n"
+   "computed without holding the global interpreter lock.\n\n"
+   "If I{order} and I{mindist} are both 1, the neighbors of each vertex are\n"
+   "the same as those returned by L{neighbors()}, so multiple edges yield\n"
+   "the same neighbor more than once. Otherwise each vertex reachable from\n"
+   "a vertex in at least I{mindist} and at most I{order} steps is listed\n"
+   "once, in the same order as in L{neighborhood()}.\n\n"
+   "@param vertices: a single vertex ID or a list of vertex IDs, or\n"
+   "  C{None} meaning all the vertices in the graph.\n"
+   "@param mode: whether to follow the outgoing (C{\"out\"}) or the\n"
+   "  incoming (C{\"in\"}) edges, or both (C{\"all\"}). Ignored for\n"
+   "  undirected graphs.\n"
+   "@param order: the maximum number of steps to take from each vertex.\n"
+   "@param mindist: the minimum number of steps needed to include a\n"
+   "  vertex. Zero means that each vertex is included in its own list.\n"
+   "@param edges: whether to return the IDs of the incident edges as well.\n"
+   "  The edges are listed in the same order as by L{incident()}, and the\n"
+   "  neighbors are listed in the matching order. Only supported if\n"
+   "  I{order} and I{mindist} are both 1.\n"
+   "@return: a tuple C{(offsets, ids)}, or C{(offsets, ids, eids)} if\n"
+   "  I{edges} is C{True}.\n"
+  },
+
   /* interface to igraph_personalized_pagerank */
-  {"personalized_pagerank", (PyCFunction) igraphmodule_Graph_personalized_pagerank,
+  {"personalized_pagerank", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_personalized_pagerank),
    METH_VARARGS | METH_KEYWORDS,
    "personalized_pagerank(vertices=None, directed=True, damping=0.85,\n"
    "        reset=None, reset_vertices=None, weights=None, \n"
    "        arpack_options=None, implementation=\"prpack\", niter=1000,\n"
-   "        eps=0.001)\n\n"
+   "        eps=0.001, return_type=None)\n\n"
    "Calculates the personalized PageRank values of a graph.\n\n"
    "The personalized PageRank calculation is similar to the PageRank\n"
    "calculation, but the random walk is reset to a non-uniform distribution\n"
@@ -13467,9 +17712,57 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  calculation as complete if the difference of PageRank values between\n"
    "  iterations change less than this value for every node. It is \n"
    "  ignored by the other implementations.\n"
+   "@param return_type: C{\"list\"} (or C{None}) returns the result\n"
+   "  as a Python list, C{\"buffer\"} returns a L{Buffer} that exposes\n"
+   "  the result without copying via the buffer protocol (e.g., to\n"
+   "  C{numpy.asarray()}).\n"
    "@return: a list with the personalized PageRank values of the specified\n"
    "  vertices.\n"},
 
+  {"personalized_pagerank_batch",
+   (PyCFunction) igraphmodule_Graph_personalized_pagerank_batch,
+   METH_VARARGS | METH_KEYWORDS,
+   "personalized_pagerank_batch(seeds, directed=True, damping=0.85,\n"
+   "        weights=None, threads=None, top_k=None, niter=1000, eps=1e-10,\n"
+   "        return_type=None)\n\n"
+   "Calculates the personalized PageRank values of a graph for many seed\n"
+   "sets at once.\n\n"
+   "The result for each seed set is the same as the one of\n"
+   "L{personalized_pagerank()} with the seed set as I{reset_vertices}, but\n"
+   "the transition structure of the random walk is set up only once for\n"
+   "all the seed sets, and the seed sets are solved with the power method\n"
+   "by several threads in parallel. As in L{personalized_pagerank()}, the\n"
+   "random walk also restarts from the seed set when it reaches a vertex\n"
+   "without outgoing edges.\n\n"
+   "@param seeds: an iterable of seed sets. Each seed set is a vertex or a\n"
+   "  sequence of vertices (IDs, names, L{Vertex} objects or a L{VertexSeq});\n"
+   "  the random walk is reset to the uniform distribution over its\n"
+   "  vertices.\n"
+   "@param directed: whether to consider directed paths.\n"
+   "@param damping: the damping factor, i.e. the probability of following\n"
+   "  an edge instead of resetting the walk in a step.\n"
+   "@param weights: edge weights to be used. Can be a sequence or iterable or\n"
+   "  even an edge attribute name.\n"
+   "@param threads: the number of threads to use. C{None} means a single\n"
+   "  thread. The result does not depend on the number of threads.\n"
+   "@param top_k: if C{None}, the scores of all the vertices are returned for\n"
+   "  every seed set. Otherwise only the I{top_k} vertices with the highest\n"
+   "  scores are returned for each seed set, in decreasing order of their\n"
+   "  scores (ties are broken by the vertex IDs).\n"
+   "@param niter: the maximum number of iterations of the power method\n"
+   "  for a seed set.\n"
+   "@param eps: the iterations of a seed set stop when the sum of the\n"
+   "  absolute changes of the scores is smaller than this.\n"
+   "@param return_type: C{\"list\"} (or C{None}) returns the result as Python\n"
+   "  lists, C{\"buffer\"} exposes it via the buffer protocol without\n"
+   "  copying (e.g., to C{numpy.asarray()}). See below for the details.\n"
+   "@return: if I{top_k} is C{None}, a matrix with one row for every seed\n"
+   "  set and one column for every vertex, as a list of lists or a\n"
+   "  L{Buffer}. Otherwise a list containing a list of (vertex, score) pairs\n"
+   "  for every seed set, or with C{return_type=\"buffer\"}, a pair of typed\n"
+   "  columns (vertex IDs and scores) with I{top_k} items for each seed set\n"
+   "  one after the other.\n"},
+
   /* interface to igraph_path_length_hist */
   {"path_length_hist", (PyCFunction) igraphmodule_Graph_path_length_hist,
    METH_VARARGS | METH_KEYWORDS,
@@ -13565,9 +17858,10 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  edges.\n"},
 
   /* interface to igraph_shortest_paths */
-  {"shortest_paths", (PyCFunction) igraphmodule_Graph_shortest_paths,
+  {"shortest_paths", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_shortest_paths),
    METH_VARARGS | METH_KEYWORDS,
-   "shortest_paths(source=None, target=None, weights=None, mode=OUT)\n\n"
+   "shortest_paths(source=None, target=None, weights=None, mode=OUT,\n"
+   "  return_type=None)\n\n"
    "Calculates shortest path lengths for given vertices in a graph.\n\n"
    "The algorithm used for the calculations is selected automatically:\n"
    "a simple BFS is used for unweighted graphs, Dijkstra's algorithm is\n"
@@ -13585,7 +17879,46 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  calculation in directed graphs. L{OUT} means only outgoing,\n"
    "  L{IN} means only incoming paths. L{ALL} means to consider\n"
    "  the directed graph as an undirected one.\n"
+   "@param return_type: C{\"list\"} (or C{None}) returns the result\n"
+   "  as a list of lists, C{\"buffer\"} returns a two-dimensional\n"
+   "  L{Buffer} (in column-major order) that exposes the result without\n"
+   "  copying via the buffer protocol (e.g., to C{numpy.asarray()}).\n"
    "@return: the shortest path lengths for given vertices in a matrix\n"},
+  {"shortest_paths_iter", (PyCFunction) igraphmodule_Graph_shortest_paths_iter,
+   METH_VARARGS | METH_KEYWORDS,
+   "shortest_paths_iter(source=None, target=None, weights=None, mode=OUT,\n"
+   "  chunk=1024, threads=1, reduce=None)\n\n"
+   "Calculates shortest path lengths from many source vertices in blocks.\n\n"
+   "Unlike L{shortest_paths()}, this method does not build the whole\n"
+   "distance matrix at once. It returns an iterator that yields one\n"
+   "two-dimensional L{Buffer} for every C{chunk} consecutive source\n"
+   "vertices, in the order of the sources, with one row per source and\n"
+   "one column per target. The sources of a block are distributed among\n"
+   "C{threads} worker threads, each running its own BFS (or Dijkstra's\n"
+   "algorithm if weights are given) without holding the global\n"
+   "interpreter lock. The iterator works on a copy of the structure of\n"
+   "the graph taken when it was created.\n\n"
+   "@param source: a list containing the source vertex IDs. If C{None},\n"
+   "  all vertices will be considered.\n"
+   "@param target: a list containing the target vertex IDs. If C{None},\n"
+   "  all vertices will be considered.\n"
+   "@param weights: a list containing the edge weights. It can also be\n"
+   "  an attribute name (edge weights are retrieved from the given\n"
+   "  attribute) or C{None} (all edges have equal weight). Negative\n"
+   "  weights are not supported.\n"
+   "@param mode: the type of shortest paths to be used for the\n"
+   "  calculation in directed graphs. L{OUT} means only outgoing,\n"
+   "  L{IN} means only incoming paths. L{ALL} means to consider\n"
+   "  the directed graph as an undirected one.\n"
+   "@param chunk: the maximum number of source vertices in a block.\n"
+   "@param threads: the number of worker threads to use.\n"
+   "@param reduce: C{None} yields the distances themselves.\n"
+   "  C{\"eccentricity\"} yields the largest finite distance from each\n"
+   "  source to the targets and C{\"harmonic\"} yields the sum of the\n"
+   "  reciprocal distances from each source to the targets other than\n"
+   "  itself. In both cases the blocks are one-dimensional L{Buffer}\n"
+   "  objects with one item per source.\n"
+   "@return: an iterator yielding the blocks as L{Buffer} objects\n"},
 
   /* interface to igraph_simplify */
   {"simplify", (PyCFunction) igraphmodule_Graph_simplify,
@@ -13697,7 +18030,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
 
   // interface to igraph_transitivity_undirected
   {"transitivity_undirected",
-   (PyCFunction) igraphmodule_Graph_transitivity_undirected,
+   (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_transitivity_undirected),
    METH_VARARGS | METH_KEYWORDS,
    "transitivity_undirected(mode=\"nan\")\n\n"
    "Calculates the global transitivity (clustering coefficient) of the\n"
@@ -13757,7 +18090,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
 
   /* interface to igraph_transitivity_avglocal_undirected */
   {"transitivity_avglocal_undirected",
-   (PyCFunction) igraphmodule_Graph_transitivity_avglocal_undirected,
+   (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_transitivity_avglocal_undirected),
    METH_VARARGS | METH_KEYWORDS,
    "transitivity_avglocal_undirected(mode=\"nan\")\n\n"
    "Calculates the average of the vertex transitivities of the graph.\n\n"
@@ -13849,7 +18182,8 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
   /* interface to igraph_similarity_dice */
   {"similarity_dice", (PyCFunction) igraphmodule_Graph_similarity_dice,
    METH_VARARGS | METH_KEYWORDS,
-   "similarity_dice(vertices=None, pairs=None, mode=IGRAPH_ALL, loops=True)\n\n"
+   "similarity_dice(vertices=None, pairs=None, mode=IGRAPH_ALL, loops=True,\n"
+   "  top_k=None, threshold=None, threads=None)\n\n"
    "Dice similarity coefficient of vertices.\n\n"
    "The Dice similarity coefficient of two vertices is twice the number of\n"
    "their common neighbors divided by the sum of their degrees. This\n"
@@ -13868,15 +18202,31 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  result in strange results: nonadjacent vertices may have larger\n"
    "  similarities compared to the case when an edge is added between them --\n"
    "  however, this might be exactly the result you want to get.\n"
+   "@param top_k: if given, only the I{top_k} most similar vertices of each\n"
+   "  vertex are listed, in the compressed sparse row format (see below).\n"
+   "  The similar vertices are found by enumerating the neighbors of the\n"
+   "  neighbors of each vertex, so this is much faster and needs much less\n"
+   "  memory than the full matrix in large sparse graphs.\n"
+   "@param threshold: if given, only the vertices whose similarity is at\n"
+   "  least this much are listed, in the compressed sparse row format. Can\n"
+   "  be combined with I{top_k}.\n"
+   "@param threads: the number of threads to use in the compressed sparse\n"
+   "  row format. The vertices are distributed among the threads.\n"
    "@return: the pairwise similarity coefficients for the vertices specified,\n"
    "  in the form of a matrix if C{pairs} is C{None} or in the form of a list\n"
-   "  if C{pairs} is not C{None}.\n"
+   "  if C{pairs} is not C{None}. If I{top_k} or I{threshold} is given, a\n"
+   "  tuple of three typed columns C{(offsets, ids, scores)}: the similar\n"
+   "  vertices of the i-th vertex are C{ids[offsets[i]:offsets[i+1]]}, most\n"
+   "  similar first (ties broken by the vertex IDs), with their similarities\n"
+   "  in the same range of C{scores}. Only vertices with positive similarity\n"
+   "  are listed and a vertex is never listed as similar to itself.\n"
   },
   /* interface to igraph_similarity_inverse_log_weighted */
   {"similarity_inverse_log_weighted",
-    (PyCFunction) igraphmodule_Graph_similarity_inverse_log_weighted,
+    (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_similarity_inverse_log_weighted),
    METH_VARARGS | METH_KEYWORDS,
-   "similarity_inverse_log_weighted(vertices=None, mode=IGRAPH_ALL)\n\n"
+   "similarity_inverse_log_weighted(vertices=None, mode=IGRAPH_ALL,\n"
+   "  top_k=None, threshold=None, threads=None)\n\n"
    "Inverse log-weighted similarity coefficient of vertices.\n\n"
    "Each vertex is assigned a weight which is 1 / log(degree). The\n"
    "log-weighted similarity of two vertices is the sum of the weights\n"
@@ -13887,13 +18237,26 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  Can be L{ALL}, L{IN} or L{OUT}, ignored for undirected graphs.\n"
    "  L{IN} means that the weights are determined by the out-degrees, L{OUT}\n"
    "  means that the weights are determined by the in-degrees.\n"
+   "@param top_k: if given, only the I{top_k} most similar vertices of each\n"
+   "  vertex are listed, in the compressed sparse row format (see below).\n"
+   "  The similar vertices are found by enumerating the neighbors of the\n"
+   "  neighbors of each vertex, so this is much faster and needs much less\n"
+   "  memory than the full matrix in large sparse graphs.\n"
+   "@param threshold: if given, only the vertices whose similarity is at\n"
+   "  least this much are listed, in the compressed sparse row format. Can\n"
+   "  be combined with I{top_k}.\n"
+   "@param threads: the number of threads to use in the compressed sparse\n"
+   "  row format. The vertices are distributed among the threads.\n"
    "@return: the pairwise similarity coefficients for the vertices specified,\n"
-   "  in the form of a matrix (list of lists).\n"
+   "  in the form of a matrix (list of lists). If I{top_k} or I{threshold}\n"
+   "  is given, a tuple of three typed columns C{(offsets, ids, scores)}\n"
+   "  like in L{similarity_jaccard()}.\n"
   },
   /* interface to igraph_similarity_jaccard */
   {"similarity_jaccard", (PyCFunction) igraphmodule_Graph_similarity_jaccard,
    METH_VARARGS | METH_KEYWORDS,
-   "similarity_jaccard(vertices=None, pairs=None, mode=IGRAPH_ALL, loops=True)\n\n"
+   "similarity_jaccard(vertices=None, pairs=None, mode=IGRAPH_ALL, loops=True,\n"
+   "  top_k=None, threshold=None, threads=None)\n\n"
    "Jaccard similarity coefficient of vertices.\n\n"
    "The Jaccard similarity coefficient of two vertices is the number of their\n"
    "common neighbors divided by the number of vertices that are adjacent to\n"
@@ -13911,17 +18274,32 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  result in strange results: nonadjacent vertices may have larger\n"
    "  similarities compared to the case when an edge is added between them --\n"
    "  however, this might be exactly the result you want to get.\n"
+   "@param top_k: if given, only the I{top_k} most similar vertices of each\n"
+   "  vertex are listed, in the compressed sparse row format (see below).\n"
+   "  The similar vertices are found by enumerating the neighbors of the\n"
+   "  neighbors of each vertex, so this is much faster and needs much less\n"
+   "  memory than the full matrix in large sparse graphs.\n"
+   "@param threshold: if given, only the vertices whose similarity is at\n"
+   "  least this much are listed, in the compressed sparse row format. Can\n"
+   "  be combined with I{top_k}.\n"
+   "@param threads: the number of threads to use in the compressed sparse\n"
+   "  row format. The vertices are distributed among the threads.\n"
    "@return: the pairwise similarity coefficients for the vertices specified,\n"
    "  in the form of a matrix if C{pairs} is C{None} or in the form of a list\n"
-   "  if C{pairs} is not C{None}.\n"
+   "  if C{pairs} is not C{None}. If I{top_k} or I{threshold} is given, a\n"
+   "  tuple of three typed columns C{(offsets, ids, scores)}: the similar\n"
+   "  vertices of the i-th vertex are C{ids[offsets[i]:offsets[i+1]]}, most\n"
+   "  similar first (ties broken by the vertex IDs), with their similarities\n"
+   "  in the same range of C{scores}. Only vertices with positive similarity\n"
+   "  are listed and a vertex is never listed as similar to itself.\n"
   },
 
   /******************/
   /* MOTIF COUNTING */
   /******************/
-  {"motifs_randesu", (PyCFunction) igraphmodule_Graph_motifs_randesu,
+  {"motifs_randesu", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_motifs_randesu),
    METH_VARARGS | METH_KEYWORDS,
-   "motifs_randesu(size=3, cut_prob=None, callback=None)\n\n"
+   "motifs_randesu(size=3, cut_prob=None, callback=None, threads=None, seed=None)\n\n"
    "Counts the number of motifs in the graph\n\n"
    "Motifs are small subgraphs of a given structure in a graph. It is\n"
    "argued that the motif profile (ie. the number of different motifs in\n"
@@ -13947,12 +18325,22 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  itself, the list of vertices in the motif and the isomorphism class of the\n"
    "  motif (see L{Graph.isoclass()}). The search will stop when the callback\n"
    "  returns an object with a non-zero truth value or raises an exception.\n"
+   "  Cannot be used together with I{threads}.\n"
+   "@param threads: C{None} to use the search of the C core, or the number of\n"
+   "  threads that share the root vertices of the search. Each subgraph is\n"
+   "  found from its vertex with the smallest ID, so the counts of the threads\n"
+   "  add up to the same result. The progress handler is called and pending\n"
+   "  signals are checked between two rounds of roots.\n"
+   "@param seed: the seed of the random streams used for the cut probabilities\n"
+   "  when I{threads} is given; C{None} draws it from the random number\n"
+   "  generator of igraph. Results with the same seed do not depend on the\n"
+   "  number of threads.\n"
    "@return: the list of motifs if I{callback} is C{None}, or C{None} otherwise\n"
-   "@see: Graph.motifs_randesu_no()\n"
+   "@see: Graph.motifs_randesu_no(), Graph.motifs_randesu_sample()\n"
   },
   {"motifs_randesu_no", (PyCFunction) igraphmodule_Graph_motifs_randesu_no,
    METH_VARARGS | METH_KEYWORDS,
-   "motifs_randesu_no(size=3, cut_prob=None)\n\n"
+   "motifs_randesu_no(size=3, cut_prob=None, threads=None, seed=None)\n\n"
    "Counts the total number of motifs in the graph\n\n"
    "Motifs are small subgraphs of a given structure in a graph.\n"
    "This function counts the total number of motifs in a graph without\n"
@@ -13964,6 +18352,11 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@param cut_prob: the cut probabilities for different levels of the search\n"
    "  tree. This must be a list of length I{size} or C{None} to find all\n"
    "  motifs.\n"
+   "@param threads: C{None} to use the search of the C core, or the number of\n"
+   "  threads that share the root vertices of the search.\n"
+   "@param seed: the seed of the random streams used for the cut probabilities\n"
+   "  when I{threads} is given; C{None} draws it from the random number\n"
+   "  generator of igraph.\n"
    "@see: Graph.motifs_randesu()\n"
   },
   {"motifs_randesu_estimate",
@@ -13984,11 +18377,44 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  motifs.\n"
    "@param sample: the size of the sample or the vertex IDs of the vertices\n"
    "  to be used for sampling.\n"
+   "@see: Graph.motifs_randesu(), Graph.motifs_randesu_sample()\n"
+  },
+  {"motifs_randesu_sample",
+   (PyCFunction) igraphmodule_Graph_motifs_randesu_sample,
+   METH_VARARGS | METH_KEYWORDS,
+   "motifs_randesu_sample(size=3, samples=1000, cut_prob=None, threads=None,\n"
+   "  seed=None, confidence=0.95, callback=None)\n\n"
+   "Estimates the number of motifs of each isomorphism class\n\n"
+   "Root vertices are drawn uniformly at random with replacement, in rounds,\n"
+   "and the motifs whose vertex with the smallest ID is the root are counted.\n"
+   "After each round, the count of each class is estimated as the number of\n"
+   "vertices times the mean count per root, together with a confidence\n"
+   "interval from the normal approximation. The running estimate of the total\n"
+   "number of motifs is reported to the progress handler, so a long sampling\n"
+   "can be watched and stopped when it is precise enough.\n\n"
+   "@param size: the size of the motifs (3 or 4).\n"
+   "@param samples: the maximum number of root vertices to draw.\n"
+   "@param cut_prob: the cut probabilities for different levels of the search\n"
+   "  tree, or C{None} to find all motifs from the sampled roots.\n"
+   "@param threads: the number of threads that share the roots of a round;\n"
+   "  C{None} means a single thread.\n"
+   "@param seed: the seed of the sampling; C{None} draws it from the random\n"
+   "  number generator of igraph. The result does not depend on the number of\n"
+   "  threads.\n"
+   "@param confidence: the confidence level of the intervals.\n"
+   "@param callback: C{None} or a callable that is called after each round\n"
+   "  with the number of roots drawn so far and the current estimates, lower\n"
+   "  and upper bounds. The sampling stops early when it returns an object\n"
+   "  with a non-zero truth value.\n"
+   "@return: a tuple of three lists: the estimated number of motifs of each\n"
+   "  isomorphism class and the lower and upper bounds of their confidence\n"
+   "  intervals (clipped at zero). Classes of unconnected graphs are C{nan}.\n"
+   "  The bounds are infinite until at least two roots were drawn.\n"
    "@see: Graph.motifs_randesu()\n"
   },
   {"dyad_census", (PyCFunction) igraphmodule_Graph_dyad_census,
-   METH_NOARGS,
-   "dyad_census()\n\n"
+   METH_VARARGS | METH_KEYWORDS,
+   "dyad_census(threads=None)\n\n"
    "Dyad census, as defined by Holland and Leinhardt\n\n"
    "Dyad census means classifying each pair of vertices of a directed\n"
    "graph into three categories: mutual, there is an edge from I{a} to\n"
@@ -13998,12 +18424,14 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@attention: this function has a more convenient interface in class\n"
    "  L{Graph} which wraps the result in a L{DyadCensus} object.\n"
    "  It is advised to use that.\n\n"
+   "@param threads: C{None} to use the C core, or the number of threads that\n"
+   "  share the vertices when classifying the connected pairs.\n"
    "@return: the number of mutual, asymmetric and null connections in a\n"
    "  3-tuple."
   },
   {"triad_census", (PyCFunction) igraphmodule_Graph_triad_census,
-   METH_NOARGS,
-   "triad_census()\n\n"
+   METH_VARARGS | METH_KEYWORDS,
+   "triad_census(threads=None)\n\n"
    "Triad census, as defined by Davis and Leinhardt\n\n"
    "Calculating the triad census means classifying every triplets of\n"
    "vertices in a directed graph. A triplet can be in one of 16 states,\n"
@@ -14013,6 +18441,10 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  L{Graph} which wraps the result in a L{TriadCensus} object.\n"
    "  It is advised to use that. The name of the triplet classes are\n"
    "  also documented there.\n\n"
+   "@param threads: C{None} to use the C core, or the number of threads that\n"
+   "  share the vertices when counting the connected triads with a parallel\n"
+   "  motif search; the triads with at most one connected pair are counted\n"
+   "  from the pairs of adjacent vertices.\n"
   },
 
   /********************/
@@ -14079,7 +18511,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
 
   /* interface to igraph_layout_kamada_kawai */
   {"layout_kamada_kawai",
-   (PyCFunction) igraphmodule_Graph_layout_kamada_kawai,
+   (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_layout_kamada_kawai),
    METH_VARARGS | METH_KEYWORDS,
    "layout_kamada_kawai(maxiter=1000, seed=None, maxiter=1000, epsilon=0, \n"
    "  kkconst=None, minx=None, maxx=None, miny=None, maxy=None, \n"
@@ -14153,7 +18585,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
 
   /* interface to igraph_layout_drl */
   {"layout_drl",
-   (PyCFunction) igraphmodule_Graph_layout_drl,
+   (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_layout_drl),
    METH_VARARGS | METH_KEYWORDS,
    "layout_drl(weights=None, fixed=None, seed=None, options=None, dim=2)\n\n"
    "Places the vertices on a 2D plane or in the 3D space ccording to the DrL\n"
@@ -14255,7 +18687,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
 
   /* interface to igraph_layout_graphopt */
   {"layout_graphopt",
-   (PyCFunction) igraphmodule_Graph_layout_graphopt,
+   (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_layout_graphopt),
    METH_VARARGS | METH_KEYWORDS,
    "layout_graphopt(niter=500, node_charge=0.001, node_mass=30, spring_length=0, spring_constant=1, max_sa_movement=5, seed=None)\n\n"
    "This is a port of the graphopt layout algorithm by Michael Schmuhl.\n"
@@ -14280,6 +18712,59 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@return: the calculated layout."
   },
 
+  /* interface to igraphmodule_layout_barnes_hut */
+  {"layout_barnes_hut",
+   (PyCFunction) igraphmodule_Graph_layout_barnes_hut,
+   METH_VARARGS | METH_KEYWORDS,
+   "layout_barnes_hut(weights=None, niter=500, seed=None, dim=2, theta=0.8,\n"
+   "  multilevel=True, threads=None, random_seed=None, return_type=None)\n\n"
+   "Places the vertices according to a multilevel spring-electrical\n"
+   "force-directed algorithm.\n\n"
+   "The model is the one of Hu, Y. F.: Efficient and high quality\n"
+   "force-directed graph drawing. The Mathematica Journal 10, 37--71, 2005.\n"
+   "The repulsion between all the pairs of vertices is approximated with a\n"
+   "quadtree (an octree in 3D) as proposed by Barnes and Hut, so an\n"
+   "iteration takes O(|V| log |V| + |E|) time instead of O(|V|^2). The graph\n"
+   "is coarsened by collapsing edges first; the coarsest graph is laid out\n"
+   "from a random layout and the finer ones are refined from the layout of\n"
+   "the coarser ones. This makes the method suitable for graphs with\n"
+   "hundreds of thousands of vertices.\n\n"
+   "@param weights: edge weights to be used. Can be a sequence or iterable or\n"
+   "  even an edge attribute name. The attraction along an edge is\n"
+   "  proportional to its weight.\n"
+   "@param niter: the maximum number of iterations on each level. The\n"
+   "  iterations of a level stop earlier when the layout has converged.\n"
+   "@param seed: if C{None}, the layout is calculated from scratch. Otherwise\n"
+   "  it must be a matrix (list of lists, L{Layout} or an object supporting\n"
+   "  the buffer protocol such as the result of an earlier call with\n"
+   "  C{return_type=\"buffer\"}), which is refined without coarsening and\n"
+   "  with short steps so that the result stays close to it. The matrix may\n"
+   "  have fewer rows than there are vertices; rows that are missing or\n"
+   "  contain NaNs mark new vertices, which are placed near their\n"
+   "  neighbors first. This is useful to re-layout a graph that changed\n"
+   "  slightly since it was last laid out.\n"
+   "@param dim: the desired number of dimensions for the layout. dim=2\n"
+   "  means a 2D layout, dim=3 means a 3D layout.\n"
+   "@param theta: the accuracy of the approximation of the repulsion. A cell\n"
+   "  of the tree is replaced by its center of mass if its width divided by\n"
+   "  its distance is less than this. Zero means no approximation; larger\n"
+   "  values are faster but less accurate.\n"
+   "@param multilevel: whether to coarsen the graph. Ignored if a seed\n"
+   "  layout is given.\n"
+   "@param threads: the number of threads calculating the forces.\n"
+   "  C{None} means a single thread. The result does not depend on the\n"
+   "  number of threads.\n"
+   "@param random_seed: the seed of the random numbers of the initial\n"
+   "  layout and the coarsening. C{None} draws it from the random number\n"
+   "  generator of the module, so the layout is reproducible with\n"
+   "  C{random.seed()}.\n"
+   "@param return_type: C{\"list\"} (or C{None}) returns the result\n"
+   "  as a list of coordinate lists, C{\"buffer\"} returns a L{Buffer} that\n"
+   "  exposes the coordinates as a matrix with one row per vertex via the\n"
+   "  buffer protocol (e.g., to C{numpy.asarray()}) without copying them.\n"
+   "@return: the calculated layout."
+  },
+
   /* interface to igraph_layout_lgl */
   {"layout_lgl", (PyCFunction) igraphmodule_Graph_layout_lgl,
    METH_VARARGS | METH_KEYWORDS,
@@ -14415,7 +18900,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "   - The parent of every vertex in the BFS\n"},
   {"bfsiter", (PyCFunction) igraphmodule_Graph_bfsiter,
    METH_VARARGS | METH_KEYWORDS,
-   "bfsiter(vid, mode=OUT, advanced=False)\n\n"
+   "bfsiter(vid, mode=OUT, advanced=False, batch=None, max_depth=None)\n\n"
    "Constructs a breadth first search (BFS) iterator of the graph.\n\n"
    "@param vid: the root vertex ID\n"
    "@param mode: either L{IN} or L{OUT} or L{ALL}.\n"
@@ -14423,10 +18908,19 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  vertex in BFS order in every step. If C{True}, the iterator\n"
    "  returns the distance of the vertex from the root and the\n"
    "  parent of the vertex in the BFS tree as well.\n"
+   "@param batch: if not C{None}, the iterator visits this many vertices\n"
+   "  in every step and returns them as a tuple of three L{Buffer}\n"
+   "  objects holding the vertex IDs, their distances from the root and\n"
+   "  their parents (-1 for the root). This avoids creating a L{Vertex}\n"
+   "  object for every visited vertex and releases the global interpreter\n"
+   "  lock while a batch is being filled. C{advanced} is ignored in this\n"
+   "  case.\n"
+   "@param max_depth: if not C{None}, vertices farther than this from the\n"
+   "  root are not visited.\n"
    "@return: the BFS iterator as an L{igraph.BFSIter} object.\n"},
   {"dfsiter", (PyCFunction) igraphmodule_Graph_dfsiter,
    METH_VARARGS | METH_KEYWORDS,
-   "dfsiter(vid, mode=OUT, advanced=False)\n\n"
+   "dfsiter(vid, mode=OUT, advanced=False, batch=None, max_depth=None)\n\n"
    "Constructs a depth first search (DFS) iterator of the graph.\n\n"
    "@param vid: the root vertex ID\n"
    "@param mode: either L{IN} or L{OUT} or L{ALL}.\n"
@@ -14434,6 +18928,15 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  vertex in DFS order in every step. If C{True}, the iterator\n"
    "  returns the distance of the vertex from the root and the\n"
    "  parent of the vertex in the DFS tree as well.\n"
+   "@param batch: if not C{None}, the iterator visits this many vertices\n"
+   "  in every step and returns them as a tuple of three L{Buffer}\n"
+   "  objects holding the vertex IDs, their distances from the root and\n"
+   "  their parents (-1 for the root). This avoids creating a L{Vertex}\n"
+   "  object for every visited vertex and releases the global interpreter\n"
+   "  lock while a batch is being filled. C{advanced} is ignored in this\n"
+   "  case.\n"
+   "@param max_depth: if not C{None}, vertices farther than this from the\n"
+   "  root are not visited.\n"
    "@return: the DFS iterator as an L{igraph.DFSIter} object.\n"},
 
   /////////////////
@@ -14456,6 +18959,30 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  each vertex pair.\n"
    "@return: the adjacency matrix.\n"},
 
+  {"get_adjacency_arrays", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_get_adjacency_arrays),
+   METH_VARARGS | METH_KEYWORDS,
+   "get_adjacency_arrays(format=\"csr\", weights=None, mode=OUT)\n\n"
+   "Returns the adjacency matrix of the graph as sparse arrays.\n\n"
+   "The arrays are L{AttributeColumn} objects that support the buffer\n"
+   "protocol, so they can be wrapped without copying, e.g., by\n"
+   "C{numpy.asarray()}, and a row of a CSR matrix can be sliced out of\n"
+   "them with C{memoryview()} without copying either. Indices are 64-bit\n"
+   "integers. Column indices are sorted within every row. Multiple edges\n"
+   "between the same pair of vertices are listed separately.\n\n"
+   "@param format: C{\"csr\"} returns the row pointers, the column\n"
+   "  indices and the values of a compressed sparse row matrix.\n"
+   "  C{\"coo\"} returns the row indices, the column indices and the\n"
+   "  values of every non-zero entry.\n"
+   "@param weights: edge weights to be used as the values of the entries.\n"
+   "  Can be a sequence or iterable or even an edge attribute name. If\n"
+   "  C{None}, every edge has value 1 and the values are integers.\n"
+   "@param mode: if L{OUT}, row M{i} lists the successors of vertex\n"
+   "  M{i}; if L{IN}, it lists its predecessors. L{ALL} treats the\n"
+   "  edges as undirected, giving a symmetric matrix. Ignored for\n"
+   "  undirected graphs, whose matrix is always symmetric. Loop edges\n"
+   "  appear only once on the diagonal.\n"
+   "@return: a tuple of three arrays.\n"},
+
   // interface to igraph_get_edgelist
   {"get_edgelist", (PyCFunction) igraphmodule_Graph_get_edgelist,
    METH_NOARGS,
@@ -14542,15 +19069,38 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@param f: the name of the file or a Python file handle\n"
    "@param directed: whether the generated graph should be directed.\n"},
 
+  {"Read_Binary", (PyCFunction) igraphmodule_Graph_Read_Binary,
+   METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+   "Read_Binary(f)\n\n"
+   "Reads a graph and its attributes from a file written by\n"
+   "L{write_binary()}.\n\n"
+   "@param f: the name of the file or a Python file handle\n"},
+  {"Open_Snapshot", (PyCFunction) igraphmodule_Graph_Open_Snapshot,
+   METH_VARARGS | METH_KEYWORDS | METH_CLASS,
+   "Open_Snapshot(f)\n\n"
+   "Opens a snapshot written by L{write_snapshot()} as a read-only graph.\n\n"
+   "The snapshot file is mapped into memory and the graph uses the vectors\n"
+   "stored in it directly, so opening even a large snapshot is fast and\n"
+   "processes opening the same snapshot share the pages of the mapping.\n"
+   "Attributes are loaded into memory as usual and may be modified, but\n"
+   "methods modifying the structure of the graph raise C{TypeError}; use\n"
+   "L{copy()} to obtain a modifiable graph.\n\n"
+   "The snapshot is trusted: only cheap consistency checks are performed\n"
+   "when it is opened.\n\n"
+   "@param f: the name of the snapshot file, or an object exporting the\n"
+   "  snapshot through the buffer protocol (e.g., an C{mmap} object)\n"},
   /* interface to igraph_read_graph_edgelist */
-  {"Read_Edgelist", (PyCFunction) igraphmodule_Graph_Read_Edgelist,
+  {"Read_Edgelist", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_Read_Edgelist),
    METH_VARARGS | METH_KEYWORDS | METH_CLASS,
    "Read_Edgelist(f, directed=True)\n\n"
    "Reads an edge list from a file and creates a graph based on it.\n\n"
    "Please note that the vertex indices are zero-based. A vertex of zero\n"
    "degree will be created for every integer that is in range but does not\n"
    "appear in the edgelist.\n\n"
-   "@param f: the name of the file or a Python file handle\n"
+   "@param f: the name of the file, a Python file handle or a binary\n"
+   "  stream with a C{readinto()} method (e.g., C{io.BytesIO} or\n"
+   "  C{gzip.GzipFile}). Streams are read in large chunks while the\n"
+   "  file is being parsed without holding the global interpreter lock.\n"
    "@param directed: whether the generated graph should be directed.\n"},
   /* interface to igraph_read_graph_graphdb */
   {"Read_GraphDB", (PyCFunction) igraphmodule_Graph_Read_GraphDB,
@@ -14562,11 +19112,14 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@param f: the name of the file or a Python file handle\n"
    "@param directed: whether the generated graph should be directed.\n"},
   /* interface to igraph_read_graph_graphml */
-  {"Read_GraphML", (PyCFunction) igraphmodule_Graph_Read_GraphML,
+  {"Read_GraphML", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_Read_GraphML),
    METH_VARARGS | METH_KEYWORDS | METH_CLASS,
    "Read_GraphML(f, directed=True, index=0)\n\n"
    "Reads a GraphML format file and creates a graph based on it.\n\n"
-   "@param f: the name of the file or a Python file handle\n"
+   "@param f: the name of the file, a Python file handle or a binary\n"
+   "  stream with a C{readinto()} method (e.g., C{io.BytesIO} or\n"
+   "  C{gzip.GzipFile}). Streams are read in large chunks while the\n"
+   "  file is being parsed without holding the global interpreter lock.\n"
    "@param index: if the GraphML file contains multiple graphs,\n"
    "  specifies the one that should be loaded. Graph indices\n"
    "  start from zero, so if you want to load the first graph,\n"
@@ -14579,7 +19132,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@param f: the name of the file or a Python file handle\n"
   },
   /* interface to igraph_read_graph_ncol */
-  {"Read_Ncol", (PyCFunction) igraphmodule_Graph_Read_Ncol,
+  {"Read_Ncol", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_Read_Ncol),
    METH_VARARGS | METH_KEYWORDS | METH_CLASS,
    "Read_Ncol(f, names=True, weights=\"if_present\", directed=True)\n\n"
    "Reads an .ncol file used by LGL.\n\n"
@@ -14591,7 +19144,10 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "LGL originally cannot deal with graphs containing multiple or loop\n"
    "edges, but this condition is not checked here, as igraph is happy\n"
    "with these.\n\n"
-   "@param f: the name of the file or a Python file handle\n"
+   "@param f: the name of the file, a Python file handle or a binary\n"
+   "  stream with a C{readinto()} method (e.g., C{io.BytesIO} or\n"
+   "  C{gzip.GzipFile}). Streams are read in large chunks while the\n"
+   "  file is being parsed without holding the global interpreter lock.\n"
    "@param names: If C{True}, the vertex names are added as a\n"
    "  vertex attribute called 'name'.\n"
    "@param weights: If True, the edge weights are added as an\n"
@@ -14604,7 +19160,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  directed\n"
   },
   /* interface to igraph_read_graph_lgl */
-  {"Read_Lgl", (PyCFunction) igraphmodule_Graph_Read_Lgl,
+  {"Read_Lgl", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_Read_Lgl),
    METH_VARARGS | METH_KEYWORDS | METH_CLASS,
    "Read_Lgl(f, names=True, weights=\"if_present\", directed=True)\n\n"
    "Reads an .lgl file used by LGL.\n\n"
@@ -14616,7 +19172,10 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "LGL originally cannot deal with graphs containing multiple or loop\n"
    "edges, but this condition is not checked here, as igraph is happy\n"
    "with these.\n\n"
-   "@param f: the name of the file or a Python file handle\n"
+   "@param f: the name of the file, a Python file handle or a binary\n"
+   "  stream with a C{readinto()} method (e.g., C{io.BytesIO} or\n"
+   "  C{gzip.GzipFile}). Streams are read in large chunks while the\n"
+   "  file is being parsed without holding the global interpreter lock.\n"
    "@param names: If C{True}, the vertex names are added as a\n"
    "  vertex attribute called 'name'.\n"
    "@param weights: If True, the edge weights are added as an\n"
@@ -14654,17 +19213,43 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "software package.\n\n"
    "@param f: the name of the file to be written or a Python file handle\n"
    },
+  {"write_binary", (PyCFunction) igraphmodule_Graph_write_binary,
+   METH_VARARGS | METH_KEYWORDS,
+   "write_binary(f, compress=False)\n\n"
+   "Writes the graph and its attributes to a file in a compact binary format.\n\n"
+   "The edge list and the numeric or boolean vertex and edge attributes are\n"
+   "stored as raw little-endian blocks; any other attribute is pickled.\n"
+   "The file can be loaded with L{Read_Binary()}, and the same format is\n"
+   "used when graphs are pickled.\n\n"
+   "@param f: the name of the file to be written or a Python file handle\n"
+   "@param compress: whether to compress the data with zlib\n"},
   /* interface to igraph_write_graph_edgelist */
-  {"write_edgelist", (PyCFunction) igraphmodule_Graph_write_edgelist,
+  {"write_edgelist", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_write_edgelist),
    METH_VARARGS | METH_KEYWORDS,
-   "write_edgelist(f)\n\n"
+   "write_edgelist(f, buffer_size=None)\n\n"
    "Writes the edge list of a graph to a file.\n\n"
    "Directed edges are written in (from, to) order.\n\n"
+   "@param f: the name of the file to be written or a Python file handle\n"
+   "@param buffer_size: the size of the output buffer in bytes. The\n"
+   "  file is written in chunks of this size; when C{f} is a Python object\n"
+   "  with a C{write()} method (such as a C{gzip.GzipFile}), each chunk is\n"
+   "  passed to it. The chunks are formatted without holding the global\n"
+   "  interpreter lock only if the C core of igraph was compiled with\n"
+   "  thread-local storage, which the bundled core is not (see\n"
+   "  L{set_gil_release()}).\n"},
+  {"write_snapshot", (PyCFunction) igraphmodule_Graph_write_snapshot,
+   METH_VARARGS | METH_KEYWORDS,
+   "write_snapshot(f)\n\n"
+   "Writes the graph and its attributes to a snapshot file that can be\n"
+   "opened with L{Open_Snapshot()}.\n\n"
+   "Snapshots contain the internal vectors of the graph in the native\n"
+   "byte order of the machine, so they are meant to be opened on the same\n"
+   "platform.\n\n"
    "@param f: the name of the file to be written or a Python file handle\n"},
   /* interface to igraph_write_graph_gml */
-  {"write_gml", (PyCFunction) igraphmodule_Graph_write_gml,
+  {"write_gml", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_write_gml),
    METH_VARARGS | METH_KEYWORDS,
-   "write_gml(f, creator=None, ids=None)\n\n"
+   "write_gml(f, creator=None, ids=None, buffer_size=None)\n\n"
    "Writes the graph in GML format to the given file.\n\n"
    "@param f: the name of the file to be written or a Python file handle\n"
    "@param creator: optional creator information to be written to the file.\n"
@@ -14672,11 +19257,18 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@param ids: optional numeric vertex IDs to use in the file. This must\n"
    "  be a list of integers or C{None}. If C{None}, the C{id} attribute of\n"
    "  the vertices are used, or if they don't exist, numeric vertex IDs\n"
-   "  will be generated automatically."},
+   "  will be generated automatically.\n"
+   "@param buffer_size: the size of the output buffer in bytes. The\n"
+   "  file is written in chunks of this size; when C{f} is a Python object\n"
+   "  with a C{write()} method (such as a C{gzip.GzipFile}), each chunk is\n"
+   "  passed to it. The chunks are formatted without holding the global\n"
+   "  interpreter lock only if the C core of igraph was compiled with\n"
+   "  thread-local storage, which the bundled core is not (see\n"
+   "  L{set_gil_release()}).\n"},
   /* interface to igraph_write_graph_ncol */
-  {"write_ncol", (PyCFunction) igraphmodule_Graph_write_ncol,
+  {"write_ncol", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_write_ncol),
    METH_VARARGS | METH_KEYWORDS,
-   "write_ncol(f, names=\"name\", weights=\"weights\")\n\n"
+   "write_ncol(f, names=\"name\", weights=\"weights\", buffer_size=None)\n\n"
    "Writes the edge list of a graph to a file in .ncol format.\n\n"
    "Note that multiple edges and/or loops break the LGL software,\n"
    "but igraph does not check for this condition. Unless you know\n"
@@ -14688,7 +19280,14 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  supply C{None} here.\n"
    "@param weights: the name of the edge attribute containing the weight\n"
    "  of the vertices. If you don't want to store weights,\n"
-   "  supply C{None} here.\n"},
+   "  supply C{None} here.\n"
+   "@param buffer_size: the size of the output buffer in bytes. The\n"
+   "  file is written in chunks of this size; when C{f} is a Python object\n"
+   "  with a C{write()} method (such as a C{gzip.GzipFile}), each chunk is\n"
+   "  passed to it. The chunks are formatted without holding the global\n"
+   "  interpreter lock only if the C core of igraph was compiled with\n"
+   "  thread-local storage, which the bundled core is not (see\n"
+   "  L{set_gil_release()}).\n"},
   /* interface to igraph_write_graph_lgl */
   {"write_lgl", (PyCFunction) igraphmodule_Graph_write_lgl,
    METH_VARARGS | METH_KEYWORDS,
@@ -14707,18 +19306,34 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  supply C{None} here.\n"
    "@param isolates: whether to include isolated vertices in the output.\n"},
   /* interface to igraph_write_graph_pajek */
-  {"write_pajek", (PyCFunction) igraphmodule_Graph_write_pajek,
+  {"write_pajek", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_write_pajek),
    METH_VARARGS | METH_KEYWORDS,
-   "write_pajek(f)\n\n"
+   "write_pajek(f, buffer_size=None)\n\n"
    "Writes the graph in Pajek format to the given file.\n\n"
    "@param f: the name of the file to be written or a Python file handle\n"
+   "@param buffer_size: the size of the output buffer in bytes. The\n"
+   "  file is written in chunks of this size; when C{f} is a Python object\n"
+   "  with a C{write()} method (such as a C{gzip.GzipFile}), each chunk is\n"
+   "  passed to it. The chunks are formatted without holding the global\n"
+   "  interpreter lock only if the C core of igraph was compiled with\n"
+   "  thread-local storage, which the bundled core is not (see\n"
+   "  L{set_gil_release()}).\n"
    },
   /* interface to igraph_write_graph_edgelist */
-  {"write_graphml", (PyCFunction) igraphmodule_Graph_write_graphml,
+  {"write_graphml", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_write_graphml),
    METH_VARARGS | METH_KEYWORDS,
-   "write_graphml(f)\n\n"
+   "write_graphml(f, buffer_size=None)\n\n"
    "Writes the graph to a GraphML file.\n\n"
+   "The attributes are converted in chunks of vertices and edges, so the\n"
+   "formatting of each chunk does not need the global interpreter lock.\n\n"
    "@param f: the name of the file to be written or a Python file handle\n"
+   "@param buffer_size: the size of the output buffer in bytes. The\n"
+   "  file is written in chunks of this size; when C{f} is a Python object\n"
+   "  with a C{write()} method (such as a C{gzip.GzipFile}), each chunk is\n"
+   "  passed to it. The chunks are formatted without holding the global\n"
+   "  interpreter lock only if the C core of igraph was compiled with\n"
+   "  thread-local storage, which the bundled core is not (see\n"
+   "  L{set_gil_release()}).\n"
   },
   /* interface to igraph_write_graph_leda */
   {"write_leda", (PyCFunction) igraphmodule_Graph_write_leda,
@@ -14770,6 +19385,49 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  graph will be mapped to an ID contained in the first element of this\n"
    "  vector; vertex 1 will be mapped to the second and so on.\n"
   },
+  {"canonical_form_bytes",
+   (PyCFunction) igraphmodule_Graph_canonical_form_bytes,
+   METH_VARARGS | METH_KEYWORDS,
+   "canonical_form_bytes(sh=\"fm\", color=None)\n\n"
+   "Returns the canonical form of the graph as a byte string.\n\n"
+   "Two graphs have the same canonical form (computed with the same\n"
+   "splitting heuristics) if and only if they are isomorphic, taking the\n"
+   "vertex colors into account if given. The form is built from the\n"
+   "canonical permutation computed by BLISS (see\n"
+   "L{canonical_permutation()}); it holds the number of vertices and\n"
+   "edges, the vertex colors in canonical order and the sorted edge list\n"
+   "of the relabeled graph as little-endian 32-bit integers, so it can be\n"
+   "stored and compared across processes. Graphs with multiple edges are\n"
+   "not supported.\n\n"
+   "The form is cached until the vertices or edges of the graph change,\n"
+   "along with the colors it was computed with, so calling this method\n"
+   "repeatedly is cheap.\n\n"
+   "@param sh: splitting heuristics for BLISS, see\n"
+   "  L{canonical_permutation()}.\n"
+   "@param color: optional list or name of a vertex attribute storing a\n"
+   "  coloring of the vertices. If C{None}, all vertices have the same\n"
+   "  color.\n"
+   "@return: the canonical form as a C{bytes} object\n"
+   "@see: L{canonical_hash()} for a hash of the form and\n"
+   "  L{igraph.canonical_forms()} for canonicalizing many graphs at once.\n"
+  },
+  {"canonical_hash",
+   (PyCFunction) igraphmodule_Graph_canonical_hash,
+   METH_VARARGS | METH_KEYWORDS,
+   "canonical_hash(sh=\"fm\", color=None)\n\n"
+   "Returns a 64-bit hash of the canonical form of the graph.\n\n"
+   "Isomorphic graphs have the same hash. Different hashes imply that the\n"
+   "graphs are not isomorphic, but equal hashes may (very rarely) belong\n"
+   "to non-isomorphic graphs; compare the results of\n"
+   "L{canonical_form_bytes()} when certainty is needed. The hash does not\n"
+   "depend on the platform or the Python process.\n\n"
+   "@param sh: splitting heuristics for BLISS, see\n"
+   "  L{canonical_permutation()}.\n"
+   "@param color: optional list or name of a vertex attribute storing a\n"
+   "  coloring of the vertices. If C{None}, all vertices have the same\n"
+   "  color.\n"
+   "@return: the hash as a non-negative integer\n"
+  },
   {"isoclass", (PyCFunction) igraphmodule_Graph_isoclass,
    METH_VARARGS | METH_KEYWORDS,
    "isoclass(vertices)\n\n"
@@ -15086,6 +19744,50 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@return: a list of lists, each item of the list containing the mapping\n"
    "  from vertices of the second graph to the vertices of the first one\n"},
 
+  {"get_subisomorphisms_vf2_iter",
+   (PyCFunction) igraphmodule_Graph_get_subisomorphisms_vf2_iter,
+   METH_VARARGS | METH_KEYWORDS,
+   "get_subisomorphisms_vf2_iter(other, color1=None, color2=None,\n"
+   "  edge_color1=None, edge_color2=None, node_compat_fn=None,\n"
+   "  edge_compat_fn=None, batch=1000, max_results=None, time_limit=None)\n\n"
+   "Returns an iterator over the subisomorphisms between the graph and\n"
+   "another one.\n\n"
+   "The iterator yields the mappings in batches (lists) while the search is\n"
+   "in progress, so the first results are available long before the search\n"
+   "finishes and at most one batch is kept in memory. The search is stopped\n"
+   "when the iterator is closed or garbage collected. The graphs must not be\n"
+   "modified until then.\n\n"
+   "The search can only be suspended between batches if the C core was\n"
+   "compiled with thread-local storage; the core bundled with python-igraph\n"
+   "is not. Otherwise the iterator is not lazy: C{max_results} or\n"
+   "C{time_limit} must be given, and the search is carried out up to that\n"
+   "limit when the first batch is requested, keeping all its results in\n"
+   "memory (see L{SearchIter}).\n\n"
+   "@param other: the other graph.\n"
+   "@param color1: optional vector storing the coloring of the vertices of\n"
+   "  the first graph. If C{None}, all vertices have the same color.\n"
+   "@param color2: optional vector storing the coloring of the vertices of\n"
+   "  the second graph. If C{None}, all vertices have the same color.\n"
+   "@param edge_color1: optional vector storing the coloring of the edges of\n"
+   "  the first graph. If C{None}, all edges have the same color.\n"
+   "@param edge_color2: optional vector storing the coloring of the edges of\n"
+   "  the second graph. If C{None}, all edges have the same color.\n"
+   "@param node_compat_fn: a function deciding whether two nodes are\n"
+   "  compatible; see L{get_subisomorphisms_vf2()}.\n"
+   "@param edge_compat_fn: a function deciding whether two edges are\n"
+   "  compatible; see L{get_subisomorphisms_vf2()}.\n"
+   "@param batch: the number of results in a batch.\n"
+   "@param max_results: the maximum number of results to return in total.\n"
+   "  C{None} means no limit.\n"
+   "@param time_limit: the time budget of the search in seconds. The search\n"
+   "  is stopped at the first result found after the budget ran out. C{None}\n"
+   "  means no limit.\n"
+   "@return: an iterator yielding lists of mappings from vertices of the\n"
+   "  second graph to the vertices of the first one\n"
+   "@raise RuntimeError: if neither C{max_results} nor C{time_limit} is\n"
+   "  given and the C core cannot suspend the search.\n"
+   "@see: L{get_subisomorphisms_vf2()}\n"},
+
   {"subisomorphic_lad", (PyCFunction) igraphmodule_Graph_subisomorphic_lad,
    METH_VARARGS | METH_KEYWORDS,
    "subisomorphic_lad(other, domains=None, induced=False, time_limit=0, \n"
@@ -15190,7 +19892,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  same capacity.\n"
    "@return: the value of the maximum flow between the given vertices\n"},
 
-  {"maxflow", (PyCFunction) igraphmodule_Graph_maxflow,
+  {"maxflow", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_maxflow),
    METH_VARARGS | METH_KEYWORDS,
    "maxflow(source, target, capacity=None)\n\n"
    "Returns the maximum flow between the source and target vertices.\n\n"
@@ -15230,7 +19932,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  representing a cut and the second element is a list of lists of vertex\n"
    "  IDs representing the sets of vertices that were separated by the cuts.\n"
   },
-  {"all_st_mincuts", (PyCFunction) igraphmodule_Graph_all_st_mincuts,
+  {"all_st_mincuts", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_all_st_mincuts),
    METH_VARARGS | METH_KEYWORDS,
    "all_st_mincuts(source, target)\n\n"
    "Returns all minimum cuts between the source and target vertices in a\n"
@@ -15308,7 +20010,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  advised to use that.\n"
   },
 
-  {"gomory_hu_tree", (PyCFunction) igraphmodule_Graph_gomory_hu_tree,
+  {"gomory_hu_tree", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_gomory_hu_tree),
    METH_VARARGS | METH_KEYWORDS,
    "gomory_hu_tree(capacity=None)\n\n"
    "Internal function, undocumented.\n\n"
@@ -15377,7 +20079,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
   /********************************/
   /* CLIQUES AND INDEPENDENT SETS */
   /********************************/
-  {"cliques", (PyCFunction) igraphmodule_Graph_cliques,
+  {"cliques", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_cliques),
    METH_VARARGS | METH_KEYWORDS,
    "cliques(min=0, max=0)\n\n"
    "Returns some or all cliques of the graph as a list of tuples.\n\n"
@@ -15387,7 +20089,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  negative, no lower bound will be used.\n"
    "@param max: the maximum size of cliques to be returned. If zero or\n"
    "  negative, no upper bound will be used."},
-  {"largest_cliques", (PyCFunction) igraphmodule_Graph_largest_cliques,
+  {"largest_cliques", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_largest_cliques),
    METH_NOARGS,
    "largest_cliques()\n\n"
    "Returns the largest cliques of the graph as a list of tuples.\n\n"
@@ -15396,7 +20098,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "(i.e. nonextendable) but not all maximal cliques are largest.\n\n"
    "@see: L{clique_number()} for the size of the largest cliques or\n"
    "  L{maximal_cliques()} for the maximal cliques"},
-  {"maximal_cliques", (PyCFunction) igraphmodule_Graph_maximal_cliques,
+  {"maximal_cliques", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_maximal_cliques),
    METH_VARARGS | METH_KEYWORDS,
    "maximal_cliques(min=0, max=0, file=None)\n\n"
    "Returns the maximal cliques of the graph as a list of tuples.\n\n"
@@ -15415,6 +20117,61 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@return: the maximal cliques of the graph as a list of lists, or C{None}\n"
    "  if the C{file} argument was given."
    "@see: L{largest_cliques()} for the largest cliques."},
+  {"cliques_iter", (PyCFunction) igraphmodule_Graph_cliques_iter,
+   METH_VARARGS | METH_KEYWORDS,
+   "cliques_iter(min=0, max=0, batch=1000, max_results=None, time_limit=None)\n\n"
+   "Returns an iterator over some or all cliques of the graph.\n\n"
+   "The iterator yields the cliques in batches (lists of tuples) while the\n"
+   "search is in progress, so at most one batch is kept in memory. The search\n"
+   "is stopped when the iterator is closed or garbage collected. The graph\n"
+   "must not be modified until then.\n\n"
+   "The search can only be suspended between batches if the C core was\n"
+   "compiled with thread-local storage; the core bundled with python-igraph\n"
+   "is not. Otherwise the iterator is not lazy: C{max_results} or\n"
+   "C{time_limit} must be given, and the search is carried out up to that\n"
+   "limit when the first batch is requested, keeping all its results in\n"
+   "memory (see L{SearchIter}).\n\n"
+   "@param min: the minimum size of cliques to be returned. If zero or\n"
+   "  negative, no lower bound will be used.\n"
+   "@param max: the maximum size of cliques to be returned. If zero or\n"
+   "  negative, no upper bound will be used.\n"
+   "@param batch: the number of results in a batch.\n"
+   "@param max_results: the maximum number of results to return in total.\n"
+   "  C{None} means no limit.\n"
+   "@param time_limit: the time budget of the search in seconds. The search\n"
+   "  is stopped at the first result found after the budget ran out. C{None}\n"
+   "  means no limit.\n"
+   "@raise RuntimeError: if neither C{max_results} nor C{time_limit} is\n"
+   "  given and the C core cannot suspend the search.\n"
+   "@see: L{cliques()}\n"},
+  {"maximal_cliques_iter", (PyCFunction) igraphmodule_Graph_maximal_cliques_iter,
+   METH_VARARGS | METH_KEYWORDS,
+   "maximal_cliques_iter(min=0, max=0, batch=1000, max_results=None,\n"
+   "  time_limit=None)\n\n"
+   "Returns an iterator over the maximal cliques of the graph.\n\n"
+   "The iterator yields the maximal cliques in batches (lists of tuples)\n"
+   "while the search is in progress, so at most one batch is kept in memory.\n"
+   "The search is stopped when the iterator is closed or garbage collected.\n"
+   "The graph must not be modified until then.\n\n"
+   "The search can only be suspended between batches if the C core was\n"
+   "compiled with thread-local storage; the core bundled with python-igraph\n"
+   "is not. Otherwise the iterator is not lazy: C{max_results} or\n"
+   "C{time_limit} must be given, and the search is carried out up to that\n"
+   "limit when the first batch is requested, keeping all its results in\n"
+   "memory (see L{SearchIter}).\n\n"
+   "@param min: the minimum size of maximal cliques to be returned. If zero\n"
+   "  or negative, no lower bound will be used.\n"
+   "@param max: the maximum size of maximal cliques to be returned. If zero\n"
+   "  or negative, no upper bound will be used.\n"
+   "@param batch: the number of results in a batch.\n"
+   "@param max_results: the maximum number of results to return in total.\n"
+   "  C{None} means no limit.\n"
+   "@param time_limit: the time budget of the search in seconds. The search\n"
+   "  is stopped at the first result found after the budget ran out. C{None}\n"
+   "  means no limit.\n"
+   "@raise RuntimeError: if neither C{max_results} nor C{time_limit} is\n"
+   "  given and the C core cannot suspend the search.\n"
+   "@see: L{maximal_cliques()}\n"},
   {"clique_number", (PyCFunction) igraphmodule_Graph_clique_number,
    METH_NOARGS,
    "clique_number()\n\n"
@@ -15422,7 +20179,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "The clique number of the graph is the size of the largest clique.\n\n"
    "@see: L{largest_cliques()} for the largest cliques."},
   {"independent_vertex_sets",
-   (PyCFunction) igraphmodule_Graph_independent_vertex_sets,
+   (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_independent_vertex_sets),
    METH_VARARGS | METH_KEYWORDS,
    "independent_vertex_sets(min=0, max=0)\n\n"
    "Returns some or all independent vertex sets of the graph as a list of tuples.\n\n"
@@ -15502,7 +20259,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@ref: MEJ Newman and M Girvan: Finding and evaluating community structure\n"
    "  in networks. Phys Rev E 69 026113, 2004.\n"
   },
-  {"coreness", (PyCFunction) igraphmodule_Graph_coreness,
+  {"coreness", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_coreness),
    METH_VARARGS | METH_KEYWORDS,
    "coreness(mode=ALL)\n\n"
    "Finds the coreness (shell index) of the vertices of the network.\n\n"
@@ -15518,7 +20275,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@ref: Vladimir Batagelj, Matjaz Zaversnik: I{An M{O(m)} Algorithm\n"
    "  for Core Decomposition of Networks.}"},
   {"community_fastgreedy",
-   (PyCFunction) igraphmodule_Graph_community_fastgreedy,
+   (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_community_fastgreedy),
    METH_VARARGS | METH_KEYWORDS,
    "community_fastgreedy(weights=None)\n\n"
    "Finds the community structure of the graph according to the algorithm of\n"
@@ -15541,7 +20298,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@see: modularity()\n"
   },
   {"community_infomap",
-   (PyCFunction) igraphmodule_Graph_community_infomap,
+   (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_community_infomap),
    METH_VARARGS | METH_KEYWORDS,
    "community_infomap(edge_weights=None, vertex_weights=None, trials=10)\n\n"
    "Finds the community structure of the network according to the Infomap\n"
@@ -15564,7 +20321,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  Eur Phys J Special Topics 178, 13 (2009). U{http://arxiv.org/abs/0906.1405}\n"
   },
   {"community_label_propagation",
-   (PyCFunction) igraphmodule_Graph_community_label_propagation,
+   (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_community_label_propagation),
    METH_VARARGS | METH_KEYWORDS,
    "community_label_propagation(weights=None, initial=None, fixed=None)\n\n"
    "Finds the community structure of the graph according to the label\n"
@@ -15621,7 +20378,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
   "  eigenvectors of matrices, arXiv:physics/0605087\n"
   },
   {"community_multilevel",
-   (PyCFunction) igraphmodule_Graph_community_multilevel,
+   (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_community_multilevel),
    METH_VARARGS | METH_KEYWORDS,
    "community_multilevel(weights=None, return_levels=True)\n\n"
    "Finds the community structure of the graph according to the multilevel\n"
@@ -15653,7 +20410,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@see: modularity()\n"
   },
   {"community_edge_betweenness",
-  (PyCFunction)igraphmodule_Graph_community_edge_betweenness,
+  (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_community_edge_betweenness),
   METH_VARARGS | METH_KEYWORDS,
   "community_edge_betweenness(directed=True, weights=None)\n\n"
   "Community structure detection based on the betweenness of the edges in\n"
@@ -15692,7 +20449,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "  modularity in a tuple.\n"
   },
   {"community_spinglass",
-   (PyCFunction) igraphmodule_Graph_community_spinglass,
+   (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_community_spinglass),
    METH_VARARGS | METH_KEYWORDS,
    "community_spinglass(weights=None, spins=25, parupdate=False, "
    "start_temp=1, stop_temp=0.01, cool_fact=0.99, update_rule=\"config\", "
@@ -15732,7 +20489,7 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@return: the community membership vector.\n"
   },
   {"community_leiden",
-   (PyCFunction) igraphmodule_Graph_community_leiden,
+   (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_community_leiden),
    METH_VARARGS | METH_KEYWORDS,
    "community_leiden(edge_weights=None, node_weights=None, \n"
    "     resolution_parameter=1.0, normalize_resolution=False, beta=0.01, \n"
@@ -15759,8 +20516,49 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "       algorithm. Each iteration may improve the partition further.\n"
    "     @return: the community membership vector.\n"
   },
+  {"community_ensemble",
+   (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_community_ensemble),
+   METH_VARARGS | METH_KEYWORDS,
+   "community_ensemble(method=\"multilevel\", n_runs=50, threads=1,\n"
+   "  seed=None, weights=None, resolution_parameter=1.0, beta=0.01,\n"
+   "  n_iterations=2, trials=10)\n\n"
+   "Runs a stochastic community detection method many times with\n"
+   "different random seeds, e.g. for consensus clustering.\n\n"
+   "Every run uses a random number generator of its own, seeded from\n"
+   "C{seed} and the index of the run, so the results are reproducible\n"
+   "and do not depend on the number of threads. The runs are distributed\n"
+   "among C{threads} threads that share the graph and the weights; this\n"
+   "needs a C core compiled with thread-local storage, otherwise the\n"
+   "runs are carried out one after the other.\n\n"
+   "The community detection methods of igraph always draw from the default\n"
+   "random number generator, so each thread installs its own generator as\n"
+   "the default one for the duration of its runs and restores the original\n"
+   "one afterwards, even if a run fails. The default generator is per\n"
+   "thread if the C core was compiled with thread-local storage; otherwise\n"
+   "it is shared, and the runs keep the GIL so that no other Python thread\n"
+   "draws from the replaced generator in the meantime.\n\n"
+   "@param method: the method to run: C{\"leiden\"} (optimizing\n"
+   "  modularity), C{\"multilevel\"}, C{\"label_propagation\"} or\n"
+   "  C{\"infomap\"}.\n"
+   "@param n_runs: the number of runs.\n"
+   "@param threads: the number of threads to use.\n"
+   "@param seed: the seed of the ensemble. C{None} means a seed drawn from\n"
+   "  the random number generator of igraph.\n"
+   "@param weights: edge weights to be used. Can be a sequence or\n"
+   "  iterable or even an edge attribute name.\n"
+   "@param resolution_parameter: the resolution parameter of the Leiden\n"
+   "  algorithm.\n"
+   "@param beta: the randomness of the refinement step of the Leiden\n"
+   "  algorithm.\n"
+   "@param n_iterations: the number of iterations of the Leiden algorithm\n"
+   "  in each run.\n"
+   "@param trials: the number of trials of Infomap in each run.\n"
+   "@return: a tuple of a two-dimensional L{Buffer} holding the membership\n"
+   "  vector of run M{i} in row M{i} and a L{Buffer} holding the\n"
+   "  modularity of each run.\n"
+  },
   {"community_walktrap",
-   (PyCFunction) igraphmodule_Graph_community_walktrap,
+   (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_community_walktrap),
    METH_VARARGS | METH_KEYWORDS,
    "community_walktrap(weights=None, steps=None)\n\n"
    "Finds the community structure of the graph according to the random walk\n"
@@ -15818,6 +20616,81 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "@return: a random walk that starts from the given vertex and has at most\n"
    "  the given length (shorter if the random walk got stuck)\n"
   },
+  {"random_walks", (PyCFunction) IGRAPHMODULE_PROFILED(igraphmodule_Graph_random_walks),
+   METH_VARARGS | METH_KEYWORDS,
+   "random_walks(starts=None, steps=10, walks_per_node=1, mode=\"out\",\n"
+   "  stuck=\"return\", weights=None, threads=1, seed=None)\n\n"
+   "Performs many random walks of a given length at once.\n\n"
+   "Walk M{i} starts from vertex M{starts[i // walks_per_node]}, hence the\n"
+   "walks from the same vertex are next to each other. The walks are\n"
+   "returned in an integer L{AttributeColumn} that holds them one after the\n"
+   "other. Its buffer is exported as a C-contiguous matrix of 64-bit\n"
+   "integers with one walk in each row and C{steps} columns, so e.g.\n"
+   "C{numpy.asarray(walks)} wraps it as such a matrix without copying.\n"
+   "Indexing the column itself is one-dimensional: vertex M{t} of walk\n"
+   "M{i} is C{walks[i*steps + t]}.\n\n"
+   "Weighted transitions are sampled in constant time using alias tables.\n"
+   "The walks are generated from independent random streams (one per block of\n"
+   "256 walks) derived from C{seed}, so the result depends on the seed only\n"
+   "and not on the number of threads.\n\n"
+   "@param starts: the start vertices of the walks. C{None} means all the\n"
+   "  vertices.\n"
+   "@param steps: the number of vertices in each walk, including the start\n"
+   "  vertex.\n"
+   "@param walks_per_node: the number of walks started from each start vertex.\n"
+   "@param mode: whether to follow outbound edges only (C{\"out\"}),\n"
+   "  inbound edges only (C{\"in\"}) or both (C{\"all\"}). Ignored for undirected\n"
+   "  graphs.\n"
+   "@param stuck: what to do when a walk gets stuck. C{\"return\"} fills the\n"
+   "  rest of the walk with -1, C{\"error\"} raises an exception.\n"
+   "@param weights: edge weights to be used. Can be a sequence or iterable\n"
+   "  or even an edge attribute name. The probability of following an edge is\n"
+   "  proportional to its weight. C{None} means that every edge has the same\n"
+   "  weight.\n"
+   "@param threads: the number of threads to use.\n"
+   "@param seed: the seed of the random streams. C{None} means a seed drawn\n"
+   "  from the random number generator of igraph.\n"
+   "@return: an L{AttributeColumn} of shape C{(len(starts) * walks_per_node,\n"
+   "  steps)} holding the vertices of walk M{i} in row M{i}\n"
+   "@see: L{random_walk()} for a single walk\n"},
+
+  /*********************/
+  /* MEMORY ACCOUNTING */
+  /*********************/
+  {"memory_usage", (PyCFunction) igraphmodule_Graph_memory_usage,
+   METH_VARARGS | METH_KEYWORDS,
+   "memory_usage(deep=True)\n\n"
+   "Returns the number of bytes used by the graph, broken down by component.\n\n"
+   "The result is a dict with the following keys:\n\n"
+   "  - C{structure}: a dict with the bytes allocated for the edge list\n"
+   "    (C{edges}) and for the incidence indices (C{index}) of the C core\n\n"
+   "  - C{graph_attributes}, C{vertex_attributes}, C{edge_attributes}:\n"
+   "    dicts mapping attribute names to the bytes used by their values\n\n"
+   "  - C{name_index}: the bytes used by the index of vertex names, zero if\n"
+   "    the index has not been built\n\n"
+   "  - C{canonical_forms}: the bytes used by the canonical forms cached by\n"
+   "    L{canonical_form_bytes()}, zero if there are none\n\n"
+   "  - C{cached_vectors}: a dict mapping edge attribute names to the bytes\n"
+   "    used by the numeric vectors cached from them\n\n"   "  - C{edge_index}: the bytes used by the hash table of the edges built\n"
+   "    by L{get_eids_batch()}, zero if the table has not been built\n\n"   "  - C{adjacency}: the bytes used by the adjacency lists cached for\n"
+   "    traversals and neighbor queries\n\n"
+   "  - C{object}: the bytes used by the Python object and the attribute\n"
+   "    tables themselves\n\n"
+   "  - C{snapshot}: the bytes held by the read-only snapshot of the graph,\n"
+   "    if there is one. These are not included in the total.\n\n"
+   "  - C{total}: the sum of all the above\n\n"
+   "Typed attribute columns are reported with their allocated capacity;\n"
+   "other attribute values are measured with C{sys.getsizeof()}.\n\n"
+   "@param deep: whether to count the items stored in the attribute lists\n"
+   "  (each distinct object only once) and not only the lists themselves.\n"
+   "@return: a dict as described above\n"
+   "@see: L{igraph.get_memory_stats()} for the memory used by the process\n"},
+  {"__sizeof__", (PyCFunction) igraphmodule_Graph___sizeof__,
+   METH_NOARGS,
+   "__sizeof__()\n\n"
+   "Returns the number of bytes used by the graph, not counting the items\n"
+   "stored in the attribute lists. Used by C{sys.getsizeof()}.\n\n"
+   "@see: L{memory_usage()} for a breakdown\n"},
 
   /**********************/
   /* INTERNAL FUNCTIONS */
@@ -15846,6 +20719,20 @@ struct PyMethodDef igraphmodule_Graph_methods[] = {
    "must be passed to other C code through Python.\n\n"},
 #endif
 
+  {"__getstate__",
+   (PyCFunction) igraphmodule_Graph___getstate__,
+   METH_NOARGS,
+   "__getstate__()\n\n"
+   "Returns the graph and its attributes in the binary format of\n"
+   "L{write_binary()} as a bytes object. Used for pickling.\n"},
+  {"__setstate__",
+   (PyCFunction) igraphmodule_Graph___setstate__,
+   METH_O,
+   "__setstate__(state)\n\n"
+   "Replaces the graph and its attributes with the ones stored in the\n"
+   "given object, which must be in the binary format of L{write_binary()}\n"
+   "and support the buffer protocol. Used for unpickling.\n"},
+
   {"_raw_pointer",
    (PyCFunction) igraphmodule_Graph__raw_pointer,
    METH_NOARGS,
@@ -25,7 +25,12 @@
 #include <igraph.h>
 #include "arpackobject.h"
 #include "attributes.h"
+#include "batchobject.h"
 #include "bfsiter.h"
+#include "bufferobject.h"
+#include "cancellation.h"
+#include "canonical.h"
+#include "columnobject.h"
 #include "dfsiter.h"
 #include "common.h"
 #include "convert.h"
@@ -33,8 +38,13 @@
 #include "edgeseqobject.h"
 #include "error.h"
 #include "graphobject.h"
+#include "memusage.h"
+#include "pathsiter.h"
+#include "profiling.h"
 #include "py2compat.h"
 #include "random.h"
+#include "searchiter.h"
+#include "threading.h"
 #include "vertexobject.h"
 #include "vertexseqobject.h"
 #include "operators.h"
@@ -142,12 +152,54 @@ static int igraphmodule_traverse(PyObject *m, visitproc visit, void* arg) {
 static int igraphmodule_clear(PyObject *m) {
   Py_CLEAR(GETSTATE(m)->progress_handler);
   Py_CLEAR(GETSTATE(m)->status_handler);
+  igraphmodule_Vertex_clear_freelist();
+  igraphmodule_Edge_clear_freelist();
   return 0;
 }
 #endif
 
+/**
+ * Minimum number of seconds between two calls to the progress handler or
+ * two checks for pending signals in the same thread
+ */
+static double igraphmodule_hook_interval = 0.1;
+
+/**
+ * Points of time (in terms of igraphmodule_clock()) before which the
+ * current thread does not call the progress handler and does not check
+ * for pending signals again
+ */
+static IGRAPHMODULE_THREAD_LOCAL double igraphmodule_next_progress_call = 0;
+static IGRAPHMODULE_THREAD_LOCAL double igraphmodule_next_signal_check = 0;
+
+/* The hooks below may be called from sections that have released the GIL
+ * (see threading.h), therefore they re-acquire it before touching any
+ * Python object. Since the C core may call them in every iteration of its
+ * loops, they first check the cancellation tokens of the thread and the
+ * time elapsed since the last callback, neither of which needs the GIL. */
+
 static int igraphmodule_igraph_interrupt_hook(void* data) {
-  if (PyErr_CheckSignals()) {
+  PyGILState_STATE gstate;
+  int interrupted;
+  double now;
+
+  if (igraphmodule_cancellation_check()) {
+    gstate = PyGILState_Ensure();
+    igraphmodule_cancellation_raise();
+    PyGILState_Release(gstate);
+    interrupted = 1;
+  } else {
+    now = igraphmodule_clock();
+    if (now < igraphmodule_next_signal_check)
+      return IGRAPH_SUCCESS;
+    igraphmodule_next_signal_check = now + igraphmodule_hook_interval;
+
+    gstate = PyGILState_Ensure();
+    interrupted = PyErr_CheckSignals();
+    PyGILState_Release(gstate);
+  }
+
+  if (interrupted) {
     IGRAPH_FINALLY_FREE();
     return IGRAPH_INTERRUPTED;
   }
@@ -156,8 +208,32 @@ static int igraphmodule_igraph_interrupt_hook(void* data) {
 
 int igraphmodule_igraph_progress_hook(const char* message, igraph_real_t percent,
 				       void* data) {
-  PyObject* progress_handler = GETSTATE(0)->progress_handler;
+  PyObject* progress_handler;
+  PyGILState_STATE gstate;
+  int retval = IGRAPH_SUCCESS;
+  double now;
+
+  if (igraphmodule_cancellation_check()) {
+    gstate = PyGILState_Ensure();
+    igraphmodule_cancellation_raise();
+    PyGILState_Release(gstate);
+    return IGRAPH_INTERRUPTED;
+  }
+
+  /* Peeking at the handler without the GIL is fine; it is read again
+   * below once we hold the GIL */
+  if (GETSTATE(0)->progress_handler == 0)
+    return IGRAPH_SUCCESS;
+
+  /* The start and the end of an operation are always reported */
+  now = igraphmodule_clock();
+  if (percent > 0 && percent < 100 && now < igraphmodule_next_progress_call)
+    return IGRAPH_SUCCESS;
+  igraphmodule_next_progress_call = now + igraphmodule_hook_interval;
+
+  gstate = PyGILState_Ensure();
 
+  progress_handler = GETSTATE(0)->progress_handler;
   if (progress_handler) {
     PyObject *result;
     if (PyCallable_Check(progress_handler)) {
@@ -166,16 +242,23 @@ int igraphmodule_igraph_progress_hook(const char* message, igraph_real_t percent
       if (result)
         Py_DECREF(result);
       else
-        return IGRAPH_INTERRUPTED;
+        retval = IGRAPH_INTERRUPTED;
     }
   }
-  
-  return IGRAPH_SUCCESS;
+
+  PyGILState_Release(gstate);
+
+  return retval;
 }
 
 int igraphmodule_igraph_status_hook(const char* message, void*data) {
-  PyObject* status_handler = GETSTATE(0)->status_handler;
+  PyObject* status_handler;
+  PyGILState_STATE gstate;
+  int retval = IGRAPH_SUCCESS;
+
+  gstate = PyGILState_Ensure();
 
+  status_handler = GETSTATE(0)->status_handler;
   if (status_handler) {
     PyObject *result;
     if (PyCallable_Check(status_handler)) {
@@ -183,11 +266,13 @@ int igraphmodule_igraph_status_hook(const char* message, void*data) {
       if (result)
         Py_DECREF(result);
       else
-        return IGRAPH_INTERRUPTED;
+        retval = IGRAPH_INTERRUPTED;
     }
   }
-  
-  return IGRAPH_SUCCESS;
+
+  PyGILState_Release(gstate);
+
+  return retval;
 }
 
 PyObject* igraphmodule_set_progress_handler(PyObject* self, PyObject* o) {
@@ -211,6 +296,28 @@ PyObject* igraphmodule_set_progress_handler(PyObject* self, PyObject* o) {
   Py_RETURN_NONE;
 }
 
+PyObject* igraphmodule_get_hook_interval(PyObject* self) {
+  return PyFloat_FromDouble(igraphmodule_hook_interval);
+}
+
+PyObject* igraphmodule_set_hook_interval(PyObject* self, PyObject* o) {
+  double interval = PyFloat_AsDouble(o);
+
+  if (interval == -1 && PyErr_Occurred())
+    return NULL;
+
+  if (interval < 0) {
+    PyErr_SetString(PyExc_ValueError, "interval must not be negative");
+    return NULL;
+  }
+
+  igraphmodule_hook_interval = interval;
+  igraphmodule_next_progress_call = 0;
+  igraphmodule_next_signal_check = 0;
+
+  Py_RETURN_NONE;
+}
+
 PyObject* igraphmodule_set_status_handler(PyObject* self, PyObject* o) {
   PyObject* status_handler;
 
@@ -555,6 +662,30 @@ PyObject* igraphmodule_split_join_distance(PyObject *self,
  */
 static PyMethodDef igraphmodule_methods[] = 
 {
+  {"canonical_forms", (PyCFunction)igraphmodule_canonical_forms,
+    METH_VARARGS | METH_KEYWORDS,
+    "canonical_forms(graphs, sh=\"fm\", color=None, hashes=False, threads=None)\n\n"
+    "Returns the canonical forms of a list of graphs.\n\n"
+    "This is the batch version of L{Graph.canonical_form_bytes()} and\n"
+    "L{Graph.canonical_hash()}, meant for deduplicating large collections\n"
+    "of small graphs: isomorphic graphs get the same form, so the forms can\n"
+    "be used as dictionary keys. Forms that are already cached in a graph\n"
+    "are reused; the others are computed with the global interpreter lock\n"
+    "released and cached in the graphs.\n\n"
+    "@param graphs: the graphs\n"
+    "@param sh: splitting heuristics for BLISS, see\n"
+    "  L{Graph.canonical_permutation()}.\n"
+    "@param color: the name of a vertex attribute storing a coloring of the\n"
+    "  vertices of each graph, or C{None} if all vertices have the same\n"
+    "  color.\n"
+    "@param hashes: whether to return the 64-bit hashes of the forms (see\n"
+    "  L{Graph.canonical_hash()}) instead of the forms themselves.\n"
+    "@param threads: the number of threads to use. The graphs are only\n"
+    "  canonicalized in parallel if the C core of igraph was compiled with\n"
+    "  thread-local storage; otherwise a single thread is used.\n"
+    "@return: a list of C{bytes} objects or integers, in the order of the\n"
+    "  graphs\n"
+  },
   {"community_to_membership", (PyCFunction)igraphmodule_community_to_membership,
     METH_VARARGS | METH_KEYWORDS,
     "community_to_membership(merges, nodes, steps, return_csize=False)"
@@ -579,6 +710,64 @@ static PyMethodDef igraphmodule_methods[] =
     "  indices corresponding to them, depending on the C{coords}\n"
     "  parameter."
   },
+  {"get_gil_release", (PyCFunction)igraphmodule_get_gil_release, METH_NOARGS,
+      "get_gil_release()\n\n"
+      "Returns whether long-running methods of L{Graph} release the global\n"
+      "interpreter lock while the C core is working. This is always C{False}\n"
+      "with the C core bundled with python-igraph, which is compiled without\n"
+      "thread-local storage.\n\n"
+      "@return: C{True} if the global interpreter lock is released, C{False}\n"
+      "  otherwise.\n"
+      "@see: L{set_gil_release()}\n"
+  },
+  {"get_hook_interval", (PyCFunction)igraphmodule_get_hook_interval, METH_NOARGS,
+      "get_hook_interval()\n\n"
+      "Returns the minimum number of seconds between two calls to the\n"
+      "progress handler and between two checks for pending signals.\n\n"
+      "@return: the interval in seconds.\n"
+      "@see: L{set_hook_interval()}\n"
+  },
+  {"get_memory_stats", (PyCFunction)igraphmodule_get_memory_stats, METH_NOARGS,
+      "get_memory_stats()\n\n"
+      "Returns global memory statistics of the igraph module.\n\n"
+      "The result is a dict with the following keys:\n\n"
+      "  - C{buffer_bytes}, C{buffer_objects}: the bytes allocated for and\n"
+      "    the number of live buffer objects returned by methods called with\n"
+      "    C{return_type=\"buffer\"}\n\n"
+      "  - C{column_bytes}, C{column_objects}: the bytes allocated for and\n"
+      "    the number of live typed attribute columns\n\n"
+      "  - C{heap_in_use}, C{heap_reserved}: the bytes in use and the bytes\n"
+      "    obtained from the operating system by the C heap of the process,\n"
+      "    which also serves the C core of igraph. C{None} if the platform\n"
+      "    does not provide these statistics.\n\n"
+      "@return: a dict as described above\n"
+      "@see: L{Graph.memory_usage()} for the memory used by a single graph\n"
+  },
+  {"get_profile_stats", (PyCFunction)igraphmodule_get_profile_stats, METH_NOARGS,
+      "get_profile_stats()\n\n"
+      "Returns the statistics collected about the calls of the methods of\n"
+      "L{Graph} since profiling was enabled or the statistics were reset.\n\n"
+      "Only the methods that release the global interpreter lock around\n"
+      "their call to the C core are instrumented (e.g., betweenness,\n"
+      "closeness, shortest paths, community detection and the readers and\n"
+      "writers of the common file formats).\n\n"
+      "@return: a dict mapping method names (such as C{\"Graph.closeness\"})\n"
+      "  to dicts with the following keys: C{calls} (the number of calls),\n"
+      "  C{input_ns} (nanoseconds spent converting the arguments),\n"
+      "  C{core_ns} (nanoseconds spent in the C core), C{output_ns}\n"
+      "  (nanoseconds spent converting the results) and C{bytes} (the number\n"
+      "  of bytes allocated by Python during the calls; always zero before\n"
+      "  Python 3.5). Calls that fail before reaching the C core count as\n"
+      "  input conversion only.\n"
+      "@see: L{set_profiling()}, L{reset_profile_stats()},\n"
+      "  L{profile_stats_to_prometheus()}\n"
+  },
+  {"get_profiling", (PyCFunction)igraphmodule_get_profiling, METH_NOARGS,
+      "get_profiling()\n\n"
+      "Returns whether statistics are collected about method calls.\n\n"
+      "@return: C{True} if profiling is enabled, C{False} otherwise.\n"
+      "@see: L{set_profiling()}\n"
+  },
   {"is_degree_sequence", (PyCFunction)igraphmodule_is_degree_sequence,
     METH_VARARGS | METH_KEYWORDS,
     "is_degree_sequence(out_deg, in_deg=None)\n\n"
@@ -615,16 +804,79 @@ static PyMethodDef igraphmodule_methods[] =
     "  degree sequence, C{False} otherwise.\n"
     "@see: L{is_degree_sequence()} if you want to allow multiple or loop edges.\n"
   },
+  {"set_gil_release", igraphmodule_set_gil_release, METH_O,
+      "set_gil_release(enabled)\n\n"
+      "Sets whether long-running methods of L{Graph} (e.g., betweenness,\n"
+      "shortest paths, community detection, clique finding, layouts) should\n"
+      "release the global interpreter lock while the C core is working,\n"
+      "allowing other Python threads to run in the meanwhile.\n\n"
+      "Inputs are converted before the lock is released, and the lock is\n"
+      "re-acquired whenever igraph needs to call back to Python (progress and\n"
+      "status handlers, interruption checks, attribute handling and the\n"
+      "Python random number generator). A graph cannot be modified while\n"
+      "such a computation is running on it, either from another thread or\n"
+      "from a callback of the computation; attempts to do so raise a\n"
+      "C{RuntimeError}.\n\n"
+      "This is enabled by default if the C core of igraph was compiled with\n"
+      "thread-local storage, allowing several computations to run on\n"
+      "multiple cores at the same time. Otherwise the C core keeps its error\n"
+      "handling state in global variables that any igraph call made by\n"
+      "another thread in the meanwhile would trample on, so the lock is\n"
+      "always kept and enabling the release raises a C{RuntimeError}.\n\n"
+      "The C core bundled with python-igraph is compiled without\n"
+      "thread-local storage, so the lock is only ever released if\n"
+      "python-igraph is linked to an igraph library built with it (see the\n"
+      "installation instructions).\n\n"
+      "@param enabled: whether to release the global interpreter lock.\n"
+      "@raise RuntimeError: if I{enabled} is true and the C core is not\n"
+      "  thread-safe.\n"
+  },
+  {"reset_profile_stats", (PyCFunction)igraphmodule_reset_profile_stats, METH_NOARGS,
+      "reset_profile_stats()\n\n"
+      "Resets the statistics returned by L{get_profile_stats()} to zero.\n"
+  },
+  {"set_hook_interval", igraphmodule_set_hook_interval, METH_O,
+      "set_hook_interval(interval)\n\n"
+      "Sets the minimum number of seconds between two calls to the progress\n"
+      "handler and between two checks for pending signals (e.g.,\n"
+      "C{KeyboardInterrupt}) while igraph is performing a long operation.\n\n"
+      "The C core reports its progress and checks for interruptions in its\n"
+      "inner loops; calling back to Python every time would take a\n"
+      "considerable share of the running time. The start and the end of an\n"
+      "operation (0 and 100 percent) are always reported to the progress\n"
+      "handler. L{CancellationToken}s are checked every time, regardless of\n"
+      "this setting. The default is 0.1 seconds.\n\n"
+      "@param interval: the interval in seconds. Zero means that the\n"
+      "  progress handler is called and signals are checked every time\n"
+      "  the C core asks for it.\n"
+      "@see: L{get_hook_interval()}\n"
+  },
   {"set_progress_handler", igraphmodule_set_progress_handler, METH_O,
       "set_progress_handler(handler)\n\n"
       "Sets the handler to be called when igraph is performing a long operation.\n"
+      "The handler is called at most once in every interval set by\n"
+      "L{set_hook_interval()}, except at the start and the end of an operation.\n"
       "@param handler: the progress handler function. It must accept two\n"
       "  arguments, the first is the message informing the user about\n"
       "  what igraph is doing right now, the second is the actual\n"
       "  progress information (a percentage).\n"
   },
-  {"set_random_number_generator", igraph_rng_Python_set_generator, METH_O,
-      "set_random_number_generator(generator)\n\n"
+  {"set_profiling", igraphmodule_set_profiling, METH_O,
+      "set_profiling(enabled)\n\n"
+      "Sets whether statistics should be collected about the calls of the\n"
+      "methods of L{Graph}, splitting their running time between the\n"
+      "conversion of the arguments, the C core and the conversion of the\n"
+      "results. Disabled by default; when disabled, the instrumentation\n"
+      "costs a single branch per call.\n\n"
+      "Enabling profiling also counts the memory allocated by Python during\n"
+      "the calls by wrapping the memory allocators of Python, which slows\n"
+      "down every allocation slightly.\n\n"
+      "@param enabled: whether to collect statistics.\n"
+      "@see: L{get_profile_stats()}\n"
+  },
+  {"set_random_number_generator", (PyCFunction)igraph_rng_Python_set_generator,
+      METH_VARARGS | METH_KEYWORDS,
+      "set_random_number_generator(generator, batch_size=1)\n\n"
       "Sets the random number generator used by igraph.\n"
       "@param generator: the generator to be used. It must be a Python object\n"
       "  with at least three attributes: C{random}, C{randint} and C{gauss}.\n"
@@ -633,9 +885,18 @@ static PyMethodDef igraphmodule_methods[] =
       "  C{random.gauss}. By default, igraph uses the C{random} module for\n"
       "  random number generation, but you can supply your alternative\n"
       "  implementation here. If the given generator is C{None}, igraph\n"
-      "  reverts to the default Mersenne twister generator implemented in the\n"
-      "  C layer, which might be slightly faster than calling back to Python\n"
-      "  for random numbers, but you cannot set its seed or save its state.\n"
+      "  installs a Mersenne twister generator implemented in the C layer and\n"
+      "  owned by the module. It is seeded from the current time when it is\n"
+      "  installed for the first time and keeps its state when it is\n"
+      "  installed again; it is not accessible from Python, so use a\n"
+      "  L{FastRNG} instance instead if you need to set the seed of a\n"
+      "  generator that does not call back to Python.\n"
+      "@param batch_size: the number of random numbers to draw at once from\n"
+      "  a Python generator. Values larger than 1 reduce the overhead of\n"
+      "  calling back to Python, but the random numbers will be consumed in\n"
+      "  a different order than without batching, and drawing from the\n"
+      "  generator outside igraph does not affect the numbers already\n"
+      "  drawn in advance. Ignored for L{FastRNG} instances and C{None}.\n"
   },
   {"set_status_handler", igraphmodule_set_status_handler, METH_O,
       "set_status_handler(handler)\n\n"
@@ -658,11 +919,12 @@ static PyMethodDef igraphmodule_methods[] =
   },
   {"_union", (PyCFunction)igraphmodule__union,
     METH_VARARGS | METH_KEYWORDS,
-    "_union(graphs, edgemaps)"
+    "_union(graphs, edgemaps=False, byname=False, combine_edges=None)"
   },
   {"_intersection", (PyCFunction)igraphmodule__intersection,
     METH_VARARGS | METH_KEYWORDS,
-    "_intersection(graphs, edgemaps)"
+    "_intersection(graphs, edgemaps=False, byname=False,\n"
+    "              keep_all_vertices=True, combine_edges=None)"
   },
   {NULL, NULL, 0, NULL}
 };
@@ -761,6 +1023,8 @@ extern PyObject* igraphmodule_arpack_options_default;
   /* Initialize VertexSeq, EdgeSeq */
   if (PyType_Ready(&igraphmodule_VertexSeqType) < 0)
     INITERROR;
+  if (PyType_Ready(&igraphmodule_VertexSeqCursorType) < 0)
+    INITERROR;
   if (PyType_Ready(&igraphmodule_EdgeSeqType) < 0)
     INITERROR;
   
@@ -782,6 +1046,22 @@ extern PyObject* igraphmodule_arpack_options_default;
     INITERROR;
   if (PyType_Ready(&igraphmodule_ARPACKOptionsType) < 0)
     INITERROR;
+  if (PyType_Ready(&igraphmodule_ARPACKSessionType) < 0)
+    INITERROR;
+  if (PyType_Ready(&igraphmodule_BufferType) < 0)
+    INITERROR;
+  if (PyType_Ready(&igraphmodule_ColumnType) < 0)
+    INITERROR;
+  if (PyType_Ready(&igraphmodule_FastRNGType) < 0)
+    INITERROR;
+  if (PyType_Ready(&igraphmodule_ShortestPathsIterType) < 0)
+    INITERROR;
+  if (PyType_Ready(&igraphmodule_SearchIterType) < 0)
+    INITERROR;
+  if (PyType_Ready(&igraphmodule_CancellationTokenType) < 0)
+    INITERROR;
+  if (PyType_Ready(&igraphmodule_GraphBatchType) < 0)
+    INITERROR;
 
   /* Initialize the core module */
 #ifdef IGRAPH_PYTHON3
@@ -796,13 +1076,25 @@ extern PyObject* igraphmodule_arpack_options_default;
   /* Initialize random number generator */
   igraphmodule_init_rng(m);
 
+  /* Initialize threading support */
+  if (igraphmodule_init_threading())
+    INITERROR;
+
   /* Add the types to the core module */
   PyModule_AddObject(m, "GraphBase", (PyObject*)&igraphmodule_GraphType);
   PyModule_AddObject(m, "BFSIter", (PyObject*)&igraphmodule_BFSIterType);
   PyModule_AddObject(m, "DFSIter", (PyObject*)&igraphmodule_DFSIterType);
   PyModule_AddObject(m, "ARPACKOptions", (PyObject*)&igraphmodule_ARPACKOptionsType);
+  PyModule_AddObject(m, "ARPACKSession", (PyObject*)&igraphmodule_ARPACKSessionType);
+  PyModule_AddObject(m, "AttributeColumn", (PyObject*)&igraphmodule_ColumnType);
+  PyModule_AddObject(m, "Buffer", (PyObject*)&igraphmodule_BufferType);
+  PyModule_AddObject(m, "CancellationToken", (PyObject*)&igraphmodule_CancellationTokenType);
   PyModule_AddObject(m, "Edge", (PyObject*)&igraphmodule_EdgeType);
   PyModule_AddObject(m, "EdgeSeq", (PyObject*)&igraphmodule_EdgeSeqType);
+  PyModule_AddObject(m, "FastRNG", (PyObject*)&igraphmodule_FastRNGType);
+  PyModule_AddObject(m, "GraphBatch", (PyObject*)&igraphmodule_GraphBatchType);
+  PyModule_AddObject(m, "SearchIter", (PyObject*)&igraphmodule_SearchIterType);
+  PyModule_AddObject(m, "ShortestPathsIter", (PyObject*)&igraphmodule_ShortestPathsIterType);
   PyModule_AddObject(m, "Vertex", (PyObject*)&igraphmodule_VertexType);
   PyModule_AddObject(m, "VertexSeq", (PyObject*)&igraphmodule_VertexSeqType);
  
@@ -811,6 +1103,11 @@ extern PyObject* igraphmodule_arpack_options_default;
     PyErr_NewException("igraph._igraph.InternalError", PyExc_Exception, NULL);
   PyModule_AddObject(m, "InternalError", igraphmodule_InternalError);
 
+  /* Exception type raised by computations stopped by a cancellation token */
+  igraphmodule_CancelledError =
+    PyErr_NewException("igraph._igraph.CancelledError", PyExc_Exception, NULL);
+  PyModule_AddObject(m, "CancelledError", igraphmodule_CancelledError);
+
   /* ARPACK default options variable */
   igraphmodule_arpack_options_default = igraphmodule_ARPACKOptions_new();
   PyModule_AddObject(m, "arpack_options", igraphmodule_arpack_options_default);
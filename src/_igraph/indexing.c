@@ -22,6 +22,7 @@
 */
 
 #include "attributes.h"
+#include "adjacency.h"
 #include "convert.h"
 #include "error.h"
 #include "indexing.h"
@@ -34,7 +35,6 @@
 static PyObject* igraphmodule_i_Graph_adjmatrix_indexing_get_value_for_vertex_pair(
     igraph_t* graph, igraph_integer_t from, igraph_integer_t to, PyObject* values) {
   igraph_integer_t eid;
-  PyObject* result;
 
   /* Retrieving a single edge */
   igraph_get_eid(graph, &eid, from, to, /* directed = */1, /* error = */0);
@@ -43,9 +43,7 @@ static PyObject* igraphmodule_i_Graph_adjmatrix_indexing_get_value_for_vertex_pa
     if (values == 0) {
       return PyInt_FromLong(1L);
     } else {
-      result = PyList_GetItem(values, eid);
-      Py_XINCREF(result);
-      return result;
+      return igraphmodule_attribute_values_get_item(values, eid);
     }
   } else {
     /* No such edge, return zero */
@@ -140,14 +138,24 @@ static PyObject* igraphmodule_i_Graph_adjmatrix_get_index_row(igraph_t* graph,
   PyObject *result = 0, *item;
   long int i, n;
   igraph_integer_t v;
+  igraphmodule_adjacency_t *adj;
+  const long int *cached = 0;
 
   if (igraph_vs_is_all(to)) {
-    /* Simple case: all edges */
+    /* Simple case: all edges, taken from the cached adjacency lists if
+     * possible */
     IGRAPH_PYCHECK(igraph_vector_init(&eids, 0));
     IGRAPH_FINALLY(igraph_vector_destroy, &eids);
-    IGRAPH_PYCHECK(igraph_incident(graph, &eids, from, neimode));
-    
-    n = igraph_vector_size(&eids);
+
+    adj = igraphmodule_get_adjacency(graph, neimode, 0);
+    if (adj) {
+      cached = adj->edges + adj->offsets[(long int)from];
+      n = IGRAPHMODULE_ADJACENCY_DEGREE(adj, (long int)from);
+    } else {
+      IGRAPH_PYCHECK(igraph_incident(graph, &eids, from, neimode));
+      n = igraph_vector_size(&eids);
+    }
+
     result = igraphmodule_PyList_Zeroes(igraph_vcount(graph));
     if (result == 0) {
       IGRAPH_FINALLY_FREE();
@@ -155,13 +163,17 @@ static PyObject* igraphmodule_i_Graph_adjmatrix_get_index_row(igraph_t* graph,
     }
 
     for (i = 0; i < n; i++) {
-      eid = (igraph_integer_t)VECTOR(eids)[i];
+      eid = (igraph_integer_t)(cached ? cached[i] : VECTOR(eids)[i]);
       v = IGRAPH_OTHER(graph, eid, from);
       if (values)
-        item = PyList_GetItem(values, eid);
+        item = igraphmodule_attribute_values_get_item(values, eid);
       else
         item = PyInt_FromLong(1);
-      Py_INCREF(item);
+      if (item == 0) {
+        Py_DECREF(result);
+        IGRAPH_FINALLY_FREE();
+        return 0;
+      }
       PyList_SetItem(result, v, item);   /* reference stolen here */
     }
 
@@ -436,7 +448,8 @@ int igraphmodule_Graph_adjmatrix_set_index(igraph_t* graph,
 
   if (attr_name == 0) {
     /* Using the "weight" attribute by default */
-    values = igraphmodule_get_edge_attribute_values(graph, "weight");
+    values = igraphmodule_has_edge_attribute(graph, "weight") ?
+      igraphmodule_create_or_get_edge_attribute_values(graph, "weight") : 0;
   } else {
     /* Specifying the name of the attribute */
     attr = igraphmodule_PyObject_ConvertToCString(attr_name);
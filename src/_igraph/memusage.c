@@ -0,0 +1,493 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#include "memusage.h"
+#include "attributes.h"
+#include "bufferobject.h"
+#include "columnobject.h"
+#include "py2compat.h"
+
+#if defined(__GLIBC__)
+#  include <malloc.h>
+#  if __GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33)
+#    define IGRAPHMODULE_HAVE_MALLINFO2 1
+#  else
+#    define IGRAPHMODULE_HAVE_MALLINFO 1
+#  endif
+#elif defined(__APPLE__)
+#  include <malloc/malloc.h>
+#  define IGRAPHMODULE_HAVE_MALLOC_ZONE_STATISTICS 1
+#endif
+
+/**
+ * \ingroup python_interface_memusage
+ * \brief Live bytes and objects in each category tracked by the interface.
+ *
+ * Only modified with the GIL held.
+ */
+static Py_ssize_t igraphmodule_i_memory_bytes[IGRAPHMODULE_MEMORY_CATEGORIES];
+static Py_ssize_t igraphmodule_i_memory_objects[IGRAPHMODULE_MEMORY_CATEGORIES];
+
+/**
+ * \ingroup python_interface_memusage
+ * \brief Records the allocation (positive numbers) or release (negative
+ *        numbers) of memory allocated by the interface itself
+ */
+void igraphmodule_memory_track(igraphmodule_memory_category_t category,
+    Py_ssize_t bytes, Py_ssize_t objects) {
+  igraphmodule_i_memory_bytes[category] += bytes;
+  igraphmodule_i_memory_objects[category] += objects;
+}
+
+/**
+ * \ingroup python_interface_memusage
+ * \brief State of a single memory usage query
+ */
+typedef struct {
+  // Whether the items of the attribute values are counted as well
+  int deep;
+  // sys.getsizeof
+  PyObject* getsizeof;
+  // The identities of the items counted so far (deep queries only), so
+  // that items shared between vertices, edges or attributes are counted
+  // only once
+  PyObject* seen;
+} igraphmodule_i_memusage_t;
+
+static Py_ssize_t igraphmodule_i_vector_bytes(const igraph_vector_t* v) {
+  return (v->stor_end - v->stor_begin) * sizeof(igraph_real_t);
+}
+
+/**
+ * \ingroup python_interface_memusage
+ * \brief Returns the size of an object including the storage it owns.
+ *
+ * Columns and buffers are handled here since the storage they own is not
+ * reported by their \c __sizeof__ method.
+ *
+ * \return the size or -1 if an exception was raised
+ */
+static Py_ssize_t igraphmodule_i_memusage_sizeof(igraphmodule_i_memusage_t* ctx,
+    PyObject* o) {
+  PyObject* result;
+  Py_ssize_t size;
+
+  if (igraphmodule_Column_Check(o))
+    return igraphmodule_Column_allocated_bytes((igraphmodule_ColumnObject*)o);
+  if (PyObject_TypeCheck(o, &igraphmodule_BufferType))
+    return igraphmodule_Buffer_allocated_bytes((igraphmodule_BufferObject*)o);
+
+  result = PyObject_CallFunctionObjArgs(ctx->getsizeof, o, NULL);
+  if (result == 0)
+    return -1;
+  size = PyLong_AsSsize_t(result);
+  Py_DECREF(result);
+
+  return size;
+}
+
+/**
+ * \ingroup python_interface_memusage
+ * \brief Adds the size of an object to the given total unless it has been
+ *        counted already in a deep query
+ *
+ * \return 0 if everything was OK, 1 otherwise
+ */
+static int igraphmodule_i_memusage_add(igraphmodule_i_memusage_t* ctx,
+    PyObject* o, Py_ssize_t* total) {
+  PyObject* key;
+  Py_ssize_t size;
+  int seen;
+
+  if (ctx->seen) {
+    key = PyLong_FromVoidPtr(o);
+    if (key == 0)
+      return 1;
+    seen = PySet_Contains(ctx->seen, key);
+    if (seen == 0)
+      seen = PySet_Add(ctx->seen, key) ? -1 : 0;
+    Py_DECREF(key);
+    if (seen < 0)
+      return 1;
+    if (seen)
+      return 0;
+  }
+
+  size = igraphmodule_i_memusage_sizeof(ctx, o);
+  if (size < 0)
+    return 1;
+
+  *total += size;
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_memusage
+ * \brief Adds the size of a container (and of its items in deep queries)
+ *
+ * Lists, tuples and dicts are recognized as containers; the keys and
+ * values of a dict are counted as its items.
+ */
+static int igraphmodule_i_memusage_add_container(igraphmodule_i_memusage_t* ctx,
+    PyObject* o, Py_ssize_t* total) {
+  PyObject *key, *value;
+  Py_ssize_t i, n, pos = 0;
+
+  if (igraphmodule_i_memusage_add(ctx, o, total))
+    return 1;
+
+  if (!ctx->deep)
+    return 0;
+
+  if (PyList_Check(o)) {
+    n = PyList_GET_SIZE(o);
+    for (i = 0; i < n; i++) {
+      if (igraphmodule_i_memusage_add(ctx, PyList_GET_ITEM(o, i), total))
+        return 1;
+    }
+  } else if (PyTuple_Check(o)) {
+    n = PyTuple_GET_SIZE(o);
+    for (i = 0; i < n; i++) {
+      if (igraphmodule_i_memusage_add(ctx, PyTuple_GET_ITEM(o, i), total))
+        return 1;
+    }
+  } else if (PyDict_Check(o)) {
+    while (PyDict_Next(o, &pos, &key, &value)) {
+      if (igraphmodule_i_memusage_add(ctx, key, total) ||
+          igraphmodule_i_memusage_add(ctx, value, total))
+        return 1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_memusage
+ * \brief Stores a size in a dict under the given key
+ */
+static int igraphmodule_i_memusage_set(PyObject* dict, const char* key,
+    Py_ssize_t size) {
+  PyObject* value = PyLong_FromSsize_t(size);
+  int retval;
+
+  if (value == 0)
+    return 1;
+  retval = PyDict_SetItemString(dict, key, value);
+  Py_DECREF(value);
+
+  return retval ? 1 : 0;
+}
+
+/**
+ * \ingroup python_interface_memusage
+ * \brief Stores a sub-dict in a dict under the given key
+ */
+static int igraphmodule_i_memusage_set_dict(PyObject* dict, const char* key,
+    PyObject* value) {
+  int retval;
+
+  if (value == 0)
+    return 1;
+  retval = PyDict_SetItemString(dict, key, value);
+  Py_DECREF(value);
+
+  return retval ? 1 : 0;
+}
+
+/**
+ * \ingroup python_interface_memusage
+ * \brief Returns a dict mapping the keys of an attribute dict (or of the
+ *        edge vector cache) to the number of bytes used by their values
+ */
+static PyObject* igraphmodule_i_memusage_attributes(igraphmodule_i_memusage_t* ctx,
+    PyObject* attrs, Py_ssize_t* total) {
+  PyObject *result, *key, *value, *size_o;
+  Py_ssize_t pos = 0, size;
+
+  result = PyDict_New();
+  if (result == 0 || attrs == 0)
+    return result;
+
+  while (PyDict_Next(attrs, &pos, &key, &value)) {
+    size = 0;
+    if (igraphmodule_i_memusage_add_container(ctx, value, &size)) {
+      Py_DECREF(result);
+      return 0;
+    }
+    size_o = PyLong_FromSsize_t(size);
+    if (size_o == 0 || PyDict_SetItem(result, key, size_o)) {
+      Py_XDECREF(size_o);
+      Py_DECREF(result);
+      return 0;
+    }
+    Py_DECREF(size_o);
+    *total += size;
+  }
+
+  return result;
+}
+
+/**
+ * \ingroup python_interface_memusage
+ * \brief Fills the memory usage breakdown of a graph.
+ *
+ * \param result  the dict to fill, or \c NULL if only the total is needed
+ * \param total   the total number of bytes is returned here
+ * \return 0 if everything was OK, 1 otherwise
+ */
+static int igraphmodule_i_Graph_memory_usage(igraphmodule_GraphObject* self,
+    igraphmodule_i_memusage_t* ctx, PyObject* result, Py_ssize_t* total) {
+  igraph_t* graph = &self->g;
+  igraphmodule_i_attribute_struct* attrs = ATTR_STRUCT(graph);
+  PyObject *structure, *sub;
+  Py_ssize_t edges, index, object, name_index, edge_index, adjacency, attributes;
+  Py_ssize_t canonical_forms;
+  static const char* attr_keys[3] = {
+    "graph_attributes", "vertex_attributes", "edge_attributes"
+  };
+  int i;
+
+  edges = igraphmodule_i_vector_bytes(&graph->from) +
+    igraphmodule_i_vector_bytes(&graph->to);
+  index = igraphmodule_i_vector_bytes(&graph->oi) +
+    igraphmodule_i_vector_bytes(&graph->ii) +
+    igraphmodule_i_vector_bytes(&graph->os) +
+    igraphmodule_i_vector_bytes(&graph->is);
+
+  /* The Python object, the attribute table and the attribute dicts
+   * themselves (without their values) */
+  object = Py_TYPE(self)->tp_basicsize + sizeof(igraphmodule_i_attribute_struct);
+  for (i = 0; i < 3; i++) {
+    PyObject* size_o = PyObject_CallFunctionObjArgs(ctx->getsizeof,
+        attrs->attrs[i], NULL);
+    if (size_o == 0)
+      return 1;
+    object += PyLong_AsSsize_t(size_o);
+    Py_DECREF(size_o);
+  }
+
+  edge_index = igraphmodule_edge_index_bytes(attrs->edge_index);
+  adjacency = 0;
+  for (i = 0; i < 3; i++) {
+    adjacency += igraphmodule_adjacency_bytes(attrs->adjacency[i]);
+  }
+  *total = edges + index + edge_index + adjacency + object;
+
+  if (result) {
+    structure = PyDict_New();
+    if (structure == 0 ||
+        igraphmodule_i_memusage_set(structure, "edges", edges) ||
+        igraphmodule_i_memusage_set(structure, "index", index)) {
+      Py_XDECREF(structure);
+      return 1;
+    }
+    if (igraphmodule_i_memusage_set_dict(result, "structure", structure) ||
+        igraphmodule_i_memusage_set(result, "edge_index", edge_index) ||
+        igraphmodule_i_memusage_set(result, "adjacency", adjacency) ||
+        igraphmodule_i_memusage_set(result, "object", object) ||
+        igraphmodule_i_memusage_set(result, "snapshot",
+          self->snapshot ? self->snapshot_view.len : 0))
+      return 1;
+  }
+
+  for (i = 0; i < 3; i++) {
+    attributes = 0;
+    sub = igraphmodule_i_memusage_attributes(ctx, attrs->attrs[i], &attributes);
+    if (sub == 0)
+      return 1;
+    *total += attributes;
+    if (result) {
+      if (igraphmodule_i_memusage_set_dict(result, attr_keys[i], sub))
+        return 1;
+    } else {
+      Py_DECREF(sub);
+    }
+  }
+
+  /* Counted after the vertex attributes so that deep queries do not count
+   * the names twice */
+  name_index = 0;
+  if (attrs->vertex_name_index &&
+      igraphmodule_i_memusage_add_container(ctx, attrs->vertex_name_index, &name_index))
+    return 1;
+  *total += name_index;
+
+  canonical_forms = 0;
+  if (attrs->canonical_forms &&
+      igraphmodule_i_memusage_add_container(ctx, attrs->canonical_forms, &canonical_forms))
+    return 1;
+  *total += canonical_forms;
+
+  attributes = 0;
+  sub = igraphmodule_i_memusage_attributes(ctx, attrs->edge_vector_cache, &attributes);
+  if (sub == 0)
+    return 1;
+  *total += attributes;
+
+  if (result) {
+    if (igraphmodule_i_memusage_set(result, "name_index", name_index) ||
+        igraphmodule_i_memusage_set(result, "canonical_forms", canonical_forms) ||
+        igraphmodule_i_memusage_set_dict(result, "cached_vectors", sub) ||
+        igraphmodule_i_memusage_set(result, "total", *total))
+      return 1;
+  } else {
+    Py_DECREF(sub);
+  }
+
+  return 0;
+}
+
+static int igraphmodule_i_memusage_init(igraphmodule_i_memusage_t* ctx, int deep) {
+  ctx->deep = deep;
+  ctx->seen = 0;
+  ctx->getsizeof = PySys_GetObject("getsizeof");   /* borrowed */
+  if (ctx->getsizeof == 0) {
+    PyErr_SetString(PyExc_RuntimeError, "sys.getsizeof is not available");
+    return 1;
+  }
+  Py_INCREF(ctx->getsizeof);
+
+  if (deep) {
+    ctx->seen = PySet_New(0);
+    if (ctx->seen == 0) {
+      Py_DECREF(ctx->getsizeof);
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+static void igraphmodule_i_memusage_destroy(igraphmodule_i_memusage_t* ctx) {
+  Py_XDECREF(ctx->getsizeof);
+  Py_XDECREF(ctx->seen);
+}
+
+/**
+ * \ingroup python_interface_memusage
+ * \brief Returns the breakdown of the memory used by a graph as a dict
+ *
+ * \param deep  whether to count the items of the attribute values (each
+ *              distinct object once) and not only the containers
+ */
+PyObject* igraphmodule_Graph_memory_usage_dict(igraphmodule_GraphObject* self,
+    int deep) {
+  igraphmodule_i_memusage_t ctx;
+  PyObject* result;
+  Py_ssize_t total;
+
+  if (igraphmodule_i_memusage_init(&ctx, deep))
+    return NULL;
+
+  result = PyDict_New();
+  if (result == 0 || igraphmodule_i_Graph_memory_usage(self, &ctx, result, &total)) {
+    Py_XDECREF(result);
+    result = 0;
+  }
+
+  igraphmodule_i_memusage_destroy(&ctx);
+  return result;
+}
+
+/**
+ * \ingroup python_interface_memusage
+ * \brief Returns the number of bytes used by a graph, not counting the
+ *        items of the attribute values
+ *
+ * \return the number of bytes or -1 if an exception was raised
+ */
+Py_ssize_t igraphmodule_Graph_memory_usage_total(igraphmodule_GraphObject* self) {
+  igraphmodule_i_memusage_t ctx;
+  Py_ssize_t total;
+
+  if (igraphmodule_i_memusage_init(&ctx, 0))
+    return -1;
+
+  if (igraphmodule_i_Graph_memory_usage(self, &ctx, 0, &total))
+    total = -1;
+
+  igraphmodule_i_memusage_destroy(&ctx);
+  return total;
+}
+
+/**
+ * \ingroup python_interface_memusage
+ * \brief Returns the global memory statistics of the interface and of the
+ *        process heap
+ */
+PyObject* igraphmodule_get_memory_stats(PyObject* self) {
+  PyObject* result = PyDict_New();
+  PyObject *in_use = 0, *reserved = 0;
+
+  if (result == 0)
+    return NULL;
+
+  if (igraphmodule_i_memusage_set(result, "buffer_bytes",
+        igraphmodule_i_memory_bytes[IGRAPHMODULE_MEMORY_BUFFERS]) ||
+      igraphmodule_i_memusage_set(result, "buffer_objects",
+        igraphmodule_i_memory_objects[IGRAPHMODULE_MEMORY_BUFFERS]) ||
+      igraphmodule_i_memusage_set(result, "column_bytes",
+        igraphmodule_i_memory_bytes[IGRAPHMODULE_MEMORY_COLUMNS]) ||
+      igraphmodule_i_memusage_set(result, "column_objects",
+        igraphmodule_i_memory_objects[IGRAPHMODULE_MEMORY_COLUMNS])) {
+    Py_DECREF(result);
+    return NULL;
+  }
+
+  /* The C core allocates with the malloc() of the C library, so the
+   * statistics of the heap are the closest we can get to its footprint */
+#if defined(IGRAPHMODULE_HAVE_MALLINFO2)
+  {
+    struct mallinfo2 info = mallinfo2();
+    in_use = PyLong_FromSize_t(info.uordblks + info.hblkhd);
+    reserved = PyLong_FromSize_t(info.arena + info.hblkhd);
+  }
+#elif defined(IGRAPHMODULE_HAVE_MALLINFO)
+  {
+    /* The fields of mallinfo are ints and wrap around above 2 GB */
+    struct mallinfo info = mallinfo();
+    in_use = PyLong_FromSize_t((unsigned int)info.uordblks + (unsigned int)info.hblkhd);
+    reserved = PyLong_FromSize_t((unsigned int)info.arena + (unsigned int)info.hblkhd);
+  }
+#elif defined(IGRAPHMODULE_HAVE_MALLOC_ZONE_STATISTICS)
+  {
+    malloc_statistics_t info;
+    malloc_zone_statistics(NULL, &info);
+    in_use = PyLong_FromSize_t(info.size_in_use);
+    reserved = PyLong_FromSize_t(info.size_allocated);
+  }
+#else
+  Py_INCREF(Py_None); in_use = Py_None;
+  Py_INCREF(Py_None); reserved = Py_None;
+#endif
+
+  if (igraphmodule_i_memusage_set_dict(result, "heap_in_use", in_use) ||
+      igraphmodule_i_memusage_set_dict(result, "heap_reserved", reserved)) {
+    Py_DECREF(result);
+    return NULL;
+  }
+
+  return result;
+}
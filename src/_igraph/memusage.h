@@ -0,0 +1,58 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef PYTHON_MEMUSAGE_H
+#define PYTHON_MEMUSAGE_H
+
+#include <Python.h>
+#include "graphobject.h"
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_memusage Memory accounting
+ */
+
+/**
+ * \ingroup python_interface_memusage
+ * \brief Categories of memory allocated by the Python interface itself
+ *        and tracked by \ref igraphmodule_memory_track()
+ */
+typedef enum {
+  // Storage of the vectors and matrices owned by Buffer objects
+  IGRAPHMODULE_MEMORY_BUFFERS = 0,
+  // Items and validity masks of typed attribute columns
+  IGRAPHMODULE_MEMORY_COLUMNS,
+  IGRAPHMODULE_MEMORY_CATEGORIES
+} igraphmodule_memory_category_t;
+
+void igraphmodule_memory_track(igraphmodule_memory_category_t category,
+    Py_ssize_t bytes, Py_ssize_t objects);
+
+PyObject* igraphmodule_Graph_memory_usage_dict(igraphmodule_GraphObject* self,
+    int deep);
+Py_ssize_t igraphmodule_Graph_memory_usage_total(igraphmodule_GraphObject* self);
+
+PyObject* igraphmodule_get_memory_stats(PyObject* self);
+
+#endif
@@ -0,0 +1,685 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#include "common.h"
+#include "error.h"
+#include "motifs.h"
+#include "threading.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* The class tables of motifs of size 3 and 4 (undirected and directed)
+ * and of triads, built on first use */
+static igraphmodule_motif_table_t igraphmodule_i_motif_tables[5];
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief Returns the number of bits in the adjacency bitmasks of a table
+ */
+static long int igraphmodule_i_motif_bits(long int size, igraph_bool_t directed) {
+  return directed ? size * (size - 1) : size * (size - 1) / 2;
+}
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief Builds the class table of a given size
+ *
+ * Creates the graph of every bitmask and asks the C core for its
+ * isomorphism class, or for its triad type if \c triads is true.
+ *
+ * \return an igraph error code
+ */
+static int igraphmodule_i_motif_table_init(igraphmodule_motif_table_t *table,
+    long int size, igraph_bool_t directed, igraph_bool_t triads) {
+  long int bits = igraphmodule_i_motif_bits(size, directed);
+  long int no_of_masks = 1L << bits, mask, bit, i, j, k, cls;
+  igraph_integer_t isoclass;
+  igraph_bool_t conn;
+  igraph_vector_t edges, census;
+  igraph_t g;
+  long int *classes;
+  char *connected;
+
+  classes = (long int*) calloc(no_of_masks, sizeof(long int));
+  connected = (char*) calloc(no_of_masks, sizeof(char));
+  if (classes == 0 || connected == 0) {
+    free(classes);
+    free(connected);
+    IGRAPH_ERROR("not enough memory for motif table", IGRAPH_ENOMEM);
+  }
+  IGRAPH_FINALLY(free, classes);
+  IGRAPH_FINALLY(free, connected);
+  IGRAPH_VECTOR_INIT_FINALLY(&edges, 0);
+  IGRAPH_VECTOR_INIT_FINALLY(&census, 0);
+
+  table->no_of_classes = 0;
+  for (mask = 0; mask < no_of_masks; mask++) {
+    igraph_vector_clear(&edges);
+    for (bit = 0, i = 0; i < size; i++) {
+      for (j = directed ? 0 : i + 1; j < size; j++) {
+        if (i == j)
+          continue;
+        if (mask & (1L << bit)) {
+          IGRAPH_CHECK(igraph_vector_push_back(&edges, i));
+          IGRAPH_CHECK(igraph_vector_push_back(&edges, j));
+        }
+        bit++;
+      }
+    }
+
+    IGRAPH_CHECK(igraph_create(&g, &edges, (igraph_integer_t) size, directed));
+    IGRAPH_FINALLY(igraph_destroy, &g);
+    if (triads) {
+      IGRAPH_CHECK(igraph_triad_census(&g, &census));
+      for (cls = 0, k = 0; k < igraph_vector_size(&census); k++) {
+        if (VECTOR(census)[k] > 0)
+          cls = k;
+      }
+      conn = 1;
+    } else {
+      IGRAPH_CHECK(igraph_isoclass(&g, &isoclass));
+      IGRAPH_CHECK(igraph_is_connected(&g, &conn, IGRAPH_WEAK));
+      cls = isoclass;
+    }
+    igraph_destroy(&g);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    classes[mask] = cls;
+    connected[cls] = conn ? 1 : 0;
+    if (cls >= table->no_of_classes)
+      table->no_of_classes = cls + 1;
+  }
+
+  igraph_vector_destroy(&census);
+  igraph_vector_destroy(&edges);
+  IGRAPH_FINALLY_CLEAN(4);
+
+  table->size = size;
+  table->directed = directed;
+  table->classes = classes;
+  table->connected = connected;
+
+  return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief Returns the class table of motifs of a given size, building it if
+ *        needed
+ *
+ * Must be called with the GIL held.
+ *
+ * \param size     the number of vertices, 3 or 4
+ * \param directed whether the motifs are directed
+ * \param triads   whether to map the bitmasks to the 16 triad types of
+ *                 \c igraph_triad_census() instead of isomorphism classes;
+ *                 \c size must be 3 and \c directed must be true
+ * \return the table, or \c NULL if an exception was raised
+ */
+const igraphmodule_motif_table_t* igraphmodule_motif_table(long int size,
+    igraph_bool_t directed, igraph_bool_t triads) {
+  igraphmodule_motif_table_t *table;
+
+  if (size != 3 && size != 4) {
+    PyErr_SetString(PyExc_ValueError, "only motifs of size 3 and 4 are supported");
+    return NULL;
+  }
+
+  table = &igraphmodule_i_motif_tables[triads ? 4 : (size - 3) * 2 + (directed ? 1 : 0)];
+  if (table->classes == 0 &&
+      igraphmodule_i_motif_table_init(table, size, directed, triads)) {
+    igraphmodule_handle_igraph_error();
+    return NULL;
+  }
+
+  return table;
+}
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief Returns the p-quantile of the standard normal distribution
+ */
+igraph_real_t igraphmodule_normal_quantile(igraph_real_t p) {
+  igraph_real_t lo = -40, hi = 40, mid;
+  int i;
+
+  /* Bisection on the cumulative distribution function */
+  for (i = 0; i < 100; i++) {
+    mid = (lo + hi) / 2;
+    if (0.5 * erfc(-mid / sqrt(2.0)) < p)
+      lo = mid;
+    else
+      hi = mid;
+  }
+
+  return (lo + hi) / 2;
+}
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief Tells whether there is an edge from \c u to \c v, using binary
+ *        search in the sorted neighbor list of \c u
+ */
+static igraph_bool_t igraphmodule_i_motifs_has_edge(const igraphmodule_adjacency_t *adj,
+    long int u, long int v) {
+  long int lo = adj->offsets[u], hi = adj->offsets[u + 1] - 1, mid;
+
+  while (lo <= hi) {
+    mid = lo + (hi - lo) / 2;
+    if (adj->neighbors[mid] == v)
+      return 1;
+    if (adj->neighbors[mid] < v)
+      lo = mid + 1;
+    else
+      hi = mid - 1;
+  }
+
+  return 0;
+}
+
+typedef enum {
+  IGRAPHMODULE_MOTIFS_TASK_MOTIFS = 0,
+  IGRAPHMODULE_MOTIFS_TASK_TRIADS,
+  IGRAPHMODULE_MOTIFS_TASK_DYADS
+} igraphmodule_i_motifs_task_t;
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief The work shared by all the workers
+ */
+typedef struct {
+  igraphmodule_i_motifs_task_t task;
+  const igraphmodule_motifs_t *motifs;
+  const igraphmodule_adjacency_t *all;
+  const igraphmodule_adjacency_t *out;
+  // The roots of the motif search (all the vertices for the other tasks,
+  // in which case this is a null pointer)
+  const long int *roots;
+  long int no_of_roots;
+  long int no_of_workers;
+  // Number of distinct neighbors of each vertex, not counting loops
+  // (triads only)
+  const long int *degrees;
+  // Number of count slots of each worker
+  long int no_of_counts;
+} igraphmodule_i_motifs_job_t;
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief Workspace and accumulators of a single worker thread; worker
+ *        \em i handles roots \em i, \em i+k, \em i+2k and so on where
+ *        \em k is the number of workers
+ *
+ * \c blocked counts for every vertex the vertices of the current subgraph
+ * that it is equal or adjacent to; it is kept at zero between roots.
+ */
+typedef struct {
+  const igraphmodule_i_motifs_job_t *job;
+  long int index;
+  long int root;
+  long int sub[IGRAPHMODULE_MOTIFS_MAX_SIZE];
+  // Extension sets of the levels of the search tree
+  long int *ext[IGRAPHMODULE_MOTIFS_MAX_SIZE];
+  int *blocked;
+  // Counts summed over all roots, their squares summed over all roots,
+  // and the counts of the current root (the first array itself unless the
+  // squares are needed)
+  igraph_real_t *acc;
+  igraph_real_t *sq;
+  igraph_real_t *loc;
+  igraph_rng_t rng;
+  igraph_bool_t has_rng;
+  igraph_bool_t failed;
+} igraphmodule_i_motifs_worker_t;
+
+static void igraphmodule_i_motifs_block(igraphmodule_i_motifs_worker_t *w,
+    long int v, int delta) {
+  const igraphmodule_adjacency_t *all = w->job->all;
+  long int j;
+
+  w->blocked[v] += delta;
+  for (j = all->offsets[v]; j < all->offsets[v + 1]; j++)
+    w->blocked[all->neighbors[j]] += delta;
+}
+
+static void igraphmodule_i_motifs_classify(igraphmodule_i_motifs_worker_t *w) {
+  const igraphmodule_motif_table_t *table = w->job->motifs->table;
+  const igraphmodule_adjacency_t *out = w->job->out;
+  long int i, j, bit = 0, mask = 0, size = table->size;
+
+  for (i = 0; i < size; i++) {
+    for (j = table->directed ? 0 : i + 1; j < size; j++) {
+      if (i == j)
+        continue;
+      if (igraphmodule_i_motifs_has_edge(out, w->sub[i], w->sub[j]))
+        mask |= 1L << bit;
+      bit++;
+    }
+  }
+
+  w->loc[table->classes[mask]] += 1;
+  w->loc[table->no_of_classes] += 1;
+}
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief Extends the current subgraph of \c depth vertices by the vertices
+ *        of its extension set in turn
+ */
+static void igraphmodule_i_motifs_extend(igraphmodule_i_motifs_worker_t *w,
+    long int depth, const long int *ext, long int no_of_ext) {
+  const igraphmodule_motifs_t *motifs = w->job->motifs;
+  const igraphmodule_adjacency_t *all = w->job->all;
+  long int *next = w->ext[depth];
+  long int v, u, j, prev, no_of_next;
+
+  while (no_of_ext > 0) {
+    v = ext[--no_of_ext];
+    if (motifs->cut_prob && motifs->cut_prob[depth] > 0 &&
+        igraph_rng_get_unif01(&w->rng) < motifs->cut_prob[depth])
+      continue;
+
+    w->sub[depth] = v;
+    if (depth + 1 == motifs->table->size) {
+      igraphmodule_i_motifs_classify(w);
+      continue;
+    }
+
+    /* The vertices that are not yet in or next to the subgraph are the
+     * exclusive neighbors of v */
+    memcpy(next, ext, no_of_ext * sizeof(long int));
+    no_of_next = no_of_ext;
+    for (prev = -1, j = all->offsets[v]; j < all->offsets[v + 1]; j++) {
+      u = all->neighbors[j];
+      if (u != prev && u > w->root && w->blocked[u] == 0)
+        next[no_of_next++] = u;
+      prev = u;
+    }
+
+    igraphmodule_i_motifs_block(w, v, 1);
+    igraphmodule_i_motifs_extend(w, depth + 1, next, no_of_next);
+    igraphmodule_i_motifs_block(w, v, -1);
+  }
+}
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief Counts the motifs whose vertex with the smallest ID is \c root
+ */
+static void igraphmodule_i_motifs_root(igraphmodule_i_motifs_worker_t *w,
+    long int root) {
+  const igraphmodule_i_motifs_job_t *job = w->job;
+  const igraphmodule_adjacency_t *all = job->all;
+  long int j, u, prev, no_of_ext = 0;
+
+  if (job->motifs->cut_prob) {
+    igraph_rng_seed(&w->rng, igraphmodule_stream_seed(job->motifs->seed, root));
+    if (job->motifs->cut_prob[0] > 0 &&
+        igraph_rng_get_unif01(&w->rng) < job->motifs->cut_prob[0])
+      return;
+  }
+
+  w->root = root;
+  w->sub[0] = root;
+  for (prev = -1, j = all->offsets[root]; j < all->offsets[root + 1]; j++) {
+    u = all->neighbors[j];
+    if (u != prev && u > root)
+      w->ext[0][no_of_ext++] = u;
+    prev = u;
+  }
+
+  igraphmodule_i_motifs_block(w, root, 1);
+  igraphmodule_i_motifs_extend(w, 1, w->ext[0], no_of_ext);
+  igraphmodule_i_motifs_block(w, root, -1);
+}
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief Classifies the edges of \c u towards its neighbors with larger IDs
+ *        and counts the triads they form with the vertices adjacent to
+ *        neither of their endpoints
+ */
+static void igraphmodule_i_motifs_triads(igraphmodule_i_motifs_worker_t *w,
+    long int u) {
+  const igraphmodule_i_motifs_job_t *job = w->job;
+  const igraphmodule_adjacency_t *all = job->all;
+  long int n = all->no_of_nodes, v, j, a, b, prev, common;
+  igraph_bool_t mutual;
+
+  for (prev = -1, j = all->offsets[u]; j < all->offsets[u + 1]; j++) {
+    v = all->neighbors[j];
+    if (v == prev || v <= u) {
+      prev = v;
+      continue;
+    }
+    prev = v;
+
+    /* Number of distinct common neighbors by merging the sorted lists */
+    common = 0;
+    a = all->offsets[u];
+    b = all->offsets[v];
+    while (a < all->offsets[u + 1] && b < all->offsets[v + 1]) {
+      if (all->neighbors[a] < all->neighbors[b]) {
+        a++;
+      } else if (all->neighbors[a] > all->neighbors[b]) {
+        b++;
+      } else {
+        if (all->neighbors[a] != u && all->neighbors[a] != v)
+          common++;
+        a++;
+        b++;
+        while (a < all->offsets[u + 1] && all->neighbors[a] == all->neighbors[a - 1])
+          a++;
+        while (b < all->offsets[v + 1] && all->neighbors[b] == all->neighbors[b - 1])
+          b++;
+      }
+    }
+
+    mutual = igraphmodule_i_motifs_has_edge(job->out, u, v) &&
+      igraphmodule_i_motifs_has_edge(job->out, v, u);
+    w->acc[mutual ? 1 : 0] += n - (job->degrees[u] + job->degrees[v] - common);
+  }
+}
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief Counts the asymmetric and mutual dyads of \c u towards its
+ *        out-neighbors (mutual dyads only towards larger IDs)
+ */
+static void igraphmodule_i_motifs_dyads(igraphmodule_i_motifs_worker_t *w,
+    long int u) {
+  const igraphmodule_adjacency_t *out = w->job->out;
+  long int v, j, prev;
+
+  for (prev = -1, j = out->offsets[u]; j < out->offsets[u + 1]; j++) {
+    v = out->neighbors[j];
+    if (v != prev && v != u) {
+      if (!igraphmodule_i_motifs_has_edge(out, v, u))
+        w->acc[0] += 1;
+      else if (v > u)
+        w->acc[1] += 1;
+    }
+    prev = v;
+  }
+}
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief Carries out the share of a worker
+ */
+static void igraphmodule_i_motifs_work(void *workers, long int index) {
+  igraphmodule_i_motifs_worker_t *w =
+    &((igraphmodule_i_motifs_worker_t*)workers)[index];
+  const igraphmodule_i_motifs_job_t *job = w->job;
+  long int i, c;
+
+  for (i = w->index; i < job->no_of_roots; i += job->no_of_workers) {
+    switch (job->task) {
+      case IGRAPHMODULE_MOTIFS_TASK_MOTIFS:
+        igraphmodule_i_motifs_root(w, job->roots[i]);
+        if (w->sq) {
+          for (c = 0; c < job->no_of_counts; c++) {
+            w->acc[c] += w->loc[c];
+            w->sq[c] += w->loc[c] * w->loc[c];
+            w->loc[c] = 0;
+          }
+        }
+        break;
+
+      case IGRAPHMODULE_MOTIFS_TASK_TRIADS:
+        igraphmodule_i_motifs_triads(w, i);
+        break;
+
+      case IGRAPHMODULE_MOTIFS_TASK_DYADS:
+        igraphmodule_i_motifs_dyads(w, i);
+        break;
+    }
+  }
+}
+
+static void igraphmodule_i_motifs_workers_destroy(
+    igraphmodule_i_motifs_worker_t *workers, long int threads) {
+  long int i, j;
+
+  if (workers == 0)
+    return;
+
+  for (i = 0; i < threads; i++) {
+    for (j = 0; j < IGRAPHMODULE_MOTIFS_MAX_SIZE; j++)
+      free(workers[i].ext[j]);
+    free(workers[i].blocked);
+    free(workers[i].acc);
+    free(workers[i].sq);
+    if (workers[i].loc != workers[i].acc)
+      free(workers[i].loc);
+    if (workers[i].has_rng)
+      igraph_rng_destroy(&workers[i].rng);
+  }
+  free(workers);
+}
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief Runs a job with the given number of threads and adds the sums of
+ *        the accumulators of the workers to \c counts (and the sums of the
+ *        squares to \c sqsums, if it is not a null pointer)
+ *
+ * \return \c IGRAPH_SUCCESS or \c IGRAPH_ENOMEM
+ */
+static int igraphmodule_i_motifs_run(const igraphmodule_i_motifs_job_t *job,
+    long int threads, igraph_real_t *counts, igraph_real_t *sqsums) {
+  igraphmodule_i_motifs_worker_t *workers = 0, *w;
+  igraphmodule_i_motifs_job_t local = *job;
+  long int i, j, c, n = job->all->no_of_nodes, max_degree = 0;
+  int retval = 0;
+
+  if (threads > job->no_of_roots)
+    threads = job->no_of_roots;
+  if (threads < 1)
+    threads = 1;
+  local.no_of_workers = threads;
+
+  if (job->task == IGRAPHMODULE_MOTIFS_TASK_MOTIFS) {
+    for (i = 0; i < n; i++) {
+      if (IGRAPHMODULE_ADJACENCY_DEGREE(job->all, i) > max_degree)
+        max_degree = IGRAPHMODULE_ADJACENCY_DEGREE(job->all, i);
+    }
+  }
+
+  workers = (igraphmodule_i_motifs_worker_t*)calloc(threads,
+      sizeof(igraphmodule_i_motifs_worker_t));
+  if (!workers) {
+    retval = IGRAPH_ENOMEM;
+    goto cleanup;
+  }
+
+  for (i = 0; i < threads; i++) {
+    w = &workers[i];
+    w->job = &local;
+    w->index = i;
+    w->acc = (igraph_real_t*)calloc(job->no_of_counts, sizeof(igraph_real_t));
+    w->loc = w->acc;
+    if (!w->acc)
+      w->failed = 1;
+    if (job->task == IGRAPHMODULE_MOTIFS_TASK_MOTIFS) {
+      /* The extension set of level d holds at most the neighbors of the
+       * first d+1 vertices of the subgraph */
+      for (j = 0; j + 1 < job->motifs->table->size; j++) {
+        w->ext[j] = (long int*)calloc((j + 1) * max_degree + 1, sizeof(long int));
+        if (!w->ext[j])
+          w->failed = 1;
+      }
+      w->blocked = (int*)calloc(n > 0 ? n : 1, sizeof(int));
+      if (!w->blocked)
+        w->failed = 1;
+      if (sqsums) {
+        w->sq = (igraph_real_t*)calloc(job->no_of_counts, sizeof(igraph_real_t));
+        w->loc = (igraph_real_t*)calloc(job->no_of_counts, sizeof(igraph_real_t));
+        if (!w->sq || !w->loc)
+          w->failed = 1;
+      }
+      if (job->motifs->cut_prob && !w->failed) {
+        if (igraph_rng_init(&w->rng, &igraph_rngtype_mt19937))
+          w->failed = 1;
+        else
+          w->has_rng = 1;
+      }
+    }
+    if (w->failed) {
+      retval = IGRAPH_ENOMEM;
+      goto cleanup;
+    }
+  }
+
+  igraphmodule_run_workers(igraphmodule_i_motifs_work, workers, threads, threads);
+
+  for (i = 0; i < threads; i++) {
+    for (c = 0; c < job->no_of_counts; c++) {
+      counts[c] += workers[i].acc[c];
+      if (sqsums)
+        sqsums[c] += workers[i].sq[c];
+    }
+  }
+
+cleanup:
+  igraphmodule_i_motifs_workers_destroy(workers, threads);
+
+  return retval;
+}
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief Counts the motifs rooted at the given vertices
+ *
+ * \param roots   the roots; a vertex may appear more than once
+ * \param counts  the number of motifs of each class rooted at the given
+ *                vertices is added here, followed by the number of motifs
+ *                of all classes. Must have <tt>no_of_classes+1</tt> items.
+ * \param sqsums  if not a null pointer, the squares of the per-root counts
+ *                are added here, in the same layout as \c counts
+ * \return \c IGRAPH_SUCCESS or \c IGRAPH_ENOMEM
+ */
+int igraphmodule_motifs_count(const igraphmodule_motifs_t *motifs,
+    const long int *roots, long int no_of_roots, long int threads,
+    igraph_real_t *counts, igraph_real_t *sqsums) {
+  igraphmodule_i_motifs_job_t job;
+
+  memset(&job, 0, sizeof(job));
+  job.task = IGRAPHMODULE_MOTIFS_TASK_MOTIFS;
+  job.motifs = motifs;
+  job.all = motifs->all;
+  job.out = motifs->out;
+  job.roots = roots;
+  job.no_of_roots = no_of_roots;
+  job.no_of_counts = motifs->table->no_of_classes + 1;
+
+  if (no_of_roots == 0)
+    return IGRAPH_SUCCESS;
+
+  return igraphmodule_i_motifs_run(&job, threads, counts, sqsums);
+}
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief Counts the triads with a single connected pair of vertices
+ *
+ * \param all    the neighbors of the vertices ignoring edge directions
+ * \param out    the out-neighbors (\c all for undirected graphs)
+ * \param asym   the number of triads of type 012 is returned here
+ * \param mutual the number of triads of type 102 is returned here
+ * \return \c IGRAPH_SUCCESS or \c IGRAPH_ENOMEM
+ */
+int igraphmodule_triads_dyadic(const igraphmodule_adjacency_t *all,
+    const igraphmodule_adjacency_t *out, long int threads,
+    igraph_real_t *asym, igraph_real_t *mutual) {
+  igraphmodule_i_motifs_job_t job;
+  igraph_real_t counts[2] = { 0, 0 };
+  long int *degrees, n = all->no_of_nodes, u, j, prev;
+  int retval;
+
+  *asym = *mutual = 0;
+  if (n == 0)
+    return IGRAPH_SUCCESS;
+
+  degrees = (long int*)calloc(n, sizeof(long int));
+  if (!degrees)
+    return IGRAPH_ENOMEM;
+  for (u = 0; u < n; u++) {
+    for (prev = -1, j = all->offsets[u]; j < all->offsets[u + 1]; j++) {
+      if (all->neighbors[j] != prev && all->neighbors[j] != u)
+        degrees[u]++;
+      prev = all->neighbors[j];
+    }
+  }
+
+  memset(&job, 0, sizeof(job));
+  job.task = IGRAPHMODULE_MOTIFS_TASK_TRIADS;
+  job.all = all;
+  job.out = out;
+  job.no_of_roots = n;
+  job.degrees = degrees;
+  job.no_of_counts = 2;
+
+  retval = igraphmodule_i_motifs_run(&job, threads, counts, 0);
+  free(degrees);
+
+  *asym = counts[0];
+  *mutual = counts[1];
+
+  return retval;
+}
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief Counts the asymmetric and mutual pairs of vertices
+ *
+ * \param out    the out-neighbors of the vertices (all the neighbors for
+ *               undirected graphs, where all connected pairs are mutual)
+ * \return \c IGRAPH_SUCCESS or \c IGRAPH_ENOMEM
+ */
+int igraphmodule_dyads_count(const igraphmodule_adjacency_t *out,
+    long int threads, igraph_real_t *asym, igraph_real_t *mutual) {
+  igraphmodule_i_motifs_job_t job;
+  igraph_real_t counts[2] = { 0, 0 };
+  int retval;
+
+  *asym = *mutual = 0;
+  if (out->no_of_nodes == 0)
+    return IGRAPH_SUCCESS;
+
+  memset(&job, 0, sizeof(job));
+  job.task = IGRAPHMODULE_MOTIFS_TASK_DYADS;
+  job.all = out;
+  job.out = out;
+  job.no_of_roots = out->no_of_nodes;
+  job.no_of_counts = 2;
+
+  retval = igraphmodule_i_motifs_run(&job, threads, counts, 0);
+
+  *asym = counts[0];
+  *mutual = counts[1];
+
+  return retval;
+}
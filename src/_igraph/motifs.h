@@ -0,0 +1,102 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+
+#ifndef PYTHON_MOTIFS_H
+#define PYTHON_MOTIFS_H
+
+#include <Python.h>
+#include <igraph.h>
+#include "adjacency.h"
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_motifs Parallel motif and triad census
+ *
+ * The connected induced subgraphs of three or four vertices are enumerated
+ * with the ESU algorithm of Wernicke on the cached adjacency lists of a
+ * graph. Every subgraph is found exactly once, from its vertex with the
+ * smallest ID (its root), so the roots can be distributed among several
+ * threads, each of them with a workspace and count arrays of its own; the
+ * counts are summed when all threads have finished. The subgraphs are
+ * classified by looking up the adjacency bitmask of their vertices in a
+ * table that maps every bitmask to its isomorphism class (or triad type).
+ *
+ * Apart from \ref igraphmodule_motif_table(), the functions below do not
+ * touch Python objects and do not use the error handling of the C core,
+ * so they can be called without holding the GIL.
+ */
+
+#define IGRAPHMODULE_MOTIFS_MAX_SIZE 4
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief The isomorphism classes of all the adjacency bitmasks of a given
+ *        number of vertices
+ *
+ * Bit \em b of a bitmask belongs to the \em b-th pair (i, j) of vertices
+ * with i != j (directed) or i < j (undirected), in row-major order.
+ */
+typedef struct {
+  long int size;
+  igraph_bool_t directed;
+  long int no_of_classes;
+  // The class of each bitmask
+  long int *classes;
+  // Whether the graphs of each class are (weakly) connected
+  char *connected;
+} igraphmodule_motif_table_t;
+
+/**
+ * \ingroup python_interface_motifs
+ * \brief A motif search shared by all the workers
+ */
+typedef struct {
+  // Neighbors ignoring edge directions, for growing the subgraphs
+  const igraphmodule_adjacency_t *all;
+  // Out-neighbors (or all the neighbors in undirected graphs), for
+  // classifying them
+  const igraphmodule_adjacency_t *out;
+  const igraphmodule_motif_table_t *table;
+  // Probabilities of cutting the search tree at each level, or a null
+  // pointer if the tree is never cut
+  const igraph_real_t *cut_prob;
+  unsigned long int seed;
+} igraphmodule_motifs_t;
+
+const igraphmodule_motif_table_t* igraphmodule_motif_table(long int size,
+    igraph_bool_t directed, igraph_bool_t triads);
+
+int igraphmodule_motifs_count(const igraphmodule_motifs_t *motifs,
+    const long int *roots, long int no_of_roots, long int threads,
+    igraph_real_t *counts, igraph_real_t *sqsums);
+int igraphmodule_triads_dyadic(const igraphmodule_adjacency_t *all,
+    const igraphmodule_adjacency_t *out, long int threads,
+    igraph_real_t *asym, igraph_real_t *mutual);
+int igraphmodule_dyads_count(const igraphmodule_adjacency_t *out,
+    long int threads, igraph_real_t *asym, igraph_real_t *mutual);
+
+igraph_real_t igraphmodule_normal_quantile(igraph_real_t p);
+
+#endif
@@ -20,10 +20,12 @@
 
 */
 
+#include "attributes.h"
 #include "common.h"
 #include "convert.h"
 #include "error.h"
 #include "graphobject.h"
+#include "threading.h"
 
 
 /** \ingroup python_interface_graph
@@ -89,201 +91,406 @@ PyObject *igraphmodule__disjoint_union(PyObject *self,
 }
 
 
-/** \ingroup python_interface_graph
- * \brief Creates the union of two or more graphs
+/**
+ * \ingroup python_interface_graph
+ * \brief Matches the vertices of several graphs by their names.
+ *
+ * Assigns a new vertex ID to each distinct value of the \c name vertex
+ * attribute, in the order of first appearance. Vertices sharing the same
+ * name are mapped to the same new vertex.
+ *
+ * \param gs          the graphs
+ * \param keep_all    whether to keep names that do not appear in all the
+ *                    graphs. If false, vertices with such names are mapped
+ *                    to -1
+ * \param vertexmaps  an initialized pointer vector (with an item destructor)
+ *                    that receives one vector for each graph, mapping its
+ *                    vertices to the new vertex IDs
+ * \param names_o     the list of names of the new vertices is returned here
+ * \return 0 if everything was OK, 1 otherwise
  */
-PyObject *igraphmodule__union(PyObject *self,
-		PyObject *args, PyObject *kwds)
-{
-  static char* kwlist[] = { "graphs", "edgemaps", NULL };
-  PyObject *it, *em_list = 0, *graphs, *with_edgemaps_o;
-  int with_edgemaps = 0;
-  long int no_of_graphs;
-  igraph_vector_ptr_t gs;
-  igraphmodule_GraphObject *o;
-  PyObject *result;
-  PyTypeObject *result_type;
-  igraph_t g;
-
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist,
-      &graphs, &with_edgemaps_o))
-    return NULL;
-
-  if (PyObject_IsTrue(with_edgemaps_o))
-    with_edgemaps = 1;
-
-  /* Needs to be an iterable */
-  it = PyObject_GetIter(graphs);
-  if (!it) {
-      Py_DECREF(it);
-      return igraphmodule_handle_igraph_error();
+static int igraphmodule_i_match_vertices_by_name(const igraph_vector_ptr_t *gs,
+    igraph_bool_t keep_all, igraph_vector_ptr_t *vertexmaps, PyObject **names_o) {
+  long int i, j, k, n, no_of_graphs = igraph_vector_ptr_size(gs);
+  PyObject *index, *names, *values, *name, *id_o;
+  igraph_vector_long_t counts, last_seen;
+  igraph_vector_t *map;
+
+  index = PyDict_New();
+  names = index ? PyList_New(0) : 0;
+  if (names == 0) {
+    Py_XDECREF(index);
+    return 1;
   }
 
-  /* Get all elements, store the graphs in an igraph_vector_ptr */
-  if (igraph_vector_ptr_init(&gs, 0)) {
-    Py_DECREF(it);
-    return igraphmodule_handle_igraph_error();
+  if (igraph_vector_long_init(&counts, 0)) {
+    Py_DECREF(index); Py_DECREF(names);
+    igraphmodule_handle_igraph_error();
+    return 1;
   }
-  if (igraphmodule_append_PyIter_of_graphs_to_vector_ptr_t_with_type(it, &gs, &result_type)) {
-    Py_DECREF(it);
-    igraph_vector_ptr_destroy(&gs);
-    return NULL;
+  if (igraph_vector_long_init(&last_seen, 0)) {
+    Py_DECREF(index); Py_DECREF(names);
+    igraph_vector_long_destroy(&counts);
+    igraphmodule_handle_igraph_error();
+    return 1;
   }
-  Py_DECREF(it);
-  no_of_graphs = (long int) igraph_vector_ptr_size(&gs);
 
-  if (with_edgemaps) {
-    /* prepare edgemaps */
-    igraph_vector_ptr_t edgemaps;
-    if (igraph_vector_ptr_init(&edgemaps, 0)) {
-      return igraphmodule_handle_igraph_error();
+  for (i = 0; i < no_of_graphs; i++) {
+    igraph_t *g = (igraph_t*)VECTOR(*gs)[i];
+
+    values = PyDict_GetItemString(ATTR_STRUCT_DICT(g)[ATTRHASH_IDX_VERTEX], "name");
+    if (values == 0) {
+      PyErr_SetString(PyExc_AttributeError, "Some graphs are not named");
+      goto error;
     }
 
-    /* Create union */
-    if (igraph_union_many(&g, &gs, &edgemaps)) {
-      igraph_vector_ptr_destroy(&gs);
-      igraph_vector_ptr_destroy(&edgemaps);
+    map = (igraph_vector_t*)calloc(1, sizeof(igraph_vector_t));
+    if (map == 0) {
+      PyErr_NoMemory();
+      goto error;
+    }
+    n = igraph_vcount(g);
+    if (igraph_vector_init(map, n)) {
+      free(map);
+      igraphmodule_handle_igraph_error();
+      goto error;
+    }
+    if (igraph_vector_ptr_push_back(vertexmaps, map)) {
+      igraph_vector_destroy(map);
+      free(map);
       igraphmodule_handle_igraph_error();
-      return NULL;
+      goto error;
     }
 
-    /* extract edgemaps */
-    long int i;
-    em_list = PyList_New((Py_ssize_t) no_of_graphs);
-    for (i = 0; i < no_of_graphs; i++) {
-      long int j;
-      long int no_of_edges = (long int) igraph_ecount(VECTOR(gs)[i]);
-      igraph_vector_t *map = VECTOR(edgemaps)[i];
-      PyObject *emi = PyList_New((Py_ssize_t) no_of_edges);
-      for (j = 0; j < no_of_edges; j++) {
-        PyObject *dest = PyLong_FromLong(VECTOR(*map)[j]);
-        PyList_SET_ITEM(emi, (Py_ssize_t) j, dest);
+    for (j = 0; j < n; j++) {
+      name = igraphmodule_attribute_values_get_item(values, j);
+      if (name == 0)
+        goto error;
+
+      id_o = PyDict_GetItem(index, name);
+      if (id_o != 0) {
+        k = PyInt_AsLong(id_o);
+      } else {
+        k = PyList_Size(names);
+        id_o = PyInt_FromLong(k);
+        if (id_o == 0 || PyDict_SetItem(index, name, id_o) ||
+            PyList_Append(names, name)) {
+          Py_XDECREF(id_o);
+          Py_DECREF(name);
+          goto error;
+        }
+        Py_DECREF(id_o);
+        if (igraph_vector_long_push_back(&counts, 0) ||
+            igraph_vector_long_push_back(&last_seen, -1)) {
+          Py_DECREF(name);
+          igraphmodule_handle_igraph_error();
+          goto error;
+        }
       }
-      PyList_SET_ITEM(em_list, (Py_ssize_t) i, emi);
+      Py_DECREF(name);
+
+      /* count each graph only once, even if it has duplicate names */
+      if (VECTOR(last_seen)[k] != i) {
+        VECTOR(last_seen)[k] = i;
+        VECTOR(counts)[k]++;
+      }
+      VECTOR(*map)[j] = k;
     }
-    igraph_vector_ptr_destroy(&edgemaps);
   }
-  else {
-    /* Create union */
-    if (igraph_union_many(&g, &gs, /* edgemaps */ 0)) {
-      igraph_vector_ptr_destroy(&gs);
-      igraphmodule_handle_igraph_error();
-      return NULL;
+
+  if (!keep_all) {
+    /* Drop the names that do not appear in all the graphs and renumber the
+     * remaining vertices; last_seen is reused to store the new IDs */
+    PyObject *common_names = PyList_New(0);
+    if (common_names == 0)
+      goto error;
+    n = igraph_vector_long_size(&counts);
+    for (k = 0, j = 0; k < n; k++) {
+      if (VECTOR(counts)[k] == no_of_graphs) {
+        if (PyList_Append(common_names, PyList_GET_ITEM(names, k))) {
+          Py_DECREF(common_names);
+          goto error;
+        }
+        VECTOR(last_seen)[k] = j++;
+      } else {
+        VECTOR(last_seen)[k] = -1;
+      }
     }
+    for (i = 0; i < no_of_graphs; i++) {
+      map = (igraph_vector_t*)VECTOR(*vertexmaps)[i];
+      n = igraph_vector_size(map);
+      for (j = 0; j < n; j++)
+        VECTOR(*map)[j] = VECTOR(last_seen)[(long int)VECTOR(*map)[j]];
+    }
+    Py_DECREF(names);
+    names = common_names;
   }
 
-  igraph_vector_ptr_destroy(&gs);
+  Py_DECREF(index);
+  igraph_vector_long_destroy(&counts);
+  igraph_vector_long_destroy(&last_seen);
 
-  /* this is correct as long as attributes are not copied by the
-   * operator. if they are copied, the initialization should not empty
-   * the attribute hashes */
-  if (no_of_graphs > 0) {
-    o = (igraphmodule_GraphObject*) igraphmodule_Graph_subclass_from_igraph_t(
-        result_type,
-        &g);
-  }
-  else {
-    o = (igraphmodule_GraphObject*) igraphmodule_Graph_from_igraph_t(&g);
+  *names_o = names;
+  return 0;
+
+error:
+  Py_DECREF(index);
+  Py_DECREF(names);
+  igraph_vector_long_destroy(&counts);
+  igraph_vector_long_destroy(&last_seen);
+  return 1;
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Rewrites the edges of several graphs in terms of new vertex IDs.
+ *
+ * Edges incident on vertices that are mapped to a negative ID are left out.
+ * Does not touch any Python objects, so it may be called without holding
+ * the GIL.
+ *
+ * \param gs           the graphs
+ * \param vertexmaps   the vertex maps, see
+ *                     \ref igraphmodule_i_match_vertices_by_name()
+ * \param no_of_nodes  the number of vertices in the new graphs
+ * \param newgs        an initialized pointer vector (with an item destructor)
+ *                     that receives the new graphs
+ * \param edge_ids     an initialized pointer vector (with an item destructor)
+ *                     that receives the IDs of the original edges that were
+ *                     kept in each new graph
+ * \return error code
+ */
+static int igraphmodule_i_remap_graphs(const igraph_vector_ptr_t *gs,
+    const igraph_vector_ptr_t *vertexmaps, long int no_of_nodes,
+    igraph_vector_ptr_t *newgs, igraph_vector_ptr_t *edge_ids) {
+  long int i, e, m, from, to, no_of_graphs = igraph_vector_ptr_size(gs);
+  igraph_vector_t edges, *eids, *map;
+  igraph_t *g, *newg;
+
+  IGRAPH_VECTOR_INIT_FINALLY(&edges, 0);
+
+  for (i = 0; i < no_of_graphs; i++) {
+    g = (igraph_t*)VECTOR(*gs)[i];
+    map = (igraph_vector_t*)VECTOR(*vertexmaps)[i];
+    m = igraph_ecount(g);
+
+    eids = (igraph_vector_t*)calloc(1, sizeof(igraph_vector_t));
+    if (eids == 0) {
+      IGRAPH_ERROR("cannot remap vertices of graph", IGRAPH_ENOMEM);
+    }
+    if (igraph_vector_init(eids, 0)) {
+      free(eids);
+      IGRAPH_ERROR("cannot remap vertices of graph", IGRAPH_ENOMEM);
+    }
+    if (igraph_vector_ptr_push_back(edge_ids, eids)) {
+      igraph_vector_destroy(eids);
+      free(eids);
+      IGRAPH_ERROR("cannot remap vertices of graph", IGRAPH_ENOMEM);
+    }
+    IGRAPH_CHECK(igraph_vector_reserve(eids, m));
+
+    igraph_vector_clear(&edges);
+    IGRAPH_CHECK(igraph_vector_reserve(&edges, 2 * m));
+    for (e = 0; e < m; e++) {
+      from = (long int)VECTOR(*map)[(long int)IGRAPH_FROM(g, e)];
+      to = (long int)VECTOR(*map)[(long int)IGRAPH_TO(g, e)];
+      if (from < 0 || to < 0)
+        continue;
+      igraph_vector_push_back(&edges, from);   /* reserved */
+      igraph_vector_push_back(&edges, to);     /* reserved */
+      igraph_vector_push_back(eids, e);        /* reserved */
+    }
+
+    newg = (igraph_t*)calloc(1, sizeof(igraph_t));
+    if (newg == 0) {
+      IGRAPH_ERROR("cannot remap vertices of graph", IGRAPH_ENOMEM);
+    }
+    if (igraph_create(newg, &edges, (igraph_integer_t) no_of_nodes,
+          igraph_is_directed(g))) {
+      free(newg);
+      IGRAPH_ERROR("cannot remap vertices of graph", IGRAPH_FAILURE);
+    }
+    if (igraph_vector_ptr_push_back(newgs, newg)) {
+      igraph_destroy(newg);
+      free(newg);
+      IGRAPH_ERROR("cannot remap vertices of graph", IGRAPH_ENOMEM);
+    }
   }
 
-  if (with_edgemaps) {
-    /* wrap in a dictionary */
-    result = PyDict_New();
-    PyDict_SetItemString(result, "graph", (PyObject *) o);
-    Py_DECREF(o);
-    PyDict_SetItemString(result, "edgemaps", em_list);
+  igraph_vector_destroy(&edges);
+  IGRAPH_FINALLY_CLEAN(1);
+
+  return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Translates the edge maps of remapped graphs back to the edge IDs
+ *        of the original graphs.
+ *
+ * \param gs        the original graphs
+ * \param edge_ids  the IDs of the original edges kept in the remapped graphs,
+ *                  see \ref igraphmodule_i_remap_graphs()
+ * \param edgemaps  the edge maps of the remapped graphs; they are updated
+ *                  in place. Original edges that were left out get -1
+ * \return error code
+ */
+static int igraphmodule_i_unmap_edgemaps(const igraph_vector_ptr_t *gs,
+    const igraph_vector_ptr_t *edge_ids, igraph_vector_ptr_t *edgemaps) {
+  long int i, j, n, no_of_graphs = igraph_vector_ptr_size(gs);
+  igraph_vector_t full, *map, *eids;
+
+  IGRAPH_VECTOR_INIT_FINALLY(&full, 0);
+
+  for (i = 0; i < no_of_graphs; i++) {
+    map = (igraph_vector_t*)VECTOR(*edgemaps)[i];
+    eids = (igraph_vector_t*)VECTOR(*edge_ids)[i];
+    IGRAPH_CHECK(igraph_vector_resize(&full,
+          igraph_ecount((igraph_t*)VECTOR(*gs)[i])));
+    igraph_vector_fill(&full, -1);
+    n = igraph_vector_size(eids);
+    for (j = 0; j < n; j++)
+      VECTOR(full)[(long int)VECTOR(*eids)[j]] = VECTOR(*map)[j];
+    IGRAPH_CHECK(igraph_vector_update(map, &full));
   }
-  else {
-    result = (PyObject *) o;
+
+  igraph_vector_destroy(&full);
+  IGRAPH_FINALLY_CLEAN(1);
+
+  return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup python_interface_graph
+ * \brief Converts a pointer vector of vectors to a list of lists of integers
+ */
+static PyObject* igraphmodule_i_vector_ptr_t_to_PyList(const igraph_vector_ptr_t *v) {
+  long int i, n = igraph_vector_ptr_size(v);
+  PyObject *list, *item;
+
+  list = PyList_New((Py_ssize_t) n);
+  if (list == 0)
+    return 0;
+
+  for (i = 0; i < n; i++) {
+    item = igraphmodule_vector_t_to_PyList(VECTOR(*v)[i], IGRAPHMODULE_TYPE_INT);
+    if (item == 0) {
+      Py_DECREF(list);
+      return 0;
+    }
+    PyList_SET_ITEM(list, (Py_ssize_t) i, item);
   }
 
-  return result;
+  return list;
 }
 
-/** \ingroup python_interface_graph
- * \brief Creates the intersection of two or more graphs
+/**
+ * \ingroup python_interface_graph
+ * \brief Common implementation of \ref igraphmodule__union() and
+ *        \ref igraphmodule__intersection()
+ *
+ * When \c byname is true, the vertices are matched by their names in C and
+ * the result gets a \c name vertex attribute. When \c comb_o is not \c None,
+ * the edge attributes of the graphs are combined into the edge attributes
+ * of the result according to the given attribute combination. The core of
+ * the operation runs without holding the GIL.
+ *
+ * \return the result graph, or a dict with keys \c graph, \c edgemaps
+ *         (if \c with_edgemaps is true) and \c vertexmaps (if \c byname is
+ *         true)
  */
-PyObject *igraphmodule__intersection(PyObject *self,
-		PyObject *args, PyObject *kwds)
-{
-  static char* kwlist[] = { "graphs", "edgemaps", NULL };
-  PyObject *it, *em_list = 0, *graphs, *with_edgemaps_o;
-  int with_edgemaps = 0;
-  long int no_of_graphs;
-  igraph_vector_ptr_t gs;
-  igraphmodule_GraphObject *o;
-  PyObject *result;
+static PyObject *igraphmodule_i_union_or_intersection(PyObject *graphs,
+    igraph_bool_t intersection, igraph_bool_t with_edgemaps,
+    igraph_bool_t byname, igraph_bool_t keep_all_vertices, PyObject *comb_o) {
+  PyObject *graph_list, *it, *names = 0, *list;
+  PyObject *result = 0;
   PyTypeObject *result_type;
+  igraphmodule_GraphObject *o;
+  igraph_vector_ptr_t gs, newgs, edge_ids, vertexmaps, edgemaps;
+  igraph_attribute_combination_t comb;
+  igraph_bool_t with_comb = (comb_o != Py_None);
+  igraph_vector_ptr_t *edgemaps_ptr = (with_edgemaps || with_comb) ? &edgemaps : 0;
+  long int i, no_of_graphs, no_of_nodes = 0;
   igraph_t g;
+  int retval;
 
-  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O", kwlist,
-      &graphs, &with_edgemaps_o))
+  /* Keep the graphs in a list so they stay alive while the GIL is released */
+  graph_list = PySequence_List(graphs);
+  if (graph_list == 0)
     return NULL;
 
-  if (PyObject_IsTrue(with_edgemaps_o))
-    with_edgemaps = 1;
-
-  /* Needs to be an iterable */
-  it = PyObject_GetIter(graphs);
-  if (!it) {
-      Py_DECREF(it);
-      return igraphmodule_handle_igraph_error();
-  }
-
   /* Get all elements, store the graphs in an igraph_vector_ptr */
   if (igraph_vector_ptr_init(&gs, 0)) {
-    Py_DECREF(it);
+    Py_DECREF(graph_list);
     return igraphmodule_handle_igraph_error();
   }
-  if (igraphmodule_append_PyIter_of_graphs_to_vector_ptr_t_with_type(it, &gs, &result_type)) {
-    Py_DECREF(it);
+  it = PyObject_GetIter(graph_list);
+  if (it == 0 ||
+      igraphmodule_append_PyIter_of_graphs_to_vector_ptr_t_with_type(it, &gs, &result_type)) {
+    Py_XDECREF(it);
+    Py_DECREF(graph_list);
     igraph_vector_ptr_destroy(&gs);
     return NULL;
   }
   Py_DECREF(it);
   no_of_graphs = (long int) igraph_vector_ptr_size(&gs);
 
-  if (with_edgemaps) {
-    /* prepare edgemaps */
-    igraph_vector_ptr_t edgemaps;
-    if (igraph_vector_ptr_init(&edgemaps, 0)) {
-      return igraphmodule_handle_igraph_error();
-    }
-
-    /* Create intersection */
-    if (igraph_intersection_many(&g, &gs, &edgemaps)) {
-      igraph_vector_ptr_destroy(&gs);
-      igraph_vector_ptr_destroy(&edgemaps);
-      igraphmodule_handle_igraph_error();
-      return NULL;
-    }
+  if (with_comb && igraphmodule_PyObject_to_attribute_combination_t(comb_o, &comb)) {
+    Py_DECREF(graph_list);
+    igraph_vector_ptr_destroy(&gs);
+    return NULL;
+  }
 
-    long int i;
-    em_list = PyList_New((Py_ssize_t) no_of_graphs);
-    for (i = 0; i < no_of_graphs; i++) {
-      long int j;
-      long int no_of_edges = (long int) igraph_ecount(VECTOR(gs)[i]);
-      igraph_vector_t *map = VECTOR(edgemaps)[i];
-      PyObject *emi = PyList_New((Py_ssize_t) no_of_edges);
-      for (j = 0; j < no_of_edges; j++) {
-        PyObject *dest = PyLong_FromLong(VECTOR(*map)[j]);
-        PyList_SET_ITEM(emi, (Py_ssize_t) j, dest);
-      }
-      PyList_SET_ITEM(em_list, (Py_ssize_t) i, emi);
-    }
-    igraph_vector_ptr_destroy(&edgemaps);
+  if (igraph_vector_ptr_init(&newgs, 0) || igraph_vector_ptr_init(&edge_ids, 0) ||
+      igraph_vector_ptr_init(&vertexmaps, 0) || igraph_vector_ptr_init(&edgemaps, 0)) {
+    /* we cannot tell which ones were initialized; this only happens when
+     * we are out of memory anyway */
+    Py_DECREF(graph_list);
+    igraph_vector_ptr_destroy(&gs);
+    if (with_comb)
+      igraph_attribute_combination_destroy(&comb);
+    return igraphmodule_handle_igraph_error();
+  }
+  IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(&newgs, igraph_destroy);
+  IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(&edge_ids, igraph_vector_destroy);
+  IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(&vertexmaps, igraph_vector_destroy);
+  IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(&edgemaps, igraph_vector_destroy);
+
+  if (byname) {
+    if (igraphmodule_i_match_vertices_by_name(&gs,
+          !intersection || keep_all_vertices, &vertexmaps, &names))
+      goto cleanup;
+    no_of_nodes = PyList_Size(names);
+  }
 
-  } 
-  else {
-    /* Create intersection */
-    if (igraph_intersection_many(&g, &gs, /* edgemaps */ 0)) {
-      igraph_vector_ptr_destroy(&gs);
-      igraphmodule_handle_igraph_error();
-      return NULL;
+  for (i = 0; i < no_of_graphs; i++)
+    ((igraphmodule_GraphObject*)PyList_GET_ITEM(graph_list, i))->busy++;
+
+  IGRAPHMODULE_BEGIN_NOGIL(0);
+  retval = 0;
+  if (byname)
+    retval = igraphmodule_i_remap_graphs(&gs, &vertexmaps, no_of_nodes,
+        &newgs, &edge_ids);
+  if (!retval) {
+    if (intersection)
+      retval = igraph_intersection_many(&g, byname ? &newgs : &gs, edgemaps_ptr);
+    else
+      retval = igraph_union_many(&g, byname ? &newgs : &gs, edgemaps_ptr);
+    if (!retval && byname && edgemaps_ptr) {
+      retval = igraphmodule_i_unmap_edgemaps(&gs, &edge_ids, edgemaps_ptr);
+      if (retval)
+        igraph_destroy(&g);
     }
   }
+  IGRAPHMODULE_END_NOGIL(0);
 
-  igraph_vector_ptr_destroy(&gs);
+  for (i = 0; i < no_of_graphs; i++)
+    ((igraphmodule_GraphObject*)PyList_GET_ITEM(graph_list, i))->busy--;
+
+  if (retval) {
+    igraphmodule_handle_igraph_error();
+    goto cleanup;
+  }
 
   /* this is correct as long as attributes are not copied by the
    * operator. if they are copied, the initialization should not empty
@@ -296,20 +503,106 @@ PyObject *igraphmodule__intersection(PyObject *self,
   else {
     o = (igraphmodule_GraphObject*) igraphmodule_Graph_from_igraph_t(&g);
   }
+  if (o == 0) {
+    igraph_destroy(&g);
+    goto cleanup;
+  }
 
-  if (with_edgemaps) {
-    /* wrap in a dictionary */
-    result = PyDict_New();
-    PyDict_SetItemString(result, "graph", (PyObject *) o);
+  if (byname && PyDict_SetItemString(ATTR_STRUCT_DICT(&o->g)[ATTRHASH_IDX_VERTEX],
+        "name", names)) {
     Py_DECREF(o);
-    PyDict_SetItemString(result, "edgemaps", em_list);
-    Py_DECREF(em_list);
+    goto cleanup;
   }
-  else {
+
+  if (with_comb &&
+      igraphmodule_attribute_combine_edges_many(&o->g, &gs, &edgemaps, &comb)) {
+    Py_DECREF(o);
+    goto cleanup;
+  }
+
+  if (!with_edgemaps && !byname) {
     result = (PyObject *) o;
+    goto cleanup;
   }
 
+  /* wrap in a dictionary */
+  result = PyDict_New();
+  if (result == 0 || PyDict_SetItemString(result, "graph", (PyObject *) o)) {
+    Py_XDECREF(result);
+    Py_DECREF(o);
+    result = 0;
+    goto cleanup;
+  }
+  Py_DECREF(o);
+
+  if (with_edgemaps) {
+    list = igraphmodule_i_vector_ptr_t_to_PyList(&edgemaps);
+    if (list == 0 || PyDict_SetItemString(result, "edgemaps", list)) {
+      Py_XDECREF(list);
+      Py_CLEAR(result);
+      goto cleanup;
+    }
+    Py_DECREF(list);
+  }
+
+  if (byname) {
+    list = igraphmodule_i_vector_ptr_t_to_PyList(&vertexmaps);
+    if (list == 0 || PyDict_SetItemString(result, "vertexmaps", list)) {
+      Py_XDECREF(list);
+      Py_CLEAR(result);
+      goto cleanup;
+    }
+    Py_DECREF(list);
+  }
+
+cleanup:
+  igraph_vector_ptr_destroy_all(&edgemaps);
+  igraph_vector_ptr_destroy_all(&vertexmaps);
+  igraph_vector_ptr_destroy_all(&edge_ids);
+  igraph_vector_ptr_destroy_all(&newgs);
+  igraph_vector_ptr_destroy(&gs);
+  if (with_comb)
+    igraph_attribute_combination_destroy(&comb);
+  Py_XDECREF(names);
+  Py_DECREF(graph_list);
+
   return result;
 }
 
+/** \ingroup python_interface_graph
+ * \brief Creates the union of two or more graphs
+ */
+PyObject *igraphmodule__union(PyObject *self,
+		PyObject *args, PyObject *kwds)
+{
+  static char* kwlist[] = { "graphs", "edgemaps", "byname", "combine_edges", NULL };
+  PyObject *graphs, *with_edgemaps_o = Py_False, *byname_o = Py_False;
+  PyObject *comb_o = Py_None;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOO", kwlist,
+      &graphs, &with_edgemaps_o, &byname_o, &comb_o))
+    return NULL;
+
+  return igraphmodule_i_union_or_intersection(graphs, 0,
+      PyObject_IsTrue(with_edgemaps_o), PyObject_IsTrue(byname_o), 1, comb_o);
+}
 
+/** \ingroup python_interface_graph
+ * \brief Creates the intersection of two or more graphs
+ */
+PyObject *igraphmodule__intersection(PyObject *self,
+		PyObject *args, PyObject *kwds)
+{
+  static char* kwlist[] = { "graphs", "edgemaps", "byname", "keep_all_vertices",
+    "combine_edges", NULL };
+  PyObject *graphs, *with_edgemaps_o = Py_False, *byname_o = Py_False;
+  PyObject *keep_all_vertices_o = Py_True, *comb_o = Py_None;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OOOO", kwlist,
+      &graphs, &with_edgemaps_o, &byname_o, &keep_all_vertices_o, &comb_o))
+    return NULL;
+
+  return igraphmodule_i_union_or_intersection(graphs, 1,
+      PyObject_IsTrue(with_edgemaps_o), PyObject_IsTrue(byname_o),
+      PyObject_IsTrue(keep_all_vertices_o), comb_o);
+}
@@ -0,0 +1,317 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#include "pagerank.h"
+#include "threading.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \ingroup python_interface_pagerank
+ * \brief The transition structure and the parameters shared by the workers
+ */
+typedef struct {
+  long int no_of_nodes;
+  // In-neighbors of the vertices in the layout of the adjacency lists,
+  // and the probability of stepping from each of them to the vertex
+  const long int *offsets;
+  long int *sources;
+  igraph_real_t *coefs;
+  // Vertices without outgoing edges (or only with zero weights); the walk
+  // restarts from the reset distribution when it gets stuck in them
+  long int *dangling;
+  long int no_of_dangling;
+  igraph_real_t damping;
+  igraph_real_t eps;
+  long int niter;
+  const igraph_vector_long_t *seed_offsets;
+  const igraph_vector_long_t *seeds;
+  const igraphmodule_pagerank_output_t *output;
+  long int no_of_workers;
+} igraphmodule_i_pagerank_job_t;
+
+/**
+ * \ingroup python_interface_pagerank
+ * \brief Workspace of a single worker thread
+ */
+typedef struct {
+  const igraphmodule_i_pagerank_job_t *job;
+  long int index;
+  igraph_real_t *x;
+  igraph_real_t *y;
+  // Min-heap of the best vertices seen so far when only the top scores
+  // are needed
+  long int *heap;
+} igraphmodule_i_pagerank_worker_t;
+
+/**
+ * \ingroup python_interface_pagerank
+ * \brief Whether vertex \c a ranks below vertex \c b; ties are broken by
+ *        the vertex IDs so that the top lists are deterministic
+ */
+static int igraphmodule_i_pagerank_below(const igraph_real_t *x, long int a, long int b) {
+  return x[a] < x[b] || (x[a] == x[b] && a > b);
+}
+
+static void igraphmodule_i_pagerank_sift_down(const igraph_real_t *x,
+    long int *heap, long int size, long int i) {
+  long int child, tmp;
+
+  while ((child = 2 * i + 1) < size) {
+    if (child + 1 < size && igraphmodule_i_pagerank_below(x, heap[child + 1], heap[child]))
+      child++;
+    if (!igraphmodule_i_pagerank_below(x, heap[child], heap[i]))
+      break;
+    tmp = heap[i]; heap[i] = heap[child]; heap[child] = tmp;
+    i = child;
+  }
+}
+
+/**
+ * \ingroup python_interface_pagerank
+ * \brief Writes the scores of a solved seed set to the output
+ */
+static void igraphmodule_i_pagerank_output(igraphmodule_i_pagerank_worker_t *w,
+    long int s) {
+  const igraphmodule_i_pagerank_job_t *job = w->job;
+  const igraphmodule_pagerank_output_t *output = job->output;
+  long int n = job->no_of_nodes, k = output->top_k, v, i, size = 0, tmp;
+  igraph_real_t *x = w->x;
+
+  if (k <= 0) {
+    for (v = 0; v < n; v++)
+      output->scores[s * output->seed_stride + v * output->vertex_stride] = x[v];
+    return;
+  }
+
+  for (v = 0; v < n; v++) {
+    if (size < k) {
+      /* sift up */
+      i = size++;
+      w->heap[i] = v;
+      while (i > 0 && igraphmodule_i_pagerank_below(x, w->heap[i], w->heap[(i - 1) / 2])) {
+        tmp = w->heap[i]; w->heap[i] = w->heap[(i - 1) / 2]; w->heap[(i - 1) / 2] = tmp;
+        i = (i - 1) / 2;
+      }
+    } else if (igraphmodule_i_pagerank_below(x, w->heap[0], v)) {
+      w->heap[0] = v;
+      igraphmodule_i_pagerank_sift_down(x, w->heap, size, 0);
+    }
+  }
+
+  /* Popping the lowest vertex repeatedly fills the list from its end */
+  while (size > 0) {
+    v = w->heap[0];
+    output->ids[s * k + size - 1] = v;
+    output->scores[s * k + size - 1] = x[v];
+    w->heap[0] = w->heap[--size];
+    igraphmodule_i_pagerank_sift_down(x, w->heap, size, 0);
+  }
+}
+
+/**
+ * \ingroup python_interface_pagerank
+ * \brief Solves the personalized PageRank of one seed set with the power
+ *        method
+ *
+ * The reset distribution is uniform over the vertices of the seed set
+ * (counted with multiplicity). The walkers stuck in dangling vertices
+ * restart from the reset distribution as well, like in the PRPACK-based
+ * implementation of the C core.
+ */
+static void igraphmodule_i_pagerank_solve(igraphmodule_i_pagerank_worker_t *w,
+    long int s) {
+  const igraphmodule_i_pagerank_job_t *job = w->job;
+  long int n = job->no_of_nodes, from = VECTOR(*job->seed_offsets)[s];
+  long int to = VECTOR(*job->seed_offsets)[s + 1], v, i, j, iter;
+  igraph_real_t *x = w->x, *y = w->y, *tmp, reset = 1.0 / (to - from);
+  igraph_real_t acc, stuck, diff, sum;
+
+  memset(x, 0, n * sizeof(igraph_real_t));
+  for (i = from; i < to; i++)
+    x[VECTOR(*job->seeds)[i]] += reset;
+
+  for (iter = 0; iter < job->niter; iter++) {
+    for (stuck = 0, i = 0; i < job->no_of_dangling; i++)
+      stuck += x[job->dangling[i]];
+    for (v = 0; v < n; v++) {
+      for (acc = 0, j = job->offsets[v]; j < job->offsets[v + 1]; j++)
+        acc += job->coefs[j] * x[job->sources[j]];
+      y[v] = job->damping * acc;
+    }
+    acc = (1 - job->damping + job->damping * stuck) * reset;
+    for (i = from; i < to; i++)
+      y[VECTOR(*job->seeds)[i]] += acc;
+
+    for (diff = 0, v = 0; v < n; v++)
+      diff += fabs(y[v] - x[v]);
+    tmp = x; x = y; y = tmp;
+    if (diff < job->eps)
+      break;
+  }
+
+  /* The scores sum up to 1 apart from rounding errors */
+  for (sum = 0, v = 0; v < n; v++)
+    sum += x[v];
+  for (v = 0; sum > 0 && v < n; v++)
+    x[v] /= sum;
+
+  w->x = x;
+  w->y = y;
+  igraphmodule_i_pagerank_output(w, s);
+}
+
+static void igraphmodule_i_pagerank_work(void *workers, long int index) {
+  igraphmodule_i_pagerank_worker_t *w =
+    &((igraphmodule_i_pagerank_worker_t*)workers)[index];
+  const igraphmodule_i_pagerank_job_t *job = w->job;
+  long int s, n = igraph_vector_long_size(job->seed_offsets) - 1;
+
+  for (s = w->index; s < n; s += job->no_of_workers)
+    igraphmodule_i_pagerank_solve(w, s);
+}
+
+static void igraphmodule_i_pagerank_workers_destroy(
+    igraphmodule_i_pagerank_worker_t *workers, long int no_of_workers) {
+  long int i;
+
+  for (i = 0; workers && i < no_of_workers; i++) {
+    free(workers[i].x);
+    free(workers[i].y);
+    free(workers[i].heap);
+  }
+  free(workers);
+}
+
+/**
+ * \ingroup python_interface_pagerank
+ * \brief Calculates personalized PageRank scores for many seed sets
+ *
+ * \param adj the adjacency lists of the graph for \c IGRAPH_IN in directed
+ *        graphs (the walk follows the edges) and for \c IGRAPH_ALL in
+ *        undirected graphs or if the directions are ignored
+ * \param weights the edge weights (all non-negative), or a null pointer
+ * \param damping the probability of following an edge in a step
+ * \param eps the iterations of a seed set stop when the L1 distance of two
+ *        consecutive score vectors is smaller than this
+ * \param niter the maximum number of iterations of a seed set
+ * \param seed_offsets the seed sets in the compressed sparse row format:
+ *        set \c s is <tt>seeds[seed_offsets[s]]</tt> to
+ *        <tt>seeds[seed_offsets[s+1]-1]</tt>; none of them may be empty
+ * \param threads the number of threads to use
+ * \param output where the scores are written
+ * \return \c IGRAPH_SUCCESS or \c IGRAPH_ENOMEM
+ */
+int igraphmodule_personalized_pagerank_batch(const igraph_t *graph,
+    const igraphmodule_adjacency_t *adj, const igraph_vector_t *weights,
+    igraph_real_t damping, igraph_real_t eps, long int niter,
+    const igraph_vector_long_t *seed_offsets, const igraph_vector_long_t *seeds,
+    long int threads, const igraphmodule_pagerank_output_t *output) {
+  igraphmodule_i_pagerank_job_t job;
+  igraphmodule_i_pagerank_worker_t *workers = 0, *w;
+  long int n = adj->no_of_nodes, m = adj->offsets[n];
+  long int no_of_sets = igraph_vector_long_size(seed_offsets) - 1;
+  long int i, j, v, e;
+  igraph_real_t *strength;
+  int retval = 0;
+
+  if (no_of_sets <= 0 || n == 0)
+    return IGRAPH_SUCCESS;
+
+  memset(&job, 0, sizeof(job));
+  job.no_of_nodes = n;
+  job.offsets = adj->offsets;
+  job.damping = damping;
+  job.eps = eps;
+  job.niter = niter;
+  job.seed_offsets = seed_offsets;
+  job.seeds = seeds;
+  job.output = output;
+
+  job.sources = (long int*)calloc(m > 0 ? m : 1, sizeof(long int));
+  job.coefs = (igraph_real_t*)calloc(m > 0 ? m : 1, sizeof(igraph_real_t));
+  job.dangling = (long int*)calloc(n, sizeof(long int));
+  strength = (igraph_real_t*)calloc(n, sizeof(igraph_real_t));
+  if (!job.sources || !job.coefs || !job.dangling || !strength) {
+    retval = IGRAPH_ENOMEM;
+    goto cleanup;
+  }
+
+  /* Transition probabilities: the weight of the edge divided by the
+   * out-strength of its source */
+  for (v = 0; v < n; v++) {
+    for (j = adj->offsets[v]; j < adj->offsets[v + 1]; j++) {
+      e = adj->edges[j];
+      job.sources[j] = IGRAPH_FROM(graph, e) == v ?
+        (long int) IGRAPH_TO(graph, e) : (long int) IGRAPH_FROM(graph, e);
+      job.coefs[j] = weights ? VECTOR(*weights)[e] : 1;
+      strength[job.sources[j]] += job.coefs[j];
+    }
+  }
+  for (j = 0; j < m; j++)
+    job.coefs[j] = strength[job.sources[j]] > 0 ? job.coefs[j] / strength[job.sources[j]] : 0;
+  for (v = 0; v < n; v++) {
+    if (!(strength[v] > 0))
+      job.dangling[job.no_of_dangling++] = v;
+  }
+
+  if (threads > no_of_sets)
+    threads = no_of_sets;
+  if (threads < 1)
+    threads = 1;
+  job.no_of_workers = threads;
+
+  workers = (igraphmodule_i_pagerank_worker_t*)calloc(threads,
+      sizeof(igraphmodule_i_pagerank_worker_t));
+  if (!workers) {
+    retval = IGRAPH_ENOMEM;
+    goto cleanup;
+  }
+
+  for (i = 0; i < threads; i++) {
+    w = &workers[i];
+    w->job = &job;
+    w->index = i;
+    w->x = (igraph_real_t*)calloc(n, sizeof(igraph_real_t));
+    w->y = (igraph_real_t*)calloc(n, sizeof(igraph_real_t));
+    if (output->top_k > 0)
+      w->heap = (long int*)calloc(output->top_k, sizeof(long int));
+    if (!w->x || !w->y || (output->top_k > 0 && !w->heap)) {
+      retval = IGRAPH_ENOMEM;
+      goto cleanup;
+    }
+  }
+
+  igraphmodule_run_workers(igraphmodule_i_pagerank_work, workers, threads, threads);
+
+cleanup:
+  igraphmodule_i_pagerank_workers_destroy(workers, threads);
+  free(job.sources);
+  free(job.coefs);
+  free(job.dangling);
+  free(strength);
+
+  return retval;
+}
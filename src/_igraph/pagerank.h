@@ -0,0 +1,71 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+
+#ifndef PYTHON_PAGERANK_H
+#define PYTHON_PAGERANK_H
+
+#include <Python.h>
+#include <igraph.h>
+#include "adjacency.h"
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_pagerank Batched personalized PageRank
+ *
+ * Personalized PageRank for many reset distributions at once. The
+ * transition structure (the weighted in-neighbor lists of the vertices,
+ * each weight divided by the out-strength of the neighbor) is built once
+ * from the cached adjacency lists and shared by all the reset vectors;
+ * each of them is then solved with the power method by one of several
+ * threads. The functions below do not touch Python objects and do not
+ * use the error handling of the C core, so they can be called without
+ * holding the GIL.
+ */
+
+/**
+ * \ingroup python_interface_pagerank
+ * \brief Where the scores of the solved reset vectors are written
+ *
+ * If \c top_k is zero, the score of vertex \c v for seed set \c s is
+ * written to <tt>scores[s * seed_stride + v * vertex_stride]</tt>, so both
+ * row-major and column-major matrices can be filled. Otherwise the \c top_k
+ * highest scores of each seed set are written to <tt>scores[s * top_k]</tt>
+ * onwards in decreasing order, and the corresponding vertices to \c ids.
+ */
+typedef struct {
+  long int top_k;
+  igraph_real_t *scores;
+  PY_LONG_LONG *ids;
+  long int seed_stride;
+  long int vertex_stride;
+} igraphmodule_pagerank_output_t;
+
+int igraphmodule_personalized_pagerank_batch(const igraph_t *graph,
+    const igraphmodule_adjacency_t *adj, const igraph_vector_t *weights,
+    igraph_real_t damping, igraph_real_t eps, long int niter,
+    const igraph_vector_long_t *seed_offsets, const igraph_vector_long_t *seeds,
+    long int threads, const igraphmodule_pagerank_output_t *output);
+
+#endif
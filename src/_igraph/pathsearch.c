@@ -0,0 +1,358 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include "pathsearch.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \ingroup python_interface_pathsearch
+ * \brief Takes the adjacency lists and a copy of the weights of a graph
+ *
+ * Must be called with the GIL held. The weights are copied as they are;
+ * checking their sign is left to the caller.
+ *
+ * \param mode the direction of the paths; ignored for undirected graphs
+ * \param weights the edge weights, or a null pointer for unweighted paths
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case and \c graph is left empty.
+ */
+int igraphmodule_pathsearch_graph_init(igraphmodule_pathsearch_graph_t *graph,
+    const igraph_t *g, igraph_neimode_t mode, const igraph_vector_t *weights) {
+  long int i, no_of_edges = igraph_ecount(g);
+
+  memset(graph, 0, sizeof(igraphmodule_pathsearch_graph_t));
+  graph->no_of_nodes = igraph_vcount(g);
+  graph->no_of_edges = no_of_edges;
+
+  if (weights) {
+    if (igraph_vector_size(weights) != no_of_edges) {
+      PyErr_SetString(PyExc_ValueError, "weight vector length must match "
+          "the number of edges");
+      return 1;
+    }
+    graph->weights = (igraph_real_t*)calloc(no_of_edges > 0 ? no_of_edges : 1,
+        sizeof(igraph_real_t));
+    if (!graph->weights) {
+      PyErr_NoMemory();
+      return 1;
+    }
+    for (i = 0; i < no_of_edges; i++) {
+      graph->weights[i] = VECTOR(*weights)[i];
+    }
+  }
+
+  if (!igraph_is_directed(g)) {
+    mode = IGRAPH_ALL;
+  } else if (mode == IGRAPH_ALL) {
+    graph->adj[1] = igraphmodule_acquire_adjacency(g, IGRAPH_IN);
+    if (!graph->adj[1]) {
+      igraphmodule_pathsearch_graph_destroy(graph);
+      return 1;
+    }
+    mode = IGRAPH_OUT;
+  }
+
+  graph->adj[0] = igraphmodule_acquire_adjacency(g, mode);
+  if (!graph->adj[0]) {
+    igraphmodule_pathsearch_graph_destroy(graph);
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_pathsearch
+ * \brief Drops the references to the adjacency lists and frees the weights
+ *
+ * Must be called with the GIL held.
+ */
+void igraphmodule_pathsearch_graph_destroy(igraphmodule_pathsearch_graph_t *graph) {
+  if (graph->adj[0]) {
+    igraphmodule_adjacency_decref(graph->adj[0]);
+  }
+  if (graph->adj[1]) {
+    igraphmodule_adjacency_decref(graph->adj[1]);
+  }
+  free(graph->weights);
+  memset(graph, 0, sizeof(igraphmodule_pathsearch_graph_t));
+}
+
+/**
+ * \ingroup python_interface_pathsearch
+ * \brief Allocates the workspace of searches on the given graph
+ *
+ * \param count_paths whether to count the shortest paths in \c sigma
+ * \param epsilon the relative tolerance of comparing weighted path lengths;
+ *        ties only matter when the paths are counted
+ * \return \c IGRAPH_SUCCESS or \c IGRAPH_ENOMEM
+ */
+int igraphmodule_pathsearch_init(igraphmodule_pathsearch_t *search,
+    const igraphmodule_pathsearch_graph_t *graph, igraph_bool_t count_paths,
+    igraph_real_t epsilon) {
+  long int i, n = graph->no_of_nodes > 0 ? graph->no_of_nodes : 1;
+
+  memset(search, 0, sizeof(igraphmodule_pathsearch_t));
+  search->graph = graph;
+  search->epsilon = epsilon;
+
+  search->dist = (igraph_real_t*)calloc(n, sizeof(igraph_real_t));
+  search->order = (long int*)calloc(n, sizeof(long int));
+  search->reached = search->order;
+  if (count_paths) {
+    search->sigma = (igraph_real_t*)calloc(n, sizeof(igraph_real_t));
+  }
+  if (graph->weights) {
+    search->reached = (long int*)calloc(n, sizeof(long int));
+    search->heap = (long int*)calloc(n, sizeof(long int));
+    search->heap_pos = (long int*)calloc(n, sizeof(long int));
+  }
+
+  if (!search->dist || !search->order || !search->reached ||
+      (count_paths && !search->sigma) ||
+      (graph->weights && (!search->heap || !search->heap_pos))) {
+    igraphmodule_pathsearch_destroy(search);
+    return IGRAPH_ENOMEM;
+  }
+
+  for (i = 0; i < n; i++) {
+    search->dist[i] = IGRAPH_INFINITY;
+  }
+  for (i = 0; graph->weights && i < n; i++) {
+    search->heap_pos[i] = -1;
+  }
+
+  return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup python_interface_pathsearch
+ * \brief Frees the workspace of a search
+ */
+void igraphmodule_pathsearch_destroy(igraphmodule_pathsearch_t *search) {
+  free(search->dist);
+  free(search->sigma);
+  if (search->reached != search->order) {
+    free(search->reached);
+  }
+  free(search->order);
+  free(search->heap);
+  free(search->heap_pos);
+  memset(search, 0, sizeof(igraphmodule_pathsearch_t));
+}
+
+/**
+ * \ingroup python_interface_pathsearch
+ * \brief Compares two weighted path lengths with a relative tolerance
+ *
+ * \return zero if the two lengths are considered equal, a negative number
+ *         if \c a is smaller and a positive one if \c a is larger
+ */
+int igraphmodule_pathsearch_compare(igraph_real_t a, igraph_real_t b,
+    igraph_real_t epsilon) {
+  igraph_real_t diff = a - b, scale = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
+  if (fabs(diff) <= epsilon * scale) {
+    return 0;
+  }
+  return diff < 0 ? -1 : 1;
+}
+
+/**
+ * \ingroup python_interface_pathsearch
+ * \brief Moves the item at the given position of the heap towards the root
+ *        until the heap property is restored
+ */
+static void igraphmodule_i_pathsearch_sift_up(igraphmodule_pathsearch_t *search,
+    long int pos) {
+  long int *heap = search->heap, *heap_pos = search->heap_pos;
+  long int v = heap[pos], parent;
+  igraph_real_t d = search->dist[v];
+
+  while (pos > 0) {
+    parent = (pos - 1) / 2;
+    if (search->dist[heap[parent]] <= d) {
+      break;
+    }
+    heap[pos] = heap[parent];
+    heap_pos[heap[pos]] = pos;
+    pos = parent;
+  }
+
+  heap[pos] = v;
+  heap_pos[v] = pos;
+}
+
+/**
+ * \ingroup python_interface_pathsearch
+ * \brief Removes and returns the vertex at the root of the heap
+ */
+static long int igraphmodule_i_pathsearch_pop(igraphmodule_pathsearch_t *search) {
+  long int *heap = search->heap, *heap_pos = search->heap_pos;
+  long int top = heap[0], size = --search->heap_size;
+  long int pos = 0, child, v;
+  igraph_real_t d;
+
+  heap_pos[top] = -1;
+  if (size == 0) {
+    return top;
+  }
+
+  v = heap[size];
+  d = search->dist[v];
+  while ((child = 2 * pos + 1) < size) {
+    if (child + 1 < size &&
+        search->dist[heap[child + 1]] < search->dist[heap[child]]) {
+      child++;
+    }
+    if (d <= search->dist[heap[child]]) {
+      break;
+    }
+    heap[pos] = heap[child];
+    heap_pos[heap[pos]] = pos;
+    pos = child;
+  }
+  heap[pos] = v;
+  heap_pos[v] = pos;
+
+  return top;
+}
+
+/**
+ * \ingroup python_interface_pathsearch
+ * \brief Finds the shortest paths from a source vertex
+ *
+ * Unweighted graphs are searched with a BFS that does not expand the
+ * vertices at the cutoff, weighted graphs with Dijkstra's algorithm that
+ * stops at the first vertex beyond the cutoff. Fills \c dist (and \c sigma
+ * if the paths are counted) for the vertices within the cutoff and lists
+ * them in \c order; every other vertex is left at an infinite distance.
+ *
+ * \param cutoff paths longer than this are ignored; negative means no limit
+ */
+void igraphmodule_pathsearch_run(igraphmodule_pathsearch_t *search,
+    long int source, igraph_real_t cutoff) {
+  const igraphmodule_pathsearch_graph_t *graph = search->graph;
+  const igraphmodule_adjacency_t *adj;
+  igraph_real_t *dist = search->dist, *sigma = search->sigma, alt;
+  long int i, j, k, end, v, u, head;
+  int cmp;
+
+  for (i = 0; i < search->no_of_reached; i++) {
+    v = search->reached[i];
+    dist[v] = IGRAPH_INFINITY;
+    if (sigma) {
+      sigma[v] = 0;
+    }
+  }
+
+  dist[source] = 0;
+  if (sigma) {
+    sigma[source] = 1;
+  }
+  search->no_of_settled = 0;
+
+  if (!graph->weights) {
+    search->order[search->no_of_settled++] = source;
+    for (head = 0; head < search->no_of_settled; head++) {
+      v = search->order[head];
+      if (cutoff >= 0 && dist[v] + 1 > cutoff) {
+        continue;
+      }
+      for (k = 0; k < 2 && graph->adj[k]; k++) {
+        adj = graph->adj[k];
+        end = adj->offsets[v + 1];
+        for (j = adj->offsets[v]; j < end; j++) {
+          u = adj->neighbors[j];
+          if (dist[u] == IGRAPH_INFINITY) {
+            dist[u] = dist[v] + 1;
+            search->order[search->no_of_settled++] = u;
+          }
+          if (sigma && dist[u] == dist[v] + 1) {
+            sigma[u] += sigma[v];
+          }
+        }
+      }
+    }
+    search->no_of_reached = search->no_of_settled;
+    return;
+  }
+
+  search->no_of_reached = 0;
+  search->reached[search->no_of_reached++] = source;
+  search->heap[0] = source;
+  search->heap_pos[source] = 0;
+  search->heap_size = 1;
+  while (search->heap_size > 0) {
+    if (cutoff >= 0 && dist[search->heap[0]] > cutoff) {
+      break;
+    }
+    v = igraphmodule_i_pathsearch_pop(search);
+    search->order[search->no_of_settled++] = v;
+
+    for (k = 0; k < 2 && graph->adj[k]; k++) {
+      adj = graph->adj[k];
+      end = adj->offsets[v + 1];
+      for (j = adj->offsets[v]; j < end; j++) {
+        u = adj->neighbors[j];
+        alt = dist[v] + graph->weights[adj->edges[j]];
+        if (alt == IGRAPH_INFINITY) {
+          /* An edge of infinite length does not lead anywhere */
+          continue;
+        }
+        if (dist[u] == IGRAPH_INFINITY) {
+          dist[u] = alt;
+          if (sigma) {
+            sigma[u] = sigma[v];
+          }
+          search->reached[search->no_of_reached++] = u;
+          search->heap[search->heap_size] = u;
+          igraphmodule_i_pathsearch_sift_up(search, search->heap_size++);
+        } else if (search->heap_pos[u] >= 0) {
+          cmp = igraphmodule_pathsearch_compare(alt, dist[u], search->epsilon);
+          if (cmp < 0) {
+            dist[u] = alt;
+            if (sigma) {
+              sigma[u] = sigma[v];
+            }
+            igraphmodule_i_pathsearch_sift_up(search, search->heap_pos[u]);
+          } else if (cmp == 0 && sigma) {
+            sigma[u] += sigma[v];
+          }
+        }
+      }
+    }
+  }
+
+  /* Vertices left in the heap are beyond the cutoff */
+  while (search->heap_size > 0) {
+    v = search->heap[--search->heap_size];
+    search->heap_pos[v] = -1;
+    dist[v] = IGRAPH_INFINITY;
+    if (sigma) {
+      sigma[v] = 0;
+    }
+  }
+}
@@ -0,0 +1,106 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef PYTHON_PATHSEARCH_H
+#define PYTHON_PATHSEARCH_H
+
+#include <Python.h>
+#include <igraph.h>
+#include "adjacency.h"
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_pathsearch Single-source shortest path searches
+ *
+ * Breadth-first searches and Dijkstra's algorithm on the cached adjacency
+ * lists of a graph, with a workspace that is reused from one search to the
+ * next. Apart from \ref igraphmodule_pathsearch_graph_init() and
+ * \ref igraphmodule_pathsearch_graph_destroy(), the functions below do not
+ * touch Python objects or the error handling of the C core, so several
+ * threads may search the same graph at once without holding the GIL, each
+ * with a workspace of its own.
+ */
+
+/**
+ * \ingroup python_interface_pathsearch
+ * \brief The graph being searched
+ *
+ * Holds references to the adjacency lists, so it stays valid even if the
+ * graph it was made of is modified or deleted.
+ */
+typedef struct {
+  // Adjacency lists in the direction of the paths. Paths in both directions
+  // of a directed graph use the out-lists and the in-lists, so that each
+  // neighbor is found next to the edge leading to it; adj[1] is a null
+  // pointer otherwise
+  igraphmodule_adjacency_t *adj[2];
+  long int no_of_nodes;
+  long int no_of_edges;
+  // Edge weights indexed by edge ID, null pointer if unweighted
+  igraph_real_t *weights;
+} igraphmodule_pathsearch_graph_t;
+
+/**
+ * \ingroup python_interface_pathsearch
+ * \brief Workspace and results of a search
+ *
+ * Every array has one item per vertex. \c dist is kept at infinity and
+ * \c sigma at zero between searches; only the entries of the vertices
+ * reached by the last search are reset when the next one starts.
+ */
+typedef struct {
+  const igraphmodule_pathsearch_graph_t *graph;
+  // Weighted path lengths whose difference is at most this much relative
+  // to their size are considered equal
+  igraph_real_t epsilon;
+  igraph_real_t *dist;
+  // Number of shortest paths from the source, null pointer if not counted
+  igraph_real_t *sigma;
+  // Vertices within the cutoff in non-decreasing order of their distance
+  long int *order;
+  long int no_of_settled;
+  // Vertices touched by the last search; the same as order if unweighted
+  long int *reached;
+  long int no_of_reached;
+  // Binary heap of Dijkstra's algorithm and the position of each vertex in
+  // it (-1 if the vertex is not in the heap)
+  long int *heap;
+  long int *heap_pos;
+  long int heap_size;
+} igraphmodule_pathsearch_t;
+
+int igraphmodule_pathsearch_graph_init(igraphmodule_pathsearch_graph_t *graph,
+    const igraph_t *g, igraph_neimode_t mode, const igraph_vector_t *weights);
+void igraphmodule_pathsearch_graph_destroy(igraphmodule_pathsearch_graph_t *graph);
+
+int igraphmodule_pathsearch_init(igraphmodule_pathsearch_t *search,
+    const igraphmodule_pathsearch_graph_t *graph, igraph_bool_t count_paths,
+    igraph_real_t epsilon);
+void igraphmodule_pathsearch_destroy(igraphmodule_pathsearch_t *search);
+void igraphmodule_pathsearch_run(igraphmodule_pathsearch_t *search,
+    long int source, igraph_real_t cutoff);
+int igraphmodule_pathsearch_compare(igraph_real_t a, igraph_real_t b,
+    igraph_real_t epsilon);
+
+#endif
@@ -0,0 +1,422 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include "pathsiter.h"
+#include <math.h>
+#include <string.h>
+#include "bufferobject.h"
+#include "common.h"
+#include "convert.h"
+#include "error.h"
+#include "py2compat.h"
+#include "threading.h"
+
+PyTypeObject igraphmodule_ShortestPathsIterType;
+
+/**
+ * \ingroup python_interface_pathsiter
+ * \brief Search workspace of a single worker thread
+ */
+struct igraphmodule_i_ShortestPathsWorker {
+  igraphmodule_ShortestPathsIterObject *iter;
+  long int index;
+  igraphmodule_pathsearch_t search;
+};
+
+typedef struct igraphmodule_i_ShortestPathsWorker igraphmodule_i_ShortestPathsWorker;
+
+/**
+ * \ingroup python_interface_pathsiter
+ * \brief Checks the weights and prepares the graph for the searches
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+static int igraphmodule_i_ShortestPathsIter_init_graph(
+    igraphmodule_ShortestPathsIterObject *self, const igraph_t *graph,
+    const igraph_vector_t *weights, igraph_neimode_t mode) {
+  long int i, n = weights ? igraph_vector_size(weights) : 0;
+
+  for (i = 0; i < n; i++) {
+    if (!(VECTOR(*weights)[i] >= 0)) {
+      PyErr_SetString(PyExc_ValueError, "weights must be non-negative");
+      return 1;
+    }
+  }
+
+  return igraphmodule_pathsearch_graph_init(&self->graph, graph, mode, weights);
+}
+
+/**
+ * \ingroup python_interface_pathsiter
+ * \brief Allocates the workspaces of the worker threads
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+static int igraphmodule_i_ShortestPathsIter_init_workers(
+    igraphmodule_ShortestPathsIterObject *self, long int no_of_workers) {
+  long int i;
+  igraphmodule_i_ShortestPathsWorker *worker;
+
+  self->workers = (igraphmodule_i_ShortestPathsWorker*)calloc(no_of_workers,
+      sizeof(igraphmodule_i_ShortestPathsWorker));
+  if (!self->workers) {
+    PyErr_NoMemory();
+    return 1;
+  }
+  self->no_of_workers = no_of_workers;
+
+  for (i = 0; i < no_of_workers; i++) {
+    worker = &self->workers[i];
+    worker->iter = self;
+    worker->index = i;
+    if (igraphmodule_pathsearch_init(&worker->search, &self->graph, 0, 0)) {
+      PyErr_NoMemory();
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_pathsiter
+ * \brief Allocate a new shortest path iterator for the given graph
+ * \param g the graph object being referenced
+ * \param sources the source vertices
+ * \param targets the target vertices; these form the columns of the blocks
+ * \param weights the edge weights, or a null pointer for unweighted paths
+ * \param mode the direction of the paths in directed graphs
+ * \param chunk the maximum number of source vertices in a block
+ * \param threads the number of worker threads to use
+ * \param reduce_o what to return for each source instead of the distances
+ *   to the targets; \c None, \c "eccentricity" or \c "harmonic"
+ * \return the allocated PyObject
+ */
+PyObject* igraphmodule_ShortestPathsIter_new(igraphmodule_GraphObject *g,
+    igraph_vs_t sources, igraph_vs_t targets, const igraph_vector_t *weights,
+    igraph_neimode_t mode, long int chunk, long int threads,
+    PyObject *reduce_o) {
+  static igraphmodule_enum_translation_table_entry_t reduce_tt[] = {
+        {"eccentricity", IGRAPHMODULE_PATHS_REDUCE_ECCENTRICITY},
+        {"harmonic", IGRAPHMODULE_PATHS_REDUCE_HARMONIC},
+        {0,0}
+    };
+  igraphmodule_ShortestPathsIterObject *o;
+  igraphmodule_paths_reduce_t reduce = IGRAPHMODULE_PATHS_REDUCE_NONE;
+
+  if (chunk <= 0) {
+    PyErr_SetString(PyExc_ValueError, "chunk must be positive");
+    return NULL;
+  }
+  if (threads <= 0) {
+    PyErr_SetString(PyExc_ValueError, "threads must be positive");
+    return NULL;
+  }
+  if (igraphmodule_PyObject_to_enum(reduce_o, reduce_tt, (int*)&reduce)) {
+    return NULL;
+  }
+
+  o = PyObject_New(igraphmodule_ShortestPathsIterObject,
+      &igraphmodule_ShortestPathsIterType);
+  if (o == NULL) {
+    return NULL;
+  }
+
+  memset(&o->graph, 0, sizeof(o->graph));
+  o->chunk = chunk;
+  o->pos = 0;
+  o->reduce = reduce;
+  o->no_of_workers = 0;
+  o->workers = 0;
+  o->block_start = o->block_size = o->block_workers = 0;
+  o->block = 0;
+
+  if (igraph_vector_init(&o->sources, 0)) {
+    igraph_vector_init(&o->targets, 0);
+    Py_DECREF(o);
+    return igraphmodule_handle_igraph_error();
+  }
+  if (igraph_vector_init(&o->targets, 0)) {
+    Py_DECREF(o);
+    return igraphmodule_handle_igraph_error();
+  }
+
+  if (igraph_vs_as_vector(&g->g, sources, &o->sources) ||
+      igraph_vs_as_vector(&g->g, targets, &o->targets)) {
+    Py_DECREF(o);
+    return igraphmodule_handle_igraph_error();
+  }
+
+  if (igraphmodule_i_ShortestPathsIter_init_graph(o, &g->g, weights, mode)) {
+    Py_DECREF(o);
+    return NULL;
+  }
+
+  /* More workers than sources in a block would never get any work */
+  if (threads > chunk) {
+    threads = chunk;
+  }
+  if (igraphmodule_i_ShortestPathsIter_init_workers(o, threads)) {
+    Py_DECREF(o);
+    return NULL;
+  }
+
+  RC_ALLOC("ShortestPathsIter", o);
+
+  return (PyObject*)o;
+}
+
+/**
+ * \ingroup python_interface_pathsiter
+ * \brief Deallocates a Python representation of a given shortest path iterator
+ */
+static void igraphmodule_ShortestPathsIter_dealloc(
+    igraphmodule_ShortestPathsIterObject* self) {
+  long int i;
+
+  for (i = 0; i < self->no_of_workers; i++) {
+    igraphmodule_pathsearch_destroy(&self->workers[i].search);
+  }
+  free(self->workers);
+  igraphmodule_pathsearch_graph_destroy(&self->graph);
+  igraph_vector_destroy(&self->sources);
+  igraph_vector_destroy(&self->targets);
+
+  RC_DEALLOC("ShortestPathsIter", self);
+
+  PyObject_Del((PyObject*)self);
+}
+
+static PyObject* igraphmodule_ShortestPathsIter_iter(
+    igraphmodule_ShortestPathsIterObject* self) {
+  Py_INCREF(self);
+  return (PyObject*)self;
+}
+
+/**
+ * \ingroup python_interface_pathsiter
+ * \brief Calculates the rows of the current block that belong to a worker
+ *
+ * Worker \em i handles rows \em i, \em i+k, \em i+2k and so on where \em k
+ * is the number of workers used for the block. Does not touch the Python
+ * API or the C core, therefore it may run in a thread of its own.
+ */
+static void igraphmodule_i_ShortestPathsWorker_run(
+    igraphmodule_i_ShortestPathsWorker *worker) {
+  igraphmodule_ShortestPathsIterObject *iter = worker->iter;
+  long int rows = iter->block_size;
+  long int no_of_targets = igraph_vector_size(&iter->targets);
+  const igraph_real_t *dist = worker->search.dist;
+  long int i, j, source, target;
+  igraph_real_t d, value;
+
+  for (i = worker->index; i < rows; i += iter->block_workers) {
+    source = (long int) VECTOR(iter->sources)[iter->block_start + i];
+    igraphmodule_pathsearch_run(&worker->search, source, -1);
+
+    switch (iter->reduce) {
+      case IGRAPHMODULE_PATHS_REDUCE_ECCENTRICITY:
+        value = 0;
+        for (j = 0; j < no_of_targets; j++) {
+          d = dist[(long int) VECTOR(iter->targets)[j]];
+          if (d != IGRAPH_INFINITY && d > value) {
+            value = d;
+          }
+        }
+        iter->block[i] = value;
+        break;
+
+      case IGRAPHMODULE_PATHS_REDUCE_HARMONIC:
+        value = 0;
+        for (j = 0; j < no_of_targets; j++) {
+          target = (long int) VECTOR(iter->targets)[j];
+          if (target != source) {
+            value += 1.0 / dist[target];
+          }
+        }
+        iter->block[i] = value;
+        break;
+
+      default:
+        /* The block is a column-major matrix with one row per source */
+        for (j = 0; j < no_of_targets; j++) {
+          iter->block[i + j * rows] = dist[(long int) VECTOR(iter->targets)[j]];
+        }
+    }
+  }
+}
+
+static void igraphmodule_i_ShortestPathsWorker_job(void *workers, long int index) {
+  igraphmodule_i_ShortestPathsWorker_run(
+      &((igraphmodule_i_ShortestPathsWorker*)workers)[index]);
+}
+
+/**
+ * \ingroup python_interface_pathsiter
+ * \brief Calculates the current block with all the workers
+ *
+ * The GIL is released for the duration of the calculation; neither the
+ * workers nor this function touch the Python API or the C core.
+ */
+static void igraphmodule_i_ShortestPathsIter_fill_block(
+    igraphmodule_ShortestPathsIterObject *self) {
+  long int no_of_workers;
+
+  no_of_workers = self->no_of_workers;
+  if (no_of_workers > self->block_size) {
+    no_of_workers = self->block_size;
+  }
+  self->block_workers = no_of_workers;
+
+  Py_BEGIN_ALLOW_THREADS
+  igraphmodule_run_workers(igraphmodule_i_ShortestPathsWorker_job,
+      self->workers, no_of_workers, no_of_workers);
+  Py_END_ALLOW_THREADS
+}
+
+/**
+ * \ingroup python_interface_pathsiter
+ * \brief Calculates and returns the next block of the iterator
+ *
+ * \return a L{Buffer} with one row per source vertex and one column per
+ *   target vertex, or a vector with one item per source vertex if a
+ *   reduction was requested
+ */
+static PyObject* igraphmodule_ShortestPathsIter_iternext(
+    igraphmodule_ShortestPathsIterObject* self) {
+  igraph_vector_t vector;
+  igraph_matrix_t matrix;
+  PyObject *result;
+  long int rows, no_of_sources = igraph_vector_size(&self->sources);
+
+  if (self->pos >= no_of_sources) {
+    return NULL;
+  }
+
+  rows = no_of_sources - self->pos;
+  if (rows > self->chunk) {
+    rows = self->chunk;
+  }
+
+  if (self->reduce != IGRAPHMODULE_PATHS_REDUCE_NONE) {
+    if (igraph_vector_init(&vector, rows)) {
+      return igraphmodule_handle_igraph_error();
+    }
+    self->block = VECTOR(vector);
+  } else {
+    if (igraph_matrix_init(&matrix, rows, igraph_vector_size(&self->targets))) {
+      return igraphmodule_handle_igraph_error();
+    }
+    self->block = VECTOR(matrix.data);
+  }
+
+  self->block_start = self->pos;
+  self->block_size = rows;
+  igraphmodule_i_ShortestPathsIter_fill_block(self);
+  self->block = 0;
+  self->pos += rows;
+
+  if (self->reduce != IGRAPHMODULE_PATHS_REDUCE_NONE) {
+    result = igraphmodule_Buffer_from_vector_t(&vector);
+    igraph_vector_destroy(&vector);
+  } else {
+    result = igraphmodule_Buffer_from_matrix_t(&matrix);
+    igraph_matrix_destroy(&matrix);
+  }
+
+  return result;
+}
+
+/**
+ * \ingroup python_interface_pathsiter
+ * \brief Returns the number of blocks that are yet to be returned
+ */
+static PyObject* igraphmodule_ShortestPathsIter_length_hint(
+    igraphmodule_ShortestPathsIterObject* self) {
+  long int remaining = igraph_vector_size(&self->sources) - self->pos;
+  return PyInt_FromLong((remaining + self->chunk - 1) / self->chunk);
+}
+
+/**
+ * \ingroup python_interface_pathsiter
+ * Method table for the \c igraph.ShortestPathsIter object
+ */
+static PyMethodDef igraphmodule_ShortestPathsIter_methods[] = {
+  {"__length_hint__", (PyCFunction)igraphmodule_ShortestPathsIter_length_hint,
+    METH_NOARGS, "Returns the number of blocks that are yet to be returned."},
+  {NULL}
+};
+
+/** \ingroup python_interface_pathsiter
+ * Python type object referencing the methods Python calls when it performs
+ * various operations on a shortest path iterator
+ */
+PyTypeObject igraphmodule_ShortestPathsIterType =
+{
+  PyVarObject_HEAD_INIT(0, 0)
+  "igraph.ShortestPathsIter",               // tp_name
+  sizeof(igraphmodule_ShortestPathsIterObject), // tp_basicsize
+  0,                                        // tp_itemsize
+  (destructor)igraphmodule_ShortestPathsIter_dealloc, // tp_dealloc
+  0,                                        // tp_print
+  0,                                        // tp_getattr
+  0,                                        // tp_setattr
+  0,                                        /* tp_compare (2.x) / tp_reserved (3.x) */
+  0,                                        // tp_repr
+  0,                                        // tp_as_number
+  0,                                        // tp_as_sequence
+  0,                                        // tp_as_mapping
+  0,                                        // tp_hash
+  0,                                        // tp_call
+  0,                                        // tp_str
+  0,                                        // tp_getattro
+  0,                                        // tp_setattro
+  0,                                        // tp_as_buffer
+  Py_TPFLAGS_DEFAULT,                       // tp_flags
+  "igraph shortest path iterator object\n\n"
+  "Yields the shortest path lengths from the source vertices to the target\n"
+  "vertices in blocks of at most a given number of sources, as L{Buffer}\n"
+  "objects with one row per source and one column per target. Use\n"
+  "L{Graph.shortest_paths_iter()} to create one.\n", // tp_doc
+  0,                                        // tp_traverse
+  0,                                        // tp_clear
+  0,                                        // tp_richcompare
+  0,                                        // tp_weaklistoffset
+  (getiterfunc)igraphmodule_ShortestPathsIter_iter, /* tp_iter */
+  (iternextfunc)igraphmodule_ShortestPathsIter_iternext, /* tp_iternext */
+  igraphmodule_ShortestPathsIter_methods,   /* tp_methods */
+  0,                                        /* tp_members */
+  0,                                        /* tp_getset */
+  0,                                        /* tp_base */
+  0,                                        /* tp_dict */
+  0,                                        /* tp_descr_get */
+  0,                                        /* tp_descr_set */
+  0,                                        /* tp_dictoffset */
+  0,                                        /* tp_init */
+  0,                                        /* tp_alloc */
+  0,                                        /* tp_new */
+  0,                                        /* tp_free */
+};
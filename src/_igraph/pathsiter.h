@@ -0,0 +1,88 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef PYTHON_PATHSITER_H
+#define PYTHON_PATHSITER_H
+
+#include <Python.h>
+#include "graphobject.h"
+#include "pathsearch.h"
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_pathsiter Chunked shortest path iterator object
+ */
+extern PyTypeObject igraphmodule_ShortestPathsIterType;
+
+/**
+ * \ingroup python_interface_pathsiter
+ * \brief Reductions that may be applied to the rows of a distance block
+ */
+typedef enum {
+  IGRAPHMODULE_PATHS_REDUCE_NONE = 0,
+  IGRAPHMODULE_PATHS_REDUCE_ECCENTRICITY,
+  IGRAPHMODULE_PATHS_REDUCE_HARMONIC
+} igraphmodule_paths_reduce_t;
+
+struct igraphmodule_i_ShortestPathsWorker;
+
+/**
+ * \ingroup python_interface_pathsiter
+ * \brief An iterator that yields the shortest path lengths from a set of
+ *        source vertices in blocks of a given number of sources.
+ *
+ * The iterator holds a reference to the cached adjacency lists of the graph
+ * and a copy of the weights, so the graph may be modified (or even deleted)
+ * while the iteration is in progress. Each block is computed by a fixed
+ * number of worker threads, each of them having its own search workspace.
+ */
+typedef struct
+{
+  PyObject_HEAD
+  // Adjacency lists and weights of the graph being searched
+  igraphmodule_pathsearch_graph_t graph;
+  // Source and target vertices
+  igraph_vector_t sources;
+  igraph_vector_t targets;
+  // Maximum number of sources in a block and the index of the next source
+  long int chunk;
+  long int pos;
+  // Reduction applied to the rows of the blocks
+  igraphmodule_paths_reduce_t reduce;
+  // Worker threads and their workspaces
+  long int no_of_workers;
+  struct igraphmodule_i_ShortestPathsWorker *workers;
+  // The block being calculated
+  long int block_start;
+  long int block_size;
+  long int block_workers;
+  igraph_real_t *block;
+} igraphmodule_ShortestPathsIterObject;
+
+PyObject* igraphmodule_ShortestPathsIter_new(igraphmodule_GraphObject *g,
+    igraph_vs_t sources, igraph_vs_t targets, const igraph_vector_t *weights,
+    igraph_neimode_t mode, long int chunk, long int threads,
+    PyObject *reduce_o);
+
+#endif
@@ -0,0 +1,305 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#include "profiling.h"
+#include "common.h"
+#include "py2compat.h"
+#include "threading.h"
+
+/**
+ * \ingroup python_interface_profiling
+ * \brief Whether the instrumented methods should collect statistics
+ */
+int igraphmodule_profiling_enabled = 0;
+
+/**
+ * \ingroup python_interface_profiling
+ * \brief The entries of the methods called since the module was loaded
+ */
+static igraphmodule_profile_entry_t* igraphmodule_i_profile_entries = 0;
+
+/**
+ * \ingroup python_interface_profiling
+ * \brief The innermost call of an instrumented method in the current thread
+ */
+static IGRAPHMODULE_THREAD_LOCAL igraphmodule_profile_call_t*
+  igraphmodule_i_profile_current_call = 0;
+
+static unsigned long long int igraphmodule_i_profile_ns(double seconds) {
+  return seconds > 0 ? (unsigned long long int)(seconds * 1e9 + 0.5) : 0;
+}
+
+/* Allocations made by Python are counted by wrapping the allocators of the
+ * "mem" and "object" domains; Python 2 and Python 3.4 do not have a
+ * suitable API, there the number of bytes is always zero. */
+
+#if defined(IGRAPH_PYTHON3) && PY_VERSION_HEX >= 0x03050000
+#  define IGRAPHMODULE_PROFILE_ALLOCATIONS 1
+
+typedef struct {
+  PyMemAllocatorDomain domain;
+  PyMemAllocatorEx original;
+  PyMemAllocatorEx wrapper;
+  int installed;
+} igraphmodule_i_profile_allocator_t;
+
+static igraphmodule_i_profile_allocator_t igraphmodule_i_profile_allocators[2];
+
+static void igraphmodule_i_profile_count(size_t size) {
+  igraphmodule_profile_call_t* call = igraphmodule_i_profile_current_call;
+  if (call)
+    call->bytes += size;
+}
+
+static void* igraphmodule_i_profile_malloc(void* ctx, size_t size) {
+  igraphmodule_i_profile_allocator_t* a = (igraphmodule_i_profile_allocator_t*)ctx;
+  igraphmodule_i_profile_count(size);
+  return a->original.malloc(a->original.ctx, size);
+}
+
+static void* igraphmodule_i_profile_calloc(void* ctx, size_t nelem, size_t elsize) {
+  igraphmodule_i_profile_allocator_t* a = (igraphmodule_i_profile_allocator_t*)ctx;
+  igraphmodule_i_profile_count(nelem * elsize);
+  return a->original.calloc(a->original.ctx, nelem, elsize);
+}
+
+static void* igraphmodule_i_profile_realloc(void* ctx, void* ptr, size_t new_size) {
+  igraphmodule_i_profile_allocator_t* a = (igraphmodule_i_profile_allocator_t*)ctx;
+  igraphmodule_i_profile_count(new_size);
+  return a->original.realloc(a->original.ctx, ptr, new_size);
+}
+
+static void igraphmodule_i_profile_free(void* ctx, void* ptr) {
+  igraphmodule_i_profile_allocator_t* a = (igraphmodule_i_profile_allocator_t*)ctx;
+  a->original.free(a->original.ctx, ptr);
+}
+
+/**
+ * \ingroup python_interface_profiling
+ * \brief Installs the counting allocators, unless they are installed already
+ */
+static void igraphmodule_i_profile_install_allocators(void) {
+  static const PyMemAllocatorDomain domains[2] = {
+    PYMEM_DOMAIN_MEM, PYMEM_DOMAIN_OBJ
+  };
+  igraphmodule_i_profile_allocator_t* a;
+  int i;
+
+  for (i = 0; i < 2; i++) {
+    a = &igraphmodule_i_profile_allocators[i];
+    if (a->installed)
+      continue;
+    a->domain = domains[i];
+    PyMem_GetAllocator(a->domain, &a->original);
+    a->wrapper.ctx = a;
+    a->wrapper.malloc = igraphmodule_i_profile_malloc;
+    a->wrapper.calloc = igraphmodule_i_profile_calloc;
+    a->wrapper.realloc = igraphmodule_i_profile_realloc;
+    a->wrapper.free = igraphmodule_i_profile_free;
+    PyMem_SetAllocator(a->domain, &a->wrapper);
+    a->installed = 1;
+  }
+}
+
+/**
+ * \ingroup python_interface_profiling
+ * \brief Restores the original allocators.
+ *
+ * An allocator is left in place if someone else (e.g., \c tracemalloc) has
+ * wrapped it in the meanwhile, since removing it would remove the other
+ * wrapper as well. It only forwards to the original allocator then.
+ */
+static void igraphmodule_i_profile_uninstall_allocators(void) {
+  igraphmodule_i_profile_allocator_t* a;
+  PyMemAllocatorEx current;
+  int i;
+
+  for (i = 0; i < 2; i++) {
+    a = &igraphmodule_i_profile_allocators[i];
+    if (!a->installed)
+      continue;
+    PyMem_GetAllocator(a->domain, &current);
+    if (current.ctx != a)
+      continue;
+    PyMem_SetAllocator(a->domain, &a->original);
+    a->installed = 0;
+  }
+}
+#else
+#  define IGRAPHMODULE_PROFILE_ALLOCATIONS 0
+#endif
+
+/**
+ * \ingroup python_interface_profiling
+ * \brief Starts measuring a call of an instrumented method.
+ *
+ * Must be called with the GIL held.
+ */
+void igraphmodule_profile_call_begin(igraphmodule_profile_call_t* call) {
+  call->core_sections = 0;
+  call->core_start = -1;
+  call->core = 0;
+  call->bytes = 0;
+  call->parent = igraphmodule_i_profile_current_call;
+  igraphmodule_i_profile_current_call = call;
+  call->start = igraphmodule_clock();
+}
+
+/**
+ * \ingroup python_interface_profiling
+ * \brief Finishes measuring a call and adds it to the counters of the method.
+ *
+ * Calls that did not reach the C core (e.g., because the arguments were
+ * invalid) count as input conversion only. The bytes allocated by nested
+ * calls of instrumented methods count for the outer call as well.
+ *
+ * Must be called with the GIL held.
+ */
+void igraphmodule_profile_call_end(igraphmodule_profile_call_t* call,
+    igraphmodule_profile_entry_t* entry) {
+  double end = igraphmodule_clock();
+  double input, output;
+
+  igraphmodule_i_profile_current_call = call->parent;
+  if (call->parent)
+    call->parent->bytes += call->bytes;
+
+  if (call->core_sections > 0) {
+    input = call->first_core_start - call->start;
+    output = end - call->last_core_end;
+  } else {
+    input = end - call->start;
+    output = 0;
+  }
+
+  if (!entry->registered) {
+    entry->registered = 1;
+    entry->next = igraphmodule_i_profile_entries;
+    igraphmodule_i_profile_entries = entry;
+  }
+
+  entry->calls++;
+  entry->input_ns += igraphmodule_i_profile_ns(input);
+  entry->core_ns += igraphmodule_i_profile_ns(call->core);
+  entry->output_ns += igraphmodule_i_profile_ns(output);
+  entry->bytes += call->bytes;
+}
+
+/**
+ * \ingroup python_interface_profiling
+ * \brief Marks the start of a core call in the current instrumented call.
+ *
+ * Called by \ref igraphmodule_begin_nogil() before the GIL is released.
+ */
+void igraphmodule_profile_core_begin(void) {
+  igraphmodule_profile_call_t* call = igraphmodule_i_profile_current_call;
+
+  if (call == 0)
+    return;
+
+  call->core_start = igraphmodule_clock();
+  if (call->core_sections == 0)
+    call->first_core_start = call->core_start;
+}
+
+/**
+ * \ingroup python_interface_profiling
+ * \brief Marks the end of a core call in the current instrumented call.
+ *
+ * Called by \ref igraphmodule_end_nogil() after the GIL is re-acquired.
+ */
+void igraphmodule_profile_core_end(void) {
+  igraphmodule_profile_call_t* call = igraphmodule_i_profile_current_call;
+
+  /* Profiling may have been enabled while the core call was running */
+  if (call == 0 || call->core_start < 0)
+    return;
+
+  call->last_core_end = igraphmodule_clock();
+  call->core += call->last_core_end - call->core_start;
+  call->core_start = -1;
+  call->core_sections++;
+}
+
+PyObject* igraphmodule_set_profiling(PyObject* self, PyObject* o) {
+  int enabled = PyObject_IsTrue(o);
+
+  if (enabled < 0)
+    return NULL;
+
+#if IGRAPHMODULE_PROFILE_ALLOCATIONS
+  if (enabled)
+    igraphmodule_i_profile_install_allocators();
+  else
+    igraphmodule_i_profile_uninstall_allocators();
+#endif
+
+  igraphmodule_profiling_enabled = enabled;
+
+  Py_RETURN_NONE;
+}
+
+PyObject* igraphmodule_get_profiling(PyObject* self) {
+  return PyBool_FromLong(igraphmodule_profiling_enabled);
+}
+
+PyObject* igraphmodule_get_profile_stats(PyObject* self) {
+  igraphmodule_profile_entry_t* entry;
+  PyObject *result, *item;
+
+  result = PyDict_New();
+  if (result == 0)
+    return NULL;
+
+  for (entry = igraphmodule_i_profile_entries; entry; entry = entry->next) {
+    if (entry->calls == 0)
+      continue;
+    item = Py_BuildValue("{sKsKsKsKsK}",
+        "calls", entry->calls,
+        "input_ns", entry->input_ns,
+        "core_ns", entry->core_ns,
+        "output_ns", entry->output_ns,
+        "bytes", entry->bytes);
+    if (item == 0 || PyDict_SetItemString(result, entry->name, item)) {
+      Py_XDECREF(item);
+      Py_DECREF(result);
+      return NULL;
+    }
+    Py_DECREF(item);
+  }
+
+  return result;
+}
+
+PyObject* igraphmodule_reset_profile_stats(PyObject* self) {
+  igraphmodule_profile_entry_t* entry;
+
+  for (entry = igraphmodule_i_profile_entries; entry; entry = entry->next) {
+    entry->calls = 0;
+    entry->input_ns = entry->core_ns = entry->output_ns = 0;
+    entry->bytes = 0;
+  }
+
+  Py_RETURN_NONE;
+}
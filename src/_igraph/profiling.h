@@ -0,0 +1,139 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef PYTHON_PROFILING_H
+#define PYTHON_PROFILING_H
+
+#include <Python.h>
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_profiling Per-method call statistics
+ *
+ * When profiling is enabled, the instrumented methods keep counters of
+ * the number of calls, the time spent converting the arguments, in the
+ * C core and converting the results, and the number of bytes allocated by
+ * Python while converting. The time spent in the C core is measured
+ * between \ref igraphmodule_begin_nogil() and
+ * \ref igraphmodule_end_nogil(), hence only methods that release the GIL
+ * around their core call are instrumented.
+ */
+
+/**
+ * \ingroup python_interface_profiling
+ * \brief Counters of an instrumented method.
+ *
+ * Entries are static variables of the wrappers generated by
+ * \ref IGRAPHMODULE_DEFINE_PROFILED and are linked into a list on their
+ * first call. They are only modified with the GIL held.
+ */
+typedef struct igraphmodule_profile_entry_s {
+  const char* name;
+  int registered;
+  unsigned long long int calls;
+  unsigned long long int input_ns;
+  unsigned long long int core_ns;
+  unsigned long long int output_ns;
+  unsigned long long int bytes;
+  struct igraphmodule_profile_entry_s* next;
+} igraphmodule_profile_entry_t;
+
+/**
+ * \ingroup python_interface_profiling
+ * \brief Measurements of a single call of an instrumented method.
+ *
+ * Lives on the stack of the wrapper; the innermost call of each thread is
+ * kept in a thread-local variable.
+ */
+typedef struct igraphmodule_profile_call_s {
+  double start;
+  double core_start;
+  double first_core_start;
+  double last_core_end;
+  double core;
+  int core_sections;
+  unsigned long long int bytes;
+  struct igraphmodule_profile_call_s* parent;
+} igraphmodule_profile_call_t;
+
+extern int igraphmodule_profiling_enabled;
+
+void igraphmodule_profile_call_begin(igraphmodule_profile_call_t* call);
+void igraphmodule_profile_call_end(igraphmodule_profile_call_t* call,
+    igraphmodule_profile_entry_t* entry);
+void igraphmodule_profile_core_begin(void);
+void igraphmodule_profile_core_end(void);
+
+/**
+ * \ingroup python_interface_profiling
+ * \brief Name of the instrumented wrapper of a method, to be used in the
+ *        method table.
+ */
+#define IGRAPHMODULE_PROFILED(func) func##_profiled
+
+/**
+ * \ingroup python_interface_profiling
+ * \brief Defines the instrumented wrapper of a method taking positional
+ *        and keyword arguments.
+ *
+ * \c selftype is the type of the first argument of the method (the graph
+ * or, for class methods, the type object). The wrapper costs a single
+ * branch when profiling is disabled.
+ */
+#define IGRAPHMODULE_DEFINE_PROFILED(func, selftype, pyname) \
+  static PyObject* func##_profiled(selftype self, PyObject* args, PyObject* kwds) { \
+    static igraphmodule_profile_entry_t entry = { pyname }; \
+    igraphmodule_profile_call_t call; \
+    PyObject* result; \
+    if (!igraphmodule_profiling_enabled) \
+      return func(self, args, kwds); \
+    igraphmodule_profile_call_begin(&call); \
+    result = func(self, args, kwds); \
+    igraphmodule_profile_call_end(&call, &entry); \
+    return result; \
+  }
+
+/**
+ * \ingroup python_interface_profiling
+ * \brief Defines the instrumented wrapper of a method without arguments.
+ */
+#define IGRAPHMODULE_DEFINE_PROFILED_NOARGS(func, selftype, pyname) \
+  static PyObject* func##_profiled(selftype self) { \
+    static igraphmodule_profile_entry_t entry = { pyname }; \
+    igraphmodule_profile_call_t call; \
+    PyObject* result; \
+    if (!igraphmodule_profiling_enabled) \
+      return func(self); \
+    igraphmodule_profile_call_begin(&call); \
+    result = func(self); \
+    igraphmodule_profile_call_end(&call, &entry); \
+    return result; \
+  }
+
+PyObject* igraphmodule_set_profiling(PyObject* self, PyObject* o);
+PyObject* igraphmodule_get_profiling(PyObject* self);
+PyObject* igraphmodule_get_profile_stats(PyObject* self);
+PyObject* igraphmodule_reset_profile_stats(PyObject* self);
+
+#endif
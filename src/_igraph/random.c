@@ -24,8 +24,24 @@
 #include "py2compat.h"
 #include "random.h"
 #include <limits.h>
+#include <string.h>
+#include <time.h>
+#include <pythread.h>
 #include <igraph_random.h>
 
+/**
+ * \ingroup python_interface_rng
+ * \brief Buffer of random numbers drawn in advance from Python's random
+ *        number generator.
+ */
+typedef struct {
+  /* Only one of these is used, depending on the function filling the buffer */
+  double* values;
+  unsigned long int* int_values;
+  Py_ssize_t next;
+  Py_ssize_t count;
+} igraph_i_rng_Python_buffer_t;
+
 /**
  * \ingroup python_interface_rng
  * \brief Internal data structure for storing references to the
@@ -35,11 +51,24 @@ typedef struct {
   PyObject* randint_func;
   PyObject* random_func;
   PyObject* gauss_func;
+  /* Number of random numbers drawn at once; 1 means no buffering */
+  Py_ssize_t batch_size;
+  igraph_i_rng_Python_buffer_t randint_buffer;
+  igraph_i_rng_Python_buffer_t random_buffer;
+  igraph_i_rng_Python_buffer_t gauss_buffer;
 } igraph_i_rng_Python_state_t;
 
-static igraph_i_rng_Python_state_t igraph_rng_Python_state = {0, 0, 0};
+static igraph_i_rng_Python_state_t igraph_rng_Python_state = {0, 0, 0, 1};
 static igraph_rng_t igraph_rng_Python = {0, 0, 0};
 
+/* The FastRNG object currently used by igraph, if any. We hold a reference
+ * to it so it is not deallocated while igraph uses it. */
+static PyObject* igraph_rng_FastRNG_current = 0;
+
+/* Native generator owned by the module, used when the random number
+ * generator is set to None */
+static igraph_rng_t igraph_rng_native = {0, 0, 0};
+
 int igraph_rng_Python_init(void **state) {
   IGRAPH_ERROR("Python RNG error, unsupported function called",
       IGRAPH_EINTERNAL);
@@ -51,18 +80,173 @@ void igraph_rng_Python_destroy(void *state) {
       __FILE__, __LINE__, IGRAPH_EINTERNAL);
 }
 
+/**
+ * \ingroup python_interface_rng
+ * \brief Discards the random numbers in a buffer.
+ */
+static void igraph_i_rng_Python_buffer_destroy(igraph_i_rng_Python_buffer_t* buffer) {
+  PyMem_Free(buffer->values);
+  PyMem_Free(buffer->int_values);
+  buffer->values = 0;
+  buffer->int_values = 0;
+  buffer->next = buffer->count = 0;
+}
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Calls of Python's random number generator that can be buffered
+ */
+typedef enum {
+  IGRAPH_I_RNG_PYTHON_RANDINT = 0,
+  IGRAPH_I_RNG_PYTHON_RANDOM,
+  IGRAPH_I_RNG_PYTHON_GAUSS
+} igraph_i_rng_Python_call_t;
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Refills a buffer by calling the corresponding Python function
+ *        \c batch_size times. Must be called with the GIL held.
+ *
+ * \return 0 if everything was OK, 1 otherwise (an exception is set)
+ */
+static int igraph_i_rng_Python_buffer_fill(igraph_i_rng_Python_buffer_t* buffer,
+    igraph_i_rng_Python_call_t call) {
+  Py_ssize_t i, n = igraph_rng_Python_state.batch_size;
+  PyObject* result;
+
+  if (call == IGRAPH_I_RNG_PYTHON_RANDINT && buffer->int_values == 0) {
+    buffer->int_values = PyMem_New(unsigned long int, n);
+    if (buffer->int_values == 0) {
+      PyErr_NoMemory();
+      return 1;
+    }
+  } else if (call != IGRAPH_I_RNG_PYTHON_RANDINT && buffer->values == 0) {
+    buffer->values = PyMem_New(double, n);
+    if (buffer->values == 0) {
+      PyErr_NoMemory();
+      return 1;
+    }
+  }
+
+  buffer->next = buffer->count = 0;
+  for (i = 0; i < n; i++) {
+    switch (call) {
+      case IGRAPH_I_RNG_PYTHON_RANDINT:
+        result = PyObject_CallFunction(igraph_rng_Python_state.randint_func,
+            "kk", 0, LONG_MAX);
+        break;
+      case IGRAPH_I_RNG_PYTHON_RANDOM:
+        result = PyObject_CallFunction(igraph_rng_Python_state.random_func, NULL);
+        break;
+      default:
+        result = PyObject_CallFunction(igraph_rng_Python_state.gauss_func,
+            "dd", 0.0, 1.0);
+    }
+    if (result == 0)
+      return 1;
+    if (call == IGRAPH_I_RNG_PYTHON_RANDINT)
+      buffer->int_values[i] = PyInt_AsLong(result);
+    else
+      buffer->values[i] = PyFloat_AsDouble(result);
+    Py_DECREF(result);
+    if (PyErr_Occurred())
+      return 1;
+    buffer->count++;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Takes the next random integer from the buffer of \c randint calls,
+ *        refilling the buffer first if it is empty. Must be called with the
+ *        GIL held.
+ *
+ * \return 0 if everything was OK, 1 otherwise (an exception is set)
+ */
+static int igraph_i_rng_Python_buffer_next_int(unsigned long int* value) {
+  igraph_i_rng_Python_buffer_t* buffer = &igraph_rng_Python_state.randint_buffer;
+  if (buffer->next >= buffer->count) {
+    if (igraph_i_rng_Python_buffer_fill(buffer, IGRAPH_I_RNG_PYTHON_RANDINT))
+      return 1;
+  }
+  *value = buffer->int_values[buffer->next++];
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Takes the next random number from the buffer of \c random or
+ *        \c gauss calls, refilling the buffer first if it is empty. Must be
+ *        called with the GIL held.
+ *
+ * \return 0 if everything was OK, 1 otherwise (an exception is set)
+ */
+static int igraph_i_rng_Python_buffer_next_real(igraph_i_rng_Python_call_t call,
+    double* value) {
+  igraph_i_rng_Python_buffer_t* buffer = call == IGRAPH_I_RNG_PYTHON_GAUSS ?
+    &igraph_rng_Python_state.gauss_buffer : &igraph_rng_Python_state.random_buffer;
+  if (buffer->next >= buffer->count) {
+    if (igraph_i_rng_Python_buffer_fill(buffer, call))
+      return 1;
+  }
+  *value = buffer->values[buffer->next++];
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Stops using the current FastRNG object, if any.
+ */
+static void igraph_i_rng_FastRNG_release_current(void) {
+  PyObject* old = igraph_rng_FastRNG_current;
+  igraph_rng_FastRNG_current = 0;
+  Py_XDECREF(old);
+}
+
 /**
  * \ingroup python_interface_rng
  * \brief Sets the random number generator used by igraph.
+ *
+ * \param object  a Python object providing \c randint, \c random and
+ *                 \c gauss methods, a \c FastRNG instance or \c None to
+ *                 install the Mersenne Twister owned by the module
+ * \param batch_size  number of random numbers to draw in one go from a
+ *                 Python generator
+ * \return \c None or \c NULL if an error happened
  */
-PyObject* igraph_rng_Python_set_generator(PyObject* self, PyObject* object) {
+static PyObject* igraph_i_rng_Python_set_generator(PyObject* object, Py_ssize_t batch_size) {
   igraph_i_rng_Python_state_t new_state, old_state;
   PyObject* func;
 
+  if (batch_size < 1) {
+    PyErr_SetString(PyExc_ValueError, "batch size must be positive");
+    return NULL;
+  }
+
   if (object == Py_None) {
-    /* Reverting to the default igraph random number generator instead
+    /* Reverting to the native igraph random number generator instead
      * of the Python-based one */
-    igraph_rng_set_default(igraph_rng_default());
+    if (igraph_rng_native.type == 0) {
+      if (igraph_rng_init(&igraph_rng_native, &igraph_rngtype_mt19937)) {
+        igraph_rng_native.type = 0;
+        PyErr_NoMemory();
+        return NULL;
+      }
+      igraph_rng_seed(&igraph_rng_native, (unsigned long)time(0));
+    }
+    igraph_rng_set_default(&igraph_rng_native);
+    igraph_i_rng_FastRNG_release_current();
+    Py_RETURN_NONE;
+  }
+
+  if (PyObject_TypeCheck(object, &igraphmodule_FastRNGType)) {
+    /* Native generator, runs without calling back to Python */
+    igraph_rng_set_default(&((igraphmodule_FastRNGObject*)object)->wrapper);
+    Py_INCREF(object);
+    igraph_i_rng_FastRNG_release_current();
+    igraph_rng_FastRNG_current = object;
     Py_RETURN_NONE;
   }
 
@@ -80,17 +264,42 @@ PyObject* igraph_rng_Python_set_generator(PyObject* self, PyObject* object) {
   GET_FUNC("random"); new_state.random_func = func;
   GET_FUNC("gauss"); new_state.gauss_func = func;
 
+  /* Random numbers drawn in advance from the old generator are discarded */
+  new_state.batch_size = batch_size;
+  memset(&new_state.randint_buffer, 0, sizeof(new_state.randint_buffer));
+  memset(&new_state.random_buffer, 0, sizeof(new_state.random_buffer));
+  memset(&new_state.gauss_buffer, 0, sizeof(new_state.gauss_buffer));
+
   old_state = igraph_rng_Python_state;
   igraph_rng_Python_state = new_state;
   Py_XDECREF(old_state.randint_func);
   Py_XDECREF(old_state.random_func);
   Py_XDECREF(old_state.gauss_func);
+  igraph_i_rng_Python_buffer_destroy(&old_state.randint_buffer);
+  igraph_i_rng_Python_buffer_destroy(&old_state.random_buffer);
+  igraph_i_rng_Python_buffer_destroy(&old_state.gauss_buffer);
 
   igraph_rng_set_default(&igraph_rng_Python);
+  igraph_i_rng_FastRNG_release_current();
 
   Py_RETURN_NONE;
 }
 
+/**
+ * \ingroup python_interface_rng
+ * \brief Sets the random number generator used by igraph.
+ */
+PyObject* igraph_rng_Python_set_generator(PyObject* self, PyObject* args, PyObject* kwds) {
+  static char* kwlist[] = { "generator", "batch_size", NULL };
+  PyObject* object;
+  Py_ssize_t batch_size = 1;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|n", kwlist, &object, &batch_size))
+    return NULL;
+
+  return igraph_i_rng_Python_set_generator(object, batch_size);
+}
+
 /**
  * \ingroup python_interface_rng
  * \brief Sets the seed of the random generator.
@@ -106,17 +315,34 @@ int igraph_rng_Python_seed(void *state, unsigned long int seed) {
  * \brief Generates an unsigned long integer using the Python random number generator.
  */
 unsigned long int igraph_rng_Python_get(void *state) {
-  PyObject* result = PyObject_CallFunction(igraph_rng_Python_state.randint_func, "kk", 0, LONG_MAX);
+  PyGILState_STATE gstate = PyGILState_Ensure();
+  PyObject* result;
   unsigned long int retval;
 
+  if (igraph_rng_Python_state.batch_size > 1) {
+    if (igraph_i_rng_Python_buffer_next_int(&retval)) {
+      PyErr_WriteUnraisable(PyErr_Occurred());
+      PyErr_Clear();
+      PyGILState_Release(gstate);
+      /* Fallback to the C random generator */
+      return rand() * LONG_MAX;
+    }
+    PyGILState_Release(gstate);
+    return retval;
+  }
+
+  result = PyObject_CallFunction(igraph_rng_Python_state.randint_func, "kk", 0, LONG_MAX);
+
   if (result == 0) {
     PyErr_WriteUnraisable(PyErr_Occurred());
     PyErr_Clear();
+    PyGILState_Release(gstate);
     /* Fallback to the C random generator */
     return rand() * LONG_MAX;
   }
   retval = PyInt_AsLong(result);
   Py_DECREF(result);
+  PyGILState_Release(gstate);
   return retval;
 }
 
@@ -125,18 +351,35 @@ unsigned long int igraph_rng_Python_get(void *state) {
  * \brief Generates a real number between 0 and 1 using the Python random number generator.
  */
 igraph_real_t igraph_rng_Python_get_real(void *state) {
-  PyObject* result = PyObject_CallFunction(igraph_rng_Python_state.random_func, NULL);
+  PyGILState_STATE gstate = PyGILState_Ensure();
+  PyObject* result;
   double retval;
 
+  if (igraph_rng_Python_state.batch_size > 1) {
+    if (igraph_i_rng_Python_buffer_next_real(IGRAPH_I_RNG_PYTHON_RANDOM, &retval)) {
+      PyErr_WriteUnraisable(PyErr_Occurred());
+      PyErr_Clear();
+      PyGILState_Release(gstate);
+      /* Fallback to the C random generator */
+      return rand();
+    }
+    PyGILState_Release(gstate);
+    return retval;
+  }
+
+  result = PyObject_CallFunction(igraph_rng_Python_state.random_func, NULL);
+
   if (result == 0) {
     PyErr_WriteUnraisable(PyErr_Occurred());
     PyErr_Clear();
+    PyGILState_Release(gstate);
     /* Fallback to the C random generator */
     return rand();
   }
 
   retval = PyFloat_AsDouble(result);
   Py_DECREF(result);
+  PyGILState_Release(gstate);
   return retval;
 }
 
@@ -146,18 +389,35 @@ igraph_real_t igraph_rng_Python_get_real(void *state) {
  *        around zero with unit variance.
  */
 igraph_real_t igraph_rng_Python_get_norm(void *state) {
-  PyObject* result = PyObject_CallFunction(igraph_rng_Python_state.gauss_func, "dd", 0.0, 1.0);
+  PyGILState_STATE gstate = PyGILState_Ensure();
+  PyObject* result;
   double retval;
 
+  if (igraph_rng_Python_state.batch_size > 1) {
+    if (igraph_i_rng_Python_buffer_next_real(IGRAPH_I_RNG_PYTHON_GAUSS, &retval)) {
+      PyErr_WriteUnraisable(PyErr_Occurred());
+      PyErr_Clear();
+      PyGILState_Release(gstate);
+      /* Fallback to the C random generator */
+      return 0;
+    }
+    PyGILState_Release(gstate);
+    return retval;
+  }
+
+  result = PyObject_CallFunction(igraph_rng_Python_state.gauss_func, "dd", 0.0, 1.0);
+
   if (result == 0) {
     PyErr_WriteUnraisable(PyErr_Occurred());
     PyErr_Clear();
+    PyGILState_Release(gstate);
     /* Fallback to the C random generator */
     return 0;
   }
 
   retval = PyFloat_AsDouble(result);
   Py_DECREF(result);
+  PyGILState_Release(gstate);
   return retval;
 }
 
@@ -180,8 +440,345 @@ igraph_rng_type_t igraph_rngtype_Python = {
   /* get_binom= */ 0
 };
 
+/******************************************************************************
+ * Native random number generator object                                      *
+ ******************************************************************************/
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Seeds the Mersenne Twister wrapped by a FastRNG object.
+ */
+static int igraph_rng_FastRNG_seed(void *state, unsigned long int seed) {
+  igraphmodule_FastRNGObject* self = (igraphmodule_FastRNGObject*)state;
+  int retval;
+
+  PyThread_acquire_lock(self->lock, WAIT_LOCK);
+  retval = igraph_rng_seed(&self->rng, seed);
+  PyThread_release_lock(self->lock);
+
+  return retval;
+}
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Returns a random integer from a FastRNG object.
+ *
+ * This is called by igraph while the GIL may be released, hence the
+ * generator is protected by its own lock instead.
+ */
+static unsigned long int igraph_rng_FastRNG_get(void *state) {
+  igraphmodule_FastRNGObject* self = (igraphmodule_FastRNGObject*)state;
+  unsigned long int retval;
+
+  PyThread_acquire_lock(self->lock, WAIT_LOCK);
+  retval = self->rng.type->get(self->rng.state);
+  PyThread_release_lock(self->lock);
+
+  return retval;
+}
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Returns a random real number between 0 and 1 from a FastRNG object.
+ */
+static igraph_real_t igraph_rng_FastRNG_get_real(void *state) {
+  igraphmodule_FastRNGObject* self = (igraphmodule_FastRNGObject*)state;
+  igraph_real_t retval;
+
+  PyThread_acquire_lock(self->lock, WAIT_LOCK);
+  retval = igraph_rng_get_unif01(&self->rng);
+  PyThread_release_lock(self->lock);
+
+  return retval;
+}
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Returns a random number from the standard normal distribution
+ *        from a FastRNG object.
+ */
+static igraph_real_t igraph_rng_FastRNG_get_norm(void *state) {
+  igraphmodule_FastRNGObject* self = (igraphmodule_FastRNGObject*)state;
+  igraph_real_t retval;
+
+  PyThread_acquire_lock(self->lock, WAIT_LOCK);
+  retval = igraph_rng_get_normal(&self->rng, 0, 1);
+  PyThread_release_lock(self->lock);
+
+  return retval;
+}
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Specification table for the generator wrapped by FastRNG objects.
+ *        The state of the wrapper is the FastRNG object itself; it is never
+ *        initialized or destroyed by igraph.
+ */
+static igraph_rng_type_t igraph_rngtype_FastRNG = {
+  /* name= */      "FastRNG",
+  /* min=  */      0,
+  /* max=  */      0xffffffffUL,
+  /* init= */      0,
+  /* destroy= */   0,
+  /* seed= */      igraph_rng_FastRNG_seed,
+  /* get= */       igraph_rng_FastRNG_get,
+  /* get_real */   igraph_rng_FastRNG_get_real,
+  /* get_norm= */  igraph_rng_FastRNG_get_norm,
+  /* get_geom= */  0,
+  /* get_binom= */ 0
+};
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Converts a Python object to a seed for a FastRNG object.
+ *        \c None means a seed derived from the current time.
+ *
+ * \return 0 if everything was OK, 1 otherwise
+ */
+static int igraph_i_rng_FastRNG_seed_from_PyObject(igraphmodule_FastRNGObject* self,
+    PyObject* o, unsigned long* seed) {
+  if (o == 0 || o == Py_None) {
+    *seed = (unsigned long)time(0) ^ (unsigned long)(size_t)self;
+    return 0;
+  }
+
+  if (!PyInt_Check(o) && !PyLong_Check(o)) {
+    PyErr_SetString(PyExc_TypeError, "seed must be an integer or None");
+    return 1;
+  }
+
+  *seed = PyLong_AsUnsignedLongMask(o);
+  if (PyErr_Occurred())
+    return 1;
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Allocates a new FastRNG object
+ */
+static PyObject* igraph_rng_FastRNG_new(PyTypeObject* type, PyObject* args, PyObject* kwds) {
+  igraphmodule_FastRNGObject* self;
+
+  self = (igraphmodule_FastRNGObject*)type->tp_alloc(type, 0);
+  if (self == 0)
+    return NULL;
+
+  self->lock = PyThread_allocate_lock();
+  if (self->lock == 0) {
+    Py_DECREF(self);
+    PyErr_NoMemory();
+    return NULL;
+  }
+
+  if (igraph_rng_init(&self->rng, &igraph_rngtype_mt19937)) {
+    self->rng.type = 0;
+    Py_DECREF(self);
+    PyErr_NoMemory();
+    return NULL;
+  }
+
+  self->wrapper.type = &igraph_rngtype_FastRNG;
+  self->wrapper.state = self;
+  self->wrapper.def = 0;
+
+  return (PyObject*)self;
+}
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Initializes a FastRNG object with the given seed
+ */
+static int igraph_rng_FastRNG_init(igraphmodule_FastRNGObject* self,
+    PyObject* args, PyObject* kwds) {
+  static char* kwlist[] = { "seed", NULL };
+  PyObject* seed_o = Py_None;
+  unsigned long seed;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &seed_o))
+    return -1;
+
+  if (igraph_i_rng_FastRNG_seed_from_PyObject(self, seed_o, &seed))
+    return -1;
+
+  igraph_rng_FastRNG_seed(self, seed);
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Deallocates a FastRNG object
+ */
+static void igraph_rng_FastRNG_dealloc(igraphmodule_FastRNGObject* self) {
+  if (self->rng.type != 0)
+    igraph_rng_destroy(&self->rng);
+  if (self->lock != 0)
+    PyThread_free_lock(self->lock);
+  Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Re-seeds a FastRNG object
+ */
+static PyObject* igraph_rng_FastRNG_seed_method(igraphmodule_FastRNGObject* self,
+    PyObject* args, PyObject* kwds) {
+  static char* kwlist[] = { "seed", NULL };
+  PyObject* seed_o = Py_None;
+  unsigned long seed;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", kwlist, &seed_o))
+    return NULL;
+
+  if (igraph_i_rng_FastRNG_seed_from_PyObject(self, seed_o, &seed))
+    return NULL;
+
+  igraph_rng_FastRNG_seed(self, seed);
+
+  Py_RETURN_NONE;
+}
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Returns a random float in [0, 1) from a FastRNG object
+ */
+static PyObject* igraph_rng_FastRNG_random(igraphmodule_FastRNGObject* self) {
+  return PyFloat_FromDouble(igraph_rng_FastRNG_get_real(self));
+}
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Returns a random integer in [a, b] from a FastRNG object
+ */
+static PyObject* igraph_rng_FastRNG_randint(igraphmodule_FastRNGObject* self,
+    PyObject* args, PyObject* kwds) {
+  static char* kwlist[] = { "a", "b", NULL };
+  long a, b, retval;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "ll", kwlist, &a, &b))
+    return NULL;
+
+  if (a > b) {
+    PyErr_SetString(PyExc_ValueError, "lower bound must not be larger than the upper bound");
+    return NULL;
+  }
+
+  PyThread_acquire_lock(self->lock, WAIT_LOCK);
+  retval = igraph_rng_get_integer(&self->rng, a, b);
+  PyThread_release_lock(self->lock);
+
+  return PyInt_FromLong(retval);
+}
+
+/**
+ * \ingroup python_interface_rng
+ * \brief Returns a random number from a normal distribution from a FastRNG
+ *        object
+ */
+static PyObject* igraph_rng_FastRNG_gauss(igraphmodule_FastRNGObject* self,
+    PyObject* args, PyObject* kwds) {
+  static char* kwlist[] = { "mu", "sigma", NULL };
+  double mu = 0.0, sigma = 1.0, retval;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|dd", kwlist, &mu, &sigma))
+    return NULL;
+
+  PyThread_acquire_lock(self->lock, WAIT_LOCK);
+  retval = igraph_rng_get_normal(&self->rng, mu, sigma);
+  PyThread_release_lock(self->lock);
+
+  return PyFloat_FromDouble(retval);
+}
+
+/**
+ * \ingroup python_interface_rng
+ * Method table for the \c igraph.FastRNG object
+ */
+static PyMethodDef igraph_rng_FastRNG_methods[] = {
+  {"seed", (PyCFunction)igraph_rng_FastRNG_seed_method,
+    METH_VARARGS | METH_KEYWORDS,
+    "seed(seed=None)\n\n"
+    "Re-seeds the generator.\n\n"
+    "@param seed: the new seed, an integer. C{None} means a seed derived\n"
+    "  from the current time.\n"
+  },
+  {"random", (PyCFunction)igraph_rng_FastRNG_random, METH_NOARGS,
+    "random()\n\n"
+    "Returns a random floating point number in the range [0, 1).\n"
+  },
+  {"randint", (PyCFunction)igraph_rng_FastRNG_randint,
+    METH_VARARGS | METH_KEYWORDS,
+    "randint(a, b)\n\n"
+    "Returns a random integer N such that M{a <= N <= b}.\n"
+  },
+  {"gauss", (PyCFunction)igraph_rng_FastRNG_gauss,
+    METH_VARARGS | METH_KEYWORDS,
+    "gauss(mu=0.0, sigma=1.0)\n\n"
+    "Returns a random number from a normal distribution with the given\n"
+    "mean and standard deviation.\n"
+  },
+  {NULL}
+};
+
+/** \ingroup python_interface_rng
+ * Python type object referencing the methods Python calls when it performs
+ * various operations on a FastRNG object
+ */
+PyTypeObject igraphmodule_FastRNGType = {
+  PyVarObject_HEAD_INIT(0, 0)
+  "igraph.FastRNG",                           /* tp_name */
+  sizeof(igraphmodule_FastRNGObject),         /* tp_basicsize */
+  0,                                          /* tp_itemsize */
+  (destructor)igraph_rng_FastRNG_dealloc,     /* tp_dealloc */
+  0,                                          /* tp_print */
+  0,                                          /* tp_getattr */
+  0,                                          /* tp_setattr */
+  0,                                          /* tp_compare (2.x) / tp_reserved (3.x) */
+  0,                                          /* tp_repr */
+  0,                                          /* tp_as_number */
+  0,                                          /* tp_as_sequence */
+  0,                                          /* tp_as_mapping */
+  0,                                          /* tp_hash */
+  0,                                          /* tp_call */
+  0,                                          /* tp_str */
+  0,                                          /* tp_getattro */
+  0,                                          /* tp_setattro */
+  0,                                          /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT,                         /* tp_flags */
+  "FastRNG(seed=None)\n\n"
+  "Native Mersenne Twister random number generator.\n\n"
+  "Instances of this class can be passed to\n"
+  "L{set_random_number_generator()} to let igraph draw random numbers\n"
+  "without calling back into Python, which is considerably faster for\n"
+  "randomized algorithms than the default generator (Python's C{random}\n"
+  "module). The generator may be used from several threads at the same\n"
+  "time. It also provides the C{random()}, C{randint()} and C{gauss()}\n"
+  "methods known from the C{random} module.\n\n"
+  "@param seed: the seed of the generator, an integer. C{None} means a\n"
+  "  seed derived from the current time.\n",
+  0,                                          /* tp_traverse */
+  0,                                          /* tp_clear */
+  0,                                          /* tp_richcompare */
+  0,                                          /* tp_weaklistoffset */
+  0,                                          /* tp_iter */
+  0,                                          /* tp_iternext */
+  igraph_rng_FastRNG_methods,                 /* tp_methods */
+  0,                                          /* tp_members */
+  0,                                          /* tp_getset */
+  0,                                          /* tp_base */
+  0,                                          /* tp_dict */
+  0,                                          /* tp_descr_get */
+  0,                                          /* tp_descr_set */
+  0,                                          /* tp_dictoffset */
+  (initproc)igraph_rng_FastRNG_init,          /* tp_init */
+  0,                                          /* tp_alloc */
+  igraph_rng_FastRNG_new,                     /* tp_new */
+};
+
 void igraphmodule_init_rng(PyObject* igraph_module) {
-  PyObject* random_module;
+  PyObject *random_module, *result;
 
   if (igraph_rng_Python.state != 0)
     return;
@@ -196,10 +793,12 @@ void igraphmodule_init_rng(PyObject* igraph_module) {
   igraph_rng_Python.type = &igraph_rngtype_Python;
   igraph_rng_Python.state = &igraph_rng_Python_state;
 
-  if (igraph_rng_Python_set_generator(igraph_module, random_module) == 0) {
+  result = igraph_i_rng_Python_set_generator(random_module, 1);
+  Py_DECREF(random_module);
+  if (result == 0) {
     PyErr_WriteUnraisable(PyErr_Occurred());
     PyErr_Clear();
     return;
   }
-  Py_DECREF(random_module);
+  Py_DECREF(result);
 }
@@ -24,9 +24,28 @@
 #define PYTHON_RANDOM_H
 
 #include <Python.h>
+#include <pythread.h>
+#include <igraph_random.h>
+
+/**
+ * \ingroup python_interface_rng
+ * \brief A native random number generator that igraph can use without
+ *        calling back into Python.
+ */
+typedef struct {
+  PyObject_HEAD
+  // The Mersenne Twister generating the random numbers
+  igraph_rng_t rng;
+  // Generator handed to igraph; forwards the calls to rng under the lock
+  igraph_rng_t wrapper;
+  // Lock protecting the state of rng, used instead of the GIL
+  PyThread_type_lock lock;
+} igraphmodule_FastRNGObject;
+
+extern PyTypeObject igraphmodule_FastRNGType;
 
 void igraphmodule_init_rng(PyObject*);
-PyObject* igraph_rng_Python_set_generator(PyObject* self, PyObject* object);
+PyObject* igraph_rng_Python_set_generator(PyObject* self, PyObject* args, PyObject* kwds);
 
 #endif
 
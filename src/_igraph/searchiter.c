@@ -0,0 +1,659 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include "searchiter.h"
+#include "common.h"
+#include "convert.h"
+#include "error.h"
+#include "py2compat.h"
+#include "threading.h"
+
+PyTypeObject igraphmodule_SearchIterType;
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Allocate a new search iterator for the given graph
+ *
+ * The parameters specific to the search (pattern graph, size limits,
+ * colors, compatibility functions) are filled in by the caller.
+ *
+ * \param g the graph object being searched
+ * \param search the search to run
+ * \param batch_size_o the number of results in a batch; \c None means 1000
+ * \param max_results_o the maximum number of results to return, or \c None
+ * \param time_limit_o the time budget of the search in seconds, or \c None
+ * \return the allocated PyObject. If the C core is not thread-safe, the
+ *   search cannot be suspended, so one of the limits is required and a
+ *   \c RuntimeError is raised without them.
+ */
+PyObject* igraphmodule_SearchIter_new(igraphmodule_GraphObject *g,
+    igraphmodule_search_t search, PyObject *batch_size_o,
+    PyObject *max_results_o, PyObject *time_limit_o) {
+  igraphmodule_SearchIterObject *o;
+  long int batch_size = 1000, max_results = 0;
+  double time_limit = 0;
+
+  if (batch_size_o != 0 && batch_size_o != Py_None) {
+    batch_size = PyInt_AsLong(batch_size_o);
+    if (PyErr_Occurred())
+      return NULL;
+    if (batch_size <= 0) {
+      PyErr_SetString(PyExc_ValueError, "batch size must be positive");
+      return NULL;
+    }
+  }
+  if (max_results_o != 0 && max_results_o != Py_None) {
+    max_results = PyInt_AsLong(max_results_o);
+    if (PyErr_Occurred())
+      return NULL;
+    if (max_results < 0) {
+      PyErr_SetString(PyExc_ValueError, "max_results must be non-negative");
+      return NULL;
+    }
+  }
+  if (time_limit_o != 0 && time_limit_o != Py_None) {
+    time_limit = PyFloat_AsDouble(time_limit_o);
+    if (PyErr_Occurred())
+      return NULL;
+    if (time_limit < 0) {
+      PyErr_SetString(PyExc_ValueError, "time_limit must be non-negative");
+      return NULL;
+    }
+  }
+
+  /* The whole search would be collected in memory otherwise, see
+   * igraphmodule_i_SearchIter_drain() */
+  if (!IGRAPHMODULE_CORE_IS_THREAD_SAFE && max_results == 0 && time_limit == 0) {
+    PyErr_SetString(PyExc_RuntimeError, "the C core of igraph was compiled "
+        "without thread-local storage, so the search cannot be suspended "
+        "between batches and is run up front; this needs max_results or "
+        "time_limit");
+    return NULL;
+  }
+
+  o = PyObject_New(igraphmodule_SearchIterObject, &igraphmodule_SearchIterType);
+  if (o == NULL)
+    return NULL;
+
+  Py_INCREF(g);
+  o->gref = g;
+  o->other = 0;
+  o->search = search;
+  o->min_size = o->max_size = 0;
+  o->color1 = o->color2 = o->edge_color1 = o->edge_color2 = 0;
+  o->node_compat_fn = o->edge_compat_fn = 0;
+  o->batch_size = batch_size;
+  o->max_results = max_results;
+  o->time_limit = time_limit;
+  o->no_of_results = 0;
+  o->started_at = 0;
+  o->next = 0;
+  o->state = IGRAPHMODULE_SEARCH_NOT_STARTED;
+  o->stop = o->exhausted = 0;
+  o->resume = o->ready = 0;
+  o->retval = 0;
+  o->exc_type = o->exc_value = o->exc_traceback = 0;
+
+  if (igraph_vector_ptr_init(&o->batch, 0)) {
+    Py_DECREF(o);
+    return igraphmodule_handle_igraph_error();
+  }
+  IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(&o->batch, igraph_vector_destroy);
+
+  RC_ALLOC("SearchIter", o);
+
+  return (PyObject*)o;
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Waits until the search thread has filled the next batch or finished
+ *
+ * Must be called with the GIL held; the GIL is released while waiting.
+ */
+static void igraphmodule_i_SearchIter_wait(igraphmodule_SearchIterObject *self) {
+  PyThreadState *tstate = igraphmodule_begin_wait();
+  PyThread_release_lock(self->resume);
+  PyThread_acquire_lock(self->ready, WAIT_LOCK);
+  igraphmodule_end_wait(tstate);
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Releases the graphs after the search thread has finished
+ */
+static void igraphmodule_i_SearchIter_finish(igraphmodule_SearchIterObject *self) {
+  if (self->state != IGRAPHMODULE_SEARCH_RUNNING)
+    return;
+
+  self->state = IGRAPHMODULE_SEARCH_FINISHED;
+  self->gref->busy--;
+  if (self->other) {
+    self->other->busy--;
+  }
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Stops the search thread if it is still running
+ */
+static void igraphmodule_i_SearchIter_stop(igraphmodule_SearchIterObject *self) {
+  if (self->state != IGRAPHMODULE_SEARCH_RUNNING)
+    return;
+
+  if (!self->exhausted) {
+    self->stop = 1;
+    igraphmodule_i_SearchIter_wait(self);
+  }
+  igraphmodule_i_SearchIter_finish(self);
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Frees the locks used to synchronize with the search thread
+ */
+static void igraphmodule_i_SearchIter_free_locks(igraphmodule_SearchIterObject *self) {
+  if (self->resume) {
+    PyThread_free_lock(self->resume);
+    self->resume = 0;
+  }
+  if (self->ready) {
+    PyThread_free_lock(self->ready);
+    self->ready = 0;
+  }
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Deallocates a Python representation of a given search iterator
+ *
+ * A search that is still in progress is stopped first.
+ */
+static void igraphmodule_SearchIter_dealloc(igraphmodule_SearchIterObject* self) {
+  igraphmodule_i_SearchIter_stop(self);
+
+  igraph_vector_ptr_destroy_all(&self->batch);
+  igraphmodule_i_SearchIter_free_locks(self);
+
+  if (self->color1) { igraph_vector_int_destroy(self->color1); free(self->color1); }
+  if (self->color2) { igraph_vector_int_destroy(self->color2); free(self->color2); }
+  if (self->edge_color1) { igraph_vector_int_destroy(self->edge_color1); free(self->edge_color1); }
+  if (self->edge_color2) { igraph_vector_int_destroy(self->edge_color2); free(self->edge_color2); }
+
+  Py_XDECREF(self->node_compat_fn);
+  Py_XDECREF(self->edge_compat_fn);
+  Py_XDECREF(self->exc_type);
+  Py_XDECREF(self->exc_value);
+  Py_XDECREF(self->exc_traceback);
+  Py_XDECREF(self->other);
+  Py_XDECREF(self->gref);
+
+  RC_DEALLOC("SearchIter", self);
+
+  PyObject_Del((PyObject*)self);
+}
+
+static PyObject* igraphmodule_SearchIter_iter(igraphmodule_SearchIterObject* self) {
+  Py_INCREF(self);
+  return (PyObject*)self;
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Adds a result to the current batch, suspending the search thread
+ *        if the batch is full
+ *
+ * Called in the thread running the search. The iterator takes over the
+ * given vector. A search that runs in the calling thread (see
+ * \ref igraphmodule_i_SearchIter_drain()) is never suspended.
+ *
+ * \return whether the search should continue
+ */
+static igraph_bool_t igraphmodule_i_SearchIter_add(
+    igraphmodule_SearchIterObject *self, igraph_vector_t *result) {
+  if (igraph_vector_ptr_push_back(&self->batch, result)) {
+    igraph_vector_destroy(result);
+    free(result);
+    self->retval = IGRAPH_ENOMEM;
+    return 0;
+  }
+
+  self->no_of_results++;
+  if (self->max_results > 0 && self->no_of_results >= self->max_results)
+    return 0;
+  if (self->time_limit > 0 &&
+      igraphmodule_clock() - self->started_at >= self->time_limit)
+    return 0;
+
+  if (IGRAPHMODULE_CORE_IS_THREAD_SAFE &&
+      igraph_vector_ptr_size(&self->batch) >= self->batch_size) {
+    /* Hand over the batch and wait until the next one is requested */
+    PyThread_release_lock(self->ready);
+    PyThread_acquire_lock(self->resume, WAIT_LOCK);
+    if (self->stop)
+      return 0;
+  }
+
+  return 1;
+}
+
+static igraph_bool_t igraphmodule_i_SearchIter_clique_handler(
+    igraph_vector_t *clique, void *arg) {
+  return igraphmodule_i_SearchIter_add((igraphmodule_SearchIterObject*)arg, clique);
+}
+
+static igraph_bool_t igraphmodule_i_SearchIter_iso_handler(
+    const igraph_vector_t *map12, const igraph_vector_t *map21, void *arg) {
+  igraphmodule_SearchIterObject *self = (igraphmodule_SearchIterObject*)arg;
+  igraph_vector_t *result;
+
+  result = (igraph_vector_t*)calloc(1, sizeof(igraph_vector_t));
+  if (!result || igraph_vector_copy(result, map21)) {
+    free(result);
+    self->retval = IGRAPH_ENOMEM;
+    return 0;
+  }
+
+  return igraphmodule_i_SearchIter_add(self, result);
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Calls a Python compatibility function from the search thread
+ */
+static igraph_bool_t igraphmodule_i_SearchIter_call_compat_fn(
+    igraphmodule_SearchIterObject *self, PyObject *fn,
+    igraph_integer_t cand1, igraph_integer_t cand2) {
+  PyGILState_STATE gstate;
+  PyObject *result;
+  igraph_bool_t retval;
+
+  gstate = PyGILState_Ensure();
+  result = PyObject_CallFunction(fn, "OOll", self->gref, self->other,
+      (long)cand1, (long)cand2);
+  if (result == NULL) {
+    /* Error in callback, return 0 */
+    PyErr_WriteUnraisable(fn);
+    retval = 0;
+  } else {
+    retval = PyObject_IsTrue(result);
+    Py_DECREF(result);
+  }
+  PyGILState_Release(gstate);
+
+  return retval;
+}
+
+static igraph_bool_t igraphmodule_i_SearchIter_node_compat_fn(
+    const igraph_t *graph1, const igraph_t *graph2,
+    const igraph_integer_t cand1, const igraph_integer_t cand2, void *arg) {
+  igraphmodule_SearchIterObject *self = (igraphmodule_SearchIterObject*)arg;
+  return igraphmodule_i_SearchIter_call_compat_fn(self, self->node_compat_fn,
+      cand1, cand2);
+}
+
+static igraph_bool_t igraphmodule_i_SearchIter_edge_compat_fn(
+    const igraph_t *graph1, const igraph_t *graph2,
+    const igraph_integer_t cand1, const igraph_integer_t cand2, void *arg) {
+  igraphmodule_SearchIterObject *self = (igraphmodule_SearchIterObject*)arg;
+  return igraphmodule_i_SearchIter_call_compat_fn(self, self->edge_compat_fn,
+      cand1, cand2);
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Runs the search itself
+ *
+ * \return 0 if everything was OK, an igraph error code otherwise
+ */
+static int igraphmodule_i_SearchIter_run(igraphmodule_SearchIterObject *self) {
+  switch (self->search) {
+    case IGRAPHMODULE_SEARCH_CLIQUES:
+      return igraph_cliques_callback(&self->gref->g, self->min_size,
+          self->max_size, igraphmodule_i_SearchIter_clique_handler, self);
+
+    case IGRAPHMODULE_SEARCH_MAXIMAL_CLIQUES:
+      return igraph_maximal_cliques_callback(&self->gref->g,
+          igraphmodule_i_SearchIter_clique_handler, self,
+          self->min_size, self->max_size);
+
+    case IGRAPHMODULE_SEARCH_SUBISOMORPHISMS_VF2:
+      return igraph_subisomorphic_function_vf2(&self->gref->g, &self->other->g,
+          self->color1, self->color2, self->edge_color1, self->edge_color2,
+          0, 0, igraphmodule_i_SearchIter_iso_handler,
+          self->node_compat_fn ? igraphmodule_i_SearchIter_node_compat_fn : 0,
+          self->edge_compat_fn ? igraphmodule_i_SearchIter_edge_compat_fn : 0,
+          self);
+  }
+
+  return IGRAPH_EINVAL;
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Entry point of the search thread
+ *
+ * The thread keeps a Python thread state of its own for the whole search so
+ * that an exception raised by the error hook of the C core is not lost when
+ * the hook releases the GIL; the exception is handed over to the consumer.
+ */
+static void igraphmodule_i_SearchIter_thread(void *arg) {
+  igraphmodule_SearchIterObject *self = (igraphmodule_SearchIterObject*)arg;
+  PyGILState_STATE gstate;
+  PyThreadState *tstate;
+  int retval = 0;
+
+  gstate = PyGILState_Ensure();
+  tstate = PyEval_SaveThread();
+
+  PyThread_acquire_lock(self->resume, WAIT_LOCK);
+  if (!self->stop) {
+    retval = igraphmodule_i_SearchIter_run(self);
+  }
+  if (retval == IGRAPH_STOP) {
+    retval = 0;
+  }
+  if (!retval) {
+    retval = self->retval;
+  }
+
+  PyEval_RestoreThread(tstate);
+  if (retval) {
+    PyErr_Fetch(&self->exc_type, &self->exc_value, &self->exc_traceback);
+  }
+  PyGILState_Release(gstate);
+
+  self->retval = retval;
+  self->exhausted = 1;
+
+  /* The iterator may be deallocated as soon as the lock is released */
+  PyThread_release_lock(self->ready);
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Starts the search thread
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+static int igraphmodule_i_SearchIter_start(igraphmodule_SearchIterObject *self) {
+  self->resume = PyThread_allocate_lock();
+  self->ready = PyThread_allocate_lock();
+  if (!self->resume || !self->ready) {
+    igraphmodule_i_SearchIter_free_locks(self);
+    PyErr_SetString(PyExc_MemoryError, "cannot allocate lock");
+    return 1;
+  }
+
+  /* Both locks start in the non-signalled state */
+  PyThread_acquire_lock(self->resume, WAIT_LOCK);
+  PyThread_acquire_lock(self->ready, WAIT_LOCK);
+
+  self->started_at = igraphmodule_clock();
+  if (PyThread_start_new_thread(igraphmodule_i_SearchIter_thread, self) ==
+      (unsigned long)-1) {
+    igraphmodule_i_SearchIter_free_locks(self);
+    PyErr_SetString(PyExc_RuntimeError, "cannot start search thread");
+    return 1;
+  }
+
+  self->state = IGRAPHMODULE_SEARCH_RUNNING;
+  self->gref->busy++;
+  if (self->other) {
+    self->other->busy++;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Drops the results of the current batch
+ */
+static void igraphmodule_i_SearchIter_clear_batch(igraphmodule_SearchIterObject *self) {
+  igraph_vector_ptr_free_all(&self->batch);
+  igraph_vector_ptr_clear(&self->batch);
+  self->next = 0;
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Runs the whole search in the calling thread
+ *
+ * Used instead of a search thread if the C core is not thread-safe: its
+ * \c IGRAPH_FINALLY stack is shared by all the threads, so a search must
+ * not be suspended halfway while other calls to the C core are made. The
+ * iterator is not lazy then: the results are collected up front and handed
+ * out in batches afterwards, which is why such iterators cannot be created
+ * without \c max_results or \c time_limit (see
+ * \ref igraphmodule_SearchIter_new()). The GIL is held during the search.
+ *
+ * \return 0 if everything was OK, 1 otherwise. An appropriate exception
+ *   is raised in the latter case.
+ */
+static int igraphmodule_i_SearchIter_drain(igraphmodule_SearchIterObject *self) {
+  int retval;
+
+  self->state = IGRAPHMODULE_SEARCH_RUNNING;
+  self->started_at = igraphmodule_clock();
+  self->gref->busy++;
+  if (self->other) {
+    self->other->busy++;
+  }
+
+  retval = igraphmodule_i_SearchIter_run(self);
+  if (retval == IGRAPH_STOP) {
+    retval = 0;
+  }
+  if (!retval) {
+    retval = self->retval;
+  }
+  self->retval = retval;
+  self->exhausted = 1;
+
+  if (retval) {
+    igraphmodule_i_SearchIter_finish(self);
+    igraphmodule_i_SearchIter_clear_batch(self);
+    if (retval == IGRAPH_ENOMEM && !PyErr_Occurred()) {
+      PyErr_NoMemory();
+    }
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+
+  /* The graphs stay busy until the results run out, like with a search
+   * thread */
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Returns the next batch of results
+ */
+static PyObject* igraphmodule_SearchIter_iternext(igraphmodule_SearchIterObject* self) {
+  PyObject *result, *item;
+  igraph_vector_t *v;
+  long int i, n;
+
+  if (self->state == IGRAPHMODULE_SEARCH_NOT_STARTED) {
+    if (IGRAPHMODULE_CORE_IS_THREAD_SAFE ?
+        igraphmodule_i_SearchIter_start(self) :
+        igraphmodule_i_SearchIter_drain(self))
+      return NULL;
+  }
+
+  if (self->state == IGRAPHMODULE_SEARCH_RUNNING &&
+      igraph_vector_ptr_size(&self->batch) == 0) {
+    if (!self->exhausted)
+      igraphmodule_i_SearchIter_wait(self);
+    if (self->exhausted)
+      igraphmodule_i_SearchIter_finish(self);
+    if (self->exhausted && self->retval) {
+      igraphmodule_i_SearchIter_clear_batch(self);
+      if (self->exc_type) {
+        PyErr_Restore(self->exc_type, self->exc_value, self->exc_traceback);
+        self->exc_type = self->exc_value = self->exc_traceback = 0;
+      } else if (self->retval == IGRAPH_ENOMEM) {
+        PyErr_NoMemory();
+      }
+      return igraphmodule_handle_igraph_error();
+    }
+  }
+
+  n = igraph_vector_ptr_size(&self->batch) - self->next;
+  if (n > self->batch_size)
+    n = self->batch_size;
+  if (n <= 0)
+    return NULL;
+
+  result = PyList_New(n);
+  for (i = 0; result && i < n; i++) {
+    v = (igraph_vector_t*)VECTOR(self->batch)[self->next + i];
+    if (self->search == IGRAPHMODULE_SEARCH_SUBISOMORPHISMS_VF2) {
+      item = igraphmodule_vector_t_to_PyList(v, IGRAPHMODULE_TYPE_INT);
+    } else {
+      item = igraphmodule_vector_t_to_PyTuple(v);
+    }
+    if (!item) {
+      Py_DECREF(result);
+      result = 0;
+    } else {
+      PyList_SET_ITEM(result, i, item);
+    }
+  }
+
+  /* The results handed out are not needed any more */
+  for (i = 0; i < n; i++) {
+    v = (igraph_vector_t*)VECTOR(self->batch)[self->next + i];
+    igraph_vector_destroy(v);
+    free(v);
+    VECTOR(self->batch)[self->next + i] = 0;
+  }
+  self->next += n;
+  if (self->next >= igraph_vector_ptr_size(&self->batch))
+    igraphmodule_i_SearchIter_clear_batch(self);
+
+  return result;
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Stops the search and releases the graphs
+ */
+static PyObject* igraphmodule_SearchIter_close(igraphmodule_SearchIterObject* self) {
+  igraphmodule_i_SearchIter_stop(self);
+  igraphmodule_i_SearchIter_clear_batch(self);
+  self->state = IGRAPHMODULE_SEARCH_FINISHED;
+  Py_RETURN_NONE;
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief Returns the number of results found so far
+ */
+static PyObject* igraphmodule_SearchIter_get_count(igraphmodule_SearchIterObject* self,
+    void* closure) {
+  return PyInt_FromLong(self->no_of_results);
+}
+
+/**
+ * \ingroup python_interface_searchiter
+ * Method table for the \c igraph.SearchIter object
+ */
+static PyMethodDef igraphmodule_SearchIter_methods[] = {
+  {"close", (PyCFunction)igraphmodule_SearchIter_close, METH_NOARGS,
+    "close()\n\n"
+    "Stops the search. No more batches are returned afterwards.\n"},
+  {NULL}
+};
+
+/**
+ * \ingroup python_interface_searchiter
+ * Getter/setter table for the \c igraph.SearchIter object
+ */
+static PyGetSetDef igraphmodule_SearchIter_getseters[] = {
+  {"count", (getter)igraphmodule_SearchIter_get_count, NULL,
+    "Number of results found so far", NULL
+  },
+  {NULL}
+};
+
+/** \ingroup python_interface_searchiter
+ * Python type object referencing the methods Python calls when it performs
+ * various operations on a search iterator
+ */
+PyTypeObject igraphmodule_SearchIterType =
+{
+  PyVarObject_HEAD_INIT(0, 0)
+  "igraph.SearchIter",                      // tp_name
+  sizeof(igraphmodule_SearchIterObject),    // tp_basicsize
+  0,                                        // tp_itemsize
+  (destructor)igraphmodule_SearchIter_dealloc, // tp_dealloc
+  0,                                        // tp_print
+  0,                                        // tp_getattr
+  0,                                        // tp_setattr
+  0,                                        /* tp_compare (2.x) / tp_reserved (3.x) */
+  0,                                        // tp_repr
+  0,                                        // tp_as_number
+  0,                                        // tp_as_sequence
+  0,                                        // tp_as_mapping
+  0,                                        // tp_hash
+  0,                                        // tp_call
+  0,                                        // tp_str
+  0,                                        // tp_getattro
+  0,                                        // tp_setattro
+  0,                                        // tp_as_buffer
+  Py_TPFLAGS_DEFAULT,                       // tp_flags
+  "igraph search iterator object\n\n"
+  "Yields the results of a clique or subisomorphism search in batches\n"
+  "(lists) while the search is in progress. The search is suspended\n"
+  "between two batches and stopped when the iterator is closed or\n"
+  "garbage collected. The graphs cannot be modified while the search is\n"
+  "in progress.\n\n"
+  "The search can only be suspended if the C core of igraph was compiled\n"
+  "with thread-local storage; the core bundled with python-igraph is not.\n"
+  "Otherwise the iterator is not lazy: the search is carried out up to\n"
+  "its limits (C{max_results} or C{time_limit}, one of which is then\n"
+  "required) when the first batch is requested, all the results found\n"
+  "are kept in memory, and the batches are handed out from there.\n", // tp_doc
+  0,                                        // tp_traverse
+  0,                                        // tp_clear
+  0,                                        // tp_richcompare
+  0,                                        // tp_weaklistoffset
+  (getiterfunc)igraphmodule_SearchIter_iter, /* tp_iter */
+  (iternextfunc)igraphmodule_SearchIter_iternext, /* tp_iternext */
+  igraphmodule_SearchIter_methods,          /* tp_methods */
+  0,                                        /* tp_members */
+  igraphmodule_SearchIter_getseters,        /* tp_getset */
+  0,                                        /* tp_base */
+  0,                                        /* tp_dict */
+  0,                                        /* tp_descr_get */
+  0,                                        /* tp_descr_set */
+  0,                                        /* tp_dictoffset */
+  0,                                        /* tp_init */
+  0,                                        /* tp_alloc */
+  0,                                        /* tp_new */
+  0,                                        /* tp_free */
+};
@@ -0,0 +1,117 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef PYTHON_SEARCHITER_H
+#define PYTHON_SEARCHITER_H
+
+#include <Python.h>
+#include <pythread.h>
+#include "graphobject.h"
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_searchiter Lazy enumeration of cliques and subisomorphisms
+ */
+extern PyTypeObject igraphmodule_SearchIterType;
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief The kinds of searches a search iterator can run
+ */
+typedef enum {
+  IGRAPHMODULE_SEARCH_CLIQUES = 0,
+  IGRAPHMODULE_SEARCH_MAXIMAL_CLIQUES,
+  IGRAPHMODULE_SEARCH_SUBISOMORPHISMS_VF2
+} igraphmodule_search_t;
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief State of the search thread of a search iterator
+ */
+typedef enum {
+  IGRAPHMODULE_SEARCH_NOT_STARTED = 0,
+  IGRAPHMODULE_SEARCH_RUNNING,
+  IGRAPHMODULE_SEARCH_FINISHED
+} igraphmodule_search_state_t;
+
+/**
+ * \ingroup python_interface_searchiter
+ * \brief An iterator that yields the results of a clique or subisomorphism
+ *        search in batches while the search is in progress.
+ *
+ * The search is run by the callback-based function of the C core in a
+ * thread of its own. The thread is suspended whenever a batch is full and
+ * resumed when the next batch is requested, so no more than one batch of
+ * results is kept in memory at any time.
+ *
+ * A C core without thread-local storage shares its \c IGRAPH_FINALLY stack
+ * between all the threads, so a suspended search would mix its entries
+ * with those of other calls. With such a core the iterator is not lazy:
+ * the search is carried out in the calling thread up to the limits of the
+ * iterator when the first batch is requested, and iterators without a
+ * limit are refused.
+ */
+typedef struct
+{
+  PyObject_HEAD
+  // The graph being searched and the pattern graph for subisomorphisms
+  igraphmodule_GraphObject* gref;
+  igraphmodule_GraphObject* other;
+  // The search to run and its parameters
+  igraphmodule_search_t search;
+  igraph_integer_t min_size, max_size;
+  igraph_vector_int_t *color1, *color2, *edge_color1, *edge_color2;
+  PyObject *node_compat_fn, *edge_compat_fn;
+  // Batch size, maximum number of results (zero = unlimited) and time
+  // budget in seconds (zero = unlimited)
+  long int batch_size;
+  long int max_results;
+  double time_limit;
+  // Number of results found so far and the time when the search started
+  long int no_of_results;
+  double started_at;
+  // The results found but not yet returned as igraph_vector_t pointers, and
+  // the index of the first one. This is one batch at most, unless the whole
+  // search was carried out up front (when the C core is not thread-safe)
+  igraph_vector_ptr_t batch;
+  long int next;
+  // State of the search as seen by the consumer, whether the search thread
+  // was asked to stop and whether it has finished
+  igraphmodule_search_state_t state;
+  int stop;
+  int exhausted;
+  // Released by the consumer when the next batch is needed and by the
+  // search thread when the batch is ready, respectively
+  PyThread_type_lock resume;
+  PyThread_type_lock ready;
+  // Result of the search and the exception raised by it
+  int retval;
+  PyObject *exc_type, *exc_value, *exc_traceback;
+} igraphmodule_SearchIterObject;
+
+PyObject* igraphmodule_SearchIter_new(igraphmodule_GraphObject *g,
+    igraphmodule_search_t search, PyObject *batch_size_o,
+    PyObject *max_results_o, PyObject *time_limit_o);
+
+#endif
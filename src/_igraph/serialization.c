@@ -0,0 +1,1039 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+/*
+ * Layout of the binary format (all integers are little-endian):
+ *
+ *   header:     "IGRB", uint32 version, uint32 flags, uint32 reserved
+ *   payload:    uint64 vcount, uint64 ecount, uint8 vertex ID width (4 or 8),
+ *               ecount source vertex IDs, ecount target vertex IDs,
+ *               then the graph, vertex and edge attributes
+ *
+ * Each attribute group starts with an uint32 count, followed by the
+ * attributes: an uint32 name length, the UTF-8 name and the values. Values
+ * start with an uint8 encoding. Typed values (floats, 64-bit integers and
+ * booleans) are followed by an uint8 flag byte and a raw block of items,
+ * optionally followed by a validity mask of one byte per item; anything
+ * else is stored as an uint64 length and the pickled Python object.
+ *
+ * If the compressed flag is set, the payload is compressed with zlib.
+ */
+
+#include "attributes.h"
+#include "columnobject.h"
+#include "error.h"
+#include "py2compat.h"
+#include "serialization.h"
+#include <string.h>
+
+#define IGRAPHMODULE_BINARY_MAGIC "IGRB"
+#define IGRAPHMODULE_BINARY_VERSION 1
+#define IGRAPHMODULE_BINARY_HEADER_SIZE 16
+
+#define IGRAPHMODULE_BINARY_FLAG_DIRECTED   1
+#define IGRAPHMODULE_BINARY_FLAG_COMPRESSED 2
+
+/* Flags of typed attribute values */
+#define IGRAPHMODULE_BINARY_VALUES_MASK     1
+#define IGRAPHMODULE_BINARY_VALUES_COLUMN   2
+
+#ifdef IGRAPH_PYTHON3
+#  define IGRAPHMODULE_BINARY_INT_CHECK_EXACT PyLong_CheckExact
+#  define IGRAPHMODULE_BINARY_PICKLE_MODULE "pickle"
+#else
+#  define IGRAPHMODULE_BINARY_INT_CHECK_EXACT PyInt_CheckExact
+#  define IGRAPHMODULE_BINARY_PICKLE_MODULE "cPickle"
+#endif
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Encodings of attribute values
+ */
+typedef enum {
+  IGRAPHMODULE_BINARY_PICKLE = 0,
+  IGRAPHMODULE_BINARY_FLOAT,
+  IGRAPHMODULE_BINARY_INT,
+  IGRAPHMODULE_BINARY_BOOL
+} igraphmodule_binary_encoding_t;
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Output buffer of the serializer, growing a bytes object in place
+ */
+typedef struct {
+  PyObject* bytes;
+  size_t size;
+} igraphmodule_i_binary_writer_t;
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Input buffer of the deserializer
+ */
+typedef struct {
+  const unsigned char* data;
+  size_t size;
+  size_t pos;
+} igraphmodule_i_binary_reader_t;
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Returns whether the host is little-endian
+ */
+static igraph_bool_t igraphmodule_i_binary_is_little_endian(void) {
+  const unsigned short int x = 1;
+  return *(const unsigned char*)&x == 1;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Stores an unsigned integer of the given width in little-endian order
+ */
+static void igraphmodule_i_binary_put_uint(unsigned char* p,
+    unsigned PY_LONG_LONG value, size_t width) {
+  size_t i;
+  for (i = 0; i < width; i++) {
+    p[i] = (unsigned char)(value & 0xff);
+    value >>= 8;
+  }
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Loads an unsigned integer of the given width in little-endian order
+ */
+static unsigned PY_LONG_LONG igraphmodule_i_binary_get_uint(const unsigned char* p,
+    size_t width) {
+  unsigned PY_LONG_LONG value = 0;
+  size_t i;
+  for (i = width; i > 0; i--) {
+    value = (value << 8) | p[i - 1];
+  }
+  return value;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Copies a block of items, reversing the byte order of each item
+ *        on big-endian hosts
+ */
+static void igraphmodule_i_binary_copy_block(unsigned char* dest,
+    const unsigned char* src, size_t count, size_t itemsize) {
+  size_t i, j;
+
+  if (itemsize == 1 || igraphmodule_i_binary_is_little_endian()) {
+    memcpy(dest, src, count * itemsize);
+    return;
+  }
+
+  for (i = 0; i < count; i++, dest += itemsize, src += itemsize) {
+    for (j = 0; j < itemsize; j++) {
+      dest[j] = src[itemsize - 1 - j];
+    }
+  }
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Makes room for the given number of bytes at the end of the output
+ *        and returns a pointer to them
+ *
+ * \return the pointer or \c NULL if there is not enough memory
+ */
+static unsigned char* igraphmodule_i_binary_writer_extend(
+    igraphmodule_i_binary_writer_t* w, size_t n) {
+  size_t capacity = w->bytes ? PyBytes_GET_SIZE(w->bytes) : 0;
+  unsigned char* result;
+
+  if (w->size + n > capacity) {
+    capacity = capacity > 0 ? capacity : 256;
+    while (capacity < w->size + n)
+      capacity *= 2;
+    if (w->bytes == 0) {
+      w->bytes = PyBytes_FromStringAndSize(0, capacity);
+      if (w->bytes == 0)
+        return 0;
+    } else if (_PyBytes_Resize(&w->bytes, capacity)) {
+      return 0;
+    }
+  }
+
+  result = (unsigned char*)PyBytes_AS_STRING(w->bytes) + w->size;
+  w->size += n;
+  return result;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Appends an unsigned integer of the given width to the output
+ *
+ * \return 0 if everything was OK, 1 otherwise
+ */
+static int igraphmodule_i_binary_write_uint(igraphmodule_i_binary_writer_t* w,
+    unsigned PY_LONG_LONG value, size_t width) {
+  unsigned char* p = igraphmodule_i_binary_writer_extend(w, width);
+  if (p == 0)
+    return 1;
+  igraphmodule_i_binary_put_uint(p, value, width);
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Appends raw bytes to the output
+ *
+ * \return 0 if everything was OK, 1 otherwise
+ */
+static int igraphmodule_i_binary_write_bytes(igraphmodule_i_binary_writer_t* w,
+    const void* data, size_t n) {
+  unsigned char* p = igraphmodule_i_binary_writer_extend(w, n);
+  if (p == 0)
+    return 1;
+  if (n > 0)
+    memcpy(p, data, n);
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Returns a pointer to the next \c n bytes of the input
+ *
+ * \return the pointer or \c NULL if the input is truncated (a \c ValueError
+ *         is raised in this case)
+ */
+static const unsigned char* igraphmodule_i_binary_read_bytes(
+    igraphmodule_i_binary_reader_t* r, size_t n) {
+  const unsigned char* result;
+
+  if (r->size - r->pos < n) {
+    PyErr_SetString(PyExc_ValueError, "truncated binary graph data");
+    return 0;
+  }
+
+  result = r->data + r->pos;
+  r->pos += n;
+  return result;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Reads an unsigned integer of the given width from the input
+ *
+ * \return 0 if everything was OK, 1 otherwise
+ */
+static int igraphmodule_i_binary_read_uint(igraphmodule_i_binary_reader_t* r,
+    size_t width, unsigned PY_LONG_LONG* value) {
+  const unsigned char* p = igraphmodule_i_binary_read_bytes(r, width);
+  if (p == 0)
+    return 1;
+  *value = igraphmodule_i_binary_get_uint(p, width);
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Calls a function of the pickle or zlib module with one argument
+ *
+ * \return the result of the call (new reference) or \c NULL
+ */
+static PyObject* igraphmodule_i_binary_call(const char* module_name,
+    const char* func_name, PyObject* arg) {
+  PyObject *module, *result;
+
+  module = PyImport_ImportModule(module_name);
+  if (module == 0)
+    return 0;
+
+  result = PyObject_CallMethod(module, (char*)func_name, "O", arg);
+  Py_DECREF(module);
+
+  return result;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Checks whether the non-missing items of a list all have the same
+ *        exact numeric or boolean type so they can be stored in a column and
+ *        restored without changing their types
+ */
+static igraph_bool_t igraphmodule_i_binary_list_is_typed(PyObject* list) {
+  Py_ssize_t i, n = PyList_GET_SIZE(list);
+  igraph_bool_t has_bool = 0, has_int = 0, has_float = 0;
+  PyObject* item;
+
+  for (i = 0; i < n; i++) {
+    item = PyList_GET_ITEM(list, i);
+    if (item == Py_None)
+      continue;
+    else if (PyBool_Check(item))
+      has_bool = 1;
+    else if (PyFloat_CheckExact(item))
+      has_float = 1;
+    else if (IGRAPHMODULE_BINARY_INT_CHECK_EXACT(item))
+      has_int = 1;
+    else
+      return 0;
+  }
+
+  return has_bool + has_int + has_float == 1;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Writes a pickled Python object to the output
+ *
+ * \return 0 if everything was OK, 1 otherwise
+ */
+static int igraphmodule_i_binary_write_pickle(igraphmodule_i_binary_writer_t* w,
+    PyObject* value) {
+  PyObject *module, *pickled;
+  int retval;
+
+  module = PyImport_ImportModule(IGRAPHMODULE_BINARY_PICKLE_MODULE);
+  if (module == 0)
+    return 1;
+
+  pickled = PyObject_CallMethod(module, "dumps", "Oi", value, -1);
+  Py_DECREF(module);
+  if (pickled == 0)
+    return 1;
+
+  if (!PyBytes_Check(pickled)) {
+    Py_DECREF(pickled);
+    PyErr_SetString(PyExc_TypeError, "pickle.dumps() must return bytes");
+    return 1;
+  }
+
+  retval = igraphmodule_i_binary_write_uint(w, IGRAPHMODULE_BINARY_PICKLE, 1) ||
+    igraphmodule_i_binary_write_uint(w, PyBytes_GET_SIZE(pickled), 8) ||
+    igraphmodule_i_binary_write_bytes(w, PyBytes_AS_STRING(pickled),
+        PyBytes_GET_SIZE(pickled));
+  Py_DECREF(pickled);
+
+  return retval;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Writes the values of a typed column to the output as raw blocks
+ *
+ * \return 0 if everything was OK, 1 otherwise
+ */
+static int igraphmodule_i_binary_write_column(igraphmodule_i_binary_writer_t* w,
+    igraphmodule_ColumnObject* column, igraph_bool_t is_column) {
+  igraphmodule_binary_encoding_t encoding;
+  size_t itemsize;
+  unsigned char* p;
+  int flags = 0;
+
+  switch (column->type) {
+    case IGRAPHMODULE_COLUMN_FLOAT:
+      encoding = IGRAPHMODULE_BINARY_FLOAT; itemsize = sizeof(double); break;
+    case IGRAPHMODULE_COLUMN_INT:
+      encoding = IGRAPHMODULE_BINARY_INT; itemsize = sizeof(PY_LONG_LONG); break;
+    default:
+      encoding = IGRAPHMODULE_BINARY_BOOL; itemsize = 1;
+  }
+
+  if (column->valid)
+    flags |= IGRAPHMODULE_BINARY_VALUES_MASK;
+  if (is_column)
+    flags |= IGRAPHMODULE_BINARY_VALUES_COLUMN;
+
+  if (igraphmodule_i_binary_write_uint(w, encoding, 1) ||
+      igraphmodule_i_binary_write_uint(w, flags, 1))
+    return 1;
+
+  p = igraphmodule_i_binary_writer_extend(w, column->size * itemsize);
+  if (p == 0)
+    return 1;
+  if (column->size > 0)
+    igraphmodule_i_binary_copy_block(p, (unsigned char*)column->data,
+        column->size, itemsize);
+
+  if (column->valid) {
+    if (igraphmodule_i_binary_write_bytes(w, column->valid, column->size))
+      return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Writes the values of an attribute to the output
+ *
+ * Vertex and edge attributes stored in columns or in lists of floats,
+ * integers or booleans are written as raw blocks; everything else is
+ * pickled.
+ *
+ * \return 0 if everything was OK, 1 otherwise
+ */
+static int igraphmodule_i_binary_write_values(igraphmodule_i_binary_writer_t* w,
+    PyObject* values, igraph_bool_t allow_typed) {
+  PyObject* column;
+  int retval;
+
+  if (allow_typed && igraphmodule_Column_Check(values))
+    return igraphmodule_i_binary_write_column(w,
+        (igraphmodule_ColumnObject*)values, 1);
+
+  if (allow_typed && PyList_Check(values) && igraphmodule_i_binary_list_is_typed(values)) {
+    column = igraphmodule_Column_from_list(values);
+    if (column != 0) {
+      retval = igraphmodule_i_binary_write_column(w,
+          (igraphmodule_ColumnObject*)column, 0);
+      Py_DECREF(column);
+      return retval;
+    }
+    /* Integers too large for a column; fall back to pickling */
+    PyErr_Clear();
+  }
+
+  return igraphmodule_i_binary_write_pickle(w, values);
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Writes the attributes of the given type to the output
+ *
+ * \return 0 if everything was OK, 1 otherwise
+ */
+static int igraphmodule_i_binary_write_attributes(igraphmodule_i_binary_writer_t* w,
+    PyObject* dict, igraph_bool_t allow_typed) {
+  Py_ssize_t pos = 0;
+  PyObject *name, *values;
+  char* name_str;
+  int retval;
+
+  if (igraphmodule_i_binary_write_uint(w, PyDict_Size(dict), 4))
+    return 1;
+
+  while (PyDict_Next(dict, &pos, &name, &values)) {
+    name_str = PyString_CopyAsString(name);
+    if (name_str == 0)
+      return 1;
+    retval = igraphmodule_i_binary_write_uint(w, strlen(name_str), 4) ||
+      igraphmodule_i_binary_write_bytes(w, name_str, strlen(name_str));
+    free(name_str);
+    if (retval)
+      return 1;
+
+    if (igraphmodule_i_binary_write_values(w, values, allow_typed))
+      return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Serializes a graph and its attributes into the compact binary format
+ *
+ * \param graph the graph to serialize
+ * \param compress whether to compress the payload with zlib
+ * \return a new bytes object or \c NULL if an error happened
+ */
+PyObject* igraphmodule_igraph_t_to_binary(const igraph_t* graph, igraph_bool_t compress) {
+  igraphmodule_i_binary_writer_t w = { 0, 0 };
+  long int i, vcount = igraph_vcount(graph), ecount = igraph_ecount(graph);
+  size_t width = (unsigned PY_LONG_LONG)vcount > 0xffffffffUL ? 8 : 4;
+  PyObject **attrs = ATTR_STRUCT_DICT(graph);
+  PyObject *payload, *compressed, *result;
+  unsigned char *from, *to;
+  int flags = 0;
+
+  if (igraph_is_directed(graph))
+    flags |= IGRAPHMODULE_BINARY_FLAG_DIRECTED;
+  if (compress)
+    flags |= IGRAPHMODULE_BINARY_FLAG_COMPRESSED;
+
+  if (igraphmodule_i_binary_write_bytes(&w, IGRAPHMODULE_BINARY_MAGIC, 4) ||
+      igraphmodule_i_binary_write_uint(&w, IGRAPHMODULE_BINARY_VERSION, 4) ||
+      igraphmodule_i_binary_write_uint(&w, flags, 4) ||
+      igraphmodule_i_binary_write_uint(&w, 0, 4))
+    goto error;
+
+  /* Edge list, as two blocks of source and target vertex IDs */
+  if (igraphmodule_i_binary_write_uint(&w, vcount, 8) ||
+      igraphmodule_i_binary_write_uint(&w, ecount, 8) ||
+      igraphmodule_i_binary_write_uint(&w, width, 1))
+    goto error;
+
+  from = igraphmodule_i_binary_writer_extend(&w, 2 * ecount * width);
+  if (from == 0)
+    goto error;
+  to = from + ecount * width;
+  for (i = 0; i < ecount; i++) {
+    igraphmodule_i_binary_put_uint(from + i * width, IGRAPH_FROM(graph, i), width);
+    igraphmodule_i_binary_put_uint(to + i * width, IGRAPH_TO(graph, i), width);
+  }
+
+  /* Attributes */
+  if (igraphmodule_i_binary_write_attributes(&w, attrs[ATTRHASH_IDX_GRAPH], 0) ||
+      igraphmodule_i_binary_write_attributes(&w, attrs[ATTRHASH_IDX_VERTEX], 1) ||
+      igraphmodule_i_binary_write_attributes(&w, attrs[ATTRHASH_IDX_EDGE], 1))
+    goto error;
+
+  if (!compress) {
+    if (_PyBytes_Resize(&w.bytes, w.size))
+      return 0;
+    return w.bytes;
+  }
+
+  payload = PyBytes_FromStringAndSize(PyBytes_AS_STRING(w.bytes) +
+      IGRAPHMODULE_BINARY_HEADER_SIZE, w.size - IGRAPHMODULE_BINARY_HEADER_SIZE);
+  if (payload == 0)
+    goto error;
+
+  compressed = igraphmodule_i_binary_call("zlib", "compress", payload);
+  Py_DECREF(payload);
+  if (compressed == 0)
+    goto error;
+
+  result = PyBytes_FromStringAndSize(0,
+      IGRAPHMODULE_BINARY_HEADER_SIZE + PyBytes_GET_SIZE(compressed));
+  if (result != 0) {
+    memcpy(PyBytes_AS_STRING(result), PyBytes_AS_STRING(w.bytes),
+        IGRAPHMODULE_BINARY_HEADER_SIZE);
+    memcpy(PyBytes_AS_STRING(result) + IGRAPHMODULE_BINARY_HEADER_SIZE,
+        PyBytes_AS_STRING(compressed), PyBytes_GET_SIZE(compressed));
+  }
+  Py_DECREF(compressed);
+  Py_DECREF(w.bytes);
+
+  return result;
+
+error:
+  Py_XDECREF(w.bytes);
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Reads the values of an attribute from the input
+ *
+ * \param n the number of values expected if the attribute is typed
+ * \param values the Python list or column is returned here
+ * \return 0 if everything was OK, 1 otherwise
+ */
+static int igraphmodule_i_binary_read_values(igraphmodule_i_binary_reader_t* r,
+    Py_ssize_t n, igraph_bool_t allow_typed, PyObject** values) {
+  unsigned PY_LONG_LONG encoding, flags, length;
+  igraphmodule_column_type_t type;
+  igraphmodule_ColumnObject* column;
+  const unsigned char* p;
+  PyObject* pickled;
+  size_t itemsize;
+
+  if (igraphmodule_i_binary_read_uint(r, 1, &encoding))
+    return 1;
+
+  if (encoding == IGRAPHMODULE_BINARY_PICKLE) {
+    if (igraphmodule_i_binary_read_uint(r, 8, &length))
+      return 1;
+    p = igraphmodule_i_binary_read_bytes(r, length);
+    if (p == 0)
+      return 1;
+    pickled = PyBytes_FromStringAndSize((const char*)p, length);
+    if (pickled == 0)
+      return 1;
+    *values = igraphmodule_i_binary_call(IGRAPHMODULE_BINARY_PICKLE_MODULE,
+        "loads", pickled);
+    Py_DECREF(pickled);
+    if (*values == 0)
+      return 1;
+    if (allow_typed && (!PyList_Check(*values) || PyList_GET_SIZE(*values) != n)) {
+      Py_DECREF(*values);
+      PyErr_SetString(PyExc_ValueError, "corrupted attribute in binary graph data");
+      return 1;
+    }
+    return 0;
+  }
+
+  switch (encoding) {
+    case IGRAPHMODULE_BINARY_FLOAT:
+      type = IGRAPHMODULE_COLUMN_FLOAT; itemsize = sizeof(double); break;
+    case IGRAPHMODULE_BINARY_INT:
+      type = IGRAPHMODULE_COLUMN_INT; itemsize = sizeof(PY_LONG_LONG); break;
+    case IGRAPHMODULE_BINARY_BOOL:
+      type = IGRAPHMODULE_COLUMN_BOOL; itemsize = 1; break;
+    default:
+      PyErr_SetString(PyExc_ValueError, "unknown attribute encoding in binary graph data");
+      return 1;
+  }
+
+  if (!allow_typed) {
+    PyErr_SetString(PyExc_ValueError, "corrupted attribute in binary graph data");
+    return 1;
+  }
+
+  if (igraphmodule_i_binary_read_uint(r, 1, &flags))
+    return 1;
+
+  p = igraphmodule_i_binary_read_bytes(r, n * itemsize);
+  if (p == 0)
+    return 1;
+
+  column = (igraphmodule_ColumnObject*)igraphmodule_Column_New(type, n);
+  if (column == 0)
+    return 1;
+  if (n > 0)
+    igraphmodule_i_binary_copy_block((unsigned char*)column->data, p, n, itemsize);
+
+  if (flags & IGRAPHMODULE_BINARY_VALUES_MASK) {
+    p = igraphmodule_i_binary_read_bytes(r, n);
+    if (p == 0) {
+      Py_DECREF(column);
+      return 1;
+    }
+    column->valid = (char*)PyMem_Malloc(column->capacity);
+    if (column->valid == 0) {
+      Py_DECREF(column);
+      PyErr_NoMemory();
+      return 1;
+    }
+    memcpy(column->valid, p, n);
+  }
+
+  if (flags & IGRAPHMODULE_BINARY_VALUES_COLUMN) {
+    *values = (PyObject*)column;
+  } else {
+    *values = igraphmodule_Column_to_list(column);
+    Py_DECREF(column);
+    if (*values == 0)
+      return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Reads the attributes of the given type from the input into the
+ *        given attribute dictionary
+ *
+ * \return 0 if everything was OK, 1 otherwise
+ */
+static int igraphmodule_i_binary_read_attributes(igraphmodule_i_binary_reader_t* r,
+    PyObject* dict, Py_ssize_t n, igraph_bool_t allow_typed) {
+  unsigned PY_LONG_LONG count, length, i;
+  const unsigned char* p;
+  PyObject *name, *values;
+  int retval;
+
+  if (igraphmodule_i_binary_read_uint(r, 4, &count))
+    return 1;
+
+  for (i = 0; i < count; i++) {
+    if (igraphmodule_i_binary_read_uint(r, 4, &length))
+      return 1;
+    p = igraphmodule_i_binary_read_bytes(r, length);
+    if (p == 0)
+      return 1;
+#ifdef IGRAPH_PYTHON3
+    name = PyUnicode_DecodeUTF8((const char*)p, length, "strict");
+#else
+    name = PyString_FromStringAndSize((const char*)p, length);
+#endif
+    if (name == 0)
+      return 1;
+
+    if (igraphmodule_i_binary_read_values(r, n, allow_typed, &values)) {
+      Py_DECREF(name);
+      return 1;
+    }
+
+    retval = PyDict_SetItem(dict, name, values);
+    Py_DECREF(name);
+    Py_DECREF(values);
+    if (retval)
+      return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Rebuilds a graph from the payload of the binary format
+ *
+ * \return 0 if everything was OK, 1 otherwise
+ */
+static int igraphmodule_i_binary_read_graph(igraphmodule_i_binary_reader_t* r,
+    igraph_bool_t directed, igraph_t* graph) {
+  unsigned PY_LONG_LONG vcount, ecount, width;
+  const unsigned char *from, *to;
+  igraph_vector_t edges;
+  PyObject** attrs;
+  long int i;
+
+  if (igraphmodule_i_binary_read_uint(r, 8, &vcount) ||
+      igraphmodule_i_binary_read_uint(r, 8, &ecount) ||
+      igraphmodule_i_binary_read_uint(r, 1, &width))
+    return 1;
+
+  if (width != 4 && width != 8) {
+    PyErr_SetString(PyExc_ValueError, "invalid vertex ID width in binary graph data");
+    return 1;
+  }
+
+  if ((unsigned PY_LONG_LONG)(igraph_integer_t)vcount != vcount ||
+      (unsigned PY_LONG_LONG)(long int)ecount != ecount ||
+      (r->size - r->pos) / (2 * width) < ecount) {
+    PyErr_SetString(PyExc_ValueError, "truncated binary graph data");
+    return 1;
+  }
+
+  from = igraphmodule_i_binary_read_bytes(r, ecount * width);
+  to = igraphmodule_i_binary_read_bytes(r, ecount * width);
+
+  if (igraph_vector_init(&edges, 2 * ecount)) {
+    igraphmodule_handle_igraph_error();
+    return 1;
+  }
+
+  for (i = 0; i < (long int)ecount; i++) {
+    VECTOR(edges)[2 * i] = igraphmodule_i_binary_get_uint(from + i * width, width);
+    VECTOR(edges)[2 * i + 1] = igraphmodule_i_binary_get_uint(to + i * width, width);
+  }
+
+  if (igraph_create(graph, &edges, (igraph_integer_t)vcount, directed)) {
+    igraphmodule_handle_igraph_error();
+    igraph_vector_destroy(&edges);
+    return 1;
+  }
+  igraph_vector_destroy(&edges);
+
+  if ((unsigned PY_LONG_LONG)igraph_vcount(graph) != vcount) {
+    /* igraph_create() adds vertices for out-of-range vertex IDs */
+    igraph_destroy(graph);
+    PyErr_SetString(PyExc_ValueError, "invalid vertex ID in binary graph data");
+    return 1;
+  }
+
+  attrs = ATTR_STRUCT_DICT(graph);
+  if (igraphmodule_i_binary_read_attributes(r, attrs[ATTRHASH_IDX_GRAPH], 1, 0) ||
+      igraphmodule_i_binary_read_attributes(r, attrs[ATTRHASH_IDX_VERTEX], vcount, 1) ||
+      igraphmodule_i_binary_read_attributes(r, attrs[ATTRHASH_IDX_EDGE], ecount, 1)) {
+    igraph_destroy(graph);
+    return 1;
+  }
+
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Rebuilds a graph and its attributes from the compact binary format
+ *
+ * \param data a Python object exporting the binary data via the buffer
+ *        protocol (e.g., \c bytes or a \c PickleBuffer)
+ * \param graph an uninitialized graph; the result is stored here
+ * \return 0 if everything was OK, 1 otherwise (an exception is set)
+ */
+int igraphmodule_binary_to_igraph_t(PyObject* data, igraph_t* graph) {
+  igraphmodule_i_binary_reader_t r = { 0, 0, 0 };
+  unsigned PY_LONG_LONG version, flags;
+  PyObject *payload = 0, *decompressed = 0;
+  Py_buffer view;
+  int retval;
+
+  if (PyObject_GetBuffer(data, &view, PyBUF_SIMPLE))
+    return 1;
+
+  r.data = (const unsigned char*)view.buf;
+  r.size = view.len;
+
+  if (r.size < IGRAPHMODULE_BINARY_HEADER_SIZE ||
+      memcmp(r.data, IGRAPHMODULE_BINARY_MAGIC, 4)) {
+    PyBuffer_Release(&view);
+    PyErr_SetString(PyExc_ValueError, "data is not in igraph's binary graph format");
+    return 1;
+  }
+
+  version = igraphmodule_i_binary_get_uint(r.data + 4, 4);
+  flags = igraphmodule_i_binary_get_uint(r.data + 8, 4);
+  if (version != IGRAPHMODULE_BINARY_VERSION) {
+    PyBuffer_Release(&view);
+    PyErr_Format(PyExc_ValueError, "unsupported binary graph format version: %ld",
+        (long)version);
+    return 1;
+  }
+
+  r.pos = IGRAPHMODULE_BINARY_HEADER_SIZE;
+
+  if (flags & IGRAPHMODULE_BINARY_FLAG_COMPRESSED) {
+    payload = PyBytes_FromStringAndSize((const char*)r.data + r.pos, r.size - r.pos);
+    PyBuffer_Release(&view);
+    if (payload == 0)
+      return 1;
+    decompressed = igraphmodule_i_binary_call("zlib", "decompress", payload);
+    Py_DECREF(payload);
+    if (decompressed == 0)
+      return 1;
+    r.data = (const unsigned char*)PyBytes_AS_STRING(decompressed);
+    r.size = PyBytes_GET_SIZE(decompressed);
+    r.pos = 0;
+  }
+
+  retval = igraphmodule_i_binary_read_graph(&r,
+      (flags & IGRAPHMODULE_BINARY_FLAG_DIRECTED) != 0, graph);
+
+  if (decompressed != 0)
+    Py_DECREF(decompressed);
+  else
+    PyBuffer_Release(&view);
+
+  return retval;
+}
+
+/*
+ * Layout of snapshots (integers in the header are little-endian, the
+ * vectors are stored in the native format of igraph_real_t):
+ *
+ *   header:     "IGRS", uint32 version, uint32 flags, uint32 byte order mark
+ *               (0x01020304 in native order), uint64 vcount, uint64 ecount,
+ *               uint64 offset and uint64 size of the attribute section,
+ *               padded to 64 bytes
+ *   vectors:    from, to, oi, ii (ecount items each), os, is (vcount+1
+ *               items each), at offset 64
+ *   attributes: graph, vertex and edge attributes as in the binary format
+ *
+ * The vectors are used in place by the graph returned from
+ * igraphmodule_snapshot_to_igraph_t(), so the snapshot should be mapped
+ * into memory instead of being read.
+ */
+
+#define IGRAPHMODULE_SNAPSHOT_MAGIC "IGRS"
+#define IGRAPHMODULE_SNAPSHOT_VERSION 1
+#define IGRAPHMODULE_SNAPSHOT_HEADER_SIZE 64
+#define IGRAPHMODULE_SNAPSHOT_BYTE_ORDER_MARK 0x01020304UL
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Returns pointers to the vectors of a graph in the order they are
+ *        stored in a snapshot
+ */
+static void igraphmodule_i_snapshot_vectors(igraph_t* graph, igraph_vector_t** vectors) {
+  vectors[0] = &graph->from;
+  vectors[1] = &graph->to;
+  vectors[2] = &graph->oi;
+  vectors[3] = &graph->ii;
+  vectors[4] = &graph->os;
+  vectors[5] = &graph->is;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Serializes a graph and its attributes into a snapshot that can be
+ *        mapped into memory by \c igraphmodule_snapshot_to_igraph_t()
+ *
+ * \return a new bytes object or \c NULL if an error happened
+ */
+PyObject* igraphmodule_igraph_t_to_snapshot(const igraph_t* graph) {
+  igraphmodule_i_binary_writer_t w = { 0, 0 };
+  igraph_vector_t* vectors[6];
+  PyObject **attrs = ATTR_STRUCT_DICT(graph);
+  unsigned PY_LONG_LONG byte_order_mark = IGRAPHMODULE_SNAPSHOT_BYTE_ORDER_MARK;
+  unsigned PY_LONG_LONG attr_offset;
+  PY_UINT32_T mark = (PY_UINT32_T)byte_order_mark;
+  unsigned char* p;
+  size_t n;
+  int i;
+
+  igraphmodule_i_snapshot_vectors((igraph_t*)graph, vectors);
+
+  p = igraphmodule_i_binary_writer_extend(&w, IGRAPHMODULE_SNAPSHOT_HEADER_SIZE);
+  if (p == 0)
+    goto error;
+  memset(p, 0, IGRAPHMODULE_SNAPSHOT_HEADER_SIZE);
+  memcpy(p, IGRAPHMODULE_SNAPSHOT_MAGIC, 4);
+  igraphmodule_i_binary_put_uint(p + 4, IGRAPHMODULE_SNAPSHOT_VERSION, 4);
+  igraphmodule_i_binary_put_uint(p + 8,
+      igraph_is_directed(graph) ? IGRAPHMODULE_BINARY_FLAG_DIRECTED : 0, 4);
+  memcpy(p + 12, &mark, 4);
+  igraphmodule_i_binary_put_uint(p + 16, igraph_vcount(graph), 8);
+  igraphmodule_i_binary_put_uint(p + 24, igraph_ecount(graph), 8);
+
+  for (i = 0; i < 6; i++) {
+    n = igraph_vector_size(vectors[i]) * sizeof(igraph_real_t);
+    if (igraphmodule_i_binary_write_bytes(&w, VECTOR(*vectors[i]), n))
+      goto error;
+  }
+
+  attr_offset = w.size;
+  if (igraphmodule_i_binary_write_attributes(&w, attrs[ATTRHASH_IDX_GRAPH], 0) ||
+      igraphmodule_i_binary_write_attributes(&w, attrs[ATTRHASH_IDX_VERTEX], 1) ||
+      igraphmodule_i_binary_write_attributes(&w, attrs[ATTRHASH_IDX_EDGE], 1))
+    goto error;
+
+  p = (unsigned char*)PyBytes_AS_STRING(w.bytes);
+  igraphmodule_i_binary_put_uint(p + 32, attr_offset, 8);
+  igraphmodule_i_binary_put_uint(p + 40, w.size - attr_offset, 8);
+
+  if (_PyBytes_Resize(&w.bytes, w.size))
+    return 0;
+  return w.bytes;
+
+error:
+  Py_XDECREF(w.bytes);
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Detaches the vectors of a graph created from a snapshot so the
+ *        graph can be destroyed with \c igraph_destroy()
+ *
+ * The vectors point into the snapshot and must not be freed by igraph.
+ */
+void igraphmodule_snapshot_detach_igraph_t(igraph_t* graph) {
+  igraph_vector_t* vectors[6];
+  int i;
+
+  igraphmodule_i_snapshot_vectors(graph, vectors);
+  for (i = 0; i < 6; i++) {
+    vectors[i]->stor_begin = vectors[i]->stor_end = vectors[i]->end = 0;
+  }
+}
+
+/**
+ * \ingroup python_interface_serialization
+ * \brief Creates a graph whose vectors point into a snapshot
+ *
+ * The contents of the vectors are not validated beyond a few cheap
+ * consistency checks, so that opening a snapshot does not touch every page
+ * of it.
+ *
+ * \param data a Python object exporting the snapshot via the buffer
+ *        protocol, typically a read-only \c mmap object
+ * \param view the buffer acquired from \c data is returned here; it must
+ *        be released only after the graph has been detached and destroyed
+ * \param graph an uninitialized graph; the result is stored here. It must
+ *        never be modified and it must be detached with
+ *        \c igraphmodule_snapshot_detach_igraph_t() before destroying it.
+ * \return 0 if everything was OK, 1 otherwise (an exception is set)
+ */
+int igraphmodule_snapshot_to_igraph_t(PyObject* data, Py_buffer* view, igraph_t* graph) {
+  igraphmodule_i_binary_reader_t r = { 0, 0, 0 };
+  unsigned PY_LONG_LONG version, flags, vcount, ecount, attr_offset, attr_size;
+  igraph_vector_t* vectors[6];
+  igraph_real_t* block;
+  PyObject** attrs;
+  PY_UINT32_T mark;
+  size_t lengths[6], total = 0;
+  int i;
+
+  if (PyObject_GetBuffer(data, view, PyBUF_SIMPLE))
+    return 1;
+
+  r.data = (const unsigned char*)view->buf;
+  r.size = view->len;
+
+  if (r.size < IGRAPHMODULE_SNAPSHOT_HEADER_SIZE ||
+      memcmp(r.data, IGRAPHMODULE_SNAPSHOT_MAGIC, 4)) {
+    PyErr_SetString(PyExc_ValueError, "data is not an igraph graph snapshot");
+    goto error;
+  }
+
+  version = igraphmodule_i_binary_get_uint(r.data + 4, 4);
+  if (version != IGRAPHMODULE_SNAPSHOT_VERSION) {
+    PyErr_Format(PyExc_ValueError, "unsupported graph snapshot version: %ld",
+        (long)version);
+    goto error;
+  }
+
+  memcpy(&mark, r.data + 12, 4);
+  if (mark != (PY_UINT32_T)IGRAPHMODULE_SNAPSHOT_BYTE_ORDER_MARK) {
+    PyErr_SetString(PyExc_ValueError, "graph snapshot was created on a "
+        "machine with a different byte order");
+    goto error;
+  }
+
+  if ((size_t)r.data % sizeof(igraph_real_t) != 0) {
+    PyErr_SetString(PyExc_ValueError, "graph snapshot is not suitably aligned "
+        "in memory");
+    goto error;
+  }
+
+  flags = igraphmodule_i_binary_get_uint(r.data + 8, 4);
+  vcount = igraphmodule_i_binary_get_uint(r.data + 16, 8);
+  ecount = igraphmodule_i_binary_get_uint(r.data + 24, 8);
+  attr_offset = igraphmodule_i_binary_get_uint(r.data + 32, 8);
+  attr_size = igraphmodule_i_binary_get_uint(r.data + 40, 8);
+
+  if ((unsigned PY_LONG_LONG)(igraph_integer_t)vcount != vcount ||
+      (unsigned PY_LONG_LONG)(long int)ecount != ecount ||
+      attr_offset > r.size || attr_size > r.size - attr_offset) {
+    PyErr_SetString(PyExc_ValueError, "truncated graph snapshot");
+    goto error;
+  }
+
+  lengths[0] = lengths[1] = lengths[2] = lengths[3] = ecount;
+  lengths[4] = lengths[5] = vcount + 1;
+  for (i = 0; i < 6; i++)
+    total += lengths[i];
+  if ((attr_offset - IGRAPHMODULE_SNAPSHOT_HEADER_SIZE) / sizeof(igraph_real_t) < total ||
+      attr_offset < IGRAPHMODULE_SNAPSHOT_HEADER_SIZE) {
+    PyErr_SetString(PyExc_ValueError, "truncated graph snapshot");
+    goto error;
+  }
+
+  block = (igraph_real_t*)(r.data + IGRAPHMODULE_SNAPSHOT_HEADER_SIZE);
+  if (block[lengths[0] * 4 + vcount] != ecount ||
+      block[lengths[0] * 4 + lengths[4] + vcount] != ecount) {
+    PyErr_SetString(PyExc_ValueError, "corrupted graph snapshot");
+    goto error;
+  }
+
+  if (igraph_empty(graph, 0, (flags & IGRAPHMODULE_BINARY_FLAG_DIRECTED) != 0)) {
+    igraphmodule_handle_igraph_error();
+    goto error;
+  }
+
+  igraphmodule_i_snapshot_vectors(graph, vectors);
+  for (i = 0; i < 6; i++) {
+    igraph_vector_destroy(vectors[i]);
+    igraph_vector_view(vectors[i], block, lengths[i]);
+    block += lengths[i];
+  }
+  graph->n = (igraph_integer_t)vcount;
+
+  r.pos = attr_offset;
+  r.size = attr_offset + attr_size;
+  attrs = ATTR_STRUCT_DICT(graph);
+  if (igraphmodule_i_binary_read_attributes(&r, attrs[ATTRHASH_IDX_GRAPH], 1, 0) ||
+      igraphmodule_i_binary_read_attributes(&r, attrs[ATTRHASH_IDX_VERTEX], vcount, 1) ||
+      igraphmodule_i_binary_read_attributes(&r, attrs[ATTRHASH_IDX_EDGE], ecount, 1)) {
+    igraphmodule_snapshot_detach_igraph_t(graph);
+    igraph_destroy(graph);
+    goto error;
+  }
+
+  return 0;
+
+error:
+  PyBuffer_Release(view);
+  return 1;
+}
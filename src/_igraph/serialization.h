@@ -0,0 +1,43 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef PYTHON_SERIALIZATION_H
+#define PYTHON_SERIALIZATION_H
+
+#include <Python.h>
+#include <igraph.h>
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_serialization Compact binary graph format
+ */
+
+PyObject* igraphmodule_igraph_t_to_binary(const igraph_t* graph, igraph_bool_t compress);
+int igraphmodule_binary_to_igraph_t(PyObject* data, igraph_t* graph);
+
+PyObject* igraphmodule_igraph_t_to_snapshot(const igraph_t* graph);
+int igraphmodule_snapshot_to_igraph_t(PyObject* data, Py_buffer* view, igraph_t* graph);
+void igraphmodule_snapshot_detach_igraph_t(igraph_t* graph);
+
+#endif
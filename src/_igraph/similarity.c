@@ -0,0 +1,408 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+#include "similarity.h"
+#include "threading.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \ingroup python_interface_similarity
+ * \brief The adjacency structure and the parameters shared by the workers
+ */
+typedef struct {
+  long int no_of_nodes;
+  // The neighbors of the vertices in the requested direction, and the
+  // vertices that have them as neighbors in that direction
+  const igraphmodule_adjacency_t *adj;
+  const igraphmodule_adjacency_t *rev;
+  igraphmodule_similarity_t type;
+  igraph_bool_t loops;
+  // Sizes of the neighbor sets for the Jaccard and Dice similarities, and
+  // the weights of the common neighbors for the inverse log-weighted one
+  igraph_real_t *sizes;
+  igraph_real_t *weights;
+  const igraph_vector_t *sources;
+  long int top_k;
+  igraph_real_t threshold;
+  // Where the result of each source starts in the buffer of the worker
+  // that processed it, and its length
+  long int *starts;
+  long int *counts;
+  long int no_of_workers;
+} igraphmodule_i_similarity_job_t;
+
+/**
+ * \ingroup python_interface_similarity
+ * \brief Workspace of a single worker thread
+ */
+typedef struct {
+  const igraphmodule_i_similarity_job_t *job;
+  long int index;
+  // Accumulated common neighbors (or their weights) of the candidates and
+  // the list of the candidates found so far for the current source
+  igraph_real_t *acc;
+  char *seen;
+  long int *touched;
+  // Min-heap of the most similar candidates
+  long int *heap;
+  // The results of the sources processed by this worker, one after the
+  // other
+  long int *ids;
+  igraph_real_t *scores;
+  long int size, capacity;
+  int failed;
+} igraphmodule_i_similarity_worker_t;
+
+/**
+ * \ingroup python_interface_similarity
+ * \brief Whether candidate \c a ranks below candidate \c b; ties are broken
+ *        by the vertex IDs so that the lists are deterministic
+ */
+static int igraphmodule_i_similarity_below(const igraph_real_t *x, long int a, long int b) {
+  return x[a] < x[b] || (x[a] == x[b] && a > b);
+}
+
+static void igraphmodule_i_similarity_sift_down(const igraph_real_t *x,
+    long int *heap, long int size, long int i) {
+  long int child, tmp;
+
+  while ((child = 2 * i + 1) < size) {
+    if (child + 1 < size && igraphmodule_i_similarity_below(x, heap[child + 1], heap[child]))
+      child++;
+    if (!igraphmodule_i_similarity_below(x, heap[child], heap[i]))
+      break;
+    tmp = heap[i]; heap[i] = heap[child]; heap[child] = tmp;
+    i = child;
+  }
+}
+
+/**
+ * \ingroup python_interface_similarity
+ * \brief Adds the vertices that have \c w as a neighbor to the candidates
+ *        of a source
+ */
+static void igraphmodule_i_similarity_visit(igraphmodule_i_similarity_worker_t *w,
+    long int u, long int mid, long int *no_of_touched) {
+  const igraphmodule_i_similarity_job_t *job = w->job;
+  const igraphmodule_adjacency_t *rev = job->rev;
+  int sets = job->type != IGRAPHMODULE_SIMILARITY_INVERSE_LOG_WEIGHTED;
+  igraph_real_t weight = sets ? 1 : job->weights[mid];
+  long int j, x, prev = -1;
+
+  for (j = rev->offsets[mid]; j < rev->offsets[mid + 1]; j++) {
+    x = rev->neighbors[j];
+    /* The Jaccard and Dice similarities work with neighbor sets: multiple
+     * edges are counted once and loop edges are ignored (the lists are
+     * sorted, so duplicates are adjacent) */
+    if (sets && (x == prev || x == mid))
+      continue;
+    prev = x;
+    if (x == u)
+      continue;
+    if (!w->seen[x]) {
+      w->seen[x] = 1;
+      w->touched[(*no_of_touched)++] = x;
+    }
+    w->acc[x] += weight;
+  }
+  if (sets && job->loops && mid != u) {
+    /* Every vertex is its own neighbor */
+    if (!w->seen[mid]) {
+      w->seen[mid] = 1;
+      w->touched[(*no_of_touched)++] = mid;
+    }
+    w->acc[mid] += 1;
+  }
+}
+
+/**
+ * \ingroup python_interface_similarity
+ * \brief Finds the most similar vertices of a source and appends them to
+ *        the buffer of the worker
+ */
+static void igraphmodule_i_similarity_source(igraphmodule_i_similarity_worker_t *w,
+    long int s) {
+  const igraphmodule_i_similarity_job_t *job = w->job;
+  const igraphmodule_adjacency_t *adj = job->adj;
+  int sets = job->type != IGRAPHMODULE_SIMILARITY_INVERSE_LOG_WEIGHTED;
+  long int u = (long int) VECTOR(*job->sources)[s], no_of_touched = 0;
+  long int j, mid, prev = -1, i, x, size = 0, tmp, k;
+  igraph_real_t c;
+
+  for (j = adj->offsets[u]; j < adj->offsets[u + 1]; j++) {
+    mid = adj->neighbors[j];
+    if (sets && (mid == prev || mid == u))
+      continue;
+    prev = mid;
+    igraphmodule_i_similarity_visit(w, u, mid, &no_of_touched);
+  }
+  if (sets && job->loops)
+    igraphmodule_i_similarity_visit(w, u, u, &no_of_touched);
+
+  /* Turn the accumulated values into similarities and select the best
+   * candidates above the threshold */
+  k = job->top_k > 0 ? job->top_k : no_of_touched;
+  for (i = 0; i < no_of_touched; i++) {
+    x = w->touched[i];
+    c = w->acc[x];
+    if (job->type == IGRAPHMODULE_SIMILARITY_JACCARD)
+      c = c / (job->sizes[u] + job->sizes[x] - c);
+    else if (job->type == IGRAPHMODULE_SIMILARITY_DICE)
+      c = 2 * c / (job->sizes[u] + job->sizes[x]);
+    w->acc[x] = c;
+    if (c < job->threshold)
+      continue;
+    if (size < k) {
+      /* sift up */
+      j = size++;
+      w->heap[j] = x;
+      while (j > 0 && igraphmodule_i_similarity_below(w->acc, w->heap[j], w->heap[(j - 1) / 2])) {
+        tmp = w->heap[j]; w->heap[j] = w->heap[(j - 1) / 2]; w->heap[(j - 1) / 2] = tmp;
+        j = (j - 1) / 2;
+      }
+    } else if (igraphmodule_i_similarity_below(w->acc, w->heap[0], x)) {
+      w->heap[0] = x;
+      igraphmodule_i_similarity_sift_down(w->acc, w->heap, size, 0);
+    }
+  }
+
+  if (w->size + size > w->capacity) {
+    long int capacity = 2 * w->capacity + size;
+    long int *ids = (long int*)realloc(w->ids, capacity * sizeof(long int));
+    igraph_real_t *scores;
+    if (ids)
+      w->ids = ids;
+    scores = ids ? (igraph_real_t*)realloc(w->scores, capacity * sizeof(igraph_real_t)) : 0;
+    if (scores)
+      w->scores = scores;
+    if (!ids || !scores) {
+      w->failed = 1;
+      size = 0;
+    } else {
+      w->capacity = capacity;
+    }
+  }
+
+  /* Popping the least similar candidate repeatedly fills the list from
+   * its end */
+  job->starts[s] = w->size;
+  job->counts[s] = size;
+  w->size += size;
+  while (size > 0) {
+    x = w->heap[0];
+    w->ids[job->starts[s] + size - 1] = x;
+    w->scores[job->starts[s] + size - 1] = w->acc[x];
+    w->heap[0] = w->heap[--size];
+    igraphmodule_i_similarity_sift_down(w->acc, w->heap, size, 0);
+  }
+
+  for (i = 0; i < no_of_touched; i++) {
+    x = w->touched[i];
+    w->acc[x] = 0;
+    w->seen[x] = 0;
+  }
+}
+
+static void igraphmodule_i_similarity_work(void *workers, long int index) {
+  igraphmodule_i_similarity_worker_t *w =
+    &((igraphmodule_i_similarity_worker_t*)workers)[index];
+  const igraphmodule_i_similarity_job_t *job = w->job;
+  long int s, n = igraph_vector_size(job->sources);
+
+  for (s = w->index; s < n && !w->failed; s += job->no_of_workers)
+    igraphmodule_i_similarity_source(w, s);
+}
+
+static void igraphmodule_i_similarity_workers_destroy(
+    igraphmodule_i_similarity_worker_t *workers, long int no_of_workers) {
+  long int i;
+
+  for (i = 0; workers && i < no_of_workers; i++) {
+    free(workers[i].acc);
+    free(workers[i].seen);
+    free(workers[i].touched);
+    free(workers[i].heap);
+    free(workers[i].ids);
+    free(workers[i].scores);
+  }
+  free(workers);
+}
+
+/**
+ * \ingroup python_interface_similarity
+ * \brief Calculates the most similar vertices of some source vertices
+ *
+ * The Jaccard and Dice similarities compare the neighbor sets of the
+ * vertices, ignoring multiple and loop edges like their dense counterparts
+ * in the C core. The inverse log-weighted similarity counts the common
+ * neighbors with multiplicity, each weighted by the inverse of the
+ * logarithm of its degree as in \c igraph_similarity_inverse_log_weighted().
+ * Only vertices with positive similarity are listed, most similar first
+ * (ties broken by the vertex IDs), and a source never lists itself.
+ *
+ * \param adj the adjacency lists in the requested direction
+ * \param rev the adjacency lists in the opposite direction; the same as
+ *        \c adj for \c IGRAPH_ALL and in undirected graphs
+ * \param type the similarity measure
+ * \param loops whether every vertex is considered its own neighbor (only
+ *        for the Jaccard and Dice similarities)
+ * \param sources the source vertices
+ * \param top_k the maximum number of vertices listed for a source, zero
+ *        means no limit
+ * \param threshold vertices less similar than this are not listed
+ * \param threads the number of threads to use
+ * \param offsets initialized vector, the result of source \c s will be
+ *        <tt>ids[offsets[s]]</tt> to <tt>ids[offsets[s+1]-1]</tt>
+ * \param ids initialized vector, the IDs of the similar vertices
+ * \param scores initialized vector, the similarities matching \c ids
+ * \return \c IGRAPH_SUCCESS or \c IGRAPH_ENOMEM
+ */
+int igraphmodule_similarity_sparse(const igraphmodule_adjacency_t *adj,
+    const igraphmodule_adjacency_t *rev, igraphmodule_similarity_t type,
+    igraph_bool_t loops, const igraph_vector_t *sources, long int top_k,
+    igraph_real_t threshold, long int threads, igraph_vector_long_t *offsets,
+    igraph_vector_long_t *ids, igraph_vector_t *scores) {
+  igraphmodule_i_similarity_job_t job;
+  igraphmodule_i_similarity_worker_t *workers = 0, *w;
+  long int n = adj->no_of_nodes, no_of_sources = igraph_vector_size(sources);
+  long int i, j, v, prev, total, heap_size;
+  int retval = 0;
+
+  if (igraph_vector_long_resize(offsets, no_of_sources + 1))
+    return IGRAPH_ENOMEM;
+  igraph_vector_long_null(offsets);
+  igraph_vector_long_clear(ids);
+  igraph_vector_clear(scores);
+  if (no_of_sources == 0 || n == 0)
+    return IGRAPH_SUCCESS;
+
+  memset(&job, 0, sizeof(job));
+  job.no_of_nodes = n;
+  job.adj = adj;
+  job.rev = rev;
+  job.type = type;
+  job.loops = loops;
+  job.sources = sources;
+  job.top_k = top_k;
+  job.threshold = threshold;
+
+  job.starts = (long int*)calloc(no_of_sources, sizeof(long int));
+  job.counts = (long int*)calloc(no_of_sources, sizeof(long int));
+  if (type == IGRAPHMODULE_SIMILARITY_INVERSE_LOG_WEIGHTED)
+    job.weights = (igraph_real_t*)calloc(n, sizeof(igraph_real_t));
+  else
+    job.sizes = (igraph_real_t*)calloc(n, sizeof(igraph_real_t));
+  if (!job.starts || !job.counts || (!job.weights && !job.sizes)) {
+    retval = IGRAPH_ENOMEM;
+    goto cleanup;
+  }
+
+  if (job.weights) {
+    /* The degrees count loop edges twice, vertices with degree 1 get
+     * weight 1 */
+    for (v = 0; v < n; v++) {
+      job.weights[v] = IGRAPHMODULE_ADJACENCY_DEGREE(rev, v);
+      if (job.weights[v] > 1)
+        job.weights[v] = 1.0 / log(job.weights[v]);
+    }
+  } else {
+    for (v = 0; v < n; v++) {
+      for (prev = -1, j = adj->offsets[v]; j < adj->offsets[v + 1]; j++) {
+        if (adj->neighbors[j] != prev && adj->neighbors[j] != v)
+          job.sizes[v]++;
+        prev = adj->neighbors[j];
+      }
+      if (loops)
+        job.sizes[v]++;
+    }
+  }
+
+  if (threads > no_of_sources)
+    threads = no_of_sources;
+  if (threads < 1)
+    threads = 1;
+  job.no_of_workers = threads;
+  heap_size = top_k > 0 && top_k < n ? top_k : n;
+
+  workers = (igraphmodule_i_similarity_worker_t*)calloc(threads,
+      sizeof(igraphmodule_i_similarity_worker_t));
+  if (!workers) {
+    retval = IGRAPH_ENOMEM;
+    goto cleanup;
+  }
+
+  for (i = 0; i < threads; i++) {
+    w = &workers[i];
+    w->job = &job;
+    w->index = i;
+    w->acc = (igraph_real_t*)calloc(n, sizeof(igraph_real_t));
+    w->seen = (char*)calloc(n, sizeof(char));
+    w->touched = (long int*)calloc(n, sizeof(long int));
+    w->heap = (long int*)calloc(heap_size, sizeof(long int));
+    if (!w->acc || !w->seen || !w->touched || !w->heap) {
+      retval = IGRAPH_ENOMEM;
+      goto cleanup;
+    }
+  }
+
+  igraphmodule_run_workers(igraphmodule_i_similarity_work, workers, threads, threads);
+
+  for (i = 0; i < threads; i++) {
+    if (workers[i].failed) {
+      retval = IGRAPH_ENOMEM;
+      goto cleanup;
+    }
+  }
+
+  /* Gather the results of the workers in the order of the sources */
+  for (total = 0, i = 0; i < no_of_sources; i++) {
+    VECTOR(*offsets)[i] = total;
+    total += job.counts[i];
+  }
+  VECTOR(*offsets)[no_of_sources] = total;
+  if (igraph_vector_long_resize(ids, total) || igraph_vector_resize(scores, total)) {
+    retval = IGRAPH_ENOMEM;
+    goto cleanup;
+  }
+  for (i = 0; i < no_of_sources; i++) {
+    if (job.counts[i] == 0)
+      continue;
+    w = &workers[i % threads];
+    memcpy(&VECTOR(*ids)[VECTOR(*offsets)[i]], w->ids + job.starts[i],
+        job.counts[i] * sizeof(long int));
+    memcpy(&VECTOR(*scores)[VECTOR(*offsets)[i]], w->scores + job.starts[i],
+        job.counts[i] * sizeof(igraph_real_t));
+  }
+
+cleanup:
+  igraphmodule_i_similarity_workers_destroy(workers, threads);
+  free(job.starts);
+  free(job.counts);
+  free(job.sizes);
+  free(job.weights);
+
+  return retval;
+}
@@ -0,0 +1,61 @@
+/* -*- mode: C -*-  */
+/* vim:set ts=2 sw=2 sts=2 et: */
+/* 
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+   
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+   
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+   
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+   02110-1301 USA
+
+*/
+
+#include "py2compat.h"
+
+#ifndef PYTHON_SIMILARITY_H
+#define PYTHON_SIMILARITY_H
+
+#include <Python.h>
+#include <igraph.h>
+#include "adjacency.h"
+
+/**
+ * \ingroup python_interface
+ * \defgroup python_interface_similarity Sparse vertex similarities
+ *
+ * Jaccard, Dice and inverse log-weighted similarities of vertices, listing
+ * only the most similar vertices of each source vertex instead of a dense
+ * matrix. The vertices similar to a source are found by enumerating the
+ * neighbors of its neighbors in the (sorted) cached adjacency lists, so
+ * the cost of a source depends on the size of its two-hop neighborhood
+ * instead of the number of vertices. The sources are distributed among
+ * several threads, each of them with an accumulator and a bounded heap of
+ * its own. The functions below do not touch Python objects and do not
+ * use the error handling of the C core, so they can be called without
+ * holding the GIL.
+ */
+
+typedef enum {
+  IGRAPHMODULE_SIMILARITY_JACCARD = 0,
+  IGRAPHMODULE_SIMILARITY_DICE,
+  IGRAPHMODULE_SIMILARITY_INVERSE_LOG_WEIGHTED
+} igraphmodule_similarity_t;
+
+int igraphmodule_similarity_sparse(const igraphmodule_adjacency_t *adj,
+    const igraphmodule_adjacency_t *rev, igraphmodule_similarity_t type,
+    igraph_bool_t loops, const igraph_vector_t *sources, long int top_k,
+    igraph_real_t threshold, long int threads, igraph_vector_long_t *offsets,
+    igraph_vector_long_t *ids, igraph_vector_t *scores);
+
+#endif
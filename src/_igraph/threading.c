@@ -0,0 +1,298 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#include "threading.h"
+#include "profiling.h"
+#include "py2compat.h"
+#include <pythread.h>
+#include <stdlib.h>
+
+/**
+ * \ingroup python_interface_threading
+ * \brief Whether the heavy methods should release the GIL.
+ *
+ * Always zero with the C core bundled with python-igraph, which is built
+ * without thread-local storage; see \ref igraphmodule_set_gil_release().
+ */
+static int igraphmodule_release_gil = IGRAPHMODULE_CORE_IS_THREAD_SAFE;
+
+/**
+ * \ingroup python_interface_threading
+ * \brief Marks the graph as busy and releases the GIL if enabled.
+ *
+ * Must be called with the GIL held.
+ *
+ * \return the saved thread state that must be passed on to
+ *         \ref igraphmodule_end_nogil(), or \c NULL if the GIL was not
+ *         released.
+ */
+PyThreadState* igraphmodule_begin_nogil(igraphmodule_GraphObject* self) {
+  PyThreadState* tstate;
+
+  if (self) {
+    self->busy++;
+  }
+
+  if (!igraphmodule_release_gil) {
+    tstate = 0;
+  } else {
+    tstate = PyEval_SaveThread();
+  }
+
+  /* Time spent waiting for the GIL is not core time */
+  if (igraphmodule_profiling_enabled) {
+    igraphmodule_profile_core_begin();
+  }
+
+  return tstate;
+}
+
+/**
+ * \ingroup python_interface_threading
+ * \brief Re-acquires the GIL if needed and clears the busy flag of the graph.
+ */
+void igraphmodule_end_nogil(igraphmodule_GraphObject* self, PyThreadState* tstate) {
+  if (igraphmodule_profiling_enabled) {
+    igraphmodule_profile_core_end();
+  }
+
+  if (tstate) {
+    PyEval_RestoreThread(tstate);
+  }
+
+  if (self) {
+    self->busy--;
+  }
+}
+
+/**
+ * \ingroup python_interface_threading
+ * \brief Releases the GIL unconditionally while waiting for C core code
+ *        running in a thread of our own.
+ *
+ * Unlike \ref igraphmodule_begin_nogil(), the GIL is released even if the
+ * heavy methods are configured to keep it, since the other thread may need
+ * it to report errors or to call Python callbacks.
+ */
+PyThreadState* igraphmodule_begin_wait(void) {
+  PyThreadState* tstate = PyEval_SaveThread();
+
+  if (igraphmodule_profiling_enabled) {
+    igraphmodule_profile_core_begin();
+  }
+
+  return tstate;
+}
+
+/**
+ * \ingroup python_interface_threading
+ * \brief Re-acquires the GIL after \ref igraphmodule_begin_wait()
+ */
+void igraphmodule_end_wait(PyThreadState* tstate) {
+  if (igraphmodule_profiling_enabled) {
+    igraphmodule_profile_core_end();
+  }
+
+  PyEval_RestoreThread(tstate);
+}
+
+/**
+ * \ingroup python_interface_threading
+ * \brief A thread started by \ref igraphmodule_run_workers()
+ */
+typedef struct {
+  igraphmodule_worker_func_t *func;
+  void *jobs;
+  // The thread runs jobs first, first+step, first+2*step and so on below n
+  long int first;
+  long int step;
+  long int n;
+  // Held while the thread is running
+  PyThread_type_lock done;
+  igraph_bool_t started;
+} igraphmodule_i_worker_thread_t;
+
+static void igraphmodule_i_worker_thread_run(igraphmodule_i_worker_thread_t *thread) {
+  long int i;
+
+  for (i = thread->first; i < thread->n; i += thread->step) {
+    thread->func(thread->jobs, i);
+  }
+}
+
+static void igraphmodule_i_worker_thread(void *arg) {
+  igraphmodule_i_worker_thread_t *thread = (igraphmodule_i_worker_thread_t*)arg;
+  igraphmodule_i_worker_thread_run(thread);
+  PyThread_release_lock(thread->done);
+}
+
+/**
+ * \ingroup python_interface_threading
+ * \brief Runs \c n jobs on at most the given number of threads and waits
+ *        for all of them to finish.
+ *
+ * The calling thread takes part in the work. Thread \em t runs jobs
+ * \em t, \em t+k, \em t+2k and so on, where \em k is the number of
+ * threads. The jobs of threads that cannot be started (for lack of memory
+ * or because the system refuses to) are run in the calling thread, so all
+ * the jobs are always carried out.
+ *
+ * Neither this function nor the threads touch the Python API, so it may be
+ * called with or without the GIL. Jobs that need the GIL (for instance to
+ * report errors of the C core) must acquire it on their own, in which case
+ * the caller must release it before calling this function.
+ */
+void igraphmodule_run_workers(igraphmodule_worker_func_t *func, void *jobs,
+    long int n, long int threads) {
+  igraphmodule_i_worker_thread_t *thr = 0;
+  long int i;
+
+  if (threads > n) {
+    threads = n;
+  }
+  if (threads > 1) {
+    thr = (igraphmodule_i_worker_thread_t*)calloc(threads,
+        sizeof(igraphmodule_i_worker_thread_t));
+  }
+  if (thr == 0) {
+    for (i = 0; i < n; i++) {
+      func(jobs, i);
+    }
+    return;
+  }
+
+  for (i = 0; i < threads; i++) {
+    thr[i].func = func;
+    thr[i].jobs = jobs;
+    thr[i].first = i;
+    thr[i].step = threads;
+    thr[i].n = n;
+  }
+
+  for (i = 1; i < threads; i++) {
+    thr[i].done = PyThread_allocate_lock();
+    if (thr[i].done == 0) {
+      continue;
+    }
+    PyThread_acquire_lock(thr[i].done, WAIT_LOCK);
+    if (PyThread_start_new_thread(igraphmodule_i_worker_thread, &thr[i]) ==
+        (unsigned long)-1) {
+      PyThread_release_lock(thr[i].done);
+    } else {
+      thr[i].started = 1;
+    }
+  }
+
+  for (i = 0; i < threads; i++) {
+    if (!thr[i].started) {
+      igraphmodule_i_worker_thread_run(&thr[i]);
+    }
+  }
+
+  for (i = 1; i < threads; i++) {
+    if (thr[i].started) {
+      PyThread_acquire_lock(thr[i].done, WAIT_LOCK);
+      PyThread_release_lock(thr[i].done);
+    }
+    if (thr[i].done) {
+      PyThread_free_lock(thr[i].done);
+    }
+  }
+
+  free(thr);
+}
+
+/**
+ * \ingroup python_interface_threading
+ * \brief Checks whether the graph may be modified.
+ *
+ * \return 1 if the graph is not used by a running computation (in another
+ *         thread, or in the current one if it is modified from a callback
+ *         of the computation) and it is not a read-only snapshot, 0
+ *         otherwise. In the latter case, a Python exception is also raised.
+ */
+int igraphmodule_Graph_check_not_busy(igraphmodule_GraphObject* self) {
+  if (self->snapshot != NULL) {
+    PyErr_SetString(PyExc_TypeError, "graph is a read-only snapshot and "
+        "cannot be modified; use copy() to obtain a modifiable graph");
+    return 0;
+  }
+  if (self->busy > 0) {
+    PyErr_SetString(PyExc_RuntimeError, "graph is in use by a running computation");
+    return 0;
+  }
+  return 1;
+}
+
+/**
+ * \ingroup python_interface_threading
+ * \brief Initializes the threading support of the module.
+ *
+ * \return 0 if everything was OK, 1 otherwise
+ */
+int igraphmodule_init_threading(void) {
+#if PY_VERSION_HEX < 0x03070000
+  PyEval_InitThreads();
+#endif
+  return 0;
+}
+
+/**
+ * \ingroup python_interface_threading
+ * \brief Enables or disables releasing the GIL in the heavy methods.
+ *
+ * Releasing the GIL is refused if the C core is not thread-safe: a core
+ * call made by another Python thread in the meanwhile would share the
+ * \c IGRAPH_FINALLY stack with the running computation.
+ */
+PyObject* igraphmodule_set_gil_release(PyObject* self, PyObject* o) {
+  int enabled = PyObject_IsTrue(o);
+
+  if (enabled < 0) {
+    return NULL;
+  }
+
+  if (enabled && !IGRAPHMODULE_CORE_IS_THREAD_SAFE) {
+    PyErr_SetString(PyExc_RuntimeError, "the C core of igraph was compiled "
+        "without thread-local storage and cannot run without the global "
+        "interpreter lock");
+    return NULL;
+  }
+
+  igraphmodule_release_gil = enabled;
+
+  Py_RETURN_NONE;
+}
+
+/**
+ * \ingroup python_interface_threading
+ * \brief Returns whether the heavy methods release the GIL.
+ */
+PyObject* igraphmodule_get_gil_release(PyObject* self) {
+  if (igraphmodule_release_gil) {
+    Py_RETURN_TRUE;
+  } else {
+    Py_RETURN_FALSE;
+  }
+}
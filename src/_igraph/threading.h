@@ -0,0 +1,140 @@
+/* -*- mode: C -*-  */
+/* vim: set ts=2 sw=2 sts=2 et: */
+
+/*
+   IGraph library.
+   Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA
+   02110-1301 USA
+
+*/
+
+#ifndef PYTHON_THREADING_H
+#define PYTHON_THREADING_H
+
+#include <Python.h>
+#include <igraph_threading.h>
+#include "graphobject.h"
+
+/** \defgroup python_interface_threading Releasing the GIL
+ * \ingroup python_interface */
+
+/**
+ * \ingroup python_interface_threading
+ * \brief Whether the C core was compiled with thread-local storage.
+ *
+ * When it was not, the error handling machinery of the C core (most notably
+ * the \c IGRAPH_FINALLY stack) is shared between all threads, therefore two
+ * C core calls must never run at the same time.
+ */
+#if defined(IGRAPH_THREAD_SAFE) && IGRAPH_THREAD_SAFE
+#  define IGRAPHMODULE_CORE_IS_THREAD_SAFE 1
+#else
+#  define IGRAPHMODULE_CORE_IS_THREAD_SAFE 0
+#endif
+
+/**
+ * \ingroup python_interface_threading
+ * \brief Storage class specifier of thread-local variables.
+ *
+ * Falls back to ordinary static storage if the compiler does not support
+ * thread-local variables; everything built on top of it then becomes
+ * process-wide instead of per-thread.
+ */
+#if defined(_MSC_VER)
+#  define IGRAPHMODULE_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#  define IGRAPHMODULE_THREAD_LOCAL __thread
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#  define IGRAPHMODULE_THREAD_LOCAL _Thread_local
+#else
+#  define IGRAPHMODULE_THREAD_LOCAL
+#endif
+
+/**
+ * \ingroup python_interface_threading
+ * \brief Lock-free loads and stores of \c int flags shared between threads.
+ *
+ * Used for flags that are set from one thread (with or without the GIL)
+ * and polled from C loops running in another one without the GIL.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#  define IGRAPHMODULE_ATOMIC_LOAD(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#  define IGRAPHMODULE_ATOMIC_STORE(ptr, value) \
+     __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#else
+/* volatile accesses of aligned ints have acquire/release semantics with
+ * MSVC on x86 and x64 */
+#  define IGRAPHMODULE_ATOMIC_LOAD(ptr) (*(volatile int*)(ptr))
+#  define IGRAPHMODULE_ATOMIC_STORE(ptr, value) \
+     (*(volatile int*)(ptr) = (value))
+#endif
+
+/**
+ * \ingroup python_interface_threading
+ * \brief Runs a block of C code without holding the global interpreter lock.
+ *
+ * The graph is marked as busy for the duration of the block so that other
+ * Python threads cannot modify it while the C core is working on it. Inputs
+ * must be converted \em before entering the block and Python objects must
+ * not be touched inside it; callbacks from the C core (progress, status,
+ * interruption, errors, warnings and attribute handlers) re-acquire the
+ * GIL on their own.
+ *
+ * The GIL is only released if the C core is thread-safe, which the core
+ * bundled with python-igraph is not; with that core the block merely marks
+ * the graph as busy.
+ *
+ * Usage:
+ *
+ * \verbatim
+IGRAPHMODULE_BEGIN_NOGIL(self);
+retval = igraph_something(&self->g, ...);
+IGRAPHMODULE_END_NOGIL(self);
+\endverbatim
+ */
+#define IGRAPHMODULE_BEGIN_NOGIL(self) { \
+  PyThreadState* __igraphmodule_tstate = igraphmodule_begin_nogil(self)
+#define IGRAPHMODULE_END_NOGIL(self) \
+  igraphmodule_end_nogil(self, __igraphmodule_tstate); \
+}
+
+PyThreadState* igraphmodule_begin_nogil(igraphmodule_GraphObject* self);
+void igraphmodule_end_nogil(igraphmodule_GraphObject* self, PyThreadState* tstate);
+
+PyThreadState* igraphmodule_begin_wait(void);
+void igraphmodule_end_wait(PyThreadState* tstate);
+
+/**
+ * \ingroup python_interface_threading
+ * \brief Function carrying out a job of \ref igraphmodule_run_workers()
+ *
+ * \param jobs  the pointer passed to \ref igraphmodule_run_workers(),
+ *              typically an array with one workspace per job
+ * \param index the index of the job
+ */
+typedef void igraphmodule_worker_func_t(void *jobs, long int index);
+
+void igraphmodule_run_workers(igraphmodule_worker_func_t *func, void *jobs,
+    long int n, long int threads);
+
+int igraphmodule_Graph_check_not_busy(igraphmodule_GraphObject* self);
+
+int igraphmodule_init_threading(void);
+PyObject* igraphmodule_set_gil_release(PyObject* self, PyObject* o);
+PyObject* igraphmodule_get_gil_release(PyObject* self);
+
+#endif
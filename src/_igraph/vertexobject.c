@@ -23,6 +23,7 @@
 */
 
 #include "attributes.h"
+#include "columnobject.h"
 #include "convert.h"
 #include "edgeobject.h"
 #include "error.h"
@@ -37,6 +38,21 @@
 
 PyTypeObject igraphmodule_VertexType;
 
+/**
+ * \ingroup python_interface_vertex
+ * \brief Vertex objects released recently, kept for reuse
+ *
+ * Python code creates and releases Vertex objects at a high rate (indexing
+ * and iterating over vertex sequences, searches, selections with callables),
+ * so instead of returning them to the allocator, a limited number of them
+ * are kept here and recycled by \c igraphmodule_Vertex_New(). They are not
+ * tracked by the garbage collector as they only reference their graph.
+ * The list is protected by the GIL.
+ */
+#define IGRAPHMODULE_VERTEX_FREELIST_MAX_SIZE 256
+static igraphmodule_VertexObject* igraphmodule_i_vertex_freelist[IGRAPHMODULE_VERTEX_FREELIST_MAX_SIZE];
+static int igraphmodule_i_vertex_freelist_size = 0;
+
 /**
  * \ingroup python_interface_vertex
  * \brief Checks whether the given Python object is a vertex
@@ -101,7 +117,12 @@ int igraphmodule_Vertex_Validate(PyObject* obj) {
  */
 PyObject* igraphmodule_Vertex_New(igraphmodule_GraphObject *gref, igraph_integer_t idx) {
   igraphmodule_VertexObject* self;
-  self=PyObject_New(igraphmodule_VertexObject, &igraphmodule_VertexType);
+  if (igraphmodule_i_vertex_freelist_size > 0) {
+    self = igraphmodule_i_vertex_freelist[--igraphmodule_i_vertex_freelist_size];
+    (void) PyObject_INIT(self, &igraphmodule_VertexType);
+  } else {
+    self=PyObject_New(igraphmodule_VertexObject, &igraphmodule_VertexType);
+  }
   if (self) {
     RC_ALLOC("Vertex", self);
     Py_INCREF(gref);
@@ -135,9 +156,25 @@ void igraphmodule_Vertex_dealloc(igraphmodule_VertexObject* self) {
 
   RC_DEALLOC("Vertex", self);
 
+  /* Instances of subclasses are larger, they cannot be recycled */
+  if (Py_TYPE(self) == &igraphmodule_VertexType &&
+      igraphmodule_i_vertex_freelist_size < IGRAPHMODULE_VERTEX_FREELIST_MAX_SIZE) {
+    igraphmodule_i_vertex_freelist[igraphmodule_i_vertex_freelist_size++] = self;
+    return;
+  }
+
   PyObject_Del((PyObject*)self);
 }
 
+/**
+ * \ingroup python_interface_vertex
+ * \brief Releases the memory of the vertex objects kept for reuse
+ */
+void igraphmodule_Vertex_clear_freelist(void) {
+  while (igraphmodule_i_vertex_freelist_size > 0)
+    PyObject_Del((PyObject*)igraphmodule_i_vertex_freelist[--igraphmodule_i_vertex_freelist_size]);
+}
+
 /** \ingroup python_interface_vertex
  * \brief Formats an \c igraph.Vertex object to a string
  * 
@@ -299,10 +336,10 @@ PyObject* igraphmodule_Vertex_attributes(igraphmodule_VertexObject* self) {
       PyObject *dictit;
       dictit = PyDict_GetItem(((PyObject**)o->g.attr)[ATTRHASH_IDX_VERTEX], name);
       if (dictit) {
-        PyObject *value = PyList_GetItem(dictit, self->idx);
+        PyObject *value = igraphmodule_attribute_values_get_item(dictit, self->idx);
         if (value) {
-          /* No need to Py_INCREF, PyDict_SetItem will do that */
           PyDict_SetItem(dict, name, value);
+          Py_DECREF(value);
         }
       }
     }
@@ -471,14 +508,13 @@ PyObject* igraphmodule_Vertex_get_attribute(igraphmodule_VertexObject* self,
 
   result=PyDict_GetItem(((PyObject**)o->g.attr)[ATTRHASH_IDX_VERTEX], s);
   if (result) {
-    /* result is a list, so get the element with index self->idx */
-    if (!PyList_Check(result)) {
+    /* result is a list or a typed column, so get the element with index
+     * self->idx */
+    if (!PyList_Check(result) && !igraphmodule_Column_Check(result)) {
       PyErr_SetString(igraphmodule_InternalError, "Vertex attribute dict member is not a list");
       return NULL;
     }
-    result=PyList_GetItem(result, self->idx);
-    Py_INCREF(result);
-    return result;
+    return igraphmodule_attribute_values_get_item(result, self->idx);
   }
   
   /* result is NULL, check whether there was an error */
@@ -498,6 +534,7 @@ int igraphmodule_Vertex_set_attribute(igraphmodule_VertexObject* self, PyObject*
   igraphmodule_GraphObject *o=self->gref;
   PyObject* result;
   int r;
+  igraph_bool_t is_name;
   
   if (!igraphmodule_Vertex_Validate((PyObject*)self))
     return -1;
@@ -505,17 +542,32 @@ int igraphmodule_Vertex_set_attribute(igraphmodule_VertexObject* self, PyObject*
   if (!igraphmodule_attribute_name_check(k))
     return -1;
 
-  if (PyString_IsEqualToASCIIString(k, "name"))
-    igraphmodule_invalidate_vertex_name_index(&o->g);
+  is_name = PyString_IsEqualToASCIIString(k, "name");
 
-  if (v==NULL)
+  if (v==NULL) {
     // we are deleting attribute
+    if (is_name)
+      igraphmodule_invalidate_vertex_name_index(&o->g);
     return PyDict_DelItem(((PyObject**)o->g.attr)[ATTRHASH_IDX_VERTEX], k);
+  }
   
   result=PyDict_GetItem(((PyObject**)o->g.attr)[ATTRHASH_IDX_VERTEX], k);
-  if (result) {
-    /* result is a list, so set the element with index self->idx */
-    if (!PyList_Check(result)) {
+  if (result && is_name && PyList_Check(result)) {
+    /* Renaming a single vertex updates the vertex name index incrementally */
+    PyObject *old_name = PyList_GetItem(result, self->idx);
+    if (old_name == 0)
+      return -1;
+    Py_INCREF(old_name);
+    Py_INCREF(v);
+    r=PyList_SetItem(result, self->idx, v);
+    if (r == 0)
+      igraphmodule_update_vertex_name_index(&o->g, self->idx, old_name, v);
+    Py_DECREF(old_name);
+    return r;
+  } else if (result) {
+    /* result is a list or a typed column, so set the element with index
+     * self->idx */
+    if (!PyList_Check(result) && !igraphmodule_Column_Check(result)) {
       PyErr_SetString(igraphmodule_InternalError, "Vertex attribute dict member is not a list");
       return -1;
     }
@@ -523,8 +575,8 @@ int igraphmodule_Vertex_set_attribute(igraphmodule_VertexObject* self, PyObject*
      * its reference count, because PyList_SetItem will "steal" a reference!
      * It took me 1.5 hours between London and Manchester to figure it out */
     Py_INCREF(v);
-    r=PyList_SetItem(result, self->idx, v);
-    if (r == -1) { Py_DECREF(v); }
+    r=igraphmodule_attribute_values_set_item(((PyObject**)o->g.attr)[ATTRHASH_IDX_VERTEX], k,
+        &result, self->idx, v);
     return r;
   }
   
@@ -532,6 +584,8 @@ int igraphmodule_Vertex_set_attribute(igraphmodule_VertexObject* self, PyObject*
   if (!PyErr_Occurred()) {
     /* no, there wasn't, so we must simply add the attribute */
     int n=(int)igraph_vcount(&o->g), i;
+    if (is_name)
+      igraphmodule_invalidate_vertex_name_index(&o->g);
     result=PyList_New(n);
     for (i=0; i<n; i++) {
       if (i != self->idx) {
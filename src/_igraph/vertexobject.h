@@ -41,6 +41,7 @@ typedef struct
 
 int igraphmodule_Vertex_clear(igraphmodule_VertexObject *self);
 void igraphmodule_Vertex_dealloc(igraphmodule_VertexObject* self);
+void igraphmodule_Vertex_clear_freelist(void);
 
 int igraphmodule_Vertex_Check(PyObject *obj);
 int igraphmodule_Vertex_Validate(PyObject *obj);
@@ -24,6 +24,7 @@
 
 #include <Python.h>
 #include "attributes.h"
+#include "columnobject.h"
 #include "common.h"
 #include "convert.h"
 #include "error.h"
@@ -182,15 +183,14 @@ int igraphmodule_VertexSeq_sq_length(igraphmodule_VertexSeqObject* self) {
 
 /**
  * \ingroup python_interface_vertexseq
- * \brief Returns the item at the given index in the sequence
+ * \brief Returns the ID of the vertex at the given index in the sequence,
+ *        or -1 if the index is out of range
  */
-PyObject* igraphmodule_VertexSeq_sq_item(igraphmodule_VertexSeqObject* self,
-                     Py_ssize_t i) {
-  igraph_t *g;
+static igraph_integer_t igraphmodule_i_VertexSeq_index(
+    igraphmodule_VertexSeqObject* self, Py_ssize_t i) {
+  igraph_t *g=&GET_GRAPH(self);
   igraph_integer_t idx = -1;
 
-  if (!self->gref) return NULL;
-  g=&GET_GRAPH(self);
   switch (igraph_vs_type(&self->vs)) {
     case IGRAPH_VS_ALL:
       if (i < 0) {
@@ -226,6 +226,19 @@ PyObject* igraphmodule_VertexSeq_sq_item(igraphmodule_VertexSeqObject* self,
        yet in the Python interface */
   }
 
+  return idx;
+}
+
+/**
+ * \ingroup python_interface_vertexseq
+ * \brief Returns the item at the given index in the sequence
+ */
+PyObject* igraphmodule_VertexSeq_sq_item(igraphmodule_VertexSeqObject* self,
+                     Py_ssize_t i) {
+  igraph_integer_t idx;
+
+  if (!self->gref) return NULL;
+  idx = igraphmodule_i_VertexSeq_index(self, i);
   if (idx < 0) {
     PyErr_SetString(PyExc_IndexError, "vertex index out of range");
     return NULL;
@@ -266,15 +279,7 @@ PyObject* igraphmodule_VertexSeq_get_attribute_values(igraphmodule_VertexSeqObje
       break;
 
     case IGRAPH_VS_ALL:
-      n = PyList_Size(values);
-      result = PyList_New(n);
-      if (!result) return 0;
-
-      for (i=0; i<n; i++) {
-        item = PyList_GET_ITEM(values, i);
-        Py_INCREF(item);
-        PyList_SET_ITEM(result, i, item);
-      }
+      result = igraphmodule_attribute_values_to_list(values);
       break;
 
     case IGRAPH_VS_VECTOR:
@@ -284,8 +289,12 @@ PyObject* igraphmodule_VertexSeq_get_attribute_values(igraphmodule_VertexSeqObje
       if (!result) return 0;
 
       for (i=0; i<n; i++) {
-        item = PyList_GET_ITEM(values, (long)VECTOR(*self->vs.data.vecptr)[i]);
-        Py_INCREF(item);
+        item = igraphmodule_attribute_values_get_item(values,
+            (long)VECTOR(*self->vs.data.vecptr)[i]);
+        if (!item) {
+          Py_DECREF(result);
+          return 0;
+        }
         PyList_SET_ITEM(result, i, item);
       }
       break;
@@ -296,8 +305,12 @@ PyObject* igraphmodule_VertexSeq_get_attribute_values(igraphmodule_VertexSeqObje
       if (!result) return 0;
 
       for (i=0; i<n; i++) {
-        item = PyList_GET_ITEM(values, (long)self->vs.data.seq.from+i);
-        Py_INCREF(item);
+        item = igraphmodule_attribute_values_get_item(values,
+            (long)self->vs.data.seq.from+i);
+        if (!item) {
+          Py_DECREF(result);
+          return 0;
+        }
         PyList_SET_ITEM(result, i, item);
       }
       break;
@@ -309,6 +322,50 @@ PyObject* igraphmodule_VertexSeq_get_attribute_values(igraphmodule_VertexSeqObje
   return result;
 }
 
+/** \ingroup python_interface_vertexseq
+ * \brief Returns the typed column storing a given attribute, converting the
+ *        attribute to a typed column first if needed
+ */
+PyObject* igraphmodule_VertexSeq_get_attribute_column(igraphmodule_VertexSeqObject* self, PyObject* o) {
+  igraphmodule_GraphObject *gr = self->gref;
+  PyObject *dict, *values, *column;
+
+  if (!igraphmodule_attribute_name_check(o))
+    return 0;
+
+  if (PyString_IsEqualToASCIIString(o, "name")) {
+    PyErr_SetString(PyExc_ValueError, "the name attribute can not be stored in a typed column");
+    return NULL;
+  }
+
+  dict = ATTR_STRUCT_DICT(&gr->g)[ATTRHASH_IDX_VERTEX];
+  values = PyDict_GetItem(dict, o);
+  if (!values) {
+    PyErr_SetString(PyExc_KeyError, "Attribute does not exist");
+    return NULL;
+  }
+
+  if (igraphmodule_Column_Check(values)) {
+    Py_INCREF(values);
+    return values;
+  }
+
+  column = igraphmodule_Column_from_list(values);
+  if (!column) {
+    if (!PyErr_Occurred())
+      PyErr_SetString(PyExc_TypeError, "attribute values must be all "
+          "numbers, all booleans or None to be stored in a typed column");
+    return NULL;
+  }
+
+  if (PyDict_SetItem(dict, o, column)) {
+    Py_DECREF(column);
+    return NULL;
+  }
+
+  return column;
+}
+
 PyObject* igraphmodule_VertexSeq_get_attribute_values_mapping(igraphmodule_VertexSeqObject *self, PyObject *o) {
   long int index;
 
@@ -346,6 +403,7 @@ int igraphmodule_VertexSeq_set_attribute_values_mapping(igraphmodule_VertexSeqOb
   igraphmodule_GraphObject *gr;
   igraph_vector_t vs;
   long i, j, n, no_of_nodes;
+  igraph_bool_t is_name;
 
   gr = self->gref;
   dict = ATTR_STRUCT_DICT(&gr->g)[ATTRHASH_IDX_VERTEX];
@@ -353,7 +411,11 @@ int igraphmodule_VertexSeq_set_attribute_values_mapping(igraphmodule_VertexSeqOb
   if (!igraphmodule_attribute_name_check(attrname))
     return -1;
 
-  if (PyString_IsEqualToASCIIString(attrname, "name"))
+  /* Assigning the names of all the vertices invalidates the vertex name
+   * index; assigning the names of a subset of the vertices updates it
+   * incrementally (see below) */
+  is_name = PyString_IsEqualToASCIIString(attrname, "name");
+  if (is_name && (values == 0 || igraph_vs_type(&self->vs) == IGRAPH_VS_ALL))
     igraphmodule_invalidate_vertex_name_index(&gr->g);
 
   if (values == 0) {
@@ -363,6 +425,24 @@ int igraphmodule_VertexSeq_set_attribute_values_mapping(igraphmodule_VertexSeqOb
     return -1;
   }
 
+  if (igraph_vs_type(&self->vs) == IGRAPH_VS_ALL &&
+      !PyString_IsEqualToASCIIString(attrname, "name")) {
+    /* One-dimensional numeric buffers (e.g., NumPy arrays) spanning all the
+     * vertices are stored in a typed column instead of a list */
+    PyObject *column;
+    int retval = igraphmodule_Column_from_buffer(values, &column);
+    if (retval == 1)
+      return -1;
+    if (retval == 0) {
+      if (((igraphmodule_ColumnObject*)column)->size == (long)igraph_vcount(&gr->g)) {
+        retval = PyDict_SetItem(dict, attrname, column);
+        Py_DECREF(column);
+        return retval;
+      }
+      Py_DECREF(column);
+    }
+  }
+
  if (PyString_Check(values) || !PySequence_Check(values)) {
     /* If values is a string or not a sequence, we construct a list with a
      * single element (the value itself) and then call ourselves again */
@@ -386,8 +466,11 @@ int igraphmodule_VertexSeq_set_attribute_values_mapping(igraphmodule_VertexSeqOb
       return -1;
     }
 
-    /* Check if we already have attributes with the given name */
+    /* Check if we already have attributes with the given name. Typed columns
+     * are replaced with a list; the values may not fit into the column */
     list = PyDict_GetItem(dict, attrname);
+    if (list != 0 && igraphmodule_Column_Check(list))
+      list = 0;
     if (list != 0) {
       /* Yes, we have. Modify its items to the items found in values */
       for (i=0, j=0; i<no_of_nodes; i++, j++) {
@@ -442,21 +525,35 @@ int igraphmodule_VertexSeq_set_attribute_values_mapping(igraphmodule_VertexSeqOb
     if (list != 0) {
       /* Yes, we have. Modify its items to the items found in values */
       for (i=0, j=0; i<no_of_nodes; i++, j++) {
+        long vid = (long)VECTOR(vs)[i];
+        PyObject *old_name = 0;
         if (j == n) j = 0;
         item = PySequence_GetItem(values, j);
         if (item == 0) {
           igraph_vector_destroy(&vs);
           return -1;
         }
+        if (is_name) {
+          /* The name attribute is always stored in a list */
+          old_name = PyList_GetItem(list, vid);
+          Py_XINCREF(old_name);
+        }
         /* No need to Py_INCREF(item), PySequence_GetItem returns a new reference */
-        if (PyList_SetItem(list, (long)VECTOR(vs)[i], item)) {
-          Py_DECREF(item);
+        if (igraphmodule_attribute_values_set_item(dict, attrname, &list,
+              vid, item)) {
+          Py_XDECREF(old_name);
           igraph_vector_destroy(&vs);
           return -1;
-        } /* PyList_SetItem stole a reference to the item automatically */
+        } /* the reference to the item was stolen automatically */
+        if (old_name) {
+          igraphmodule_update_vertex_name_index(&gr->g, vid, old_name, item);
+          Py_DECREF(old_name);
+        }
       }
       igraph_vector_destroy(&vs);
     } else if (values != 0) {
+      if (is_name)
+        igraphmodule_invalidate_vertex_name_index(&gr->g);
       /* We don't have attributes with the given name yet. Create an entry
        * in the dict, create a new list, fill with None for vertices not in the
        * sequence and copy the rest */
@@ -822,6 +919,66 @@ PyObject* igraphmodule_VertexSeq_select(igraphmodule_VertexSeqObject *self,
   return (PyObject*)result;
 }
 
+/**
+ * \ingroup python_interface_vertexseq
+ * \brief Selects the vertices of the sequence whose attribute values match a
+ *        condition, e.g., <tt>age_gt=200</tt> in \c VertexSeq.select()
+ */
+PyObject* igraphmodule_VertexSeq_select_by_attribute(igraphmodule_VertexSeqObject *self,
+  PyObject *args) {
+  igraphmodule_VertexSeqObject *result;
+  igraphmodule_GraphObject *gr = self->gref;
+  PyObject *name, *op, *value, *values;
+  igraph_vector_t ids;
+
+  if (!PyArg_ParseTuple(args, "OOO", &name, &op, &value))
+    return NULL;
+
+  if (!igraphmodule_attribute_name_check(name))
+    return NULL;
+
+  values = PyDict_GetItem(ATTR_STRUCT_DICT(&gr->g)[ATTRHASH_IDX_VERTEX], name);
+  if (!values) {
+    PyErr_SetString(PyExc_KeyError, "Attribute does not exist");
+    return NULL;
+  }
+
+  if (igraph_vector_init(&ids, 0)) {
+    igraphmodule_handle_igraph_error();
+    return NULL;
+  }
+  if (igraph_vs_as_vector(&gr->g, self->vs, &ids)) {
+    igraphmodule_handle_igraph_error();
+    igraph_vector_destroy(&ids);
+    return NULL;
+  }
+
+  /* The values are evaluated on the current members of the sequence only,
+   * so chained filters narrow down the same index vector */
+  if (igraphmodule_attribute_values_filter(values, &ids, op, value)) {
+    igraph_vector_destroy(&ids);
+    return NULL;
+  }
+
+  result = igraphmodule_VertexSeq_copy(self);
+  if (result == 0) {
+    igraph_vector_destroy(&ids);
+    return NULL;
+  }
+
+  igraph_vs_destroy(&result->vs);
+  if (igraph_vs_vector_copy(&result->vs, &ids)) {
+    igraph_vs_none(&result->vs);
+    Py_DECREF(result);
+    igraphmodule_handle_igraph_error();
+    igraph_vector_destroy(&ids);
+    return NULL;
+  }
+  igraph_vector_destroy(&ids);
+
+  return (PyObject*)result;
+}
+
 /**
  * \ingroup python_interface_vertexseq
  * Converts a vertex sequence to an igraph vector containing the corresponding
@@ -892,6 +1049,106 @@ PyObject* igraphmodule_VertexSeq__reindex_names(igraphmodule_VertexSeqObject* se
   Py_RETURN_NONE;
 }
 
+/**
+ * \ingroup python_interface_vertexseq
+ * \brief Returns an iterator over the sequence that reuses a single
+ *   \c igraph.Vertex object in every step
+ */
+PyObject* igraphmodule_VertexSeq_cursor(igraphmodule_VertexSeqObject* self) {
+  igraphmodule_VertexSeqCursorObject* o;
+
+  if (!self->gref) {
+    PyErr_SetString(PyExc_ValueError, "vertex sequence has no graph");
+    return NULL;
+  }
+
+  o = PyObject_New(igraphmodule_VertexSeqCursorObject, &igraphmodule_VertexSeqCursorType);
+  if (o == 0)
+    return NULL;
+
+  Py_INCREF(self);
+  o->seq = self;
+  o->pos = 0;
+  o->vertex = 0;
+  RC_ALLOC("VertexSeqCursor", o);
+
+  return (PyObject*)o;
+}
+
+/**
+ * \ingroup python_interface_vertexseq
+ * \brief Deallocates a cursor over a vertex sequence
+ */
+void igraphmodule_VertexSeqCursor_dealloc(igraphmodule_VertexSeqCursorObject* self) {
+  Py_XDECREF(self->vertex);
+  Py_XDECREF(self->seq);
+  RC_DEALLOC("VertexSeqCursor", self);
+  PyObject_Del((PyObject*)self);
+}
+
+/**
+ * \ingroup python_interface_vertexseq
+ * \brief Moves the cursor to the next vertex of the sequence
+ *
+ * The vertex returned in the previous step is updated in place and
+ * returned again; a new vertex is created only in the first step.
+ */
+PyObject* igraphmodule_VertexSeqCursor_iternext(igraphmodule_VertexSeqCursorObject* self) {
+  igraph_integer_t idx;
+
+  idx = igraphmodule_i_VertexSeq_index(self->seq, self->pos);
+  if (idx < 0)
+    return NULL;
+  self->pos++;
+
+  if (self->vertex == 0) {
+    self->vertex = (igraphmodule_VertexObject*) igraphmodule_Vertex_New(self->seq->gref, idx);
+    if (self->vertex == 0)
+      return NULL;
+  } else {
+    self->vertex->idx = idx;
+    self->vertex->hash = -1;
+  }
+
+  Py_INCREF(self->vertex);
+  return (PyObject*)self->vertex;
+}
+
+/** \ingroup python_interface_vertexseq
+ * Python type object of the cursors returned by \c VertexSeq.cursor()
+ */
+PyTypeObject igraphmodule_VertexSeqCursorType =
+{
+  PyVarObject_HEAD_INIT(0, 0)
+  "igraph.core.VertexSeqCursor",              /* tp_name */
+  sizeof(igraphmodule_VertexSeqCursorObject), /* tp_basicsize */
+  0,                                          /* tp_itemsize */
+  (destructor)igraphmodule_VertexSeqCursor_dealloc, /* tp_dealloc */
+  0,                                          /* tp_print */
+  0,                                          /* tp_getattr */
+  0,                                          /* tp_setattr */
+  0,                                          /* tp_compare (2.x) / tp_reserved (3.x) */
+  0,                                          /* tp_repr */
+  0,                                          /* tp_as_number */
+  0,                                          /* tp_as_sequence */
+  0,                                          /* tp_as_mapping */
+  0,                                          /* tp_hash */
+  0,                                          /* tp_call */
+  0,                                          /* tp_str */
+  0,                                          /* tp_getattro */
+  0,                                          /* tp_setattro */
+  0,                                          /* tp_as_buffer */
+  Py_TPFLAGS_DEFAULT,                         /* tp_flags */
+  "Iterator over a vertex sequence that returns the same Vertex object in\n" /* tp_doc */
+  "every step. See L{VertexSeq.cursor()}.",
+  0,                                          /* tp_traverse */
+  0,                                          /* tp_clear */
+  0,                                          /* tp_richcompare */
+  0,                                          /* tp_weaklistoffset */
+  PyObject_SelfIter,                          /* tp_iter */
+  (iternextfunc)igraphmodule_VertexSeqCursor_iternext, /* tp_iternext */
+};
+
 /**
  * \ingroup python_interface_vertexseq
  * Method table for the \c igraph.VertexSeq object
@@ -902,11 +1159,35 @@ PyMethodDef igraphmodule_VertexSeq_methods[] = {
    "attribute_names() -> list\n\n"
    "Returns the attribute name list of the graph's vertices\n"
   },
+  {"cursor", (PyCFunction)igraphmodule_VertexSeq_cursor,
+   METH_NOARGS,
+   "cursor() -> iterator\n\n"
+   "Iterates over the vertices of the sequence like C{iter()}, but returns\n"
+   "the same L{Vertex} object in every step, changing only its index.\n\n"
+   "This avoids allocating a new vertex object in each step of long loops.\n"
+   "In exchange, the vertex returned in a step must not be stored or used\n"
+   "after the next step as it will refer to a different vertex by then.\n"
+  },
   {"find", (PyCFunction)igraphmodule_VertexSeq_find,
    METH_VARARGS,
    "find(condition) -> Vertex\n\n"
    "For internal use only.\n"
   },
+  {"get_attribute_column", (PyCFunction)igraphmodule_VertexSeq_get_attribute_column,
+   METH_O,
+   "get_attribute_column(attrname) -> AttributeColumn\n\n"
+   "Returns the typed column that stores the values of a given vertex\n"
+   "attribute for all vertices.\n\n"
+   "Numeric and boolean attributes may be stored in a contiguous typed\n"
+   "column instead of a list. Attributes assigned from one-dimensional\n"
+   "numeric buffers (e.g., NumPy arrays) are stored this way automatically;\n"
+   "this method converts attributes stored in a list on demand. The column\n"
+   "supports the buffer protocol, so it can be wrapped without copying,\n"
+   "e.g., by C{numpy.asarray()} or C{memoryview()}. The exported buffer is\n"
+   "read-only; assigning new values to the attribute works as usual.\n\n"
+   "@param attrname: the name of the attribute\n"
+   "@return: an L{AttributeColumn} object\n"
+  },
   {"get_attribute_values", (PyCFunction)igraphmodule_VertexSeq_get_attribute_values,
    METH_O,
    "get_attribute_values(attrname) -> list\n"
@@ -930,6 +1211,14 @@ PyMethodDef igraphmodule_VertexSeq_methods[] = {
    "select(...) -> VertexSeq\n\n"
    "For internal use only.\n"
   },
+  {"_select_by_attribute", (PyCFunction)igraphmodule_VertexSeq_select_by_attribute,
+   METH_VARARGS,
+   "_select_by_attribute(attrname, op, value) -> VertexSeq\n\n"
+   "Selects the vertices whose value of the given attribute satisfies\n"
+   "C{attrvalue op value}, where C{op} is one of C{\"lt\"}, C{\"le\"},\n"
+   "C{\"eq\"}, C{\"ne\"}, C{\"gt\"}, C{\"ge\"}, C{\"in\"} or C{\"notin\"}.\n\n"
+   "For internal use only; see L{VertexSeq.select()}.\n"
+  },
   {"_reindex_names", (PyCFunction)igraphmodule_VertexSeq__reindex_names, METH_NOARGS,
    "Re-creates the dictionary that maps vertex names to IDs.\n\n"
    "For internal use only.\n"
@@ -25,6 +25,7 @@
 
 #include <Python.h>
 #include "graphobject.h"
+#include "vertexobject.h"
 
 /**
  * \ingroup python_interface_vertexseq
@@ -37,6 +38,18 @@ typedef struct {
   PyObject* weakreflist;
 } igraphmodule_VertexSeqObject;
 
+/**
+ * \ingroup python_interface_vertexseq
+ * \brief An iterator over a vertex sequence that reuses a single vertex
+ *        object in every step
+ */
+typedef struct {
+  PyObject_HEAD
+  igraphmodule_VertexSeqObject* seq;
+  Py_ssize_t pos;
+  igraphmodule_VertexObject* vertex;
+} igraphmodule_VertexSeqCursorObject;
+
 PyObject* igraphmodule_VertexSeq_new(PyTypeObject *subtype,
   PyObject* args, PyObject* kwds);
 int igraphmodule_VertexSeq_init(igraphmodule_VertexSeqObject* self,
@@ -49,12 +62,16 @@ PyObject* igraphmodule_VertexSeq_find(igraphmodule_VertexSeqObject *self,
   PyObject *args);
 PyObject* igraphmodule_VertexSeq_select(igraphmodule_VertexSeqObject *self,
   PyObject *args);
+PyObject* igraphmodule_VertexSeq_select_by_attribute(igraphmodule_VertexSeqObject *self,
+  PyObject *args);
 
 int igraphmodule_VertexSeq_to_vector_t(igraphmodule_VertexSeqObject *self,
   igraph_vector_t *v);
 PyObject* igraphmodule_VertexSeq_get_graph(igraphmodule_VertexSeqObject *self,
   void* closure);
+PyObject* igraphmodule_VertexSeq_cursor(igraphmodule_VertexSeqObject *self);
 
 extern PyTypeObject igraphmodule_VertexSeqType;
+extern PyTypeObject igraphmodule_VertexSeqCursorType;
 
 #endif
@@ -42,9 +42,11 @@ from igraph.formula import *
 from igraph.layout import *
 from igraph.matching import *
 from igraph.operators import *
+from igraph.profiling import *
 from igraph.statistics import *
 from igraph.summary import *
 from igraph.utils import *
+from igraph.utils import _column_to_native
 from igraph.version import __version__, __version_info__
 
 import os
@@ -555,7 +557,7 @@ class Graph(GraphBase):
         return result
 
     def dyad_census(self, *args, **kwds):
-        """dyad_census()
+        """dyad_census(threads=None)
 
         Calculates the dyad census of the graph.
 
@@ -565,6 +567,8 @@ class Graph(GraphBase):
         from I{a} to I{b} or from I{b} to I{a} but not the other way round)
         and null (there is no connection between I{a} and I{b}).
 
+        @param threads: C{None} to use the C core, or the number of threads
+          that share the vertices of the graph.
         @return: a L{DyadCensus} object.
         @newfield ref: Reference
         @ref: Holland, P.W. and Leinhardt, S.  (1970).  A Method for Detecting
@@ -654,20 +658,21 @@ class Graph(GraphBase):
             raise ImportError('You should install scipy package in order to use this function')
         import numpy as np
 
-        edges = self.get_edgelist()
-        if attribute is None:
-            weights = [1] * len(edges)
-        else:
-            if attribute not in self.es.attribute_names():
-                raise ValueError("Attribute does not exist")
+        if attribute is not None and attribute not in self.es.attribute_names():
+            raise ValueError("Attribute does not exist")
 
-            weights = self.es[attribute]
+        indptr, indices, data = GraphBase.get_adjacency_arrays(self, "csr", attribute)
 
         N = self.vcount()
-        mtx = sparse.csr_matrix((weights, zip(*edges)), shape=(N, N))
+        mtx = sparse.csr_matrix(
+            (np.asarray(data), np.asarray(indices), np.asarray(indptr)),
+            shape=(N, N)
+        )
 
-        if not self.is_directed():
-            mtx = mtx + sparse.triu(mtx, 1).T + sparse.tril(mtx, -1).T
+        if not mtx.has_canonical_format:
+            # Multiple edges; the arrays exported by igraph are read-only
+            mtx = mtx.copy()
+            mtx.sum_duplicates()
         return mtx
 
     def get_adjlist(self, mode=OUT):
@@ -923,7 +928,7 @@ class Graph(GraphBase):
 
     def pagerank(self, vertices=None, directed=True, damping=0.85,
                  weights=None, arpack_options=None, implementation="prpack",
-                 niter=1000, eps=0.001):
+                 niter=1000, eps=0.001, return_type=None):
         """Calculates the Google PageRank values of a graph.
 
         @param vertices: the indices of the vertices being queried.
@@ -953,13 +958,17 @@ class Graph(GraphBase):
           calculation as complete if the difference of PageRank values between
           iterations change less than this value for every node. It is
           ignored by the other implementations.
+        @param return_type: C{"list"} (or C{None}) returns the result as a
+          Python list, C{"buffer"} returns a L{Buffer} that exposes the
+          result without copying via the buffer protocol.
         @return: a list with the Google PageRank values of the specified
           vertices."""
         if arpack_options is None:
             arpack_options = _igraph.arpack_options
         return self.personalized_pagerank(vertices, directed, damping, None,\
                                           None, weights, arpack_options, \
-                                          implementation, niter, eps)
+                                          implementation, niter, eps, \
+                                          return_type)
 
     def spanning_tree(self, weights=None, return_tree=True):
         """Calculates a minimum spanning tree for a graph.
@@ -1023,10 +1032,12 @@ class Graph(GraphBase):
         return sum(xs) / float(len(xs))
 
     def triad_census(self, *args, **kwds):
-        """triad_census()
+        """triad_census(threads=None)
 
         Calculates the triad census of the graph.
 
+        @param threads: C{None} to use the C core, or the number of threads
+          that share the vertices of the graph.
         @return: a L{TriadCensus} object.
         @newfield ref: Reference
         @ref: Davis, J.A. and Leinhardt, S.  (1972).  The Structure of
@@ -1533,6 +1544,11 @@ class Graph(GraphBase):
           - C{auto}, C{automatic}: automatic layout
             (see L{Graph.layout_auto})
 
+          - C{bh}, C{barnes_hut}: multilevel, multi-threaded force-directed
+            layout for large graphs (see L{Graph.layout_barnes_hut})
+
+          - C{bh_3d}, C{bh3d}, C{barnes_hut_3d}: 3D version of the above
+
           - C{bipartite}: bipartite layout (see L{Graph.layout_bipartite})
 
           - C{circle}, C{circular}: circular layout
@@ -1591,7 +1607,9 @@ class Graph(GraphBase):
           layout names or a callable which returns either a L{Layout} object or
           a list of lists containing the coordinates. If C{None}, uses the
           value of the C{plotting.layout} configuration key.
-        @return: a L{Layout} object.
+        @return: a L{Layout} object, or the L{Buffer} of coordinates returned
+          by the layout method if it was asked for one with
+          C{return_type="buffer"}.
         """
         if layout is None:
             layout = config["plotting.layout"]
@@ -1609,7 +1627,7 @@ class Graph(GraphBase):
         if not hasattr(method, "__call__"):
             raise ValueError("layout method must be callable")
         l = method(self, *args, **kwds)
-        if not isinstance(l, Layout):
+        if not isinstance(l, (Layout, Buffer)):
             l = Layout(l)
         return l
 
@@ -2068,19 +2086,17 @@ class Graph(GraphBase):
         C{gunzip} or C{zcat} from Unix command line) or the Python C{gzip}
         module.
 
-        Uses a temporary file to store intermediate GraphML data, so
-        make sure you have enough free space to store the unzipped
-        GraphML file as well.
+        The GraphML data is compressed while it is being written, without
+        storing the uncompressed file anywhere.
 
         @param f: the name of the file to be written.
         @param compresslevel: the level of compression. 1 is fastest and
           produces the least compression, and 9 is slowest and produces
           the most compression."""
-        from igraph.utils import named_temporary_file
-        with named_temporary_file() as tmpfile:
-            self.write_graphml(tmpfile)
-            outf = gzip.GzipFile(f, "wb", compresslevel)
-            copyfileobj(open(tmpfile, "rb"), outf)
+        outf = gzip.GzipFile(f, "wb", compresslevel)
+        try:
+            self.write_graphml(outf)
+        finally:
             outf.close()
 
     @classmethod
@@ -2555,6 +2571,9 @@ class Graph(GraphBase):
             elif ext2 == ".graphml":
                 return "graphmlz"
 
+        if ext == ".igb":
+            return "binary"
+
         if ext in [".graphml", ".graphmlz", ".lgl", ".ncol", ".pajek",
             ".gml", ".dimacs", ".edgelist", ".edges", ".edge", ".net",
             ".pickle", ".picklez", ".dot", ".gw", ".lgr", ".dl"]:
@@ -2609,7 +2628,8 @@ class Graph(GraphBase):
           C{"edges"} or C{"edge"} (edge list), C{"adjacency"}
           (adjacency matrix), C{"dl"} (DL format used by UCINET),
           C{"pickle"} (Python pickled format),
-          C{"picklez"} (gzipped Python pickled format)
+          C{"picklez"} (gzipped Python pickled format),
+          C{"binary"} (igraph's compact binary format)
         @raises IOError: if the file format can't be identified and
           none was given.
         """
@@ -2643,6 +2663,8 @@ class Graph(GraphBase):
 
             - C{"adjacency"}: adjacency matrix format
 
+            - C{"binary"}: igraph's compact binary format
+
             - C{"dimacs"}: DIMACS format
 
             - C{"dot"}, C{"graphviz"}: GraphViz DOT format
@@ -2887,6 +2909,77 @@ class Graph(GraphBase):
         # Construct the graph
         return klass(n, edge_list, directed, {}, vertex_attributes, edge_attributes)
 
+    @classmethod
+    def from_columns(klass, source, target, directed=False, edge_attrs=None,
+            vertex_names=None, vertex_name_attr="name"):
+        """Constructs a graph from columns of an edge table.
+
+        This is the columnar counterpart of L{TupleList()}: instead of a row
+        for each edge, it takes the source vertices, the target vertices and
+        the edge attributes as separate columns, and works out the vertices
+        in C, without iterating over the rows in Python. The columns may be
+        lists, NumPy arrays, pandas Series, or Apache Arrow arrays and
+        chunked arrays (e.g., the columns of a table read from a Parquet
+        file).
+
+        Integer columns of sources and targets that support the buffer
+        protocol (e.g., integer NumPy or Arrow arrays, or C{array.array}
+        objects) are used as vertex IDs as they are, unless C{vertex_names}
+        says otherwise. Other vertex keys (including lists of integers) are
+        mapped to vertex IDs in the order of their first appearance (like in
+        L{TupleList()}) and they are stored in the vertex attribute given by
+        C{vertex_name_attr}. Arrow string columns are hashed directly in
+        their buffers, so no Python strings are created apart from the
+        vertex names.
+
+        Numeric edge attribute columns are stored in typed columns without
+        converting the values to Python objects.
+
+        @param source: the source vertices of the edges
+        @param target: the target vertices of the edges, a column of the
+          same kind as C{source}
+        @param directed: whether the constructed graph will be directed
+        @param edge_attrs: a dict mapping edge attribute names to columns
+          with the values of the attribute for each edge
+        @param vertex_names: C{None} to use integer buffers as vertex IDs
+          and to look up other keys, C{True} to look up integer buffers
+          as well, or a sequence of all the vertex keys in the order of the
+          vertex IDs. In the latter case, the graph has a vertex for each
+          key (including the ones without edges) and every source and target
+          vertex must be one of them.
+        @param vertex_name_attr: the name of the vertex attribute that will
+          contain the vertex keys if they were looked up
+        @return: the graph that was constructed
+        """
+        key_columns = [_column_to_native(column, keys=True)
+                       for column in (source, target)]
+        if vertex_names is not None and vertex_names is not True:
+            vertex_names = _column_to_native(vertex_names)
+            if hasattr(vertex_names, "tolist"):
+                vertex_names = vertex_names.tolist()
+            elif not isinstance(vertex_names, (list, tuple)):
+                vertex_names = list(vertex_names)
+
+        graph, names = klass._from_columns(key_columns[0], key_columns[1],
+                directed=directed, vertex_names=vertex_names)
+        del key_columns
+
+        if names is None and vertex_names is not None and vertex_names is not True:
+            names = vertex_names
+        if names is not None:
+            graph.vs[vertex_name_attr] = names
+
+        for name, values in (edge_attrs or {}).items():
+            values = _column_to_native(values)
+            if not hasattr(values, "__len__"):
+                values = list(values)
+            if len(values) != graph.ecount():
+                raise ValueError("edge attribute %r must have a value for "
+                        "each edge" % (name,))
+            graph.es[name] = values
+
+        return graph
+
     #################################
     # Constructor for graph formulae
     Formula=classmethod(construct_graph_from_formula)
@@ -3561,19 +3654,33 @@ class Graph(GraphBase):
         result.__dict__.update(attrs)
         return result
 
-    def __reduce__(self):
-        """Support for pickling."""
-        constructor = self.__class__
-        gattrs, vattrs, eattrs = {}, {}, {}
-        for attr in self.attributes():
-            gattrs[attr] = self[attr]
-        for attr in self.vs.attribute_names():
-            vattrs[attr] = self.vs[attr]
-        for attr in self.es.attribute_names():
-            eattrs[attr] = self.es[attr]
-        parameters = (self.vcount(), self.get_edgelist(), \
-            self.is_directed(), gattrs, vattrs, eattrs)
-        return (constructor, parameters, self.__dict__)
+    def __reduce_ex__(self, protocol):
+        """Support for pickling.
+
+        The graph and its attributes are stored in the binary format of
+        L{write_binary()}. With pickle protocol 5 or later, the binary data
+        is wrapped in a C{pickle.PickleBuffer} so it can be transferred
+        out-of-band without copying."""
+        data = GraphBase.__getstate__(self)
+        if protocol >= 5:
+            try:
+                from pickle import PickleBuffer
+            except ImportError:
+                pass
+            else:
+                data = PickleBuffer(data)
+        return (self.__class__, (), (data, self.__dict__))
+
+    def __setstate__(self, state):
+        """Support for unpickling."""
+        if isinstance(state, dict):
+            # Pickled by an earlier version that passed the graph to the
+            # constructor and only the instance dict as the state
+            self.__dict__.update(state)
+            return
+        data, attrs = state
+        GraphBase.__setstate__(self, data)
+        self.__dict__.update(attrs)
 
     __iter__ = None                # needed for PyPy
     __hash__ = None                # needed for PyPy
@@ -3820,22 +3927,24 @@ class Graph(GraphBase):
             other = [other]
         return disjoint_union([self] + other)
 
-    def union(self, other, byname='auto'):
-        """union(self, other, byname="auto")
+    def union(self, other, byname='auto', combine_edges=None):
+        """union(self, other, byname="auto", combine_edges=None)
 
         Creates the union of two (or more) graphs.
 
         @param other: graph or list of graphs to be united with the current one.
         @param byname: whether to use vertex names instead of ids. See
           L{igraph.union} for details.
+        @param combine_edges: how to combine the edge attributes of the
+          graphs. See L{igraph.union} for details.
         @return: the union graph
         """
         if isinstance(other, GraphBase):
             other = [other]
-        return union([self] + other, byname=byname)
+        return union([self] + other, byname=byname, combine_edges=combine_edges)
 
-    def intersection(self, other, byname='auto'):
-        """intersection(self, other, byname="auto")
+    def intersection(self, other, byname='auto', combine_edges=None):
+        """intersection(self, other, byname="auto", combine_edges=None)
 
         Creates the intersection of two (or more) graphs.
 
@@ -3843,11 +3952,14 @@ class Graph(GraphBase):
           the current one.
         @param byname: whether to use vertex names instead of ids. See
           L{igraph.intersection} for details.
+        @param combine_edges: how to combine the edge attributes of the
+          graphs. See L{igraph.intersection} for details.
         @return: the intersection graph
         """
         if isinstance(other, GraphBase):
             other = [other]
-        return intersection([self] + other, byname=byname)
+        return intersection([self] + other, byname=byname,
+                            combine_edges=combine_edges)
 
     _format_mapping = {
           "ncol":       ("Read_Ncol", "write_ncol"),
@@ -3862,6 +3974,7 @@ class Graph(GraphBase):
           "pajek":      ("Read_Pajek", "write_pajek"),
           "dimacs":     ("Read_DIMACS", "write_dimacs"),
           "adjacency":  ("Read_Adjacency", "write_adjacency"),
+          "binary":     ("Read_Binary", "write_binary"),
           "adj":        ("Read_Adjacency", "write_adjacency"),
           "edgelist":   ("Read_Edgelist", "write_edgelist"),
           "edge":       ("Read_Edgelist", "write_edgelist"),
@@ -3878,6 +3991,8 @@ class Graph(GraphBase):
     _layout_mapping = {
         "auto": "layout_auto",
         "automatic": "layout_auto",
+        "barnes_hut": "layout_barnes_hut",
+        "bh": "layout_barnes_hut",
         "bipartite": "layout_bipartite",
         "circle": "layout_circle",
         "circular": "layout_circle",
@@ -4160,10 +4275,11 @@ class VertexSeq(_igraph.VertexSeq):
             if attr[0] == '_':
                 # Method call, not an attribute
                 values = getattr(vs.graph, attr[1:])(vs)
+                filtered_idxs=[i for i, v in enumerate(values) if func(v, value)]
+                vs = vs.select(filtered_idxs)
             else:
-                values = vs[attr]
-            filtered_idxs=[i for i, v in enumerate(values) if func(v, value)]
-            vs = vs.select(filtered_idxs)
+                # Attribute filters are evaluated in C on the attribute storage
+                vs = vs._select_by_attribute(attr, op, value)
 
         return vs
 
@@ -4564,7 +4680,9 @@ class EdgeSeq(_igraph.EdgeSeq):
                     # Method call, not an attribute
                     values = getattr(es.graph, attr[1:])(es)
             else:
-                values = es[attr]
+                # Attribute filters are evaluated in C on the attribute storage
+                es = es._select_by_attribute(attr, op, value)
+                continue
 
             # If we have a function to apply on the values, do that; otherwise
             # we assume that filtered_idxs has already been calculated.
@@ -4665,14 +4783,15 @@ _add_proxy_methods()
 
 def _layout_method_wrapper(func):
     """Wraps an existing layout method to ensure that it returns a Layout
-    instead of a list of lists.
+    instead of a list of lists. Coordinate buffers requested from the method
+    with C{return_type="buffer"} are returned as they are.
 
     @param func: the method to wrap. Must be a method of the Graph object.
     @return: a new method
     """
     def result(*args, **kwds):
         layout = func(*args, **kwds)
-        if not isinstance(layout, Layout):
+        if not isinstance(layout, (Layout, Buffer)):
             layout = Layout(layout)
         return layout
     result.__name__ = func.__name__
@@ -104,7 +104,7 @@ def disjoint_union(graphs):
     return graph_union
 
 
-def union(graphs, byname='auto'):
+def union(graphs, byname='auto', combine_edges=None):
     """Graph union.
 
     The union of two or more graphs is created. The graphs may have identical
@@ -129,6 +129,13 @@ def union(graphs, byname='auto'):
       False, ignore vertex names. If True, merge vertices based on names. If
       'auto', use True if all graphs have named vertices and False otherwise
       (in the latter case, a warning is generated too).
+    @param combine_edges: specifies how to combine the attributes of the
+      edges of the graphs into the attributes of the corresponding edges of
+      the union, using the same format as in L{Graph.simplify()}. Edge
+      attributes without a combination rule are dropped; missing values are
+      skipped. The combination happens in C in a single pass over the
+      edges. If C{None}, edge attributes are copied and renamed on
+      conflicts as described above.
     @return: the union graph
     """
 
@@ -155,42 +162,27 @@ def union(graphs, byname='auto'):
         return graphs[0].copy()
     # Now there are at least two graphs
 
-    if byname:
-        allnames = [g.vs['name'] for g in graphs]
-        uninames = list(set.union(*(set(vns) for vns in allnames)))
-        permutation_map = {x: i for i, x in enumerate(uninames)}
-        nve = len(uninames)
-        newgraphs = []
-        for g, vertex_names in zip(graphs, allnames):
-            # Make a copy
-            ng = g.copy()
-
-            # Add the missing vertices
-            v_missing = list(set(uninames) - set(vertex_names))
-            ng.add_vertices(v_missing)
-
-            # Reorder vertices to match uninames
-            # vertex k -> p[k]
-            permutation = [permutation_map[x] for x in ng.vs['name']]
-            ng = ng.permute_vertices(permutation)
-
-            newgraphs.append(ng)
-    else:
-        newgraphs = graphs
-
-    # If any graph has any edge attributes, we need edgemaps
-    edgemaps = any(len(g.edge_attributes()) for g in graphs)
-    res = _union(newgraphs, edgemaps)
-    if edgemaps:
+    # If any graph has any edge attributes, we need edgemaps unless they are
+    # combined in C
+    edgemaps = combine_edges is None and \
+        any(len(g.edge_attributes()) for g in graphs)
+    res = _union(graphs, edgemaps, byname, combine_edges)
+    if edgemaps or byname:
         graph_union = res['graph']
-        edgemaps = res['edgemaps']
+        edgemaps = res.get('edgemaps')
     else:
         graph_union = res
 
+    # Vertex maps point to the vertices of the union graph
+    if byname:
+        vertexmaps = res['vertexmaps']
+    else:
+        vertexmaps = [range(g.vcount()) for g in graphs]
+
     # Graph attributes
     a_first_graph = {}
     a_conflict = set()
-    for ig, g in enumerate(newgraphs, 1):
+    for ig, g in enumerate(graphs, 1):
         # NOTE: a_name is the name of the attribute, a_value its value
         for a_name in g.attributes():
             a_value = g[a_name]
@@ -209,18 +201,16 @@ def union(graphs, byname='auto'):
                     graph_union.pop(a_name)
             graph_union['{:}_{:}'.format(a_name, ig)] = a_value
 
-    # Vertex attributes
-    if byname:
-        graph_union.vs['name'] = uninames
-    attrs = set.union(*(set(g.vertex_attributes()) for g in newgraphs)) - set(['name'])
+    # Vertex attributes; 'name' is set in C when matching by names
+    attrs = set.union(*(set(g.vertex_attributes()) for g in graphs)) - set(['name'])
     nve = graph_union.vcount()
     for a_name in attrs:
         # Check for conflicts at at least one vertex
         conflict = False
         vals = [None for i in range(nve)]
-        for g in newgraphs:
+        for g, vmap in zip(graphs, vertexmaps):
             if a_name in g.vertex_attributes():
-                for i, a_value in enumerate(g.vs[a_name]):
+                for i, a_value in zip(vmap, g.vs[a_name]):
                     if a_value is None:
                         continue
                     if vals[i] is None:
@@ -237,19 +227,22 @@ def union(graphs, byname='auto'):
             continue
 
         # There is a conflict, name after the graph number
-        for ig, g in enumerate(newgraphs, 1):
+        for ig, (g, vmap) in enumerate(zip(graphs, vertexmaps), 1):
             if a_name in g.vertex_attributes():
-                graph_union.vs['{:}_{:}'.format(a_name, ig)] = g.vs[a_name]
+                vals = [None for i in range(nve)]
+                for i, a_value in zip(vmap, g.vs[a_name]):
+                    vals[i] = a_value
+                graph_union.vs['{:}_{:}'.format(a_name, ig)] = vals
 
-    # Edge attributes
+    # Edge attributes, unless they were combined in C
     if edgemaps:
-        attrs = set.union(*(set(g.edge_attributes()) for g in newgraphs))
+        attrs = set.union(*(set(g.edge_attributes()) for g in graphs))
         ne = graph_union.ecount()
         for a_name in attrs:
             # Check for conflicts at at least one edge
             conflict = False
             vals = [None for i in range(ne)]
-            for g, emap in zip(newgraphs, edgemaps):
+            for g, emap in zip(graphs, edgemaps):
                 if a_name not in g.edge_attributes():
                     continue
                 for iu, a_value in zip(emap, g.es[a_name]):
@@ -259,7 +252,6 @@ def union(graphs, byname='auto'):
                         vals[iu] = a_value
                         continue
                     if vals[iu] != a_value:
-                        print(g, g.vs['name'], emap, a_value, iu, vals[iu])
                         conflict = True
                         break
                 if conflict:
@@ -270,7 +262,7 @@ def union(graphs, byname='auto'):
                 continue
 
             # There is a conflict, name after the graph number
-            for ig, (g, emap) in enumerate(zip(newgraphs, edgemaps), 1):
+            for ig, (g, emap) in enumerate(zip(graphs, edgemaps), 1):
                 if a_name not in g.edge_attributes():
                     continue
                 # Pass through map
@@ -282,7 +274,8 @@ def union(graphs, byname='auto'):
     return graph_union
 
 
-def intersection(graphs, byname='auto', keep_all_vertices=True):
+def intersection(graphs, byname='auto', keep_all_vertices=True,
+                 combine_edges=None):
     """Graph intersection.
 
     The intersection of two or more graphs is created. The graphs may have
@@ -309,6 +302,13 @@ def intersection(graphs, byname='auto', keep_all_vertices=True):
       (in the latter case, a warning is generated too).
     @param keep_all_vertices: bool specifying if vertices that are not present
       in all graphs should be kept in the intersection.
+    @param combine_edges: specifies how to combine the attributes of the
+      edges of the graphs into the attributes of the corresponding edges of
+      the intersection, using the same format as in L{Graph.simplify()}.
+      Edge attributes without a combination rule are dropped; missing values
+      are skipped. The combination happens in C in a single pass over the
+      edges. If C{None}, edge attributes are copied and renamed on
+      conflicts as described above.
     @return: the intersection graph
     """
 
@@ -335,52 +335,29 @@ def intersection(graphs, byname='auto', keep_all_vertices=True):
         return graphs[0].copy()
     # Now there are at least two graphs
 
-    if byname:
-        allnames = [g.vs['name'] for g in graphs]
-
-        if keep_all_vertices:
-            uninames = list(set.union(*(set(vns) for vns in allnames)))
-        else:
-            uninames = list(set.intersection(*(set(vns) for vns in allnames)))
-        permutation_map = {x: i for i, x in enumerate(uninames)}
-
-        nv = len(uninames)
-        newgraphs = []
-        for g, vertex_names in zip(graphs, allnames):
-            # Make a copy
-            ng = g.copy()
-
-            if keep_all_vertices:
-                # Add the missing vertices
-                v_missing = list(set(uninames) - set(vertex_names))
-                ng.add_vertices(v_missing)
-            else:
-                # Delete the private vertices
-                v_private = list(set(vertex_names) - set(uninames))
-                ng.delete_vertices(v_private)
-
-            # Reorder vertices to match uninames
-            # vertex k -> p[k]
-            permutation = [permutation_map[x] for x in ng.vs['name']]
-            ng = ng.permute_vertices(permutation)
-
-            newgraphs.append(ng)
-    else:
-        newgraphs = graphs
-
-    # If any graph has any edge attributes, we need edgemaps
-    edgemaps = any(len(g.edge_attributes()) for g in graphs)
-    res = _intersection(newgraphs, edgemaps)
-    if edgemaps:
+    # If any graph has any edge attributes, we need edgemaps unless they are
+    # combined in C
+    edgemaps = combine_edges is None and \
+        any(len(g.edge_attributes()) for g in graphs)
+    res = _intersection(graphs, edgemaps, byname, keep_all_vertices,
+                        combine_edges)
+    if edgemaps or byname:
         graph_intsec = res['graph']
-        edgemaps = res['edgemaps']
+        edgemaps = res.get('edgemaps')
     else:
         graph_intsec = res
 
+    # Vertex maps point to the vertices of the intersection graph; vertices
+    # that were not kept are mapped to -1
+    if byname:
+        vertexmaps = res['vertexmaps']
+    else:
+        vertexmaps = [range(g.vcount()) for g in graphs]
+
     # Graph attributes
     a_first_graph = {}
     a_conflict = set()
-    for ig, g in enumerate(newgraphs, 1):
+    for ig, g in enumerate(graphs, 1):
         # NOTE: a_name is the name of the attribute, a_value its value
         for a_name in g.attributes():
             a_value = g[a_name]
@@ -399,20 +376,18 @@ def intersection(graphs, byname='auto', keep_all_vertices=True):
                     graph_intsec.pop(a_name)
             graph_intsec['{:}_{:}'.format(a_name, ig)] = a_value
 
-    # Vertex attributes
-    if byname:
-        graph_intsec.vs['name'] = uninames
-    attrs = set.union(*(set(g.vertex_attributes()) for g in newgraphs)) - set(['name'])
+    # Vertex attributes; 'name' is set in C when matching by names
+    attrs = set.union(*(set(g.vertex_attributes()) for g in graphs)) - set(['name'])
     nv = graph_intsec.vcount()
     for a_name in attrs:
         # Check for conflicts at at least one vertex
         conflict = False
         vals = [None for i in range(nv)]
-        for g in newgraphs:
+        for g, vmap in zip(graphs, vertexmaps):
             if a_name not in g.vertex_attributes():
                 continue
-            for i, a_value in enumerate(g.vs[a_name]):
-                if a_value is None:
+            for i, a_value in zip(vmap, g.vs[a_name]):
+                if i == -1 or a_value is None:
                     continue
                 if vals[i] is None:
                     vals[i] = a_value
@@ -428,19 +403,23 @@ def intersection(graphs, byname='auto', keep_all_vertices=True):
             continue
 
         # There is a conflict, name after the graph number
-        for ig, g in enumerate(newgraphs, 1):
+        for ig, (g, vmap) in enumerate(zip(graphs, vertexmaps), 1):
             if a_name in g.vertex_attributes():
-                graph_intsec.vs['{:}_{:}'.format(a_name, ig)] = g.vs[a_name]
+                vals = [None for i in range(nv)]
+                for i, a_value in zip(vmap, g.vs[a_name]):
+                    if i != -1:
+                        vals[i] = a_value
+                graph_intsec.vs['{:}_{:}'.format(a_name, ig)] = vals
 
-    # Edge attributes
+    # Edge attributes, unless they were combined in C
     if edgemaps:
-        attrs = set.union(*(set(g.edge_attributes()) for g in newgraphs))
+        attrs = set.union(*(set(g.edge_attributes()) for g in graphs))
         ne = graph_intsec.ecount()
         for a_name in attrs:
             # Check for conflicts at at least one edge
             conflict = False
             vals = [None for i in range(ne)]
-            for g, emap in zip(newgraphs, edgemaps):
+            for g, emap in zip(graphs, edgemaps):
                 if a_name not in g.edge_attributes():
                     continue
                 for iu, a_value in zip(emap, g.es[a_name]):
@@ -462,7 +441,7 @@ def intersection(graphs, byname='auto', keep_all_vertices=True):
                 continue
 
             # There is a conflict, name after the graph number
-            for ig, (g, emap) in enumerate(zip(newgraphs, edgemaps), 1):
+            for ig, (g, emap) in enumerate(zip(graphs, edgemaps), 1):
                 if a_name not in g.edge_attributes():
                     continue
                 # Pass through map
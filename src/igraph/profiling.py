@@ -0,0 +1,83 @@
+# vim:ts=4:sw=4:sts=4:et
+# -*- coding: utf-8 -*-
+"""
+Exporting the call statistics collected by igraph when profiling is enabled
+"""
+
+__license__ = u"""\
+Copyright (C) 2006-2012  Tamas Nepusz <ntamas@gmail.com>
+Pázmány Péter sétány 1/a, 1117 Budapest, Hungary
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc.,  51 Franklin Street, Fifth Floor, Boston, MA 
+02110-1301 USA
+"""
+
+from igraph._igraph import get_profile_stats
+
+__all__ = ["profile_stats_to_prometheus"]
+
+#: The metrics exported by L{profile_stats_to_prometheus()}: the key in the
+#: statistics, the suffix of the metric name, the scale factor and the help
+#: text
+_PROMETHEUS_METRICS = [
+    ("calls", "calls_total", 1, "Number of calls of the method"),
+    ("input_ns", "input_seconds_total", 1e-9,
+     "Time spent converting the arguments of the method"),
+    ("core_ns", "core_seconds_total", 1e-9,
+     "Time spent in the C core of igraph"),
+    ("output_ns", "output_seconds_total", 1e-9,
+     "Time spent converting the results of the method"),
+    ("bytes", "allocated_bytes_total", 1,
+     "Bytes allocated by Python during the calls of the method"),
+]
+
+
+def _escape_label_value(value):
+    return value.replace("\\", "\\\\").replace("\"", "\\\"") \
+            .replace("\n", "\\n")
+
+
+def profile_stats_to_prometheus(stats=None, prefix="igraph"):
+    """Formats the statistics collected about method calls in the text
+    exposition format of Prometheus.
+
+    Every counter of L{get_profile_stats()} becomes a counter metric with
+    a C{method} label; times are converted to seconds. The result can be
+    served directly on a metrics endpoint, or parsed by the C{prometheus_client}
+    package if a custom collector is needed.
+
+    @param stats: the statistics to format, as returned by
+      L{get_profile_stats()}. C{None} means the current statistics.
+    @param prefix: the prefix of the metric names.
+    @return: the metrics as a string.
+    """
+    if stats is None:
+        stats = get_profile_stats()
+
+    lines = []
+    methods = sorted(stats)
+    for key, suffix, scale, help_text in _PROMETHEUS_METRICS:
+        name = "%s_%s" % (prefix, suffix)
+        lines.append("# HELP %s %s" % (name, help_text))
+        lines.append("# TYPE %s counter" % name)
+        for method in methods:
+            value = stats[method][key]
+            if scale != 1:
+                value = "%r" % (value * scale)
+            lines.append('%s{method="%s"} %s' % (
+                name, _escape_label_value(method), value
+            ))
+    lines.append("")
+    return "\n".join(lines)
@@ -2,7 +2,7 @@
 # -*- coding: utf-8 -*-
 """Utility functions that cannot be categorised anywhere else.
 
-@undocumented: _is_running_in_ipython
+@undocumented: _is_running_in_ipython, _column_to_native
 """
 
 from contextlib import contextmanager
@@ -91,6 +91,50 @@ def numpy_to_contiguous_memoryview(obj):
     return memoryview(require(obj, dtype=dtype, requirements="AC"))
 
 
+def _column_to_native(column, keys=False):
+    """Converts a column of a table (a NumPy array, a pandas Series or an
+    Apache Arrow array) into a form that is read by the C layer without
+    iterating over it from Python.
+
+    Numeric columns become NumPy arrays or other objects exporting a
+    one-dimensional buffer. When C{keys} is C{True}, Arrow string arrays
+    are turned into a pair of their offset and data buffers so the strings
+    can be hashed without creating Python strings.
+    """
+    if hasattr(column, "combine_chunks"):
+        # Arrow ChunkedArray
+        column = column.combine_chunks()
+
+    if hasattr(column, "buffers") and hasattr(column, "null_count"):
+        # Arrow Array
+        if column.null_count:
+            raise ValueError("columns must not contain missing values")
+        type_name = str(column.type)
+        if keys and type_name in ("string", "large_string") and \
+                hasattr(memoryview, "cast"):
+            _, offsets, data = column.buffers()[:3]
+            size = 4 if type_name == "string" else 8
+            offsets = memoryview(offsets)[size * column.offset:
+                                          size * (column.offset + len(column) + 1)]
+            offsets = offsets.cast("B").cast("i" if size == 4 else "q")
+            return offsets, (memoryview(data) if data is not None else b"")
+        if type_name.startswith(("int", "uint", "float", "double", "bool")):
+            return column.to_numpy(zero_copy_only=False)
+        return column.to_pylist()
+
+    if hasattr(column, "to_numpy"):
+        # pandas Series or Index
+        column = column.to_numpy()
+
+    if hasattr(column, "dtype") and hasattr(column, "tolist"):
+        # Only numeric NumPy arrays are usable as buffers; strings and other
+        # objects are best handled as a list
+        if column.dtype.kind not in "biuf":
+            return column.tolist()
+
+    return column
+
+
 def rescale(values, out_range=(0., 1.), in_range=None, clamp=False,
             scale=None):
     """Rescales a list of numbers into a given range.
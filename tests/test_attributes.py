@@ -264,6 +264,209 @@ class AttributeCombinationTests(unittest.TestCase):
         self.assertTrue(sorted(g.edge_attributes()) == [])
 
 
+class TypedAttributeColumnTests(unittest.TestCase):
+    def testAssignFromBuffer(self):
+        from array import array
+        g = Graph.Ring(5)
+        g.es["weight"] = array("d", [1.5, 2, 3, 4, 5])
+        self.assertTrue(isinstance(g.es.get_attribute_column("weight"), AttributeColumn))
+        self.assertEqual(g.es["weight"], [1.5, 2.0, 3.0, 4.0, 5.0])
+        self.assertEqual(g.es[1]["weight"], 2.0)
+        self.assertEqual(g.es[1:3]["weight"], [2.0, 3.0])
+
+        g.vs["x"] = array("l", [1, 2, 3, 4, 5])
+        self.assertEqual(g.vs.get_attribute_column("x").type, "int")
+        self.assertEqual(g.vs["x"], [1, 2, 3, 4, 5])
+        self.assertEqual(g.vs[2].attributes(), {"x": 3})
+
+    def testNumPyArrays(self):
+        try:
+            import numpy as np
+        except ImportError:
+            self.skipTest("NumPy not installed")
+
+        g = Graph.Lattice([4, 4], circular=False)
+        weights = np.arange(1, g.ecount() + 1, dtype=float)
+        g.es["weight"] = weights
+        g.es["weight_list"] = weights.tolist()
+        self.assertEqual(g.shortest_paths(weights="weight"),
+                         g.shortest_paths(weights="weight_list"))
+        self.assertEqual(g.strength(weights="weight"),
+                         g.strength(weights="weight_list"))
+
+        column = np.asarray(g.es.get_attribute_column("weight"))
+        self.assertTrue((column == weights).all())
+        self.assertFalse(column.flags.writeable)
+
+    def testListToColumn(self):
+        g = Graph.Ring(4)
+        g.es["flag"] = [True, False, True, True]
+        g.es["value"] = [1, 2.5, None, 4]
+        self.assertEqual(g.es.get_attribute_column("flag").type, "bool")
+        column = g.es.get_attribute_column("value")
+        self.assertEqual(column.type, "float")
+        self.assertEqual(column.valid, [True, True, False, True])
+        self.assertEqual(g.es["value"], [1.0, 2.5, None, 4.0])
+
+        g.es["label"] = ["a", "b", "c", "d"]
+        self.assertRaises(TypeError, g.es.get_attribute_column, "label")
+        g.vs["name"] = ["a", "b", "c", "d"]
+        self.assertRaises(ValueError, g.vs.get_attribute_column, "name")
+
+    def testGrowAndModify(self):
+        from array import array
+        g = Graph.Ring(3)
+        g.es["weight"] = array("d", [1, 2, 3])
+        view = memoryview(g.es.get_attribute_column("weight"))
+
+        g.add_edges([(0, 0)])
+        self.assertEqual(g.es["weight"], [1.0, 2.0, 3.0, None])
+        self.assertEqual(view.tolist(), [1.0, 2.0, 3.0])
+
+        g.es[3]["weight"] = 4
+        self.assertEqual(g.es["weight"], [1.0, 2.0, 3.0, 4.0])
+        self.assertEqual(g.es.get_attribute_column("weight").type, "float")
+
+        # Values that do not fit the column turn it back into a list
+        g.es[0]["weight"] = "heavy"
+        self.assertEqual(g.es["weight"], ["heavy", 2.0, 3.0, 4.0])
+        self.assertRaises(TypeError, g.es.get_attribute_column, "weight")
+
+    def testPermuteAndCopy(self):
+        from array import array
+        g = Graph.Ring(4)
+        g.vs["x"] = array("d", [0, 1, 2, 3])
+        g2 = g.copy()
+        g.vs[0]["x"] = 10
+        self.assertEqual(g2.vs["x"], [0.0, 1.0, 2.0, 3.0])
+
+        g3 = g2.permute_vertices([3, 2, 1, 0])
+        self.assertEqual(g3.vs["x"], [3.0, 2.0, 1.0, 0.0])
+
+        g2.delete_vertices([1])
+        self.assertEqual(g2.vs["x"], [0.0, 2.0, 3.0])
+
+        g2.contract_vertices([0, 0, 1], combine_attrs="sum")
+        self.assertEqual(g2.vs["x"], [2.0, 3.0])
+
+    def testDeletionCompactsInPlace(self):
+        from array import array
+        g = Graph.Ring(10)
+        g.es["weight"] = array("d", range(10))
+        g.es["flag"] = [i % 3 == 0 for i in range(10)]
+        g.es["value"] = [None if i % 4 == 1 else i for i in range(10)]
+        g.es["label"] = list("abcdefghij")
+        column = g.es.get_attribute_column("weight")
+        label = g.es["label"]
+
+        g.delete_edges([0, 3, 4, 9])
+        self.assertTrue(g.es.get_attribute_column("weight") is column)
+        self.assertEqual(g.es["weight"], [1.0, 2.0, 5.0, 6.0, 7.0, 8.0])
+        self.assertEqual(g.es["flag"], [False, False, False, True, False, False])
+        self.assertEqual(g.es["value"], [None, 2.0, None, 6.0, 7.0, 8.0])
+        self.assertEqual(g.es["label"], list("bcfghi"))
+        self.assertEqual(label, list("abcdefghij"))
+
+        # Exported columns are left intact
+        view = memoryview(g.es.get_attribute_column("weight"))
+        g.delete_edges([0])
+        self.assertEqual(view.tolist(), [1.0, 2.0, 5.0, 6.0, 7.0, 8.0])
+        self.assertEqual(g.es["weight"], [2.0, 5.0, 6.0, 7.0, 8.0])
+
+        g.vs["x"] = array("l", range(10))
+        g.vs["name"] = list("ABCDEFGHIJ")
+        g.delete_vertices([0, 5])
+        self.assertEqual(g.vs["x"], [1, 2, 3, 4, 6, 7, 8, 9])
+        self.assertEqual(g.vs.find("G").index, 4)
+
+    def testCombinationOfColumns(self):
+        from array import array
+
+        def mean(xs):
+            return float(sum(xs)) / len(xs)
+
+        def median(xs):
+            xs, n = sorted(xs), len(xs)
+            return xs[n // 2] if n % 2 else (xs[n // 2 - 1] + xs[n // 2]) / 2.0
+
+        def prod(xs):
+            result = 1.0
+            for x in xs:
+                result *= x
+            return result
+
+        reference = {
+            "sum": lambda xs: float(sum(xs)), "prod": prod, "mean": mean,
+            "median": median, "min": min, "max": max,
+            "first": lambda xs: xs[0], "last": lambda xs: xs[-1],
+        }
+
+        typed = Graph([(0, 1), (1, 0), (1, 2), (2, 3), (2, 3), (2, 3), (3, 3)])
+        typed.es["int"] = array("l", [3, -2, 7, 4, 9, 4, 1])
+        typed.es["float"] = array("d", [1.5, 2.5, 3, 0.25, -1, 8, 7])
+        typed.es["bool"] = [True, False, True, False, True, True, False]
+        for name in ("int", "float", "bool"):
+            self.assertEqual(typed.es.get_attribute_column(name).type, name)
+
+        # Python callables get the values of the merged edges in a list
+        groups = [[0, 1], [2], [3, 4, 5]]
+        for method, func in reference.items():
+            g = typed.copy()
+            g.simplify(combine_edges=method)
+            for name in ("int", "float", "bool"):
+                expected = [func([typed.es[i][name] for i in group]) for group in groups]
+                self.assertEqual(g.es[name], expected)
+                self.assertEqual([type(x) for x in g.es[name]],
+                                 [type(x) for x in expected])
+
+        g = typed.copy()
+        g.simplify(combine_edges="max")
+        self.assertEqual(g.es.get_attribute_column("int").type, "int")
+        self.assertEqual(g.es["int"], [3, 7, 9])
+
+        # Columns with missing values take the list-based route
+        g = typed.copy()
+        g.es["float"] = array("d", [1, 2, 3, 4, 5, 6, 7])
+        g.es[2]["float"] = None
+        self.assertRaises(TypeError, g.simplify, combine_edges="sum")
+
+
+class WeightCacheTests(unittest.TestCase):
+    def testInvalidation(self):
+        g = Graph.Ring(4)
+        g.es["weight"] = [1, 2, 3, 4]
+        self.assertEqual(g.strength(weights="weight"), [5, 3, 5, 7])
+        self.assertEqual(g.strength(weights="weight"), [5, 3, 5, 7])
+
+        g.es[0]["weight"] = 10
+        self.assertEqual(g.strength(weights="weight"), [14, 12, 5, 7])
+
+        g.es["weight"] = [1, 1, 1, 1]
+        self.assertEqual(g.strength(weights="weight"), [2, 2, 2, 2])
+
+        g[0, 2] = 5
+        self.assertEqual(g.strength(weights="weight"), [7, 2, 7, 2])
+
+        g.add_edges([(1, 3)])
+        g.es[5]["weight"] = 3
+        self.assertEqual(g.strength(weights="weight"), [7, 5, 7, 5])
+
+        g.delete_edges([0])
+        self.assertEqual(g.strength(weights="weight"), [6, 4, 7, 5])
+
+        del g.es["weight"]
+        self.assertRaises(Exception, g.strength, weights="weight")
+
+    def testCopiesAreIndependent(self):
+        g = Graph.Ring(3)
+        g.es["weight"] = [1, 2, 3]
+        self.assertEqual(g.strength(weights="weight"), [4, 3, 5])
+        g2 = g.copy()
+        g2.es["weight"] = [2, 2, 2]
+        self.assertEqual(g.strength(weights="weight"), [4, 3, 5])
+        self.assertEqual(g2.strength(weights="weight"), [4, 4, 4])
+
+
 class UnicodeAttributeTests(unittest.TestCase):
     def testUnicodeAttributeNameCombination(self):
         g = Graph.Erdos_Renyi(n=9, m=20)
@@ -274,9 +477,11 @@ class UnicodeAttributeTests(unittest.TestCase):
 def suite():
     attribute_suite = unittest.makeSuite(AttributeTests)
     attribute_combination_suite = unittest.makeSuite(AttributeCombinationTests)
+    typed_column_suite = unittest.makeSuite(TypedAttributeColumnTests)
+    weight_cache_suite = unittest.makeSuite(WeightCacheTests)
     unicode_attributes_suite = unittest.makeSuite(UnicodeAttributeTests)
     return unittest.TestSuite([attribute_suite, attribute_combination_suite,
-        unicode_attributes_suite])
+        typed_column_suite, weight_cache_suite, unicode_attributes_suite])
 
 def test():
     runner = unittest.TextTestRunner()
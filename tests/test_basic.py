@@ -1,7 +1,7 @@
 import unittest
 
 from igraph import (
-    ALL, Graph, IN, InternalError, is_degree_sequence,
+    ALL, Graph, IN, InternalError, OUT, is_degree_sequence,
     is_graphical_degree_sequence, Matrix
 )
 
@@ -140,6 +140,33 @@ class BasicTests(unittest.TestCase):
         self.assertEqual(g.vs[2:]["name"], ["spam", "bacon", "eggs", None, None])
         self.assertEqual(g.vs[5:]["color"], ["k", "b"])
 
+    def testVertexNameIndexUpdates(self):
+        g = Graph()
+        for i in range(20):
+            g.add_vertices(["v%d" % i])
+            if i > 0:
+                g.add_edges([("v%d" % (i - 1), "v%d" % i)])
+        self.assertEqual(g.get_edgelist(), [(i, i + 1) for i in range(19)])
+        self.assertEqual(g.vs.find("v7").index, 7)
+
+        # Duplicate names resolve to the vertex with the smallest ID
+        g.add_vertices(["v3"])
+        self.assertEqual(g.vs.find("v3").index, 3)
+
+        # Renaming a vertex takes effect immediately
+        g.vs[3]["name"] = "renamed"
+        self.assertEqual(g.vs.find("v3").index, 20)
+        self.assertEqual(g.vs.find("renamed").index, 3)
+        g.vs[5:7]["name"] = ["five", "six"]
+        self.assertEqual(g.vs.find("six").index, 6)
+        self.assertRaises(ValueError, g.vs.find, "v6")
+
+        # Deleting vertices shifts the IDs
+        g.delete_vertices(["v0", "v1"])
+        self.assertEqual(g.vs.find("renamed").index, 1)
+        self.assertEqual(g.degree(["renamed", "five", "v19"]), [2, 2, 1])
+        self.assertRaises(ValueError, g.degree, ["renamed", "v0"])
+
     def testDeleteVertices(self):
         g = Graph([(0, 1), (1, 2), (2, 3), (0, 2), (3, 4), (4, 5)])
         self.assertEqual(6, g.vcount())
@@ -282,6 +309,75 @@ class BasicTests(unittest.TestCase):
         g.delete_edges()
         self.assertEqual(0, g.ecount())
 
+    def testBatchUpdate(self):
+        g = Graph(3, [(0, 1)])
+        g.vs["name"] = ["a", "b", "c"]
+
+        with g.batch_update() as batch:
+            batch.add_vertices(["d", "e"])
+            batch.add_vertex("f", color="red")
+            batch.add_edges([("a", "d"), ("d", "e"), (2, 5)], {"weight": [1, 2, 3]})
+            batch.add_edge("e", "f", weight=4)
+            batch.set_vertex_attribute("a", "color", "blue")
+            batch.set_edge_attribute(0, "weight", 0)
+            batch.delete_edges([2])
+            self.assertEqual(3, batch.vertices_added)
+            self.assertEqual(4, batch.edges_added)
+            self.assertEqual(3, g.vcount())
+            self.assertEqual(1, g.ecount())
+
+        self.assertEqual(g.get_edgelist(), [(0, 1), (0, 3), (2, 5), (4, 5)])
+        self.assertEqual(g.es["weight"], [0, 1, 3, 4])
+        self.assertEqual(g.vs["name"], list("abcdef"))
+        self.assertEqual(g.vs["color"], ["blue", None, None, None, None, "red"])
+        self.assertEqual(g.vs.find("f").index, 5)
+
+        # Exceptions discard the batch
+        def add_and_fail():
+            with g.batch_update() as batch:
+                batch.add_vertices(2)
+                raise KeyError("spam")
+        self.assertRaises(KeyError, add_and_fail)
+        self.assertEqual(6, g.vcount())
+
+        # Invalid modifications are rejected before they reach the batch
+        batch = g.batch_update()
+        self.assertRaises(ValueError, batch.add_edges, [(0, 10)])
+        self.assertRaises(ValueError, batch.add_edges, [("a", "no-such-vertex")])
+        self.assertRaises(ValueError, batch.add_edges, [(0, 1)], {"weight": [1, 2]})
+        self.assertRaises(ValueError, batch.delete_edges, [4])
+        self.assertEqual(0, batch.edges_added)
+
+        # The graph may not be modified directly while the batch is pending
+        batch.add_edges([(0, 1)])
+        g.add_vertices(1)
+        self.assertRaises(RuntimeError, batch.commit)
+        batch.discard()
+        batch.add_edges([(6, 0)])
+        batch.commit()
+        self.assertEqual(g.get_edgelist()[-1], (0, 6))
+
+        # Deletions are collected and applied at once
+        with g.batch_update() as batch:
+            batch.delete_vertices("f")
+            batch.delete_edges(g.es.select(_within=[0, 1]))
+            batch.add_vertex("g")
+            batch.delete_vertices([7])
+        self.assertEqual(g.get_edgelist(), [(0, 3), (0, 5)])
+        self.assertEqual(g.vs["name"], ["a", "b", "c", "d", "e", None])
+
+    @unittest.skipIf(np is None, "test case depends on NumPy")
+    def testBatchUpdateNumPy(self):
+        g = Graph(4)
+        with g.batch_update() as batch:
+            batch.add_edges(np.array([[0, 1], [1, 2], [2, 3]], dtype=np.int32))
+            batch.add_edges(np.array([[3, 0], [9, 9]], dtype=float)[:1])
+        self.assertEqual(g.get_edgelist(), [(0, 1), (1, 2), (2, 3), (0, 3)])
+
+        batch = g.batch_update()
+        self.assertRaises(ValueError, batch.add_edges, np.array([[0, 4]]))
+        self.assertRaises(ValueError, batch.add_edges, np.array([[0, 1.5]]))
+
     def testClear(self):
         g = Graph.Famous("petersen")
         g["name"] = list("petersen")
@@ -315,6 +411,53 @@ class BasicTests(unittest.TestCase):
         self.assertTrue(eids == [14, 13, 14, 13])
         self.assertRaises(InternalError, g.get_eids, pairs=[(0, 1), (0, 2)])
 
+    def testGraphGetEidsBatch(self):
+        g = Graph.Famous("petersen")
+        pairs = [(0, 1), (5, 0), (1, 6), (4, 9), (8, 6), (0, 2)]
+        expected = [0, 2, 4, 9, 12, -1]
+        self.assertEqual(list(g.get_eids_batch(pairs, index=False)), expected)
+        self.assertEqual(g.memory_usage()["edge_index"], 0)
+        self.assertEqual(list(g.get_eids_batch(pairs)), expected)
+        self.assertTrue(g.memory_usage()["edge_index"] > 0)
+
+        # The other lookups use the index once it exists
+        self.assertEqual(g.get_eid(6, 1), 4)
+        self.assertEqual(g.get_eid(0, 2, error=False), -1)
+        self.assertRaises(InternalError, g.get_eid, 0, 2)
+        self.assertRaises(InternalError, g.get_eid, 0, 11)
+        self.assertTrue(g.are_connected(9, 4))
+        self.assertFalse(g.are_connected(0, 2))
+        self.assertEqual(g.get_eids(pairs=pairs[:5]), expected[:5])
+        self.assertRaises(InternalError, g.get_eids, pairs=pairs)
+
+        # Modifying the edges drops the index
+        g.delete_edges([0])
+        self.assertEqual(g.memory_usage()["edge_index"], 0)
+        self.assertEqual(list(g.get_eids_batch(pairs)),
+                         [-1, 1, 3, 8, 11, -1])
+        g.add_edges([(0, 2)])
+        self.assertEqual(g.memory_usage()["edge_index"], 0)
+        self.assertEqual(g.get_eids_batch([(2, 0)])[0], g.ecount() - 1)
+
+        self.assertRaises(ValueError, g.get_eids_batch, [(0, 10)])
+
+    def testGraphGetEidsBatchDirected(self):
+        g = Graph([(0, 1), (1, 2), (1, 2), (2, 0)], directed=True)
+        pairs = [(0, 1), (1, 0), (1, 2), (0, 2)]
+        self.assertEqual(list(g.get_eids_batch(pairs)), [0, -1, 1, -1])
+        self.assertEqual(list(g.get_eids_batch(pairs, directed=False)),
+                         [0, 0, 1, 3])
+
+    @unittest.skipIf(np is None, "test case depends on NumPy")
+    def testGraphGetEidsBatchNumPy(self):
+        g = Graph.Lattice([10, 10], circular=False)
+        edges = np.array(g.get_edgelist(), dtype=np.int32)
+        eids = g.get_eids_batch(edges[::-1])
+        self.assertEqual(list(eids), list(range(g.ecount() - 1, -1, -1)))
+        self.assertEqual(list(g.get_eids_batch(edges[:, ::-1].astype(float))),
+                         list(range(g.ecount())))
+        self.assertRaises(ValueError, g.get_eids_batch, np.zeros((3, 3)))
+
     def testAdjacency(self):
         g = Graph(4, [(0, 1), (1, 2), (2, 0), (2, 3)], directed=True)
         self.assertTrue(g.neighbors(2) == [0, 1, 3])
@@ -333,6 +476,73 @@ class BasicTests(unittest.TestCase):
         self.assertTrue(g.get_inclist(IN) == [[2], [0], [1], [3]])
         self.assertTrue(g.get_inclist(ALL) == [[0, 2], [1, 0], [2, 3, 1], [3]])
 
+    def testCachedAdjacency(self):
+        edges = [(0, 1), (1, 2), (2, 0), (2, 3), (2, 1), (3, 3), (1, 2), (4, 2)]
+        for directed in (False, True):
+            g = Graph(5, edges, directed=directed)
+            # Fresh copies answer single queries via the C core
+            expected = dict(
+                (mode, [(g.copy().neighbors(v, mode), g.copy().incident(v, mode))
+                        for v in range(g.vcount())])
+                for mode in (OUT, IN, ALL)
+            )
+
+            for _ in range(5):
+                for mode in (OUT, IN, ALL):
+                    result = [(g.neighbors(v, mode), g.incident(v, mode))
+                              for v in range(g.vcount())]
+                    self.assertEqual(result, expected[mode])
+            self.assertTrue(g.memory_usage()["adjacency"] > 0)
+            self.assertEqual(g.successors(2), expected[OUT][2][0])
+            self.assertEqual(g.predecessors(2), expected[IN][2][0])
+            self.assertEqual(g[2, :], g.copy()[2, :])
+
+            # Modifying the graph drops the cached lists
+            g.add_edges([(4, 0)])
+            self.assertEqual(g.memory_usage()["adjacency"], 0)
+            self.assertTrue(0 in g.neighbors(4))
+            g.add_vertices(1)
+            self.assertEqual(g.neighbors(5), [])
+
+    def testNeighborsBatch(self):
+        edges = [(0, 1), (1, 2), (2, 0), (2, 3), (2, 1), (3, 3), (1, 2), (4, 2)]
+        for directed in (False, True):
+            g = Graph(5, edges, directed=directed)
+            for mode in (OUT, IN, ALL):
+                offsets, ids = g.neighbors_batch(mode=mode)
+                offsets, ids = list(offsets), list(ids)
+                self.assertEqual(offsets[0], 0)
+                self.assertEqual(
+                    [offsets[i + 1] - offsets[i] for i in range(g.vcount())],
+                    g.degree(mode=mode),
+                )
+                self.assertEqual(
+                    [ids[offsets[i]:offsets[i + 1]] for i in range(g.vcount())],
+                    [g.neighbors(v, mode) for v in range(g.vcount())],
+                )
+
+                offsets, ids, eids = g.neighbors_batch([4, 2], mode=mode, edges=True)
+                offsets, ids, eids = list(offsets), list(ids), list(eids)
+                for i, v in enumerate([4, 2]):
+                    self.assertEqual(eids[offsets[i]:offsets[i + 1]], g.incident(v, mode))
+                for u, e in zip(ids, eids):
+                    self.assertTrue(u in g.es[e].tuple)
+
+                for order, mindist in ((2, 1), (2, 0), (3, 2)):
+                    offsets, ids = g.neighbors_batch(mode=mode, order=order, mindist=mindist)
+                    offsets, ids = list(offsets), list(ids)
+                    self.assertEqual(
+                        [ids[offsets[i]:offsets[i + 1]] for i in range(g.vcount())],
+                        g.neighborhood(order=order, mode=mode, mindist=mindist),
+                    )
+
+        g = Graph.Ring(5)
+        offsets, ids = g.neighbors_batch([])
+        self.assertEqual((list(offsets), list(ids)), ([0], []))
+        self.assertRaises(ValueError, g.neighbors_batch, order=0)
+        self.assertRaises(ValueError, g.neighbors_batch, order=2, mindist=3)
+        self.assertRaises(ValueError, g.neighbors_batch, order=2, edges=True)
+
     def testMultiplesLoops(self):
         g = Graph.Tree(7, 2)
 
@@ -388,6 +598,30 @@ class BasicTests(unittest.TestCase):
         self.assertTrue(g.is_directed() == g2.is_directed())
         self.assertTrue(g2.custom_data == g.custom_data)
 
+    def testPicklingTypedAttributes(self):
+        import pickle
+        g = Graph.Ring(5, directed=True)
+        g.vs["x"] = [0.5, None, 1.5, 2.5, 3.5]
+        g.es["count"] = [1, 2, 3, 4, 5]
+        g.es["label"] = [None, "b", 3, 4.0, True]
+
+        for protocol in range(2, pickle.HIGHEST_PROTOCOL + 1):
+            g2 = pickle.loads(pickle.dumps(g, protocol))
+            self.assertEqual(g.get_edgelist(), g2.get_edgelist())
+            self.assertTrue(g2.is_directed())
+            for attr in ("x", ):
+                self.assertEqual(g.vs[attr], g2.vs[attr])
+            for attr in ("count", "label"):
+                self.assertEqual(g.es[attr], g2.es[attr])
+
+        if pickle.HIGHEST_PROTOCOL >= 5:
+            buffers = []
+            data = pickle.dumps(g, 5, buffer_callback=buffers.append)
+            g2 = pickle.loads(data, buffers=buffers)
+            self.assertEqual(len(buffers), 1)
+            self.assertEqual(g.get_edgelist(), g2.get_edgelist())
+            self.assertEqual(g.vs["x"], g2.vs["x"])
+
     def testHashing(self):
         g = Graph([(0, 1), (1, 2)])
         self.assertRaises(TypeError, hash, g)
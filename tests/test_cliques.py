@@ -2,9 +2,11 @@ from __future__ import print_function
 
 import unittest
 
+from math import isnan
+
 from igraph import *
 
-from .utils import is_pypy, skipIf, temporary_file
+from .utils import is_pypy, search_iter_limits, skipIf, temporary_file
 
 
 class CliqueTests(unittest.TestCase):
@@ -60,6 +62,48 @@ class CliqueTests(unittest.TestCase):
             self.g.maximal_cliques(max=3, file=fname)
             self.assertEqual([[0, 3, 4], [0, 4, 5]], read_cliques(fname))
 
+    def testCliquesIter(self):
+        limits = search_iter_limits()
+
+        batches = list(self.g.cliques_iter(batch=4, **limits))
+        self.assertTrue(all(len(batch) <= 4 for batch in batches))
+        self.assertEqual(sorted(map(sorted, self.g.cliques())),
+                         sorted(sorted(c) for batch in batches for c in batch))
+
+        batches = list(self.g.maximal_cliques_iter(min=4, batch=1, **limits))
+        self.assertEqual([1, 1], [len(batch) for batch in batches])
+        self.assertEqual([[1, 2, 3, 4], [1, 2, 4, 5]],
+                         sorted(sorted(batch[0]) for batch in batches))
+
+        it = self.g.cliques_iter(max_results=5, batch=2)
+        self.assertEqual(5, sum(len(batch) for batch in it))
+        self.assertEqual(5, it.count)
+
+        it = self.g.maximal_cliques_iter(batch=1, **limits)
+        self.assertEqual(1, len(next(it)))
+        self.assertRaises(RuntimeError, self.g.add_vertices, 1)
+        it.close()
+        self.assertRaises(StopIteration, next, it)
+
+        # The graph is released once the search is closed
+        self.g.add_vertices(1)
+        self.g.delete_vertices(6)
+
+        # Several searches may be in progress at the same time
+        it = self.g.cliques_iter(batch=1, **limits)
+        it2 = self.g.cliques_iter(batch=1, **limits)
+        self.assertEqual(next(it), next(it2))
+        self.assertEqual(len(self.g.cliques()) - 1, sum(len(batch) for batch in it))
+        it2.close()
+
+        self.assertRaises(ValueError, self.g.cliques_iter, batch=0)
+
+        # Without thread-local storage in the C core, unlimited searches
+        # would be collected in memory up front and are refused
+        if limits:
+            self.assertRaises(RuntimeError, self.g.cliques_iter)
+            self.assertRaises(RuntimeError, self.g.maximal_cliques_iter)
+
     def testCliqueNumber(self):
         self.assertEqual(self.g.clique_number(), 4)
         self.assertEqual(self.g.omega(), 4)
@@ -129,6 +173,56 @@ class MotifTests(unittest.TestCase):
         self.assertTrue(len(list(tc)) == 16)
         self.assertTrue(len(tuple(tc)) == 16)
 
+    def testParallelCensus(self):
+        for g in [self.g, Graph.Erdos_Renyi(30, 0.3), Graph.Star(6, mode="in")]:
+            self.assertEqual(list(g.dyad_census(threads=3)), list(g.dyad_census()))
+            if not g.is_directed():
+                continue
+            self.assertEqual(list(g.triad_census(threads=3)), list(g.triad_census()))
+
+    def testParallelMotifs(self):
+        def nan_to_none(counts):
+            return [None if isnan(x) else x for x in counts]
+
+        g = Graph.Erdos_Renyi(40, 0.15)
+        for graph in [self.g, g]:
+            for size in [3, 4]:
+                expected = nan_to_none(graph.motifs_randesu(size=size))
+                for threads in [1, 4]:
+                    self.assertEqual(nan_to_none(
+                        graph.motifs_randesu(size=size, threads=threads)), expected)
+                self.assertEqual(graph.motifs_randesu_no(size=size, threads=2),
+                                 sum(x for x in expected if x is not None))
+
+        cut_prob = [0, 0.3, 0.3]
+        self.assertEqual(
+            nan_to_none(g.motifs_randesu(cut_prob=cut_prob, threads=1, seed=42)),
+            nan_to_none(g.motifs_randesu(cut_prob=cut_prob, threads=3, seed=42)))
+        self.assertRaises(ValueError, g.motifs_randesu, size=5, threads=2)
+        self.assertRaises(ValueError, g.motifs_randesu, threads=2,
+                          callback=lambda *args: False)
+
+    def testMotifSample(self):
+        g = Graph.Erdos_Renyi(50, 0.2)
+        exact = g.motifs_randesu()
+
+        est, lower, upper = g.motifs_randesu_sample(samples=200, threads=2, seed=1)
+        self.assertEqual(len(est), len(exact))
+        for e, l, u, x in zip(est, lower, upper, exact):
+            if isnan(x):
+                self.assertTrue(isnan(e) and isnan(l) and isnan(u))
+            else:
+                self.assertTrue(l <= e <= u)
+        self.assertEqual(
+            g.motifs_randesu_sample(samples=200, threads=1, seed=1), (est, lower, upper))
+
+        rounds = []
+        def callback(done, estimates, lower, upper):
+            rounds.append(done)
+            return True
+        g.motifs_randesu_sample(samples=1000, callback=callback)
+        self.assertEqual(len(rounds), 1)
+
 class CliqueBenchmark(object):
     """This is a benchmark, not a real test case. You can run it
     using:
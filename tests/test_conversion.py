@@ -110,12 +110,115 @@ class GraphRepresentationTests(unittest.TestCase):
             g.get_adjacency_sparse() == np.array(g.get_adjacency().data)
         ))
 
+    def testGetAdjacencyArrays(self):
+        def to_dense(n, rows, cols, data):
+            result = [[0] * n for _ in range(n)]
+            for i, j, value in zip(rows, cols, data):
+                result[i][j] += value
+            return result
+
+        def csr_rows(indptr):
+            return [i for i in range(len(indptr) - 1)
+                    for _ in range(indptr[i], indptr[i+1])]
+
+        # Undirected case with a loop and a multi-edge
+        g = Graph([(0, 1), (1, 2), (2, 2), (0, 1), (3, 1)])
+        g.es["weight"] = [1.5, 2, 3, 4, 5]
+        indptr, indices, data = g.get_adjacency_arrays()
+        self.assertTrue(isinstance(indptr, AttributeColumn))
+        self.assertEqual(indptr.tolist(), [0, 2, 6, 8, 9])
+        self.assertEqual(indices.tolist(), [1, 1, 0, 0, 2, 3, 1, 2, 1])
+        self.assertEqual(
+            to_dense(4, csr_rows(indptr.tolist()), indices.tolist(), data.tolist()),
+            [[0, 2, 0, 0], [2, 0, 1, 1], [0, 1, 1, 0], [0, 1, 0, 0]])
+
+        rows, cols, data = g.get_adjacency_arrays("coo", weights="weight")
+        self.assertEqual(rows.tolist(), csr_rows(indptr.tolist()))
+        self.assertEqual(cols.tolist(), indices.tolist())
+        self.assertEqual(data.tolist(), [1.5, 4, 1.5, 4, 2, 5, 2, 3, 5])
+
+        # Directed case
+        g = Graph.Tree(6, 3, "tree_out")
+        g.add_edges([(0, 1), (1, 0), (4, 4)])
+        for mode in ("out", "in"):
+            rows, cols, data = g.get_adjacency_arrays("coo", mode=mode)
+            if mode == "in":
+                rows, cols = cols, rows
+            self.assertEqual(
+                to_dense(6, rows.tolist(), cols.tolist(), data.tolist()),
+                g.get_adjacency().data)
+        indptr, indices, _ = g.get_adjacency_arrays(mode="all")
+        self.assertEqual(indptr.tolist(), [0, 5, 10, 11, 12, 14, 15])
+        self.assertEqual(memoryview(indices)[5:10].tolist(), [0, 0, 0, 4, 5])
+
+
+class BufferReturnTypeTests(unittest.TestCase):
+    def testVectorBuffer(self):
+        g = Graph.Star(5)
+        buf = g.degree(return_type="buffer")
+        self.assertTrue(isinstance(buf, Buffer))
+        self.assertEqual(len(buf), 5)
+        self.assertEqual(buf.shape, (5,))
+        self.assertEqual(buf.tolist(), [4.0, 1.0, 1.0, 1.0, 1.0])
+        self.assertEqual(memoryview(buf).tolist(), g.degree())
+        self.assertEqual(g.degree(return_type="list"), g.degree())
+        self.assertRaises(ValueError, g.degree, return_type="spam")
+
+    def testMatrixBuffer(self):
+        g = Graph.Ring(4)
+        g.add_vertices(1)
+        buf = g.shortest_paths(target=[0, 1, 4], return_type="buffer")
+        self.assertEqual(buf.shape, (5, 3))
+        self.assertEqual(buf.tolist(), g.shortest_paths(target=[0, 1, 4]))
+
+    def testNumPyBuffer(self):
+        try:
+            import numpy as np
+        except ImportError:
+            self.skipTest("NumPy is a dependency of this test.")
+
+        g = Graph.Lattice([3, 4], circular=False)
+        arr = np.asarray(g.betweenness(return_type="buffer"))
+        self.assertTrue(np.allclose(arr, g.betweenness()))
+        arr = np.asarray(g.shortest_paths(return_type="buffer"))
+        self.assertEqual(arr.shape, (12, 12))
+        self.assertTrue(np.all(arr == np.array(g.shortest_paths())))
+
+
+class BufferInputTests(unittest.TestCase):
+    def testWeightsFromArray(self):
+        from array import array
+
+        g = Graph.Ring(5)
+        weights = [1.5, 2, 3, 4, 5]
+        expected = g.strength(weights=weights)
+        self.assertEqual(g.strength(weights=array("d", weights)), expected)
+        self.assertEqual(g.strength(weights=array("f", weights)), expected)
+        self.assertEqual(g.strength(weights=array("i", [2] * 5)), [4.0] * 5)
+
+        buf = g.degree(return_type="buffer")
+        self.assertEqual(g.strength(weights=buf), [4.0] * 5)
+
+    def testIntegerVectorFromArray(self):
+        from array import array
+
+        g = Graph.Ring(6)
+        g.contract_vertices(array("l", [0, 0, 1, 1, 2, 2]))
+        self.assertEqual(g.vcount(), 3)
+        self.assertEqual(sorted(g.get_edgelist()), [(0, 0), (0, 1), (0, 2), (1, 1), (1, 2), (2, 2)])
+
+        g = Graph.Ring(6)
+        self.assertRaises(ValueError, g.contract_vertices, array("l", [0, -1, 1, 1, 2, 2]))
+        self.assertEqual(g.vcount(), 6)
+
 
 def suite():
     direction_suite = unittest.makeSuite(DirectedUndirectedTests)
     representation_suite = unittest.makeSuite(GraphRepresentationTests)
+    buffer_suite = unittest.makeSuite(BufferReturnTypeTests)
+    buffer_input_suite = unittest.makeSuite(BufferInputTests)
     return unittest.TestSuite([direction_suite,
-        representation_suite])
+        representation_suite, buffer_suite, buffer_input_suite])
 
 def test():
     runner = unittest.TextTestRunner()
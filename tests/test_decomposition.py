@@ -351,6 +351,40 @@ class CommunityTests(unittest.TestCase):
                                 initial_membership=[0]*G.vcount())
         self.assertMembershipsEqual(cl, [0, 1, 0, 0, 0, 1, 1, 1])
 
+    def testEnsemble(self):
+        g = Graph.Full(5) + Graph.Full(5) + Graph.Full(5)
+        g += [(0,5), (5,10), (10, 0)]
+
+        for method in ("leiden", "multilevel", "label_propagation", "infomap"):
+            memberships, modularity = g.community_ensemble(method, n_runs=6,
+                                                           seed=42)
+            self.assertEqual(memberships.shape, (6, g.vcount()))
+            self.assertEqual(modularity.shape, (6,))
+            for row, q in zip(memberships.tolist(), modularity.tolist()):
+                row = [int(x) for x in row]
+                self.assertAlmostEqual(g.modularity(row), q, places=6)
+
+            # Results depend on the seed only, not on the number of threads
+            memberships2, modularity2 = g.community_ensemble(method, n_runs=6,
+                                                             threads=3, seed=42)
+            self.assertEqual(memberships.tolist(), memberships2.tolist())
+            self.assertEqual(modularity.tolist(), modularity2.tolist())
+
+        memberships, _ = g.community_ensemble("multilevel", n_runs=3, seed=1)
+        for row in memberships.tolist():
+            self.assertMembershipsEqual([int(x) for x in row],
+                                        [0,0,0,0,0,1,1,1,1,1,2,2,2,2,2])
+
+        # The default random number generator is restored after the runs
+        random.seed(7)
+        expected = Graph.Erdos_Renyi(20, 0.3).get_edgelist()
+        random.seed(7)
+        g.community_ensemble("infomap", n_runs=4, threads=2, seed=3)
+        self.assertEqual(Graph.Erdos_Renyi(20, 0.3).get_edgelist(), expected)
+
+        self.assertRaises(ValueError, g.community_ensemble, "spam")
+        self.assertRaises(ValueError, g.community_ensemble, threads=0)
+
 class CohesiveBlocksTests(unittest.TestCase):
     def genericTests(self, cbs):
         self.assertTrue(isinstance(cbs, CohesiveBlocks))
@@ -274,6 +274,20 @@ class EdgeSeqTests(unittest.TestCase):
         self.assertTrue(len(g.es(betweenness_gt=10)) < 2000)
         self.assertTrue(len(g.es(betweenness_gt=10, parity=0)) < 2000)
 
+    def testKeywordFilteringSelectOnColumns(self):
+        g = Graph.Ring(6)
+        g.es["weight"] = [0.5, 2.0, None, 4.0, 2.0, 1.5]
+        for as_column in (False, True):
+            if as_column:
+                g.es.get_attribute_column("weight")
+            self.assertEqual(g.es.select(weight=2.0).indices, [1, 4])
+            self.assertEqual(g.es.select(weight_ne=2).indices, [0, 2, 3, 5])
+            self.assertEqual(g.es.select(weight_in=[0.5, 4]).indices, [0, 3])
+            self.assertEqual(g.es.select(weight_notin=[0.5, 4]).indices,
+                             [1, 2, 4, 5])
+            self.assertEqual(g.es.select(weight_in=[None]).indices, [2])
+            self.assertEqual(g.es[3:].select(weight_eq=2).indices, [4])
+
     def testSourceTargetFiltering(self):
         g = Graph.Barabasi(1000, 2, directed=True)
         es1 = set(e.source for e in g.es.select(_target_in=[2, 4]))
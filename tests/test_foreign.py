@@ -197,6 +197,92 @@ class ForeignTests(unittest.TestCase):
                 self._testNCOLOrLGL(func=Graph.Read_Lgl, fname=fp,
                                     can_be_reopened=False)
 
+    def testReadFromStream(self):
+        data = b"eggs spam 1\nham eggs 2\nham bacon\nbacon spam 3\nspam spam\n"
+        self._testNCOLOrLGL(func=Graph.Read_Ncol, fname=io.BytesIO(data),
+                            can_be_reopened=False)
+
+        import gzip
+        buf = io.BytesIO()
+        with gzip.GzipFile(fileobj=buf, mode="wb") as fp:
+            fp.write(b"0 1\n1 2\n2 0\n" * 1000)
+        buf.seek(0)
+        with gzip.GzipFile(fileobj=buf, mode="rb") as fp:
+            g = Graph.Read_Edgelist(fp, directed=False)
+        self.assertEqual(g.vcount(), 3)
+        self.assertEqual(g.ecount(), 3000)
+        self.assertFalse(g.is_directed())
+
+        class FailingStream(io.RawIOBase):
+            def readable(self):
+                return True
+
+            def readinto(self, buf):
+                raise ValueError("stream failed")
+
+        self.assertRaises(ValueError, Graph.Read_Edgelist, FailingStream())
+
+    def testWriteToStream(self):
+        g = Graph([(0, 1), (1, 2), (2, 0)], directed=True)
+        g["title"] = "A & B"
+        g.vs["name"] = ["a", "<b>", "c"]
+        g.vs["size"] = [1.5, None, 3]
+        g.vs["flag"] = [True, False, True]
+        g.es["weight"] = [1, 2, 3]
+
+        with temporary_file() as tmpfname:
+            g.write_graphml(tmpfname)
+            with open(tmpfname, "rb") as fp:
+                expected = fp.read()
+
+        # Tiny buffers flush the output many times while writing
+        buf = io.BytesIO()
+        g.write_graphml(buf, buffer_size=7)
+        self.assertEqual(expected, buf.getvalue())
+
+        data = expected.decode("utf-8")
+        self.assertTrue('<key id="g_title" for="graph" attr.name="title" '
+                        'attr.type="string"/>' in data)
+        self.assertTrue('<key id="v_flag" for="node" attr.name="flag" '
+                        'attr.type="boolean"/>' in data)
+        self.assertTrue('<data key="g_title">A &amp; B</data>' in data)
+        self.assertTrue('<data key="v_name">&lt;b&gt;</data>' in data)
+        self.assertTrue('<data key="v_size">1.5</data>' in data)
+        self.assertEqual(2, data.count('<data key="v_size">'))
+        self.assertTrue('<edge source="n2" target="n0">\n'
+                        '      <data key="e_weight">3</data>' in data)
+
+        buf = io.StringIO()
+        g.write_gml(buf, creator="test", buffer_size=16)
+        lines = buf.getvalue().split("\n")
+        self.assertEqual(['Creator "test"', 'Version 1', 'graph', '[',
+                          '  directed 1', '  title "A & B"'], lines[:6])
+        self.assertTrue('    size NaN' in lines)
+        self.assertTrue('    flag 1' in lines)
+
+        import gzip
+        buf = io.BytesIO()
+        with gzip.GzipFile(fileobj=buf, mode="wb") as fp:
+            g.write_ncol(fp)
+        buf.seek(0)
+        with gzip.GzipFile(fileobj=buf, mode="rb") as fp:
+            self.assertEqual(b"a <b> 1\n<b> c 2\nc a 3\n", fp.read())
+
+        self.assertRaises(ValueError, g.write_edgelist, io.BytesIO(),
+                          buffer_size=0)
+
+        g.vs[0]["name"] = "\x01"
+        self.assertRaises(ValueError, g.write_graphml, io.BytesIO())
+
+        class FailingStream(io.RawIOBase):
+            def writable(self):
+                return True
+
+            def write(self, data):
+                raise ValueError("stream failed")
+
+        self.assertRaises(ValueError, g.write_edgelist, FailingStream())
+
     def testAdjacency(self):
         with temporary_file(u"""\
         # Test comment line
@@ -233,6 +319,72 @@ class ForeignTests(unittest.TestCase):
                 not g.is_directed())
             g.write_pickle(tmpfname)
 
+    def testBinary(self):
+        g = Graph([(0, 1), (1, 2), (2, 0), (2, 3)], directed=True)
+        g["name"] = "test"
+        g.vs["name"] = ["a", "b", "c", "d"]
+        g.vs["size"] = [1, 2, None, 4]
+        g.es["weight"] = [0.5, 1.5, 2.5, 3.5]
+        g.es["flag"] = [True, False, True, None]
+        g.es["color"] = memoryview(b"\x01\x02\x03\x04").cast("b") \
+                if sys.version_info >= (3, 3) else [1, 2, 3, 4]
+
+        for compress in (False, True):
+            with temporary_file() as tmpfname:
+                g.write_binary(tmpfname, compress=compress)
+                g2 = Graph.Read_Binary(tmpfname)
+                self.assertTrue(isinstance(g2, Graph))
+                self.assertTrue(g2.is_directed())
+                self.assertEqual(g.get_edgelist(), g2.get_edgelist())
+                self.assertEqual(g2["name"], "test")
+                self.assertEqual(g2.vs["name"], ["a", "b", "c", "d"])
+                self.assertEqual(g2.vs["size"], [1, 2, None, 4])
+                self.assertEqual(g2.es["weight"], [0.5, 1.5, 2.5, 3.5])
+                self.assertEqual(g2.es["flag"], [True, False, True, None])
+                self.assertEqual(g2.es["color"], [1, 2, 3, 4])
+
+        with temporary_file() as tmpfname:
+            g.write(tmpfname, format="binary")
+            g2 = Graph.Read(tmpfname, format="binary")
+            self.assertEqual(g.get_edgelist(), g2.get_edgelist())
+
+        with temporary_file(b"not a graph", "wb", binary=True) as tmpfname:
+            self.assertRaises(ValueError, Graph.Read_Binary, tmpfname)
+
+    def testSnapshot(self):
+        g = Graph.Famous("zachary")
+        g.vs["name"] = ["v%d" % i for i in range(g.vcount())]
+        g.es["weight"] = [float(i) for i in range(g.ecount())]
+
+        with temporary_file() as tmpfname:
+            g.write_snapshot(tmpfname)
+
+            g2 = Graph.Open_Snapshot(tmpfname)
+            self.assertTrue(isinstance(g2, Graph))
+            self.assertFalse(g2.is_directed())
+            self.assertEqual(g.get_edgelist(), g2.get_edgelist())
+            self.assertEqual(g.degree(), g2.degree())
+            self.assertEqual(g.neighbors(0), g2.neighbors(0))
+            self.assertEqual(g.vs["name"], g2.vs["name"])
+            self.assertEqual(g.es["weight"], g2.es["weight"])
+            self.assertEqual(g.shortest_paths(0, weights="weight"),
+                    g2.shortest_paths(0, weights="weight"))
+
+            # Attributes can be changed, the structure cannot
+            g2.vs["color"] = "red"
+            self.assertRaises(TypeError, g2.add_vertices, 1)
+            self.assertRaises(TypeError, g2.add_edges, [(0, 1)])
+            self.assertRaises(TypeError, g2.delete_edges, [0])
+            self.assertRaises(TypeError, g2.simplify)
+
+            g3 = g2.copy()
+            g3.add_vertices(1)
+            self.assertEqual(g3.vcount(), g.vcount() + 1)
+            del g2, g3
+
+        with temporary_file(b"not a snapshot", "wb", binary=True) as tmpfname:
+            self.assertRaises(ValueError, Graph.Open_Snapshot, tmpfname)
+
 
 def suite():
     foreign_suite = unittest.makeSuite(ForeignTests)
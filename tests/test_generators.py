@@ -1,6 +1,9 @@
+import os
 import unittest
 from igraph import *
 
+from .utils import temporary_file
+
 try:
     import numpy as np
     import pandas as pd
@@ -8,6 +11,11 @@ except ImportError:
     np = None
     pd = None
 
+try:
+    import pyarrow as pa
+except ImportError:
+    pa = None
+
 
 class GeneratorTests(unittest.TestCase):
     def testStar(self):
@@ -154,6 +162,58 @@ class GeneratorTests(unittest.TestCase):
         pref_matrix[0][1] = 0.7
         self.assertRaises(InternalError, Graph.SBM, 60, pref_matrix, types)
 
+    def testParallelGenerators(self):
+        # The result depends on the seed only, not on the number of threads
+        g1 = Graph.Erdos_Renyi(3000, 0.01, seed=42, threads=1)
+        g2 = Graph.Erdos_Renyi(3000, 0.01, seed=42, threads=3)
+        self.assertEqual(g1.get_edgelist(), g2.get_edgelist())
+        self.assertTrue(g1.is_simple())
+        self.assertTrue(40000 < g1.ecount() < 50000)
+        g3 = Graph.Erdos_Renyi(3000, 0.01, seed=43, threads=3)
+        self.assertNotEqual(g1.get_edgelist(), g3.get_edgelist())
+        self.assertRaises(ValueError, Graph.Erdos_Renyi, 100, m=10, seed=42)
+
+        g = Graph.SBM(60, [[0.5, 0, 0], [0, 0, 0.5], [0, 0.5, 0]],
+                      [20, 20, 20], directed=True, seed=42, threads=2)
+        self.assertTrue(g.is_directed())
+        self.assertTrue(all(
+            (e.source < 20) == (e.target < 20) and e.source != e.target
+            for e in g.es
+        ))
+
+        g = Graph.Static_Fitness(500, range(1, 101), multiple=True, seed=42)
+        self.assertEqual(100, g.vcount())
+        self.assertEqual(500, g.ecount())
+        self.assertEqual(0, sum(g.is_loop()))
+        self.assertRaises(ValueError, Graph.Static_Fitness, 500,
+                          range(1, 101), seed=42)
+
+        g1 = Graph.Static_Power_Law(1000, 3000, 2.5, multiple=True, seed=1)
+        g2 = Graph.Static_Power_Law(1000, 3000, 2.5, multiple=True, seed=1,
+                                    threads=4)
+        self.assertEqual(3000, g1.ecount())
+        self.assertEqual(g1.get_edgelist(), g2.get_edgelist())
+
+        g = Graph.Watts_Strogatz(1, 100, 2, 0, multiple=True, seed=42)
+        self.assertTrue(g.isomorphic(Graph.Lattice([100], nei=2, circular=True)))
+        self.assertRaises(ValueError, Graph.Watts_Strogatz, 2, 10, 1, 0.1,
+                          multiple=True, seed=42)
+
+    def testParallelGeneratorsToFile(self):
+        g = Graph.Erdos_Renyi(500, 0.02, seed=42)
+
+        with temporary_file() as fname:
+            count = Graph.Erdos_Renyi(500, 0.02, seed=42, file=fname)
+            self.assertEqual(g.ecount(), count)
+            g2 = Graph.Read_Edgelist(fname, directed=False)
+            self.assertEqual(g.get_edgelist(), g2.get_edgelist())
+
+        with temporary_file() as fname:
+            count = Graph.Erdos_Renyi(500, 0.02, seed=42, file=fname,
+                                      format="binary", threads=2)
+            self.assertEqual(g.ecount(), count)
+            self.assertEqual(16 * count, os.path.getsize(fname))
+
     def testWeightedAdjacency(self):
         mat = [[0, 1, 2, 0], [2, 0, 0, 0], [0, 0, 2.5, 0], [0, 1, 0, 0]]
 
@@ -172,6 +232,19 @@ class GeneratorTests(unittest.TestCase):
         self.assertTrue(el == [(0,1), (0,2), (1,0), (3,1)])
         self.assertTrue(g.es["w0"] == [1, 2, 2, 1])
 
+    @unittest.skipIf(np is None, "test case depends on NumPy")
+    def testWeightedAdjacencyNumPy(self):
+        mat = [[0, 1, 2, 0], [2, 0, 0, 0], [0, 0, 2.5, 0], [0, 1, 0, 0]]
+
+        for arr in (np.array(mat), np.asfortranarray(mat), np.array(mat)[:, ::-1][:, ::-1]):
+            g = Graph.Weighted_Adjacency(arr, attr="w0")
+            self.assertTrue(g.get_edgelist() == [(0,1), (0,2), (1,0), (2,2), (3,1)])
+            self.assertTrue(g.es["w0"] == [1, 2, 2, 2.5, 1])
+
+        bool_mat = np.array(mat) > 0
+        g = Graph.Adjacency(bool_mat)
+        self.assertTrue(g.get_edgelist() == Graph.Adjacency(bool_mat.tolist()).get_edgelist())
+
     @unittest.skipIf((np is None) or (pd is None), "test case depends on NumPy/Pandas")
     def testDataFrame(self):
         edges = pd.DataFrame(
@@ -210,6 +283,82 @@ class GeneratorTests(unittest.TestCase):
         g = Graph.DataFrame(edges, use_vids=True)
         self.assertTrue(g.vcount() == 7)
 
+    def testFromColumns(self):
+        from array import array
+
+        g = Graph.from_columns(["C", "A", "B"], ["A", "B", "D"],
+                edge_attrs={"weight": [0.4, 0.1, 0.7]})
+        self.assertEqual(g.vs["name"], ["C", "A", "B", "D"])
+        self.assertEqual(g.get_edgelist(), [(0, 1), (1, 2), (2, 3)])
+        self.assertEqual(g.es["weight"], [0.4, 0.1, 0.7])
+        self.assertFalse(g.is_directed())
+        other = Graph.TupleList([("C", "A", 0.4), ("A", "B", 0.1),
+            ("B", "D", 0.7)], weights=True)
+        self.assertEqual(other.vs["name"], g.vs["name"])
+        self.assertEqual(other.get_edgelist(), g.get_edgelist())
+
+        # Integer buffers are vertex IDs unless asked otherwise
+        g = Graph.from_columns(array("i", [0, 2]), array("q", [3, 3]), directed=True)
+        self.assertEqual((g.vcount(), g.get_edgelist()), (4, [(0, 3), (2, 3)]))
+        self.assertTrue(g.is_directed())
+        self.assertFalse("name" in g.vertex_attributes())
+        g = Graph.from_columns(array("q", [10, 2 ** 40]), array("q", [2 ** 40, 7]),
+                vertex_names=True, vertex_name_attr="key")
+        self.assertEqual(g.vs["key"], [10, 2 ** 40, 7])
+        self.assertEqual(g.get_edgelist(), [(0, 1), (1, 2)])
+
+        g = Graph.from_columns(["a", "b"], ["b", "a"], vertex_names=["x", "b", "a"])
+        self.assertEqual(g.vs["name"], ["x", "b", "a"])
+        self.assertEqual(g.get_edgelist(), [(2, 1), (1, 2)])
+
+        self.assertRaises(KeyError, Graph.from_columns, ["a"], ["c"],
+                vertex_names=["a", "b"])
+        self.assertRaises(ValueError, Graph.from_columns, ["a"], ["b"],
+                vertex_names=["a", "b", "a"])
+        self.assertRaises(ValueError, Graph.from_columns, ["a", "b"], ["b"])
+        self.assertRaises(ValueError, Graph.from_columns, array("i", [-1]),
+                array("i", [0]))
+        self.assertRaises(ValueError, Graph.from_columns, ["a"], ["b"],
+                edge_attrs={"weight": [1, 2]})
+
+        g = Graph.from_columns([], [])
+        self.assertEqual((g.vcount(), g.ecount()), (0, 0))
+
+    @unittest.skipIf(np is None, "test case depends on NumPy")
+    def testFromColumnsNumPy(self):
+        weights = np.array([0.5, 1.5, 2.5])
+        g = Graph.from_columns(np.array([3, 1, 0]), np.array([1, 2, 2]),
+                edge_attrs={"weight": weights, "label": np.array(["x", "y", "z"])})
+        self.assertEqual(g.get_edgelist(), [(1, 3), (1, 2), (0, 2)])
+        self.assertEqual(g.es["weight"], [0.5, 1.5, 2.5])
+        self.assertEqual(g.es["label"], ["x", "y", "z"])
+
+        g = Graph.from_columns(np.array(["u", "v"]), np.array(["v", "w"]))
+        self.assertEqual(g.vs["name"], ["u", "v", "w"])
+
+    @unittest.skipIf(pa is None, "test case depends on PyArrow")
+    def testFromColumnsArrow(self):
+        table = pa.table({
+            "source": ["a", "b", "c", "a"],
+            "target": ["b", "c", "", "c"],
+            "weight": [1.0, 2.0, 3.0, 4.0],
+        })
+        g = Graph.from_columns(table.column("source"), table.column("target"),
+                edge_attrs={"weight": table.column("weight")}, directed=True)
+        self.assertEqual(g.vs["name"], ["a", "b", "c", ""])
+        self.assertEqual(g.get_edgelist(), [(0, 1), (1, 2), (2, 3), (0, 2)])
+        self.assertEqual(g.es["weight"], [1.0, 2.0, 3.0, 4.0])
+
+        # Sliced arrays start at an offset within their buffers
+        source = pa.array(["x", "y", "z", "x"]).slice(1)
+        target = pa.array(["q", "z", "x", "y"], type=pa.large_string()).slice(1)
+        g = Graph.from_columns(source, target)
+        self.assertEqual(g.vs["name"], ["y", "z", "x"])
+        self.assertEqual(g.get_edgelist(), [(0, 1), (1, 2), (2, 0)])
+
+        self.assertRaises(ValueError, Graph.from_columns, pa.array(["a", None]),
+                pa.array(["b", "c"]))
+
 def suite():
     generator_suite = unittest.makeSuite(GeneratorTests)
     return unittest.TestSuite([generator_suite])
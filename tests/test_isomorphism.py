@@ -3,6 +3,8 @@ from igraph import *
 from itertools import permutations
 from random import shuffle
 
+from .utils import search_iter_limits
+
 def node_compat(g1, g2, v1, v2):
     """Node compatibility function for isomorphism tests"""
     return g1.vs[v1]["color"] == g2.vs[v2]["color"]
@@ -230,6 +232,29 @@ class SubisomorphismTests(unittest.TestCase):
         self.assertTrue(g.count_subisomorphisms_vf2(g2, edge_color1="color", edge_color2="color") == 2)
         self.assertTrue(g.count_subisomorphisms_vf2(g2, edge_compat_fn=edge_compat) == 2)
 
+    def testGetSubisomorphismsVF2Iter(self):
+        g = Graph.Lattice([3,3], circular=False)
+        g2 = Graph.Lattice([2,2], circular=False)
+        limits = search_iter_limits()
+        maps = [m for batch in g.get_subisomorphisms_vf2_iter(g2, batch=5, **limits)
+                for m in batch]
+        self.assertEqual(sorted(g.get_subisomorphisms_vf2(g2)), sorted(maps))
+        self.assertEqual([], list(g2.get_subisomorphisms_vf2_iter(g, **limits)))
+
+        g.vs["color"] = [0,0,0,0,1,0,0,0,0]
+        g2.vs["color"] = [1,0,0,0]
+        maps = [m for batch in g.get_subisomorphisms_vf2_iter(g2, "color", "color",
+                                                                **limits)
+                for m in batch]
+        self.assertEqual(4*2, len(maps))
+        maps = [m for batch in g.get_subisomorphisms_vf2_iter(g2,
+                node_compat_fn=node_compat, **limits) for m in batch]
+        self.assertEqual(4*2, len(maps))
+
+        it = g.get_subisomorphisms_vf2_iter(g2, max_results=3, batch=2)
+        self.assertEqual([2, 1], [len(batch) for batch in it])
+
+
 class PermutationTests(unittest.TestCase):
     def testCanonicalPermutation(self):
         # Simple case: two ring graphs
@@ -267,6 +292,54 @@ class PermutationTests(unittest.TestCase):
         self.assertTrue(g3.vcount() == g4.vcount())
         self.assertTrue(sorted(g3.get_edgelist()) == sorted(g4.get_edgelist()))
 
+    def testCanonicalForm(self):
+        g1 = Graph(4, [(0, 1), (1, 2), (2, 3), (3, 0), (0, 2)])
+        g2 = g1.permute_vertices([2, 0, 3, 1])
+        g3 = Graph(4, [(0, 1), (1, 2), (2, 3), (3, 0), (1, 3)])
+        g4 = Graph.Star(4)
+
+        form = g1.canonical_form_bytes()
+        self.assertTrue(isinstance(form, bytes))
+        self.assertEqual(len(form), 4 * (3 + 2 * 5))
+        self.assertEqual(form, g2.canonical_form_bytes())
+        self.assertEqual(form, g3.canonical_form_bytes())
+        self.assertNotEqual(form, g4.canonical_form_bytes())
+        self.assertEqual(g1.canonical_hash(), g3.canonical_hash())
+        self.assertNotEqual(g1.canonical_hash(), g4.canonical_hash())
+        self.assertTrue(g1.canonical_hash() >= 0)
+
+        # Cached until the graph changes
+        self.assertTrue(g1.memory_usage()["canonical_forms"] > 0)
+        g1.add_edges([(1, 3)])
+        self.assertNotEqual(form, g1.canonical_form_bytes())
+        self.assertEqual(g1.canonical_form_bytes(),
+                         Graph.Full(4).canonical_form_bytes())
+
+        # Colors are part of the form
+        g2.vs["color"] = [0, 1, 0, 1]
+        g3.vs["color"] = [0, 1, 0, 1]
+        self.assertNotEqual(g2.canonical_form_bytes(color="color"),
+                            g3.canonical_form_bytes(color="color"))
+        g3.vs["color"] = [0, 0, 1, 1]
+        self.assertEqual(g2.canonical_form_bytes(color="color"),
+                         g3.canonical_form_bytes(color="color"))
+        self.assertNotEqual(g2.canonical_form_bytes(color="color"),
+                            g2.canonical_form_bytes())
+
+        self.assertRaises(InternalError,
+                          Graph([(0, 1), (0, 1)]).canonical_form_bytes)
+
+        # Batch version
+        graphs = [g1, g2, g3, g4, Graph.Full(4)]
+        forms = canonical_forms(graphs)
+        self.assertEqual(forms, [g.canonical_form_bytes() for g in graphs])
+        hashes = canonical_forms(graphs, hashes=True, threads=2)
+        self.assertEqual(hashes, [g.canonical_hash() for g in graphs])
+        self.assertEqual(canonical_forms([g2, g3], color="color"),
+                         [g2.canonical_form_bytes(color="color")] * 2)
+        self.assertEqual(canonical_forms([]), [])
+        self.assertRaises(TypeError, canonical_forms, [g1, None])
+
     def testPermuteVertices(self):
         g1 = Graph(8, [(0, 4), (0, 5), (0, 6), \
                        (1, 4), (1, 5), (1, 7), \
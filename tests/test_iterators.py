@@ -20,6 +20,25 @@ class IteratorTests(unittest.TestCase):
              (4, 2, 1), (5, 2, 2), (6, 2, 2),
              (7, 3, 3), (8, 3, 3), (9, 3, 4)])
 
+    def testBFSIterBatched(self):
+        g = Graph.Tree(10, 2)
+        batches = list(g.bfsiter(0, batch=4))
+        self.assertEqual([len(vids) for vids, _, _ in batches], [4, 4, 2])
+        vids = sum((vids.tolist() for vids, _, _ in batches), [])
+        dists = sum((dists.tolist() for _, dists, _ in batches), [])
+        parents = sum((parents.tolist() for _, _, parents in batches), [])
+        self.assertEqual(vids, list(range(10)))
+        self.assertEqual(dists, [0, 1, 1, 2, 2, 2, 2, 3, 3, 3])
+        self.assertEqual(parents, [-1, 0, 0, 1, 1, 2, 2, 3, 3, 4])
+
+        vs = [v.index for v in g.bfsiter(0, max_depth=2)]
+        self.assertEqual(vs, [0, 1, 2, 3, 4, 5, 6])
+        (vids, dists, _), = list(g.bfsiter(1, mode=ALL, batch=100, max_depth=1))
+        self.assertEqual(sorted(vids.tolist()), [0, 1, 3, 4])
+
+        self.assertRaises(ValueError, g.bfsiter, 0, batch=0)
+        self.assertRaises(ValueError, g.bfsiter, 0, max_depth=-1)
+
     def testDFS(self):
         g = Graph.Tree(10, 2)
         vs, ps = g.dfs(0)
@@ -38,6 +57,20 @@ class IteratorTests(unittest.TestCase):
              (8, 3, 3), (4, 2, 1), (9, 3, 4),
              (2, 1, 0), (5, 2, 2), (6, 2, 2)])
 
+    def testDFSIterBatched(self):
+        g = Graph.Tree(10, 2)
+        batches = list(g.dfsiter(0, batch=3))
+        self.assertEqual([len(vids) for vids, _, _ in batches], [3, 3, 3, 1])
+        vids = sum((vids.tolist() for vids, _, _ in batches), [])
+        dists = sum((dists.tolist() for _, dists, _ in batches), [])
+        parents = sum((parents.tolist() for _, _, parents in batches), [])
+        self.assertEqual(vids, [0, 1, 3, 7, 8, 4, 9, 2, 5, 6])
+        self.assertEqual(dists, [0, 1, 2, 3, 3, 2, 3, 1, 2, 2])
+        self.assertEqual(parents, [-1, 0, 1, 3, 3, 1, 4, 0, 2, 2])
+
+        vs = [v.index for v in g.dfsiter(0, max_depth=1)]
+        self.assertEqual(vs, [0, 1, 2])
+
 
 def suite():
     iterator_suite = unittest.makeSuite(IteratorTests)
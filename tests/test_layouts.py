@@ -1,5 +1,5 @@
 import unittest
-from igraph import Graph, Layout, BoundingBox
+from igraph import Graph, Layout, BoundingBox, Buffer
 
 
 class LayoutTests(unittest.TestCase):
@@ -282,6 +282,45 @@ class LayoutAlgorithmTests(unittest.TestCase):
         lo = g.layout("drl")
         self.assertTrue(isinstance(lo, Layout))
 
+    def testBarnesHut(self):
+        g = Graph.Lattice([50, 50], circular=False)
+        lo = g.layout("bh", random_seed=42)
+        self.assertTrue(isinstance(lo, Layout))
+        self.assertEqual(len(lo), g.vcount())
+        self.assertEqual(lo.dim, 2)
+
+        # Adjacent vertices are much closer to each other than the others
+        def dist(layout, u, v):
+            return sum((a - b) ** 2 for a, b in zip(layout[u], layout[v])) ** 0.5
+        edge = sum(dist(lo, *e.tuple) for e in g.es) / g.ecount()
+        pairs = [(u, (u * 37 + 11) % g.vcount()) for u in range(g.vcount())]
+        self.assertTrue(edge * 5 < sum(dist(lo, u, v) for u, v in pairs) / len(pairs))
+
+        # The result depends on the random seed only, not on the threads
+        self.assertEqual(g.layout("bh", random_seed=42, threads=2).coords, lo.coords)
+
+        buf = g.layout_barnes_hut(random_seed=42, return_type="buffer")
+        self.assertTrue(isinstance(buf, Buffer))
+        self.assertEqual(buf.shape, (g.vcount(), 2))
+        self.assertEqual(buf.tolist(), lo.coords)
+
+        # Incremental layout of a slightly changed graph from the buffer
+        g2 = g.copy()
+        g2.add_vertices(1)
+        g2.add_edges([(0, g.vcount())])
+        lo2 = g2.layout("bh", seed=buf)
+        self.assertEqual(len(lo2), g2.vcount())
+        moved = sum(dist(Layout([lo[v], lo2[v]]), 0, 1) for v in range(g.vcount()))
+        self.assertTrue(moved / g.vcount() < edge)
+        self.assertTrue(dist(lo2, 0, g.vcount()) < 3 * edge)
+
+        lo = Graph.Tree(100, 2).layout("bh_3d", random_seed=42)
+        self.assertEqual(lo.dim, 3)
+
+        self.assertRaises(ValueError, g.layout_barnes_hut, dim=4)
+        self.assertRaises(ValueError, g.layout_barnes_hut, seed=[[0, 0, 0]])
+        self.assertRaises(ValueError, g.layout_barnes_hut, weights=[-1] * g.ecount())
+
 
 def suite():
     layout_suite = unittest.makeSuite(LayoutTests)
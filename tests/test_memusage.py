@@ -0,0 +1,107 @@
+import sys
+import unittest
+
+from array import array
+from igraph import Graph, get_memory_stats
+
+
+class MemoryUsageTests(unittest.TestCase):
+    def testBreakdown(self):
+        g = Graph.Ring(100)
+        usage = g.memory_usage()
+        for key in ("structure", "graph_attributes", "vertex_attributes",
+                    "edge_attributes", "name_index", "cached_vectors",
+                    "object", "snapshot", "total"):
+            self.assertTrue(key in usage)
+        self.assertTrue(usage["structure"]["edges"] >= 2 * 100 * 8)
+        self.assertTrue(usage["structure"]["index"] >= 4 * 100 * 8)
+        self.assertEqual(usage["vertex_attributes"], {})
+        self.assertEqual(usage["name_index"], 0)
+        self.assertEqual(usage["snapshot"], 0)
+
+        total = usage["structure"]["edges"] + usage["structure"]["index"] + \
+            usage["object"]
+        self.assertEqual(usage["total"], total)
+
+    def testAttributes(self):
+        g = Graph.Ring(1000)
+        g["title"] = "ring"
+        g.vs["label"] = ["vertex %d" % i for i in range(g.vcount())]
+        g.es["weight"] = array("d", range(g.ecount()))
+
+        shallow = g.memory_usage(deep=False)
+        deep = g.memory_usage(deep=True)
+        self.assertTrue("title" in deep["graph_attributes"])
+        self.assertTrue(deep["vertex_attributes"]["label"] >
+                        shallow["vertex_attributes"]["label"])
+        # Typed columns are measured by their own storage
+        self.assertTrue(shallow["edge_attributes"]["weight"] >= g.ecount() * 8)
+        self.assertEqual(shallow["edge_attributes"]["weight"],
+                         deep["edge_attributes"]["weight"])
+        self.assertTrue(deep["total"] > shallow["total"])
+
+    def testSharedValuesCountedOnce(self):
+        g = Graph.Ring(1000)
+        value = "x" * 10000
+        g.vs["label"] = [value] * g.vcount()
+        usage = g.memory_usage()
+        self.assertTrue(usage["vertex_attributes"]["label"] <
+                        sys.getsizeof(value) * 2 + sys.getsizeof(g.vs["label"]))
+
+    def testNameIndex(self):
+        g = Graph.Ring(100)
+        g.vs["name"] = ["v%d" % i for i in range(g.vcount())]
+        self.assertEqual(g.memory_usage()["name_index"], 0)
+        g.vs.find("v10")
+        self.assertTrue(g.memory_usage(deep=False)["name_index"] > 0)
+
+    def testSizeOf(self):
+        g = Graph.Ring(100)
+        self.assertTrue(sys.getsizeof(g) >= g.memory_usage(deep=False)["total"])
+        g.vs["label"] = list(range(100))
+        self.assertTrue(sys.getsizeof(g) > g.memory_usage(deep=False)["object"])
+
+
+class MemoryStatsTests(unittest.TestCase):
+    def testBuffers(self):
+        g = Graph.Ring(10000)
+        before = get_memory_stats()
+        buf = g.degree(return_type="buffer")
+        after = get_memory_stats()
+        self.assertEqual(after["buffer_objects"], before["buffer_objects"] + 1)
+        self.assertTrue(after["buffer_bytes"] - before["buffer_bytes"] >= 10000 * 8)
+        del buf
+        self.assertEqual(get_memory_stats()["buffer_bytes"], before["buffer_bytes"])
+
+    def testColumns(self):
+        before = get_memory_stats()
+        g = Graph.Ring(1000)
+        g.es["weight"] = array("d", range(g.ecount()))
+        after = get_memory_stats()
+        self.assertTrue(after["column_objects"] > before["column_objects"])
+        self.assertTrue(after["column_bytes"] - before["column_bytes"] >= 1000 * 8)
+        del g
+        self.assertEqual(get_memory_stats()["column_bytes"], before["column_bytes"])
+
+    def testHeap(self):
+        stats = get_memory_stats()
+        if stats["heap_in_use"] is None:
+            self.assertTrue(stats["heap_reserved"] is None)
+        else:
+            self.assertTrue(stats["heap_in_use"] > 0)
+            self.assertTrue(stats["heap_reserved"] >= stats["heap_in_use"])
+
+
+def suite():
+    memory_usage_suite = unittest.makeSuite(MemoryUsageTests)
+    memory_stats_suite = unittest.makeSuite(MemoryStatsTests)
+    return unittest.TestSuite([memory_usage_suite, memory_stats_suite])
+
+
+def test():
+    runner = unittest.TextTestRunner()
+    runner.run(suite())
+
+
+if __name__ == "__main__":
+    test()
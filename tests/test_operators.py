@@ -148,6 +148,32 @@ class OperatorTests(unittest.TestCase):
             else:
                 self.assertTrue(e['attr'] == 'set_too')
 
+    def testUnionManyCombineEdges(self):
+        gs = [
+            Graph.Formula('A-B, B-C'),
+            Graph.Formula('B-A, C-D'),
+            Graph.Formula('D-C'),
+            ]
+        gs[0].es['weight'] = [1, 2]
+        gs[1].es['weight'] = [3, 4]
+        gs[2].es['label'] = ['x']
+        g = union(gs, combine_edges=dict(weight="sum", label="first"))
+        names = g.vs['name']
+        self.assertEqual(names, ['A', 'B', 'C', 'D'])
+        self.assertEqual(sorted(g.edge_attributes()), ['label', 'weight'])
+        attrs = dict(
+            ("".join(sorted(names[v] for v in e.tuple)), (e['weight'], e['label']))
+            for e in g.es
+        )
+        self.assertEqual(attrs, {
+            'AB': (4, None), 'BC': (2, None), 'CD': (4, 'x')
+        })
+
+        # Attributes without a combination rule are dropped
+        g = union(gs, combine_edges=dict(weight=max))
+        self.assertEqual(g.edge_attributes(), ['weight'])
+        self.assertEqual(sorted(g.es['weight']), [2, 3, 4])
+
     def testIntersectionNoGraphs(self):
         self.assertRaises(ValueError, intersection, [])
 
@@ -191,6 +217,24 @@ class OperatorTests(unittest.TestCase):
         g = intersection(gs)
         self.assertTrue(g.es['attr'] == ['set'])
 
+    def testIntersectionManyCombineEdges(self):
+        gs = [
+            Graph.Formula('A-B, B-C, C-D'),
+            Graph.Formula('B-C, C-A, A-B, E-A'),
+            ]
+        gs[0].es['weight'] = [1, 2, 3]
+        gs[1].es['weight'] = [10, 20, 30, 40]
+        gs[1].vs.find('E')['color'] = 'red'
+        g = intersection(gs, keep_all_vertices=False, combine_edges="max")
+        self.assertEqual(g.vs['name'], ['A', 'B', 'C'])
+        self.assertEqual(g.vs['color'], [None, None, None])
+        weights = dict((tuple(sorted(e.tuple)), e['weight']) for e in g.es)
+        self.assertEqual(weights, {(0, 1): 30, (1, 2): 10})
+
+        g = intersection(gs, combine_edges="max")
+        self.assertEqual(g.vs['name'], ['A', 'B', 'C', 'D', 'E'])
+        self.assertEqual(g.ecount(), 2)
+
     def testInPlaceAddition(self):
         g = Graph.Full(3)
         orig = g
@@ -0,0 +1,77 @@
+import unittest
+
+from igraph import Graph, get_profile_stats, get_profiling, \
+        profile_stats_to_prometheus, reset_profile_stats, set_profiling
+
+
+class ProfilingTests(unittest.TestCase):
+    def setUp(self):
+        self.old_state = get_profiling()
+        set_profiling(True)
+        reset_profile_stats()
+
+    def tearDown(self):
+        set_profiling(self.old_state)
+        reset_profile_stats()
+
+    def testSetProfiling(self):
+        self.assertTrue(get_profiling())
+        set_profiling(False)
+        self.assertFalse(get_profiling())
+
+    def testCounters(self):
+        g = Graph.Lattice([10, 10], circular=False)
+        g.es["weight"] = list(range(1, g.ecount() + 1))
+        for _ in range(3):
+            g.closeness(weights="weight")
+
+        stats = get_profile_stats()
+        self.assertTrue("Graph.closeness" in stats)
+        entry = stats["Graph.closeness"]
+        self.assertEqual(entry["calls"], 3)
+        self.assertTrue(entry["core_ns"] > 0)
+        for key in ("input_ns", "output_ns", "bytes"):
+            self.assertTrue(entry[key] >= 0)
+
+        # Failed calls count as input conversion only
+        self.assertRaises(Exception, g.closeness, weights="no_such_attribute")
+        entry = get_profile_stats()["Graph.closeness"]
+        self.assertEqual(entry["calls"], 4)
+
+        reset_profile_stats()
+        self.assertFalse("Graph.closeness" in get_profile_stats())
+
+    def testDisabled(self):
+        set_profiling(False)
+        g = Graph.Lattice([5, 5])
+        g.betweenness()
+        self.assertEqual(get_profile_stats(), {})
+
+    def testPrometheus(self):
+        stats = {
+            "Graph.closeness": dict(calls=2, input_ns=1000, core_ns=5000000,
+                                    output_ns=2000, bytes=64)
+        }
+        text = profile_stats_to_prometheus(stats, prefix="test")
+        lines = text.split("\n")
+        self.assertTrue("# TYPE test_calls_total counter" in lines)
+        self.assertTrue('test_calls_total{method="Graph.closeness"} 2' in lines)
+        self.assertTrue('test_allocated_bytes_total{method="Graph.closeness"} 64'
+                        in lines)
+        core = [line for line in lines
+                if line.startswith("test_core_seconds_total{")][0]
+        self.assertAlmostEqual(float(core.split()[-1]), 0.005)
+
+
+def suite():
+    profiling_suite = unittest.makeSuite(ProfilingTests)
+    return unittest.TestSuite([profiling_suite])
+
+
+def test():
+    runner = unittest.TextTestRunner()
+    runner.run(suite())
+
+
+if __name__ == "__main__":
+    test()
@@ -40,10 +40,69 @@ class RandomNumberGeneratorTests(unittest.TestCase):
         g2 = Graph.Erdos_Renyi(n=1000, m=5000)
         self.assertTrue(g1.get_edgelist() == g2.get_edgelist())
 
+    def testBatchedGenerator(self):
+        set_random_number_generator(FakeRNG, batch_size=16)
+        graph = Graph.GRG(10, 0.2)
+        self.assertEqual(graph.vs["x"], [0.1] * 10)
+
+        random.seed(42)
+        set_random_number_generator(random, batch_size=64)
+        g1 = Graph.Erdos_Renyi(n=100, m=500)
+        random.seed(42)
+        set_random_number_generator(random, batch_size=64)
+        g2 = Graph.Erdos_Renyi(n=100, m=500)
+        self.assertTrue(g1.get_edgelist() == g2.get_edgelist())
+
+        self.assertRaises(ValueError, set_random_number_generator, random,
+                batch_size=0)
+
+
+class FastRNGTests(unittest.TestCase):
+    def tearDown(self):
+        set_random_number_generator(random)
+
+    def testSeeding(self):
+        set_random_number_generator(FastRNG(42))
+        g1 = Graph.Erdos_Renyi(n=1000, m=5000)
+        set_random_number_generator(FastRNG(42))
+        g2 = Graph.Erdos_Renyi(n=1000, m=5000)
+        self.assertTrue(g1.get_edgelist() == g2.get_edgelist())
+
+        rng = FastRNG(42)
+        set_random_number_generator(rng)
+        g3 = Graph.Erdos_Renyi(n=1000, m=5000)
+        rng.seed(42)
+        g4 = Graph.Erdos_Renyi(n=1000, m=5000)
+        self.assertTrue(g1.get_edgelist() == g3.get_edgelist())
+        self.assertTrue(g3.get_edgelist() == g4.get_edgelist())
+
+        self.assertRaises(TypeError, FastRNG, "spam")
+
+    def testMethods(self):
+        rng = FastRNG(1234)
+        for _ in range(100):
+            x = rng.random()
+            self.assertTrue(0 <= x < 1)
+            n = rng.randint(3, 5)
+            self.assertTrue(3 <= n <= 5)
+        self.assertTrue(isinstance(rng.gauss(0.0, 1.0), float))
+        self.assertRaises(ValueError, rng.randint, 5, 3)
+
+        rng1, rng2 = FastRNG(7), FastRNG(7)
+        self.assertEqual([rng1.random() for _ in range(10)],
+                [rng2.random() for _ in range(10)])
+
+    def testAsPythonGenerator(self):
+        # FastRNG provides the same interface as the random module
+        set_random_number_generator(FastRNG(5))
+        g = Graph.GRG(10, 0.2)
+        self.assertEqual(len(set(g.vs["x"])), 10)
+
 
 def suite():
     random_suite = unittest.makeSuite(RandomNumberGeneratorTests)
-    return unittest.TestSuite([random_suite])
+    fast_rng_suite = unittest.makeSuite(FastRNGTests)
+    return unittest.TestSuite([random_suite, fast_rng_suite])
 
 def test():
     runner = unittest.TextTestRunner()
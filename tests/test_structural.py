@@ -303,6 +303,68 @@ class CentralityTests(unittest.TestCase):
         for obs, exp in zip(cl, expected_cl):
             self.assertAlmostEqual(obs, exp, places=4)
 
+    def assertListAlmostEqual(self, first, second, places=7):
+        self.assertEqual(len(first), len(second))
+        for x, y in zip(first, second):
+            self.assertAlmostEqual(x, y, places=places)
+
+    def testParallelCentralities(self):
+        graphs = [
+            Graph.Lattice([4, 5], circular=False),
+            Graph(8, [(0, 1), (1, 2), (2, 0), (2, 3), (3, 4), (4, 2), (5, 6), (1, 2), (4, 4)]),
+            Graph(8, [(0, 1), (1, 2), (2, 0), (2, 3), (3, 4), (4, 2), (5, 6), (1, 2)],
+                  directed=True),
+        ]
+        for g in graphs:
+            weights = [1 + (i * 7) % 4 for i in range(g.ecount())]
+            for kwds in ({}, {"weights": weights}, {"cutoff": 2}):
+                for directed in (True, False):
+                    self.assertListAlmostEqual(
+                        g.betweenness(directed=directed, threads=3, **kwds),
+                        g.betweenness(directed=directed, **kwds))
+                    self.assertListAlmostEqual(
+                        g.edge_betweenness(directed=directed, threads=3, **kwds),
+                        g.edge_betweenness(directed=directed, **kwds))
+                for mode in (OUT, IN, ALL):
+                    with warnings.catch_warnings():
+                        warnings.simplefilter("ignore")
+                        expected = g.closeness(mode=mode, **kwds)
+                    self.assertListAlmostEqual(
+                        g.closeness(mode=mode, threads=2, **kwds), expected)
+                    self.assertListAlmostEqual(
+                        g.closeness([3, 0], mode=mode, threads=2, **kwds),
+                        [expected[3], expected[0]])
+
+        g = Graph.Lattice([10, 10], circular=False)
+        estimate, error = g.betweenness(approximate=True, samples=100)
+        self.assertListAlmostEqual(estimate, g.betweenness())
+        self.assertEqual(error, 0.0)
+        self.assertAlmostEqual(g.betweenness(5, approximate=True, samples=1000)[0],
+                               g.betweenness(5))
+        estimate, error = g.betweenness(approximate=True, samples=20, seed=42)
+        estimate2, error2 = g.betweenness(approximate=True, samples=20, seed=42, threads=4)
+        self.assertListAlmostEqual(estimate, estimate2)
+        self.assertEqual(error, error2)
+        self.assertTrue(error > 0)
+        exact = g.betweenness()
+        self.assertTrue(all(abs(x - y) <= error for x, y in zip(estimate, exact)))
+        estimate, error = g.edge_betweenness(approximate=True, samples=20, seed=42)
+        self.assertEqual(len(estimate), g.ecount())
+        self.assertTrue(error > 0)
+
+        estimate, error = g.closeness(approximate=True, samples=30, seed=1)
+        exact = g.closeness()
+        self.assertTrue(error > 0)
+        for x, y in zip(estimate, exact):
+            self.assertTrue(abs(99 / x - 99 / y) <= error)
+        cl, error = g.closeness(approximate=True, samples=100)
+        self.assertListAlmostEqual(cl, exact)
+        self.assertEqual(error, 0.0)
+
+        self.assertRaises(ValueError, g.betweenness, threads=0)
+        self.assertRaises(ValueError, g.betweenness, approximate=True, samples=0)
+        self.assertRaises(ValueError, g.closeness, threads=2, weights=[0] * g.ecount())
+
     def testPageRank(self):
         g = Graph.Star(11)
         cent = g.pagerank()
@@ -320,6 +382,48 @@ class CentralityTests(unittest.TestCase):
         cent2 = g.personalized_pagerank(reset_vertices=g.vs[1], damping=0.5)
         self.assertTrue(max(abs(x-y) for x, y in zip(cent, cent2)) < 0.001)
 
+    def testPersonalizedPageRankBatch(self):
+        g = Graph([(0, 1), (0, 2), (1, 2), (2, 0), (3, 2), (3, 4), (5, 3)], directed=True)
+        g.es["weight"] = [1, 2, 1, 3, 1, 2, 1]
+        seeds = [3, [0, 4], g.vs[1:3]]
+        for directed in (True, False):
+            for weights in (None, "weight"):
+                res = g.personalized_pagerank_batch(seeds, directed=directed,
+                        weights=weights, damping=0.7)
+                self.assertEqual(len(res), len(seeds))
+                for seed, row in zip(seeds, res):
+                    expected = g.personalized_pagerank(reset_vertices=seed,
+                            directed=directed, weights=weights, damping=0.7)
+                    self.assertListAlmostEqual(row, expected, places=6)
+
+                self.assertEqual(g.personalized_pagerank_batch(seeds,
+                    directed=directed, weights=weights, damping=0.7,
+                    threads=3), res)
+
+        res = g.personalized_pagerank_batch(seeds)
+        top = g.personalized_pagerank_batch(seeds, top_k=2)
+        for row, best in zip(res, top):
+            self.assertEqual(len(best), 2)
+            order = sorted(range(g.vcount()), key=lambda v: (-round(row[v], 9), v))
+            self.assertEqual([v for v, _ in best], order[:2])
+            self.assertListAlmostEqual([score for _, score in best],
+                    [row[v] for v in order[:2]])
+
+        buf = g.personalized_pagerank_batch(seeds, return_type="buffer")
+        self.assertEqual(buf.shape, (3, g.vcount()))
+        self.assertEqual(buf.tolist(), res)
+        ids, scores = g.personalized_pagerank_batch(seeds, top_k=2,
+                return_type="buffer")
+        self.assertEqual(list(ids), [v for best in top for v, _ in best])
+        self.assertEqual(list(scores), [x for best in top for _, x in best])
+
+        self.assertEqual(len(g.personalized_pagerank_batch(seeds, top_k=100)[0]),
+                g.vcount())
+        self.assertEqual(g.personalized_pagerank_batch([]), [])
+        self.assertRaises(ValueError, g.personalized_pagerank_batch, [[]])
+        self.assertRaises(ValueError, g.personalized_pagerank_batch, [10])
+        self.assertRaises(ValueError, g.personalized_pagerank_batch, [0], top_k=0)
+
     def testEigenvectorCentrality(self):
         g = Graph.Star(11)
         cent = g.evcent()
@@ -346,6 +450,39 @@ class CentralityTests(unittest.TestCase):
         hsc, ev = g.hub_score(scale=False, return_eigenvalue=True)
         if hsc[0]<0: hsc = [-x for x in hsc]
 
+    def testARPACKSession(self):
+        s = ARPACKSession()
+        self.assertTrue(isinstance(s, ARPACKOptions))
+        self.assertFalse(s.warm_start)
+
+        g = Graph.Famous("Zachary")
+        expected = g.evcent()
+        cent = g.evcent(arpack_options=s)
+        self.assertFalse(s.warm_start)
+        for obs, exp in zip(cent, expected):
+            self.assertAlmostEqual(obs, exp, places=4)
+        cold_numop = s.numop
+
+        cent, ev = g.evcent(arpack_options=s, return_eigenvalue=True)
+        self.assertTrue(s.warm_start)
+        self.assertTrue(s.numop <= cold_numop)
+        self.assertTrue(s.time >= 0)
+        for obs, exp in zip(cent, expected):
+            self.assertAlmostEqual(obs, exp, places=4)
+        self.assertAlmostEqual(ev, g.evcent(return_eigenvalue=True)[1], places=4)
+
+        g = Graph.Tree(15, 2, TREE_IN)
+        for obs, exp in zip(g.hub_score(arpack_options=s), g.hub_score()):
+            self.assertAlmostEqual(obs, exp, places=4)
+        self.assertFalse(s.warm_start)
+        for obs, exp in zip(g.authority_score(arpack_options=s),
+                            g.authority_score()):
+            self.assertAlmostEqual(obs, exp, places=4)
+
+        s.reset()
+        g.evcent(arpack_options=s)
+        self.assertFalse(s.warm_start)
+
     def testCoreness(self):
         g = Graph.Full(4) + Graph(4) + [(0,4), (1,5), (2,6), (3,7)]
         self.assertEqual(g.coreness("A"), [3,3,3,3,1,1,1,1])
@@ -366,6 +503,16 @@ class NeighborhoodTests(unittest.TestCase):
                     [1,2,6,7], [2,3,7,8], [3,4,8,9], \
                     [4,5,9], [5,6], [6,7]])
 
+    def testNeighborhoodDirected(self):
+        g = Graph(5, [(0, 1), (1, 2), (1, 2), (2, 0), (3, 3), (2, 3), (4, 2)],
+                  directed=True)
+        self.assertEqual(g.neighborhood(4, order=2, mode=OUT), [4, 2, 0, 3])
+        self.assertEqual(g.neighborhood(4, order=2, mode=OUT, mindist=2), [0, 3])
+        self.assertEqual(g.neighborhood(2, mode=IN), [2, 1, 4])
+        self.assertEqual(g.neighborhood([0, 4], order=2, mode=OUT),
+                [[0, 1, 2], [4, 2, 0, 3]])
+        self.assertEqual(g.neighborhood_size([0, 4], order=2, mode=OUT), [3, 4])
+
     def testNeighborhoodSize(self):
         g = Graph.Ring(10, circular=False)
         self.assertTrue(g.neighborhood_size() == [2,3,3,3,3,3,3,3,3,2])
@@ -417,6 +564,38 @@ class MiscTests(unittest.TestCase):
         el.sort()
         self.assertTrue(el == [(0, 2), (0, 4)])
 
+    def testSimilaritySparse(self):
+        g = Graph([(0, 1), (0, 2), (1, 2), (2, 3), (3, 4), (3, 4), (4, 4),
+                   (5, 1), (5, 3), (6, 0)], directed=True)
+        for mode in (ALL, OUT, IN):
+            for method, kwds in (
+                    (g.similarity_jaccard, dict(loops=False)),
+                    (g.similarity_jaccard, dict(loops=True)),
+                    (g.similarity_dice, dict(loops=True)),
+                    (g.similarity_inverse_log_weighted, {})):
+                dense = method(mode=mode, **kwds)
+                for top_k, threshold in ((None, 0), (2, None), (3, 0.3)):
+                    offsets, ids, scores = method(mode=mode, top_k=top_k,
+                            threshold=threshold, threads=2, **kwds)
+                    offsets, ids, scores = list(offsets), list(ids), list(scores)
+                    self.assertEqual(len(offsets), g.vcount() + 1)
+                    for u, row in enumerate(dense):
+                        order = [v for v in sorted(range(g.vcount()),
+                                 key=lambda v: (-round(row[v], 9), v))
+                                 if v != u and row[v] > 0 and row[v] >= (threshold or 0)]
+                        if top_k:
+                            order = order[:top_k]
+                        start, end = offsets[u], offsets[u + 1]
+                        self.assertEqual(ids[start:end], order)
+                        for v, score in zip(order, scores[start:end]):
+                            self.assertAlmostEqual(score, row[v], places=10)
+
+        offsets, ids, scores = g.similarity_jaccard([5, 2], top_k=1)
+        self.assertEqual((list(offsets), list(ids)), ([0, 1, 2], [1, 0]))
+        self.assertAlmostEqual(scores[0], 0.4)
+        self.assertRaises(ValueError, g.similarity_jaccard, pairs=[(0, 1)], top_k=1)
+        self.assertRaises(ValueError, g.similarity_dice, top_k=0)
+
 
 class PathTests(unittest.TestCase):
     def testShortestPaths(self):
@@ -443,6 +622,41 @@ class PathTests(unittest.TestCase):
         self.assertTrue(g.shortest_paths(weights="weight", target=[2,3]) ==
                 [row[2:4] for row in expected])
 
+    def testShortestPathsIter(self):
+        g = Graph(10, [(0,1), (0,2), (0,3), (1,2), (1,4), (1,5), (2,3), (2,6), \
+            (3,2), (3,6), (4,5), (4,7), (5,6), (5,8), (5,9), (7,5), (7,8), \
+            (8,9), (5,2), (2,1)], directed=True)
+        g.es["weight"] = [0,2,1,0,5,2,1,1,0,2,2,8,1,1,3,1,1,4,2,1]
+
+        for weights in (None, "weight"):
+            for threads in (1, 3):
+                expected = g.shortest_paths(weights=weights)
+                blocks = list(g.shortest_paths_iter(weights=weights, chunk=4,
+                                                    threads=threads))
+                self.assertEqual([block.shape for block in blocks],
+                                 [(4, 10), (4, 10), (2, 10)])
+                self.assertEqual(sum((block.tolist() for block in blocks), []),
+                                 expected)
+
+        expected = g.shortest_paths(source=[5, 1], target=[2, 3], mode=IN)
+        blocks = list(g.shortest_paths_iter(source=[5, 1], target=[2, 3],
+                                            mode=IN))
+        self.assertEqual(len(blocks), 1)
+        self.assertEqual(blocks[0].tolist(), expected)
+
+        g = Graph.Lattice([4, 5], circular=False)
+        blocks = g.shortest_paths_iter(chunk=7, threads=2, reduce="eccentricity")
+        self.assertEqual(sum((block.tolist() for block in blocks), []),
+                         g.eccentricity())
+        harmonic = [sum(1.0 / d for d in row if d > 0)
+                    for row in g.shortest_paths()]
+        blocks = g.shortest_paths_iter(threads=4, reduce="harmonic")
+        for obs, exp in zip(sum((b.tolist() for b in blocks), []), harmonic):
+            self.assertAlmostEqual(obs, exp, places=6)
+
+        self.assertRaises(ValueError, g.shortest_paths_iter, chunk=0)
+        self.assertRaises(ValueError, g.shortest_paths_iter, weights=[-1]*g.ecount())
+
     def testGetShortestPaths(self):
         g = Graph(4, [(0,1), (0,2), (1,3), (3,2), (2,1)], directed=True)
         sps = g.get_shortest_paths(0)
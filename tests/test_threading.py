@@ -0,0 +1,150 @@
+import threading
+import time
+import unittest
+
+from igraph import Graph, get_gil_release, set_gil_release, \
+        CancellationToken, CancelledError, get_hook_interval, \
+        set_hook_interval, set_progress_handler
+
+
+def try_enable_gil_release():
+    """Releases the GIL in the long-running methods if the C core allows
+    it; returns whether it does."""
+    try:
+        set_gil_release(True)
+    except RuntimeError:
+        return False
+    return True
+
+
+class GILReleaseTests(unittest.TestCase):
+    def setUp(self):
+        self.old_state = get_gil_release()
+        if not try_enable_gil_release():
+            self.skipTest("the C core is not thread-safe")
+
+    def tearDown(self):
+        set_gil_release(self.old_state)
+
+    def testSetGILRelease(self):
+        self.assertTrue(get_gil_release())
+        set_gil_release(False)
+        self.assertFalse(get_gil_release())
+
+    def testResultsFromThreads(self):
+        g = Graph.Lattice([10, 10], circular=False)
+        g.es["weight"] = list(range(1, g.ecount() + 1))
+        expected = g.betweenness(weights="weight")
+
+        results = [None] * 4
+
+        def worker(index):
+            results[index] = g.betweenness(weights="weight")
+
+        threads = [threading.Thread(target=worker, args=(i,)) for i in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        for result in results:
+            self.assertEqual(result, expected)
+
+    def testCallbacksWithoutGIL(self):
+        # Community detection uses the Python random number generator, which
+        # has to re-acquire the GIL
+        g = Graph.Famous("zachary")
+        cl = g.community_multilevel()
+        self.assertEqual(len(cl.membership), g.vcount())
+
+        # Errors raised by the C core are still converted to exceptions
+        self.assertRaises(Exception, g.betweenness, weights=[-1.0])
+
+
+class CancellationTests(unittest.TestCase):
+    def setUp(self):
+        self.old_state = get_gil_release()
+        try_enable_gil_release()
+
+    def tearDown(self):
+        set_gil_release(self.old_state)
+
+    def testCancelledToken(self):
+        g = Graph.Lattice([20, 20], circular=False)
+        token = CancellationToken()
+        self.assertFalse(token.cancelled)
+        with token:
+            self.assertEqual(len(g.betweenness()), g.vcount())
+            token.cancel()
+            self.assertTrue(token.cancelled)
+            self.assertFalse(token.timed_out)
+            self.assertRaises(CancelledError, g.betweenness)
+
+        # The token is not active any more
+        self.assertEqual(len(g.betweenness()), g.vcount())
+
+    def testTimeout(self):
+        g = Graph.Lattice([20, 20], circular=False)
+        with CancellationToken(timeout=0) as token:
+            self.assertRaises(CancelledError, g.betweenness)
+        self.assertTrue(token.timed_out)
+
+        # Nested tokens: the outer one stops the computation
+        with CancellationToken(timeout=0):
+            with CancellationToken(timeout=3600):
+                self.assertRaises(CancelledError, g.betweenness)
+
+        self.assertRaises(ValueError, CancellationToken, timeout=-1)
+
+    def testCancelFromOtherThread(self):
+        g = Graph.Lattice([200, 200], circular=False)
+        token = CancellationToken()
+        timer = threading.Timer(0.05, token.cancel)
+        timer.start()
+        try:
+            with token:
+                start = time.time()
+                while time.time() - start < 60:
+                    g.betweenness()
+        except CancelledError:
+            pass
+        finally:
+            timer.cancel()
+        self.assertTrue(token.cancelled)
+
+    def testHookInterval(self):
+        old_interval = get_hook_interval()
+        calls = []
+        set_progress_handler(lambda message, percent: calls.append(percent))
+        try:
+            g = Graph.Lattice([30, 30], circular=False)
+
+            set_hook_interval(0)
+            g.betweenness()
+            all_calls = len(calls)
+
+            del calls[:]
+            set_hook_interval(3600)
+            g.betweenness()
+            self.assertTrue(len(calls) < all_calls)
+            self.assertTrue(len(calls) <= 2)
+
+            self.assertRaises(ValueError, set_hook_interval, -1)
+        finally:
+            set_progress_handler(None)
+            set_hook_interval(old_interval)
+
+
+def suite():
+    gil_release_suite = unittest.makeSuite(GILReleaseTests)
+    cancellation_suite = unittest.makeSuite(CancellationTests)
+    return unittest.TestSuite([gil_release_suite, cancellation_suite])
+
+
+def test():
+    runner = unittest.TextTestRunner()
+    runner.run(suite())
+
+
+if __name__ == "__main__":
+    test()
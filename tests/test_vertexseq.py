@@ -1,5 +1,6 @@
 # vim:ts=4 sw=4 sts=4:
 
+import operator
 import unittest
 
 from igraph import *
@@ -200,6 +201,22 @@ class VertexSeqTests(unittest.TestCase):
         self.assertEqual(ind, [vertex.index for vertex in self.g.vs[arr.tolist()]])
         self.assertEqual(ind, [vertex.index for vertex in self.g.vs[list(arr)]])
 
+    def testCursor(self):
+        seen, objects = [], set()
+        for vertex in self.g.vs[2, 5, 7].cursor():
+            seen.append((vertex.index, vertex["name"], hash(vertex) == hash(self.g.vs[vertex.index])))
+            objects.add(id(vertex))
+        self.assertEqual(seen, [(2, "C", True), (5, "F", True), (7, "H", True)])
+        self.assertEqual(len(objects), 1)
+        self.assertEqual([v.index for v in self.g.vs.cursor()], list(range(10)))
+        self.assertEqual(list(self.g.vs.select(None).cursor()), [])
+
+        # Released vertices are recycled but never shared
+        vertices = [self.g.vs[i] for i in range(10)]
+        del vertices[::2]
+        self.assertEqual([v.index for v in vertices], [1, 3, 5, 7, 9])
+        self.assertEqual([self.g.vs[i].index for i in range(10)], list(range(10)))
+
     def testPartialAttributeAssignment(self):
         only_even = self.g.vs.select(lambda v: (v.index % 2 == 0))
         only_even["test"] = [0] * len(only_even)
@@ -315,6 +332,43 @@ class VertexSeqTests(unittest.TestCase):
         del g.vs["degree"]
         self.assertTrue(len(g.vs(_degree_gt=30)) == l)
 
+    def testKeywordFilteringSelectOnColumns(self):
+        g = Graph.Ring(8)
+        values = {
+            "int": [3, 1, 4, 1, 5, 9, 2, 6],
+            "float": [0.5, 1.0, 2.5, float("nan"), 4.0, 1.0, 7.5, 0.0],
+            "bool": [True, False, True, True, False, False, True, False],
+            "missing": [1, None, 3, None, 5, 6, None, 8],
+        }
+        conditions = [
+            ("eq", 1), ("ne", 1), ("lt", 4), ("gt", 2.5), ("le", 1.0),
+            ("ge", True), ("in", [1, 2.5, 9]), ("notin", (1, 6)),
+            ("in", set([True])), ("eq", "x"), ("in", ["x", None]),
+        ]
+        for name, attr_values in values.items():
+            g.vs[name] = attr_values
+            for as_column in (False, True):
+                if as_column:
+                    g.vs.get_attribute_column(name)
+                for op, value in conditions:
+                    if name == "missing" and op in ("lt", "gt", "le", "ge"):
+                        continue
+                    expected = [
+                        i for i, v in enumerate(attr_values)
+                        if (v in value if op == "in" else
+                            v not in value if op == "notin" else
+                            getattr(operator, op)(v, value))
+                    ]
+                    observed = g.vs.select(**{name + "_" + op: value}).indices
+                    self.assertEqual(expected, observed, (name, op, value))
+
+        # chained filters narrow down the previous selection
+        vs = g.vs.select(int_gt=1).select(float_lt=5)
+        self.assertEqual(vs.indices, [0, 2, 4, 5, 7])
+        vs = g.vs.select([7, 5, 0, 5]).select(int_ge=3)
+        self.assertEqual(vs.indices, [7, 5, 0, 5])
+        self.assertRaises(KeyError, g.vs.select, nonexistent_gt=2)
+
     def testIndexAndKeywordFilteringFind(self):
         self.assertRaises(ValueError, self.g.vs.find, 2, name="G")
         self.assertRaises(ValueError, self.g.vs.find, 2, test=4)
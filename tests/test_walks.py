@@ -54,6 +54,42 @@ class RandomWalkTests(unittest.TestCase):
         self.assertEqual([5, 6, 7, 8, 9], walk)
         self.assertRaises(InternalError, g.random_walk, 5, 20, stuck="error")
 
+    def testRandomWalks(self):
+        g = Graph.GRG(100, 0.2)
+        starts = [0, 5, 17]
+        walks = g.random_walks(starts, 8, walks_per_node=3, seed=42)
+        self.assertEqual("int", walks.type)
+        self.assertEqual((len(starts) * 3, 8), walks.shape)
+        self.assertEqual(len(starts) * 3 * 8, len(walks))
+        flat = list(walks)
+        for i in range(len(starts) * 3):
+            walk = [v for v in flat[i*8:(i+1)*8] if v >= 0]
+            self.validate_walk(g, walk, starts[i // 3], 8)
+
+        # The buffer is a C-contiguous matrix with one walk per row
+        view = memoryview(walks)
+        self.assertEqual((len(starts) * 3, 8), view.shape)
+        self.assertTrue(view.c_contiguous)
+        self.assertEqual(flat[8:16], view.tolist()[1])
+
+        # Same seed, same walks, regardless of the number of threads
+        walks = g.random_walks(steps=5, walks_per_node=4, seed=7)
+        self.assertEqual(list(walks),
+                         list(g.random_walks(steps=5, walks_per_node=4,
+                                             seed=7, threads=3)))
+        self.assertEqual((g.vcount() * 4, 5), walks.shape)
+
+        # Zero-weight edges are never followed
+        g = Graph.Star(5, mode="out") + [(1, 2)]
+        g.es["weight"] = [1, 0, 0, 2, 3]
+        walks = list(g.random_walks([0] * 50, 2, weights="weight", seed=1))
+        self.assertEqual(set([0]), set(walks[0::2]))
+        self.assertTrue(set(walks[1::2]) <= set([1, 4]))
+
+        g = Graph.Ring(10, circular=False, directed=True)
+        self.assertEqual([5, 6, 7, 8, 9, -1, -1], list(g.random_walks([5], 7)))
+        self.assertRaises(InternalError, g.random_walks, [5], 20, stuck="error")
+
 
 def suite():
     random_walk_suite = unittest.makeSuite(RandomWalkTests)
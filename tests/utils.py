@@ -10,7 +10,7 @@ import types
 from contextlib import contextmanager
 from textwrap import dedent
 
-__all__ = ["skip", "skipIf", "temporary_file"]
+__all__ = ["search_iter_limits", "skip", "skipIf", "temporary_file"]
 
 
 def _id(obj):
@@ -70,3 +70,15 @@ def temporary_file(content=None, mode=None, binary=False):
 
 
 is_pypy = (platform.python_implementation() == "PyPy")
+
+
+def search_iter_limits():
+    """Returns the keyword arguments that clique and subisomorphism
+    iterators need on this build: a limit on the number of results if the
+    C core cannot suspend a search, nothing otherwise."""
+    from igraph import Graph
+    try:
+        Graph(1).cliques_iter().close()
+    except RuntimeError:
+        return {"max_results": 1000000}
+    return {}